@@ -0,0 +1,458 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file main.cc
+ * \brief Serving benchmark: latency-under-load measurement of a relax VM module.
+ */
+#include <dmlc/json.h>
+#include <dmlc/logging.h>
+#include <tvm/runtime/module.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "serving_engine.h"
+#include "workload.h"
+
+using namespace tvm;
+using namespace tvm::bench_serving;
+
+static const std::string kUsage =
+    "Command line usage\n"
+    "--model            - Path to the compiled relax executable (.so). Required\n"
+    "--device           - Comma separated devices, e.g. cuda:0,cuda:1. Default=cpu\n"
+    "--step-func        - Name of the forward step function. Default=step\n"
+    "--kv-cache-func    - Name of the KV cache creation function; \"\" disables\n"
+    "                     cache driving and occupancy sampling. Default=\"\"\n"
+    "--num-requests     - Number of requests in the stream. Default=256\n"
+    "--request-rate     - Mean arrival rate in requests/s. Default=8\n"
+    "--arrival          - Arrival process: poisson|uniform|burst. Default=poisson\n"
+    "--burst-size       - Requests per burst when --arrival=burst. Default=16\n"
+    "--prompt-len       - Prompt length, \"n\" or \"low:high\". Default=128\n"
+    "--output-len       - Decode length, \"n\" or \"low:high\". Default=64\n"
+    "--max-batch-size   - In-flight requests per engine step. Default=32\n"
+    "--vocab-size       - Vocabulary for random token ids. Default=32000\n"
+    "--kv-sample-every  - Sample KV cache stats every N steps, 0 disables. Default=1\n"
+    "--seed             - Workload seed. Default=0\n"
+    "--measure-scaling  - Also run on the first device alone and report the\n"
+    "                     multi-device scaling efficiency. Default=False\n"
+    "--dump-requests    - Include per-request records in the output. Default=False\n"
+    "--output           - Write the JSON report to this file instead of stdout\n"
+    "\n"
+    "  Example\n"
+    "  ./tvm_bench_serving --model=model.so --device=cuda:0,cuda:1 \\\n"
+    "      --kv-cache-func=create_kv_cache --request-rate=16 --measure-scaling\n"
+    "\n";
+
+/*! \brief Parsed command line arguments. */
+struct BenchArgs {
+  std::string model;
+  std::vector<DLDevice> devices{DLDevice{kDLCPU, 0}};
+  std::vector<std::string> device_names{"cpu"};
+  WorkloadConfig workload;
+  std::string step_func = "step";
+  std::string kv_cache_func;
+  int max_batch_size = 32;
+  int kv_sample_every = 1;
+  bool measure_scaling = false;
+  bool dump_requests = false;
+  std::string output;
+};
+
+/*! \brief Parse one device given as "type" or "type:id". */
+bool ParseDevice(const std::string& name, DLDevice* out) {
+  std::string kind = name;
+  int id = 0;
+  size_t colon = name.find(':');
+  if (colon != std::string::npos) {
+    kind = name.substr(0, colon);
+    try {
+      id = std::stoi(name.substr(colon + 1));
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  static const std::pair<const char*, DLDeviceType> kKinds[] = {
+      {"cpu", kDLCPU},     {"llvm", kDLCPU},     {"cuda", kDLCUDA},
+      {"rocm", kDLROCM},   {"metal", kDLMetal},  {"vulkan", kDLVulkan},
+      {"opencl", kDLOpenCL},
+  };
+  for (const auto& kv : kKinds) {
+    if (kind == kv.first) {
+      *out = DLDevice{kv.second, id};
+      return true;
+    }
+  }
+  return false;
+}
+
+/*! \brief Split a comma separated list. */
+std::vector<std::string> SplitCommas(const std::string& text) {
+  std::vector<std::string> items;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+bool ParseCmdArgs(int argc, char* argv[], BenchArgs* args) {
+  auto value_of = [](const char* arg, const char* flag) -> const char* {
+    size_t len = strlen(flag);
+    if (strncmp(arg, flag, len) == 0 && arg[len] == '=') return arg + len + 1;
+    return nullptr;
+  };
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = nullptr;
+    if ((value = value_of(arg, "--model"))) {
+      args->model = value;
+    } else if ((value = value_of(arg, "--device"))) {
+      args->devices.clear();
+      args->device_names = SplitCommas(value);
+      for (const std::string& name : args->device_names) {
+        DLDevice device;
+        if (!ParseDevice(name, &device)) {
+          LOG(ERROR) << "Unknown device \"" << name << "\"";
+          return false;
+        }
+        args->devices.push_back(device);
+      }
+      if (args->devices.empty()) return false;
+    } else if ((value = value_of(arg, "--step-func"))) {
+      args->step_func = value;
+    } else if ((value = value_of(arg, "--kv-cache-func"))) {
+      args->kv_cache_func = value;
+    } else if ((value = value_of(arg, "--num-requests"))) {
+      args->workload.num_requests = std::stoi(value);
+    } else if ((value = value_of(arg, "--request-rate"))) {
+      args->workload.request_rate = std::stod(value);
+    } else if ((value = value_of(arg, "--arrival"))) {
+      if (!ParseArrivalProcess(value, &args->workload.arrival)) {
+        LOG(ERROR) << "Unknown arrival process \"" << value << "\"";
+        return false;
+      }
+    } else if ((value = value_of(arg, "--burst-size"))) {
+      args->workload.burst_size = std::stoi(value);
+    } else if ((value = value_of(arg, "--prompt-len"))) {
+      if (!ParseLengthRange(value, &args->workload.prompt_len)) return false;
+    } else if ((value = value_of(arg, "--output-len"))) {
+      if (!ParseLengthRange(value, &args->workload.output_len)) return false;
+    } else if ((value = value_of(arg, "--max-batch-size"))) {
+      args->max_batch_size = std::stoi(value);
+    } else if ((value = value_of(arg, "--vocab-size"))) {
+      args->workload.vocab_size = std::stoi(value);
+    } else if ((value = value_of(arg, "--kv-sample-every"))) {
+      args->kv_sample_every = std::stoi(value);
+    } else if ((value = value_of(arg, "--seed"))) {
+      args->workload.seed = std::stoull(value);
+    } else if (strcmp(arg, "--measure-scaling") == 0) {
+      args->measure_scaling = true;
+    } else if (strcmp(arg, "--dump-requests") == 0) {
+      args->dump_requests = true;
+    } else if ((value = value_of(arg, "--output"))) {
+      args->output = value;
+    } else {
+      LOG(ERROR) << "Unknown argument \"" << arg << "\"";
+      return false;
+    }
+  }
+  if (args->model.empty()) {
+    LOG(ERROR) << "--model is required";
+    return false;
+  }
+  return true;
+}
+
+/*! \brief Latency summary with JSON serialization. */
+struct JSONLatency {
+  LatencySummary summary;
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("count", summary.count);
+    writer->WriteObjectKeyValue("mean", summary.mean);
+    writer->WriteObjectKeyValue("p50", summary.p50);
+    writer->WriteObjectKeyValue("p90", summary.p90);
+    writer->WriteObjectKeyValue("p95", summary.p95);
+    writer->WriteObjectKeyValue("p99", summary.p99);
+    writer->WriteObjectKeyValue("max", summary.max);
+    writer->EndObject();
+  }
+};
+
+/*! \brief KV cache occupancy time series of one engine. */
+struct JSONKVSample {
+  KVCacheSample sample;
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("t_s", sample.t_s);
+    writer->WriteObjectKeyValue("pages_in_use", sample.pages_in_use);
+    writer->WriteObjectKeyValue("page_utilization", sample.page_utilization);
+    writer->WriteObjectKeyValue("num_sequences", sample.num_sequences);
+    writer->EndObject();
+  }
+};
+
+/*! \brief Per-request record. */
+struct JSONRequest {
+  RequestMetrics metrics;
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("id", metrics.id);
+    writer->WriteObjectKeyValue("arrival_s", metrics.arrival_s);
+    writer->WriteObjectKeyValue("first_token_s", metrics.first_token_s);
+    writer->WriteObjectKeyValue("finish_s", metrics.finish_s);
+    writer->WriteObjectKeyValue("prompt_len", metrics.prompt_len);
+    writer->WriteObjectKeyValue("output_len", metrics.output_len);
+    writer->EndObject();
+  }
+};
+
+/*! \brief Per-engine detail of a run. */
+struct JSONEngine {
+  std::string device;
+  int64_t num_steps{0};
+  double mean_batch_tokens{0.0};
+  std::vector<JSONKVSample> kv_samples;
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("device", device);
+    writer->WriteObjectKeyValue("num_steps", num_steps);
+    writer->WriteObjectKeyValue("mean_batch_tokens", mean_batch_tokens);
+    writer->WriteObjectKeyValue("kv_cache", kv_samples);
+    writer->EndObject();
+  }
+};
+
+/*! \brief Aggregated report of one run over a device set. */
+struct RunReport {
+  std::vector<std::string> devices;
+  double wall_s{0.0};
+  int64_t num_requests{0};
+  int64_t total_output_tokens{0};
+  double request_throughput{0.0};
+  double output_token_throughput{0.0};
+  JSONLatency ttft;
+  JSONLatency tpot;
+  JSONLatency step_latency;
+  std::vector<JSONEngine> engines;
+  std::vector<JSONRequest> requests;
+  bool dump_requests{false};
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("devices", devices);
+    writer->WriteObjectKeyValue("wall_s", wall_s);
+    writer->WriteObjectKeyValue("num_requests", num_requests);
+    writer->WriteObjectKeyValue("total_output_tokens", total_output_tokens);
+    writer->WriteObjectKeyValue("request_throughput_rps", request_throughput);
+    writer->WriteObjectKeyValue("output_token_throughput_tps", output_token_throughput);
+    writer->WriteObjectKeyValue("ttft_s", ttft);
+    writer->WriteObjectKeyValue("tpot_s", tpot);
+    writer->WriteObjectKeyValue("step_latency_s", step_latency);
+    writer->WriteObjectKeyValue("engines", engines);
+    if (dump_requests) {
+      writer->WriteObjectKeyValue("requests", requests);
+    }
+    writer->EndObject();
+  }
+};
+
+/*! \brief Echo of the workload configuration, so a report is self-describing. */
+struct JSONConfig {
+  const BenchArgs* args;
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("model", args->model);
+    writer->WriteObjectKeyValue("num_requests", static_cast<int64_t>(args->workload.num_requests));
+    writer->WriteObjectKeyValue("request_rate", args->workload.request_rate);
+    writer->WriteObjectKeyValue("arrival", std::string(ArrivalProcessName(args->workload.arrival)));
+    writer->WriteObjectKeyValue("burst_size", static_cast<int64_t>(args->workload.burst_size));
+    writer->WriteObjectKeyValue("prompt_len_low",
+                                static_cast<int64_t>(args->workload.prompt_len.low));
+    writer->WriteObjectKeyValue("prompt_len_high",
+                                static_cast<int64_t>(args->workload.prompt_len.high));
+    writer->WriteObjectKeyValue("output_len_low",
+                                static_cast<int64_t>(args->workload.output_len.low));
+    writer->WriteObjectKeyValue("output_len_high",
+                                static_cast<int64_t>(args->workload.output_len.high));
+    writer->WriteObjectKeyValue("max_batch_size", static_cast<int64_t>(args->max_batch_size));
+    writer->WriteObjectKeyValue("vocab_size", static_cast<int64_t>(args->workload.vocab_size));
+    writer->WriteObjectKeyValue("seed", static_cast<int64_t>(args->workload.seed));
+    writer->EndObject();
+  }
+};
+
+/*! \brief Multi-device scaling efficiency relative to a single-device baseline. */
+struct JSONScaling {
+  int64_t num_devices{0};
+  double baseline_tps{0.0};
+  double scaled_tps{0.0};
+  double efficiency{0.0};
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("num_devices", num_devices);
+    writer->WriteObjectKeyValue("baseline_tps", baseline_tps);
+    writer->WriteObjectKeyValue("scaled_tps", scaled_tps);
+    writer->WriteObjectKeyValue("efficiency", efficiency);
+    writer->EndObject();
+  }
+};
+
+/*!
+ * \brief Run the workload over a set of devices, one engine per device.
+ *
+ *  Requests are assigned to engines round-robin by arrival order; every
+ *  engine thread measures against the same start instant so arrival times
+ *  are honored globally.
+ */
+RunReport RunWorkload(const BenchArgs& args, runtime::Module executable,
+                      const std::vector<DLDevice>& devices,
+                      const std::vector<std::string>& device_names,
+                      const std::vector<RequestSpec>& requests) {
+  size_t num_engines = devices.size();
+  std::vector<std::unique_ptr<ServingEngine>> engines;
+  for (size_t i = 0; i < num_engines; ++i) {
+    EngineConfig config;
+    config.device = devices[i];
+    config.step_func = args.step_func;
+    config.kv_cache_func = args.kv_cache_func;
+    config.max_batch_size = args.max_batch_size;
+    config.kv_sample_every = args.kv_sample_every;
+    config.vocab_size = args.workload.vocab_size;
+    config.seed = args.workload.seed + i;
+    engines.emplace_back(new ServingEngine(config, executable));
+  }
+
+  std::vector<std::vector<RequestSpec>> assignments(num_engines);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    assignments[i % num_engines].push_back(requests[i]);
+  }
+
+  std::vector<EngineResult> results(num_engines);
+  ServingEngine::Clock::time_point start = ServingEngine::Clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_engines; ++i) {
+    threads.emplace_back(
+        [&, i]() { results[i] = engines[i]->Run(assignments[i], start); });
+  }
+  for (std::thread& t : threads) t.join();
+  double wall_s =
+      std::chrono::duration<double>(ServingEngine::Clock::now() - start).count();
+
+  RunReport report;
+  report.devices = device_names;
+  report.wall_s = wall_s;
+  report.dump_requests = args.dump_requests;
+  std::vector<double> ttft_samples;
+  std::vector<double> tpot_samples;
+  std::vector<double> step_samples;
+  for (size_t i = 0; i < num_engines; ++i) {
+    JSONEngine engine;
+    engine.device = device_names[i];
+    engine.num_steps = static_cast<int64_t>(results[i].steps.size());
+    int64_t batch_tokens = 0;
+    for (const StepSample& step : results[i].steps) {
+      step_samples.push_back(step.latency_s);
+      batch_tokens += step.batch_tokens;
+    }
+    if (!results[i].steps.empty()) {
+      engine.mean_batch_tokens = 1.0 * batch_tokens / results[i].steps.size();
+    }
+    for (const KVCacheSample& sample : results[i].kv_samples) {
+      engine.kv_samples.push_back(JSONKVSample{sample});
+    }
+    report.engines.push_back(std::move(engine));
+    for (const RequestMetrics& metrics : results[i].requests) {
+      ++report.num_requests;
+      report.total_output_tokens += metrics.output_len;
+      ttft_samples.push_back(metrics.first_token_s - metrics.arrival_s);
+      if (metrics.output_len > 1) {
+        tpot_samples.push_back((metrics.finish_s - metrics.first_token_s) /
+                               (metrics.output_len - 1));
+      }
+      report.requests.push_back(JSONRequest{metrics});
+    }
+  }
+  report.request_throughput = report.num_requests / wall_s;
+  report.output_token_throughput = report.total_output_tokens / wall_s;
+  report.ttft = JSONLatency{Summarize(&ttft_samples)};
+  report.tpot = JSONLatency{Summarize(&tpot_samples)};
+  report.step_latency = JSONLatency{Summarize(&step_samples)};
+  return report;
+}
+
+int main(int argc, char* argv[]) {
+  BenchArgs args;
+  if (!ParseCmdArgs(argc, argv, &args)) {
+    LOG(INFO) << kUsage;
+    return 1;
+  }
+
+  runtime::Module executable = runtime::Module::LoadFromFile(args.model);
+  std::vector<RequestSpec> requests = GenerateWorkload(args.workload);
+
+  // The scaling baseline runs the same stream on the first device alone.
+  RunReport baseline;
+  bool has_baseline = args.measure_scaling && args.devices.size() > 1;
+  if (has_baseline) {
+    LOG(INFO) << "Running scaling baseline on " << args.device_names[0];
+    baseline = RunWorkload(args, executable, {args.devices[0]}, {args.device_names[0]}, requests);
+  }
+  LOG(INFO) << "Running workload on " << args.devices.size() << " device(s)";
+  RunReport report = RunWorkload(args, executable, args.devices, args.device_names, requests);
+
+  std::ostringstream body;
+  dmlc::JSONWriter writer(&body);
+  writer.BeginObject();
+  writer.WriteObjectKeyValue("config", JSONConfig{&args});
+  writer.WriteObjectKeyValue("run", report);
+  if (has_baseline) {
+    writer.WriteObjectKeyValue("baseline", baseline);
+    JSONScaling scaling;
+    scaling.num_devices = static_cast<int64_t>(args.devices.size());
+    scaling.baseline_tps = baseline.output_token_throughput;
+    scaling.scaled_tps = report.output_token_throughput;
+    scaling.efficiency =
+        baseline.output_token_throughput > 0.0
+            ? report.output_token_throughput /
+                  (args.devices.size() * baseline.output_token_throughput)
+            : 0.0;
+    writer.WriteObjectKeyValue("scaling", scaling);
+  }
+  writer.EndObject();
+
+  if (args.output.empty()) {
+    std::cout << body.str() << std::endl;
+  } else {
+    std::ofstream out(args.output);
+    CHECK(out) << "Cannot open output file " << args.output;
+    out << body.str() << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file serving_engine.cc
+ * \brief A minimal continuous-batching driver of a relax VM serving module.
+ */
+#include "serving_engine.h"
+
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/memory/memory_manager.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <deque>
+#include <thread>
+
+namespace tvm {
+namespace bench_serving {
+
+using runtime::Map;
+using runtime::NDArray;
+using runtime::ObjectRef;
+using runtime::PackedFunc;
+using runtime::ShapeTuple;
+using runtime::String;
+
+namespace {
+
+/*! \brief Seconds elapsed since a steady clock instant. */
+double ElapsedSeconds(ServingEngine::Clock::time_point start) {
+  return std::chrono::duration<double>(ServingEngine::Clock::now() - start).count();
+}
+
+}  // namespace
+
+ServingEngine::ServingEngine(const EngineConfig& config, runtime::Module executable)
+    : config_(config), rng_(config.seed) {
+  PackedFunc load_exec = executable.GetFunction("vm_load_executable", /*query_imports=*/true);
+  CHECK(load_exec != nullptr) << "Module is not a relax executable";
+  vm_ = load_exec();
+  // The VM always needs a CPU context for shape computations next to the
+  // target device, matching the python-side VirtualMachine setup.
+  int alloc = static_cast<int>(runtime::memory::AllocatorType::kPooled);
+  PackedFunc init = vm_.GetFunction("vm_initialization");
+  if (config_.device.device_type == kDLCPU) {
+    init(static_cast<int>(config_.device.device_type), config_.device.device_id, alloc);
+  } else {
+    init(static_cast<int>(config_.device.device_type), config_.device.device_id, alloc,
+         static_cast<int>(kDLCPU), 0, alloc);
+  }
+
+  step_func_ = vm_.GetFunction(config_.step_func, true);
+  CHECK(step_func_ != nullptr) << "Module does not expose step function \"" << config_.step_func
+                               << "\"";
+
+  if (!config_.kv_cache_func.empty()) {
+    PackedFunc create_cache = vm_.GetFunction(config_.kv_cache_func, true);
+    CHECK(create_cache != nullptr) << "Module does not expose KV cache creation function \""
+                                   << config_.kv_cache_func << "\"";
+    kv_cache_ = create_cache();
+    auto lookup = [](const char* name) {
+      const PackedFunc* pf = runtime::Registry::Get(name);
+      CHECK(pf != nullptr) << "Cannot find global function " << name;
+      return *pf;
+    };
+    fadd_sequence_ = lookup("vm.builtin.kv_state_add_sequence");
+    fremove_sequence_ = lookup("vm.builtin.kv_state_remove_sequence");
+    fbegin_forward_ = lookup("vm.builtin.kv_state_begin_forward");
+    fend_forward_ = lookup("vm.builtin.kv_state_end_forward");
+    // The stats surface is optional; occupancy sampling is skipped without it.
+    if (const PackedFunc* pf = runtime::Registry::Get("vm.builtin.kv_cache_debug_stats")) {
+      fdebug_stats_ = *pf;
+    }
+  }
+}
+
+NDArray ServingEngine::MakeTokenIds(int num_tokens) {
+  NDArray host = NDArray::Empty({1, num_tokens}, DLDataType{kDLInt, 32, 1}, DLDevice{kDLCPU, 0});
+  auto* data = static_cast<int32_t*>(host->data);
+  std::uniform_int_distribution<int32_t> token_dist(0, config_.vocab_size - 1);
+  for (int i = 0; i < num_tokens; ++i) {
+    data[i] = token_dist(rng_);
+  }
+  if (config_.device.device_type == kDLCPU) return host;
+  return host.CopyTo(config_.device);
+}
+
+void ServingEngine::SampleKVCache(double t_s, EngineResult* result) {
+  if (fdebug_stats_ == nullptr) return;
+  Map<String, ObjectRef> stats = fdebug_stats_(kv_cache_);
+  KVCacheSample sample;
+  sample.t_s = t_s;
+  sample.pages_in_use = stats["num_pages_in_use"].as<runtime::profiling::CountNode>()->value;
+  sample.page_utilization = stats["page_utilization"].as<runtime::profiling::RatioNode>()->ratio;
+  sample.num_sequences = stats["num_sequences"].as<runtime::profiling::CountNode>()->value;
+  result->kv_samples.push_back(sample);
+}
+
+EngineResult ServingEngine::Run(const std::vector<RequestSpec>& requests,
+                                Clock::time_point start) {
+  EngineResult result;
+  result.requests.reserve(requests.size());
+
+  std::deque<InFlight> active;
+  size_t next_arrival = 0;
+  size_t completed = 0;
+  int64_t num_steps = 0;
+
+  while (completed < requests.size()) {
+    // Admit every request that has arrived, up to the batch capacity.
+    double now = ElapsedSeconds(start);
+    while (next_arrival < requests.size() &&
+           static_cast<int>(active.size()) < config_.max_batch_size &&
+           requests[next_arrival].arrival_s <= now) {
+      const RequestSpec& spec = requests[next_arrival];
+      if (kv_cache_.defined()) {
+        fadd_sequence_(kv_cache_, spec.id);
+      }
+      InFlight entry;
+      entry.spec = &spec;
+      active.push_back(entry);
+      ++next_arrival;
+    }
+    if (active.empty()) {
+      // Nothing in flight: sleep through the idle gap until the next arrival.
+      auto wake = start + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(requests[next_arrival].arrival_s));
+      std::this_thread::sleep_until(wake);
+      continue;
+    }
+
+    // Build one forward round over all in-flight requests: pending prompts
+    // contribute their full length, decoding requests one token each.
+    std::vector<int64_t> seq_ids;
+    std::vector<int64_t> append_lengths;
+    int total_tokens = 0;
+    for (const InFlight& entry : active) {
+      int len = entry.prefilled ? 1 : entry.spec->prompt_len;
+      seq_ids.push_back(entry.spec->id);
+      append_lengths.push_back(len);
+      total_tokens += len;
+    }
+    NDArray token_ids = MakeTokenIds(total_tokens);
+
+    double t_begin = ElapsedSeconds(start);
+    if (kv_cache_.defined()) {
+      fbegin_forward_(kv_cache_, ShapeTuple(seq_ids), ShapeTuple(append_lengths));
+      step_func_(token_ids, kv_cache_);
+      fend_forward_(kv_cache_);
+    } else {
+      step_func_(token_ids);
+    }
+    TVMSynchronize(config_.device.device_type, config_.device.device_id, nullptr);
+    double t_end = ElapsedSeconds(start);
+
+    StepSample step;
+    step.t_s = t_end;
+    step.latency_s = t_end - t_begin;
+    step.batch_requests = static_cast<int>(active.size());
+    step.batch_tokens = total_tokens;
+    result.steps.push_back(step);
+    ++num_steps;
+    if (config_.kv_sample_every > 0 && num_steps % config_.kv_sample_every == 0) {
+      SampleKVCache(t_end, &result);
+    }
+
+    // Each round yields one token per in-flight request; retire the finished ones.
+    for (auto it = active.begin(); it != active.end();) {
+      if (!it->prefilled) {
+        it->prefilled = true;
+        it->first_token_s = t_end;
+      }
+      ++it->generated;
+      if (it->generated >= it->spec->output_len) {
+        if (kv_cache_.defined()) {
+          fremove_sequence_(kv_cache_, it->spec->id);
+        }
+        RequestMetrics metrics;
+        metrics.id = it->spec->id;
+        metrics.arrival_s = it->spec->arrival_s;
+        metrics.first_token_s = it->first_token_s;
+        metrics.finish_s = t_end;
+        metrics.prompt_len = it->spec->prompt_len;
+        metrics.output_len = it->spec->output_len;
+        result.requests.push_back(metrics);
+        ++completed;
+        it = active.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace bench_serving
+}  // namespace tvm
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file serving_engine.h
+ * \brief A minimal continuous-batching driver of a relax VM serving module.
+ */
+#ifndef TVM_APPS_BENCH_SERVING_SERVING_ENGINE_H_
+#define TVM_APPS_BENCH_SERVING_SERVING_ENGINE_H_
+
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "workload.h"
+
+namespace tvm {
+namespace bench_serving {
+
+/*! \brief Configuration of one engine instance. */
+struct EngineConfig {
+  /*! \brief The device this engine runs on. */
+  DLDevice device{kDLCPU, 0};
+  /*! \brief Name of the forward step function in the VM module. */
+  std::string step_func{"step"};
+  /*! \brief Optional name of a KV cache creation function; empty disables cache driving. */
+  std::string kv_cache_func;
+  /*! \brief Maximum number of in-flight requests per forward round. */
+  int max_batch_size{32};
+  /*! \brief Sample the KV cache stats every this many engine steps (0 disables). */
+  int kv_sample_every{1};
+  /*! \brief Vocabulary size used to draw random token ids. */
+  int vocab_size{32000};
+  /*! \brief Seed of the token id generator. */
+  uint64_t seed{0};
+};
+
+/*! \brief Per-request completion record, times in seconds from run start. */
+struct RequestMetrics {
+  int64_t id;
+  double arrival_s;
+  /*! \brief Completion time of the step that processed the prompt (TTFT endpoint). */
+  double first_token_s;
+  /*! \brief Completion time of the last decode step. */
+  double finish_s;
+  int prompt_len;
+  int output_len;
+};
+
+/*! \brief One engine forward round. */
+struct StepSample {
+  /*! \brief Completion time in seconds from run start. */
+  double t_s;
+  /*! \brief Wall time of the forward call including device sync. */
+  double latency_s;
+  int batch_requests;
+  int batch_tokens;
+};
+
+/*! \brief KV cache stats snapshot, taken through vm.builtin.kv_cache_debug_stats. */
+struct KVCacheSample {
+  double t_s;
+  int64_t pages_in_use;
+  double page_utilization;
+  int64_t num_sequences;
+};
+
+/*! \brief Measurements of one engine over one run. */
+struct EngineResult {
+  std::vector<RequestMetrics> requests;
+  std::vector<StepSample> steps;
+  std::vector<KVCacheSample> kv_samples;
+};
+
+/*!
+ * \brief Drives one relax VM instance with a request stream.
+ *
+ *  The engine owns a VM created from the executable module and, when
+ *  configured, a KV cache created by the module's cache creation function.
+ *  Requests are admitted as they arrive up to max_batch_size; each engine
+ *  step batches the pending prompt and decode tokens of all in-flight
+ *  requests into one call of the step function, bracketed by the generic
+ *  vm.builtin.kv_state_{begin,end}_forward calls. See the README for the
+ *  module contract.
+ */
+class ServingEngine {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * \brief Construct an engine.
+   * \param config The engine configuration.
+   * \param executable The compiled relax executable module.
+   */
+  ServingEngine(const EngineConfig& config, runtime::Module executable);
+
+  /*!
+   * \brief Process a request stream to completion.
+   * \param requests The requests assigned to this engine, sorted by arrival.
+   * \param start The common start instant arrival times are relative to.
+   * \return The recorded measurements.
+   */
+  EngineResult Run(const std::vector<RequestSpec>& requests, Clock::time_point start);
+
+ private:
+  /*! \brief An admitted request. */
+  struct InFlight {
+    const RequestSpec* spec;
+    /*! \brief Whether the prompt has been processed. */
+    bool prefilled{false};
+    /*! \brief Number of decoded tokens so far. */
+    int generated{0};
+    double first_token_s{0.0};
+  };
+
+  /*! \brief Draw num_tokens random ids and place them on the engine device. */
+  runtime::NDArray MakeTokenIds(int num_tokens);
+  /*! \brief Snapshot the KV cache stats if the surface is available. */
+  void SampleKVCache(double t_s, EngineResult* result);
+
+  EngineConfig config_;
+  runtime::Module vm_;
+  runtime::PackedFunc step_func_;
+  runtime::ObjectRef kv_cache_;
+  // Generic KVState drivers looked up from the global registry.
+  runtime::PackedFunc fadd_sequence_;
+  runtime::PackedFunc fremove_sequence_;
+  runtime::PackedFunc fbegin_forward_;
+  runtime::PackedFunc fend_forward_;
+  runtime::PackedFunc fdebug_stats_;
+  std::mt19937_64 rng_;
+};
+
+}  // namespace bench_serving
+}  // namespace tvm
+
+#endif  // TVM_APPS_BENCH_SERVING_SERVING_ENGINE_H_
@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file workload.cc
+ * \brief Synthetic request stream generation and latency summaries.
+ */
+#include "workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace tvm {
+namespace bench_serving {
+
+std::vector<RequestSpec> GenerateWorkload(const WorkloadConfig& config) {
+  std::mt19937_64 rng(config.seed);
+  std::uniform_int_distribution<int> prompt_dist(config.prompt_len.low, config.prompt_len.high);
+  std::uniform_int_distribution<int> output_dist(config.output_len.low, config.output_len.high);
+  std::exponential_distribution<double> exp_dist(config.request_rate);
+
+  std::vector<RequestSpec> requests;
+  requests.reserve(config.num_requests);
+  double now = 0.0;
+  for (int i = 0; i < config.num_requests; ++i) {
+    RequestSpec spec;
+    spec.id = i;
+    spec.prompt_len = prompt_dist(rng);
+    spec.output_len = output_dist(rng);
+    switch (config.arrival) {
+      case ArrivalProcess::kPoisson:
+        now += exp_dist(rng);
+        break;
+      case ArrivalProcess::kUniform:
+        now += 1.0 / config.request_rate;
+        break;
+      case ArrivalProcess::kBurst:
+        // A whole burst shares one arrival instant; the gap between bursts
+        // keeps the long-run rate at request_rate.
+        if (i != 0 && i % config.burst_size == 0) {
+          now += config.burst_size / config.request_rate;
+        }
+        break;
+    }
+    spec.arrival_s = now;
+    requests.push_back(spec);
+  }
+  return requests;
+}
+
+LatencySummary Summarize(std::vector<double>* samples) {
+  LatencySummary summary;
+  if (samples->empty()) return summary;
+  std::sort(samples->begin(), samples->end());
+  double total = 0.0;
+  for (double v : *samples) total += v;
+  auto percentile = [&](double p) {
+    size_t idx = static_cast<size_t>(std::ceil(p * samples->size())) - 1;
+    return (*samples)[std::min(idx, samples->size() - 1)];
+  };
+  summary.count = static_cast<int64_t>(samples->size());
+  summary.mean = total / samples->size();
+  summary.p50 = percentile(0.50);
+  summary.p90 = percentile(0.90);
+  summary.p95 = percentile(0.95);
+  summary.p99 = percentile(0.99);
+  summary.max = samples->back();
+  return summary;
+}
+
+bool ParseArrivalProcess(const std::string& name, ArrivalProcess* out) {
+  if (name == "poisson") {
+    *out = ArrivalProcess::kPoisson;
+  } else if (name == "uniform") {
+    *out = ArrivalProcess::kUniform;
+  } else if (name == "burst") {
+    *out = ArrivalProcess::kBurst;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* ArrivalProcessName(ArrivalProcess arrival) {
+  switch (arrival) {
+    case ArrivalProcess::kPoisson:
+      return "poisson";
+    case ArrivalProcess::kUniform:
+      return "uniform";
+    case ArrivalProcess::kBurst:
+      return "burst";
+  }
+  return "unknown";
+}
+
+bool ParseLengthRange(const std::string& spec, LengthRange* out) {
+  size_t colon = spec.find(':');
+  try {
+    if (colon == std::string::npos) {
+      out->low = out->high = std::stoi(spec);
+    } else {
+      out->low = std::stoi(spec.substr(0, colon));
+      out->high = std::stoi(spec.substr(colon + 1));
+    }
+  } catch (const std::exception&) {
+    return false;
+  }
+  return out->low > 0 && out->high >= out->low;
+}
+
+}  // namespace bench_serving
+}  // namespace tvm
@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file workload.h
+ * \brief Synthetic request stream generation and latency summaries.
+ */
+#ifndef TVM_APPS_BENCH_SERVING_WORKLOAD_H_
+#define TVM_APPS_BENCH_SERVING_WORKLOAD_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace bench_serving {
+
+/*! \brief Supported request arrival processes. */
+enum class ArrivalProcess {
+  /*! \brief Poisson arrivals: exponential inter-arrival times at the given rate. */
+  kPoisson,
+  /*! \brief Evenly spaced arrivals at the given rate. */
+  kUniform,
+  /*! \brief Bursts of burst_size simultaneous arrivals, spaced to match the given rate. */
+  kBurst,
+};
+
+/*! \brief Inclusive integer range; low == high gives a fixed length. */
+struct LengthRange {
+  int low{0};
+  int high{0};
+};
+
+/*! \brief Configuration of the synthetic workload. */
+struct WorkloadConfig {
+  /*! \brief Total number of requests in the stream. */
+  int num_requests{256};
+  /*! \brief Mean arrival rate in requests per second. */
+  double request_rate{8.0};
+  /*! \brief The arrival process. */
+  ArrivalProcess arrival{ArrivalProcess::kPoisson};
+  /*! \brief Requests per burst when arrival == kBurst. */
+  int burst_size{16};
+  /*! \brief Prompt length distribution. */
+  LengthRange prompt_len{128, 128};
+  /*! \brief Output (decode) length distribution. */
+  LengthRange output_len{64, 64};
+  /*! \brief Vocabulary size used to draw random token ids. */
+  int vocab_size{32000};
+  /*! \brief Seed of the workload generator. */
+  uint64_t seed{0};
+};
+
+/*! \brief One request of the generated stream. */
+struct RequestSpec {
+  /*! \brief The request id, also used as the KV cache sequence id. */
+  int64_t id;
+  /*! \brief Arrival time in seconds from the start of the run. */
+  double arrival_s;
+  /*! \brief Number of prompt tokens. */
+  int prompt_len;
+  /*! \brief Number of tokens to decode. */
+  int output_len;
+};
+
+/*!
+ * \brief Generate the request stream of a workload, sorted by arrival time.
+ * \param config The workload configuration.
+ * \return The generated requests.
+ */
+std::vector<RequestSpec> GenerateWorkload(const WorkloadConfig& config);
+
+/*! \brief Summary statistics of a latency sample set, in seconds. */
+struct LatencySummary {
+  int64_t count{0};
+  double mean{0.0};
+  double p50{0.0};
+  double p90{0.0};
+  double p95{0.0};
+  double p99{0.0};
+  double max{0.0};
+};
+
+/*!
+ * \brief Summarize a set of latency samples.
+ * \param samples The samples in seconds; consumed (sorted in place).
+ * \return The summary; all-zero if samples is empty.
+ */
+LatencySummary Summarize(std::vector<double>* samples);
+
+/*!
+ * \brief Parse an arrival process name.
+ * \param name One of "poisson", "uniform", "burst".
+ * \param out The parsed process.
+ * \return Whether the name was recognized.
+ */
+bool ParseArrivalProcess(const std::string& name, ArrivalProcess* out);
+
+/*! \return the name of an arrival process. */
+const char* ArrivalProcessName(ArrivalProcess arrival);
+
+/*!
+ * \brief Parse a length range given as "n" or "low:high".
+ * \param spec The textual range.
+ * \param out The parsed range.
+ * \return Whether the spec was well-formed.
+ */
+bool ParseLengthRange(const std::string& spec, LengthRange* out);
+
+}  // namespace bench_serving
+}  // namespace tvm
+
+#endif  // TVM_APPS_BENCH_SERVING_WORKLOAD_H_
@@ -135,6 +135,9 @@ set(USE_CPP_RPC OFF)
 # Whether to build the C++ native runtime tool binary
 set(USE_CPP_RTVM OFF)
 
+# Whether to build the serving load benchmark harness
+set(USE_BENCH_SERVING OFF)
+
 # Whether to build the iOS RPC server application
 set(USE_IOS_RPC OFF)
 
@@ -221,6 +224,9 @@ set(USE_RANDOM ON)
 # Whether use NNPack
 set(USE_NNPACK OFF)
 
+# Whether to support zstd-compressed ndarray cache shards (requires libzstd)
+set(USE_ZSTD OFF)
+
 # Possible values:
 # - ON: enable tflite with cmake's find search
 # - OFF: disable tflite
@@ -99,6 +99,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_METAL="${USE_METAL}"
     TVM_INFO_USE_MICRO_STANDALONE_RUNTIME="${USE_MICRO_STANDALONE_RUNTIME}"
     TVM_INFO_USE_MICRO="${USE_MICRO}"
+    TVM_INFO_USE_MINIMAL_CHECKS="${USE_MINIMAL_CHECKS}"
     TVM_INFO_USE_MIOPEN="${USE_MIOPEN}"
     TVM_INFO_USE_MKL="${USE_MKL}"
     TVM_INFO_USE_MRVL="${USE_MRVL}"
@@ -28,6 +28,15 @@ if(USE_CUSTOM_LOGGING)
   target_compile_definitions(tvm_runtime PUBLIC TVM_LOG_CUSTOMIZE=1)
 endif()
 
+if(USE_MINIMAL_CHECKS)
+  # Set and propogate TVM_CHECKS_MINIMAL flag when minimal checks have been requested
+  target_compile_definitions(tvm_objs PUBLIC TVM_CHECKS_MINIMAL=1)
+  target_compile_definitions(tvm_runtime_objs PUBLIC TVM_CHECKS_MINIMAL=1)
+  target_compile_definitions(tvm_libinfo_objs PUBLIC TVM_CHECKS_MINIMAL=1)
+  target_compile_definitions(tvm PUBLIC TVM_CHECKS_MINIMAL=1)
+  target_compile_definitions(tvm_runtime PUBLIC TVM_CHECKS_MINIMAL=1)
+endif()
+
 add_library(libbacktrace STATIC IMPORTED)
 
 set(LIBBACKTRACE_INCLUDE_DIR NOTFOUND)
@@ -0,0 +1,28 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+if(USE_ZSTD)
+  find_path(ZSTD_INCLUDE_DIR zstd.h)
+  find_library(ZSTD_LIBRARY zstd)
+  if(NOT ZSTD_INCLUDE_DIR OR NOT ZSTD_LIBRARY)
+    message(FATAL_ERROR "Cannot find zstd, USE_ZSTD=" ${USE_ZSTD})
+  endif()
+  message(STATUS "Build with zstd support: " ${ZSTD_LIBRARY})
+  include_directories(SYSTEM ${ZSTD_INCLUDE_DIR})
+  list(APPEND TVM_RUNTIME_LINKER_LIBS ${ZSTD_LIBRARY})
+  add_definitions(-DTVM_USE_ZSTD=1)
+endif(USE_ZSTD)
@@ -53,6 +53,8 @@
 #include <tvm/ir/expr.h>
 #include <tvm/tir/var.h>
 
+#include <memory>
+
 namespace tvm {
 namespace arith {
 
@@ -357,6 +359,44 @@ Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, R
                                 const PrimExpr& input_pred, IterMapLevel check_level,
                                 arith::Analyzer* analyzer, bool simplify_trivial_iterators = true);
 
+/*!
+ * \brief Simplifier that amortizes the iterator-context setup of IterMapSimplify.
+ *
+ *  IterMapSimplify spends a large part of its time parsing the input predicate into
+ *  bound constraints and sanity-checking the iterator ranges, which is wasted work
+ *  when it is called once per buffer access against the same iterator domain, as in
+ *  layout transformation. This class performs the setup once in the constructor and
+ *  lets Simplify be invoked repeatedly for every batch of access indices.
+ */
+class IterMapSimplifier {
+ public:
+  /*!
+   * \brief Construct the simplifier by parsing the shared iterator context.
+   * \param input_iters Map from variable to iterator's range.
+   * \param input_pred The predicate constraints on the input iterators.
+   * \param check_level The iter mapping checking level.
+   * \param analyzer Analyzer used to get context information.
+   * \param simplify_trivial_iterators If true, iterators with unit extents are simplified.
+   */
+  TVM_DLL IterMapSimplifier(const Map<Var, Range>& input_iters, const PrimExpr& input_pred,
+                            IterMapLevel check_level, arith::Analyzer* analyzer,
+                            bool simplify_trivial_iterators = true);
+
+  TVM_DLL ~IterMapSimplifier();
+
+  /*!
+   * \brief Use IterVarMap detector to rewrite and simplify the indices.
+   * \param indices The indices to detect pattern for.
+   * \return The indices after rewrite; the input indices on failure.
+   */
+  TVM_DLL Array<PrimExpr> Simplify(const Array<PrimExpr>& indices);
+
+ private:
+  struct Impl;
+  /*! \brief Internal state holding the pre-parsed constraints. */
+  std::unique_ptr<Impl> impl_;
+};
+
 /*!
  * \brief Apply the inverse of the affine transformation to the outputs.
  *
@@ -158,6 +158,32 @@ class OpNode : public RelayExprNode {
   }
 };
 
+/*!
+ * \brief Dense token of an op attribute key.
+ *
+ *  Construction resolves the attribute name to a process-wide dense id, so
+ *  GetAttrMap calls that take the token index the attribute table directly
+ *  instead of hashing the name. Declare tokens once at static-init (e.g. as
+ *  a namespace level constant or function-local static) and reuse them on
+ *  the hot path.
+ *
+ * \sa Op::GetAttrMap
+ */
+class OpAttrToken {
+ public:
+  /*!
+   * \brief Resolve the token of an attribute key.
+   * \param attr_name The name of the attribute.
+   */
+  TVM_DLL explicit OpAttrToken(const String& attr_name);
+  /*! \return the dense id of the attribute key. */
+  uint32_t token() const { return token_; }
+
+ private:
+  /*! \brief The dense id of the attribute key. */
+  uint32_t token_;
+};
+
 /*!
  * \brief Managed reference class to OpNode.
  * \sa OpNode
@@ -173,6 +199,15 @@ class Op : public RelayExpr {
    */
   template <typename ValueType>
   inline static OpAttrMap<ValueType> GetAttrMap(const String& attr_name);
+  /*!
+   * \brief Get additional registered attribute about operators by key token.
+   *  Same as the name based overload, minus the per-call string hashing.
+   * \param attr_key The pre-resolved token of the attribute key.
+   * \return An OpAttrMap of the specified attribute.
+   * \tparam ValueType The type of the attribute.
+   */
+  template <typename ValueType>
+  inline static OpAttrMap<ValueType> GetAttrMap(const OpAttrToken& attr_key);
   /*!
    * \brief Checks if an attr map is present in the registry.
    * \param attr_name The name of the attribute.
@@ -196,6 +231,13 @@ class Op : public RelayExpr {
    * \return The attr map.
    */
   TVM_DLL static const AttrRegistryMapContainerMap<Op>& GetAttrMapContainer(const String& key);
+  /*!
+   * \brief Get generic attrmap given a pre-resolved attr key token
+   * \param attr_key The attribute key token
+   * \return The attr map.
+   */
+  TVM_DLL static const AttrRegistryMapContainerMap<Op>& GetAttrMapContainer(
+      const OpAttrToken& attr_key);
 };
 
 /*!
@@ -366,6 +408,11 @@ inline OpAttrMap<ValueType> Op::GetAttrMap(const String& key) {
   return OpAttrMap<ValueType>(Op::GetAttrMapContainer(key));
 }
 
+template <typename ValueType>
+inline OpAttrMap<ValueType> Op::GetAttrMap(const OpAttrToken& attr_key) {
+  return OpAttrMap<ValueType>(Op::GetAttrMapContainer(attr_key));
+}
+
 inline OpNode* OpRegEntry::get() { return const_cast<OpNode*>(op_.operator->()); }
 
 inline OpRegEntry& OpRegEntry::describe(const std::string& descr) {  // NOLINT(*)
@@ -21,8 +21,10 @@
 #define TVM_META_SCHEDULE_COST_MODEL_H_
 
 #include <tvm/meta_schedule/arg_info.h>
+#include <tvm/meta_schedule/feature_extractor.h>
 #include <tvm/meta_schedule/measure_candidate.h>
 #include <tvm/meta_schedule/runner.h>
+#include <tvm/runtime/module.h>
 #include <tvm/node/reflection.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/string.h>
@@ -145,6 +147,44 @@ class PyCostModelNode : public CostModelNode {
   TVM_DECLARE_FINAL_OBJECT_INFO(PyCostModelNode, CostModelNode);
 };
 
+/*!
+ * \brief A cost model that runs a pre-trained model in-process through a runtime module.
+ * \details
+ * The feature matrices are extracted natively by the configured feature extractor and handed
+ * directly to the `predict` function of the loaded runtime module, so prediction crosses no
+ * language boundary and no candidate objects are serialized per query. The runtime module
+ * wraps the exported model (e.g. a compiled tree ensemble) and may execute on any device;
+ * it receives the per-candidate feature matrices as an array of NDArrays and must return
+ * one score per candidate as a float64 NDArray on the host.
+ *
+ * The model is inference-only: `Update` keeps no state and `Save` is not supported.
+ */
+class ModuleCostModelNode : public CostModelNode {
+ public:
+  /*! \brief The feature extractor that produces the per-candidate feature matrices. */
+  FeatureExtractor extractor{nullptr};
+  /*! \brief The runtime module that wraps the pre-trained model. */
+  runtime::Module model;
+  /*! \brief The `predict` function of the runtime module. */
+  runtime::PackedFunc predict_func{nullptr};
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("extractor", &extractor);
+    // `model` is not visited
+    // `predict_func` is not visited
+  }
+
+  void Load(const String& path);
+  void Save(const String& path);
+  void Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
+              const Array<RunnerResult>& results);
+  std::vector<double> Predict(const TuneContext& context,
+                              const Array<MeasureCandidate>& candidates);
+
+  static constexpr const char* _type_key = "meta_schedule.ModuleCostModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ModuleCostModelNode, CostModelNode);
+};
+
 /*!
  * \brief Managed reference to CostModelNode
  * \sa CostModelNode
@@ -165,6 +205,13 @@ class CostModel : public runtime::ObjectRef {
                                        PyCostModelNode::FUpdate f_update,    //
                                        PyCostModelNode::FPredict f_predict,  //
                                        PyCostModelNode::FAsString f_as_string);
+  /*!
+   * \brief Create a cost model that runs a pre-trained model in-process.
+   * \param extractor The feature extractor producing the per-candidate feature matrices.
+   * \param path The path of the exported model, loadable as a runtime module.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel ModuleCostModel(FeatureExtractor extractor, String path);
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CostModel, ObjectRef, CostModelNode);
 };
 
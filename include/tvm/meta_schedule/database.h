@@ -223,6 +223,21 @@ class DatabaseNode : public runtime::Object {
    * \return An array of top K tuning records for the given workload.
    */
   virtual Array<TuningRecord> GetTopK(const Workload& workload, int top_k) = 0;
+  /*!
+   * \brief Get the top K valid tuning records of workloads similar to the given module.
+   *
+   *  Unlike `GetTopK`, which serves exact workload matches only, this indexes the stored
+   *  workloads by their op signature and loop-extent fingerprint and returns records from
+   *  near-matching workloads, e.g. the same kernel tuned at different shapes. The returned
+   *  traces are candidates for transfer: they were recorded against a different module and
+   *  may fail to re-apply, so callers must tolerate application failures.
+   *
+   * \param mod The IRModule whose similar workloads are searched for.
+   * \param top_k The number of top records to be returned.
+   * \return An array of at most K tuning records from similar workloads, nearest first.
+   *  Records of workloads that match the module exactly are excluded.
+   */
+  virtual Array<TuningRecord> GetSimilarTopK(const IRModule& mod, int top_k);
   /*!
    * \brief Get all tuning records from the database.
    * \return An Array of all the tuning records in the database.
@@ -480,9 +495,24 @@ class Database : public runtime::ObjectRef {
    * \param path_tuning_record The path to the database table.
    * \param allow_missing Whether to create new file when the given path is not found.
    * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   * \param commit_batch_size The number of tuning records buffered in memory before they are
+   * written to the record file in one batch. The default of 1 writes through on every commit;
+   * larger values amortize the file I/O when measurement throughput is high. Buffered records
+   * are flushed when the database is destructed.
    */
   TVM_DLL static Database JSONDatabase(String path_workload, String path_tuning_record,
-                                       bool allow_missing, String mod_eq_name = "structural");
+                                       bool allow_missing, String mod_eq_name = "structural",
+                                       int commit_batch_size = 1);
+  /*!
+   * \brief Create a database sharded over multiple append-only record files, with tuning
+   * records bucketed per workload so top-k queries do not scan unrelated records.
+   * \param path The path to the database directory.
+   * \param num_shards The number of record shards to spread commits over.
+   * \param allow_missing Whether to create new files when the given path holds none.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database ShardedDatabase(String path, int num_shards, bool allow_missing,
+                                          String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
@@ -149,6 +149,15 @@ class Postproc : public runtime::ObjectRef {
    * \return The postprocessor created
    */
   TVM_DLL static Postproc VerifyGPUCode();
+  /*!
+   * \brief Creates a postprocessor that compiles each candidate through the target compiler
+   *  and prunes candidates that spill registers or fall below an occupancy floor, before
+   *  any device measurement is spent on them.
+   * \param min_occupancy_percent The minimum register-limited occupancy in percent;
+   *  0 disables the occupancy check and prunes spilling candidates only.
+   * \return The postprocessor created
+   */
+  TVM_DLL static Postproc VerifyRegisterUsage(int min_occupancy_percent = 0);
   /*!
    * \brief Verifies that the VTCM usage of a given schedule is within the provided limit.
    * \return The postprocessor created
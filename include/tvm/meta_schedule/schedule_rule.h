@@ -235,6 +235,17 @@ class ScheduleRule : public runtime::ObjectRef {
    */
   TVM_DLL static ScheduleRule AddRFactor(int max_jobs_per_core,  //
                                          Optional<Integer> max_innermost_factor);
+  /*!
+   * \brief Create a rule that tiles a block with a cache-oblivious loop structure,
+   * halving every data-parallel and reduction axis level by level instead of sampling
+   * tile sizes, so the resulting schedule is portable across cache hierarchies
+   * \param depth The maximum number of halving levels, i.e. the recursion depth of the
+   * cache-oblivious subdivision lowered to iterative tiling
+   * \param min_inner_extent Stop halving an axis once its tile extent would drop below
+   * this, e.g. to keep the innermost tile vectorizable
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule CacheObliviousTiling(int depth, int min_inner_extent);
   /*!
    * \brief Create a schedule rule which applies cross-thread reduction to some reduction blocks
    * correspondingly when needed
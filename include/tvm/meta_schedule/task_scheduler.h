@@ -53,6 +53,10 @@ class TaskRecordNode : public runtime::Object {
   int run_error_count = 0;
   /*! \brief The latency of each run, in milliseconds. */
   std::vector<double> latency_ms = {};
+  /*! \brief Wallclock seconds this task has spent in the builder. */
+  double build_seconds = 0.0;
+  /*! \brief Wallclock seconds this task has spent sending to and waiting on the runner. */
+  double run_seconds = 0.0;
   /*! \brief The measure candidates. */
   Optional<Array<MeasureCandidate>> measure_candidates = NullOpt;
   /*! \brief The building results. */
@@ -68,6 +72,8 @@ class TaskRecordNode : public runtime::Object {
     v->Visit("build_error_count", &build_error_count);
     v->Visit("run_error_count", &run_error_count);
     // `latency_ms` is not visited
+    v->Visit("build_seconds", &build_seconds);
+    v->Visit("run_seconds", &run_seconds);
     v->Visit("measure_candidates", &measure_candidates);
     v->Visit("builder_results", &builder_results);
     v->Visit("runner_futures", &runner_futures);
@@ -273,10 +279,13 @@ class TaskScheduler : public runtime::ObjectRef {
    * \param alpha The parameter alpha to control gradient computation.
    * \param window_size The parameter to control backward window size.
    * \param seed The random seed.
+   * \param stall_rounds The number of consecutive non-improving measurement rounds after which a
+   *  task is preempted. 0 means never preempt.
    * \return The task scheduler created.
    */
   TVM_DLL static TaskScheduler GradientBased(PackedFunc logger, double alpha, int window_size,
-                                             support::LinearCongruentialEngine::TRandState seed);
+                                             support::LinearCongruentialEngine::TRandState seed,
+                                             int stall_rounds);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
    * \param logger The tuning task's logging function.
@@ -32,6 +32,8 @@
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -72,6 +74,36 @@ class AttrVisitor {
   //! \endcond
 };
 
+/*! \brief Kind of a reflected field, mirroring the AttrVisitor overloads. */
+enum class AttrFieldKind : int32_t {
+  kDouble = 0,
+  kInt64 = 1,
+  kUInt64 = 2,
+  kInt = 3,
+  kBool = 4,
+  kString = 5,
+  kVoidPtr = 6,
+  kDataType = 7,
+  kNDArray = 8,
+  kObjectRef = 9,
+};
+
+/*!
+ * \brief Flat metadata record describing one reflected field of a node type.
+ *
+ * A table of these records is built once per type and lets reflection
+ * consumers iterate an array and address fields directly, instead of
+ * re-running VisitAttrs with a virtual call per field on every node.
+ */
+struct AttrFieldInfo {
+  /*! \brief The field name. Points at the string literal passed to Visit. */
+  const char* name;
+  /*! \brief The kind of the field. */
+  AttrFieldKind kind;
+  /*! \brief Byte offset of the field from the start of the object. */
+  size_t offset;
+};
+
 /*!
  * \brief Virtual function table to support IR/AST node reflection.
  *
@@ -176,6 +208,35 @@ class ReflectionVTable {
    */
   TVM_DLL std::vector<std::string> ListAttrNames(Object* self) const;
 
+  /*!
+   * \brief Get the flat field-metadata table of the object's type.
+   *
+   *  The table is built lazily the first time a type is queried, by running
+   *  the registered VisitAttrs function once with a recording visitor.  The
+   *  recorded offsets are a property of the type, not the instance, so the
+   *  table is valid for every object of the same type.  This relies on
+   *  VisitAttrs visiting a fixed list of direct members, the same requirement
+   *  CreateObject already places on reflected nodes.
+   *
+   * \param self The pointer to the object.
+   * \return The field table, or nullptr if the type has no VisitAttrs.
+   */
+  TVM_DLL const std::vector<AttrFieldInfo>* GetFieldInfo(Object* self);
+  /*!
+   * \brief Visit the fields of self by iterating the flat field table.
+   *
+   *  Behaves like VisitAttrs, but calls the concrete visitor's overloads
+   *  directly, so a visitor whose Visit methods are final pays no virtual
+   *  dispatch per field.  Types without VisitAttrs are silently skipped,
+   *  matching VisitAttrs.
+   *
+   * \param self The pointer to the object.
+   * \param visitor The attribute visitor, passed by its concrete type.
+   * \tparam Visitor The concrete visitor type.
+   */
+  template <typename Visitor>
+  inline void VisitAttrsFlat(Object* self, Visitor* visitor);
+
   /*! \return The global singleton. */
   TVM_DLL static ReflectionVTable* Global();
 
@@ -194,6 +255,10 @@ class ReflectionVTable {
   std::vector<FCreate> fcreate_;
   /*! \brief ReprBytes function. */
   std::vector<FReprBytes> frepr_bytes_;
+  /*! \brief Lazily built per-type field tables, indexed by type_index. */
+  std::vector<std::unique_ptr<std::vector<AttrFieldInfo>>> field_info_;
+  /*! \brief Guards lazy construction of field_info_. */
+  std::mutex field_info_mutex_;
 };
 
 /*! \brief Registry of a reflection table. */
@@ -391,6 +456,50 @@ inline void ReflectionVTable::VisitAttrs(Object* self, AttrVisitor* visitor) con
   fvisit_attrs_[tindex](self, visitor);
 }
 
+template <typename Visitor>
+inline void ReflectionVTable::VisitAttrsFlat(Object* self, Visitor* visitor) {
+  const std::vector<AttrFieldInfo>* fields = GetFieldInfo(self);
+  if (fields == nullptr) {
+    return;
+  }
+  char* base = reinterpret_cast<char*>(self);
+  for (const AttrFieldInfo& field : *fields) {
+    void* addr = base + field.offset;
+    switch (field.kind) {
+      case AttrFieldKind::kDouble:
+        visitor->Visit(field.name, static_cast<double*>(addr));
+        break;
+      case AttrFieldKind::kInt64:
+        visitor->Visit(field.name, static_cast<int64_t*>(addr));
+        break;
+      case AttrFieldKind::kUInt64:
+        visitor->Visit(field.name, static_cast<uint64_t*>(addr));
+        break;
+      case AttrFieldKind::kInt:
+        visitor->Visit(field.name, static_cast<int*>(addr));
+        break;
+      case AttrFieldKind::kBool:
+        visitor->Visit(field.name, static_cast<bool*>(addr));
+        break;
+      case AttrFieldKind::kString:
+        visitor->Visit(field.name, static_cast<std::string*>(addr));
+        break;
+      case AttrFieldKind::kVoidPtr:
+        visitor->Visit(field.name, static_cast<void**>(addr));
+        break;
+      case AttrFieldKind::kDataType:
+        visitor->Visit(field.name, static_cast<DataType*>(addr));
+        break;
+      case AttrFieldKind::kNDArray:
+        visitor->Visit(field.name, static_cast<runtime::NDArray*>(addr));
+        break;
+      case AttrFieldKind::kObjectRef:
+        visitor->Visit(field.name, static_cast<runtime::ObjectRef*>(addr));
+        break;
+    }
+  }
+}
+
 inline bool ReflectionVTable::GetReprBytes(const Object* self, std::string* repr_bytes) const {
   uint32_t tindex = self->type_index();
   if (tindex < frepr_bytes_.size() && frepr_bytes_[tindex] != nullptr) {
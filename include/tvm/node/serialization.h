@@ -47,5 +47,28 @@ TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
  */
 TVM_DLL runtime::ObjectRef LoadJSON(std::string json_str);
 
+/*!
+ * \brief Save the node as well as all the nodes it depends on in a compact
+ *  binary format.
+ *
+ *  The binary format stores the same reflection-based object graph as
+ *  SaveJSON, but length-prefixed with an interned string table and raw
+ *  tensor payloads, making it considerably faster to load for large IR
+ *  artifacts. It is an internal caching format: no stability across TVM
+ *  versions is guaranteed, use SaveJSON for interchange.
+ *
+ * \param node The object to be serialized.
+ * \return The binary blob of the node.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load a TVM object graph from the binary format produced by
+ *  SaveBinary.
+ * \param blob The binary blob to load from.
+ * \return The root object of the loaded graph.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(std::string blob);
+
 }  // namespace tvm
 #endif  // TVM_NODE_SERIALIZATION_H_
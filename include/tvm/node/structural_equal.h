@@ -30,6 +30,7 @@
 
 #include <cmath>
 #include <string>
+#include <vector>
 
 namespace tvm {
 
@@ -126,6 +127,25 @@ class StructuralEqual : public BaseValueEqual {
                           const bool map_free_params = false) const;
 };
 
+/*!
+ * \brief Group a collection of objects by structural equality.
+ *
+ * All objects are structurally hashed on a thread pool, bucketed by hash, and
+ * the candidates within each bucket are confirmed with deep structural
+ * equality, with the buckets processed in parallel. Deduplicating n objects
+ * therefore costs n hashes plus deep comparisons only among hash-colliding
+ * candidates, instead of the n^2 pairwise comparisons of repeated
+ * StructuralEqual calls.
+ *
+ * \param objects The objects to be grouped.
+ * \param map_free_vars Whether or not to map free variables.
+ * \return A vector `repr` of the same length as \p objects, where `repr[i]`
+ *  is the index of the first object structurally equal to `objects[i]`.
+ *  An object is a distinct representative exactly when `repr[i] == i`.
+ */
+TVM_DLL std::vector<size_t> StructuralDeduplicationGroups(const Array<ObjectRef>& objects,
+                                                          bool map_free_vars = false);
+
 /*!
  * \brief A Reducer class to reduce the structural equality result of two objects.
  *
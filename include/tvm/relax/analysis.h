@@ -304,6 +304,27 @@ TVM_DLL Array<tir::Var> TIRVarsInStructInfo(const StructInfo& sinfo);
  */
 TVM_DLL Array<tir::Var> DefinableTIRVarsInStructInfo(const StructInfo& sinfo);
 
+/*!
+ * \brief Derive integer upper bounds for the symbolic variables defined by a
+ * parameter struct info, given the struct info of the matching argument.
+ *
+ * For every dimension (or shape value, or prim value) of \p param_sinfo that
+ * is a bare TIR variable, the corresponding expression in \p arg_sinfo is
+ * bounded with the analyzer; when it has a constant upper bound, the variable
+ * is recorded with that bound. When a variable constrains several positions,
+ * the loosest bound is kept. Variables whose corresponding expressions are
+ * unbounded are left out of the result.
+ *
+ * \param param_sinfo The parameter struct info whose variables are to be bounded.
+ * \param arg_sinfo The struct info of the argument bound to the parameter.
+ * \param analyzer The analyzer holding the bounds of the variables that appear
+ * in \p arg_sinfo.
+ * \return The map from bounded TIR variables to their upper bound values.
+ */
+TVM_DLL Map<tir::Var, IntImm> DeriveSymbolicVarBounds(const StructInfo& param_sinfo,
+                                                      const StructInfo& arg_sinfo,
+                                                      arith::Analyzer* analyzer);
+
 /*! \brief Collect expressions whose usage requires them to be non-negative
  *
  * Any PrimExpr that is used as a tensor shape, or as an element in a
@@ -185,6 +185,17 @@ TVM_DLL Pass CanonicalizeBindings();
  */
 TVM_DLL Pass EliminateCommonSubexpr(bool call_only = false);
 
+/*!
+ * \brief Eliminate call_tir full-tensor copies whose source is never
+ * re-mutated, rebinding their results to alias the source tensor.
+ *
+ * The copy kernels become dead code and can be removed by a subsequent
+ * DeadCodeElimination.
+ *
+ * \return The pass that eliminates redundant copies.
+ */
+TVM_DLL Pass EliminateRedundantCopies();
+
 /*!
  * \brief Bind params of function of the module to constant tensors.
  *
@@ -213,6 +224,27 @@ TVM_DLL Pass BindParams(String func_name, Map<ObjectRef, ObjectRef> params);
 TVM_DLL Pass BindSymbolicVars(Map<ObjectRef, PrimExpr> binding_map,
                               Optional<String> func_name = NullOpt);
 
+/*!
+ * \brief Specialize a function under symbolic-shape bindings and dispatch
+ *   between the specialized clones with a cheap runtime check.
+ *
+ * The function is cloned once per specialization, with the bound symbolic
+ * variables propagated and the resulting constant shape arithmetic folded.
+ * The original function is replaced with a dispatcher that evaluates each
+ * specialization predicate in order and calls the first matching clone,
+ * falling back to a generic copy of the original body.
+ *
+ * \param func_name The name of the function to specialize.
+ *
+ * \param specializations The specializations to generate.  Each entry is a
+ *      binding map as accepted by `BindSymbolicVars`; the corresponding
+ *      clone is guarded by the conjunction of the equalities it binds.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass SpecializeSymbolicVarDispatch(String func_name,
+                                           Array<Map<ObjectRef, PrimExpr>> specializations);
+
 /*!
  * \brief Fold constant expressions within dataflow blocks.
  *
@@ -471,12 +503,17 @@ class PatternCheckContext : public ObjectRef {
  * \param target_index If the specified function has more than one return values, specify the index
  * of the return value as the target. If it is not specified, the first return value will be the
  * target.
+ * \param share_adjoints Whether to share structurally identical adjoint subexpressions across
+ * bindings (hash-consed expression building) while generating the backward bindings. This reduces
+ * the size and the memory footprint of the generated training graph, at the cost of the generated
+ * bindings no longer mirroring the forward bindings one-to-one. For prompt release of the shared
+ * intermediates, compose with KillAfterLastUse after lowering.
  * \return The Pass.
  *
  * \note ConvertToDataflow may need to be called first to provide dataflow blocks.
  */
 TVM_DLL Pass Gradient(String func_name, Optional<Array<Var>> require_grads = NullOpt,
-                      int target_index = 0);
+                      int target_index = 0, bool share_adjoints = false);
 
 /*!
  * \brief Apply pattern matching to each function in the given module, and group matched
@@ -619,12 +656,20 @@ TVM_DLL Pass DataflowUseInplaceCalls();
  * \param out_dtype The output data type of gemm/conv, which is the data type of the accumulator.
  * \param fp16_input_names The names of function parameters whose dtype should become fp16. The
  * function signature would change accordingly.
+ * \param calibrated_absmax Optional calibration data: per-op-name largest absolute output value
+ * observed when running the fp32 module on calibration inputs. Ops whose observed range fits fp16
+ * with headroom may be relaxed to run in fp16, while ops with observed fp16 overflow are kept in
+ * fp32 regardless of their static policy.
+ * \param op_fp16_speedup Optional per-op-name fp16-over-fp32 throughput ratio measured on the
+ * target device. Ops with a ratio at or below 1.0 are never actively cast to fp16.
  * \return The Pass.
  *
  * \note Mainly operates within dataflow blocks. ConvertToDataflow may need to be called first.
  */
 TVM_DLL Pass ToMixedPrecision(const DataType& out_dtype,
-                              Optional<Array<String>> fp16_input_names = NullOpt);
+                              Optional<Array<String>> fp16_input_names = NullOpt,
+                              Optional<Map<String, FloatImm>> calibrated_absmax = NullOpt,
+                              Optional<Map<String, FloatImm>> op_fp16_speedup = NullOpt);
 
 /*!
  * \brief Rewrite a Relax module for executing with CUDA graph. This pass identifies
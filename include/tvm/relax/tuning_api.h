@@ -168,6 +168,8 @@ class Knob : public runtime::ObjectRef {
   TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(Knob, ObjectRef, KnobNode);
 };
 
+class Trace;
+
 /*! \brief Trace manages history of optimization decisions. */
 class TraceNode : public runtime::Object {
  public:
@@ -225,6 +227,19 @@ class TraceNode : public runtime::Object {
    */
   ObjectRef AsJSON(bool include_in_mod = true) const;
 
+  /*!
+   * \brief Serialize Trace as a delta against a base trace.
+   *
+   *  Candidate traces explored within one search task typically extend a common
+   *  base by a suffix, so only the length of the shared prefix and the suffix of
+   *  knobs/decisions are emitted: `[prefix_len, knobs_suffix, decisions_suffix]`.
+   *  The input IRModule is never included; it is recovered from the base on
+   *  deserialization.
+   * \param base The base trace to encode against.
+   * \return The JSON-style object
+   */
+  ObjectRef AsJSONDelta(const Trace& base) const;
+
   /*! \brief Set the performance. */
   void SetPerf(double _perf) { perf = _perf; }
   /*! \brief Set output module. */
@@ -248,6 +263,19 @@ class Trace : public runtime::ObjectRef {
   TVM_DLL explicit Trace(IRModule in_mod, Array<Knob> knobs, Array<String> decisions);
   /*! \brief Deserialize JSON-style object into Trace */
   TVM_DLL static Trace FromJSON(const ObjectRef& json_obj);
+  /*!
+   * \brief Deserialize a delta-encoded JSON-style object into Trace.
+   *
+   *  The shared prefix of knobs/decisions and the input IRModule are structurally
+   *  shared with `base` rather than re-parsed; when the delta extends the full
+   *  base trace, the replay resumes from the base's output module instead of
+   *  re-applying the whole history.
+   * \param json_obj The json object produced by TraceNode::AsJSONDelta.
+   * \param base The base trace the delta was encoded against.
+   */
+  TVM_DLL static Trace FromJSONDelta(const ObjectRef& json_obj, const Trace& base);
+  /*! \brief Check whether a trace json object is delta-encoded. */
+  TVM_DLL static bool IsJSONDelta(const ObjectRef& json_obj);
   TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(Trace, ObjectRef, TraceNode);
 };
 
@@ -273,6 +301,13 @@ class TuningRecordNode : public runtime::Object {
    * \return JSON object
    */
   ObjectRef AsJSON(bool include_irmod = false) const;
+
+  /*!
+   * \brief Export the tuning record to a JSON string, delta-encoding the trace.
+   * \param base The base trace to encode the record's trace against.
+   * \return JSON object
+   */
+  ObjectRef AsJSONDelta(const Trace& base) const;
 };
 
 /*!
@@ -293,6 +328,13 @@ class TuningRecord : public runtime::ObjectRef {
    * \return The tuning record created.
    */
   TVM_DLL static TuningRecord FromJSON(const ObjectRef& json_obj);
+  /*!
+   * \brief Create a tuning record from a json object whose trace may be delta-encoded.
+   * \param json_obj The json object.
+   * \param base The base trace deltas were encoded against.
+   * \return The tuning record created.
+   */
+  TVM_DLL static TuningRecord FromJSON(const ObjectRef& json_obj, const Trace& base);
   TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(TuningRecord, runtime::ObjectRef, TuningRecordNode);
 };
 
@@ -426,6 +426,23 @@ TVM_DLL Pass MetaScheduleLayoutRewrite();
  */
 TVM_DLL Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts);
 
+/*!
+ * \brief Given multiple candidate layout assignments, apply ConvertLayout with each of
+ * them and keep the converted module that minimizes the estimated cost of the
+ * layout_transform operators it contains, measured as the number of tensor elements
+ * moved across the whole graph. The unconverted module is kept when every candidate
+ * makes things worse.
+ *
+ * This replaces the greedy per-op layout preference with a whole-graph comparison:
+ * a layout that is locally attractive for one op can be rejected when the transforms
+ * it forces on the surrounding graph outweigh it.
+ *
+ * \param candidate_layouts The candidate desired-layout maps to try, each in the same
+ *                          format ConvertLayout accepts.
+ * \return The pass.
+ */
+TVM_DLL Pass ConvertLayoutSearch(const Array<Map<String, Array<String>>>& candidate_layouts);
+
 /*!
  * \brief Legalizes an expr with another expression.
  * \param legalize_map_attr_name The Op's attr name which corresponds to the legalize rule function.
@@ -141,6 +141,12 @@ typedef int (*FTVMParallelLambda)(int task_id, TVMParallelGroupEnv* penv, void*
  * \param num_task Number of tasks to launch, can be 0, means launch
  *           with all available threads.
  *
+ * \note When called from inside a running task, the call becomes a nested
+ *  launch: if the workers are partitioned into teams, the lead lane of a
+ *  team runs the tasks across its team's lanes, while any other caller runs
+ *  them serially as a single task. The outer task id then acts as the team
+ *  id and the inner one as the lane id.
+ *
  * \return 0 when no error is thrown, -1 when failure happens
  */
 TVM_DLL int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task);
@@ -153,6 +159,32 @@ TVM_DLL int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, in
  */
 TVM_DLL int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv);
 
+/*!
+ * \brief Get the address of the runtime-wide kernel trace enable flag.
+ *
+ *  Kernels compiled with the kernel trace hooks read this flag through a
+ *  pointer patched into the module at load time, so tracing can be toggled
+ *  at runtime without recompiling the kernels.
+ * \return The address of the flag; nonzero value means tracing is enabled.
+ */
+TVM_DLL const int32_t* TVMBackendKernelTraceEnabledFlag();
+
+/*!
+ * \brief Kernel entry trace hook, invoked by instrumented kernels when
+ *  kernel tracing is enabled.
+ * \param name The global symbol of the kernel being entered.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendKernelTraceEnter(const char* name);
+
+/*!
+ * \brief Kernel exit trace hook, invoked by instrumented kernels when
+ *  kernel tracing is enabled.
+ * \param name The global symbol of the kernel being exited.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendKernelTraceExit(const char* name);
+
 /*!
  * \brief Simple static initialization function.
  *  Run f once and set handle to be not null.
@@ -569,6 +569,43 @@ TVM_DLL int TVMArrayToDLPack(TVMArrayHandle from, DLManagedTensor** out);
  */
 TVM_DLL void TVMDLManagedTensorCallDeleter(DLManagedTensor* dltensor);
 
+/*!
+ * \brief Register an external buffer as a persistent zero-copy array.
+ *
+ *  The tensor is validated (contiguity, alignment) once at registration and
+ *  the returned handle stays stable until TVMExternalTensorUnregister, so a
+ *  framework adaptor can pass it to packed functions on every call without
+ *  per-call capsule or validation overhead. The caller keeps ownership of
+ *  the buffer and must keep it alive while the handle is registered.
+ *
+ * \param tensor The external buffer description; its contents are copied.
+ * \param out The stable output array handle.
+ * \return 0 when success, nonzero when failure happens
+ */
+TVM_DLL int TVMExternalTensorRegister(DLTensor* tensor, TVMArrayHandle* out);
+
+/*!
+ * \brief Rebind the shape of a registered external tensor in place.
+ *
+ *  Only the new extents are validated against the byte capacity recorded at
+ *  registration; data pointer, dtype and device stay as registered, making
+ *  the rebind cheap enough for per-call use with varying shapes.
+ *
+ * \param handle The handle obtained from TVMExternalTensorRegister.
+ * \param shape The new shape extents.
+ * \param ndim The number of dimensions of the new shape.
+ * \return 0 when success, nonzero when failure happens
+ */
+TVM_DLL int TVMExternalTensorRebindShape(TVMArrayHandle handle, const tvm_index_t* shape,
+                                         int ndim);
+
+/*!
+ * \brief Unregister an external tensor registered by TVMExternalTensorRegister.
+ * \param handle The handle to unregister; it must not be used afterwards.
+ * \return 0 when success, nonzero when failure happens
+ */
+TVM_DLL int TVMExternalTensorUnregister(TVMArrayHandle handle);
+
 /*!
  * \brief Create a new runtime stream.
  *
@@ -120,6 +120,31 @@ using Float = Box<double>;
  */
 using Bool = Box<bool>;
 
+/*!
+ * \brief Box an integer, reusing interned boxes for common values.
+ *
+ * Scalars crossing the FFI as ObjectRef would otherwise allocate a
+ * fresh `BoxNode<int64_t>` per conversion.  Small non-negative values
+ * (0 to 256 inclusive) are served from a table of interned boxes that
+ * live for the duration of the process, so the hot conversion path
+ * performs no allocation.  Values outside the interned range fall back
+ * to a regular allocation.  The interned boxes may be shared across
+ * threads; this is safe because the reference counter is atomic and
+ * the boxed value is immutable.
+ *
+ * \param value The value to be boxed
+ * \return A Box<int64_t> holding the value
+ */
+TVM_DLL Int InternedInt(int64_t value);
+
+/*!
+ * \brief Box a boolean, reusing the interned boxes for true and false.
+ *
+ * \param value The value to be boxed
+ * \return A Box<bool> holding the value
+ */
+TVM_DLL Bool InternedBool(bool value);
+
 namespace detail {
 template <>
 struct BoxNodeRuntimeTraits<int64_t> {
@@ -64,6 +64,17 @@
 #define TVM_ALWAYS_INLINE inline __attribute__((always_inline))
 #endif
 
+/*!
+ * \brief Macro helper to mark a function as rarely executed.
+ * It is only used on failure paths of checks and logging, so that
+ * compilers lay their code out away from the hot instruction stream.
+ */
+#if defined(_MSC_VER)
+#define TVM_COLD
+#else
+#define TVM_COLD __attribute__((cold))
+#endif
+
 /*!
  * \brief Macro helper for exception throwing.
  */
@@ -97,6 +108,19 @@
 #define TVM_LOG_CUSTOMIZE 0
 #endif
 
+/*!
+ * \brief Whether or not to minimize the inline footprint of checks.
+ *  When enabled, CHECK and ICHECK still evaluate their conditions, but
+ *  a failure raises a fatal error carrying only the static check message:
+ *  the streamed operands are discarded without generating any formatting
+ *  code at the call site. This trims the per-check code size in
+ *  dispatch-heavy translation units at the cost of less detailed error
+ *  messages.
+ */
+#ifndef TVM_CHECKS_MINIMAL
+#define TVM_CHECKS_MINIMAL 0
+#endif
+
 // a technique that enables overriding macro names on the number of parameters. This is used
 // to define other macros below
 #define GET_MACRO(_1, _2, _3, _4, _5, NAME, ...) NAME
@@ -286,8 +310,8 @@ namespace detail {
  *
  * \sa TVM_LOG_CUSTOMIZE
  */
-[[noreturn]] TVM_DLL void LogFatalImpl(const std::string& file, int lineno,
-                                       const std::string& message);
+[[noreturn]] TVM_DLL TVM_COLD void LogFatalImpl(const std::string& file, int lineno,
+                                                const std::string& message);
 
 /*!
  * \brief Custom implementations of LogMessage.
@@ -348,7 +372,7 @@ class LogMessage {
  */
 class LogFatal {
  public:
-  TVM_NO_INLINE LogFatal(const char* file, int lineno) { GetEntry().Init(file, lineno); }
+  TVM_NO_INLINE TVM_COLD LogFatal(const char* file, int lineno) { GetEntry().Init(file, lineno); }
 #ifdef _MSC_VER
 #pragma disagnostic push
 #pragma warning(disable : 4722)
@@ -369,7 +393,7 @@ class LogFatal {
       this->file_ = file;
       this->lineno_ = lineno;
     }
-    [[noreturn]] TVM_NO_INLINE dmlc::Error Finalize() TVM_THROW_EXCEPTION {
+    [[noreturn]] TVM_NO_INLINE TVM_COLD dmlc::Error Finalize() TVM_THROW_EXCEPTION {
       InternalError error(file_, lineno_, stream_.str());
 #if DMLC_LOG_BEFORE_THROW
       std::cerr << error.what() << std::endl;
@@ -381,7 +405,7 @@ class LogFatal {
     int lineno_;
   };
 
-  TVM_DLL TVM_NO_INLINE static Entry& GetEntry();
+  TVM_DLL TVM_NO_INLINE TVM_COLD static Entry& GetEntry();
 };
 
 /*!
@@ -543,7 +567,7 @@ class VLogContextEntry {
 };
 
 template <typename X, typename Y>
-std::unique_ptr<std::string> LogCheckFormat(const X& x, const Y& y) {
+TVM_NO_INLINE TVM_COLD std::unique_ptr<std::string> LogCheckFormat(const X& x, const Y& y) {
   std::ostringstream os;
   os << " (" << x << " vs. " << y << ") ";  // CHECK_XX(x, y) requires x and y can be serialized to
                                             // string. Use CHECK(x OP y) otherwise.
@@ -561,6 +585,10 @@ std::unique_ptr<std::string> LogCheckFormat(const X& x, const Y& y) {
   }                                                                                       \
   TVM_ALWAYS_INLINE std::unique_ptr<std::string> LogCheck##name(int x, int y) {           \
     return LogCheck##name<int, int>(x, y);                                                \
+  }                                                                                       \
+  template <typename X, typename Y>                                                       \
+  TVM_ALWAYS_INLINE bool LogCheckPass##name(const X& x, const Y& y) {                     \
+    return (x op y);                                                                      \
   }
 
 #if defined(__GNUC__) || defined(__clang__)  // GCC and Clang
@@ -584,6 +612,45 @@ TVM_CHECK_FUNC(_NE, !=)
 #pragma warning(pop)
 #endif
 
+/*!
+ * \brief Raise the fatal error of a failed check, carrying only the static check message.
+ *  Used by the minimal-footprint variants of the check macros.
+ * \sa TVM_CHECKS_MINIMAL
+ */
+[[noreturn]] TVM_DLL TVM_NO_INLINE TVM_COLD void LogCheckFailed(const char* file, int lineno,
+                                                                const char* check_msg);
+
+/*!
+ * \brief Class to discard the streamed operands of a failed check and raise the fatal error
+ * when going out of scope. Do not use directly, it backs the minimal-footprint variants of
+ * the check macros.
+ * \sa TVM_CHECKS_MINIMAL
+ */
+class CheckFailedSink {
+ public:
+  CheckFailedSink(const char* file, int lineno, const char* check_msg)
+      : file_(file), lineno_(lineno), check_msg_(check_msg) {}
+#ifdef _MSC_VER
+#pragma disagnostic push
+#pragma warning(disable : 4722)
+#endif
+  [[noreturn]] ~CheckFailedSink() TVM_THROW_EXCEPTION {
+    LogCheckFailed(file_, lineno_, check_msg_);
+  }
+#ifdef _MSC_VER
+#pragma disagnostic pop
+#endif
+  template <typename T>
+  TVM_ALWAYS_INLINE CheckFailedSink& operator<<(const T&) {
+    return *this;
+  }
+
+ private:
+  const char* file_;
+  int lineno_;
+  const char* check_msg_;
+};
+
 }  // namespace detail
 
 #define TVM_LOG_LEVEL_DEBUG 0
@@ -601,6 +668,26 @@ TVM_CHECK_FUNC(_NE, !=)
 #define LOG_WARNING \
   ::tvm::runtime::detail::LogMessage(__FILE__, __LINE__, TVM_LOG_LEVEL_WARNING).stream()
 
+#if TVM_CHECKS_MINIMAL
+
+#define TVM_CHECK_BINARY_OP(name, op, x, y)                   \
+  if (!::tvm::runtime::detail::LogCheckPass##name(x, y))      \
+  ::tvm::runtime::detail::CheckFailedSink(__FILE__, __LINE__, \
+                                          "Check failed: " #x " " #op " " #y)
+
+#define CHECK(x)                                              \
+  if (!(x))                                                   \
+  ::tvm::runtime::detail::CheckFailedSink(__FILE__, __LINE__, \
+                                          "Check failed: (" #x ") is false")
+
+#define CHECK_NOTNULL(x)                                                        \
+  ((x) == nullptr ? (::tvm::runtime::detail::LogCheckFailed(__FILE__, __LINE__, \
+                                                            "Check not null: " #x),             \
+                     (x))                                                       \
+                  : (x))  // NOLINT(*)
+
+#else
+
 #define TVM_CHECK_BINARY_OP(name, op, x, y)                                \
   if (auto __tvm__log__err = ::tvm::runtime::detail::LogCheck##name(x, y)) \
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream()            \
@@ -611,16 +698,19 @@ TVM_CHECK_FUNC(_NE, !=)
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
       << "Check failed: (" #x << ") is false: "
 
+#define CHECK_NOTNULL(x)                                                          \
+  ((x) == nullptr ? ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
+                        << "Check not null: " #x << ' ',                          \
+   (x) : (x))  // NOLINT(*)
+
+#endif  // TVM_CHECKS_MINIMAL
+
 #define CHECK_LT(x, y) TVM_CHECK_BINARY_OP(_LT, <, x, y)
 #define CHECK_GT(x, y) TVM_CHECK_BINARY_OP(_GT, >, x, y)
 #define CHECK_LE(x, y) TVM_CHECK_BINARY_OP(_LE, <=, x, y)
 #define CHECK_GE(x, y) TVM_CHECK_BINARY_OP(_GE, >=, x, y)
 #define CHECK_EQ(x, y) TVM_CHECK_BINARY_OP(_EQ, ==, x, y)
 #define CHECK_NE(x, y) TVM_CHECK_BINARY_OP(_NE, !=, x, y)
-#define CHECK_NOTNULL(x)                                                          \
-  ((x) == nullptr ? ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
-                        << "Check not null: " #x << ' ',                          \
-   (x) : (x))  // NOLINT(*)
 
 #define LOG_IF(severity, condition) \
   !(condition) ? (void)0 : ::tvm::runtime::detail::LogMessageVoidify() & LOG(severity)
@@ -698,6 +788,26 @@ TVM_CHECK_FUNC(_NE, !=)
 
 #define TVM_ICHECK_INDENT "  "
 
+#if TVM_CHECKS_MINIMAL
+
+#define ICHECK_BINARY_OP(name, op, x, y)                 \
+  if (!::tvm::runtime::detail::LogCheckPass##name(x, y)) \
+  ::tvm::runtime::detail::CheckFailedSink(               \
+      __FILE__, __LINE__, "InternalError: Check failed: " #x " " #op " " #y)
+
+#define ICHECK(x)                          \
+  if (!(x))                                \
+  ::tvm::runtime::detail::CheckFailedSink( \
+      __FILE__, __LINE__, "InternalError: Check failed: (" #x ") is false")
+
+#define ICHECK_NOTNULL(x)                                                       \
+  ((x) == nullptr ? (::tvm::runtime::detail::LogCheckFailed(__FILE__, __LINE__, \
+                                                            "InternalError: Check not null: " #x), \
+                     (x))                                                       \
+                  : (x))  // NOLINT(*)
+
+#else
+
 #define ICHECK_BINARY_OP(name, op, x, y)                                   \
   if (auto __tvm__log__err = ::tvm::runtime::detail::LogCheck##name(x, y)) \
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream()            \
@@ -708,16 +818,19 @@ TVM_CHECK_FUNC(_NE, !=)
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
       << "InternalError: Check failed: (" #x << ") is false: "
 
+#define ICHECK_NOTNULL(x)                                                         \
+  ((x) == nullptr ? ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
+                        << "InternalError: Check not null: " #x << ' ',           \
+   (x) : (x))  // NOLINT(*)
+
+#endif  // TVM_CHECKS_MINIMAL
+
 #define ICHECK_LT(x, y) ICHECK_BINARY_OP(_LT, <, x, y)
 #define ICHECK_GT(x, y) ICHECK_BINARY_OP(_GT, >, x, y)
 #define ICHECK_LE(x, y) ICHECK_BINARY_OP(_LE, <=, x, y)
 #define ICHECK_GE(x, y) ICHECK_BINARY_OP(_GE, >=, x, y)
 #define ICHECK_EQ(x, y) ICHECK_BINARY_OP(_EQ, ==, x, y)
 #define ICHECK_NE(x, y) ICHECK_BINARY_OP(_NE, !=, x, y)
-#define ICHECK_NOTNULL(x)                                                         \
-  ((x) == nullptr ? ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
-                        << "InternalError: Check not null: " #x << ' ',           \
-   (x) : (x))  // NOLINT(*)
 
 }  // namespace runtime
 // Re-export error types
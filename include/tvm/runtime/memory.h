@@ -25,12 +25,85 @@
 
 #include <tvm/runtime/object.h>
 
+#include <cstddef>
 #include <cstdlib>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
+
+/*!
+ * \brief A thread-local pool recycling Object storage blocks by size.
+ *
+ *  While a pool is current on a thread (see ObjectPoolScope), storage of
+ *  deleted objects is pushed onto a per-size free list instead of being
+ *  returned to the global allocator, and new objects of the same size pop
+ *  from that list. This turns the alloc/free churn of transient IR inside a
+ *  compiler pass into pointer swaps; the pooled blocks are released in bulk
+ *  when the scope ends. Reference counting and object lifetimes are
+ *  unchanged: objects that outlive the scope were allocated from the global
+ *  allocator's blocks to begin with and are freed normally whenever their
+ *  refcount drops with no pool current.
+ */
+class ObjectMemoryPool {
+ public:
+  /*! \return The pool current on this thread, or nullptr. */
+  static ObjectMemoryPool*& Current() {
+    static thread_local ObjectMemoryPool* current = nullptr;
+    return current;
+  }
+  /*! \brief Obtain a storage block of \p size bytes, reusing a pooled block if possible. */
+  void* Obtain(size_t size) {
+    auto it = free_lists_.find(size);
+    if (it != free_lists_.end() && !it->second.empty()) {
+      void* ptr = it->second.back();
+      it->second.pop_back();
+      return ptr;
+    }
+    return ::operator new(size);
+  }
+  /*! \brief Return a storage block of \p size bytes to the pool. */
+  void Release(size_t size, void* ptr) { free_lists_[size].push_back(ptr); }
+  /*! \brief Release all pooled blocks back to the global allocator. */
+  void Drain() {
+    for (auto& kv : free_lists_) {
+      for (void* ptr : kv.second) {
+        ::operator delete(ptr);
+      }
+    }
+    free_lists_.clear();
+  }
+
+ private:
+  std::unordered_map<size_t, std::vector<void*>> free_lists_;
+};
+
+/*!
+ * \brief RAII scope that makes a fresh ObjectMemoryPool current on this thread.
+ *
+ *  Opt-in for passes whose profiles are dominated by allocation of
+ *  short-lived IR nodes. Scopes nest; the enclosing pool is restored and the
+ *  scope's pooled blocks are drained on exit.
+ */
+class ObjectPoolScope {
+ public:
+  ObjectPoolScope() : parent_(ObjectMemoryPool::Current()) {
+    ObjectMemoryPool::Current() = &pool_;
+  }
+  ~ObjectPoolScope() {
+    ObjectMemoryPool::Current() = parent_;
+    pool_.Drain();
+  }
+  ObjectPoolScope(const ObjectPoolScope&) = delete;
+  ObjectPoolScope& operator=(const ObjectPoolScope&) = delete;
+
+ private:
+  ObjectMemoryPool* parent_;
+  ObjectMemoryPool pool_;
+};
 /*!
  * \brief Allocate an object using default allocator.
  * \param args arguments to the constructor.
@@ -118,7 +191,12 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
       // class with non-virtual destructor.
       // We are fine here as we captured the right deleter during construction.
       // This is also the right way to get storage type for an object pool.
-      StorageType* data = new StorageType();
+      StorageType* data;
+      if (ObjectMemoryPool* pool = PoolFor()) {
+        data = static_cast<StorageType*>(pool->Obtain(sizeof(StorageType)));
+      } else {
+        data = new StorageType();
+      }
       new (data) T(std::forward<Args>(args)...);
       return reinterpret_cast<T*>(data);
     }
@@ -126,6 +204,13 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
     static Object::FDeleter Deleter() { return Deleter_; }
 
    private:
+    // Pooled and plain blocks are interchangeable, so pooling is restricted
+    // to types the global allocator would place without extended alignment.
+    static ObjectMemoryPool* PoolFor() {
+      if (alignof(T) > alignof(std::max_align_t)) return nullptr;
+      return ObjectMemoryPool::Current();
+    }
+
     static void Deleter_(Object* objptr) {
       // NOTE: this is important to cast back to T*
       // because objptr and tptr may not be the same
@@ -136,7 +221,11 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
       // instead of tptr->~T(), which could mean the intention
       // call a virtual destructor(which may not be available and is not required).
       tptr->T::~T();
-      delete reinterpret_cast<StorageType*>(tptr);
+      if (ObjectMemoryPool* pool = PoolFor()) {
+        pool->Release(sizeof(StorageType), tptr);
+      } else {
+        delete reinterpret_cast<StorageType*>(tptr);
+      }
     }
   };
 
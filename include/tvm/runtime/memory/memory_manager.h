@@ -42,6 +42,7 @@ namespace memory {
 enum AllocatorType {
   kNaive = 1,
   kPooled,
+  kStreamOrdered,
 };
 
 struct Buffer {
@@ -94,10 +95,18 @@ class Allocator {
   TVM_DLL virtual void Free(const Buffer& buffer) = 0;
   /*! \brief Clear the allocated memory. */
   TVM_DLL virtual void Clear();
+  /*! \brief Release cached free blocks back to the device, keeping live allocations intact. */
+  TVM_DLL virtual void Trim();
   /*! \brief The amount of memory currently allocated.
    *  \return The amount of memory currently allocated.
    */
   TVM_DLL virtual size_t UsedMemory() const = 0;
+  /*! \brief The number of allocations that reached the device rather than
+   *   being served from a cache; used to verify steady-state allocation
+   *   behavior. Allocators without a cache may report zero.
+   *  \return The device allocation count since the allocator was created.
+   */
+  TVM_DLL virtual size_t DeviceAllocCount() const { return 0; }
 
  protected:
   /*! \brief Check if the given memory scope is allowed to allocate by the allocator. */
@@ -124,8 +133,27 @@ class MemoryManager {
    * \return The memory allocator.
    */
   TVM_DLL static Allocator* GetAllocator(Device dev, AllocatorType type);
+  /*!
+   * \brief Get the pinned-host counterpart of the given device.
+   *
+   *  Storages spilled off a device (e.g. by the memory planner when the
+   *  activation peak exceeds a device budget) are placed on this device, so
+   *  the data stays addressable by the original device through unified
+   *  addressing while consuming host memory.
+   * \param dev The device to find the counterpart for.
+   * \return The pinned-host device. Devices without a dedicated pinned-host
+   *  device type fall back to plain CPU.
+   */
+  TVM_DLL static Device GetPinnedHostDevice(Device dev);
   /*! \brief Clear the allocators. */
   static void Clear();
+  /*!
+   * \brief Trim the cached free memory of all allocators.
+   *
+   *  Unlike Clear, buffers still in use stay valid, so long-running servers
+   *  can call this periodically to cap resident memory.
+   */
+  TVM_DLL static void Defragment();
 
  private:
   MemoryManager() {}
@@ -219,7 +219,11 @@ class TVM_DLL ModuleNode : public Object {
   const PackedFunc* GetFuncFromEnv(const String& name);
 
   /*! \brief Clear all imports of the module. */
-  void ClearImports() { imports_.clear(); }
+  void ClearImports() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    imports_.clear();
+    import_index_.clear();
+  }
 
   /*! \return The module it imports from */
   const std::vector<Module>& imports() const { return imports_; }
@@ -268,6 +272,15 @@ class TVM_DLL ModuleNode : public Object {
  private:
   /*! \brief Cache used by GetImport */
   std::unordered_map<std::string, std::shared_ptr<PackedFunc>> import_cache_;
+  /*!
+   * \brief Symbol index over the imports, built lazily as lookups resolve.
+   *
+   *  Maps a function name to the direct import whose subtree resolved it, so
+   *  repeated lookups replace the linear walk over the imports with a single
+   *  hash probe per import-tree level. Entries point into imports_ and are
+   *  cleared together with it.
+   */
+  std::unordered_map<std::string, ModuleNode*> import_index_;
   std::mutex mutex_;
 };
 
@@ -300,6 +313,14 @@ constexpr const char* tvm_param_prefix = "__tvm_param__";
 constexpr const char* tvm_lookup_linked_param = "_lookup_linked_param";
 /*! \brief Model entrypoint generated as an interface to the AOT function outside of TIR */
 constexpr const char* tvm_entrypoint_suffix = "run";
+/*!
+ * \brief Infix marking an ISA-variant copy of an exported symbol.
+ *
+ *  A symbol named `<name><infix><feature>` is a version of `<name>` compiled for the
+ *  given CPU feature level (e.g. `avx512`); the system library picks the best variant
+ *  the host supports at load time and falls back to the plain symbol otherwise.
+ */
+constexpr const char* tvm_isa_variant_infix = "__tvm_mcpu_";
 }  // namespace symbol
 
 // implementations of inline functions.
@@ -363,6 +363,11 @@ inline size_t GetDataSize(const DLTensor& arr) {
   for (tvm_index_t i = 0; i < arr.ndim; ++i) {
     size *= static_cast<size_t>(arr.shape[i]);
   }
+  if (arr.dtype.bits < 8) {
+    // Sub-byte types are stored bit-packed: account for the exact number of
+    // bits over the whole tensor instead of rounding every element to a byte.
+    return (size * arr.dtype.bits * arr.dtype.lanes + 7) / 8;
+  }
   size *= (arr.dtype.bits * arr.dtype.lanes + 7) / 8;
   return size;
 }
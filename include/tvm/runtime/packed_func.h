@@ -2315,7 +2315,7 @@ inline TObjectRef TVMPODValue_CRTP_<Derived>::AsObjectRef() const {
 
   if constexpr (std::is_base_of_v<TObjectRef, Int>) {
     if (type_code_ == kTVMArgInt) {
-      return Int(value_.v_int64);
+      return InternedInt(value_.v_int64);
     }
   }
 
@@ -2327,7 +2327,7 @@ inline TObjectRef TVMPODValue_CRTP_<Derived>::AsObjectRef() const {
 
   if constexpr (std::is_base_of_v<TObjectRef, Bool>) {
     if (type_code_ == kTVMArgBool) {
-      return Bool(value_.v_int64);
+      return InternedBool(value_.v_int64);
     }
   }
 
@@ -103,6 +103,15 @@ class Executable : public runtime::ModuleNode {
    * \return The instruction.
    */
   Instruction GetInstruction(Index i) const;
+  /*!
+   * \brief Tighten the register file size of every VM function to the highest
+   * register its bytecode actually references.
+   *
+   * The compiler sizes register files conservatively; compacting them keeps
+   * interpreter frames minimal, which matters for servers that push and pop
+   * frames on every request. Invoked automatically during serialization.
+   */
+  void CompactRegisterFile();
   /*!
    * \brief Set j-th byte data of i-th instruction to val.
    * \param i The index of the instruction to be updated.
@@ -22,6 +22,7 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -48,6 +49,19 @@ struct NDArrayCacheMetadata {
       TVM_DLL NDArray Load(Device device, const std::string* raw_data,
                            Optional<NDArray>* staging_buffer = nullptr) const;
 
+      /*!
+       * \brief Load the parameter by aliasing already-resident raw data (e.g. a
+       *  memory-mapped shard file) instead of copying it.
+       *
+       *  Falls back to a copying load when the record requires dtype conversion
+       *  or the aliased address is not sufficiently aligned.
+       * \param device The device to load onto, must be CPU-accessible.
+       * \param data_base Base address of the shard's raw data.
+       * \param owner A handle that keeps the aliased memory alive.
+       */
+      TVM_DLL NDArray LoadZeroCopy(Device device, const char* data_base,
+                                   std::shared_ptr<void> owner) const;
+
       /*! \brief Name of the parameter */
       std::string name;
       /*! \brief Shape of the parameter */
@@ -56,10 +70,15 @@ struct NDArrayCacheMetadata {
       DataType dtype;
       /*! \brief Format of the parameter */
       std::string format;
-      /*! \brief Number of bytes */
+      /*! \brief Number of bytes after decompression/decoding */
       int64_t nbytes;
       /*! \brief Offset from the raw stream */
       int64_t byte_offset;
+      /*!
+       * \brief Number of bytes the record occupies in the shard file when the
+       *  shard is compressed (JSON key "encodedNbytes"); 0 when stored raw.
+       */
+      int64_t encoded_nbytes = 0;
     };
 
     /*! \brief Load a FileRecord into memory */
@@ -68,12 +87,22 @@ struct NDArrayCacheMetadata {
                                 std::string* raw_data_buffer,    //
                                 Optional<NDArray>* staging_buffer = nullptr) const;
 
+    /*! \brief Load a FileRecord whose raw data has already been read into memory */
+    TVM_DLL Array<NDArray> Load(Device device,                 //
+                                const std::string* raw_data,   //
+                                Optional<NDArray>* staging_buffer = nullptr) const;
+
     /*! \brief Relative path to the bin file */
     std::string data_path;
     /*! \brief Format of the file */
     std::string format;
     /*! \brief Size of the file */
     int64_t nbytes;
+    /*!
+     * \brief Size of the shared zstd dictionary stored at the head of a
+     *  `zstd-shard` file (JSON key "dictNbytes"); 0 when there is none.
+     */
+    int64_t dict_nbytes = 0;
     /*! \brief The parameters in the file */
     std::vector<ParamRecord> records;
   };
@@ -27,6 +27,7 @@
 #include <tvm/runtime/c_backend_api.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -92,6 +93,13 @@ class ThreadGroup {
     kSpecifyOneCorePerThread = -2,
     /*All threads will get the same core group affinity.*/
     kSpecifyThreadShareAllCore = -3,
+    /*One worker pinned to each physical core; SMT/hyper-threaded siblings stay idle.*/
+    kOnePerPhysicalCore = -4,
+    /*Confine all workers to the cores sharing one last-level cache (one CCX/tile).*/
+    kSpecifyOneLLCDomain = -5,
+    /*Exclude the lower-frequency efficiency cores of hybrid CPUs; keeps the
+     * SMT siblings of the performance cores, unlike kBig on such parts.*/
+    kExcludeEfficiencyCores = -6,
   };
   /*!
    * \brief configure the CPU id affinity
@@ -136,12 +144,18 @@ TVM_DLL void ResetThreadPool();
 /*!
  * \brief Configuring the CPU affinity mode for the working threads.
  * \param mode The preferred CPU type (1 = big, -1 = little, -2 = kSpecifyOneCorePerThread,
- *  -3 = kSpecifyThreadShareAllCore).
+ *  -3 = kSpecifyThreadShareAllCore, -4 = kOnePerPhysicalCore, -5 = kSpecifyOneLLCDomain,
+ *  -6 = kExcludeEfficiencyCores).
  * \param nthreads The number of threads to use (0 = use all).
  * \param cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads.
+ * \param worker_spin_wait_us Time budget in microseconds an idle worker keeps spinning
+ *  before it backs off to a condition-variable sleep. A negative value (default) leaves
+ *  the configured budget unchanged (fixed spin-count behavior unless set through
+ *  TVM_THREAD_POOL_SPIN_WAIT_US); a large value effectively gives persistent-spin
+ *  workers with sub-microsecond dispatch latency at the cost of idle cycles.
  */
 TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode, int nthreads,
-                       std::vector<unsigned int> cpus);
+                       std::vector<unsigned int> cpus, int64_t worker_spin_wait_us = -1);
 
 /*!
  * \brief Get the number of threads being used by the TVM runtime
@@ -149,6 +163,25 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
  */
 TVM_DLL int32_t NumThreads();
 
+/*!
+ * \brief Get the number of NUMA nodes visible through sysfs.
+ * \returns The node count; 1 when the topology is unknown.
+ */
+TVM_DLL int NumNumaNodes();
+
+/*!
+ * \brief Get the NUMA node of the cpu the calling thread is currently running on.
+ * \returns The node id; 0 when the topology is unknown.
+ */
+TVM_DLL int CurrentNumaNode();
+
+/*!
+ * \brief Get the logical cpus belonging to the given NUMA node.
+ * \param node The node id.
+ * \returns The cpu ids; empty when the topology is unknown.
+ */
+TVM_DLL std::vector<unsigned int> NumaNodeCpus(int node);
+
 }  // namespace threading
 
 /*!
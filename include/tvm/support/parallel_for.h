@@ -61,7 +61,8 @@ TVM_DLL std::vector<std::vector<int>> rr_partitioner(int begin, int end, int ste
  * \param step The traversal step to the index.
  * \param partitioner A partition function to split tasks to different threads. Use Round-robin
  * partitioner by default.
- * \note 1. Currently do not support nested parallel_for; 2. The order of execution in each thread
+ * \note 1. The loop runs on the persistent runtime thread pool; a nested parallel_for is
+ * executed serially on the calling thread; 2. The order of execution in each thread
  * is not guaranteed, the for loop task should be thread independent and thread safe.
  */
 TVM_DLL void parallel_for(int begin, int end, const std::function<void(int)>& f, int step = 1,
@@ -105,6 +105,27 @@ class LinearCongruentialEngine {
     *rand_state_ptr_ = NormalizeSeed(rand_state);
   }
 
+  /*!
+   * \brief Derive the seed of an independent random stream from a base seed and a stream index.
+   *
+   *  This is a counter-based construction: the result only depends on (rand_state, stream_index),
+   *  not on how many numbers were drawn before, so parallel workers can derive one stream per
+   *  candidate index and stay bit-reproducible regardless of thread scheduling. The mixing
+   *  function is a SplitMix64-style finalizer, whose avalanche behavior decorrelates
+   *  consecutive stream indices.
+   * \param rand_state The base random seed shared by all streams.
+   * \param stream_index The index of the stream to derive.
+   * \return The seed of the derived stream, normalized to [1, modulus - 1].
+   */
+  static TRandState StreamSeed(TRandState rand_state, int64_t stream_index) {
+    uint64_t z = static_cast<uint64_t>(NormalizeSeed(rand_state)) +
+                 (static_cast<uint64_t>(stream_index) + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+    return NormalizeSeed(static_cast<TRandState>(z % static_cast<uint64_t>(modulus)));
+  }
+
   /*!
    * \brief Fork a new seed for another RNG from current random state.
    * \return The forked seed.
@@ -93,6 +93,17 @@ TVM_DLL double EstimateTIRFlops(const Stmt& stmt);
  */
 TVM_DLL double EstimateTIRFlops(const IRModule& mod);
 
+/*!
+ * \brief Report per-loop buffer access strides, working-set bounds and
+ *        predicted cache behavior of a PrimFunc.
+ * \param func The function to analyze.
+ * \param l1_bytes The L1 data cache capacity to compare working sets against.
+ * \param l2_bytes The L2 cache capacity to compare working sets against.
+ * \return A human-readable per-loop report.
+ */
+TVM_DLL String AnalyzeMemoryAccessPatterns(const PrimFunc& func, int64_t l1_bytes,
+                                           int64_t l2_bytes);
+
 /*!
  * \brief Find undefined vars in the statement.
  * \param stmt The statement to be checked.
@@ -284,7 +295,9 @@ TVM_DLL size_t CalculateExprComplexity(const PrimExpr& expr);
 TVM_DLL size_t CalculateConstantBytes(const PrimFunc& func, const Integer& constant_byte_alignment);
 
 /*!
- * \brief Calculate the workspace size in bytes needed by the TIR allocates inside the TIR PrimFunc
+ * \brief Calculate the workspace size in bytes needed by the TIR allocates inside the TIR PrimFunc.
+ * The result is the high-water mark over the properly nested allocation scopes; for PrimFuncs that
+ * already went through LowerTVMBuiltin, lowered TVMBackendAllocWorkspace calls are counted as well.
  * \param func The TIR PrimFunc for which the workspace size to be calculated
  * \param workspace_byte_alignment The byte alignment required for each tensor allocated in this
  * workspace
@@ -821,6 +821,23 @@ TVM_DLL const Op& vectorcombine();
  */
 TVM_DLL const Op& dp4a();
 
+/*!
+ * \brief Pack a sub-byte integer vector into its bit-packed storage integer.
+ *
+ *  The argument's total bit width (bits * lanes) must equal that of the
+ *  result dtype, e.g. int4x8 packs into an int32. Backends lower this to a
+ *  bit-level reinterpret of the vector value.
+ */
+TVM_DLL const Op& subbyte_pack();
+
+/*!
+ * \brief Unpack a bit-packed storage integer into a sub-byte integer vector.
+ *
+ *  The inverse of subbyte_pack: the argument's total bit width must equal
+ *  that of the result vector dtype, e.g. an int32 unpacks into int4x8.
+ */
+TVM_DLL const Op& subbyte_unpack();
+
 /*!
  * \brief atomic add instruction, corresponding e.g. to atomicAdd in CUDA
  */
@@ -28,6 +28,7 @@
 #include <tvm/tir/function.h>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace tvm {
@@ -83,6 +84,28 @@ enum ScheduleDebugMask : uint32_t {
   kVerifyCachedFlags = 2,
 };
 
+/*!
+ * \brief A cache of derived analyses over the statements of a schedule.
+ * All entries are keyed by statement pointers owned by the sref tree, and any `Replace`
+ * call may change the answers, so the cache is emptied there. Between two edits -- the
+ * common pattern during tuning, where the same analyses are evaluated for thousands of
+ * candidates -- repeated queries hit the cache instead of traversing the blocks again.
+ */
+struct ScheduleAnalysisCache {
+  /*! \brief The result of `GetLoopIterType`, keyed by the loop statement. */
+  std::unordered_map<const StmtNode*, int> loop_iter_type;
+  /*! \brief Scope root and result of `CheckCompleteBlockErrorCode`, keyed by the block. */
+  std::unordered_map<const StmtNode*, std::pair<const StmtNode*, int>> complete_block_code;
+  /*! \brief Scope root and result of `CheckReductionBlockErrorCode`, keyed by the block. */
+  std::unordered_map<const StmtNode*, std::pair<const StmtNode*, int>> reduction_block_code;
+  /*! \brief Remove all the entries of the cache. */
+  void Clear() {
+    loop_iter_type.clear();
+    complete_block_code.clear();
+    reduction_block_code.clear();
+  }
+};
+
 /*!
  * \brief The state of scheduling, which exposes a `Replace` method as
  * the primary interface for all the scheduling primitives to manipulate the TensorIR.
@@ -107,6 +130,19 @@ class ScheduleStateNode : public Object {
   std::unordered_map<StmtSRef, BlockInfo, ObjectPtrHash, ObjectPtrEqual> block_info;
   /*! \brief The reverse mapping from block/for-loop to their corresponding srefs */
   std::unordered_map<const StmtNode*, StmtSRef> stmt2ref;
+  /*!
+   * \brief Blocks whose cached BlockInfo may be outdated, because a `Replace` call
+   * has rewritten their subtree, or a statement below them, since the info was computed.
+   * `UpdateScopeBlockInfo` re-analyzes exactly these blocks and reuses the cached info
+   * of unchanged nested scopes, so the cost of re-analysis is proportional to the edit
+   * rather than to the size of the function.
+   */
+  std::unordered_set<const StmtNode*> stale_block_info;
+  /*!
+   * \brief Cached results of derived per-statement analyses, emptied by `Replace`.
+   * \sa ScheduleAnalysisCache
+   */
+  ScheduleAnalysisCache analysis_cache;
   /*!
    * \brief Do extra correctness checking after the class creation
    * and each time after calling the Replace method.
@@ -122,6 +158,8 @@ class ScheduleStateNode : public Object {
     v->Visit("mod", &mod);
     // `block_info` is not visited
     // `stmt2ref` is not visited
+    // `stale_block_info` is not visited
+    // `analysis_cache` is not visited
     v->Visit("debug_mask", &debug_mask);
     v->Visit("enable_check", &enable_check);
   }
@@ -154,6 +154,23 @@ class Trace : public runtime::ObjectRef {
    * \param sch The TensorIR schedule
    */
   static void ApplyJSONToSchedule(ObjectRef json, Schedule sch);
+  /*!
+   * \brief Apply a batch of traces, sharing the replay of common trace prefixes.
+   *
+   * Traces with identical instruction sequences, e.g. a population obtained by
+   * mutating decisions of a common parent, are replayed together: the shared
+   * prefix is applied once and each member resumes on a copy of the schedule
+   * taken at the point where its decisions diverge. Prefix sharing stops at
+   * sampling instructions that do not carry a decision, which each replay is
+   * expected to re-sample independently.
+   * \param traces The traces to be replayed
+   * \param f_create A factory creating the fresh schedule a trace is replayed onto
+   * \param remove_postproc If postprocessing instructions are removed
+   * \return The resulting schedules, one per trace, in the same order
+   */
+  static Array<Schedule> ApplyToSchedulesInBatch(
+      const Array<Trace>& traces, const runtime::TypedPackedFunc<Schedule()>& f_create,
+      bool remove_postproc);
 
   TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(Trace, runtime::ObjectRef, TraceNode);
 };
@@ -745,6 +745,21 @@ TVM_DLL Pass UnifiedStaticMemoryPlanner();
  */
 TVM_DLL Pass InjectSoftwarePipeline();
 
+/*!
+ * \brief Automatically annotate eligible serial loops with the software pipeline
+ * stage/order annotations consumed by InjectSoftwarePipeline.
+ *
+ * A loop is eligible when its body stages data from global memory into shared
+ * buffers allocated under the loop and then computes on the staged data. The
+ * stage count is chosen from the shared memory budget of the target, and on
+ * CUDA targets with cp.async support the copy stage is marked asynchronous.
+ *
+ * The pass only runs when the `tir.enable_auto_software_pipeline` config is set.
+ *
+ * \return The IR transform pass.
+ */
+TVM_DLL Pass AutoSoftwarePipeline();
+
 TVM_DLL Pass BindParams(const Array<runtime::NDArray>& constants);
 
 /*!
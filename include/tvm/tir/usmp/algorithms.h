@@ -53,6 +53,19 @@ Map<BufferInfo, PoolAllocation> GreedyBySize(const Array<BufferInfo>& buffer_inf
  */
 Map<BufferInfo, PoolAllocation> GreedyByConflicts(const Array<BufferInfo>& buffer_info_arr,
                                                   const Integer& memory_pressure);
+
+/*!
+ * \brief The Greedy-by-Access algorithm to plan memory
+ *
+ * This will perform a greedy algorithm in deciding the offsets
+ * within provided Pools, using the estimated access traffic of the buffer
+ * and the memory bandwidth of the pools, so that the hottest buffers are
+ * placed in the fastest pools (e.g. VTCM on Hexagon).
+ *
+ * \return A Map of BufferInfo objects and their associated PoolAllocation
+ */
+Map<BufferInfo, PoolAllocation> GreedyByAccess(const Array<BufferInfo>& buffer_info_arr,
+                                               const Integer& memory_pressure);
 /*!
  *\brief The Hill-Climb algoritm to plan memory
  *
@@ -82,6 +82,11 @@ struct BufferInfoNode : public Object {
   Array<ObjectRef> conflicts;
   /*! \brief Whether BufferInfo object retains info about IO tensors or intermediaries */
   BufferInfoKind kind;
+  /*! \brief A static estimate of how many times the buffer is accessed during an
+   * inference, weighted by the extents of the enclosing loops. This is used by
+   * bandwidth-aware algorithms (e.g. greedy_by_access) to place the hottest
+   * buffers in the fastest pools (e.g. VTCM on Hexagon). */
+  Integer access_estimate;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("name_hint", &name_hint);
@@ -90,12 +95,14 @@ struct BufferInfoNode : public Object {
     v->Visit("alignment", &alignment);
     v->Visit("conflicts", &conflicts);
     v->Visit("kind", &kind);
+    v->Visit("access_estimate", &access_estimate);
   }
 
   bool SEqualReduce(const BufferInfoNode* other, SEqualReducer equal) const {
     return equal(name_hint, other->name_hint) && equal(size_bytes, other->size_bytes) &&
            equal(pool_candidates, other->pool_candidates) && equal(alignment, other->alignment) &&
-           equal(conflicts, other->conflicts) && equal(kind, other->kind);
+           equal(conflicts, other->conflicts) && equal(kind, other->kind) &&
+           equal(access_estimate, other->access_estimate);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
@@ -105,6 +112,7 @@ struct BufferInfoNode : public Object {
     hash_reduce(conflicts);
     hash_reduce(pool_candidates);
     hash_reduce(kind);
+    hash_reduce(access_estimate);
   }
   /*!
    * \brief Set the liveness conflicts of this BufferInfo
@@ -26,10 +26,15 @@ There are two types of feature
    This feature is invariant of loop structure.
 """
 
+import atexit
+import glob
+import hashlib
+import os
 import struct
 import numpy as np
 import tvm._ffi
 
+from tvm.ir import structural_hash
 from tvm.target import Target
 from tvm.driver import build_module
 
@@ -68,6 +73,87 @@ except ValueError as e:
     ) = _get_itervar_feature_flatten = raise_error
 
 
+# Content-addressed cache over lowered statements.
+# Identical lowered IR recurs constantly across a tuning session (and across
+# sessions on the same task), so feature vectors are cached under the
+# structural hash of the lowered stmt. The cache is enabled by pointing
+# TVM_AUTOTVM_FEATURE_CACHE_DIR at a directory and calling init_feature_cache
+# with a task key; each process appends its new entries to its own shard file,
+# so concurrent extraction workers never write the same file.
+_FEATURE_CACHE_DIR_ENV = "TVM_AUTOTVM_FEATURE_CACHE_DIR"
+_FEATURE_CACHE_VERSION = 1
+_FEATURE_CACHE_FLUSH_EVERY = 64
+
+_feature_cache = None  # dict str -> np.ndarray, merged from all shards of the task
+_feature_cache_own = None  # entries added by this process, pending flush
+_feature_cache_path = None
+_feature_cache_atexit = False
+
+
+def init_feature_cache(task_key):
+    """Enable the content-addressed feature cache for a task.
+
+    Does nothing unless the environment variable TVM_AUTOTVM_FEATURE_CACHE_DIR
+    names a directory. When enabled, get_itervar_feature_flatten and
+    get_buffer_curve_sample_flatten cache their results keyed by the
+    structural hash of the lowered stmt, both in memory and on disk, so
+    repeated lowerings of identical IR skip extraction across configs,
+    processes and tuning sessions.
+
+    Parameters
+    ----------
+    task_key: str
+        A string identifying the tuning task; the per-task cache files are
+        named after its digest.
+    """
+    global _feature_cache, _feature_cache_own, _feature_cache_path, _feature_cache_atexit
+    cache_dir = os.environ.get(_FEATURE_CACHE_DIR_ENV, "")
+    if not cache_dir:
+        _feature_cache = _feature_cache_own = _feature_cache_path = None
+        return
+    os.makedirs(cache_dir, exist_ok=True)
+    digest = hashlib.md5(task_key.encode()).hexdigest()[:16]
+    prefix = os.path.join(cache_dir, f"fea_v{_FEATURE_CACHE_VERSION}_{digest}")
+    _feature_cache = {}
+    for shard in glob.glob(prefix + ".*.npz"):
+        try:
+            with np.load(shard) as data:
+                for key in data.files:
+                    _feature_cache.setdefault(key, data[key])
+        except (IOError, ValueError):  # an in-flight or truncated shard, skip it
+            continue
+    _feature_cache_own = {}
+    _feature_cache_path = f"{prefix}.{os.getpid()}.npz"
+    if not _feature_cache_atexit:
+        atexit.register(_flush_feature_cache)
+        _feature_cache_atexit = True
+
+
+def _flush_feature_cache():
+    """Write this process's new cache entries to its shard file."""
+    if _feature_cache_path is None or not _feature_cache_own:
+        return
+    tmp_path = _feature_cache_path + ".tmp"
+    with open(tmp_path, "wb") as fout:
+        np.savez(fout, **_feature_cache_own)
+    os.replace(tmp_path, _feature_cache_path)
+
+
+def _cached_stmt_feature(stmt, key_prefix, fextract):
+    """Look up the feature vector of a lowered stmt, extracting on a miss."""
+    if _feature_cache is None:
+        return fextract(stmt)
+    key = f"{key_prefix}_{structural_hash(stmt, map_free_vars=True)}"
+    if key in _feature_cache:
+        return _feature_cache[key]
+    fea = np.array(fextract(stmt), dtype=np.float32)
+    _feature_cache[key] = fea
+    _feature_cache_own[key] = fea
+    if len(_feature_cache_own) % _FEATURE_CACHE_FLUSH_EVERY == 0:
+        _flush_feature_cache()
+    return fea
+
+
 def get_itervar_feature(sch, args, take_log=False):
     """get features of iter vars
 
@@ -135,9 +221,12 @@ def get_itervar_feature_flatten(sch, args, take_log=True):
         one-dimensional vector
     """
     stmt = ana_lower(sch, args, simple_mode=True)
-    feas = _get_itervar_feature_flatten(stmt, take_log)
-    feas = struct.unpack(f"{len(feas) // 4}f", feas)
-    return feas
+
+    def _extract(stmt):
+        feas = _get_itervar_feature_flatten(stmt, take_log)
+        return struct.unpack(f"{len(feas) // 4}f", feas)
+
+    return _cached_stmt_feature(stmt, f"itervar_{int(take_log)}", _extract)
 
 
 def get_flatten_name(fea):
@@ -209,6 +298,9 @@ def get_buffer_curve_sample_flatten(sch, args, sample_n=30):
         one-dimensional vector
     """
     stmt = ana_lower(sch, args, simple_mode=True)
-    feas = _get_buffer_curve_sample_flatten(stmt, sample_n, False)
-    feas = struct.unpack(f"{len(feas) // 4}f", feas)
-    return feas
+
+    def _extract(stmt):
+        feas = _get_buffer_curve_sample_flatten(stmt, sample_n, False)
+        return struct.unpack(f"{len(feas) // 4}f", feas)
+
+    return _cached_stmt_feature(stmt, f"curve_{sample_n}", _extract)
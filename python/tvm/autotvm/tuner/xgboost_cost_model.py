@@ -383,6 +383,8 @@ def _extract_popen_initializer(space, target, task):
     _extract_space = space
     _extract_target = target
     _extract_task = task
+    # no-op unless TVM_AUTOTVM_FEATURE_CACHE_DIR is set
+    feature.init_feature_cache(str((task.name, task.args, str(target))))
 
 
 def _extract_itervar_feature_index(args):
@@ -177,6 +177,16 @@ class GraphModule(object):
         self._get_num_inputs = module["get_num_inputs"]
         self._load_params = module["load_params"]
         self._share_params = module["share_params"]
+        try:
+            self._stage_param = module["stage_param"]
+            self._commit_params = module["commit_params"]
+        except AttributeError:
+            self._stage_param = lambda *_: (_ for _ in ()).throw(
+                Exception("stage_param is not implemented for C graph executor")
+            )
+            self._commit_params = lambda *_: (_ for _ in ()).throw(
+                Exception("commit_params is not implemented for C graph executor")
+            )
 
     def set_input(self, key=None, value=None, **params):
         """Set inputs to the module via kwargs
@@ -251,6 +261,66 @@ class GraphModule(object):
         """
         self._set_output_zero_copy(key, value)
 
+    def stage_param(self, key=None, value=None, **params):
+        """Stage new values for inputs without disturbing running inference.
+
+        The copies run asynchronously on a side stream into shadow buffers;
+        call :py:meth:`commit_params` between inferences to atomically flip
+        all staged values in. Useful for hot-swapping weights while serving.
+
+        Parameters
+        ----------
+        key : int or str
+           The input key
+
+        value : the input value.
+           The new input value
+
+        params : dict of str to NDArray
+           Additional staged parameters
+        """
+        if key is not None:
+            self._stage_param(key, value)
+        for k, v in params.items():
+            self._stage_param(k, v)
+
+    def commit_params(self):
+        """Make every parameter staged by :py:meth:`stage_param` visible.
+
+        Waits for the outstanding staging copies, then rebinds the affected
+        inputs by pointer flip; the cost is independent of the parameter
+        sizes. Call between inferences.
+        """
+        self._commit_params()
+
+    def run_async(self, callback=None, **input_dict):
+        """Enqueue forward execution of the graph and return a waitable handle.
+
+        The whole step is enqueued on the device streams; only the completion
+        wait runs off this thread, so the caller can keep several requests in
+        flight and block only when it chooses to.
+
+        Parameters
+        ----------
+        callback : Optional[Callable[[], None]]
+            Invoked on the completion thread once the run finishes.
+
+        input_dict : dict of str to NDArray
+            List of input values to be feed to
+
+        Returns
+        -------
+        handle : tvm.runtime.Module
+            A handle with ``handle["wait"]()`` blocking until completion and
+            ``handle["done"]()`` polling without blocking.
+        """
+        if input_dict:
+            self.set_input(**input_dict)
+        run_async = self.module["run_async"]
+        if callback is None:
+            return run_async()
+        return run_async(callback)
+
     def run(self, **input_dict):
         """Run forward execution of the graph
 
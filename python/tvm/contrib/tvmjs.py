@@ -63,6 +63,17 @@ def _convert_bf16_to_f32(value):
     return (data.astype("uint32") << 16).view("float32")
 
 
+def _require_zstandard():
+    try:
+        import zstandard  # pylint: disable=import-outside-toplevel
+    except ImportError:
+        raise RuntimeError(
+            "zstd-compressed ndarray cache requires the `zstandard` package, "
+            "run `pip install zstandard` to enable it"
+        )
+    return zstandard
+
+
 def _calculate_md5(filename):
     hash_md5 = hashlib.md5()
     with open(filename, "rb") as file:
@@ -80,9 +91,11 @@ class NDArrayCacheShardingManager:
         prefix: str,
         shard_cap_nbytes: int,
         initial_shard_records: Optional[Mapping[str, Any]] = None,
+        compression: Optional[str] = None,
     ):
         self.cache_dir = cache_dir
         self.prefix = prefix
+        self.compression = compression
         self.curr_records = []
         self.curr_data = bytearray()
         self.shard_records = []
@@ -149,6 +162,11 @@ class NDArrayCacheShardingManager:
 
     def update_single_record(self, rec, data):
         """Update a single record in a shard file."""
+        if self.compression is not None:
+            raise ValueError(
+                "Cannot update a record inside a compressed shard in place, "
+                "as the compressed size changes with the content."
+            )
         name = rec["name"]
         idx, old_rec = self.name_to_record[name]
         if old_rec["nbytes"] != rec["nbytes"]:
@@ -180,18 +198,64 @@ class NDArrayCacheShardingManager:
         data_path = f"{self.prefix}_{self.counter}.bin"
         full_path = os.path.join(self.cache_dir, data_path)
         self.counter += 1
+
+        shard_format = "raw-shard"
+        dict_nbytes = 0
+        if self.compression == "zstd":
+            data, dict_nbytes = self._compress_zstd(data, records)
+            shard_format = "zstd-shard"
+
         with open(full_path, "wb") as outfile:
             outfile.write(data)
 
         shard_record = {
             "dataPath": data_path,
-            "format": "raw-shard",
+            "format": shard_format,
             "nbytes": len(data),
             "records": records,
             "md5sum": _calculate_md5(full_path),
         }
+        if dict_nbytes:
+            shard_record["dictNbytes"] = dict_nbytes
         self.shard_records.append(shard_record)
 
+    @staticmethod
+    def _compress_zstd(data, records):
+        """Compress each record into its own zstd frame, sharing a dictionary.
+
+        Each record stays independently decompressible so the loader can
+        decompress records in parallel. Records in a shard are often slices of
+        the same weight layout, so a dictionary trained over them improves the
+        compression ratio of the small frames.
+
+        Updates ``byteOffset`` of each record in place to the compressed
+        offset, records the frame size as ``encodedNbytes``, and returns the
+        compressed shard contents together with the dictionary size placed at
+        the head of the shard.
+        """
+        zstandard = _require_zstandard()
+        samples = [
+            bytes(data[rec["byteOffset"] : rec["byteOffset"] + rec["nbytes"]]) for rec in records
+        ]
+        dict_bytes = b""
+        zdict = None
+        if len(samples) >= 8:
+            # dictionary training needs a reasonable number of samples;
+            # fall back to plain per-record frames on tiny shards
+            try:
+                zdict = zstandard.train_dictionary(1 << 17, samples)
+                dict_bytes = zdict.as_bytes()
+            except zstandard.ZstdError:
+                zdict = None
+        cctx = zstandard.ZstdCompressor(dict_data=zdict) if zdict else zstandard.ZstdCompressor()
+        out = bytearray(dict_bytes)
+        for rec, sample in zip(records, samples):
+            frame = cctx.compress(sample)
+            rec["byteOffset"] = len(out)
+            rec["encodedNbytes"] = len(frame)
+            out += frame
+        return bytes(out), len(dict_bytes)
+
     @property
     def pending_nbytes(self):
         """Return total bytes stored so far"""
@@ -209,6 +273,7 @@ def dump_ndarray_cache(
     shard_cap_mb=32,
     show_progress: bool = True,
     update_if_exists: bool = False,
+    compression: Optional[str] = None,
 ):
     """Dump parameters to NDArray cache.
 
@@ -239,9 +304,16 @@ def dump_ndarray_cache(
     update_if_exists: bool
         If the cache already exists, update the cache. When set to False, it will overwrite the
         existing files.
+
+    compression: Optional[str]
+        When set to "zstd", compress each record into its own zstd frame so shards
+        load faster from slow storage. Loading compressed shards requires a runtime
+        built with USE_ZSTD, or the `zstandard` package on the python side.
     """
     if encode_format not in ("raw", "f32-to-bf16"):
         raise ValueError(f"Invalie encode_format {encode_format}")
+    if compression not in (None, "zstd"):
+        raise ValueError(f"Invalid compression {compression}")
 
     records = []
     from_generator = isinstance(params, GeneratorType)
@@ -266,7 +338,11 @@ def dump_ndarray_cache(
             records = old_data["records"]
 
     shard_manager = NDArrayCacheShardingManager(
-        cache_dir, "params_shard", shard_cap_nbytes, initial_shard_records=records
+        cache_dir,
+        "params_shard",
+        shard_cap_nbytes,
+        initial_shard_records=records,
+        compression=compression,
     )
 
     param_generator = params.items() if not from_generator else params
@@ -355,7 +431,14 @@ def load_ndarray_cache(cachepath: str, device: tvm.runtime.Device):
         data_path = shard_rec["dataPath"]
         full_data_path = os.path.join(cachedir, data_path)
         raw_data = open(full_data_path, "rb").read()
-        assert shard_rec["format"] == "raw-shard"
+        is_zstd = shard_rec["format"] == "zstd-shard"
+        if is_zstd:
+            zstandard = _require_zstandard()
+            dict_nbytes = shard_rec.get("dictNbytes", 0)
+            zdict = zstandard.ZstdCompressionDict(raw_data[:dict_nbytes]) if dict_nbytes else None
+            dctx = zstandard.ZstdDecompressor(dict_data=zdict)
+        else:
+            assert shard_rec["format"] == "raw-shard"
         assert shard_rec["nbytes"] == len(raw_data)
 
         for rec in shard_rec["records"]:
@@ -367,8 +450,14 @@ def load_ndarray_cache(cachepath: str, device: tvm.runtime.Device):
             nbytes = rec["nbytes"]
 
             arr = tvm.nd.empty(shape, dtype, device=device)
-            assert offset + nbytes <= len(raw_data)
-            buffer_source = raw_data[offset : offset + nbytes]
+            if is_zstd:
+                encoded_nbytes = rec["encodedNbytes"]
+                assert offset + encoded_nbytes <= len(raw_data)
+                buffer_source = dctx.decompress(raw_data[offset : offset + encoded_nbytes])
+                assert len(buffer_source) == nbytes
+            else:
+                assert offset + nbytes <= len(raw_data)
+                buffer_source = raw_data[offset : offset + nbytes]
             if dtype == "e4m3_float8":
                 if ml_dtypes is not None:
                     dtype = ml_dtypes.float8_e4m3fn
@@ -318,6 +318,49 @@ def build(
     return OperatorModule.from_module(to_return, ir_module_by_target=annotated_mods, name=name)
 
 
+def batch_build(
+    mods: List[IRModule],
+    target: Optional[Union[str, Target]] = None,
+    target_host: Optional[Union[str, Target]] = None,
+    simple_mode: bool = False,
+) -> List[Module]:
+    """Build many TIR modules for the same target in a single FFI call.
+
+    Tuning workloads compile large batches of candidate schedules; invoking
+    :func:`build` per candidate rebuilds the lowering pipeline and crosses the
+    FFI boundary once per module. This entry point constructs the pipeline once
+    on the C++ side and reuses it for every module. Setting the environment
+    variable ``TVM_DRIVER_LOWER_CACHE=1`` additionally memoizes lowered modules
+    across calls, so structurally identical candidates skip lowering entirely.
+
+    Parameters
+    ----------
+    mods : List[IRModule]
+        The TIR modules to build. Each module is lowered and built independently.
+
+    target : Optional[Union[str, Target]]
+        The target to build every module for. Defaults to the current target
+        context, or "llvm" if there is none.
+
+    target_host : Optional[Union[str, Target]]
+        Host compilation target, if target is a device target.
+
+    simple_mode : bool
+        If True, loop partition is skipped during lowering.
+
+    Returns
+    -------
+    rt_mods : List[tvm.runtime.Module]
+        The built runtime modules, in the order of the inputs.
+    """
+    if target is None:
+        target = Target.current()
+    if target is None:
+        target = "llvm"
+    target, target_host = Target.canon_target_and_host(target, target_host)
+    return list(_driver_ffi.batch_build(mods, target, target_host, simple_mode))
+
+
 class OperatorModule(Module):
     """Wraps the Module returned by tvm.build() and captures additional outputs of that function."""
 
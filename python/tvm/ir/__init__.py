@@ -29,6 +29,7 @@ from .base import (
     assert_structural_equal,
     load_json,
     save_json,
+    structural_deduplication_groups,
     structural_equal,
     structural_hash,
 )
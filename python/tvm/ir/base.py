@@ -298,6 +298,40 @@ def structural_hash(node, map_free_vars=False):
     return _ffi_node_api.StructuralHash(node, map_free_vars)  # type: ignore # pylint: disable=no-member
 
 
+def structural_deduplication_groups(nodes, map_free_vars=False):
+    """Group a list of nodes by structural equality.
+
+    All nodes are structurally hashed in parallel, bucketed by hash, and
+    hash-colliding candidates are confirmed with deep structural equality,
+    so deduplicating n nodes avoids the n^2 pairwise comparisons of
+    repeated structural_equal calls.
+
+    Parameters
+    ----------
+    nodes : List[Object]
+        The nodes to be grouped.
+
+    map_free_vars : bool
+        Whether free variables (i.e. variables without a definition site)
+        should be mapped as equal to each other.
+
+    Return
+    ------
+    result : List[int]
+        A list of the same length as `nodes`, whose i-th entry is the index
+        of the first node structurally equal to `nodes[i]`. A node is a
+        distinct representative exactly when `result[i] == i`.
+
+    See Also
+    --------
+    structural_equal
+    structural_hash
+    """
+    nodes = [tvm.runtime.convert(node) for node in nodes]
+    groups = _ffi_node_api.StructuralDeduplicationGroups(nodes, map_free_vars)  # type: ignore # pylint: disable=no-member
+    return [int(group) for group in groups]
+
+
 def deprecated(
     method_name: str,
     new_method_name: str,
@@ -22,5 +22,6 @@ from .database import Database, PyDatabase, TuningRecord, Workload, create
 from .json_database import JSONDatabase
 from .memory_database import MemoryDatabase
 from .ordered_union_database import OrderedUnionDatabase
+from .remote_database import DatabaseService, RemoteDatabase
 from .schedule_fn_database import ScheduleFnDatabase
 from .union_database import UnionDatabase
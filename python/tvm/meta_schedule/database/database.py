@@ -221,6 +221,29 @@ class Database(Object):
         """
         return _ffi_api.DatabaseGetTopK(self, workload, top_k)  # type: ignore # pylint: disable=no-member
 
+    def get_similar_top_k(self, mod: IRModule, top_k: int) -> List[TuningRecord]:
+        """Get the top K valid tuning records of workloads similar to the given module.
+
+        Unlike `get_top_k`, which serves exact workload matches only, this indexes the
+        stored workloads by their op signature and loop-extent fingerprint and returns
+        records from near-matching workloads, e.g. the same kernel tuned at different
+        shapes. The returned traces were recorded against a different module and may fail
+        to re-apply, so callers must tolerate application failures.
+
+        Parameters
+        ----------
+        mod : IRModule
+            The IRModule whose similar workloads are searched for.
+        top_k : int
+            The number of top records to get.
+
+        Returns
+        -------
+        top_k_records : List[TuningRecord]
+            At most K records from similar workloads, nearest first.
+        """
+        return _ffi_api.DatabaseGetSimilarTopK(self, mod, top_k)  # type: ignore # pylint: disable=no-member
+
     def get_all_tuning_records(self) -> List[TuningRecord]:
         """Get all the tuning records from the database.
 
@@ -57,6 +57,7 @@ class JSONDatabase(Database):
         work_dir: Optional[str] = None,
         allow_missing: bool = True,
         module_equality: str = "structural",
+        commit_batch_size: int = 1,
     ) -> None:
         """Constructor.
 
@@ -73,6 +74,11 @@ class JSONDatabase(Database):
             and `path_workload`.
         allow_missing : bool
             Whether to create new file when the given path is not found.
+        commit_batch_size : int
+            The number of tuning records buffered in memory before they are written to the
+            record file in one batch. The default of 1 writes through on every commit; larger
+            values amortize the file I/O when measurement throughput is high. Buffered records
+            are flushed when the database is destructed.
         """
         if work_dir is not None:
             if path_workload is None:
@@ -89,4 +95,5 @@ class JSONDatabase(Database):
             path_tuning_record,
             allow_missing,
             module_equality,
+            commit_batch_size,
         )
@@ -0,0 +1,182 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A database client/service pair sharing tuning records between jobs over RPC"""
+import json
+import threading
+import uuid
+from typing import List, Optional
+
+import tvm._ffi
+from tvm.ir import IRModule
+from tvm.target import Target
+
+from ..utils import derived_object
+from .database import Database, PyDatabase, TuningRecord, Workload
+from .memory_database import MemoryDatabase
+
+_SERVICE_PREFIX = "meta_schedule.remote_database"
+
+
+class DatabaseService:
+    """The server side of the shared tuning database.
+
+    Wraps a backing database (typically a `JSONDatabase` so results persist) and registers
+    the service functions in the hosting process's global function registry, so that an RPC
+    server running in the same process serves them to `RemoteDatabase` clients. The server
+    must run with ``no_fork=True`` so every client session shares this process.
+
+    Typical usage::
+
+        database = ms.database.JSONDatabase(work_dir="/shared/tune")
+        ms.database.DatabaseService(database)
+        tvm.rpc.Server(port=9190, no_fork=True).proc.join()
+
+    Parameters
+    ----------
+    database : Database
+        The backing database shared between all clients.
+    """
+
+    def __init__(self, database: Database) -> None:
+        self.database = database
+        # The commit log: (client_id, workload_json_str, record_json_str), in commit order.
+        # Clients poll it with a cursor to subscribe to records committed by their peers.
+        self._log: List[tuple] = []
+        self._lock = threading.Lock()
+        tvm._ffi.register_func(f"{_SERVICE_PREFIX}.commit_batch", self._commit_batch, override=True)
+        tvm._ffi.register_func(f"{_SERVICE_PREFIX}.poll", self._poll, override=True)
+
+    def _commit_batch(self, client_id: str, payload: str) -> None:
+        """Commit a batch of (workload, record) JSON pairs from one client."""
+        entries = json.loads(payload)
+        with self._lock:
+            for workload_json, record_json in entries:
+                workload = Workload.from_json(json.loads(workload_json))
+                workload = self.database.commit_workload(workload.mod)
+                record = TuningRecord.from_json(json.loads(record_json), workload)
+                self.database.commit_tuning_record(record)
+                self._log.append((client_id, workload_json, record_json))
+
+    def _poll(self, client_id: str, cursor: int) -> str:
+        """Return the commits made since `cursor` by clients other than `client_id`."""
+        with self._lock:
+            entries = [
+                [workload_json, record_json]
+                for origin, workload_json, record_json in self._log[cursor:]
+                if origin != client_id
+            ]
+            new_cursor = len(self._log)
+        return json.dumps({"cursor": new_cursor, "entries": entries})
+
+
+@derived_object
+class RemoteDatabase(PyDatabase):
+    """A database client that shares tuning records with concurrent jobs via a
+    `DatabaseService` reached over the existing RPC machinery.
+
+    All reads are served from a local in-memory write-through cache; `commit_tuning_record`
+    additionally buffers the record and ships buffered records to the service in optimistic
+    batches (no coordination is needed, because tuning records are append-only and
+    idempotent to merge). Every read first polls the service for records committed by other
+    clients since the last poll, so concurrent jobs on the same model family see each
+    other's best records instead of duplicating measurements.
+
+    Parameters
+    ----------
+    tracker_host : str
+        The host of the RPC server running the `DatabaseService`.
+    tracker_port : int
+        The port of the RPC server.
+    key : str
+        The key to connect with, if the server requires one.
+    batch_size : int
+        The number of records buffered locally before a batch is shipped to the service.
+    module_equality : str
+        A string to specify the module equality testing and hashing method,
+        as in `MemoryDatabase`.
+    """
+
+    def __init__(
+        self,
+        tracker_host: str,
+        tracker_port: int,
+        key: str = "",
+        batch_size: int = 8,
+        module_equality: str = "structural",
+    ) -> None:
+        # pylint: disable=import-outside-toplevel
+        from tvm import rpc
+
+        super().__init__()
+        self._local = MemoryDatabase(module_equality)
+        self._client_id = uuid.uuid4().hex
+        self._batch_size = batch_size
+        self._pending: List[List[str]] = []
+        self._cursor = 0
+        session = rpc.connect(tracker_host, tracker_port, key)
+        self._remote_commit_batch = session.get_function(f"{_SERVICE_PREFIX}.commit_batch")
+        self._remote_poll = session.get_function(f"{_SERVICE_PREFIX}.poll")
+        self._session = session  # keep the session alive
+
+    def _sync(self) -> None:
+        """Pull records committed by other clients into the local cache."""
+        reply = json.loads(self._remote_poll(self._client_id, self._cursor))
+        self._cursor = reply["cursor"]
+        for workload_json, record_json in reply["entries"]:
+            workload = Workload.from_json(json.loads(workload_json))
+            workload = self._local.commit_workload(workload.mod)
+            record = TuningRecord.from_json(json.loads(record_json), workload)
+            self._local.commit_tuning_record(record)
+
+    def flush(self) -> None:
+        """Ship all buffered records to the service."""
+        if self._pending:
+            self._remote_commit_batch(self._client_id, json.dumps(self._pending))
+            self._pending = []
+
+    def has_workload(self, mod: IRModule) -> bool:
+        self._sync()
+        return self._local.has_workload(mod)
+
+    def commit_workload(self, mod: IRModule) -> Workload:
+        return self._local.commit_workload(mod)
+
+    def commit_tuning_record(self, record: TuningRecord) -> None:
+        self._local.commit_tuning_record(record)
+        self._pending.append(
+            [json.dumps(record.workload.as_json()), json.dumps(record.as_json())]
+        )
+        if len(self._pending) >= self._batch_size:
+            self.flush()
+
+    def get_top_k(self, workload: Workload, top_k: int) -> List[TuningRecord]:
+        self._sync()
+        return self._local.get_top_k(workload, top_k)
+
+    def get_all_tuning_records(self) -> List[TuningRecord]:
+        self._sync()
+        return self._local.get_all_tuning_records()
+
+    def query_tuning_record(
+        self, mod: IRModule, target: Target, workload_name: Optional[str] = None
+    ) -> Optional[TuningRecord]:
+        self._sync()
+        return self._local.query_tuning_record(mod, target, workload_name)
+
+    def __len__(self) -> int:
+        self._sync()
+        return len(self._local)
@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A postprocessor that prunes register-spilling candidates via early compile feedback"""
+import os
+import re
+import subprocess
+import tempfile
+
+import tvm._ffi
+from tvm._ffi.registry import register_object
+from .. import _ffi_api
+from .postproc import Postproc
+
+# Register file size per SM and max resident threads, used to estimate the
+# register-limited occupancy. These are common across recent NVIDIA GPUs; the
+# estimate only needs to be monotone in register pressure, not exact.
+_REGISTERS_PER_SM = 64 * 1024
+_MAX_THREADS_PER_SM = 2048
+
+
+@register_object("meta_schedule.VerifyRegisterUsage")
+class VerifyRegisterUsage(Postproc):
+    """A postprocessor that compiles each candidate through the target compiler and prunes
+    candidates that spill registers, or whose register-limited occupancy falls below the
+    given floor, before any device measurement is spent on them.
+
+    The compile feedback is provided by the packed function
+    ``meta_schedule.gpu_compile_feedback``; the default implementation below shells out to
+    NVCC with ``--ptxas-options=-v``. When the compiler is unavailable, candidates pass
+    through unchanged.
+
+    Parameters
+    ----------
+    min_occupancy_percent : int
+        The minimum register-limited occupancy in percent; 0 disables the occupancy check
+        and prunes spilling candidates only.
+    """
+
+    def __init__(self, min_occupancy_percent: int = 0) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.PostprocVerifyRegisterUsage,  # type: ignore # pylint: disable=no-member
+            min_occupancy_percent,
+        )
+
+
+@tvm._ffi.register_func("meta_schedule.gpu_compile_feedback")
+def _gpu_compile_feedback(mod, target):
+    """Compile the candidate with NVCC and report register usage.
+
+    Returns ``[registers_per_thread, spill_bytes, occupancy_percent]`` for the most
+    register-hungry kernel in the module, or None when feedback is unavailable, in which
+    case the candidate is not pruned.
+    """
+    # pylint: disable=import-outside-toplevel
+    if target.kind.name != "cuda":
+        return None
+    try:
+        lib = tvm.build(mod, target=target)
+        code = lib.imported_modules[0].get_source()
+        arch = target.attrs.get("arch", None)
+        cmd = ["nvcc", "--cubin", "--ptxas-options=-v", "-o", os.devnull]
+        if arch is not None:
+            cmd.append(f"-arch={arch}")
+        with tempfile.NamedTemporaryFile("w", suffix=".cu") as temp_file:
+            temp_file.write(code)
+            temp_file.flush()
+            proc = subprocess.run(
+                cmd + [temp_file.name],
+                stdout=subprocess.PIPE,
+                stderr=subprocess.PIPE,
+                check=True,
+            )
+        stderr = proc.stderr.decode("utf-8")
+    except (tvm.TVMError, subprocess.SubprocessError, OSError):
+        return None
+    num_regs = 0
+    spill_bytes = 0
+    for match in re.finditer(r"Used (\d+) registers", stderr):
+        num_regs = max(num_regs, int(match.group(1)))
+    for match in re.finditer(r"(\d+) bytes spill (?:stores|loads)", stderr):
+        spill_bytes += int(match.group(1))
+    if num_regs == 0:
+        return None
+    reg_limited_threads = _REGISTERS_PER_SM // num_regs
+    occupancy_percent = min(100, 100 * reg_limited_threads // _MAX_THREADS_PER_SM)
+    return [num_regs, spill_bytes, occupancy_percent]
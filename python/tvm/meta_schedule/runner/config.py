@@ -41,6 +41,17 @@ class EvaluatorConfig(NamedTuple):
         increase the number of runs to the given time (in ms) to reduce the measurement error.
     enable_cpu_cache_flush: bool
         Whether to flush the cache on CPU.
+    adaptive: bool
+        Whether to measure adaptively. When enabled, each candidate is first probed with a
+        single repeat; candidates slower than `adaptive_early_stop_k` times the best latency
+        seen so far (for the same argument signature) are not measured further, and the
+        remaining candidates accumulate up to `repeat` repeats but stop early once the
+        coefficient of variation of the collected costs drops below `adaptive_cv_threshold`.
+    adaptive_early_stop_k: float
+        The early-stop multiplier over the incumbent latency. Only used when `adaptive` is on.
+    adaptive_cv_threshold: float
+        Stop repeating once the coefficient of variation of the measured costs falls below
+        this value. Only used when `adaptive` is on.
 
     Note
     ----
@@ -52,6 +63,9 @@ class EvaluatorConfig(NamedTuple):
     repeat: int = 1
     min_repeat_ms: int = 100
     enable_cpu_cache_flush: bool = False
+    adaptive: bool = False
+    adaptive_early_stop_k: float = 8.0
+    adaptive_cv_threshold: float = 0.02
 
     @staticmethod
     def _normalized(config: Optional["EvaluatorConfig"]) -> "EvaluatorConfig":
@@ -62,6 +76,9 @@ class EvaluatorConfig(NamedTuple):
             repeat=config.repeat,
             min_repeat_ms=config.min_repeat_ms,
             enable_cpu_cache_flush=config.enable_cpu_cache_flush,
+            adaptive=config.adaptive,
+            adaptive_early_stop_k=config.adaptive_early_stop_k,
+            adaptive_cv_threshold=config.adaptive_cv_threshold,
         )
         return config
 
@@ -101,6 +101,8 @@ def run_evaluator_common(
     costs: List[float]
         The evaluator results
     """
+    if getattr(evaluator_config, "adaptive", False):
+        return run_evaluator_adaptive(rt_mod, device, evaluator_config, repeated_args)
     evaluator = rt_mod.time_evaluator(
         func_name=rt_mod.entry_name,
         dev=device,
@@ -118,3 +120,91 @@ def run_evaluator_common(
         repeated_costs.append(profile_result.results)
     costs = [float(cost) for cost in itertools.chain.from_iterable(repeated_costs)]
     return costs
+
+
+# The best mean latency seen by this worker process, keyed by the argument signature of the
+# workload. Worker processes are reused across candidates of the same tuning task, so the
+# incumbent accumulates over a tuning session; keying by argument signature keeps interleaved
+# tasks from cutting each other off.
+_ADAPTIVE_INCUMBENT: Dict[str, float] = {}
+
+
+def _coefficient_of_variation(costs: List[float]) -> float:
+    mean = sum(costs) / len(costs)
+    if mean <= 0:
+        return 0.0
+    variance = sum((cost - mean) ** 2 for cost in costs) / (len(costs) - 1)
+    return (variance**0.5) / mean
+
+
+def run_evaluator_adaptive(
+    rt_mod: Module,
+    device: Device,
+    evaluator_config: EvaluatorConfig,
+    repeated_args: List[T_ARGUMENT_LIST],
+) -> List[float]:
+    """Run the evaluator with early stopping and adaptive repeat counts.
+
+    Each candidate is probed with a single repeat first. Candidates slower than
+    `adaptive_early_stop_k` times the incumbent latency for the same argument signature
+    are returned after the probe: they only need to be ranked, not timed precisely.
+    Surviving candidates accumulate repeats up to `evaluator_config.repeat`, stopping as
+    soon as the coefficient of variation of the collected costs drops below
+    `adaptive_cv_threshold`, so stable kernels stop early and noisy ones keep the full
+    repeat budget.
+
+    Parameters
+    ----------
+    rt_mod: Module
+        The runtime module
+    device: Device
+        The device to run the evaluator
+    evaluator_config: EvaluatorConfig
+        The evaluator config
+    repeated_args: List[T_ARGUMENT_LIST]
+        The repeated arguments
+
+    Returns
+    -------
+    costs: List[float]
+        The evaluator results
+    """
+    evaluator = rt_mod.time_evaluator(
+        func_name=rt_mod.entry_name,
+        dev=device,
+        number=evaluator_config.number,
+        repeat=1,
+        min_repeat_ms=evaluator_config.min_repeat_ms,
+        f_preproc="cache_flush_cpu_non_first_arg"
+        if evaluator_config.enable_cpu_cache_flush
+        else "",
+    )
+    incumbent_key = repr([(arg.shape, arg.dtype) for arg in repeated_args[0]])
+    args_iter = itertools.cycle(repeated_args)
+    max_repeat = max(int(evaluator_config.repeat), 1)
+
+    # Probe with a single repeat.
+    device.sync()
+    costs: List[float] = [float(cost) for cost in evaluator(*next(args_iter)).results]
+
+    probe = sum(costs) / len(costs)
+    incumbent = _ADAPTIVE_INCUMBENT.get(incumbent_key, None)
+    if incumbent is None or probe < incumbent:
+        _ADAPTIVE_INCUMBENT[incumbent_key] = probe
+    elif probe > evaluator_config.adaptive_early_stop_k * incumbent:
+        # A clear loser: the probe is accurate enough to rank it.
+        return costs
+
+    # Refine until the measurement is stable or the repeat budget is exhausted.
+    while len(costs) < max_repeat:
+        if len(costs) >= 2 and (
+            _coefficient_of_variation(costs) < evaluator_config.adaptive_cv_threshold
+        ):
+            break
+        device.sync()
+        costs.extend(float(cost) for cost in evaluator(*next(args_iter)).results)
+
+    best = min(costs)
+    if best < _ADAPTIVE_INCUMBENT[incumbent_key]:
+        _ADAPTIVE_INCUMBENT[incumbent_key] = best
+    return costs
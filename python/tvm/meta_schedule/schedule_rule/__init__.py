@@ -23,6 +23,7 @@ from .add_rfactor import AddRFactor
 from .apply_custom_rule import ApplyCustomRule
 from .auto_bind import AutoBind
 from .auto_inline import AutoInline, InlineConstantScalars
+from .cache_oblivious_tiling import CacheObliviousTiling
 from .cross_thread_reduction import CrossThreadReduction
 from .multi_level_tiling import (
     MultiLevelTiling,
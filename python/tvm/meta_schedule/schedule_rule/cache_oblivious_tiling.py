@@ -0,0 +1,53 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Cache-oblivious tiling rule that halves every axis level by level"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("meta_schedule.CacheObliviousTiling")
+class CacheObliviousTiling(ScheduleRule):
+    """Rule that tiles a block with a cache-oblivious loop structure.
+
+    Instead of sampling tile sizes that fit one particular cache hierarchy, the
+    rule halves every data-parallel and reduction axis simultaneously for a
+    controlled number of levels, the iterative lowering of the recursive
+    subdivision of a cache-oblivious algorithm. The produced schedule contains
+    no sampling instructions, so it is portable across targets with different
+    cache hierarchies.
+
+    Parameters
+    ----------
+    depth : int
+        The maximum number of halving levels, i.e. the recursion depth.
+    min_inner_extent : int
+        Stop halving an axis once its tile extent would drop below this,
+        e.g. to keep the innermost tile vectorizable.
+    """
+
+    def __init__(
+        self,
+        depth: int = 4,
+        min_inner_extent: int = 8,
+    ) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleCacheObliviousTiling,  # type: ignore # pylint: disable=no-member
+            depth,
+            min_inner_extent,
+        )
@@ -34,6 +34,7 @@ class GradientBased(TaskScheduler):
         alpha: float = 0.2,
         window_size: int = 3,
         seed: int = -1,
+        stall_rounds: int = 0,
     ) -> None:
         """Constructor.
 
@@ -45,6 +46,10 @@ class GradientBased(TaskScheduler):
             The parameter to control backward window size in gradient computation.
         seed : int = -1
             The random seed.
+        stall_rounds : int = 0
+            Preempt a task after this many consecutive measurement rounds without
+            improvement of its best latency, so the remaining budget goes to tasks
+            that are still improving. 0 means never preempt.
         """
         self.__init_handle_by_constructor__(
             _ffi_api.TaskSchedulerGradientBased,  # type: ignore # pylint: disable=no-member
@@ -52,4 +57,5 @@ class GradientBased(TaskScheduler):
             alpha,
             window_size,
             seed,
+            stall_rounds,
         )
@@ -267,3 +267,54 @@ def compile_tir(
     if not isinstance(target, Target):
         target = Target(target)
     return database.query_schedule(mod, target, workload_name="main")
+
+
+def compile_tir_variants(
+    database: Database,
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    target: Union[Target, str],
+    top_k: int = 4,
+):
+    """Compile the top-K schedule variants of a TIR function into one runtime module.
+
+    The best record provides the entry function `main`; the next records are exported
+    alongside it as ``main__variant_0``, ``main__variant_1``, and so on. The runtime's
+    library function lookup recognizes this naming scheme and returns a dispatcher that
+    measures the variants on the deployment hardware during a warmup window and locks in
+    the fastest one per shape bucket, so shapes unseen at tuning time are not stuck with
+    whichever variant won on the tuning machine.
+
+    Parameters
+    ----------
+    database : Database
+        The database of tuning records.
+    mod : Union[ir.IRModule, tir.PrimFunc]
+        The TIR function to compile.
+    target : Union[str, Target]
+        The target to compile for.
+    top_k : int
+        The number of schedule variants to export.
+
+    Returns
+    -------
+    rt_mod : tvm.runtime.Module
+        The compiled module containing the entry function and its variants.
+    """
+    # pylint: disable=import-outside-toplevel
+    from tvm.driver import build as tvm_build
+
+    mod = _normalize_mod(mod)
+    if not isinstance(target, Target):
+        target = Target(target)
+    workload = database.commit_workload(mod)
+    records = database.get_top_k(workload, top_k)
+    if not records:
+        raise ValueError("The database has no tuning records for the given module")
+    functions = {}
+    for index, record in enumerate(records):
+        sch = tir.Schedule(mod)
+        record.trace.apply_to_schedule(sch, remove_postproc=False)
+        name = "main" if index == 0 else f"main__variant_{index - 1}"
+        functions[name] = sch.mod["main"].with_attr("global_symbol", name)
+    variant_mod = ir.IRModule({name: func for name, func in functions.items()})
+    return tvm_build(variant_mod, target=target)
@@ -19,4 +19,8 @@
 from . import contrib
 from .cumsum import gpu_2d_continuous_cumsum
 from .pattern import get_tir_pattern
-from .sampling import gpu_multinomial_from_uniform, generic_get_sample_index
+from .sampling import (
+    gpu_multinomial_from_uniform,
+    gpu_sample_top_p_from_prob,
+    generic_get_sample_index,
+)
@@ -18,6 +18,7 @@
 """Backend kernels for sampling operator."""
 
 import math
+from types import SimpleNamespace
 from typing import Callable, Optional
 from tvm.script import tir as T
 from tvm.tir import PrimFunc
@@ -28,45 +29,21 @@ def _is_power_of_two(n: int):
     return n > 0 and (n & (n - 1)) == 0
 
 
-def gpu_multinomial_from_uniform(
-    prob_dtype: str = "float32",
-    sample_dtype: str = "float32",
-    sample_indices_dtype: str = "int64",
-    dtype: str = "int64",
-    ty_len: int = 4,
-    tx_len: int = 32,
-    thread_elem: int = 4,
-    eps: float = 1e-6,
-) -> PrimFunc:
-    """Generate GPU kernel for multinomial_from_uniform operator.
-
-    Parameters
-    ----------
-    ty_len : int
-        The length of `threadIdx.y`
-
-    tx_len : int
-        The length of `threadIdx.x`
-
-    thread_elem : int
-        The number of elements processed by single thread
-
-    prob_dtype : str
-        The probability data type
-
-    sample_dtype : str
-        The sample data type
-
-    sample_indices_dtype : str
-        The sample indices data type
-
-    dtype : str
-        The output data type
-
-    Returns
-    -------
-    func : PrimFunc
-        The generated function
+def _make_sampling_primitives(
+    prob_dtype: str,
+    dtype: str,
+    tx_len: int,
+    ty_len: int,
+    thread_elem: int,
+    eps: float,
+) -> SimpleNamespace:
+    """Build the block-level primitives shared by the sampling kernels.
+
+    The returned namespace carries the thread-geometry constants and the
+    `single_batch_sampling` macro, which scans one block-sized chunk of the
+    vocabulary: it accumulates the mass of elements above `threshold` and, when
+    the running aggregate crosses `uniform_sample`, selects the crossing index
+    via a block cumsum and a masked min-reduction.
     """
 
     TX = T.int64(tx_len)  # threadIdx.x
@@ -75,23 +52,13 @@ def gpu_multinomial_from_uniform(
     # number of elements to be processed by single thread
     thread_elem = T.int64(thread_elem)
     # number of elements to be processed by single warp
-    warp_elem = T.int64(tx_len * thread_elem)
+    warp_elem = T.int64(tx_len * int(thread_elem))
     # number of elements to be processed by single block(SM)
-    block_elem = T.int64(tx_len * ty_len * thread_elem)
+    block_elem = T.int64(tx_len * ty_len * int(thread_elem))
 
     LOG_TX = T.int64(int(math.log2(tx_len)))
     LOG_TY = T.int64(int(math.log2(ty_len)))
 
-    if (
-        not _is_power_of_two(tx_len)
-        or not _is_power_of_two(ty_len)
-        or not _is_power_of_two(thread_elem)
-    ):
-        raise ValueError(
-            "Configuration of tx_len, ty_len, thread_elem must be power of 2,"
-            f"but got {tx_len}, {ty_len}, {thread_elem}"
-        )
-
     @T.macro
     def block_cumsum(
         ty: T.int64,
@@ -253,6 +220,73 @@ def gpu_multinomial_from_uniform(
 
             aggregate[()] += step_aggregate[()]
 
+    return SimpleNamespace(
+        TX=TX,
+        TY=TY,
+        thread_elem=thread_elem,
+        warp_elem=warp_elem,
+        block_elem=block_elem,
+        single_batch_sampling=single_batch_sampling,
+    )
+
+
+def _check_thread_geometry(tx_len: int, ty_len: int, thread_elem: int):
+    if (
+        not _is_power_of_two(tx_len)
+        or not _is_power_of_two(ty_len)
+        or not _is_power_of_two(thread_elem)
+    ):
+        raise ValueError(
+            "Configuration of tx_len, ty_len, thread_elem must be power of 2,"
+            f"but got {tx_len}, {ty_len}, {thread_elem}"
+        )
+
+
+def gpu_multinomial_from_uniform(
+    prob_dtype: str = "float32",
+    sample_dtype: str = "float32",
+    sample_indices_dtype: str = "int64",
+    dtype: str = "int64",
+    ty_len: int = 4,
+    tx_len: int = 32,
+    thread_elem: int = 4,
+    eps: float = 1e-6,
+) -> PrimFunc:
+    """Generate GPU kernel for multinomial_from_uniform operator.
+
+    Parameters
+    ----------
+    ty_len : int
+        The length of `threadIdx.y`
+
+    tx_len : int
+        The length of `threadIdx.x`
+
+    thread_elem : int
+        The number of elements processed by single thread
+
+    prob_dtype : str
+        The probability data type
+
+    sample_dtype : str
+        The sample data type
+
+    sample_indices_dtype : str
+        The sample indices data type
+
+    dtype : str
+        The output data type
+
+    Returns
+    -------
+    func : PrimFunc
+        The generated function
+    """
+    _check_thread_geometry(tx_len, ty_len, thread_elem)
+    prims = _make_sampling_primitives(prob_dtype, dtype, tx_len, ty_len, thread_elem, eps)
+    TX, TY, block_elem = prims.TX, prims.TY, prims.block_elem
+    single_batch_sampling = prims.single_batch_sampling
+
     @T.prim_func
     def parallel_sampling_from_prob(
         var_prob: T.handle,
@@ -303,6 +337,152 @@ def gpu_multinomial_from_uniform(
     return parallel_sampling_from_prob
 
 
+def gpu_sample_top_p_from_prob(
+    prob_dtype: str = "float32",
+    sample_dtype: str = "float32",
+    sample_indices_dtype: str = "int64",
+    dtype: str = "int64",
+    ty_len: int = 4,
+    tx_len: int = 32,
+    thread_elem: int = 4,
+    eps: float = 1e-6,
+) -> PrimFunc:
+    """Generate a fused GPU kernel for batched top-p sampling from probabilities.
+
+    The kernel keeps the whole pipeline on device, replacing the CPU builtin
+    `vm.builtin.sample_top_p_from_prob` that copies a full vocabulary row to the
+    host per token. It uses the same pivot heuristic as the CPU path: elements
+    with probability below `top_p / 1024` cannot all fit in the nucleus by the
+    pigeonhole principle, so the first phase sums the mass above that pivot and
+    the second phase inverse-CDF samples `u * mass` within the filtered set. If
+    the pivot turns out to remove too much mass (sum below `top_p`, a rare
+    near-uniform distribution), the kernel falls back to sampling the full row,
+    matching the CPU fallback. One block handles one batch row, so all
+    sequences of a decode step are sampled in a single launch.
+
+    The signature is `f(prob, uniform_samples, row_indices, top_p, token_ids)`
+    where `top_p` is a per-row `(batch_size, 1)` tensor, allowing per-sequence
+    sampling parameters.
+
+    Parameters
+    ----------
+    ty_len : int
+        The length of `threadIdx.y`
+
+    tx_len : int
+        The length of `threadIdx.x`
+
+    thread_elem : int
+        The number of elements processed by single thread
+
+    prob_dtype : str
+        The probability data type
+
+    sample_dtype : str
+        The sample data type
+
+    sample_indices_dtype : str
+        The sample indices data type
+
+    dtype : str
+        The output data type
+
+    Returns
+    -------
+    func : PrimFunc
+        The generated function
+    """
+    _check_thread_geometry(tx_len, ty_len, thread_elem)
+    prims = _make_sampling_primitives(prob_dtype, dtype, tx_len, ty_len, thread_elem, eps)
+    TX, TY, block_elem = prims.TX, prims.TY, prims.block_elem
+    single_batch_sampling = prims.single_batch_sampling
+
+    @T.prim_func
+    def parallel_top_p_sampling_from_prob(
+        var_prob: T.handle,
+        var_uniform_samples: T.handle,
+        var_row_indices: T.handle,
+        var_top_p: T.handle,
+        var_sampled_token_ids: T.handle,
+    ):
+        T.func_attr({"tir.is_scheduled": 1})
+        n, vocab_size, batch_size = T.int64(), T.int64(), T.int64()
+        # match buffers
+        prob = T.match_buffer(var_prob, (n, vocab_size), prob_dtype)
+        uniform_samples = T.match_buffer(var_uniform_samples, (batch_size, 1), sample_dtype)
+        row_indices = T.match_buffer(var_row_indices, (batch_size, 1), sample_indices_dtype)
+        top_p_arr = T.match_buffer(var_top_p, (batch_size, 1), prob_dtype)
+        token_ids = T.match_buffer(var_sampled_token_ids, (batch_size, 1), dtype)
+        # local buffers
+        aggregate = T.alloc_buffer((), prob_dtype, scope="local")
+        filtered_mass = T.alloc_buffer((), prob_dtype, scope="local")
+        pivot = T.alloc_buffer((), prob_dtype, scope="local")
+        target = T.alloc_buffer((), prob_dtype, scope="local")
+        sample_id_local = T.alloc_buffer((), dtype, scope="local")
+        step_iter = T.alloc_buffer((), "int32", scope="local")
+
+        for bx in T.thread_binding(batch_size, thread="blockIdx.x"):
+            row_idx = row_indices[bx, 0]
+            for ty in T.thread_binding(TY, thread="threadIdx.y"):
+                for tx in T.thread_binding(TX, thread="threadIdx.x"):
+                    u = uniform_samples[bx, 0]
+                    pivot[()] = top_p_arr[bx, 0] * T.Cast(prob_dtype, 1.0 / 1024.0)
+                    # Phase 1: total mass above the pivot. Passing a target of 2
+                    # (above any possible mass) keeps the selection path of
+                    # single_batch_sampling disabled, so this is a pure reduction.
+                    aggregate[()] = T.Cast(prob_dtype, 0)
+                    step_iter[()] = T.int32(0)
+                    while T.tvm_thread_invariant(
+                        T.Cast("int64", step_iter[()]) < T.ceildiv(vocab_size, block_elem)
+                    ):
+                        single_batch_sampling(
+                            prob,
+                            row_idx,
+                            vocab_size,
+                            ty,
+                            tx,
+                            T.Cast("int64", step_iter[()]),
+                            pivot[()],
+                            aggregate,
+                            2.0,
+                            sample_id_local,
+                        )
+                        step_iter[()] += 1
+                    filtered_mass[()] = aggregate[()]
+                    # The pivot cut away so much that the remainder cannot cover
+                    # the nucleus; retry over the full row (rare).
+                    if filtered_mass[()] < top_p_arr[bx, 0]:
+                        pivot[()] = T.Cast(prob_dtype, 0)
+                        filtered_mass[()] = T.Cast(prob_dtype, 1)
+                    # Phase 2: inverse-CDF sampling of u * mass over the
+                    # filtered set.
+                    target[()] = u * filtered_mass[()]
+                    aggregate[()] = T.Cast(prob_dtype, 0)
+                    step_iter[()] = T.int32(0)
+                    # at least one iteration
+                    while T.tvm_thread_invariant(
+                        (step_iter[()] == 0 or aggregate[()] < target[()] - eps)
+                        and T.Cast("int64", step_iter[()]) < T.ceildiv(vocab_size, block_elem)
+                    ):
+                        single_batch_sampling(
+                            prob,
+                            row_idx,
+                            vocab_size,
+                            ty,
+                            tx,
+                            T.Cast("int64", step_iter[()]),
+                            pivot[()],
+                            aggregate,
+                            target[()],
+                            sample_id_local,
+                        )
+                        step_iter[()] += 1
+                    if tx == 0 and ty == 0:
+                        token_ids[bx, 0] = sample_id_local[()]
+
+    return parallel_top_p_sampling_from_prob
+
+
 def generic_get_sample_index(
     prob_dtype: str = "float32",
     sample_dtype: str = "float32",
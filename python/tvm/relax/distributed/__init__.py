@@ -19,5 +19,6 @@
 
 from .global_info import DeviceMesh, device_mesh
 from .struct_info import Placement, DTensorStructInfo, PlacementSpec
+from .auto_sharding import CollectiveCostModel, plan_shardings
 
 from . import transform
@@ -83,6 +83,10 @@ def default_build_pipeline():
             [
                 backend.DispatchSampling(),
                 backend.DispatchSortScan(),
+                # Rewrite eligible last-use producer/consumer pairs to in-place
+                # calls while dataflow blocks (and liveness) are still available;
+                # the freed tensors then never reach the memory planner.
+                transform.DataflowUseInplaceCalls(),
                 transform.LegalizeOps(),
                 transform.RewriteDataflowReshape(),
                 transform.ToNonDataflow(),
@@ -37,6 +37,7 @@ from .transform import (
     DecomposeOpsForInference,
     DecomposeOpsForTraining,
     EliminateCommonSubexpr,
+    EliminateRedundantCopies,
     ExpandMatmulOfSum,
     ExpandTupleArguments,
     FewShotTuning,
@@ -72,6 +73,7 @@ from .transform import (
     RewriteCUDAGraph,
     RewriteDataflowReshape,
     RunCodegen,
+    SpecializeSymbolicVarDispatch,
     SplitCallTIRByPattern,
     StaticPlanBlockMemory,
     ToMixedPrecision,
@@ -86,6 +88,7 @@ from .transform import (
 )
 
 from .attach_external_modules import AttachExternModules
+from .block_sparse import ConvertToBlockSparse
 from .fast_math import FastMathTransform
 from .fuse_transpose_matmul import FuseTransposeMatmul
 from .ipc_allreduce_rewrite import IPCAllReduceRewrite
@@ -0,0 +1,146 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, unused-argument
+"""Relax pass converting dense matmuls on block-sparse weights to BSR kernels."""
+import functools
+import operator
+
+import numpy as np
+
+import tvm
+from tvm import relax, topi
+from tvm.ir.module import IRModule
+from tvm.relax import Call, Expr, PyExprMutator, expr_functor
+
+
+def _to_bsr(weight: np.ndarray, blocksize, sparsity_threshold):
+    """Convert an (N, K) weight to its BSR parts when it is sparse enough.
+
+    Returns the (data, indices, indptr) constants, or None when the weight
+    does not tile by `blocksize` or is denser than `sparsity_threshold`.
+    """
+    # pylint: disable=import-outside-toplevel
+    import scipy.sparse as sp
+
+    if weight.ndim != 2:
+        return None
+    if weight.shape[0] % blocksize[0] != 0 or weight.shape[1] % blocksize[1] != 0:
+        return None
+    sparsity = 1.0 - (np.count_nonzero(weight) / weight.size)
+    if sparsity < sparsity_threshold:
+        return None
+    sparse_weight = sp.bsr_matrix(weight, blocksize=blocksize)
+    return (
+        relax.const(sparse_weight.data),
+        relax.const(sparse_weight.indices),
+        relax.const(sparse_weight.indptr),
+    )
+
+
+@expr_functor.mutator
+class _BlockSparseRewriter(PyExprMutator):
+    """Rewrites matmuls with qualifying constant weights to topi.nn.sparse_dense."""
+
+    def __init__(self, mod, blocksize, sparsity_threshold):
+        super().__init__(mod)
+        self.blocksize = blocksize
+        self.sparsity_threshold = sparsity_threshold
+
+    def _weight_as_nk(self, arg):
+        """Return the weight of `matmul(x, arg)` as an (N, K) numpy array, or None."""
+        if isinstance(arg, relax.Var):
+            bound = self.lookup_binding(arg)
+            if (
+                isinstance(bound, Call)
+                and bound.op == tvm.ir.Op.get("relax.permute_dims")
+                and isinstance(bound.args[0], relax.Constant)
+            ):
+                axes = bound.attrs.axes
+                if axes is None or list(axes) == [1, 0]:
+                    weight = bound.args[0].data.numpy()
+                    if weight.ndim == 2:
+                        # matmul(x, w.T): w is already laid out as (N, K).
+                        return weight
+            arg = bound
+        if isinstance(arg, relax.Constant):
+            weight = arg.data.numpy()
+            if weight.ndim == 2:
+                return np.ascontiguousarray(weight.transpose())
+        return None
+
+    def visit_call_(self, call: Call) -> Expr:
+        if call.op != tvm.ir.Op.get("relax.matmul"):
+            return super().visit_call_(call)
+        out_dtype = call.attrs.out_dtype
+        x = call.args[0]
+        x_sinfo = x.struct_info
+        if (
+            not isinstance(x_sinfo, relax.TensorStructInfo)
+            or x_sinfo.ndim < 2
+            or x_sinfo.shape is None
+            or (out_dtype and out_dtype != x_sinfo.dtype)
+        ):
+            return super().visit_call_(call)
+        weight = self._weight_as_nk(call.args[1])
+        if weight is None:
+            return super().visit_call_(call)
+        bsr = _to_bsr(weight, self.blocksize, self.sparsity_threshold)
+        if bsr is None:
+            return super().visit_call_(call)
+        w_data, w_indices, w_indptr = bsr
+        x_shape = list(x_sinfo.shape)
+        if x_sinfo.ndim > 2:
+            # sparse_dense is a 2-D kernel; fold the leading dims around it.
+            rows = functools.reduce(operator.mul, x_shape[:-1])
+            x = self.builder_.emit(relax.op.reshape(x, [rows, x_shape[-1]]))
+        out = self.builder_.emit(
+            self.builder_.call_te(topi.nn.sparse_dense, x, w_data, w_indices, w_indptr, False)
+        )
+        if x_sinfo.ndim > 2:
+            out = relax.op.reshape(out, x_shape[:-1] + [weight.shape[0]])
+        return out
+
+
+@tvm.transform.module_pass(opt_level=0, name="ConvertToBlockSparse")
+class ConvertToBlockSparse:
+    """Convert dense matmuls on block-sparse constant weights to BSR kernels.
+
+    Matmuls whose weight is a constant (directly, or through a 2-D transpose
+    as emitted for linear layers) are rewritten to topi.nn.sparse_dense when
+    the fraction of all-zero `blocksize` blocks reaches `sparsity_threshold`;
+    the weight is replaced by its BSR data/indices/indptr constants. The
+    existing topi schedules for sparse_dense then apply as usual.
+
+    Parameters
+    ----------
+    blocksize : Tuple[int, int]
+        Blocksize of the BSR matrix.
+    sparsity_threshold : float
+        Minimal sparsity requirement for converting to sparse operation.
+    """
+
+    def __init__(self, blocksize=(16, 1), sparsity_threshold=0.7):
+        self.blocksize = blocksize
+        self.sparsity_threshold = sparsity_threshold
+
+    def transform_module(self, mod: IRModule, ctx: tvm.transform.PassContext) -> IRModule:
+        rewriter = _BlockSparseRewriter(mod, self.blocksize, self.sparsity_threshold)
+        for gv, func in mod.functions_items():
+            if isinstance(func, tvm.relax.Function):
+                func = rewriter.visit_expr(func)
+                rewriter.builder_.update_func(gv, func)
+        return rewriter.builder_.get()
@@ -49,7 +49,10 @@ class DataflowBlockPass(tvm.ir.transform.Pass):
 
 
 def Gradient(
-    func_name: str, require_grads: Optional[Union[Var, List[Var]]] = None, target_index: int = 0
+    func_name: str,
+    require_grads: Optional[Union[Var, List[Var]]] = None,
+    target_index: int = 0,
+    share_adjoints: bool = False,
 ) -> tvm.ir.transform.Pass:
     """Reverse-mode automatic differentiation.
 
@@ -96,6 +99,13 @@ def Gradient(
         If the specified function has more than one return values, specify the index of the return
         value as the target. If it is not specified, the first return value will be the target.
 
+    share_adjoints : bool
+        Whether to share structurally identical adjoint subexpressions across bindings
+        (hash-consed expression building) while generating the backward bindings. This reduces
+        the size and the memory footprint of the generated training graph, at the cost of the
+        generated bindings no longer mirroring the forward bindings one-to-one. For prompt
+        release of the shared intermediates, compose with KillAfterLastUse after lowering.
+
     Returns
     -------
     ret : tvm.ir.transform.Pass
@@ -222,7 +232,7 @@ def Gradient(
     if require_grads is not None and not isinstance(require_grads, list):
         require_grads = [require_grads]
 
-    return _ffi_api.Gradient(func_name, require_grads, target_index)  # type: ignore
+    return _ffi_api.Gradient(func_name, require_grads, target_index, share_adjoints)  # type: ignore
 
 
 def ToNonDataflow() -> tvm.ir.transform.Pass:
@@ -480,6 +490,21 @@ def EliminateCommonSubexpr(call_only=False) -> FunctionPass:
     return _ffi_api.EliminateCommonSubexpr(call_only)  # type: ignore
 
 
+def EliminateRedundantCopies() -> tvm.ir.transform.Pass:
+    """Eliminate call_tir full-tensor copies whose source is never re-mutated.
+
+    The results of such copies are rebound to alias the source tensor, so the
+    copy kernels become dead code; run DeadCodeElimination afterwards to
+    remove them.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass that eliminates redundant copies.
+    """
+    return _ffi_api.EliminateRedundantCopies()  # type: ignore
+
+
 def UpdateVDevice(new_vdevice: tvm.ir.VDevice, index: int) -> tvm.ir.transform.Pass:
     """Update virtual device.
 
@@ -694,6 +719,46 @@ def BindSymbolicVars(
     return _ffi_api.BindSymbolicVars(binding_map, func_name)  # type: ignore
 
 
+def SpecializeSymbolicVarDispatch(
+    func_name: str,
+    specializations: List[Mapping[Union[str, tvm.tir.Var], tvm.tir.PrimExpr]],
+) -> tvm.ir.transform.Pass:
+    """Specialize a function under symbolic-shape bindings with runtime dispatch.
+
+    The function is cloned once per specialization, with the bound symbolic
+    variables propagated and the resulting constant shape arithmetic folded.
+    The original function is replaced with a dispatcher that evaluates each
+    specialization predicate in order and calls the first matching clone,
+    falling back to a generic copy of the original body.  This yields
+    branch-free kernels for hot shape regimes (e.g. the `n == 1` decode step
+    of a language model) without maintaining separate model exports.
+
+    Parameters
+    ----------
+    func_name : str
+        The name of the function to specialize.
+
+    specializations : List[Mapping[Union[str, tvm.tir.Var], tvm.tir.PrimExpr]]
+        The specializations to generate.  Each entry is a binding map as
+        accepted by :py:func:`BindSymbolicVars`; the corresponding clone is
+        guarded by the conjunction of the equalities it binds.
+
+    Returns
+    -------
+    ret: tvm.ir.transform.Pass
+    """
+    # Relax uses int64 for symbolic variables, but the FFI
+    # converts python integers into int32.
+    specializations = [
+        {
+            key: tvm.tir.const(value, "int64") if isinstance(value, int) else value
+            for key, value in binding_map.items()
+        }
+        for binding_map in specializations
+    ]
+    return _ffi_api.SpecializeSymbolicVarDispatch(func_name, specializations)  # type: ignore
+
+
 def RunCodegen(
     target_options: Optional[dict] = None,
     entry_functions: Optional[List[str]] = None,
@@ -1383,7 +1448,10 @@ def DeadCodeElimination(entry_functions: Optional[List[str]] = None) -> tvm.ir.t
 
 
 def ToMixedPrecision(
-    out_dtype="float32", fp16_input_names: Optional[List[str]] = None
+    out_dtype="float32",
+    fp16_input_names: Optional[List[str]] = None,
+    calibrated_absmax: Optional[Dict[str, float]] = None,
+    op_fp16_speedup: Optional[Dict[str, float]] = None,
 ) -> tvm.ir.transform.Pass:
     """Automatic mixed precision pass. Currently the pass assumes the input module to be fp32
     only, and will automatically cast fp32 to fp16 for certain ops.
@@ -1397,13 +1465,24 @@ def ToMixedPrecision(
     fp16_input_names : List[str]
         The names of function parameters whose dtype should become fp16. The  function signature
         would change accordingly.
+    calibrated_absmax : Optional[Dict[str, float]]
+        Per-op-name largest absolute output value observed when running the fp32 module on
+        calibration inputs, e.g. collected with the `vm.builtin.value_range_profile_instrument`
+        VM instrument. Ops whose observed range fits fp16 with headroom may be relaxed to run in
+        fp16, while ops with observed fp16 overflow are kept in fp32 regardless of their static
+        policy.
+    op_fp16_speedup : Optional[Dict[str, float]]
+        Per-op-name fp16-over-fp32 throughput ratio measured once per target device. Ops with a
+        ratio at or below 1.0 are never actively cast to fp16.
 
     Returns
     -------
     ret : tvm.transform.Pass
         The registered pass for mixed precision.
     """
-    return _ffi_api.ToMixedPrecision(out_dtype, fp16_input_names)  # type: ignore
+    return _ffi_api.ToMixedPrecision(  # type: ignore
+        out_dtype, fp16_input_names, calibrated_absmax, op_fp16_speedup
+    )
 
 
 def SplitCallTIRByPattern(patterns: List[PrimFunc], fcodegen: Callable) -> tvm.ir.transform.Pass:
@@ -385,3 +385,78 @@ def gen_call_tir_inputs(
         tir_vars = _shape_with_old_tir_var(unbound_tir_vars, tir_var_inverse_map)
 
     return (tir_func, call_tir_args, output_sinfo, tir_vars)
+
+
+def prepack_params(mod: tvm.IRModule, func_name: str, params: Dict[str, Any]) -> List[Any]:
+    """Bind params into a packing function and evaluate it ahead of time.
+
+    Binds the given weights into `func_name` (typically the `transform_params`
+    function produced by :py:class:`tvm.relax.transform.LiftTransformParams`)
+    and constant-folds it, so the layout/packing transforms run once at export
+    time instead of on every process start.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module containing the packing function.
+
+    func_name : str
+        The name of the packing function.
+
+    params : Dict[str, Any]
+        The weights to bind, in canonical layout, keyed by parameter name.
+
+    Returns
+    -------
+    packed_params : List[tvm.nd.NDArray]
+        The packed weights, one per output of the packing function.
+    """
+    return _ffi_api.PrepackParams(mod, func_name, params)  # type: ignore
+
+
+def prepack_params_to_ndarray_cache(
+    mod: tvm.IRModule,
+    func_name: str,
+    params: Dict[str, Any],
+    cache_dir: str,
+    name_prefix: str = "param",
+    meta_data: Optional[Dict[str, Any]] = None,
+) -> None:
+    """Prepack params and dump them to an NDArray cache.
+
+    The packed tensors are stored under ``{name_prefix}_{i}`` in output order,
+    matching ``vm.builtin.param_array_from_cache``, with the packing function
+    recorded in the cache metadata. Tensors are stored raw, so loading the
+    cache is a straight copy (or mmap) to the device with no repacking.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module containing the packing function.
+
+    func_name : str
+        The name of the packing function.
+
+    params : Dict[str, Any]
+        The weights to bind, in canonical layout, keyed by parameter name.
+
+    cache_dir : str
+        The directory to write the NDArray cache to.
+
+    name_prefix : str
+        The prefix used to name the packed tensors in the cache.
+
+    meta_data : Optional[Dict[str, Any]]
+        Extra metadata to store in the cache json file.
+    """
+    from ..contrib import tvmjs  # pylint: disable=import-outside-toplevel
+
+    packed = prepack_params(mod, func_name, params)
+    record = dict(meta_data) if meta_data else {}
+    record["prepacked"] = {"function": func_name, "num_params": len(packed)}
+    tvmjs.dump_ndarray_cache(
+        {f"{name_prefix}_{i}": nd for i, nd in enumerate(packed)},
+        cache_dir,
+        encode_format="raw",
+        meta_data=record,
+    )
@@ -0,0 +1,281 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Cost-model gating for BYOC offload decisions.
+
+BYOC partitioning offloads every subgraph the external codegen supports, but
+small subgraphs can lose to native codegen once per-call engine and transfer
+overheads are paid. The helpers here estimate (or measure) the benefit of each
+partition and un-partition the net losses using
+``InlineCompilerFunctionsBoundTo``.
+"""
+import logging
+
+import numpy as np
+
+import tvm
+from tvm import autotvm, relay
+from tvm.contrib import graph_executor
+
+logger = logging.getLogger("te_compiler")
+
+
+def _tensor_types(ttype):
+    """Flatten a checked type into the list of its TensorTypes."""
+    if isinstance(ttype, tvm.ir.TupleType):
+        result = []
+        for field in ttype.fields:
+            result += _tensor_types(field)
+        return result
+    assert isinstance(ttype, relay.TensorType)
+    return [ttype]
+
+
+def _num_bytes(ttype):
+    """The size of a tensor type in bytes, or None if the shape is dynamic."""
+    nelem = 1
+    for dim in ttype.shape:
+        if not isinstance(dim, tvm.tir.IntImm):
+            return None
+        nelem *= int(dim)
+    return nelem * tvm.runtime.DataType(ttype.dtype).bits // 8
+
+
+class OffloadCostModel:
+    """An analytical model of the fixed cost of calling an offloaded subgraph.
+
+    The model charges a per-call engine overhead plus the time to move every
+    subgraph input and output across the host/device boundary. This is a lower
+    bound on the offloaded time: a partition whose measured native time is
+    below this bound is guaranteed to be a net loss and is inlined back.
+
+    Parameters
+    ----------
+    engine_overhead_us : float
+        The fixed per-call overhead of the external engine, in microseconds.
+
+    transfer_gbytes_per_sec : float
+        The effective bandwidth for moving subgraph inputs and outputs, in
+        GB/s. Set to ``float("inf")`` when the engine shares memory with the
+        native runtime.
+    """
+
+    def __init__(self, engine_overhead_us=100.0, transfer_gbytes_per_sec=8.0):
+        self.engine_overhead_us = engine_overhead_us
+        self.transfer_gbytes_per_sec = transfer_gbytes_per_sec
+
+    def offload_overhead(self, func):
+        """The fixed per-call cost of offloading func, in seconds.
+
+        Returns None when the transfer volume cannot be determined statically.
+        """
+        total_bytes = 0
+        ttypes = [param.checked_type for param in func.params] + [func.ret_type]
+        for ttype in ttypes:
+            for tensor in _tensor_types(ttype):
+                nbytes = _num_bytes(tensor)
+                if nbytes is None:
+                    return None
+                total_bytes += nbytes
+        return self.engine_overhead_us / 1e6 + total_bytes / (
+            self.transfer_gbytes_per_sec * 1e9
+        )
+
+    def estimate_native_time(self, func, target, tuning_records):
+        """Estimate the native time of func from measured tuning records.
+
+        Sums the best measured time of every tunable task extracted from the
+        subgraph. Returns None when some task has no record, in which case no
+        decision can be made from the database.
+
+        Parameters
+        ----------
+        func : relay.Function
+            The partitioned subgraph, with its partition attributes stripped.
+
+        target : tvm.target.Target
+            The native compilation target.
+
+        tuning_records : str
+            Path to the autotvm tuning log holding the measured records.
+        """
+        best_by_workload = {}
+        for inp, res in autotvm.record.load_from_file(tuning_records):
+            if res.error_no != 0 or str(inp.target) != str(target):
+                continue
+            cost = np.mean(res.costs)
+            workload = inp.task.workload
+            if workload not in best_by_workload or cost < best_by_workload[workload]:
+                best_by_workload[workload] = cost
+        tasks = autotvm.task.extract_from_program(func, params=None, target=target)
+        total = 0.0
+        for task in tasks:
+            if task.workload not in best_by_workload:
+                logger.info("offload_benefit: no tuning record for %s", task.workload)
+                return None
+            total += best_by_workload[task.workload]
+        return total
+
+
+def _strip_partition_attrs(func):
+    func = func.with_attr("Compiler", "")
+    return relay.Function(func.params, func.body, func.ret_type, func.type_params)
+
+
+def calibrate_offloads(mod, compiler, target, device, number=10, repeat=3):
+    """Measure both the native and the offloaded path of every partition.
+
+    Each "Compiler" partition for the given compiler is wrapped in a
+    standalone module and built twice - once as partitioned and once with the
+    partition inlined - then timed on random inputs. The results can be passed
+    to :py:func:`prune_uneconomic_offloads` as ``measured_times``.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The partitioned module.
+
+    compiler : str
+        The value of the "Compiler" attribute to calibrate, e.g. "tensorrt".
+
+    target : tvm.target.Target
+        The native compilation target.
+
+    device : tvm.runtime.Device
+        The device to measure on.
+
+    number, repeat : int
+        The time_evaluator measurement configuration.
+
+    Returns
+    -------
+    measured_times : Dict[str, Tuple[float, float]]
+        Maps each partition's global symbol to (native_seconds,
+        offloaded_seconds).
+    """
+
+    def _measure(submod, inputs):
+        with tvm.transform.PassContext(opt_level=3):
+            lib = relay.build(submod, target=target)
+        module = graph_executor.GraphModule(lib["default"](device))
+        for name, value in inputs.items():
+            module.set_input(name, value)
+        timer = module.module.time_evaluator("run", device, number=number, repeat=repeat)
+        return timer().mean
+
+    measured_times = {}
+    for gvar in mod.get_global_vars():
+        func = mod[gvar]
+        if not func.attrs or func.attrs.get("Compiler", None) != compiler:
+            continue
+        params = [relay.var(p.name_hint, p.checked_type) for p in func.params]
+        wrapper = relay.Function(params, relay.Call(gvar, params))
+        submod = tvm.IRModule({"main": wrapper, gvar.name_hint: func})
+        submod = relay.transform.InferType()(submod)
+        inputs = {}
+        for param in params:
+            ttype = param.type_annotation
+            shape = [int(dim) for dim in ttype.shape]
+            inputs[param.name_hint] = np.random.uniform(-1, 1, size=shape).astype(ttype.dtype)
+        native_mod = relay.transform.InlineCompilerFunctionsBoundTo(
+            [submod.get_global_var(gvar.name_hint)]
+        )(submod)
+        native_time = _measure(native_mod, inputs)
+        offload_time = _measure(submod, inputs)
+        measured_times[gvar.name_hint] = (native_time, offload_time)
+        logger.info(
+            "offload_benefit: %s native %.2fus offloaded %.2fus",
+            gvar.name_hint,
+            native_time * 1e6,
+            offload_time * 1e6,
+        )
+    return measured_times
+
+
+def prune_uneconomic_offloads(
+    mod, compiler, target=None, tuning_records=None, cost_model=None, measured_times=None
+):
+    """Un-partition the "Compiler" subgraphs that lose to native codegen.
+
+    The decision uses, in order of preference:
+
+    1. ``measured_times`` from :py:func:`calibrate_offloads`, comparing the
+       two measured paths directly;
+    2. the cost model, inlining partitions whose measured native time from
+       ``tuning_records`` is below the fixed offload overhead.
+
+    Partitions without enough information to decide are left offloaded.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The partitioned module.
+
+    compiler : str
+        The value of the "Compiler" attribute to gate, e.g. "tensorrt".
+
+    target : Optional[tvm.target.Target]
+        The native compilation target; required unless measured_times covers
+        every partition.
+
+    tuning_records : Optional[str]
+        Path to the autotvm tuning log with measured native records.
+
+    cost_model : Optional[OffloadCostModel]
+        The offload overhead model; defaults to ``OffloadCostModel()``.
+
+    measured_times : Optional[Dict[str, Tuple[float, float]]]
+        Per-partition (native_seconds, offloaded_seconds) measurements.
+
+    Returns
+    -------
+    mod : tvm.IRModule
+        The module with net-loss partitions inlined back.
+    """
+    if cost_model is None:
+        cost_model = OffloadCostModel()
+    measured_times = measured_times or {}
+
+    global_vars_to_inline = []
+    for gvar in mod.get_global_vars():
+        func = mod[gvar]
+        if not func.attrs or func.attrs.get("Compiler", None) != compiler:
+            continue
+        if gvar.name_hint in measured_times:
+            native_time, offload_time = measured_times[gvar.name_hint]
+            if native_time <= offload_time:
+                global_vars_to_inline.append(gvar)
+            continue
+        if tuning_records is None or target is None:
+            continue
+        offload_overhead = cost_model.offload_overhead(func)
+        if offload_overhead is None:
+            continue
+        native_time = cost_model.estimate_native_time(
+            _strip_partition_attrs(func), target, tuning_records
+        )
+        if native_time is not None and native_time <= offload_overhead:
+            global_vars_to_inline.append(gvar)
+
+    if not global_vars_to_inline:
+        return mod
+    logger.info(
+        "offload_benefit: inlining %d uneconomic %s partition(s)",
+        len(global_vars_to_inline),
+        compiler,
+    )
+    return relay.transform.InlineCompilerFunctionsBoundTo(global_vars_to_inline)(mod)
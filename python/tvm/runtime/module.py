@@ -290,6 +290,28 @@ class Module(object):
         """Remove all imports of the module."""
         _ffi_api.ModuleClearImports(self)
 
+    def patch_function(self, name, patch):
+        """Atomically rebind one function of a loaded library to a new implementation.
+
+        Requires the runtime to hand out patchable functions: set the environment
+        variable ``TVM_RUNTIME_PATCHABLE_KERNELS=1`` before loading the artifact.
+        Function handles already cached by executors pick up the new implementation
+        on their next call, while calls in flight finish on the implementation they
+        started with. The patch module is kept alive by the binding.
+
+        Parameters
+        ----------
+        name : str
+            The name of the function to rebind.
+
+        patch : Union[str, tvm.runtime.Module]
+            The module providing the new implementation, or a path to a shared
+            library to load it from.
+        """
+        if isinstance(patch, str):
+            patch = load_module(patch)
+        _ffi_api.ModulePatchFunction(self, name, patch)
+
     def save(self, file_name, fmt=""):
         """Save the module to file.
 
@@ -606,8 +628,8 @@ class Module(object):
                 files.append(path_obj)
             else:
                 path_cc = os.path.join(workspace_dir, f"{pack_lib_prefix}devc.c")
-                with open(path_cc, "w") as f:
-                    f.write(_ffi_api.ModulePackImportsToC(self, is_system_lib, pack_lib_prefix))
+                # streams the blob to the file so export memory stays bounded
+                _ffi_api.ModulePackImportsToCFile(self, is_system_lib, path_cc, pack_lib_prefix)
                 files.append(path_cc)
 
         # The imports could contain a c module but the object format could be tar
@@ -292,3 +292,33 @@ if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=T
             for dev, names in metric_names.items():
                 wrapped[DeviceWrapper(dev)] = names
             self.__init_handle_by_constructor__(_ffi_api.PAPIMetricCollector, wrapped)
+
+
+# Only available on Linux; the runtime registers it when built with perf_event support
+if (
+    _ffi.get_global_func("runtime.profiling.PerfEventMetricCollector", allow_missing=True)
+    is not None
+):
+
+    @_ffi.register_object("runtime.profiling.PerfEventMetricCollector")
+    class PerfEventMetricCollector(MetricCollector):
+        """Collects per-thread hardware counters through the Linux perf_event
+        interface, with no external library dependency. Counters are opened on
+        every thread of the process, including ThreadPool workers, and the
+        kernel's multiplex scaling is applied so the collector is safe to use
+        alongside other perf users on shared production hosts.
+        """
+
+        def __init__(self, metric_names: Optional[Sequence[str]] = None):
+            """
+            Parameters
+            ----------
+            metric_names : Optional[Sequence[str]]
+                Events to collect, e.g. ["perf::CACHE-MISSES", "perf::BRANCH-MISSES",
+                "perf::STALLED-CYCLES-BACKEND"]. Defaults to cycles, instructions,
+                cache misses, branch misses and front/backend stall cycles.
+            """
+            metric_names = [] if metric_names is None else list(metric_names)
+            self.__init_handle_by_constructor__(
+                _ffi_api.PerfEventMetricCollector, metric_names
+            )
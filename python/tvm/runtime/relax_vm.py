@@ -41,6 +41,7 @@ class VirtualMachine(object):
 
     NAIVE_ALLOCATOR = 1
     POOLED_ALLOCATOR = 2
+    STREAM_ORDERED_ALLOCATOR = 3
 
     def __init__(
         self,
@@ -62,7 +63,10 @@ class VirtualMachine(object):
 
         memory_cfg : Optional[Union[str, Dict[Device, str]]]
             Config the type of memory allocator. The allocator type can be ["naive",
-            "pooled"]. If memory_cfg is None, all devices will use pooled allocator
+            "pooled", "stream-ordered"]. The stream-ordered allocator enqueues
+            allocations and frees on the current stream on devices that support it
+            (CUDA 11.2+), so concurrent inference streams do not serialize on
+            allocation. If memory_cfg is None, all devices will use pooled allocator
             by default. If memory_cfg is string, all devices will use the specified
             allocator type. If memory_cfg is a dict, each device uses the allocator
             type specified in the dict, or pooled allocator if not specified in the
@@ -115,9 +119,11 @@ class VirtualMachine(object):
         if memory_cfg is None:
             memory_cfg = {}
         elif isinstance(memory_cfg, str):
-            assert memory_cfg in ["naive", "pooled"]
+            assert memory_cfg in ["naive", "pooled", "stream-ordered"]
             if memory_cfg == "naive":
                 default_alloc_type = VirtualMachine.NAIVE_ALLOCATOR
+            elif memory_cfg == "stream-ordered":
+                default_alloc_type = VirtualMachine.STREAM_ORDERED_ALLOCATOR
             memory_cfg = {}
         elif not isinstance(memory_cfg, dict):
             raise TypeError(
@@ -303,6 +309,36 @@ class VirtualMachine(object):
         """
         self._invoke_stateful(func_name)
 
+    def invoke_stateful_async(self, func_name: str, callback=None) -> tvm.runtime.Module:
+        """
+        Like `invoke_stateful`, but returns a waitable handle instead of
+        blocking on device completion.
+
+        The bytecode runs on the calling thread - kernel launches are
+        asynchronous on stream-based devices - and only the completion wait
+        moves to a worker thread, so the caller can keep several requests in
+        flight. Obtain the results with `get_outputs` after the handle
+        reports completion.
+
+        Parameters
+        ----------
+        func_name: str
+            The name of the function to call.
+
+        callback: Optional[Callable[[], None]]
+            Invoked on the completion thread once the run finishes.
+
+        Returns
+        -------
+        handle : tvm.runtime.Module
+            A handle with ``handle["wait"]()`` blocking until completion and
+            ``handle["done"]()`` polling without blocking.
+        """
+        invoke_async = self.module["invoke_stateful_async"]
+        if callback is None:
+            return invoke_async(func_name)
+        return invoke_async(func_name, callback)
+
     def get_outputs(self, func_name: str) -> Union[tvm.Object, Tuple[Any]]:
         """
         Get the value output by the function by the given name
@@ -507,6 +543,36 @@ class VirtualMachine(object):
         report_json = self.module["profile"](func_name, *cargs)
         return Report.from_json(report_json)
 
+    def profile_collapsed(self, func_name: str, *args) -> str:
+        """Profile a function call and attribute device time hierarchically.
+
+        Unlike :py:meth:`profile`, which reports flat per-call timings, each
+        device call is attributed to the stack of VM functions it was invoked
+        from, so the result shows which frontend-level function owns the time.
+
+        Parameters
+        ----------
+        func_name : str
+            The name of the function.
+
+        args: List of NDArray or other objects supported by PackedFunc.
+            The arguments to the function.
+
+        Returns
+        -------
+        stacks: str
+            The profile in the flame-graph collapsed-stack format: one
+            "frame;frame;leaf value" line per distinct stack, with device time
+            in microseconds as the value. The text can be fed directly to
+            flamegraph.pl or speedscope.
+        """
+        cargs: List[Any] = []
+
+        for arg in args:
+            self._convert(arg, cargs)
+
+        return self.module["profile_collapsed"](func_name, *cargs)
+
 
 @register_func("vm.builtin.debug_print")
 def _print(lineo: str, array) -> None:
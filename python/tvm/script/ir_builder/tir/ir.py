@@ -1933,6 +1933,8 @@ vectorhigh = _dtype_forward(_tir_op.vectorhigh)
 vectorcombine = _dtype_forward(_tir_op.vectorcombine)
 get_active_lane_mask = _dtype_forward(_tir_op.get_active_lane_mask)
 dp4a = _dtype_forward(_tir_op.dp4a)
+subbyte_pack = _dtype_forward(_tir_op.subbyte_pack)
+subbyte_unpack = _dtype_forward(_tir_op.subbyte_unpack)
 
 
 broadcast = Broadcast
@@ -2193,6 +2195,8 @@ __all__ = [
     "vectorhigh",
     "vectorcombine",
     "dp4a",
+    "subbyte_pack",
+    "subbyte_unpack",
     "assume",
     "undef",
     "tvm_call_packed",
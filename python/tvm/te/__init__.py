@@ -42,6 +42,7 @@ from .operation import placeholder, compute, scan, extern, var, size_var, const
 from .operation import thread_axis, reduce_axis
 from .operation import create_prim_func
 from .operation import extern_primfunc
+from .ragged import RaggedDim, ragged_dim, ragged_reduce, position_segments
 
 from .tensor import PlaceholderOp, ComputeOp, TensorComputeOp, ScanOp, ExternOp, HybridOp
 from .autodiff import gradient
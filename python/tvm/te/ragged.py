@@ -0,0 +1,206 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Ragged iteration helpers for the Tensor Expression language.
+
+A ragged dimension is described CSR-style by an ``indptr`` array: segment
+``i`` owns positions ``indptr[i] .. indptr[i + 1]``. These helpers lower
+ragged iteration onto dense rectangular domains so the resulting stages are
+ordinary :py:func:`tvm.te.compute` stages — ``split``, ``parallel``,
+``vectorize`` and autotuning apply to them unchanged:
+
+- :py:func:`ragged_reduce` iterates each segment over a rectangular
+  ``[0, max_extent)`` axis and masks the tail with the reducer's ``where``
+  predicate. This keeps the per-segment reduction local, at the cost of
+  wasted lanes when extents vary widely.
+- :py:func:`position_segments` materializes the position-to-segment table,
+  so bandwidth-bound kernels can instead iterate the flat ``[0, nnz)``
+  position space, which is perfectly load balanced under ``split`` and
+  ``parallel`` regardless of the segment length distribution.
+"""
+import tvm
+from tvm import tir
+
+from .operation import compute, extern, reduce_axis
+
+
+class RaggedDim(object):
+    """A ragged dimension described by a CSR-style indptr array.
+
+    Parameters
+    ----------
+    indptr : tvm.te.Tensor
+        1-D monotone array with shape [num_segments + 1]. Segment i owns
+        positions indptr[i] to indptr[i + 1].
+
+    max_extent : Union[int, PrimExpr]
+        Static upper bound on the extent of any segment. Used as the
+        rectangular extent that guarded lowerings iterate over.
+
+    name : str
+        The name hint of the dimension.
+    """
+
+    def __init__(self, indptr, max_extent, name="ragged"):
+        self.indptr = indptr
+        self.max_extent = max_extent
+        self.num_segments = indptr.shape[0] - 1
+        self.name = name
+
+    def extent(self, segment):
+        """The extent of the given segment."""
+        return self.indptr[segment + 1] - self.indptr[segment]
+
+    def position(self, segment, offset):
+        """The flat position of the given offset within the given segment."""
+        return self.indptr[segment] + offset
+
+
+def ragged_reduce(dim, inner_shape, fcompute, reducer=None, name="ragged_reduce", tag=""):
+    """Reduce over a ragged dimension into one value per segment.
+
+    The ragged axis is lowered to a rectangular reduce axis of extent
+    ``dim.max_extent`` whose tail is masked with the reducer's ``where``
+    predicate, so the stage schedules like any dense reduction.
+
+    Parameters
+    ----------
+    dim : RaggedDim
+        The ragged dimension to reduce over.
+
+    inner_shape : Tuple[Union[int, PrimExpr]]
+        The shape of the non-ragged trailing output dimensions.
+
+    fcompute : Callable
+        fcompute(segment, offset, position, *inner_indices) returning the
+        value to reduce. ``position`` is the flat index into the position
+        space, ``offset`` the index within the segment.
+
+    reducer : Optional[Callable]
+        The commutative reducer to apply, tvm.te.sum by default. Must
+        support the ``where`` argument of :py:func:`tvm.tir.comm_reducer`.
+
+    name : str
+        The name hint of the output tensor.
+
+    tag : str
+        The tag of the output tensor.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        Tensor with shape [num_segments, *inner_shape].
+
+    Example
+    -------
+    An embedding bag summing rows of a weight table:
+
+    .. code-block:: python
+
+        bag = te.ragged_dim(indptr, max_bag_size)
+        out = te.ragged_reduce(
+            bag, (embed_dim,), lambda i, j, p, d: weight[indices[p], d]
+        )
+    """
+    if reducer is None:
+        reducer = tir.sum
+
+    def _compute(segment, *inner):
+        k = reduce_axis((0, dim.max_extent), name=f"{dim.name}_k")
+        body = fcompute(segment, k, dim.position(segment, k), *inner)
+        return reducer(body, axis=k, where=k < dim.extent(segment))
+
+    return compute((dim.num_segments, *tuple(inner_shape)), _compute, name=name, tag=tag)
+
+
+def position_segments(dim, nnz, out_dtype="int32", name="position_segments"):
+    """Materialize the position-to-segment table of a ragged dimension.
+
+    For each flat position p in [0, nnz) the table holds the segment that
+    owns p, found by binary search over indptr. Kernels that iterate the
+    position space instead of the segment space do identical work per
+    iteration, so splitting and parallelizing the position loop balances
+    load even when segment extents are highly skewed.
+
+    Parameters
+    ----------
+    dim : RaggedDim
+        The ragged dimension.
+
+    nnz : Union[int, PrimExpr]
+        The total number of positions, indptr[num_segments].
+
+    out_dtype : str
+        The dtype of the table.
+
+    name : str
+        The name hint of the output tensor.
+
+    Returns
+    -------
+    segments : tvm.te.Tensor
+        1-D tensor with shape [nnz] holding the owning segment per position.
+    """
+
+    def _table_ir(indptr, out):
+        irb = tvm.tir.ir_builder.create()
+        indptr_ptr = irb.buffer_ptr(indptr)
+        out_ptr = irb.buffer_ptr(out)
+        num_segments = indptr.shape[0] - 1
+        with irb.for_range(0, nnz, kind="parallel", name="pos") as pos:
+            lo = irb.allocate(out_dtype, (1,), name="lo", scope="local")
+            hi = irb.allocate(out_dtype, (1,), name="hi", scope="local")
+            lo[0] = tir.const(0, out_dtype)
+            hi[0] = tir.Cast(out_dtype, num_segments)
+            # Invariant: indptr[lo] <= pos < indptr[hi].
+            with irb.while_loop(lo[0] + 1 < hi[0]):
+                mid = (lo[0] + hi[0]) // 2
+                with irb.if_scope(pos < indptr_ptr[mid]):
+                    hi[0] = mid
+                with irb.else_scope():
+                    lo[0] = mid
+            out_ptr[pos] = lo[0]
+        return irb.get()
+
+    return extern(
+        (nnz,),
+        [dim.indptr],
+        lambda ins, outs: _table_ir(ins[0], outs[0]),
+        dtype=out_dtype,
+        name=name,
+    )
+
+
+def ragged_dim(indptr, max_extent, name="ragged"):
+    """Create a ragged dimension from a CSR-style indptr array.
+
+    Parameters
+    ----------
+    indptr : tvm.te.Tensor
+        1-D monotone array with shape [num_segments + 1].
+
+    max_extent : Union[int, PrimExpr]
+        Static upper bound on the extent of any segment.
+
+    name : str
+        The name hint of the dimension.
+
+    Returns
+    -------
+    dim : RaggedDim
+        The ragged dimension.
+    """
+    return RaggedDim(indptr, max_extent, name)
@@ -262,6 +262,46 @@ def estimate_tir_flops(stmt_or_mod: Union[Stmt, IRModule]) -> float:
     return _ffi_api.EstimateTIRFlops(stmt_or_mod)  # type: ignore # pylint: disable=no-member
 
 
+def memory_access_report(
+    func: PrimFunc, l1_bytes: int = 32 * 1024, l2_bytes: int = 1024 * 1024
+) -> str:
+    """Report per-loop buffer access strides, working-set bounds and
+    predicted cache behavior of a PrimFunc.
+
+    The report lists, for every loop, the element stride of each buffer
+    access with respect to the loop variable and an upper bound on the
+    working set the loop body touches, compared against the given cache
+    capacities. Page-crossing strides are flagged as TLB-hostile. To dump
+    reports while a pass pipeline runs, wrap this in a pass instrument::
+
+        @tvm.instrument.pass_instrument
+        class DumpAccessPatterns:
+            def run_after_pass(self, mod, info):
+                for func in mod.functions.values():
+                    if isinstance(func, tvm.tir.PrimFunc):
+                        print(tvm.tir.analysis.memory_access_report(func))
+
+    Parameters
+    ----------
+    func: tvm.tir.PrimFunc
+        The function to analyze.
+
+    l1_bytes: int
+        The L1 data cache capacity to compare working sets against.
+
+    l2_bytes: int
+        The L2 cache capacity to compare working sets against.
+
+    Returns
+    -------
+    report: str
+        A human-readable per-loop report.
+    """
+    return _ffi_api.AnalyzeMemoryAccessPatterns(  # type: ignore # pylint: disable=no-member
+        func, l1_bytes, l2_bytes
+    )
+
+
 # NOTE: relay_func_type in the following two functions should be relay.FuncType however that would
 # introduce a cycling dependency. We make do with Object.
 
@@ -1832,6 +1832,50 @@ def dp4a(vec1, vec2, acc=0):
     return call_intrin("int32", "tir.dp4a", vec1, vec2, acc)
 
 
+def subbyte_pack(dtype, vec):
+    """Pack a sub-byte integer vector into its bit-packed storage integer
+
+    The vector's total bit width (bits * lanes) must equal that of dtype,
+    e.g. an int4x8 vector packs into an int32.
+
+    Parameters
+    ----------
+    dtype : str
+       The storage integer type, e.g. "int32".
+
+    vec : PrimExpr
+       The sub-byte vector to pack.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.subbyte_pack", vec)
+
+
+def subbyte_unpack(dtype, value):
+    """Unpack a bit-packed storage integer into a sub-byte integer vector
+
+    The inverse of subbyte_pack: the value's total bit width must equal that
+    of the vector dtype, e.g. an int32 unpacks into an int4x8 vector.
+
+    Parameters
+    ----------
+    dtype : str
+       The sub-byte vector type, e.g. "int4x8".
+
+    value : PrimExpr
+       The storage integer to unpack.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.subbyte_unpack", value)
+
+
 def ret(val, span=None):
     """Create a tir return expression
 
@@ -367,7 +367,7 @@ def get_mfma_intrin(k_dim, in_dtype="float32", out_dtype="float32", b_transposed
                 T.llvm_lookup_intrinsic_id(mfma_intrin),
                 T.uint32(6),
                 T.call_intrin("int32", "tir.reinterpret", A[tx, 0:local_size]),
-                T.call_intrin("int32", "tir.reinterpret", A[tx, 0:local_size]),
+                T.call_intrin("int32", "tir.reinterpret", B[tx, 0:local_size]),
                 C[tx, 0:local_size_out],
                 T.int32(0),
                 T.int32(0),
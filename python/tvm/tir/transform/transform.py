@@ -93,6 +93,22 @@ def StorageFlatten(cache_line_size, create_bound_attribute: bool = False):
     return _ffi_api.StorageFlatten(cache_line_size, create_bound_attribute)  # type: ignore
 
 
+def AutoTexturePlacement():
+    """Place eligible intermediate buffers in texture memory automatically.
+
+    Scores the access pattern of every realized intermediate buffer and
+    rewrites the profitable ones to the "global.texture" storage scope, so
+    that TextureFlatten lowers them to image2d without manual schedule
+    annotations.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AutoTexturePlacement()  # type: ignore
+
+
 def TextureFlatten():
     """Flatten the multi-dimensional read/write to 2D.
 
@@ -989,6 +1005,17 @@ def InjectPermutedLayout():
     return _ffi_api.InjectPermutedLayout()  # type: ignore
 
 
+def InjectLDSSwizzle():
+    """Inject a swizzled layout for AMD LDS buffers to avoid bank conflicts
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectLDSSwizzle()  # type: ignore
+
+
 def UnifyThreadBinding():
     """Unify all the thread bindings for "blockIdx.x/y/z",
     "threadIdx.x/y/z", and "vthread.x/y/z". Before the unification,
@@ -16,4 +16,4 @@
 # under the License.
 """Utilities operating at a graph/model or other "high" level"""
 
-from .roofline import roofline_analysis
+from .roofline import optimization_priority_report, roofline_analysis
@@ -21,11 +21,13 @@ import numpy as np
 
 from ... import IRModule, auto_scheduler, build, get_global_func, nd, relay, tir, topi, transform
 from ...contrib import utils
+from ...contrib.debugger import debug_executor
+from ...error import TVMError
 from ...ir.expr import GlobalVar
 from ...ir.instrument import pass_instrument
 from ...rpc.base import RPC_SESS_MASK
 from ...rpc.client import RPCSession
-from ...runtime import Device, num_threads, profiler_vm, profiling
+from ...runtime import DataType, Device, num_threads, profiler_vm, profiling
 from ...script import tir as T
 from ...target import Target
 from . import cuda, registry, x86
@@ -77,6 +79,57 @@ class SaveLoweredTIR:
                     self.functions[v] = func
 
 
+def _estimate_features_from_tir(prim: tir.PrimFunc) -> Optional[Dict[str, np.ndarray]]:
+    """Approximate featurization results for functions auto_scheduler cannot handle.
+
+    :py:func:`auto_scheduler.feature.named_features_from_primfunc` returns None
+    for some lowered functions, for example those containing opaque blocks. For
+    those we fall back to counting operations with
+    :py:func:`tir.analysis.estimate_tir_flops` and bytes touched with the sizes
+    of the buffers in the buffer map, and present the results under the feature
+    names that the peak flops/bandwidth estimators consume.
+
+    Parameters
+    ----------
+    prim : tir.PrimFunc
+        Function that could not be featurized.
+
+    Returns
+    -------
+    features : Optional[Dict[str, np.ndarray]]
+        Approximated features, or None if `prim` contains constructs that the
+        fallback cannot count either (unsupported ops, dynamic buffer shapes).
+    """
+    try:
+        flops = tir.analysis.estimate_tir_flops(IRModule({"main": prim}))
+    except TVMError:
+        return None
+    loaded_bytes = 0
+    for buffer in prim.buffer_map.values():
+        num_elements = 1
+        for dim in buffer.shape:
+            if not isinstance(dim, tir.IntImm):
+                return None
+            num_elements *= dim.value
+        loaded_bytes += num_elements * ((DataType(buffer.dtype).bits + 7) // 8)
+    ops = np.array([flops])
+    zero = np.zeros(1)
+    # estimate_tir_flops does not separate integer from floating point
+    # operations, so report the total under both; the estimators read only the
+    # family matching the function's dtype.
+    return {
+        "float_addsub": ops,
+        "float_mul": zero,
+        "float_mad": zero,
+        "float_divmod": zero,
+        "int_addsub": ops,
+        "int_mul": zero,
+        "int_mad": zero,
+        "int_divmod": zero,
+        "B0.bytes": np.array([float(loaded_bytes)]),
+    }
+
+
 def roofline_from_existing(
     report: profiling.Report,
     tir_functions: Dict[GlobalVar, tir.PrimFunc],
@@ -157,6 +210,9 @@ def roofline_from_existing(
         if "Hash" in call.keys() and call["Hash"] in all_features:
             _, prim, features = all_features[call["Hash"]]
             if features is None:
+                features = _estimate_features_from_tir(prim)
+            if features is None:
+                new_calls.append(call)
                 continue
 
             with target:
@@ -194,12 +250,64 @@ def roofline_from_existing(
     return profiling.Report(new_calls, report.device_metrics, new_configuration)
 
 
+def optimization_priority_report(
+    report: profiling.Report, efficiency_threshold: float = 50.0
+) -> profiling.Report:
+    """Reorder a roofline-annotated report into an optimization priority list.
+
+    Each call that carries roofline metrics (see
+    :py:func:`roofline_from_existing`) is annotated with the amount of time
+    that could be recovered by lifting it to its roofline bound and a flag
+    marking whether it falls below `efficiency_threshold`. Calls are then
+    sorted by descending recoverable time, so the first rows of the report are
+    the operators where optimization effort pays off the most. Calls without
+    roofline metrics are kept at the end of the report in their original
+    order.
+
+    Use ``report.table(sort=False, aggregate=False)`` to print the result, as
+    the default table formatting re-sorts calls by duration.
+
+    Parameters
+    ----------
+    report : profiling.Report
+        Report annotated by :py:func:`roofline_from_existing` or
+        :py:func:`roofline_analysis`.
+    efficiency_threshold : float
+        Percent of theoretical optimal below which a call is flagged as a
+        candidate for optimization.
+
+    Returns
+    -------
+    profiling.Report
+        New report with the calls annotated and reordered as described above.
+    """
+    prioritized = []
+    unannotated = []
+    for call in report.calls:
+        if "Percent of Theoretical Optimal" not in call.keys():
+            unannotated.append(call)
+            continue
+        percent = call["Percent of Theoretical Optimal"].ratio
+        duration = call["Duration (us)"].microseconds
+        call = dict(call)
+        # Time that a perfectly optimized implementation of this call would
+        # recover, assuming it reaches its roofline bound.
+        recoverable = duration * max(0.0, 1.0 - percent / 100.0)
+        call["Estimated Recoverable Time (us)"] = profiling.Duration(recoverable)
+        call["Below Threshold"] = "yes" if percent < efficiency_threshold else "no"
+        prioritized.append((recoverable, call))
+    prioritized.sort(key=lambda x: x[0], reverse=True)
+    new_calls = [call for _, call in prioritized] + unannotated
+    return profiling.Report(new_calls, report.device_metrics, report.configuration)
+
+
 def roofline_analysis(
     mod: IRModule,
     params: Dict[str, nd.NDArray],
     target: Union[str, Target],
     dev: Device,
     remote: Optional[RPCSession] = None,
+    executor: str = "vm",
 ) -> profiling.Report:
     """
     Create a profiling report that contains roofline and other estimated
@@ -242,6 +350,10 @@ def roofline_analysis(
       Remote session used to upload artifacts for runtime evaluation. Must be
       the same session used to create `dev`.
 
+    executor : str
+      Which executor to profile with: "vm" for the VM profiler or "graph" for
+      the debug graph executor.
+
     Returns
     -------
 
@@ -250,6 +362,8 @@ def roofline_analysis(
     """
     if isinstance(target, str):
         target = Target(target)
+    if executor not in ("vm", "graph"):
+        raise ValueError(f"Unknown executor {executor}, expected 'vm' or 'graph'")
 
     save_tir = SaveLoweredTIR()
     # copy existing context but add our instrument
@@ -261,19 +375,42 @@ def roofline_analysis(
         instruments=list(pass_ctx.instruments) + [save_tir],
         config=pass_ctx.config,
     ):
-        lib = relay.vm.compile(mod, params=params, target=target)
-    # upload to remote if running over rpc
-    if dev.device_type >= RPC_SESS_MASK:
-        if remote is None:
-            raise RuntimeError("A RPCSession must be provided when using a remote device.")
-        temp = utils.tempdir()
-        path = temp.relpath("roofline_lib.tar")
-        lib.mod.export_library(path)
-        remote.upload(path)
-        lib = remote.load_module("roofline_lib.tar")
-    vmexec = profiler_vm.VirtualMachineProfiler(lib, dev)
+        if executor == "vm":
+            lib = relay.vm.compile(mod, params=params, target=target)
+        else:
+            lib = relay.build(mod, params=params, target=target)
 
     args = _create_args(mod, dev, remote=remote)
-    report = vmexec.profile(*args)
+    if executor == "vm":
+        # upload to remote if running over rpc
+        if dev.device_type >= RPC_SESS_MASK:
+            if remote is None:
+                raise RuntimeError("A RPCSession must be provided when using a remote device.")
+            temp = utils.tempdir()
+            path = temp.relpath("roofline_lib.tar")
+            lib.mod.export_library(path)
+            remote.upload(path)
+            lib = remote.load_module("roofline_lib.tar")
+        vmexec = profiler_vm.VirtualMachineProfiler(lib, dev)
+        report = vmexec.profile(*args)
+    else:
+        graph_json = lib.get_graph_json()
+        if dev.device_type >= RPC_SESS_MASK:
+            if remote is None:
+                raise RuntimeError("A RPCSession must be provided when using a remote device.")
+            temp = utils.tempdir()
+            path = temp.relpath("roofline_lib.tar")
+            lib.export_library(path)
+            remote.upload(path)
+            libmod = remote.load_module("roofline_lib.tar")
+        else:
+            libmod = lib.module
+        gmod = debug_executor.create(graph_json, libmod, dev)
+        # Parameters bound at compile time are not graph inputs, so only feed
+        # the arguments the graph still expects.
+        for param, arg in zip(mod["main"].params, args):
+            if gmod.get_input_index(param.name_hint) >= 0:
+                gmod.set_input(param.name_hint, arg)
+        report = gmod.profile()
 
     return roofline_from_existing(report, save_tir.functions, target, dev, remote=remote)
@@ -22,9 +22,14 @@
  * \brief Canonical form based simplification.
  */
 #include <tvm/arith/analyzer.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/op.h>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "const_fold.h"
 #include "pattern_match.h"
 #include "product_normal_form.h"
@@ -685,10 +690,39 @@ class CanonicalSimplifier::Impl : public RewriteSimplifier::Impl {
     }
     ObjectPtr<SplitExprNode> n = make_object<SplitExprNode>();
     n->dtype = expr.dtype();
-    n->index = std::move(expr);
+    n->index = InternIndex(std::move(expr));
     n->div_mode = kTruncDiv;
     return SplitExpr(n);
   }
+  /*!
+   * \brief Return the interned representative of an index used in split normal forms.
+   *
+   * The same index expression is rebuilt over and over when simplifying families of
+   * related indices (e.g. flattening every access of a buffer), and every SumExpr merge
+   * compares split indices with ExprDeepEqual. Interning the indices within the lifetime
+   * of the analyzer makes the `same_as` fast path of `SplitExprNode::IndexEqual` hit for
+   * structurally identical indices, so those comparisons become pointer equality.
+   *
+   * \param index The index expression.
+   * \return An expression structurally equal to `index`, shared by all splits of it.
+   */
+  PrimExpr InternIndex(PrimExpr index) {
+    // Variables are atoms: deep equality already is pointer equality for them.
+    if (index.as<tir::VarNode>()) return index;
+    // Bound the memory retained over the lifetime of the analyzer; starting over only
+    // costs some missed sharing.
+    if (num_interned_indices_ >= kMaxInternedIndices) {
+      interned_indices_.clear();
+      num_interned_indices_ = 0;
+    }
+    std::vector<PrimExpr>& bucket = interned_indices_[StructuralHash()(index)];
+    for (const PrimExpr& candidate : bucket) {
+      if (tir::ExprDeepEqual()(candidate, index)) return candidate;
+    }
+    bucket.push_back(index);
+    ++num_interned_indices_;
+    return index;
+  }
   /*!
    * \brief Convert expr to an equivalent SplitExpr
    *        that has the specified div_mode.
@@ -732,6 +766,13 @@ class CanonicalSimplifier::Impl : public RewriteSimplifier::Impl {
   }
   // Simplify the combiner used in reduce.
   PrimExpr SimplifyReduceCombiner(const ReduceNode* op);
+
+  /*! \brief The maximum number of index expressions interned at a time. */
+  static constexpr size_t kMaxInternedIndices = 1 << 16;
+  /*! \brief The interned split indices, bucketed by structural hash. */
+  std::unordered_map<size_t, std::vector<PrimExpr>> interned_indices_;
+  /*! \brief The total number of entries in `interned_indices_`. */
+  size_t num_interned_indices_{0};
 };
 
 PrimExpr CanonicalSimplifier::Impl::VisitExpr_(const AddNode* op) {
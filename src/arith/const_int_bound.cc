@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <unordered_map>
 
 #include "constraint_extract.h"
 #include "int_operator.h"
@@ -130,15 +131,19 @@ class ConstIntBoundAnalyzer::Impl
       }
     }
     var_map_[var] = info;
+    memo_.clear();
   }
 
   Entry VisitExpr_(const LetNode* op) final {
     auto it = var_map_.find(op->var);
     // if the var has not been binded, update the info.
     if (it == var_map_.end()) {
-      var_map_[op->var] = this->VisitExpr(op->value);
+      Entry value = this->VisitExpr(op->value);
+      var_map_[op->var] = value;
+      memo_.clear();
       Entry ret = VisitExpr(op->body);
       var_map_.erase(op->var);
+      memo_.clear();
       return ret;
     } else {
       return VisitExpr(op->body);
@@ -155,6 +160,14 @@ class ConstIntBoundAnalyzer::Impl
   }
 
   Entry VisitExpr(const PrimExpr& expr) final {
+    // The memo table is bypassed when the caller asked for the full bound map,
+    // so that every sub-expression is still recorded into it.
+    if (bound_ == nullptr) {
+      auto it = memo_.find(expr);
+      if (it != memo_.end()) {
+        return it->second;
+      }
+    }
     Entry res = ExprFunctor::VisitExpr(expr);
     tir::ExprDeepEqual equal;
     // a linear search over additional info
@@ -176,6 +189,12 @@ class ConstIntBoundAnalyzer::Impl
       }
       (*bound_)[expr] = ConstIntBound(res.min_value, res.max_value);
     }
+    if (bound_ == nullptr) {
+      if (memo_.size() >= kMaxMemoSize) {
+        memo_.clear();
+      }
+      memo_[expr] = res;
+    }
     return res;
   }
 
@@ -441,10 +460,12 @@ class ConstIntBoundAnalyzer::Impl
     if (info.size() == 0) return nullptr;
     size_t old_size = additional_info_.size();
     additional_info_.insert(additional_info_.end(), info.begin(), info.end());
+    memo_.clear();
     size_t new_size = old_size + info.size();
     auto frecover = [old_size, new_size, this]() {
       ICHECK_EQ(additional_info_.size(), new_size);
       additional_info_.resize(old_size);
+      memo_.clear();
     };
     return frecover;
   }
@@ -457,6 +478,14 @@ class ConstIntBoundAnalyzer::Impl
   std::vector<BoundInfo> additional_info_;
   // look up table for memorization
   BoundMapType* bound_{nullptr};
+  // memoization of sub-expression results, keyed on object identity.
+  // Cached entries depend on the bindings and constraints that were active
+  // when they were computed, so the table is cleared whenever var_map_ or
+  // additional_info_ changes.
+  std::unordered_map<PrimExpr, Entry, ObjectPtrHash, ObjectPtrEqual> memo_;
+  // bound on the memo table so long-lived analyzers do not grow it
+  // without limit.
+  static constexpr size_t kMaxMemoSize = 8192;
   // constants: the limit value means umlimited
   // NOTE: kNegInf/kPosInf are used to represent infinity.
   static const constexpr int64_t kNegInf = ConstIntBound::kNegInf;
@@ -42,13 +42,20 @@ void IRMutatorWithAnalyzer::MarkBufferMapShapes(const tir::PrimFunc& func) {
 
 Array<PrimExpr> IRMutatorWithAnalyzer::IterMapSimplifyWithContext(const Array<PrimExpr>& indices,
                                                                   bool non_trivial_only) {
-  PrimExpr pred = const_true();
-  for (PrimExpr val : iter_predicates_) {
-    pred = pred && val;
+  // The iterator context only changes when the visitor enters or leaves a scope,
+  // while this function is called once per buffer access, so reuse the parsed
+  // context across the accesses that share it.
+  if (iter_map_simplifier_ == nullptr || iter_map_simplifier_version_ != iter_context_version_) {
+    PrimExpr pred = const_true();
+    for (PrimExpr val : iter_predicates_) {
+      pred = pred && val;
+    }
+    iter_map_simplifier_ = std::make_unique<IterMapSimplifier>(
+        this->iter_vars_, pred, arith::IterMapLevel::Surjective, this->analyzer_);
+    iter_map_simplifier_version_ = iter_context_version_;
   }
   int n = indices.size();
-  Array<PrimExpr> simplified = arith::IterMapSimplify(
-      indices, this->iter_vars_, pred, arith::IterMapLevel::Surjective, this->analyzer_);
+  Array<PrimExpr> simplified = iter_map_simplifier_->Simplify(indices);
   if (non_trivial_only) {
     for (int i = 0; i < n; ++i) {
       if (simplified[i]->IsInstance<IntImmNode>() && indices[i]->IsInstance<VarNode>()) {
@@ -64,6 +71,7 @@ Stmt IRMutatorWithAnalyzer::VisitStmt_(const ForNode* op) {
   Range dom = Range::FromMinExtent(op->min, op->extent);
   analyzer_->Bind(op->loop_var, dom);
   iter_vars_.Set(op->loop_var, dom);
+  ++iter_context_version_;
   return StmtExprMutator::VisitStmt_(op);
 }
 
@@ -72,6 +80,9 @@ Stmt IRMutatorWithAnalyzer::VisitStmt_(const BlockNode* op) {
     analyzer_->Bind(iter_var->var, iter_var->dom);
     iter_vars_.Set(iter_var->var, iter_var->dom);
   }
+  if (!op->iter_vars.empty()) {
+    ++iter_context_version_;
+  }
   return StmtExprMutator::VisitStmt_(op);
 }
 
@@ -138,6 +149,7 @@ Stmt IRMutatorWithAnalyzer::VisitStmt_(const AttrStmtNode* op) {
     Range dom = Range::FromMinExtent(make_zero(op->value.dtype()), op->value);
     analyzer_->Bind(iv->var, dom);
     iter_vars_.Set(iv->var, dom);
+    ++iter_context_version_;
     Stmt stmt = StmtExprMutator::VisitStmt_(op);
     return stmt;
   } else {
@@ -25,9 +25,11 @@
 #define TVM_ARITH_IR_MUTATOR_WITH_ANALYZER_H_
 
 #include <tvm/arith/analyzer.h>
+#include <tvm/arith/iter_affine_map.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <memory>
 #include <utility>
 
 namespace tvm {
@@ -99,12 +101,25 @@ class IRMutatorWithAnalyzer : public tir::StmtExprMutator {
     // simple heuristics for detecting predicate
     if (tir::UsesVar(condition, f_use_itervar)) {
       iter_predicates_.push_back(condition);
+      ++iter_context_version_;
       callback();
       iter_predicates_.pop_back();
+      ++iter_context_version_;
     } else {
       callback();
     }
   }
+
+ private:
+  // Version number of the recorded iterator context. It is bumped every time
+  // iter_vars_ or iter_predicates_ changes; note that both containers may be
+  // updated in place when uniquely referenced, so an identity check on them is
+  // not a valid staleness test for the cached simplifier below.
+  size_t iter_context_version_{0};
+  // Lazily built simplifier reused across IterMapSimplifyWithContext calls that
+  // share the same iterator context, together with the version it was built for.
+  std::unique_ptr<IterMapSimplifier> iter_map_simplifier_;
+  size_t iter_map_simplifier_version_{0};
 };
 }  // namespace arith
 }  // namespace tvm
@@ -28,6 +28,7 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <memory>
 #include <utility>
 
 #include "../support/utils.h"
@@ -1428,36 +1429,31 @@ bool IterRangeSanityCheck(const Map<Var, Range>& iter_ranges) {
   return true;
 }
 
-IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-                            const PrimExpr& predicate, IterMapLevel check_level,
-                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+/*!
+ * \brief Run iter map detection on indices whose iterator context is already parsed.
+ *
+ *  This is the shared backend of DetectIterMap and IterMapSimplifier: the caller is
+ *  responsible for the iterator range sanity check and for parsing the predicate into
+ *  constraints sorted by expression size.
+ *
+ * \param indices The indices to detect pattern for.
+ * \param constrained_input_iters The input iterators with single-iterator bounds applied.
+ * \param constraints The remaining predicate constraints, sorted by expression size.
+ * \param check_level The iter mapping checking level.
+ * \param analyzer Analyzer used to get context information.
+ * \param simplify_trivial_iterators If true, iterators with unit extents are simplified.
+ * \return The detected iteration result.
+ */
+IterMapResult DetectIterMapPreparsed(const Array<PrimExpr>& indices,
+                                     const Map<Var, Range>& constrained_input_iters,
+                                     const std::vector<IterConstraint>& constraints,
+                                     IterMapLevel check_level, arith::Analyzer* analyzer,
+                                     bool simplify_trivial_iterators) {
   IterMapResult result;
 
   // Overall detection algorithm is divided into two steps:
   // - Step0: IterMapRewriter rewrites the expression to use IterMapExpr patterns.
   // - Step1: IterIndependenceChecker checks if the iterator are independent.
-  if (!IterRangeSanityCheck(input_iters)) {
-    result->errors.push_back("Invalid iterators.  Iterators may not be expressions of each other.");
-    return result;
-  }
-  Map<Var, Range> constrained_input_iters = input_iters;
-  std::vector<IterConstraint> constraints;
-  if (!is_one(predicate) &&
-      !MatchBoundConstraints(predicate, &constrained_input_iters, &constraints)) {
-    result->errors.push_back("Could not parse predicate as constraints on the input iterators.");
-    return result;
-  }
-  // We have to make sure when we visit an iterator, all the constraints related with its successors
-  // in the iter var graph has been visited, where the expression of this iterator will contain the
-  // expression of its successor, so we sort them by their sizes.
-  for (IterConstraint& constraint : constraints) {
-    constraint.expr_size = CalculateExprComplexity(constraint.iter);
-  }
-
-  std::sort(
-      constraints.begin(), constraints.end(),
-      [](const IterConstraint& a, const IterConstraint& b) { return a.expr_size < b.expr_size; });
-
   IterMapRewriter rewriter(analyzer, constrained_input_iters, check_level,
                            simplify_trivial_iterators, &result->errors);
   // Step0.0: rewrite constraints in the order from size-small ones to size-big ones
@@ -1513,6 +1509,37 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
   return result;
 }
 
+IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                            const PrimExpr& predicate, IterMapLevel check_level,
+                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+  if (!IterRangeSanityCheck(input_iters)) {
+    IterMapResult result;
+    result->errors.push_back("Invalid iterators.  Iterators may not be expressions of each other.");
+    return result;
+  }
+  Map<Var, Range> constrained_input_iters = input_iters;
+  std::vector<IterConstraint> constraints;
+  if (!is_one(predicate) &&
+      !MatchBoundConstraints(predicate, &constrained_input_iters, &constraints)) {
+    IterMapResult result;
+    result->errors.push_back("Could not parse predicate as constraints on the input iterators.");
+    return result;
+  }
+  // We have to make sure when we visit an iterator, all the constraints related with its successors
+  // in the iter var graph has been visited, where the expression of this iterator will contain the
+  // expression of its successor, so we sort them by their sizes.
+  for (IterConstraint& constraint : constraints) {
+    constraint.expr_size = CalculateExprComplexity(constraint.iter);
+  }
+
+  std::sort(
+      constraints.begin(), constraints.end(),
+      [](const IterConstraint& a, const IterConstraint& b) { return a.expr_size < b.expr_size; });
+
+  return DetectIterMapPreparsed(indices, constrained_input_iters, constraints, check_level,
+                                analyzer, simplify_trivial_iterators);
+}
+
 TVM_REGISTER_GLOBAL("arith.DetectIterMap")
     .set_body_typed([](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
                        const PrimExpr& input_pred, int check_level,
@@ -2135,20 +2162,73 @@ PrimExpr NormalizeIterMapToExpr(const PrimExpr& expr) {
 
 TVM_REGISTER_GLOBAL("arith.NormalizeIterMapToExpr").set_body_typed(NormalizeIterMapToExpr);
 
-Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-                                const PrimExpr& input_pred, IterMapLevel check_level,
-                                arith::Analyzer* ana, bool simplify_trivial_iterators) {
-  if (!IterRangeSanityCheck(input_iters)) return indices;
-  auto res = DetectIterMap(indices, input_iters, input_pred, check_level, ana,
-                           /*simplify_trivial_iterators=*/simplify_trivial_iterators);
-  Array<IterSumExpr> rewrite = res->indices;
+/*! \brief The pre-parsed iterator context shared by the Simplify calls. */
+struct IterMapSimplifier::Impl {
+  /*! \brief The iterator ranges as given, used by the predicate-free fallback. */
+  Map<Var, Range> input_iters;
+  /*! \brief The iterator ranges with single-iterator bound constraints applied. */
+  Map<Var, Range> constrained_input_iters;
+  /*! \brief The remaining predicate constraints, sorted by expression size. */
+  std::vector<IterConstraint> constraints;
+  /*! \brief The iter mapping checking level. */
+  IterMapLevel check_level;
+  /*! \brief The analyzer used to get context information. */
+  Analyzer* analyzer;
+  /*! \brief Whether iterators with unit extents are simplified. */
+  bool simplify_trivial_iterators;
+  /*! \brief Whether the iterator ranges passed the sanity check. */
+  bool ranges_valid{false};
+  /*! \brief Whether the predicate could be parsed into constraints. */
+  bool predicate_valid{false};
+  /*! \brief Whether the predicate is trivially true. */
+  bool predicate_is_one{false};
+};
+
+IterMapSimplifier::IterMapSimplifier(const Map<Var, Range>& input_iters,
+                                     const PrimExpr& input_pred, IterMapLevel check_level,
+                                     arith::Analyzer* analyzer, bool simplify_trivial_iterators)
+    : impl_(std::make_unique<Impl>()) {
+  impl_->input_iters = input_iters;
+  impl_->check_level = check_level;
+  impl_->analyzer = analyzer;
+  impl_->simplify_trivial_iterators = simplify_trivial_iterators;
+  impl_->ranges_valid = IterRangeSanityCheck(input_iters);
+  if (!impl_->ranges_valid) return;
+  impl_->predicate_is_one = is_one(input_pred);
+  impl_->constrained_input_iters = input_iters;
+  if (impl_->predicate_is_one) {
+    impl_->predicate_valid = true;
+    return;
+  }
+  impl_->predicate_valid =
+      MatchBoundConstraints(input_pred, &impl_->constrained_input_iters, &impl_->constraints);
+  if (!impl_->predicate_valid) return;
+  for (IterConstraint& constraint : impl_->constraints) {
+    constraint.expr_size = CalculateExprComplexity(constraint.iter);
+  }
+  std::sort(
+      impl_->constraints.begin(), impl_->constraints.end(),
+      [](const IterConstraint& a, const IterConstraint& b) { return a.expr_size < b.expr_size; });
+}
+
+IterMapSimplifier::~IterMapSimplifier() = default;
 
-  if (rewrite.empty() && !is_one(input_pred) && check_level != IterMapLevel::Bijective) {
+Array<PrimExpr> IterMapSimplifier::Simplify(const Array<PrimExpr>& indices) {
+  if (!impl_->ranges_valid) return indices;
+  Array<IterSumExpr> rewrite;
+  if (impl_->predicate_valid) {
+    rewrite = DetectIterMapPreparsed(indices, impl_->constrained_input_iters, impl_->constraints,
+                                     impl_->check_level, impl_->analyzer,
+                                     impl_->simplify_trivial_iterators)
+                  ->indices;
+  }
+  if (rewrite.empty() && !impl_->predicate_is_one &&
+      impl_->check_level != IterMapLevel::Bijective) {
     // The input predicate may cause detect iter map to fail
     // but we can still detect the iter map without the input predicate
     // in which case the resulting iter map is valid and can be used for simplification.
-    rewrite = DetectIterMap(indices, input_iters, const_true(), check_level, ana,
-                            /*simplify_trivial_iterators=*/simplify_trivial_iterators)
+    rewrite = DetectIterMapPreparsed(indices, impl_->input_iters, {}, impl_->check_level,
+                                     impl_->analyzer, impl_->simplify_trivial_iterators)
                   ->indices;
   }
 
@@ -2157,11 +2237,18 @@ Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, R
   }
   Array<PrimExpr> simplified;
   simplified.reserve(rewrite.size());
-  IterMapToExprNormalizer converter(ana);
+  IterMapToExprNormalizer converter(impl_->analyzer);
   for (const auto& expr : rewrite) simplified.push_back(converter.Convert(expr));
   return simplified;
 }
 
+Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                                const PrimExpr& input_pred, IterMapLevel check_level,
+                                arith::Analyzer* ana, bool simplify_trivial_iterators) {
+  return IterMapSimplifier(input_iters, input_pred, check_level, ana, simplify_trivial_iterators)
+      .Simplify(indices);
+}
+
 TVM_REGISTER_GLOBAL("arith.IterMapSimplify")
     .set_body_typed([](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
                        const PrimExpr& input_pred, int check_level,
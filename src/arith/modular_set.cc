@@ -111,6 +111,7 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       }
     }
     var_map_[var] = Entry(info->coeff, info->base);
+    memo_.clear();
   }
 
   // Detect useful constraints and use them in the analysis scope.
@@ -131,15 +132,31 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
   }
 
   // Override visitor behaviors
+  Entry VisitExpr(const PrimExpr& expr) final {
+    auto it = memo_.find(expr);
+    if (it != memo_.end()) {
+      return it->second;
+    }
+    Entry res = ExprFunctor::VisitExpr(expr);
+    if (memo_.size() >= kMaxMemoSize) {
+      memo_.clear();
+    }
+    memo_[expr] = res;
+    return res;
+  }
+
   Entry VisitExprDefault_(const Object* op) final { return Everything(); }
 
   Entry VisitExpr_(const LetNode* op) final {
     auto it = var_map_.find(op->var);
     // if the var has not been binded, update the info.
     if (it == var_map_.end()) {
-      var_map_[op->var] = this->VisitExpr(op->value);
+      Entry value = this->VisitExpr(op->value);
+      var_map_[op->var] = value;
+      memo_.clear();
       Entry ret = VisitExpr(op->body);
       var_map_.erase(op->var);
+      memo_.clear();
       return ret;
     } else {
       return VisitExpr(op->body);
@@ -303,6 +320,13 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
   Analyzer* parent_{nullptr};
   // internal variable map
   std::unordered_map<Var, Entry> var_map_;
+  // memoization of sub-expression results, keyed on object identity.
+  // Cached entries depend on the bindings that were active when they were
+  // computed, so the table is cleared whenever var_map_ changes.
+  std::unordered_map<PrimExpr, Entry, ObjectPtrHash, ObjectPtrEqual> memo_;
+  // bound on the memo table so long-lived analyzers do not grow it
+  // without limit.
+  static constexpr size_t kMaxMemoSize = 8192;
   /*!
    * \brief Update var by intersecting entry with var's current set.
    * \param var The variable.
@@ -316,8 +340,12 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       old = it->second;
     }
     var_map_[var] = Intersect(old, entry);
+    memo_.clear();
     // reover function.
-    return [this, old, var]() { var_map_[var] = old; };
+    return [this, old, var]() {
+      var_map_[var] = old;
+      memo_.clear();
+    };
   }
   /*!
    * \brief Create union of two sets.
@@ -89,6 +89,18 @@ using namespace tir;
     return RecursiveRewrite((ResExpr).Eval());                   \
   }
 
+// Whether the expression is a leaf from the viewpoint of the rewrite rules,
+// i.e. not an arithmetic composite (Add, Sub, Mul, Div, Mod, FloorDiv,
+// FloorMod, Min, Max, Select, Ramp, Broadcast, ...) that a nested pattern
+// could destructure. Used as a pre-dispatch filter: when every rule for an
+// operator requires at least one composite operand, a node whose operands are
+// all atoms cannot match any of them and the linear rule scan can be skipped.
+inline bool IsRewriteAtom(const PrimExpr& expr) {
+  return expr->IsInstance<VarNode>() || expr->IsInstance<IntImmNode>() ||
+         expr->IsInstance<FloatImmNode>() || expr->IsInstance<BufferLoadNode>() ||
+         expr->IsInstance<ProducerLoadNode>();
+}
+
 // NOTE for developers:
 //
 // We mainly focus on index expression simplification.
@@ -386,6 +398,14 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
   PrimExpr ret = IRMutatorWithAnalyzer::VisitExpr_(op);
   op = ret.as<AddNode>();
   if (auto const_res = TryConstFold<Add>(op->a, op->b)) return const_res.value();
+  // Pre-dispatch filter: every rule below requires at least one composite
+  // operand or two structurally equal operands (x + x), so the sum of two
+  // distinct atoms -- the common case in index arithmetic -- cannot match
+  // and skips the scan over the rule table entirely.
+  if (IsRewriteAtom(op->a) && IsRewriteAtom(op->b) && !ExprDeepEqual()(op->a, op->b)) {
+    RecordRuleScanSkipped();
+    return ret;
+  }
   // Pattern var to match any expression
   PVar<PrimExpr> x, y, z, b1, b2, s1, s2;
   // Pattern var match IntImm
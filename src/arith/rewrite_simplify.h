@@ -52,6 +52,7 @@ struct RewriteSimplifierStatsNode : Object {
   int64_t rewrites_performed{0};
   int64_t max_recursive_depth{0};
   int64_t num_recursive_rewrites{0};
+  int64_t rule_scans_skipped{0};
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("nodes_visited", &nodes_visited);
@@ -60,6 +61,7 @@ struct RewriteSimplifierStatsNode : Object {
     v->Visit("rewrites_performed", &rewrites_performed);
     v->Visit("max_recursive_depth", &max_recursive_depth);
     v->Visit("num_recursive_rewrites", &num_recursive_rewrites);
+    v->Visit("rule_scans_skipped", &rule_scans_skipped);
   }
 
   static constexpr const char* _type_key = "arith.RewriteSimplifierStats";
@@ -136,6 +138,7 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
   RewriteSimplifierStatsNode stats_;
 
   void RecordAttemptedRewrite() { stats_.rewrites_attempted++; }
+  void RecordRuleScanSkipped() { stats_.rule_scans_skipped++; }
   void RecordRewrite() {
     stats_.rewrites_performed++;
 
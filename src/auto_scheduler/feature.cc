@@ -40,7 +40,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <mutex>
 #include <numeric>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -1360,8 +1363,65 @@ void GetPerStoreFeatureName(int max_n_bufs, std::vector<std::string>* ret) {
   // section total : 3
 }
 
+/*!
+ * \brief Process-wide cache of extracted per-store features.
+ *
+ * Evolutionary search re-evaluates the same candidate states across generations,
+ * and each evaluation used to pay a full ApplySteps plus TIR lowering just to
+ * recompute an identical feature vector. States are keyed by their printed
+ * schedule (the same identity the search policies use to deduplicate states)
+ * together with everything else the lowering depends on. The cache is cleared
+ * wholesale when it reaches capacity; entries are cheap to recompute.
+ */
+class PerStoreFeatureCache {
+ public:
+  static PerStoreFeatureCache* Global() {
+    static PerStoreFeatureCache inst;
+    return &inst;
+  }
+
+  bool Get(const std::string& key, std::vector<float>* out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      return false;
+    }
+    *out = it->second;
+    return true;
+  }
+
+  void Put(const std::string& key, const std::vector<float>& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.size() >= kMaxEntries) {
+      cache_.clear();
+    }
+    cache_[key] = value;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4096;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<float>> cache_;
+};
+
+std::string PerStoreFeatureCacheKey(const SearchTask& task, const State& state, int max_n_bufs) {
+  auto pass_ctx = tvm::transform::PassContext::Current();
+  std::ostringstream os;
+  os << task->workload_key << "/" << task->target->str() << "/"
+     << task->hardware_params->cache_line_bytes << "/" << max_n_bufs << "/"
+     << pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value() << "/"
+     << pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value() << "/"
+     << state.ToStr();
+  return os.str();
+}
+
 void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, int max_n_bufs,
                                    std::vector<float>* feature, std::atomic<int>* error_ct) {
+  std::string cache_key = PerStoreFeatureCacheKey(task, state, max_n_bufs);
+  if (PerStoreFeatureCache::Global()->Get(cache_key, feature)) {
+    return;
+  }
+
   auto [sch, tensors] = task->compute_dag.ApplySteps(state->transform_steps);
 
   // When inlining, replace const matrices with const values.
@@ -1415,6 +1475,7 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
     mod = optimize(std::move(mod));
     PrimFunc prim_func = Downcast<PrimFunc>(mod->Lookup(name));
     GetPerStoreFeature(prim_func, task->hardware_params->cache_line_bytes, max_n_bufs, feature);
+    PerStoreFeatureCache::Global()->Put(cache_key, *feature);
   } catch (Error& e) {
     (*error_ct)++;
   }
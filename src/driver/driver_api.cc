@@ -24,17 +24,24 @@
 #include <dmlc/thread_local.h>
 #include <tvm/driver/driver_api.h>
 #include <tvm/ir/transform.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/executor.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/target/codegen.h>
 #include <tvm/te/operation.h>
 #include <tvm/tir/analysis.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <mutex>
 #include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace tvm {
 
@@ -42,8 +49,10 @@ namespace tvm {
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.noalias", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.detect_global_barrier", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_bound_checkers", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.emit_kernel_trace_hooks", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_assert", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_vectorize", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.vectorize_reduction_loops", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_buffer_level_predication", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_cse_tir", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_debug", Bool);
@@ -52,6 +61,7 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_storage_rewrite", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.is_entry_func", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.add_lower_pass", Array<Array<ObjectRef>>);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.debug_keep_trivial_loop", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.parallel_lowering", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.use_async_copy", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.merge_static_smem", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_lwp", Bool);
@@ -65,6 +75,13 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tir.ptx_ldg32", Bool);
 // the "experimental" notation for this feature.
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.experimental_dma_bypass_cache", Bool);
 
+// Extra host CPU feature levels to compile every exported function for, e.g.
+// ["avx512", "avx2"]. Each level produces a copy of the host module whose symbols
+// carry the runtime::symbol::tvm_isa_variant_infix marker; the system library
+// selects the best variant the executing machine supports at load time, so one
+// artifact can ship per-microarchitecture kernels. Only supported for llvm hosts.
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.host_isa_variants", Array<String>);
+
 using tvm::Array;
 using tvm::transform::Pass;
 
@@ -214,6 +231,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
   pass_list.push_back(tir::transform::Simplify());
   pass_list.push_back(tir::transform::InjectPermutedLayout());
   pass_list.push_back(tir::transform::Simplify());
+  pass_list.push_back(tir::transform::AutoSoftwarePipeline());
   pass_list.push_back(tir::transform::InjectSoftwarePipeline());
   pass_list.push_back(tir::transform::TransformMmaBufferLayout());
   pass_list.push_back(tir::transform::LowerOpaqueBlock());
@@ -281,17 +299,147 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
   return pass_list;
 }
 
-IRModule LowerWithPassList(IRModule mod, Array<tvm::transform::Pass> pass_list) {
-  auto optimize = tvm::transform::Sequential(pass_list);
-  mod = optimize(std::move(mod));
+/*!
+ * \brief Apply a pass pipeline to every function of the module in parallel.
+ *
+ * Each function is lowered in its own single-function module on a worker
+ * thread and the results are merged back, so compile time for modules with
+ * thousands of kernels scales with the number of cores instead of running
+ * single-threaded. The lowering pipelines are function-scoped, which makes
+ * the split equivalent to running the pipeline on the whole module.
+ */
+IRModule ApplyPassesParallel(IRModule mod, transform::Sequential seq) {
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  std::vector<GlobalVar> global_vars;
+  std::vector<BaseFunc> base_funcs;
+  for (const auto& kv : mod->functions) {
+    global_vars.push_back(kv.first);
+    base_funcs.push_back(kv.second);
+  }
+  std::vector<IRModule> lowered(global_vars.size());
+  support::parallel_for(0, static_cast<int>(global_vars.size()), [&](int i) {
+    // Worker threads start with an empty pass context stack, so enter the
+    // caller's context to make the pass configuration visible to the passes.
+    With<transform::PassContext> scope(pass_ctx);
+    IRModule func_mod = IRModule({{global_vars[i], base_funcs[i]}}, mod->type_definitions, {}, {},
+                                 mod->attrs);
+    lowered[i] = seq(std::move(func_mod));
+  });
+  for (const IRModule& func_mod : lowered) {
+    mod->Update(func_mod);
+  }
   return mod;
 }
 
 IRModule ApplyPasses(IRModule mod, transform::Sequential seq) {
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  bool parallel_lowering =
+      pass_ctx->GetConfig<Bool>("tir.parallel_lowering", Bool(false)).value();
+  if (parallel_lowering && mod->functions.size() > 1) {
+    bool all_prim_funcs = true;
+    for (const auto& kv : mod->functions) {
+      if (!kv.second->IsInstance<tir::PrimFuncNode>()) {
+        all_prim_funcs = false;
+        break;
+      }
+    }
+    // Pass instruments run on the worker threads in the parallel mode and are
+    // not necessarily thread-safe, so keep the sequential path when any are
+    // registered.
+    if (all_prim_funcs && pass_ctx->instruments.size() == 0) {
+      return ApplyPassesParallel(std::move(mod), seq);
+    }
+  }
   mod = seq(std::move(mod));
   return mod;
 }
 
+/*!
+ * \brief A process-wide cache of lowered modules for repeated driver invocations.
+ *
+ *  Interactive tuning sessions call tvm.build on many near-identical inputs and pay the
+ *  full lowering pipeline each time. When TVM_DRIVER_LOWER_CACHE=1, lowered modules are
+ *  memoized keyed by the structural hash of the input module and the current pass
+ *  configuration; hits skip the pipeline entirely. Lowered modules are immutable, so the
+ *  cached instance can be shared freely. Off by default because the cache retains the
+ *  input and output modules for the process lifetime.
+ */
+class LoweredModuleCache {
+ public:
+  static LoweredModuleCache* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new LoweredModuleCache();
+    return inst;
+  }
+
+  static bool Enabled() {
+    static bool enabled = []() -> bool {
+      const char* var = std::getenv("TVM_DRIVER_LOWER_CACHE");
+      return var != nullptr && std::atoi(var) != 0;
+    }();
+    return enabled;
+  }
+
+  Optional<IRModule> Lookup(const IRModule& mod, size_t config_hash) {
+    size_t key = Combine(tvm::StructuralHash()(mod), config_hash);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (tvm::StructuralEqual()(it->second.input, mod)) {
+        return it->second.output;
+      }
+    }
+    return NullOpt;
+  }
+
+  void Insert(const IRModule& mod, size_t config_hash, const IRModule& lowered) {
+    size_t key = Combine(tvm::StructuralHash()(mod), config_hash);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      // Bulk eviction keeps the bookkeeping trivial; a full cache simply starts over.
+      entries_.clear();
+    }
+    entries_.emplace(key, Entry{mod, lowered});
+  }
+
+  /*! \brief Hash of the state the pipeline output depends on besides the module. */
+  static size_t CurrentConfigHash(size_t num_passes) {
+    transform::PassContext ctx = transform::PassContext::Current();
+    size_t hash = tvm::StructuralHash()(ctx->config);
+    hash = Combine(hash, num_passes);
+    hash = Combine(hash, static_cast<size_t>(ctx->opt_level));
+    return hash;
+  }
+
+ private:
+  struct Entry {
+    IRModule input;
+    IRModule output;
+  };
+
+  static size_t Combine(size_t a, size_t b) {
+    return a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2));
+  }
+
+  static constexpr size_t kMaxEntries = 1024;
+  std::unordered_multimap<size_t, Entry> entries_;
+  std::mutex mutex_;
+};
+
+IRModule LowerWithPassList(IRModule mod, Array<tvm::transform::Pass> pass_list) {
+  if (LoweredModuleCache::Enabled()) {
+    size_t config_hash = LoweredModuleCache::CurrentConfigHash(pass_list.size());
+    if (Optional<IRModule> cached = LoweredModuleCache::Global()->Lookup(mod, config_hash)) {
+      return cached.value();
+    }
+    IRModule lowered = ApplyPasses(mod, tvm::transform::Sequential(pass_list));
+    LoweredModuleCache::Global()->Insert(mod, config_hash, lowered);
+    return lowered;
+  }
+  return ApplyPasses(std::move(mod), tvm::transform::Sequential(pass_list));
+}
+
 // Convert te schedule to IRModule
 IRModule ScheduleToModule(te::Schedule sch, const Array<ObjectRef>& args, const std::string& name,
                           const std::unordered_map<te::Tensor, tir::Buffer>& binds,
@@ -451,6 +599,57 @@ void CheckAndUpdateHostConsistency(Map<Target, IRModule>* targets, Target* host)
   *targets = new_targets;
 }
 
+/*!
+ * \brief Compile ISA-variant copies of the host module per `tir.host_isa_variants`.
+ *
+ *  Every exported function is duplicated with the variant infix appended to its
+ *  global symbol and rebuilt with the `mcpu` matching the requested feature level,
+ *  so the system library can pick the widest variant the host CPU supports.
+ *
+ * \param mhost_all The merged host module.
+ * \param target_host The host target the variants are derived from.
+ * \return The compiled variant modules, possibly empty.
+ */
+std::vector<runtime::Module> BuildHostIsaVariants(const IRModule& mhost_all,
+                                                  const Target& target_host) {
+  std::vector<runtime::Module> variants;
+  Array<String> tags = transform::PassContext::Current()
+                           ->GetConfig<Array<String>>("tir.host_isa_variants", Array<String>())
+                           .value();
+  if (tags.empty()) {
+    return variants;
+  }
+  if (target_host->kind->name != "llvm") {
+    LOG(WARNING) << "tir.host_isa_variants requires an llvm host target, but the host is "
+                 << target_host->kind->name << "; no ISA variants are generated";
+    return variants;
+  }
+  // The feature tags the runtime probes for, and the cpu each one maps to.
+  static const std::unordered_map<std::string, std::string> kTagToMCpu = {
+      {"avx512", "skylake-avx512"}, {"avx2", "core-avx2"}, {"sse42", "nehalem"}};
+  for (const String& tag : tags) {
+    auto it = kTagToMCpu.find(tag);
+    CHECK(it != kTagToMCpu.end()) << "ValueError: unknown entry \"" << tag
+                                  << "\" in tir.host_isa_variants, expect one of"
+                                     " \"avx512\", \"avx2\" or \"sse42\"";
+    Map<GlobalVar, BaseFunc> functions;
+    for (auto kv : mhost_all->functions) {
+      BaseFunc func = kv.second;
+      if (Optional<String> sym = func->GetAttr<String>(tvm::attr::kGlobalSymbol)) {
+        std::string variant_sym =
+            std::string(sym.value()) + runtime::symbol::tvm_isa_variant_infix + std::string(tag);
+        func = WithAttr(std::move(func), tvm::attr::kGlobalSymbol, String(variant_sym));
+      }
+      functions.Set(kv.first, func);
+    }
+    IRModule variant_mod(functions, {}, {}, {}, mhost_all->attrs);
+    Map<String, ObjectRef> config = target_host->Export();
+    config.Set("mcpu", String(it->second));
+    variants.push_back(codegen::Build(variant_mod, Target(config)));
+  }
+  return variants;
+}
+
 runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
                              const Target& target_host_arg) {
   CHECK(inputs_arg.size()) << "TIRToRuntime expects at least one IRModule as input.";
@@ -517,6 +716,9 @@ runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
   }
 
   runtime::Module mhost = codegen::Build(mhost_all, target_host);
+  for (const auto& it : BuildHostIsaVariants(mhost_all, target_host)) {
+    mhost.Import(it);
+  }
   for (const auto& it : device_modules) {
     if (it.operator->()) {
       mhost.Import(it);
@@ -531,6 +733,36 @@ TVM_REGISTER_GLOBAL("driver.tir_to_runtime")
       return TIRToRuntime(inputs_arg, host_target);
     });
 
+/*!
+ * \brief Build many IRModules for the same target in one call.
+ *
+ *  Tuning builders compile large batches of candidate schedules; crossing the FFI and
+ *  reconstructing the lowering pipeline per module adds up. This entry point builds the
+ *  pass list once, reuses it for every module, and benefits from the lowered-module
+ *  cache when TVM_DRIVER_LOWER_CACHE is enabled.
+ *
+ * \param mods The modules to build.
+ * \param target The target to build for.
+ * \param target_host The host target, may be undefined.
+ * \return The built runtime modules, in the order of the inputs.
+ */
+runtime::Module BatchBuildOne(IRModule mod, const Target& target, const Target& target_host,
+                              const Array<tvm::transform::Pass>& pass_list) {
+  IRModule lowered = LowerWithPassList(std::move(mod), pass_list);
+  return TIRToRuntime({{target, lowered}}, target_host);
+}
+
+TVM_REGISTER_GLOBAL("driver.batch_build")
+    .set_body_typed([](Array<IRModule> mods, Target target, Target target_host, bool simple_mode) {
+      Array<tvm::transform::Pass> pass_list = CreatePassList(simple_mode);
+      Array<runtime::Module> results;
+      results.reserve(mods.size());
+      for (IRModule mod : mods) {
+        results.push_back(BatchBuildOne(std::move(mod), target, target_host, pass_list));
+      }
+      return results;
+    });
+
 // Build for heterogeneous execution when targets are specified as
 // objects.  This wrapper around the internal API is maintained for
 // backwards compatibility.
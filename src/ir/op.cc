@@ -62,6 +62,14 @@ const AttrRegistryMapContainerMap<Op>& Op::GetAttrMapContainer(const String& att
   return OpRegistry::Global()->GetAttrMap(attr_name);
 }
 
+OpAttrToken::OpAttrToken(const String& attr_name)
+    : token_(OpRegistry::Global()->AttrKeyToken(attr_name)) {}
+
+// Get attribute map by pre-resolved key token
+const AttrRegistryMapContainerMap<Op>& Op::GetAttrMapContainer(const OpAttrToken& attr_key) {
+  return OpRegistry::Global()->GetAttrMap(attr_key.token());
+}
+
 // Check if a key is present in the registry.
 bool Op::HasAttrMap(const String& attr_name) { return OpRegistry::Global()->HasAttrMap(attr_name); }
 
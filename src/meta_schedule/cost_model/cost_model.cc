@@ -45,6 +45,50 @@ std::vector<double> PyCostModelNode::Predict(const TuneContext& context,
   return result;
 }
 
+void ModuleCostModelNode::Load(const String& path) {
+  model = runtime::Module::LoadFromFile(path);
+  predict_func = model->GetFunction("predict", /*query_imports=*/true);
+  CHECK(predict_func != nullptr) << "ValueError: The model loaded from \"" << path
+                                 << "\" does not provide a `predict` function.";
+}
+
+void ModuleCostModelNode::Save(const String& path) {
+  LOG(FATAL) << "ValueError: ModuleCostModel is inference-only and cannot be saved. "
+             << "Export the model with its own toolchain instead.";
+}
+
+void ModuleCostModelNode::Update(const TuneContext& context,
+                                 const Array<MeasureCandidate>& candidates,
+                                 const Array<RunnerResult>& results) {
+  // The model is pre-trained and frozen; measurement results do not update it.
+}
+
+std::vector<double> ModuleCostModelNode::Predict(const TuneContext& context,
+                                                 const Array<MeasureCandidate>& candidates) {
+  ICHECK(predict_func != nullptr) << "ValueError: ModuleCostModel's model is not loaded. "
+                                  << "Call `Load` before `Predict`.";
+  Array<runtime::NDArray> features = extractor->ExtractFrom(context, candidates);
+  runtime::NDArray scores = predict_func(features);
+  CHECK(scores->ndim == 1 && static_cast<size_t>(scores->shape[0]) == candidates.size())
+      << "ValueError: The model is expected to return one score per candidate, while the "
+      << "returned array has a mismatching shape.";
+  CHECK(scores.DataType() == DataType::Float(64))
+      << "ValueError: The model is expected to return float64 scores, while "
+      << scores.DataType() << " is got.";
+  if (scores->device.device_type != kDLCPU) {
+    scores = scores.CopyTo(Device{kDLCPU, 0});
+  }
+  const double* data = static_cast<const double*>(scores->data);
+  return std::vector<double>(data, data + candidates.size());
+}
+
+CostModel CostModel::ModuleCostModel(FeatureExtractor extractor, String path) {
+  ObjectPtr<ModuleCostModelNode> n = make_object<ModuleCostModelNode>();
+  n->extractor = std::move(extractor);
+  n->Load(path);
+  return CostModel(n);
+}
+
 CostModel CostModel::PyCostModel(PyCostModelNode::FLoad f_load,        //
                                  PyCostModelNode::FSave f_save,        //
                                  PyCostModelNode::FUpdate f_update,    //
@@ -68,8 +112,14 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
       p->stream << f_as_string();
     });
 
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<ModuleCostModelNode>([](const ObjectRef& n, ReprPrinter* p) {
+      p->stream << "meta_schedule.ModuleCostModel";
+    });
+
 TVM_REGISTER_OBJECT_TYPE(CostModelNode);
 TVM_REGISTER_NODE_TYPE(PyCostModelNode);
+TVM_REGISTER_NODE_TYPE(ModuleCostModelNode);
 
 TVM_REGISTER_GLOBAL("meta_schedule.CostModelLoad").set_body_method<CostModel>(&CostModelNode::Load);
 TVM_REGISTER_GLOBAL("meta_schedule.CostModelSave").set_body_method<CostModel>(&CostModelNode::Save);
@@ -84,6 +134,8 @@ TVM_REGISTER_GLOBAL("meta_schedule.CostModelPredict")
       std::copy(result.begin(), result.end(), static_cast<double*>(p_addr));
     });
 TVM_REGISTER_GLOBAL("meta_schedule.CostModelPyCostModel").set_body_typed(CostModel::PyCostModel);
+TVM_REGISTER_GLOBAL("meta_schedule.CostModelModuleCostModel")
+    .set_body_typed(CostModel::ModuleCostModel);
 
 }  // namespace meta_schedule
 }  // namespace tvm
@@ -16,12 +16,79 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../module_equality.h"
 #include "../utils.h"
 
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief A shape-insensitive summary of a workload used for similarity retrieval.
+ *
+ *  `op_signature` captures the structure (sorted block names of every PrimFunc), which must
+ *  match exactly for two workloads to be comparable; `log_extents` captures the sorted
+ *  constant loop extents in log2 space, so that shape variants of the same kernel are close.
+ */
+struct WorkloadFingerprint {
+  std::string op_signature;
+  std::vector<double> log_extents;
+
+  static WorkloadFingerprint FromModule(const IRModule& mod) {
+    WorkloadFingerprint fingerprint;
+    std::vector<std::string> block_names;
+    for (const auto& kv : mod->functions) {
+      if (const auto* prim_func = kv.second.as<tir::PrimFuncNode>()) {
+        tir::PostOrderVisit(prim_func->body, [&](const ObjectRef& obj) {
+          if (const auto* block = obj.as<tir::BlockNode>()) {
+            block_names.push_back(block->name_hint);
+          } else if (const auto* loop = obj.as<tir::ForNode>()) {
+            if (const auto* extent = loop->extent.as<IntImmNode>()) {
+              fingerprint.log_extents.push_back(
+                  std::log2(static_cast<double>(std::max<int64_t>(extent->value, 1))));
+            }
+          }
+        });
+      }
+    }
+    std::sort(block_names.begin(), block_names.end());
+    for (const std::string& name : block_names) {
+      fingerprint.op_signature += name;
+      fingerprint.op_signature += ';';
+    }
+    std::sort(fingerprint.log_extents.begin(), fingerprint.log_extents.end());
+    return fingerprint;
+  }
+
+  /*!
+   * \brief The distance to another fingerprint with the same op signature.
+   *  Aligned sorted log-extents are compared pairwise; unmatched extents are charged as if
+   *  compared against extent 1.
+   */
+  double DistanceTo(const WorkloadFingerprint& other) const {
+    size_t n = std::min(log_extents.size(), other.log_extents.size());
+    double distance = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      distance += std::fabs(log_extents[i] - other.log_extents[i]);
+    }
+    for (size_t i = n; i < log_extents.size(); ++i) {
+      distance += log_extents[i];
+    }
+    for (size_t i = n; i < other.log_extents.size(); ++i) {
+      distance += other.log_extents[i];
+    }
+    return distance;
+  }
+};
+
 /******** Workload ********/
 
 Workload::Workload(IRModule mod) {
@@ -174,6 +241,47 @@ TuningRecord TuningRecord::FromJSON(const ObjectRef& json_obj, const Workload& w
 DatabaseNode::DatabaseNode(String mod_eq_name) { mod_eq_ = ModuleEquality::Create(mod_eq_name); }
 DatabaseNode::~DatabaseNode() = default;
 
+Array<TuningRecord> DatabaseNode::GetSimilarTopK(const IRModule& mod, int top_k) {
+  WorkloadFingerprint query = WorkloadFingerprint::FromModule(mod);
+  Workload::THashCode query_shash = GetModuleEquality().Hash(mod);
+  // Fingerprint each distinct workload once; records of a workload share its distance.
+  std::unordered_map<const WorkloadNode*, double> workload2distance;
+  std::vector<TuningRecord> candidates;
+  for (const TuningRecord& record : this->GetAllTuningRecords()) {
+    if (!record->IsValid()) {
+      continue;
+    }
+    const WorkloadNode* workload = record->workload.get();
+    auto it = workload2distance.find(workload);
+    if (it == workload2distance.end()) {
+      double distance = -1.0;
+      if (!(workload->shash == query_shash && GetModuleEquality().Equal(workload->mod, mod))) {
+        WorkloadFingerprint fingerprint = WorkloadFingerprint::FromModule(workload->mod);
+        if (fingerprint.op_signature == query.op_signature) {
+          distance = query.DistanceTo(fingerprint);
+        }
+      }
+      it = workload2distance.emplace(workload, distance).first;
+    }
+    if (it->second >= 0) {
+      candidates.push_back(record);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&workload2distance](const TuningRecord& a, const TuningRecord& b) -> bool {
+                     double da = workload2distance.at(a->workload.get());
+                     double db = workload2distance.at(b->workload.get());
+                     if (da != db) {
+                       return da < db;
+                     }
+                     return SortTuningRecordByMeanRunSecs()(a, b);
+                   });
+  if (top_k >= 0 && static_cast<int>(candidates.size()) > top_k) {
+    candidates.resize(top_k);
+  }
+  return Array<TuningRecord>(candidates.begin(), candidates.end());
+}
+
 Optional<TuningRecord> DatabaseNode::QueryTuningRecord(const IRModule& mod, const Target& target,
                                                        const String& workload_name) {
   if (!this->HasWorkload(mod)) {
@@ -311,6 +419,8 @@ TVM_REGISTER_GLOBAL("meta_schedule.DatabaseCommitTuningRecord")
     .set_body_method<Database>(&DatabaseNode::CommitTuningRecord);
 TVM_REGISTER_GLOBAL("meta_schedule.DatabaseGetTopK")
     .set_body_method<Database>(&DatabaseNode::GetTopK);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseGetSimilarTopK")
+    .set_body_method<Database>(&DatabaseNode::GetSimilarTopK);
 TVM_REGISTER_GLOBAL("meta_schedule.DatabaseGetAllTuningRecords")
     .set_body_method<Database>(&DatabaseNode::GetAllTuningRecords);
 TVM_REGISTER_GLOBAL("meta_schedule.DatabaseSize").set_body_method<Database>(&DatabaseNode::Size);
@@ -76,10 +76,18 @@ class JSONDatabaseNode : public DatabaseNode {
   String path_workload;
   /*! \brief The path to the tuning record table */
   String path_tuning_record;
+  /*! \brief The number of tuning records buffered before they are written in one batch */
+  int commit_batch_size = 1;
   /*! \brief All the workloads in the database */
   std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
   /*! \brief All the tuning records in the database */
   std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs> tuning_records_;
+  /*! \brief The serialized tuning records not yet written to the record file */
+  std::vector<std::string> pending_record_lines_;
+  /*! \brief The append stream of the record file, kept open across batched commits */
+  std::ofstream tuning_record_stream_;
+
+  ~JSONDatabaseNode() { FlushTuningRecords(); }
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("path_workload", &path_workload);
@@ -112,11 +120,30 @@ class JSONDatabaseNode : public DatabaseNode {
 
   void CommitTuningRecord(const TuningRecord& record) {
     this->tuning_records_.insert(record);
-    JSONFileAppendLine(this->path_tuning_record,
-                       JSONDumps(Array<ObjectRef>{
-                           /*workload_index=*/Integer(this->workloads2idx_.at(record->workload)),
-                           /*tuning_record=*/record->AsJSON()  //
-                       }));
+    this->pending_record_lines_.push_back(JSONDumps(Array<ObjectRef>{
+        /*workload_index=*/Integer(this->workloads2idx_.at(record->workload)),
+        /*tuning_record=*/record->AsJSON()  //
+    }));
+    if (static_cast<int>(this->pending_record_lines_.size()) >= this->commit_batch_size) {
+      FlushTuningRecords();
+    }
+  }
+
+  /*! \brief Write the buffered tuning records to the record file in one batch. */
+  void FlushTuningRecords() {
+    if (this->pending_record_lines_.empty()) {
+      return;
+    }
+    if (!this->tuning_record_stream_.is_open()) {
+      this->tuning_record_stream_.open(this->path_tuning_record, std::ofstream::app);
+      CHECK(this->tuning_record_stream_.good())
+          << "ValueError: Cannot open the file to write: " << this->path_tuning_record;
+    }
+    for (const std::string& line : this->pending_record_lines_) {
+      this->tuning_record_stream_ << line << '\n';
+    }
+    this->tuning_record_stream_.flush();
+    this->pending_record_lines_.clear();
   }
 
   Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
@@ -155,9 +182,11 @@ class JSONDatabaseNode : public DatabaseNode {
 };
 
 Database Database::JSONDatabase(String path_workload, String path_tuning_record, bool allow_missing,
-                                String mod_eq_name) {
+                                String mod_eq_name, int commit_batch_size) {
+  CHECK_GT(commit_batch_size, 0) << "ValueError: commit_batch_size should be a positive number.";
   int num_threads = std::thread::hardware_concurrency();
   ObjectPtr<JSONDatabaseNode> n = make_object<JSONDatabaseNode>(mod_eq_name);
+  n->commit_batch_size = commit_batch_size;
   // Load `n->workloads2idx_` from `path_workload`
   std::vector<Workload> workloads;
   {
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+// Defined in json_database.cc
+extern std::vector<ObjectRef> JSONFileReadLines(const String& path, int num_threads,
+                                                bool allow_missing);
+extern void JSONFileAppendLine(const String& path, const std::string& line);
+
+/*! \brief The path to the workload table inside a database directory. */
+inline std::string ShardedWorkloadPath(const String& path) {
+  return std::string(path) + "/workloads.json";
+}
+
+/*! \brief The path to the i-th tuning-record shard inside a database directory. */
+inline std::string ShardedRecordPath(const String& path, int shard_idx) {
+  return std::string(path) + "/records_" + std::to_string(shard_idx) + ".json";
+}
+
+/*!
+ * \brief A tuning database sharded over multiple append-only record files.
+ *
+ * The on-disk layout is a directory holding the workload table plus
+ * `num_shards` record files using the same JSON-lines encoding as
+ * JSONDatabase. Records are bucketed per workload in memory, so GetTopK is a
+ * hash lookup into the bucket of the queried workload instead of a scan over
+ * every record, and startup parses the shards concurrently instead of
+ * sorting one global record set. Commits stay O(1) appends to the shard
+ * owned by the record's workload.
+ */
+class ShardedDatabaseNode : public DatabaseNode {
+ public:
+  explicit ShardedDatabaseNode(String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name),
+        workloads2idx_(/*bucket_count*/ 0, WorkloadHash(), WorkloadEqual(GetModuleEquality())) {}
+
+  /*! \brief The path to the database directory */
+  String path;
+  /*! \brief The number of record shards in the database directory */
+  int num_shards;
+  /*! \brief All the workloads in the database */
+  std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
+  /*! \brief The tuning records of each workload, bucketed by workload index */
+  std::unordered_map<int, std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs>>
+      records_by_workload_;
+  /*! \brief The total number of tuning records */
+  int64_t num_records_ = 0;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("path", &path);
+    v->Visit("num_shards", &num_shards);
+    // `workloads2idx_` is not visited
+    // `records_by_workload_` is not visited
+    // `num_records_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.ShardedDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ShardedDatabaseNode, DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) {
+    return workloads2idx_.find(Workload(mod, GetModuleEquality().Hash(mod))) !=
+           workloads2idx_.end();
+  }
+
+  Workload CommitWorkload(const IRModule& mod) {
+    auto [it, inserted] =
+        this->workloads2idx_.emplace(Workload(mod, GetModuleEquality().Hash(mod)), -1);
+    Workload workload = it->first;
+    if (inserted) {
+      it->second = static_cast<int>(this->workloads2idx_.size()) - 1;
+      JSONFileAppendLine(ShardedWorkloadPath(this->path), JSONDumps(workload->AsJSON()));
+    }
+    return it->first;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) {
+    int workload_index = this->workloads2idx_.at(record->workload);
+    this->records_by_workload_[workload_index].insert(record);
+    ++this->num_records_;
+    JSONFileAppendLine(ShardedRecordPath(this->path, workload_index % this->num_shards),
+                       JSONDumps(Array<ObjectRef>{
+                           /*workload_index=*/Integer(workload_index),
+                           /*tuning_record=*/record->AsJSON()  //
+                       }));
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    auto idx = this->workloads2idx_.find(workload);
+    if (idx == this->workloads2idx_.end()) {
+      return {};
+    }
+    auto bucket = this->records_by_workload_.find(idx->second);
+    if (bucket == this->records_by_workload_.end()) {
+      return {};
+    }
+    Array<TuningRecord> results;
+    results.reserve(top_k);
+    for (const TuningRecord& record : bucket->second) {
+      if (!record->IsValid()) {
+        continue;
+      }
+      results.push_back(record);
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
+      }
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() {
+    std::vector<TuningRecord> records;
+    records.reserve(this->num_records_);
+    for (const auto& kv : this->records_by_workload_) {
+      records.insert(records.end(), kv.second.begin(), kv.second.end());
+    }
+    std::sort(records.begin(), records.end(), SortTuningRecordByMeanRunSecs());
+    return Array<TuningRecord>(records.begin(), records.end());
+  }
+
+  int64_t Size() { return num_records_; }
+};
+
+Database Database::ShardedDatabase(String path, int num_shards, bool allow_missing,
+                                   String mod_eq_name) {
+  CHECK_GT(num_shards, 0) << "ValueError: num_shards must be positive";
+  int num_threads = std::thread::hardware_concurrency();
+  ObjectPtr<ShardedDatabaseNode> n = make_object<ShardedDatabaseNode>(mod_eq_name);
+  // Load `n->workloads2idx_` from the workload table
+  std::vector<Workload> workloads;
+  {
+    std::vector<ObjectRef> json_objs =
+        JSONFileReadLines(ShardedWorkloadPath(path), num_threads, allow_missing);
+    int n_objs = json_objs.size();
+    n->workloads2idx_.reserve(n_objs);
+    workloads.reserve(n_objs);
+    for (int i = 0; i < n_objs; ++i) {
+      Workload workload = Workload::FromJSON(json_objs[i]);
+      auto recalc_hash = n->GetModuleEquality().Hash(workload->mod);
+      // Todo(tvm-team): re-enable the shash check when we get environment
+      // independent structural hash values.
+      if (recalc_hash != workload->shash) {
+        ObjectPtr<WorkloadNode> wkl = make_object<WorkloadNode>(*workload.get());
+        wkl->shash = recalc_hash;
+        workload = Workload(wkl);
+      }
+      n->workloads2idx_.emplace(workload, i);
+      workloads.push_back(workload);
+    }
+  }
+  // Load the record shards. A directory written with a larger shard count
+  // keeps all its shards readable: loading continues past `num_shards` for
+  // as long as shard files exist, and appends go to the full shard range.
+  {
+    std::vector<std::vector<ObjectRef>> shard_objs;
+    for (int shard_idx = 0;; ++shard_idx) {
+      std::string shard_path = ShardedRecordPath(path, shard_idx);
+      bool exists = static_cast<bool>(std::ifstream(shard_path));
+      if (!exists && shard_idx >= num_shards) {
+        break;
+      }
+      shard_objs.push_back(JSONFileReadLines(shard_path, num_threads, allow_missing && !exists));
+    }
+    num_shards = static_cast<int>(shard_objs.size());
+    for (int shard_idx = 0; shard_idx < num_shards; ++shard_idx) {
+      const std::vector<ObjectRef>& json_objs = shard_objs[shard_idx];
+      std::vector<int> workload_indices(json_objs.size(), -1);
+      std::vector<TuningRecord> records(json_objs.size(), TuningRecord{nullptr});
+      support::parallel_for_dynamic(
+          0, json_objs.size(), num_threads, [&](int thread_id, int task_id) {
+            const ObjectRef& json_obj = json_objs[task_id];
+            Workload workload{nullptr};
+            try {
+              const ArrayNode* arr = json_obj.as<ArrayNode>();
+              ICHECK_EQ(arr->size(), 2);
+              int64_t workload_index = Downcast<runtime::Int>(arr->at(0));
+              ICHECK(workload_index >= 0 && static_cast<size_t>(workload_index) < workloads.size());
+              workload = workloads[workload_index];
+              workload_indices[task_id] = static_cast<int>(workload_index);
+              records[task_id] = TuningRecord::FromJSON(arr->at(1), workload);
+            } catch (std::runtime_error& e) {
+              LOG(FATAL) << "ValueError: Unable to parse TuningRecord, on line " << (task_id + 1)
+                         << " of file " << ShardedRecordPath(path, shard_idx)
+                         << ". The workload is:\n"
+                         << (workload.defined() ? workload->mod->Script() : "(null)")
+                         << "\nThe JSONObject of TuningRecord is:\n"
+                         << json_obj << "\nThe error message is:\n"
+                         << e.what();
+            }
+          });
+      for (size_t i = 0; i < records.size(); ++i) {
+        n->records_by_workload_[workload_indices[i]].insert(records[i]);
+        ++n->num_records_;
+      }
+    }
+  }
+  n->path = path;
+  n->num_shards = num_shards;
+  return Database(n);
+}
+
+TVM_REGISTER_NODE_TYPE(ShardedDatabaseNode);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseShardedDatabase")
+    .set_body_typed(Database::ShardedDatabase);
+
+}  // namespace meta_schedule
+}  // namespace tvm
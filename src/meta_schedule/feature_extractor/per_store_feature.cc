@@ -19,6 +19,7 @@
 #include <tvm/tir/transform.h>
 
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -232,9 +233,8 @@ runtime::NDArray AsNDArray(const std::vector<std::vector<double>>& src, int seco
       /*ctx=*/DLDevice{kDLCPU, 0});
   double* data = static_cast<double*>(tgt->data);
   for (const std::vector<double>& row : src) {
-    for (double v : row) {
-      *data++ = v;
-    }
+    std::memcpy(data, row.data(), row.size() * sizeof(double));
+    data += row.size();
   }
   return tgt;
 }
@@ -1381,6 +1381,9 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     for (int i = 0; i < n_features; ++i) {
       const tir::Feature& feature = features[i];
       std::vector<double>& result = (*results)[i];
+      // The output rows may be reused across candidates, so reset the length
+      // while keeping the allocated capacity.
+      result.clear();
       result.reserve(feature_vector_length);
       feature.group1->Export(&result);
       feature.group2->Export(&result, this->buffers_per_store);
@@ -1401,7 +1404,9 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     }
     auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
       const auto& candidate = candidates[task_id];
-      std::vector<std::vector<double>> features;
+      // Reuse the feature matrix of the worker thread across candidates so the
+      // hot loop stops allocating one row set per candidate.
+      static thread_local std::vector<std::vector<double>> features;
       ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
       if (extract_workload) {
         for (auto& feature : features) {
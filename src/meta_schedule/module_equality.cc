@@ -24,6 +24,10 @@
 #include <tvm/tir/analysis.h>
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "../node/ndarray_hash_equal.h"
 
@@ -33,7 +37,14 @@ namespace meta_schedule {
 class ModuleEqualityStructural : public ModuleEquality {
  public:
   size_t Hash(IRModule mod) const { return tvm::StructuralHash()(mod); }
-  bool Equal(IRModule lhs, IRModule rhs) const { return tvm::StructuralEqual()(lhs, rhs); }
+  bool Equal(IRModule lhs, IRModule rhs) const {
+    // A different number of functions already rules out structural equality,
+    // so skip the deep comparison for trivially distinct modules.
+    if (lhs->functions.size() != rhs->functions.size()) {
+      return false;
+    }
+    return tvm::StructuralEqual()(lhs, rhs);
+  }
   String GetName() const { return "structural"; }
 };
 
@@ -58,6 +69,9 @@ class ModuleEqualityIgnoreNDArray : public ModuleEquality {
  public:
   size_t Hash(IRModule mod) const { return SHashHandlerIgnoreNDArray().Hash(mod, false); }
   bool Equal(IRModule lhs, IRModule rhs) const {
+    if (lhs->functions.size() != rhs->functions.size()) {
+      return false;
+    }
     return SEqualHandlerIgnoreNDArray().Equal(lhs, rhs, false);
   }
   String GetName() const { return "ignore-ndarray"; }
@@ -85,13 +99,75 @@ class ModuleEqualityAnchorBlock : public ModuleEquality {
   String GetName() const { return "anchor-block"; }
 };
 
+/*!
+ * \brief Decorator that memoizes the hash results of an underlying
+ *  ModuleEquality, keyed on the module's object identity.
+ *
+ * Tuning hashes the same extracted workloads thousands of times, so caching
+ * the module-level result makes repeated hashing O(1) after the first visit.
+ * Entries hold a strong reference to the module, so an address can never be
+ * reused by a different module while its entry is alive, and copy-on-write
+ * updates produce a fresh object that misses the cache instead of hitting a
+ * stale entry. Modules must not be mutated in place after being hashed, which
+ * holds for the immutable workloads meta schedule extracts.
+ */
+class ModuleEqualityHashCache : public ModuleEquality {
+ public:
+  explicit ModuleEqualityHashCache(std::unique_ptr<ModuleEquality> inner)
+      : inner_(std::move(inner)) {}
+
+  size_t Hash(IRModule mod) const final {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = cache_.find(mod);
+      if (it != cache_.end()) {
+        return it->second;
+      }
+    }
+    size_t hash = inner_->Hash(mod);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.size() >= kMaxEntries) {
+      cache_.clear();
+    }
+    cache_.emplace(std::move(mod), hash);
+    return hash;
+  }
+
+  bool Equal(IRModule lhs, IRModule rhs) const final {
+    if (lhs.same_as(rhs)) {
+      return true;
+    }
+    // Equal modules hash equal under every ModuleEquality variant, so differing
+    // hashes prove inequality without walking either module. The hashes come
+    // from the cache above, making mismatches O(1) once a module has been
+    // hashed, which is what database lookups against many workloads hit.
+    if (Hash(lhs) != Hash(rhs)) {
+      return false;
+    }
+    return inner_->Equal(lhs, rhs);
+  }
+
+  String GetName() const final { return inner_->GetName(); }
+
+ private:
+  // Bound the table so long tuning sessions do not pin modules forever.
+  static constexpr size_t kMaxEntries = 4096;
+
+  std::unique_ptr<ModuleEquality> inner_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<IRModule, size_t, ObjectPtrHash, ObjectPtrEqual> cache_;
+};
+
 std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq_name) {
+  auto wrap = [](std::unique_ptr<ModuleEquality> inner) -> std::unique_ptr<ModuleEquality> {
+    return std::make_unique<ModuleEqualityHashCache>(std::move(inner));
+  };
   if (mod_eq_name == "structural") {
-    return std::make_unique<ModuleEqualityStructural>();
+    return wrap(std::make_unique<ModuleEqualityStructural>());
   } else if (mod_eq_name == "ignore-ndarray") {
-    return std::make_unique<ModuleEqualityIgnoreNDArray>();
+    return wrap(std::make_unique<ModuleEqualityIgnoreNDArray>());
   } else if (mod_eq_name == "anchor-block") {
-    return std::make_unique<ModuleEqualityAnchorBlock>();
+    return wrap(std::make_unique<ModuleEqualityAnchorBlock>());
   }
   LOG(FATAL) << "Unknown module equality " << mod_eq_name;
 }
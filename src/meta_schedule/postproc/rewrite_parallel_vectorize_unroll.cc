@@ -191,7 +191,7 @@ void AdjustParallelVectorize(const Schedule& sch, const BlockRV& block_rv,
     loop_types.reserve(n_loops);
     for (const LoopRV& loop_rv : loop_rvs) {
       loop_srefs.push_back(sch->GetSRef(loop_rv));
-      loop_types.push_back(GetLoopIterType(loop_srefs.back()));
+      loop_types.push_back(GetLoopIterType(sch->state(), loop_srefs.back()));
     }
   }
   // check the maximal number of axes that are vectorizable (contiguous memory access)
@@ -298,7 +298,7 @@ void AdjustParallelVectorize(const Schedule& sch, const BlockRV& block_rv,
         break;
       }
       // Cannot vectorize reduce axis
-      if (GetLoopIterType(loop_sref) != IterVarType::kDataPar) {
+      if (GetLoopIterType(sch->state(), loop_sref) != IterVarType::kDataPar) {
         break;
       }
       // Cannot fuse with a loop with multiple children
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief A postprocessor that prunes candidates based on early compile feedback.
+ *
+ *  `VerifyGPUCode` checks static resource limits, but register spilling is only visible to
+ *  the target compiler, and spill-bound candidates still reach device measurement. This
+ *  postprocessor compiles each candidate through the registered packed function
+ *  `meta_schedule.gpu_compile_feedback`, which returns `[registers_per_thread, spill_bytes,
+ *  occupancy_percent]` for the candidate (see python/tvm/meta_schedule/postproc/
+ *  verify_register_usage.py for the NVCC-backed default). Spilling candidates are pruned
+ *  outright; candidates whose register-limited occupancy is below the configured floor are
+ *  pruned as well. When no feedback function is registered, or when it cannot compile the
+ *  candidate locally, the postprocessor passes everything through unchanged.
+ */
+class VerifyRegisterUsageNode : public PostprocNode {
+ public:
+  /*! \brief The minimum register-limited occupancy, in percent; 0 disables the check. */
+  int min_occupancy_percent = 0;
+  /*! \brief The target to compile for. */
+  Target target_{nullptr};
+
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    ICHECK(context->target.defined());
+    this->target_ = context->target.value();
+  }
+
+  bool Apply(const tir::Schedule& sch) final {
+    static const runtime::PackedFunc* f_feedback =
+        runtime::Registry::Get("meta_schedule.gpu_compile_feedback");
+    if (f_feedback == nullptr) {
+      return true;
+    }
+    ObjectRef feedback = (*f_feedback)(sch->mod(), this->target_);
+    if (!feedback.defined()) {
+      // The compiler is unavailable or the candidate could not be compiled locally;
+      // leave the decision to the regular build-and-measure flow.
+      return true;
+    }
+    Array<Integer> result = Downcast<Array<Integer>>(feedback);
+    ICHECK_EQ(result.size(), 3) << "ValueError: gpu_compile_feedback must return "
+                                   "[registers_per_thread, spill_bytes, occupancy_percent]";
+    int64_t spill_bytes = result[1].IntValue();
+    int64_t occupancy_percent = result[2].IntValue();
+    if (spill_bytes > 0) {
+      return false;
+    }
+    if (min_occupancy_percent > 0 && occupancy_percent < min_occupancy_percent) {
+      return false;
+    }
+    return true;
+  }
+
+  Postproc Clone() const {
+    ObjectPtr<VerifyRegisterUsageNode> n = make_object<VerifyRegisterUsageNode>(*this);
+    return Postproc(n);
+  }
+
+  void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("min_occupancy_percent", &min_occupancy_percent); }
+
+  static constexpr const char* _type_key = "meta_schedule.VerifyRegisterUsage";
+  TVM_DECLARE_FINAL_OBJECT_INFO(VerifyRegisterUsageNode, PostprocNode);
+};
+
+Postproc Postproc::VerifyRegisterUsage(int min_occupancy_percent) {
+  ObjectPtr<VerifyRegisterUsageNode> n = make_object<VerifyRegisterUsageNode>();
+  n->min_occupancy_percent = min_occupancy_percent;
+  return Postproc(n);
+}
+
+TVM_REGISTER_NODE_TYPE(VerifyRegisterUsageNode);
+TVM_REGISTER_GLOBAL("meta_schedule.PostprocVerifyRegisterUsage")
+    .set_body_typed(Postproc::VerifyRegisterUsage);
+
+}  // namespace meta_schedule
+}  // namespace tvm
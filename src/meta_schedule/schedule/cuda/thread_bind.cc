@@ -125,7 +125,7 @@ void BindBlockThreadIdx(tir::Schedule sch, tir::BlockRV block_rv,  //
         i_multi_child = i + 1;
       }
     }
-    if (GetLoopIterType(loop_sref) == IterVarType::kDataPar) {
+    if (GetLoopIterType(sch->state(), loop_sref) == IterVarType::kDataPar) {
       if (i_spatial_loop == i - 1) {
         ++i_spatial_loop;
       }
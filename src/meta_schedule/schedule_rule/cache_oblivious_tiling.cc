@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+using tir::IterVarType;
+using tir::LoopRV;
+using tir::Schedule;
+
+/*!
+ * \brief The rule that tiles a block with a cache-oblivious loop structure.
+ *
+ * Instead of sampling tile sizes that fit one particular cache hierarchy, the
+ * rule halves every data-parallel and reduction axis simultaneously for a
+ * controlled number of levels, which is the iterative lowering of the
+ * recursive subdivision of a cache-oblivious algorithm: whatever the cache
+ * sizes are, some level of the resulting loop nest works on a block that fits
+ * each cache. The produced schedule contains no sampling instructions, so it
+ * is portable across targets with different cache hierarchies.
+ */
+class CacheObliviousTilingNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  Array<Schedule> Apply(const Schedule& sch, const tir::BlockRV& block_rv) final;
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<CacheObliviousTilingNode> n = make_object<CacheObliviousTilingNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ public:
+  /*! \brief The maximum number of halving levels, i.e. the recursion depth. */
+  int depth;
+  /*! \brief Stop halving an axis once its tile extent would drop below this. */
+  int min_inner_extent;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("depth", &depth);
+    v->Visit("min_inner_extent", &min_inner_extent);
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.CacheObliviousTiling";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CacheObliviousTilingNode, ScheduleRuleNode);
+};
+
+Array<Schedule> CacheObliviousTilingNode::Apply(const Schedule& sch, const tir::BlockRV& block_rv) {
+  if (!NeedsMultiLevelTiling(sch->state(), sch->GetSRef(block_rv))) {
+    return {sch};
+  }
+  // Keep the original schedule so the search can still compare against the
+  // other tiling rules applied to it.
+  Schedule ori_sch = sch->Copy();
+  ori_sch->Seed(sch->ForkSeed());
+
+  // Step 1. Assuming trivial binding, pair the loops and their iter-var-types,
+  // and decide how many times each axis can be halved.
+  Array<LoopRV> loops = sch->GetLoops(block_rv);
+  std::vector<IterVarType> iter_types = GetBlockVarTypes(sch->GetSRef(block_rv));
+  ICHECK_EQ(loops.size(), iter_types.size());
+  int n = loops.size();
+  std::vector<int> num_levels(n, 0);
+  int max_levels = 0;
+  for (int i = 0; i < n; ++i) {
+    if (iter_types[i] != IterVarType::kDataPar && iter_types[i] != IterVarType::kCommReduce) {
+      continue;
+    }
+    const int64_t* extent = tir::GetLoopIntExtent(sch->Get(loops[i]).get());
+    if (extent == nullptr) {
+      continue;
+    }
+    int levels = 0;
+    for (int64_t tile = *extent; levels < depth && tile >= 2 * min_inner_extent; tile /= 2) {
+      ++levels;
+    }
+    num_levels[i] = levels;
+    max_levels = std::max(max_levels, levels);
+  }
+  if (max_levels == 0) {
+    return {ori_sch};
+  }
+
+  // Step 2. Split each axis into its halving chain. Every factor is a
+  // constant 2, so no tile-size decision is recorded in the trace.
+  std::vector<Array<LoopRV>> chains(n);
+  for (int i = 0; i < n; ++i) {
+    if (num_levels[i] == 0) {
+      chains[i] = {loops[i]};
+      continue;
+    }
+    Array<Optional<tir::ExprRV>> factors;
+    factors.push_back(NullOpt);
+    for (int level = 0; level < num_levels[i]; ++level) {
+      factors.push_back(Integer(2));
+    }
+    chains[i] = sch->Split(loops[i], factors);
+  }
+
+  // Step 3. Reorder level by level: first the outer chunk of every axis, then
+  // the level-1 halves of every axis, and so on. This is the recursive
+  // subdivision unrolled to `depth` iterative tiling levels.
+  Array<LoopRV> order;
+  for (int level = 0; level <= max_levels; ++level) {
+    for (int i = 0; i < n; ++i) {
+      if (level < static_cast<int>(chains[i].size())) {
+        order.push_back(chains[i][level]);
+      }
+    }
+  }
+  sch->Reorder(order);
+  return {sch, ori_sch};
+}
+
+ScheduleRule ScheduleRule::CacheObliviousTiling(int depth, int min_inner_extent) {
+  CHECK_GE(depth, 1) << "ValueError: depth must be at least 1, but gets: " << depth;
+  CHECK_GE(min_inner_extent, 1) << "ValueError: min_inner_extent must be at least 1, but gets: "
+                                << min_inner_extent;
+  ObjectPtr<CacheObliviousTilingNode> n = make_object<CacheObliviousTilingNode>();
+  n->depth = depth;
+  n->min_inner_extent = min_inner_extent;
+  return ScheduleRule(n);
+}
+
+TVM_REGISTER_NODE_TYPE(CacheObliviousTilingNode);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleCacheObliviousTiling")
+    .set_body_typed(ScheduleRule::CacheObliviousTiling);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -112,8 +112,34 @@ class SizedHeap {
 struct PerThreadData {
   IRModule mod{nullptr};
   TRandState rand_state{-1};
-  std::function<int32_t()> trace_sampler = nullptr;
-  std::function<Optional<Mutator>()> mutator_sampler = nullptr;
+  /*! \brief Thread-local copies of the design space traces. See `SetDesignSpaces`. */
+  Array<tir::Trace> design_spaces;
+  /*! \brief Stateless samplers drawing from the per-candidate random state passed per call. */
+  std::function<int32_t(TRandState*)> trace_sampler = nullptr;
+  std::function<Optional<Mutator>(TRandState*)> mutator_sampler = nullptr;
+
+  /*!
+   * \brief Make thread-local copies of the design space traces.
+   * \param spaces The design space traces shared by all threads.
+   * \note Trace replay in the sampling/mutation workers copies the instructions of the picked
+   * design space, so if all threads read the same trace objects, every candidate bumps the
+   * refcounts of the same instruction objects and the workers serialize on those atomics.
+   * Replaying each design space once onto this thread's module copy recreates the instructions
+   * as thread-local objects, after which the workers touch no shared IR.
+   */
+  void SetDesignSpaces(const Array<tir::Trace>& spaces) {
+    design_spaces.clear();
+    design_spaces.reserve(spaces.size());
+    for (const tir::Trace& space : spaces) {
+      tir::Schedule sch =
+          tir::Schedule::Traced(mod,
+                                /*rand_state=*/ForkSeed(&rand_state),
+                                /*debug_mode=*/0,
+                                /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+      space->ApplyToSchedule(sch, /*remove_postproc=*/false);
+      design_spaces.push_back(sch->trace().value()->Simplified(true));
+    }
+  }
 
   /*!
    * \brief Set the value for the trace and mutator samplers per thread.
@@ -123,20 +149,18 @@ struct PerThreadData {
    */
   void Set(const std::vector<double>& scores, double genetic_mutate_prob,
            const Map<Mutator, FloatImm>& mutator_probs) {
-    trace_sampler = tir::MakeMultinomialSampler(&rand_state, scores);
-    mutator_sampler = MakeMutatorSampler(genetic_mutate_prob, mutator_probs, &rand_state);
+    trace_sampler = tir::MakeMultinomialSampler(scores);
+    mutator_sampler = MakeMutatorSampler(genetic_mutate_prob, mutator_probs);
   }
 
  private:
   /*!
    * \brief Create a sampler function that picks mutators according to the mass function
-   * \param rand_state The random state for sampling
-   * \return The sampler created
+   * \return The sampler created, drawing from the random state passed per call
    */
-  static std::function<Optional<Mutator>()> MakeMutatorSampler(
-      double genetic_mutate_prob,                   //
-      const Map<Mutator, FloatImm>& mutator_probs,  //
-      TRandState* rand_state) {
+  static std::function<Optional<Mutator>(TRandState*)> MakeMutatorSampler(
+      double genetic_mutate_prob,  //
+      const Map<Mutator, FloatImm>& mutator_probs) {
     std::vector<Optional<Mutator>> mutators;
     std::vector<double> masses;
     mutators.push_back(NullOpt);
@@ -162,9 +186,9 @@ struct PerThreadData {
         masses[i] /= total_mass_mutator;
       }
     }
-    return [idx_sampler = tir::MakeMultinomialSampler(rand_state, masses),
-            mutators = std::move(mutators)]() -> Optional<Mutator> {
-      int i = idx_sampler();
+    return [idx_sampler = tir::MakeMultinomialSampler(masses),
+            mutators = std::move(mutators)](TRandState* rand_state) mutable -> Optional<Mutator> {
+      int i = idx_sampler(rand_state);
       return mutators[i];
     };
   }
@@ -208,16 +232,20 @@ struct ConcurrentBitmask {
 /*!
  * \brief Assemble measure candidates from the given candidate traces.
  * \param traces The picked candidate traces.
+ * \param num_threads The number of threads used to extract the argument info.
  * \return The assembled measure candidates.
  */
-Array<MeasureCandidate> AssembleCandidates(const std::vector<Schedule>& picks) {
-  Array<MeasureCandidate> measure_inputs;
-  measure_inputs.reserve(picks.size());
-  for (const Schedule& sch : picks) {
-    measure_inputs.push_back(
-        MeasureCandidate(sch, ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true)));
-  }
-  return measure_inputs;
+Array<MeasureCandidate> AssembleCandidates(const std::vector<Schedule>& picks, int num_threads) {
+  // The argument info extraction analyzes each candidate's module independently,
+  // and used to be the serial tail of every cost model query on large populations.
+  std::vector<MeasureCandidate> measure_inputs(picks.size(), MeasureCandidate{nullptr});
+  support::parallel_for_dynamic(
+      0, picks.size(), num_threads, [&picks, &measure_inputs](int thread_id, int task_id) {
+        const Schedule& sch = picks.at(task_id);
+        measure_inputs.at(task_id) =
+            MeasureCandidate(sch, ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true));
+      });
+  return Array<MeasureCandidate>(measure_inputs.begin(), measure_inputs.end());
 }
 
 /*!
@@ -232,13 +260,33 @@ std::vector<double> PredictNormalizedScore(const std::vector<Schedule>& candidat
                                            const CostModel& cost_model) {
   auto _ = Profiler::TimedScope("EvoSearch/Evolve/PredictNormalizedScore");
   ICHECK(!candidates.empty()) << "Candidates given for score prediction can not be empty list!";
-  std::vector<double> scores = cost_model->Predict(context, AssembleCandidates(candidates));
+  std::vector<double> scores =
+      cost_model->Predict(context, AssembleCandidates(candidates, context->num_threads));
   for (double& score : scores) {
     score = std::max(0.0, score);
   }
   return scores;
 }
 
+/*!
+ * \brief Fingerprint a mutated trace by its sampling decisions.
+ * \param trace The trace to fingerprint
+ * \return A hash identifying the trace among mutations of the same parent
+ * \note Mutators rewrite decisions via `Trace::WithDecision` and share the parent's
+ * instruction objects, so hashing the instruction identities together with the decision
+ * values distinguishes any two mutations without walking into the instructions themselves.
+ */
+size_t TraceDecisionHash(const tir::Trace& trace) {
+  uint64_t hash_code = 0;
+  for (const tir::Instruction& inst : trace->insts) {
+    if (Optional<ObjectRef> decision = trace->GetDecision(inst)) {
+      hash_code = support::HashCombine(hash_code, std::hash<const Object*>()(inst.get()));
+      hash_code = support::HashCombine(hash_code, StructuralHash()(decision.value()));
+    }
+  }
+  return hash_code;
+}
+
 /**************** Evolutionary Search ****************/
 
 /*!\brief A search strategy that generates measure candidates using evolutionary search. */
@@ -293,6 +341,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       for (PerThreadData& data : this->per_thread_data_) {
         data.mod = DeepCopyIRModule(mod);
         data.rand_state = ForkSeed(&self->rand_state_);
+        data.SetDesignSpaces(design_spaces);
       }
       this->database_ = database;
       this->cost_model_ = cost_model;
@@ -482,10 +531,14 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   int actual_num = measured_traces.size();
   ThreadedTraceApply pp(self->postprocs_);
   std::vector<Schedule> results(actual_num, Schedule{nullptr});
-  auto f_proc_measured = [this, &measured_traces, &results, &pp](int thread_id,
-                                                                 int trace_id) -> void {
+  TRandState base_seed = ForkSeed(&self->rand_state_);
+  auto f_proc_measured = [this, &measured_traces, &results, &pp, base_seed](int thread_id,
+                                                                            int trace_id) -> void {
     PerThreadData& data = this->per_thread_data_.at(thread_id);
-    TRandState* rand_state = &data.rand_state;
+    // One counter-based stream per candidate, so the result does not depend
+    // on which thread picks up which candidate.
+    TRandState candidate_state = support::LinearCongruentialEngine::StreamSeed(base_seed, trace_id);
+    TRandState* rand_state = &candidate_state;
     const IRModule& mod = data.mod;
     tir::Trace trace = measured_traces.at(trace_id);
     Schedule& result = results.at(trace_id);
@@ -498,6 +551,43 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     }
   };
   support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_measured);
+  if (actual_num < num) {
+    // Warm start: top up with traces transferred from similar workloads, e.g. the same
+    // kernel tuned at different shapes. Transferred traces were recorded against another
+    // module, so application failures are tolerated and simply skipped.
+    std::vector<tir::Trace> transfer_traces;
+    for (TuningRecord record : this->database_->GetSimilarTopK(this->token_->mod, num - actual_num)) {
+      transfer_traces.push_back(record->trace);
+    }
+    int num_transfer = transfer_traces.size();
+    std::vector<Schedule> transferred(num_transfer, Schedule{nullptr});
+    TRandState transfer_seed = ForkSeed(&self->rand_state_);
+    auto f_proc_transfer = [this, &transfer_traces, &transferred, &pp, transfer_seed](
+                               int thread_id, int trace_id) -> void {
+      PerThreadData& data = this->per_thread_data_.at(thread_id);
+      TRandState candidate_state =
+          support::LinearCongruentialEngine::StreamSeed(transfer_seed, trace_id);
+      TRandState* rand_state = &candidate_state;
+      const IRModule& mod = data.mod;
+      tir::Trace trace = transfer_traces.at(trace_id);
+      if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
+        transferred.at(trace_id) = sch.value();
+      }
+    };
+    support::parallel_for_dynamic(0, num_transfer, self->ctx_->num_threads, f_proc_transfer);
+    int num_applied = 0;
+    for (const Schedule& sch : transferred) {
+      if (sch.defined()) {
+        results.push_back(sch);
+        ++num_applied;
+      }
+    }
+    if (num_transfer > 0) {
+      TVM_PY_LOG(INFO, self->ctx_->logger)
+          << "Transferred " << num_applied << " / " << num_transfer
+          << " trace(s) from similar workloads to seed the population";
+    }
+  }
   return results;
 }
 
@@ -509,14 +599,17 @@ std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int nu
   while (static_cast<int>(out_schs.size()) < self->init_min_unmeasured &&
          fail_count < self->max_fail_count) {
     std::vector<Schedule> results(num, Schedule{nullptr});
-    auto f_proc_unmeasured = [this, &results, &pp](int thread_id, int trace_id) -> void {
+    TRandState base_seed = ForkSeed(&self->rand_state_);
+    auto f_proc_unmeasured = [this, &results, &pp, base_seed](int thread_id, int trace_id) -> void {
       PerThreadData& data = this->per_thread_data_.at(thread_id);
-      TRandState* rand_state = &data.rand_state;
+      TRandState candidate_state =
+          support::LinearCongruentialEngine::StreamSeed(base_seed, trace_id);
+      TRandState* rand_state = &candidate_state;
       const IRModule& mod = data.mod;
       Schedule& result = results.at(trace_id);
       ICHECK(!result.defined());
-      int design_space_index = tir::SampleInt(rand_state, 0, design_spaces.size());
-      tir::Trace trace(design_spaces[design_space_index]->insts, {});
+      int design_space_index = tir::SampleInt(rand_state, 0, data.design_spaces.size());
+      tir::Trace trace(data.design_spaces[design_space_index]->insts, {});
       if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
         result = sch.value();
       }
@@ -578,31 +671,49 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
       ThreadedTraceApply pp(self->postprocs_);
       ConcurrentBitmask cbmask(self->population_size);
       std::vector<Schedule> next_population(self->population_size, Schedule{nullptr});
+      TRandState base_seed = ForkSeed(&self->rand_state_);
       // The worker function
-      auto f_find_candidate = [&cbmask, &population, &next_population, &pp, this](int thread_id,
-                                                                                  int trace_id) {
+      auto f_find_candidate = [&cbmask, &population, &next_population, &pp, base_seed,
+                               this](int thread_id, int trace_id) {
         // Prepare samplers
         PerThreadData& data = this->per_thread_data_.at(thread_id);
-        TRandState* rand_state = &data.rand_state;
+        // One counter-based stream per candidate: all draws below, including
+        // the ones inside the stateless samplers, come from this stream, so
+        // the evolved population is identical however candidates are
+        // distributed over threads.
+        TRandState candidate_state =
+            support::LinearCongruentialEngine::StreamSeed(base_seed, trace_id);
+        TRandState* rand_state = &candidate_state;
         const IRModule& mod = data.mod;
-        std::function<int()>& trace_sampler = data.trace_sampler;
-        std::function<Optional<Mutator>()>& mutator_sampler = data.mutator_sampler;
+        std::function<int(TRandState*)>& trace_sampler = data.trace_sampler;
+        std::function<Optional<Mutator>(TRandState*)>& mutator_sampler = data.mutator_sampler;
         Schedule& result = next_population.at(trace_id);
         int sampled_trace_id = -1;
+        // Fingerprints of mutations that already failed post-processing for this
+        // candidate. Mutators draw from small decision spaces, so retries often
+        // regenerate an earlier mutation; remembering the failures avoids paying
+        // the full trace replay and post-processing for them a second time.
+        std::vector<size_t> failed_mutations;
         // Loop until success
         for (int fail_count = 0; fail_count <= self->genetic_max_fail_count; ++fail_count) {
-          sampled_trace_id = trace_sampler();
+          sampled_trace_id = trace_sampler(rand_state);
           tir::Trace trace = population.at(sampled_trace_id)->trace().value();
-          if (Optional<Mutator> opt_mutator = mutator_sampler()) {
+          if (Optional<Mutator> opt_mutator = mutator_sampler(rand_state)) {
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
             if (Optional<tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
+              size_t fingerprint = TraceDecisionHash(new_trace.value());
+              if (std::find(failed_mutations.begin(), failed_mutations.end(), fingerprint) !=
+                  failed_mutations.end()) {
+                continue;
+              }
               if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
                 result = sch.value();
                 break;
               }
+              failed_mutations.push_back(fingerprint);
             }
           } else if (cbmask.QueryAndMark(sampled_trace_id)) {
             // Decision: do not mutate
@@ -735,7 +846,7 @@ Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasure
       return NullOpt;
     }
   }
-  return AssembleCandidates(picks);
+  return AssembleCandidates(picks, self->ctx_->num_threads);
 }
 
 void EvolutionarySearchNode::State::NotifyRunnerResults(
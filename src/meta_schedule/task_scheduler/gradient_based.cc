@@ -26,18 +26,22 @@ class GradientBasedNode final : public TaskSchedulerNode {
  public:
   double alpha;
   int window_size;
+  int stall_rounds;
   support::LinearCongruentialEngine::TRandState rand_state;
 
   int round_robin_rounds_;
   std::vector<std::vector<double>> best_latency_history_;
+  std::vector<int> rounds_without_improvement_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     TaskSchedulerNode::VisitAttrs(v);
     v->Visit("alpha", &alpha);
     v->Visit("window_size", &window_size);
+    v->Visit("stall_rounds", &stall_rounds);
     // `rand_state` is not visited.
     // `num_rounds_already_` is not visited.
     // `best_latency_history_` is not visited.
+    // `rounds_without_improvement_` is not visited.
   }
 
   static constexpr const char* _type_key = "meta_schedule.GradientBased";
@@ -51,6 +55,7 @@ class GradientBasedNode final : public TaskSchedulerNode {
     int n_tasks = tasks.size();
     round_robin_rounds_ = 0;
     best_latency_history_.resize(n_tasks, std::vector<double>());
+    rounds_without_improvement_.resize(n_tasks, 0);
     TaskSchedulerNode::Tune(tasks, task_weights, max_trials_global, max_trials_per_task,
                             num_trials_per_iter, builder, runner, measure_callbacks, database,
                             cost_model);
@@ -80,9 +85,22 @@ class GradientBasedNode final : public TaskSchedulerNode {
       tasks_alive.reserve(n_tasks);
       for (int i = 0; i < n_tasks; ++i) {
         this->TouchTask(i);
-        if (!this->tasks_[i]->is_terminated) {
-          tasks_alive.push_back(i);
+        if (this->tasks_[i]->is_terminated) {
+          continue;
         }
+        // Preempt tasks that have stopped improving: their budget is better
+        // spent on tasks whose gradient is still live.
+        if (stall_rounds > 0 && rounds_without_improvement_[i] >= stall_rounds) {
+          if (this->tasks_[i]->runner_futures.defined()) {
+            this->JoinRunningTask(i);
+          }
+          TVM_PY_LOG(INFO, this->logger)
+              << "Task #" << i << " is preempted: no improvement in the last "
+              << rounds_without_improvement_[i] << " measurement round(s)";
+          TerminateTask(i);
+          continue;
+        }
+        tasks_alive.push_back(i);
       }
       if (tasks_alive.empty()) {
         return -1;
@@ -101,6 +119,15 @@ class GradientBasedNode final : public TaskSchedulerNode {
         double g1 = (n >= 1 + w) ? (best_latency[n - 1 - w] - best) / w : 0.0;
         double g2 = best / n;
         double g = alpha * g1 + (1 - alpha) * g2;
+        // Normalize by the wallclock cost of one measurement round of this
+        // task, so that the scheduler maximizes predicted improvement per
+        // second rather than per round: a task whose candidates take 10x
+        // longer to build and measure must promise 10x the improvement.
+        const TaskRecordNode* task = this->tasks_[task_id].get();
+        double seconds_per_round = (task->build_seconds + task->run_seconds) / n;
+        if (seconds_per_round > 0) {
+          g /= seconds_per_round;
+        }
         grad.push_back(g * task_weight);
       } else {
         // If the best time cost is unavailable, it means some task is not valid. Skip it.
@@ -126,20 +153,28 @@ class GradientBasedNode final : public TaskSchedulerNode {
     Array<RunnerResult> results = TaskSchedulerNode::JoinRunningTask(task_id);
     TaskRecordNode* task = this->tasks_[task_id].get();
     if (task->latency_ms.size() > 0) {
-      this->best_latency_history_.at(task_id).push_back(
-          *std::min_element(task->latency_ms.begin(),  //
-                            task->latency_ms.end()));
+      std::vector<double>& history = this->best_latency_history_.at(task_id);
+      double best = *std::min_element(task->latency_ms.begin(),  //
+                                      task->latency_ms.end());
+      if (!history.empty() && best >= history.back()) {
+        ++this->rounds_without_improvement_.at(task_id);
+      } else {
+        this->rounds_without_improvement_.at(task_id) = 0;
+      }
+      history.push_back(best);
     }
     return results;
   }
 };
 
 TaskScheduler TaskScheduler::GradientBased(PackedFunc logger, double alpha, int window_size,
-                                           support::LinearCongruentialEngine::TRandState seed) {
+                                           support::LinearCongruentialEngine::TRandState seed,
+                                           int stall_rounds) {
   ObjectPtr<GradientBasedNode> n = make_object<GradientBasedNode>();
   n->logger = logger;
   n->alpha = alpha;
   n->window_size = window_size;
+  n->stall_rounds = stall_rounds;
   n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
   return TaskScheduler(n);
 }
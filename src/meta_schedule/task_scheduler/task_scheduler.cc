@@ -16,11 +16,30 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <chrono>
+#include <cstdlib>
+#include <future>
+
 #include "../utils.h"
 
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief Whether the scheduler overlaps building with the harvest of running measurements.
+ * Controlled by the environment variable TVM_META_SCHEDULE_PIPELINE_BUILD; disabled when unset.
+ * \note The pipelined mode runs the builder on a background thread, which requires the builder
+ * implementation to tolerate being invoked off the main thread (the popen-pool-based local
+ * builder does). It is therefore opt-in.
+ */
+inline bool PipelinedBuildEnabled() {
+  static bool enabled = []() -> bool {
+    const char* var = std::getenv("TVM_META_SCHEDULE_PIPELINE_BUILD");
+    return var != nullptr && std::atoi(var) != 0;
+  }();
+  return enabled;
+}
+
 TaskRecord::TaskRecord(TuneContext ctx, double task_weight) {
   ObjectPtr<TaskRecordNode> n = runtime::make_object<TaskRecordNode>();
   n->ctx = ctx;
@@ -40,6 +59,7 @@ TaskRecord::TaskRecord(TuneContext ctx, double task_weight) {
 
 void SendToBuilder(TaskRecordNode* self, const Builder& builder) {
   auto _ = Profiler::TimedScope("SendToBuilder");
+  auto tik = std::chrono::steady_clock::now();
   Array<MeasureCandidate> candidates = self->measure_candidates.value();
   Target target = self->ctx->target.value();
   Array<BuilderInput> inputs;
@@ -48,10 +68,13 @@ void SendToBuilder(TaskRecordNode* self, const Builder& builder) {
     inputs.push_back(BuilderInput(candidate->sch->mod(), target));
   }
   self->builder_results = builder->Build(inputs);
+  self->build_seconds +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - tik).count();
 }
 
 void SendToRunner(TaskRecordNode* self, const Runner& runner) {
   auto _ = Profiler::TimedScope("SendToRunner");
+  auto tik = std::chrono::steady_clock::now();
   Array<MeasureCandidate> candidates = self->measure_candidates.value();
   Array<BuilderResult> builder_results = self->builder_results.value();
   Target target = self->ctx->target.value();
@@ -72,6 +95,7 @@ void SendToRunner(TaskRecordNode* self, const Runner& runner) {
                                  /*args_info=*/candidate->args_info));
   }
   Array<RunnerFuture> futures = runner->Run(inputs);
+  self->run_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tik).count();
   if (n_build_errors == 0) {
     self->runner_futures = futures;
     return;
@@ -191,7 +215,27 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
       int num_candidates = candidates.value().size();
       num_trials_already += num_candidates;
       TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to builder";
-      SendToBuilder(task, builder);
+      if (PipelinedBuildEnabled()) {
+        // Build on a background thread, and use the wait to harvest the measurements of the
+        // other tasks as they finish. This overlaps compilation with both the in-flight
+        // measurements and the result commit (callbacks, cost model update) of other tasks,
+        // which otherwise only happens after the blocking build returns. The in-flight window
+        // stays bounded: each task still has at most one generation built or measured at a time.
+        std::future<void> builder_future =
+            std::async(std::launch::async, [task, &builder]() { SendToBuilder(task, builder); });
+        while (builder_future.wait_for(std::chrono::milliseconds(10)) !=
+               std::future_status::ready) {
+          for (int i = 0; i < n_tasks; ++i) {
+            if (i != task_id && !tasks_[i]->is_terminated) {
+              TouchTask(i);
+            }
+          }
+        }
+        // Propagate exceptions thrown by the builder, if any.
+        builder_future.get();
+      } else {
+        SendToBuilder(task, builder);
+      }
       TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to runner";
       SendToRunner(task, runner);
     } else {
@@ -216,11 +260,14 @@ Array<RunnerResult> TaskSchedulerNode::JoinRunningTask(int task_id) {
   Array<RunnerResult> results;
   {
     auto _ = Profiler::TimedScope("JoinRunnerFutures");
+    auto tik = std::chrono::steady_clock::now();
     Array<RunnerFuture> futures = task->runner_futures.value();
     results.reserve(futures.size());
     for (RunnerFuture future : futures) {
       results.push_back(future->Result());
     }
+    task->run_seconds +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - tik).count();
   }
   ICHECK(task->measure_candidates.defined());
   task->ctx->search_strategy.value()->NotifyRunnerResults(task->measure_candidates.value(),
@@ -358,8 +358,13 @@ struct ThreadedTraceApply {
   }
 
  private:
-  /*! \brief A helper data structure that stores the fail count for each postprocessor. */
-  struct Item {
+  /*!
+   * \brief A helper data structure that stores the fail count for each postprocessor.
+   * \note Aligned to the cache line size: the counters are incremented concurrently by all
+   * worker threads, and without the padding a frequently-failing postprocessor would bounce
+   * the cache line holding its neighbors' counters as well.
+   */
+  struct alignas(64) Item {
     /*! \brief The postprocessor. */
     Postproc postproc{nullptr};
     /*! \brief The thread-safe postprocessor failure counter. */
@@ -148,6 +148,51 @@ class AttrRegistry {
     return *it->second.get();
   }
 
+  /*!
+   * \brief Assign or look up the dense token of an attribute key.
+   *
+   *  Tokens are assigned in resolution order and stay valid for the lifetime
+   *  of the process, so a caller can resolve a key once at static-init and
+   *  use the token for all subsequent GetAttrMap calls.
+   *
+   * \param attr_name The name of the attribute.
+   * \return The token assigned to the attribute key.
+   */
+  uint32_t AttrKeyToken(const String& attr_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = attr_token_map_.find(attr_name);
+    if (it != attr_token_map_.end()) return it->second;
+    uint32_t token = static_cast<uint32_t>(attr_token_table_.size());
+    attr_token_map_[attr_name] = token;
+    attr_token_table_.emplace_back(attr_name, nullptr);
+    return token;
+  }
+
+  /*!
+   * \brief Get an internal attribute map by its key token.
+   *
+   *  Equivalent to the name based overload but indexes the attribute table
+   *  directly instead of probing a string keyed map.
+   *
+   * \param token The token obtained from AttrKeyToken.
+   * \return The result attribute map.
+   */
+  const AttrRegistryMapContainerMap<KeyType>& GetAttrMap(uint32_t token) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ICHECK_LT(token, attr_token_table_.size()) << "Invalid attribute key token " << token;
+    auto& entry = attr_token_table_[token];
+    if (entry.second == nullptr) {
+      // The attribute table is created lazily by the first UpdateAttr, which
+      // may run after the token was assigned; bind the pointer on first use.
+      auto it = attrs_.find(entry.first);
+      if (it == attrs_.end()) {
+        LOG(FATAL) << "Attribute \'" << entry.first << "\' is not registered";
+      }
+      entry.second = it->second.get();
+    }
+    return *entry.second;
+  }
+
   /*!
    * \brief Check of attribute has been registered.
    * \param attr_name The name of the attribute.
@@ -175,6 +220,10 @@ class AttrRegistry {
   std::unordered_map<String, EntryType*> entry_map_;
   // storage of additional attribute table.
   std::unordered_map<String, std::unique_ptr<AttrRegistryMapContainerMap<KeyType>>> attrs_;
+  // map from attribute key to its dense token.
+  std::unordered_map<String, uint32_t> attr_token_map_;
+  // token indexed table of attribute keys and their tables.
+  std::vector<std::pair<String, const AttrRegistryMapContainerMap<KeyType>*>> attr_token_table_;
 };
 
 }  // namespace tvm
@@ -151,6 +151,63 @@ ReflectionVTable* ReflectionVTable::Global() {
   return &inst;
 }
 
+namespace {
+// Records the name, kind and byte offset of every field visited on one
+// representative instance. Member offsets are a property of the type, so
+// the recorded table is valid for every other instance of the same type.
+class FieldInfoRecorder : public AttrVisitor {
+ public:
+  FieldInfoRecorder(Object* self, std::vector<AttrFieldInfo>* fields)
+      : base_(reinterpret_cast<char*>(self)), fields_(fields) {}
+
+  void Visit(const char* key, double* value) final { Record(key, AttrFieldKind::kDouble, value); }
+  void Visit(const char* key, int64_t* value) final { Record(key, AttrFieldKind::kInt64, value); }
+  void Visit(const char* key, uint64_t* value) final { Record(key, AttrFieldKind::kUInt64, value); }
+  void Visit(const char* key, int* value) final { Record(key, AttrFieldKind::kInt, value); }
+  void Visit(const char* key, bool* value) final { Record(key, AttrFieldKind::kBool, value); }
+  void Visit(const char* key, std::string* value) final {
+    Record(key, AttrFieldKind::kString, value);
+  }
+  void Visit(const char* key, void** value) final { Record(key, AttrFieldKind::kVoidPtr, value); }
+  void Visit(const char* key, DataType* value) final {
+    Record(key, AttrFieldKind::kDataType, value);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    Record(key, AttrFieldKind::kNDArray, value);
+  }
+  void Visit(const char* key, runtime::ObjectRef* value) final {
+    Record(key, AttrFieldKind::kObjectRef, value);
+  }
+
+ private:
+  void Record(const char* key, AttrFieldKind kind, void* addr) {
+    fields_->push_back(
+        AttrFieldInfo{key, kind, static_cast<size_t>(reinterpret_cast<char*>(addr) - base_)});
+  }
+
+  char* base_;
+  std::vector<AttrFieldInfo>* fields_;
+};
+}  // anonymous namespace
+
+const std::vector<AttrFieldInfo>* ReflectionVTable::GetFieldInfo(Object* self) {
+  uint32_t tindex = self->type_index();
+  if (tindex >= fvisit_attrs_.size() || fvisit_attrs_[tindex] == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(field_info_mutex_);
+  if (tindex >= field_info_.size()) {
+    field_info_.resize(tindex + 1);
+  }
+  if (field_info_[tindex] == nullptr) {
+    auto fields = std::make_unique<std::vector<AttrFieldInfo>>();
+    FieldInfoRecorder recorder(self, fields.get());
+    fvisit_attrs_[tindex](self, &recorder);
+    field_info_[tindex] = std::move(fields);
+  }
+  return field_info_[tindex].get();
+}
+
 ObjectPtr<Object> ReflectionVTable::CreateInitObject(const std::string& type_key,
                                                      const std::string& repr_bytes) const {
   uint32_t tindex = Object::TypeKey2Index(type_key);
@@ -22,6 +22,13 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace tvm {
 
@@ -30,11 +37,124 @@ TVMScriptPrinter::FType& TVMScriptPrinter::vtable() {
   return inst;
 }
 
+namespace {
+
+/*!
+ * \brief A bounded cache of printed scripts, keyed by object identity.
+ *
+ *  Pipelines that log tuning records reprint the same IRModule or PrimFunc
+ *  objects many times; printing is deterministic given the node and the
+ *  config, so the text can be reused as long as the node object is alive.
+ *  Keying by object pointer (with the cached entry holding a reference to
+ *  keep the pointer valid) makes hits exact: structurally equal but distinct
+ *  objects simply miss. Enabled by setting TVM_SCRIPT_PRINTER_CACHE=1.
+ */
+class ScriptCache {
+ public:
+  static ScriptCache* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new ScriptCache();
+    return inst;
+  }
+
+  static bool Enabled() {
+    static bool enabled = []() {
+      const char* val = std::getenv("TVM_SCRIPT_PRINTER_CACHE");
+      return val != nullptr && std::atoi(val) != 0;
+    }();
+    return enabled;
+  }
+
+  /*! \brief Whether the config allows reuse: per-site markup varies between prints. */
+  static bool Cacheable(const PrinterConfig& cfg) {
+    return cfg->path_to_underline.empty() && cfg->path_to_annotate.empty() &&
+           cfg->obj_to_underline.empty() && cfg->obj_to_annotate.empty();
+  }
+
+  /*! \brief The scalar config fields that affect the printed text. */
+  static std::string ConfigFingerprint(const PrinterConfig& cfg) {
+    std::ostringstream os;
+    os << cfg->ir_prefix << ';' << cfg->tir_prefix << ';' << cfg->relax_prefix << ';'
+       << cfg->module_alias << ';' << cfg->buffer_dtype << ';' << cfg->int_dtype << ';'
+       << cfg->float_dtype << ';' << cfg->verbose_expr << ';' << cfg->indent_spaces << ';'
+       << cfg->print_line_numbers << ';' << cfg->num_context_lines << ';' << cfg->syntax_sugar
+       << ';' << cfg->show_meta << ';' << cfg->show_object_address << ';'
+       << cfg->show_all_struct_info;
+    for (const String& name : cfg->binding_names) {
+      os << ';' << name;
+    }
+    return os.str();
+  }
+
+  bool Lookup(const ObjectRef& node, const std::string& fingerprint, std::string* script) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(Key{node.get(), fingerprint});
+    if (it == entries_.end()) {
+      return false;
+    }
+    *script = it->second.script;
+    return true;
+  }
+
+  void Insert(const ObjectRef& node, const std::string& fingerprint, const std::string& script) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key{node.get(), fingerprint};
+    if (entries_.count(key)) {
+      return;
+    }
+    // Bound both the entry count and the objects kept alive by eviction in
+    // insertion order.
+    if (insertion_order_.size() >= kMaxEntries) {
+      entries_.erase(insertion_order_.front());
+      insertion_order_.pop_front();
+    }
+    entries_.emplace(key, Entry{node, script});
+    insertion_order_.push_back(key);
+  }
+
+ private:
+  struct Key {
+    const Object* node;
+    std::string fingerprint;
+    bool operator==(const Key& other) const {
+      return node == other.node && fingerprint == other.fingerprint;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<const Object*>()(key.node) ^ (std::hash<std::string>()(key.fingerprint) * 3);
+    }
+  };
+  struct Entry {
+    ObjectRef node;  // keeps the keyed pointer valid
+    std::string script;
+  };
+
+  static constexpr size_t kMaxEntries = 256;
+  std::mutex mutex_;
+  std::unordered_map<Key, Entry, KeyHash> entries_;
+  std::deque<Key> insertion_order_;
+};
+
+}  // namespace
+
 std::string TVMScriptPrinter::Script(const ObjectRef& node, const Optional<PrinterConfig>& cfg) {
   if (!TVMScriptPrinter::vtable().can_dispatch(node)) {
     return AsLegacyRepr(node);
   }
-  return TVMScriptPrinter::vtable()(node, cfg.value_or(PrinterConfig()));
+  PrinterConfig config = cfg.value_or(PrinterConfig());
+  if (ScriptCache::Enabled() && node.defined() && ScriptCache::Cacheable(config)) {
+    std::string fingerprint = ScriptCache::ConfigFingerprint(config);
+    std::string script;
+    if (ScriptCache::Global()->Lookup(node, fingerprint, &script)) {
+      return script;
+    }
+    script = TVMScriptPrinter::vtable()(node, config);
+    ScriptCache::Global()->Insert(node, fingerprint, script);
+    return script;
+  }
+  return TVMScriptPrinter::vtable()(node, config);
 }
 
 bool IsIdentifier(const std::string& name) {
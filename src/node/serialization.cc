@@ -154,7 +154,7 @@ class NodeIndexer : public AttrVisitor {
     } else {
       // if the node already have repr bytes, no need to visit Attrs.
       if (!reflection_->GetReprBytes(node, nullptr)) {
-        reflection_->VisitAttrs(node, this);
+        reflection_->VisitAttrsFlat(node, this);
       }
     }
   }
@@ -302,7 +302,7 @@ class JSONAttrGetter : public AttrVisitor {
       }
     } else {
       // recursively index normal object.
-      reflection_->VisitAttrs(node, this);
+      reflection_->VisitAttrsFlat(node, this);
     }
   }
 };
@@ -355,7 +355,7 @@ class FieldDependencyFinder : public AttrVisitor {
       return;
     }
     jnode_ = jnode;
-    reflection_->VisitAttrs(node, this);
+    reflection_->VisitAttrsFlat(node, this);
   }
 };
 
@@ -464,7 +464,7 @@ class JSONAttrSetter : public AttrVisitor {
       return;
     }
     jnode_ = jnode;
-    reflection_->VisitAttrs(node->get(), this);
+    reflection_->VisitAttrsFlat(node->get(), this);
   }
 };
 
@@ -500,7 +500,13 @@ struct JSONGraph {
     helper.ReadAllFields(reader);
   }
 
-  static JSONGraph Create(const ObjectRef& root) {
+  /*!
+   * \brief Build the graph for the given root object.
+   * \param root The root object.
+   * \param raw_tensors When non-null, receives the indexed tensors for the
+   *  caller to serialize directly, and b64ndarrays is left empty.
+   */
+  static JSONGraph Create(const ObjectRef& root, std::vector<DLTensor*>* raw_tensors = nullptr) {
     JSONGraph g;
     NodeIndexer indexer;
     indexer.MakeIndex(const_cast<Object*>(root.get()));
@@ -515,6 +521,10 @@ struct JSONGraph {
     }
     g.attrs["tvm_version"] = TVM_VERSION;
     g.root = indexer.node_index_.at(const_cast<Object*>(root.get()));
+    if (raw_tensors != nullptr) {
+      *raw_tensors = indexer.tensor_list_;
+      return g;
+    }
     // serialize tensor
     for (DLTensor* tensor : indexer.tensor_list_) {
       std::string blob;
@@ -571,8 +581,41 @@ std::string SaveJSON(const ObjectRef& n) {
   return os.str();
 }
 
-ObjectRef LoadJSON(std::string json_str) {
+// Construct the object graph described by jgraph, with tensors giving the
+// decoded NDArray pool referenced from the node attributes.
+ObjectRef ConstructObjectGraph(JSONGraph* jgraph, std::vector<runtime::NDArray> tensors) {
   ReflectionVTable* reflection = ReflectionVTable::Global();
+  size_t n_nodes = jgraph->nodes.size();
+  // Pass 1: create all non-container objects
+  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    const JSONNode& jnode = jgraph->nodes[i];
+    if (jnode.type_key.length() != 0) {
+      nodes[i] = reflection->CreateInitObject(jnode.type_key, jnode.repr_bytes);
+    }
+  }
+  // Pass 2: figure out all field dependency
+  {
+    FieldDependencyFinder dep_finder;
+    for (size_t i = 0; i < n_nodes; ++i) {
+      dep_finder.Find(nodes[i].get(), &jgraph->nodes[i]);
+    }
+  }
+  // Pass 3: topo sort
+  std::vector<size_t> topo_order = jgraph->TopoSort();
+  // Pass 4: set all values
+  {
+    JSONAttrSetter setter;
+    setter.node_list_ = &nodes;
+    setter.tensor_list_ = &tensors;
+    for (size_t i : topo_order) {
+      setter.Set(&nodes[i], &jgraph->nodes[i]);
+    }
+  }
+  return ObjectRef(nodes.at(jgraph->root));
+}
+
+ObjectRef LoadJSON(std::string json_str) {
   JSONGraph jgraph;
   {
     // load in json graph.
@@ -580,7 +623,6 @@ ObjectRef LoadJSON(std::string json_str) {
     dmlc::JSONReader reader(&is);
     jgraph.Load(&reader);
   }
-  size_t n_nodes = jgraph.nodes.size();
   std::vector<runtime::NDArray> tensors;
   {
     // load in tensors
@@ -593,36 +635,128 @@ ObjectRef LoadJSON(std::string json_str) {
       tensors.emplace_back(std::move(temp));
     }
   }
-  // Pass 1: create all non-container objects
-  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
-  for (size_t i = 0; i < n_nodes; ++i) {
-    const JSONNode& jnode = jgraph.nodes[i];
-    if (jnode.type_key.length() != 0) {
-      nodes[i] = reflection->CreateInitObject(jnode.type_key, jnode.repr_bytes);
+  return ConstructObjectGraph(&jgraph, std::move(tensors));
+}
+
+// Magic number and version prefixing the binary object graph format.
+constexpr uint64_t kTVMObjectGraphBinaryMagic = 0x544D4F424A475248;
+constexpr uint32_t kTVMObjectGraphBinaryVersion = 1;
+
+std::string SaveBinary(const ObjectRef& n) {
+  std::vector<DLTensor*> tensors;
+  JSONGraph jgraph = JSONGraph::Create(n, &tensors);
+
+  // Intern type keys and attribute names so each unique string is stored
+  // once; large modules repeat the same handful of keys thousands of times.
+  std::unordered_map<std::string, uint32_t> string_index;
+  std::vector<std::string> string_table;
+  auto intern = [&](const std::string& s) -> uint32_t {
+    auto it = string_index.find(s);
+    if (it != string_index.end()) {
+      return it->second;
     }
-  }
-  // Pass 2: figure out all field dependency
-  {
-    FieldDependencyFinder dep_finder;
-    for (size_t i = 0; i < n_nodes; ++i) {
-      dep_finder.Find(nodes[i].get(), &jgraph.nodes[i]);
+    uint32_t id = static_cast<uint32_t>(string_table.size());
+    string_index.emplace(s, id);
+    string_table.push_back(s);
+    return id;
+  };
+  for (const JSONNode& jnode : jgraph.nodes) {
+    intern(jnode.type_key);
+    for (const auto& kv : jnode.attrs) {
+      intern(kv.first);
     }
   }
-  // Pass 3: topo sort
-  std::vector<size_t> topo_order = jgraph.TopoSort();
-  // Pass 4: set all values
-  {
-    JSONAttrSetter setter;
-    setter.node_list_ = &nodes;
-    setter.tensor_list_ = &tensors;
-    for (size_t i : topo_order) {
-      setter.Set(&nodes[i], &jgraph.nodes[i]);
-    }
+
+  std::string blob;
+  dmlc::MemoryStringStream mstrm(&blob);
+  dmlc::Stream* strm = &mstrm;
+  strm->Write(kTVMObjectGraphBinaryMagic);
+  strm->Write(kTVMObjectGraphBinaryVersion);
+  strm->Write(string_table);
+  strm->Write(jgraph.attrs);
+  strm->Write(static_cast<uint64_t>(jgraph.root));
+  strm->Write(static_cast<uint64_t>(jgraph.nodes.size()));
+  for (const JSONNode& jnode : jgraph.nodes) {
+    strm->Write(intern(jnode.type_key));
+    strm->Write(jnode.repr_bytes);
+    strm->Write(static_cast<uint32_t>(jnode.attrs.size()));
+    for (const auto& kv : jnode.attrs) {
+      strm->Write(intern(kv.first));
+      strm->Write(kv.second);
+    }
+    strm->Write(jnode.keys);
+    std::vector<uint64_t> data(jnode.data.begin(), jnode.data.end());
+    strm->Write(data);
+  }
+  // Tensor payloads are written in the raw DLTensor stream format rather
+  // than base64 text, so loading copies bytes instead of decoding them.
+  strm->Write(static_cast<uint64_t>(tensors.size()));
+  for (DLTensor* tensor : tensors) {
+    runtime::SaveDLTensor(strm, tensor);
   }
-  return ObjectRef(nodes.at(jgraph.root));
+  return blob;
+}
+
+ObjectRef LoadBinary(std::string bin) {
+  dmlc::MemoryStringStream mstrm(&bin);
+  dmlc::Stream* strm = &mstrm;
+  uint64_t magic = 0;
+  uint32_t version = 0;
+  ICHECK(strm->Read(&magic) && magic == kTVMObjectGraphBinaryMagic)
+      << "ValueError: the blob is not saved by SaveBinary";
+  ICHECK(strm->Read(&version) && version == kTVMObjectGraphBinaryVersion)
+      << "ValueError: binary object graph version mismatch";
+
+  std::vector<std::string> string_table;
+  ICHECK(strm->Read(&string_table));
+  JSONGraph jgraph;
+  ICHECK(strm->Read(&jgraph.attrs));
+  uint64_t root = 0;
+  uint64_t n_nodes = 0;
+  ICHECK(strm->Read(&root));
+  ICHECK(strm->Read(&n_nodes));
+  jgraph.root = static_cast<size_t>(root);
+  jgraph.nodes.resize(n_nodes);
+  for (JSONNode& jnode : jgraph.nodes) {
+    uint32_t type_key_id = 0;
+    ICHECK(strm->Read(&type_key_id));
+    jnode.type_key = string_table.at(type_key_id);
+    ICHECK(strm->Read(&jnode.repr_bytes));
+    uint32_t num_attrs = 0;
+    ICHECK(strm->Read(&num_attrs));
+    for (uint32_t i = 0; i < num_attrs; ++i) {
+      uint32_t key_id = 0;
+      std::string value;
+      ICHECK(strm->Read(&key_id));
+      ICHECK(strm->Read(&value));
+      jnode.attrs.emplace(string_table.at(key_id), std::move(value));
+    }
+    ICHECK(strm->Read(&jnode.keys));
+    std::vector<uint64_t> data;
+    ICHECK(strm->Read(&data));
+    jnode.data.assign(data.begin(), data.end());
+  }
+  uint64_t n_tensors = 0;
+  ICHECK(strm->Read(&n_tensors));
+  std::vector<runtime::NDArray> tensors;
+  tensors.reserve(n_tensors);
+  for (uint64_t i = 0; i < n_tensors; ++i) {
+    runtime::NDArray temp;
+    ICHECK(temp.Load(strm));
+    tensors.emplace_back(std::move(temp));
+  }
+  return ConstructObjectGraph(&jgraph, std::move(tensors));
 }
 
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body_typed([](const ObjectRef& n) -> runtime::String {
+  return SaveBinary(n);
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body_typed([](const runtime::String& blob) {
+  return LoadBinary(std::string(blob));
+});
 }  // namespace tvm
@@ -25,10 +25,14 @@
 #include <tvm/node/object_path.h>
 #include <tvm/node/reflection.h>
 #include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 
+#include <cstdint>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "ndarray_hash_equal.h"
 
@@ -581,6 +585,64 @@ bool StructuralEqual::operator()(const ObjectRef& lhs, const ObjectRef& rhs,
   return SEqualHandlerDefault(false, nullptr, false).Equal(lhs, rhs, map_free_params);
 }
 
+std::vector<size_t> StructuralDeduplicationGroups(const Array<ObjectRef>& objects,
+                                                  bool map_free_vars) {
+  int n = static_cast<int>(objects.size());
+  std::vector<size_t> repr(n);
+  if (n == 0) {
+    return repr;
+  }
+  // Step 1. Hash all objects in parallel. Each task owns its handler, and
+  // hashing only reads the object graphs, so no synchronization is needed.
+  std::vector<uint64_t> hashes(n);
+  support::parallel_for(0, n, [&](int i) {
+    hashes[i] = SHashHandlerDefault().Hash(objects[i], map_free_vars);
+  });
+  // Step 2. Bucket by hash. The original order is kept within each bucket so
+  // that the representative of every group is its first occurrence.
+  std::unordered_map<uint64_t, std::vector<int>> buckets;
+  for (int i = 0; i < n; ++i) {
+    buckets[hashes[i]].push_back(i);
+  }
+  std::vector<const std::vector<int>*> bucket_list;
+  bucket_list.reserve(buckets.size());
+  for (const auto& kv : buckets) {
+    bucket_list.push_back(&kv.second);
+  }
+  // Step 3. Confirm hash-colliding candidates with deep structural equality,
+  // one bucket per task. Buckets write disjoint entries of `repr`.
+  support::parallel_for(0, static_cast<int>(bucket_list.size()), [&](int b) {
+    const std::vector<int>& candidates = *bucket_list[b];
+    std::vector<int> representatives;
+    for (int i : candidates) {
+      size_t group = i;
+      for (int j : representatives) {
+        if (SEqualHandlerDefault(false, nullptr, false)
+                .Equal(objects[i], objects[j], map_free_vars)) {
+          group = j;
+          break;
+        }
+      }
+      if (group == static_cast<size_t>(i)) {
+        representatives.push_back(i);
+      }
+      repr[i] = group;
+    }
+  });
+  return repr;
+}
+
+TVM_REGISTER_GLOBAL("node.StructuralDeduplicationGroups")
+    .set_body_typed([](const Array<ObjectRef>& objects, bool map_free_vars) {
+      std::vector<size_t> groups = StructuralDeduplicationGroups(objects, map_free_vars);
+      Array<IntImm> result;
+      result.reserve(groups.size());
+      for (size_t group : groups) {
+        result.push_back(IntImm(DataType::Int(64), static_cast<int64_t>(group)));
+      }
+      return result;
+    });
+
 bool NDArrayEqual(const runtime::NDArray::Container* lhs, const runtime::NDArray::Container* rhs,
                   SEqualReducer equal, bool compare_data) {
   if (lhs == rhs) return true;
@@ -139,6 +139,14 @@ class SHashHandlerDefault::Impl {
     ICHECK_EQ(pending_tasks_.size(), 0U);
     ICHECK_EQ(result_stack_.size(), 0U);
 
+    // Reserve the traversal stacks up front; large modules push thousands of
+    // tasks and would otherwise regrow the vectors repeatedly.
+    if (task_stack_.capacity() == 0) {
+      task_stack_.reserve(kInitialStackSize);
+      pending_tasks_.reserve(kInitialStackSize);
+      result_stack_.reserve(kInitialStackSize);
+    }
+
     this->SHashReduce(object, map_free_vars);
     ICHECK_EQ(pending_tasks_.size(), 1U);
     ICHECK(allow_push_to_stack_);
@@ -245,6 +253,8 @@ class SHashHandlerDefault::Impl {
   uint32_t free_var_counter_{0};
   // graph node counter.
   uint32_t graph_node_counter_{0};
+  // initial capacity of the traversal stacks.
+  static constexpr size_t kInitialStackSize = 256;
   // record current stack top
   bool allow_push_to_stack_{true};
   // list of pending tasks to be pushed to the stack.
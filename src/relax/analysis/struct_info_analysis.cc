@@ -23,6 +23,7 @@
  *
  * \note Update this file when you added a new StructInfo.
  */
+#include <tvm/arith/analyzer.h>
 #include <tvm/relax/analysis.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/struct_info_functor.h>
@@ -1231,6 +1232,83 @@ TVM_REGISTER_GLOBAL("relax.analysis.TIRVarsInStructInfo").set_body_typed(TIRVars
 TVM_REGISTER_GLOBAL("relax.analysis.DefinableTIRVarsInStructInfo")
     .set_body_typed(DefinableTIRVarsInStructInfo);
 
+//--------------------------
+// DeriveSymbolicVarBounds
+//--------------------------
+
+namespace {
+
+void DeriveBoundFromPrimExpr(const PrimExpr& param_expr, const PrimExpr& arg_expr,
+                             arith::Analyzer* analyzer, Map<tir::Var, IntImm>* bounds) {
+  const auto* var = param_expr.as<tir::VarNode>();
+  if (var == nullptr) {
+    return;
+  }
+  int64_t max_value = analyzer->const_int_bound(arg_expr)->max_value;
+  if (max_value == arith::ConstIntBound::kPosInf) {
+    return;
+  }
+  tir::Var tir_var = GetRef<tir::Var>(var);
+  auto it = bounds->find(tir_var);
+  // Keep the loosest bound when a variable constrains several positions.
+  if (it == bounds->end() || (*it).second->value < max_value) {
+    bounds->Set(tir_var, IntImm(DataType::Int(64), max_value));
+  }
+}
+
+void DeriveBoundsFromStructInfo(const StructInfo& param_sinfo, const StructInfo& arg_sinfo,
+                                arith::Analyzer* analyzer, Map<tir::Var, IntImm>* bounds) {
+  if (const auto* param_tensor = param_sinfo.as<TensorStructInfoNode>()) {
+    const auto* arg_tensor = arg_sinfo.as<TensorStructInfoNode>();
+    if (arg_tensor == nullptr || !param_tensor->shape.defined() || !arg_tensor->shape.defined()) {
+      return;
+    }
+    const auto* param_shape = param_tensor->shape.value().as<ShapeExprNode>();
+    const auto* arg_shape = arg_tensor->shape.value().as<ShapeExprNode>();
+    if (param_shape == nullptr || arg_shape == nullptr ||
+        param_shape->values.size() != arg_shape->values.size()) {
+      return;
+    }
+    for (size_t i = 0; i < param_shape->values.size(); ++i) {
+      DeriveBoundFromPrimExpr(param_shape->values[i], arg_shape->values[i], analyzer, bounds);
+    }
+  } else if (const auto* param_shape = param_sinfo.as<ShapeStructInfoNode>()) {
+    const auto* arg_shape = arg_sinfo.as<ShapeStructInfoNode>();
+    if (arg_shape == nullptr || !param_shape->values.defined() || !arg_shape->values.defined() ||
+        param_shape->values.value().size() != arg_shape->values.value().size()) {
+      return;
+    }
+    for (size_t i = 0; i < param_shape->values.value().size(); ++i) {
+      DeriveBoundFromPrimExpr(param_shape->values.value()[i], arg_shape->values.value()[i],
+                              analyzer, bounds);
+    }
+  } else if (const auto* param_prim = param_sinfo.as<PrimStructInfoNode>()) {
+    const auto* arg_prim = arg_sinfo.as<PrimStructInfoNode>();
+    if (arg_prim == nullptr || !param_prim->value.defined() || !arg_prim->value.defined()) {
+      return;
+    }
+    DeriveBoundFromPrimExpr(param_prim->value.value(), arg_prim->value.value(), analyzer, bounds);
+  } else if (const auto* param_tuple = param_sinfo.as<TupleStructInfoNode>()) {
+    const auto* arg_tuple = arg_sinfo.as<TupleStructInfoNode>();
+    if (arg_tuple == nullptr || param_tuple->fields.size() != arg_tuple->fields.size()) {
+      return;
+    }
+    for (size_t i = 0; i < param_tuple->fields.size(); ++i) {
+      DeriveBoundsFromStructInfo(param_tuple->fields[i], arg_tuple->fields[i], analyzer, bounds);
+    }
+  }
+}
+
+}  // namespace
+
+Map<tir::Var, IntImm> DeriveSymbolicVarBounds(const StructInfo& param_sinfo,
+                                              const StructInfo& arg_sinfo,
+                                              arith::Analyzer* analyzer) {
+  Map<tir::Var, IntImm> bounds;
+  DeriveBoundsFromStructInfo(param_sinfo, arg_sinfo, analyzer, &bounds);
+  return bounds;
+}
+
 class NonNegativeExpressionCollector : relax::StructInfoVisitor {
  public:
   static Array<PrimExpr> Collect(const StructInfo& sinfo) {
@@ -20,10 +20,15 @@
 #include <tvm/meta_schedule/extracted_task.h>
 #include <tvm/relax/expr.h>
 #include <tvm/relax/expr_functor.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/target/target.h>
 #include <tvm/tir/function.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "../../meta_schedule/module_equality.h"
 
 namespace tvm {
@@ -31,9 +36,7 @@ namespace relax {
 namespace backend {
 
 using meta_schedule::ExtractedTask;
-using meta_schedule::ModuleEqual;
 using meta_schedule::ModuleEquality;
-using meta_schedule::ModuleHash;
 
 /*!
  * \brief Extract the Meta-Schedule tuning task from a given IRModule.
@@ -47,6 +50,10 @@ using meta_schedule::ModuleHash;
  *   `fn2` is called by 3 Call-TIR and `fn3` is called by 5 Call-TIR.
  *   Then we will have a ExtractedTask for all three functions, whose weight
  *   is 5 + 3 + 2 = 10.
+ *   3. The costly parts of extraction are per-callee and independent, so the
+ *   normalization, schedulability filtering, block counting and hashing of
+ *   each distinct callee run in parallel; only the cheap relax traversal and
+ *   the final hash-bucketed merge remain serial.
  */
 class BlockCounter : public tir::StmtVisitor {
  public:
@@ -64,31 +71,124 @@ class BlockCounter : public tir::StmtVisitor {
   size_t count{0};
 };
 
+/*! \brief The per-callee state filled in during extraction. */
+struct CalleeInfo {
+  /*! \brief The PrimFunc the call-tir ops refer to. */
+  tir::PrimFunc func;
+  /*! \brief The name of the first global var referring to the function. */
+  String task_name;
+  /*! \brief The number of call-tir ops referring to the function. */
+  int weight = 0;
+  /*! \brief The function wrapped as a `main`-only module, as the tuner expects. */
+  IRModule mod{nullptr};
+  /*! \brief The module hash under the requested module equality. */
+  size_t hash = 0;
+  /*! \brief The number of blocks, used to break ties between equal modules. */
+  size_t block_count = 0;
+  /*! \brief Whether there is anything for the tuner to schedule. */
+  bool schedulable = true;
+};
+
 class TaskExtractor : public ExprVisitor {
  public:
   static Array<ExtractedTask> ExtractTask(IRModule mod, Target target, String mod_eq_name) {
-    TaskExtractor extractor(mod, target, mod_eq_name);
-    // We go through each Relax function in the module.
+    std::unique_ptr<ModuleEquality> mod_eq = ModuleEquality::Create(mod_eq_name);
+
+    // Step 1. Traverse the Relax functions serially, collecting each distinct
+    // call-tir callee and its call count.  The traversal itself is cheap; the
+    // costly per-callee work is deferred to the parallel step below.
+    TaskExtractor extractor(mod);
     for (const auto& kv : mod->functions) {
       if (const auto* func = kv.second.as<FunctionNode>()) {
         extractor(GetRef<Function>(func));
       }
     }
-    Array<ExtractedTask> tasks;
-    for (const auto& it : extractor.func2task_) {
-      tasks.push_back(it.second);
+    std::vector<CalleeInfo>& callees = extractor.callees_;
+
+    // Step 2. Normalize, filter and hash every distinct callee in parallel.
+    // Trivially-unschedulable callees (no blocks to schedule, or already
+    // scheduled) are filtered out here, before any hashing happens.
+    support::parallel_for_dynamic(
+        0, callees.size(), std::thread::hardware_concurrency(), [&](int thread_id, int task_id) {
+          CalleeInfo& callee = callees[task_id];
+          callee.block_count = BlockCounter::GetBlockCount(callee.func);
+          if (callee.block_count == 0 ||
+              callee.func->HasNonzeroAttr(tir::attr::kIsScheduled)) {
+            callee.schedulable = false;
+            return;
+          }
+          callee.mod = NormalizeAsTask(callee.func);
+          callee.hash = mod_eq->Hash(callee.mod);
+        });
+
+    // Step 3. Merge the callees into tasks, bucketed by the precomputed hash
+    // and confirmed with the module equality.  Callees are visited in the
+    // first-seen order of Step 1, so the result is independent of the thread
+    // schedule above.
+    struct TaskSlot {
+      int callee;
+      size_t task_index;
+    };
+    std::unordered_map<size_t, std::vector<TaskSlot>> hash_buckets;
+    std::vector<ExtractedTask> tasks;
+    for (int i = 0; i < static_cast<int>(callees.size()); ++i) {
+      const CalleeInfo& callee = callees[i];
+      if (!callee.schedulable) {
+        continue;
+      }
+      std::vector<TaskSlot>& bucket = hash_buckets[callee.hash];
+      TaskSlot* slot = nullptr;
+      for (TaskSlot& candidate : bucket) {
+        if (mod_eq->Equal(callees[candidate.callee].mod, callee.mod)) {
+          slot = &candidate;
+          break;
+        }
+      }
+      if (slot == nullptr) {
+        bucket.push_back(TaskSlot{i, tasks.size()});
+        tasks.push_back(ExtractedTask(/*task_name=*/callee.task_name,  //
+                                      /*mod=*/callee.mod,              //
+                                      /*target=*/target,               //
+                                      /*dispatched=*/{callee.mod},     //
+                                      /*weight=*/callee.weight));
+        continue;
+      }
+      tasks[slot->task_index]->weight += callee.weight;
+      // When anchor-block based equality is used, tuning tasks "nn_conv2d_add_nn_relu" and
+      // "nn_conv2d_add_add_nn_relu", for example, can be identified as equal. Thus, one of them
+      // will be selected to tune by the code below.
+      //
+      // To make sure that we tune "nn_conv2d_add_nn_relu" and not "nn_conv2d_add_add_nn_relu", we
+      // count the PrinFunc number of blocks and leave only the function with the smallest number of
+      // blocks. This way, "nn_conv2d_add_nn_relu" will have a smaller number of blocks than
+      // "nn_conv2d_add_add_nn_relu" and will be selected to tune.
+      if (callee.block_count < callees[slot->callee].block_count) {
+        int weight = tasks[slot->task_index]->weight;
+        tasks[slot->task_index] = ExtractedTask(/*task_name=*/callee.task_name,  //
+                                                /*mod=*/callee.mod,              //
+                                                /*target=*/target,               //
+                                                /*dispatched=*/{callee.mod},     //
+                                                /*weight=*/weight);
+        slot->callee = i;
+      }
     }
-    return tasks;
+    return Array<ExtractedTask>(tasks.begin(), tasks.end());
   }
 
  private:
-  explicit TaskExtractor(IRModule mod, Target target, String mod_eq_name)
-      : mod_(std::move(mod)),
-        target_(std::move(target)),
-        mod_eq_(ModuleEquality::Create(mod_eq_name)),
-        func2task_(/*bucket_count*/ 0, ModuleHash(*mod_eq_), ModuleEqual(*mod_eq_)) {
-    normalize_mod_func_ = runtime::Registry::Get("tvm.meta_schedule.normalize_mod");
-    ICHECK(normalize_mod_func_) << "Normalization function is not found.";
+  explicit TaskExtractor(IRModule mod) : mod_(std::move(mod)) {}
+
+  /*!
+   * \brief Wrap a PrimFunc as a `main`-only IRModule, mirroring the python
+   *  helper `tvm.meta_schedule.normalize_mod`.  The python helper cannot be
+   *  invoked from the parallel step, so the PrimFunc case is replicated here.
+   */
+  static IRModule NormalizeAsTask(tir::PrimFunc func) {
+    if (!func->GetAttr<String>(tvm::attr::kGlobalSymbol).defined()) {
+      func = WithAttr(std::move(func), tvm::attr::kGlobalSymbol, String("main"));
+    }
+    func = WithAttr(std::move(func), tir::attr::kNoAlias, Bool(true));
+    return IRModule({{GlobalVar("main"), func}});
   }
 
   void VisitExpr_(const CallNode* call) final {
@@ -103,40 +203,22 @@ class TaskExtractor : public ExprVisitor {
     }
 
     const GlobalVar& global_var = Downcast<GlobalVar>(call->args[0]);
-    const tir::PrimFunc& func = Downcast<tir::PrimFunc>(mod_->Lookup(global_var));
-    IRModule mod = (*normalize_mod_func_)(func);
-    size_t weight = 1;
-    auto it = func2task_.find(mod);
-    if (it != func2task_.end()) {
-      it->second->weight += 1;
-      const tir::PrimFunc& alt_func = Downcast<tir::PrimFunc>(it->first->Lookup("main"));
-      // When anchor-block based equality is used, tuning tasks "nn_conv2d_add_nn_relu" and
-      // "nn_conv2d_add_add_nn_relu", for example, can be identified as equal. Thus, one of them
-      // will be selected to tune by the code below.
-      //
-      // To make sure that we tune "nn_conv2d_add_nn_relu" and not "nn_conv2d_add_add_nn_relu", we
-      // count the PrinFunc number of blocks and leave only the function with the smallest number of
-      // blocks. This way, "nn_conv2d_add_nn_relu" will have a smaller number of blocks than
-      // "nn_conv2d_add_add_nn_relu" and will be selected to tune.
-      if (BlockCounter::GetBlockCount(func) < BlockCounter::GetBlockCount(alt_func)) {
-        weight += it->second->weight;
-        func2task_.erase(it->first);
-      }
+    auto it = callee_index_.find(global_var.get());
+    if (it != callee_index_.end()) {
+      ++callees_[it->second].weight;
+      return;
     }
-
-    ExtractedTask task(/*task_name=*/global_var->name_hint,  //
-                       /*mod=*/mod,                          //
-                       /*target=*/target_,                   //
-                       /*dispatched=*/{mod},                 //
-                       /*weight=*/weight);
-    func2task_.emplace(mod, task);
+    CalleeInfo callee;
+    callee.func = Downcast<tir::PrimFunc>(mod_->Lookup(global_var));
+    callee.task_name = global_var->name_hint;
+    callee.weight = 1;
+    callee_index_.emplace(global_var.get(), callees_.size());
+    callees_.push_back(std::move(callee));
   }
 
   IRModule mod_;
-  Target target_;
-  std::unique_ptr<ModuleEquality> mod_eq_;
-  std::unordered_map<IRModule, ExtractedTask, ModuleHash, ModuleEqual> func2task_;
-  const runtime::PackedFunc* normalize_mod_func_;
+  std::unordered_map<const GlobalVarNode*, size_t> callee_index_;
+  std::vector<CalleeInfo> callees_;
 };
 
 TVM_REGISTER_GLOBAL("relax.backend.MetaScheduleExtractTask")
@@ -517,6 +517,25 @@ class BlockBuilderImpl : public BlockBuilderNode {
 
 // TODO(relax-team): Check normalize logic after struct info.
 
+// A Normalizer is created for every BlockBuilder, including the short-lived
+// ones used during struct info inference, so resolve the attr keys of its op
+// maps once and hand the dense tokens to GetAttrMap instead of hashing the
+// names per instance.
+static const OpAttrToken& InferStructInfoToken() {
+  static const OpAttrToken token("FInferStructInfo");
+  return token;
+}
+
+static const OpAttrToken& DistInferStructInfoToken() {
+  static const OpAttrToken token("dist.FInferStructInfo");
+  return token;
+}
+
+static const OpAttrToken& NormalizeToken() {
+  static const OpAttrToken token("FNormalize");
+  return token;
+}
+
 // Normalizer on struct info:
 //
 // We take benefit of the following invariants(that are checked in constructor):
@@ -1028,11 +1047,11 @@ class Normalizer : public BlockBuilderImpl, private ExprFunctor<Expr(const Expr&
 
   /*! \brief Operator struct info inference map. */
   tvm::OpAttrMap<FInferStructInfo> op_map_infer_struct_info_ =
-      Op::GetAttrMap<FInferStructInfo>("FInferStructInfo");
+      Op::GetAttrMap<FInferStructInfo>(InferStructInfoToken());
   tvm::OpAttrMap<FInferStructInfo> op_map_dist_infer_struct_info_ =
-      Op::GetAttrMap<FInferStructInfo>("dist.FInferStructInfo");
+      Op::GetAttrMap<FInferStructInfo>(DistInferStructInfoToken());
   /*! \brief Operator normalization function */
-  tvm::OpAttrMap<FNormalize> op_map_normalize_ = Op::GetAttrMap<FNormalize>("FNormalize");
+  tvm::OpAttrMap<FNormalize> op_map_normalize_ = Op::GetAttrMap<FNormalize>(NormalizeToken());
 
   /*! \brief Whether the FNormalize function should be applied */
   bool apply_f_normalize_{true};
@@ -199,6 +199,76 @@ IRModule BindParam(IRModule m, String func_name, Map<ObjectRef, ObjectRef> bind_
 
 TVM_REGISTER_GLOBAL("relax.FunctionBindParams").set_body_typed(FunctionBindParams);
 
+/*!
+ * \brief Bind params into a packing function and evaluate it ahead of time.
+ *
+ * Binds the given weights into \p func_name (typically the `transform_params`
+ * function produced by LiftTransformParams) and runs FoldConstant, so the
+ * layout/packing transforms execute now, at export time, instead of on every
+ * process start. The function's outputs must fold completely to constants;
+ * the packed tensors are returned in output order.
+ *
+ * \param mod The module containing the packing function.
+ * \param func_name The name of the packing function.
+ * \param params The weights to bind, in canonical layout.
+ * \return The packed weights, one per output of the packing function.
+ */
+Array<runtime::NDArray> PrepackParams(IRModule mod, String func_name,
+                                      Map<ObjectRef, ObjectRef> params) {
+  mod = BindParam(std::move(mod), func_name, params);
+  mod = transform::FoldConstant()(std::move(mod));
+
+  BaseFunc base_func = mod->Lookup(func_name);
+  const auto* func = base_func.as<FunctionNode>();
+  CHECK(func) << "PrepackParams: " << func_name << " is not a Relax function";
+
+  // Collect the bindings of the folded function so output vars can be chased
+  // back to the constants (or the tuple of constants) they are bound to.
+  std::unordered_map<const VarNode*, Expr> bindings;
+  Expr ret = func->body;
+  if (const auto* seq = ret.as<SeqExprNode>()) {
+    for (const BindingBlock& block : seq->blocks) {
+      for (const Binding& binding : block->bindings) {
+        if (const auto* var_binding = binding.as<VarBindingNode>()) {
+          bindings[var_binding->var.get()] = var_binding->value;
+        }
+      }
+    }
+    ret = seq->body;
+  }
+  auto resolve = [&](Expr expr) -> Expr {
+    while (const auto* var = expr.as<VarNode>()) {
+      auto it = bindings.find(var);
+      if (it == bindings.end()) break;
+      expr = it->second;
+    }
+    return expr;
+  };
+
+  ret = resolve(ret);
+  Array<Expr> outputs;
+  if (const auto* tuple = ret.as<TupleNode>()) {
+    outputs = tuple->fields;
+  } else {
+    outputs = {ret};
+  }
+
+  Array<runtime::NDArray> result;
+  result.reserve(outputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    Expr output = resolve(outputs[i]);
+    const auto* constant = output.as<ConstantNode>();
+    CHECK(constant) << "PrepackParams: output " << i << " of " << func_name
+                    << " did not fold to a constant. The packing transforms must be "
+                    << "evaluatable on the host; got residual expression of type "
+                    << output->GetTypeKey();
+    result.push_back(constant->data);
+  }
+  return result;
+}
+
+TVM_REGISTER_GLOBAL("relax.PrepackParams").set_body_typed(PrepackParams);
+
 namespace transform {
 
 Pass BindParams(String func_name, Map<ObjectRef, ObjectRef> params) {
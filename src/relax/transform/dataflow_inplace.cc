@@ -509,10 +509,23 @@ bool InplaceConditionsMet(
   }
 }
 
-// this is obviously not a complete list
-static std::unordered_set<std::string> SUPPORTED_OPS = {"relax.add",      "relax.subtract",
-                                                        "relax.multiply", "relax.divide",
-                                                        "relax.nn.silu",  "relax.nn.relu"};
+// Ops eligible for in-place rewriting. The criterion is that the final stage
+// of the legalized TIR reads its inputs only at the coordinates it writes
+// (reductions such as softmax/layer_norm stage their intermediate results in
+// separate buffers), so writing the result over a dead argument is safe.
+// This covers elementwise chains, residual adds, and normalization layers.
+static std::unordered_set<std::string> SUPPORTED_OPS = {
+    // binary elementwise (residual adds, gating products, ...)
+    "relax.add", "relax.subtract", "relax.multiply", "relax.divide", "relax.maximum",
+    "relax.minimum", "relax.power",
+    // unary elementwise
+    "relax.exp", "relax.negative", "relax.sqrt", "relax.rsqrt", "relax.square", "relax.sigmoid",
+    "relax.tanh", "relax.clip",
+    // activations
+    "relax.nn.relu", "relax.nn.silu", "relax.nn.gelu", "relax.nn.gelu_tanh",
+    // row-wise normalization; the elementwise final stage reads only the
+    // staged reduction buffers besides the input at the written coordinates
+    "relax.nn.softmax", "relax.nn.layer_norm", "relax.nn.rms_norm"};
 bool OpSupportsInplace(const Op& op) { return SUPPORTED_OPS.count(op->name); }
 
 /*! \brief Corresponds to a binding where at least one argument meets the conditions to be
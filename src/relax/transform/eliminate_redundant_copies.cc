@@ -0,0 +1,231 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/eliminate_redundant_copies.cc
+ * \brief Eliminate call_tir full-tensor copies whose source is never re-mutated.
+ *
+ * Exported models frequently contain copy/contiguous kernels, e.g. inserted by
+ * frontends around layout changes, which survive RewriteDataflowReshape when
+ * they are interleaved with other calls.  A call_tir whose PrimFunc only
+ * copies a single input into an identically shaped output produces a value
+ * that is interchangeable with its argument, provided nothing mutates the
+ * argument afterwards.  This pass rebinds such results directly to their
+ * source, so consumers alias the source buffer and the copy kernel becomes
+ * dead code.
+ *
+ * Mutation is conservative: arguments of call_tir_inplace at the in-place
+ * indices, and every tensor reachable from the arguments of a call whose
+ * callee is not a known-pure relax op, are treated as re-mutated and their
+ * copies are preserved.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/attrs/op.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/struct_info.h>
+#include <tvm/relax/transform.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/function.h>
+
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*! \brief The tensor arguments whose buffer the PrimFunc actually reads or writes. */
+std::vector<size_t> UsedTensorArgIndices(const tir::PrimFunc& fn, size_t num_args) {
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < num_args; ++i) {
+    if (auto buffer = fn->buffer_map.Get(fn->params[i])) {
+      auto buffer_var = buffer.value()->data;
+      if (tir::UsesVar(fn->body,
+                       [=](const tir::VarNode* var) { return var == buffer_var.get(); })) {
+        indices.push_back(i);
+      }
+    }
+  }
+  return indices;
+}
+
+/*!
+ * \brief Collect the relax vars whose backing tensor may be written after its
+ *   definition, so copies of them must be kept.
+ */
+class MutatedVarCollector : public ExprVisitor {
+ public:
+  static std::unordered_set<const VarNode*> Collect(const Function& func) {
+    MutatedVarCollector collector;
+    collector(func);
+    return std::move(collector.mutated_);
+  }
+
+ private:
+  void VisitExpr_(const CallNode* call) final {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    static const Op& call_tir_inplace_op = Op::Get("relax.call_tir_inplace");
+    static const Op& call_dps_packed_op = Op::Get("relax.call_dps_packed");
+    static const Op& call_pure_packed_op = Op::Get("relax.call_pure_packed");
+    static const Op& call_inplace_packed_op = Op::Get("relax.call_inplace_packed");
+    if (call->op.same_as(call_tir_inplace_op)) {
+      const auto* attrs = call->attrs.as<CallTIRInplaceAttrs>();
+      ICHECK(attrs) << "call_tir_inplace is missing its attributes";
+      Array<Expr> args = Downcast<Tuple>(call->args[1])->fields;
+      for (const Integer& index : attrs->inplace_indices) {
+        if (index->value >= 0) {
+          MarkMutated(args[index->value]);
+        }
+      }
+    } else if (call->op.same_as(call_dps_packed_op) || call->op.same_as(call_pure_packed_op) ||
+               call->op.same_as(call_inplace_packed_op)) {
+      // The callee is an opaque packed function that receives raw tensors and
+      // may scribble on them; treat every argument as mutated.
+      for (size_t i = 1; i < call->args.size(); ++i) {
+        MarkMutated(call->args[i]);
+      }
+    } else if (!call->op.same_as(call_tir_op) && !call->op->IsInstance<OpNode>()) {
+      // Calls to extern funcs, closures or other functions may capture and
+      // write their tensor arguments; treat every argument as mutated.
+      for (const Expr& arg : call->args) {
+        MarkMutated(arg);
+      }
+    }
+    ExprVisitor::VisitExpr_(call);
+  }
+
+  void MarkMutated(const Expr& expr) {
+    if (const auto* var = expr.as<VarNode>()) {
+      mutated_.insert(var);
+    } else if (const auto* tuple = expr.as<TupleNode>()) {
+      for (const Expr& field : tuple->fields) {
+        MarkMutated(field);
+      }
+    }
+  }
+
+  std::unordered_set<const VarNode*> mutated_;
+};
+
+class RedundantCopyEliminator : public ExprMutator {
+ public:
+  RedundantCopyEliminator(const IRModule& mod, std::unordered_set<const VarNode*> mutated)
+      : mod_(mod), mutated_(std::move(mutated)) {}
+
+ private:
+  using ExprMutator::VisitExpr_;
+
+  BindingBlock VisitBindingBlock(const BindingBlock& block) final {
+    // Aliasing is only applied inside dataflow blocks, whose bindings are
+    // guaranteed to be side-effect free between definition and use.
+    if (const auto* dataflow_block = block.as<DataflowBlockNode>()) {
+      return VisitBindingBlock_(dataflow_block);
+    } else {
+      return block;
+    }
+  }
+
+  Expr VisitExpr_(const CallNode* call) final {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    if (call->op != call_tir_op) {
+      return GetRef<Call>(call);
+    }
+
+    auto prim_fn = Downcast<tir::PrimFunc>(mod_->Lookup(Downcast<GlobalVar>(call->args[0])));
+    auto arg_tuple = Downcast<Tuple>(call->args[1])->fields;
+    auto used_tensor_arg_indices = UsedTensorArgIndices(prim_fn, arg_tuple.size());
+    if (used_tensor_arg_indices.size() != 1) {
+      return GetRef<Call>(call);
+    }
+
+    Expr arg = arg_tuple[used_tensor_arg_indices[0]];
+    const auto* arg_var = arg.as<VarNode>();
+    if (arg_var == nullptr || mutated_.count(arg_var)) {
+      return GetRef<Call>(call);
+    }
+    if (!IsFullTensorCopy(prim_fn, call, arg)) {
+      return GetRef<Call>(call);
+    }
+    // Rebind the copy result to its source.  The binding is a zero-cost
+    // register alias in the VM, and the copy kernel becomes dead code.
+    return arg;
+  }
+
+  /*!
+   * \brief Whether the call copies its single input into an identically
+   *   shaped output, element for element.
+   */
+  bool IsFullTensorCopy(const tir::PrimFunc& prim_fn, const CallNode* call, const Expr& inp) {
+    if (!HasReshapePattern(prim_fn)) {
+      return false;
+    }
+    ICHECK(inp->struct_info_.defined() && call->struct_info_.defined());
+    const auto* inp_sinfo = inp->struct_info_.as<TensorStructInfoNode>();
+    const auto* res_sinfo = call->struct_info_.as<TensorStructInfoNode>();
+    if (inp_sinfo == nullptr || res_sinfo == nullptr) {
+      return false;
+    }
+    if (inp_sinfo->IsUnknownDtype() || inp_sinfo->dtype != res_sinfo->dtype) {
+      return false;
+    }
+    // Unlike RewriteDataflowReshape, only the exact-same-shape case is an
+    // alias; an actual reshape must keep producing a new view.
+    auto inp_shape = inp_sinfo->GetShape();
+    auto res_shape = res_sinfo->GetShape();
+    if (!inp_shape.defined() || !res_shape.defined() ||
+        inp_shape.value().size() != res_shape.value().size()) {
+      return false;
+    }
+    arith::Analyzer analyzer;
+    for (size_t i = 0; i < inp_shape.value().size(); ++i) {
+      if (!analyzer.CanProveEqual(inp_shape.value()[i], res_shape.value()[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const IRModule& mod_;
+  std::unordered_set<const VarNode*> mutated_;
+};
+
+}  // namespace
+
+Expr EliminateRedundantCopies(const Function& f, const IRModule& mod) {
+  return RedundantCopyEliminator(mod, MutatedVarCollector::Collect(f))(f);
+}
+
+namespace transform {
+
+Pass EliminateRedundantCopies() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(EliminateRedundantCopies(f, m));
+      };
+  return CreateFunctionPass(pass_func, 0, "EliminateRedundantCopies", {});
+}
+
+TVM_REGISTER_GLOBAL("relax.transform.EliminateRedundantCopies")
+    .set_body_typed(EliminateRedundantCopies);
+
+}  // namespace transform
+
+}  // namespace relax
+}  // namespace tvm
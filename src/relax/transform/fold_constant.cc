@@ -24,22 +24,191 @@
 #include <tvm/relax/op_attr_types.h>
 #include <tvm/relax/transform.h>
 #include <tvm/relax/type.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace relax {
 
+/*!
+ * \brief Batched constant-evaluation engine shared across the functions of a module.
+ *
+ * Builds of structurally identical PrimFuncs and evaluations of identical
+ * (function, arguments) pairs are memoized for the whole pass run rather than
+ * per Relax function. Evaluations are not executed inline: each foldable
+ * call is queued and its (already allocated) output tensor is returned
+ * immediately, so independent bindings - e.g. thousands of per-weight
+ * transforms - accumulate and then run in parallel in a single Flush. A
+ * queued output that is consumed by a later foldable call (or read directly,
+ * as in tensor_to_shape) forces a flush first, so chained folds stay correct.
+ */
+class ConstantEvalEngine {
+ public:
+  /*!
+   * \brief Get a cached build version of func
+   * \return The cached func, nullopt if func cannot be built.
+   */
+  Optional<runtime::PackedFunc> GetCachedBuild(tir::PrimFunc func) {
+    // TODO(tvm-team): consider another way of bulk extract and build PrimFunc once
+    // would be helpful for future cases where PrimFunc recursively call into each other
+    Target eval_cpu_target{"llvm"};
+
+    auto it = func_build_cache_.find(func);
+    if (it != func_build_cache_.end()) {
+      return it->second;
+    }
+    Optional<runtime::PackedFunc> build_func = NullOpt;
+
+    try {
+      // Not all the primfunc can be directly built via llvm, for example, if a function is
+      // already scheduled to only work on GPU, we will need to skip this in the const folder for
+      // now
+      // TODO(Hongyi): further check and narrow the scope of foldable function
+      runtime::Module rt_module =
+          build(LowerPrimFunc(func, "tir_function"), eval_cpu_target, eval_cpu_target);
+      build_func = rt_module.GetFunction("tir_function");
+    } catch (const tvm::Error& err) {
+      // build failure may happen in which case we skip
+      DLOG(WARNING) << "Build failure for function " << func << ", Error message: " << err.what();
+    }
+    func_build_cache_[func] = build_func;
+    return build_func;
+  }
+
+  /*!
+   * \brief Queue the constant evaluation of a call_tir and return its output tensor.
+   * \return The constant holding the (possibly still pending) result, or nullopt if
+   *         the function cannot be built.
+   */
+  Optional<Expr> Evaluate(tir::PrimFunc tir_func, Array<runtime::NDArray> arr_args,
+                          runtime::ShapeTuple shape, DataType ret_type) {
+    // Inputs still being produced by queued evaluations must be materialized first.
+    for (const auto& arg : arr_args) {
+      if (pending_outputs_.count(arg->data)) {
+        Flush();
+        break;
+      }
+    }
+
+    // Identical subgraphs fold to the same tensor.
+    std::vector<EvalRecord>& records = eval_memo_[tir_func];
+    for (const EvalRecord& record : records) {
+      if (RecordMatches(record, arr_args, shape, ret_type)) {
+        return record.result;
+      }
+    }
+
+    Optional<runtime::PackedFunc> func = GetCachedBuild(tir_func);
+    if (!func) return NullOpt;
+
+    DLDevice cpu_dev = {DLDeviceType::kDLCPU, 0};
+    runtime::NDArray ret_tensor = runtime::NDArray::Empty(shape, ret_type, cpu_dev);
+
+    runtime::PackedFunc f = func.value();
+    tasks_.emplace_back([f, arr_args, ret_tensor]() mutable {
+      // here the vector size has an additional + 1 because we need to put ret_tensor at the end
+      std::vector<TVMValue> values(arr_args.size() + 1);
+      std::vector<int> type_codes(arr_args.size() + 1);
+
+      // avoid set rvalue ref which get de-allocated later, store args in a vector
+      // where temp_args[i] are lvalue ref that is stable
+      std::vector<runtime::NDArray> temp_args(arr_args.begin(), arr_args.end());
+
+      size_t arg_offset = 0;
+      for (; arg_offset < temp_args.size(); ++arg_offset) {
+        runtime::TVMArgsSetter(values.data(), type_codes.data())(arg_offset,
+                                                                 temp_args[arg_offset]);
+      }
+      // set return value
+      runtime::TVMArgsSetter(values.data(), type_codes.data())(arg_offset++, ret_tensor);
+
+      TVMRetValue ret;
+      // invoke
+      f.CallPacked(TVMArgs(values.data(), type_codes.data(), values.size()), &ret);
+    });
+    pending_outputs_.insert(ret_tensor->data);
+
+    Constant result(ret_tensor);
+    records.push_back(EvalRecord{std::move(arr_args), std::move(shape), ret_type, result});
+    return result;
+  }
+
+  /*! \brief Materialize \p arr if it is the output of a queued evaluation. */
+  void WaitFor(const runtime::NDArray& arr) {
+    if (pending_outputs_.count(arr->data)) {
+      Flush();
+    }
+  }
+
+  /*! \brief Run all queued evaluations, in parallel when there is more than one. */
+  void Flush() {
+    if (tasks_.empty()) return;
+    if (tasks_.size() == 1) {
+      tasks_[0]();
+    } else {
+      support::parallel_for(0, static_cast<int>(tasks_.size()), [this](int i) { tasks_[i](); });
+    }
+    tasks_.clear();
+    pending_outputs_.clear();
+  }
+
+ private:
+  /*! \brief One memoized evaluation of a PrimFunc over constant arguments. */
+  struct EvalRecord {
+    Array<runtime::NDArray> args;
+    runtime::ShapeTuple shape;
+    DataType dtype;
+    Constant result;
+  };
+
+  static bool RecordMatches(const EvalRecord& record, const Array<runtime::NDArray>& args,
+                            const runtime::ShapeTuple& shape, DataType dtype) {
+    if (record.dtype != dtype || record.args.size() != args.size() ||
+        record.shape.size() != shape.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < shape.size(); ++i) {
+      if (record.shape[i] != shape[i]) return false;
+    }
+    for (size_t i = 0; i < args.size(); ++i) {
+      // Argument identity: shared Constant nodes reuse the same NDArray.
+      if (!record.args[i].same_as(args[i])) return false;
+    }
+    return true;
+  }
+
+  // cache for function build, via structural equality
+  std::unordered_map<tir::PrimFunc, Optional<runtime::PackedFunc>, StructuralHash, StructuralEqual>
+      func_build_cache_;
+  // memoized evaluations, grouped by structurally equal PrimFunc
+  std::unordered_map<tir::PrimFunc, std::vector<EvalRecord>, StructuralHash, StructuralEqual>
+      eval_memo_;
+  // queued evaluations and the data pointers of their not-yet-materialized outputs
+  std::vector<std::function<void()>> tasks_;
+  std::unordered_set<const void*> pending_outputs_;
+};
+
 class ConstantFolder : public ExprMutator {
  public:
-  static Function Fold(Function func, IRModule ctx_module) {
-    ConstantFolder folder(std::move(ctx_module));
+  static Function Fold(Function func, IRModule ctx_module, ConstantEvalEngine* engine) {
+    ConstantFolder folder(std::move(ctx_module), engine);
     func = Downcast<Function>(RemoveAllUnused(folder(func)));
+    // Materialize any evaluations still in flight before the result escapes.
+    engine->Flush();
     return func;
   }
 
  private:
-  explicit ConstantFolder(IRModule ctx_module) : ExprMutator(ctx_module) {}
+  explicit ConstantFolder(IRModule ctx_module, ConstantEvalEngine* engine)
+      : ExprMutator(ctx_module), engine_(engine) {}
 
   /*!
    * \brief Pattern match the shape inside the given struct info to a
@@ -96,37 +265,6 @@ class ConstantFolder : public ExprMutator {
     return NullOpt;
   }
 
-  /*!
-   * \brief Get a cached build version of func
-   * \return The cached func, nullopt if func cannot be built.
-   */
-  Optional<PackedFunc> GetCachedBuild(tir::PrimFunc func) {
-    // TODO(tvm-team): consider another way of bulk extract and build PrimFunc once
-    // would be helpful for future cases where PrimFunc recursively call into each other
-    Target eval_cpu_target{"llvm"};
-
-    auto it = func_build_cache_.find(func);
-    if (it != func_build_cache_.end()) {
-      return it->second;
-    }
-    Optional<PackedFunc> build_func = NullOpt;
-
-    try {
-      // Not all the primfunc can be directly built via llvm, for example, if a function is
-      // already scheduled to only work on GPU, we will need to skip this in the const folder for
-      // now
-      // TODO(Hongyi): further check and narrow the scope of foldable function
-      runtime::Module rt_module =
-          build(LowerPrimFunc(func, "tir_function"), eval_cpu_target, eval_cpu_target);
-      build_func = rt_module.GetFunction("tir_function");
-    } catch (const tvm::Error& err) {
-      // build failure may happen in which case we skip
-      DLOG(WARNING) << "Build failure for function " << func << ", Error message: " << err.what();
-    }
-    func_build_cache_[func] = build_func;
-    return build_func;
-  }
-
   /*!
    * \brief Checks if it is useful to fold \p expr.
    * \details Folding an expr is a trade-off - we are materializing a constant in the IRModule and
@@ -140,38 +278,6 @@ class ConstantFolder : public ExprMutator {
     return true;
   }
 
-  // Try constant evaluate the function call
-  // if failed return NullOpt
-  Optional<Expr> ConstEvaluateCallTIR(tir::PrimFunc tir_func, Array<runtime::NDArray> arr_args,
-                                      runtime::ShapeTuple shape, DataType ret_type) {
-    // obtain function from the cache.
-    Optional<PackedFunc> func = GetCachedBuild(tir_func);
-    if (!func) return NullOpt;
-
-    // here the vector size has an additional + 1 because we need to put ret_tensor at the end
-    std::vector<TVMValue> values(arr_args.size() + 1);
-    std::vector<int> type_codes(arr_args.size() + 1);
-
-    DLDevice cpu_dev = {DLDeviceType::kDLCPU, 0};
-    runtime::NDArray ret_tensor = runtime::NDArray::Empty(shape, ret_type, cpu_dev);
-
-    // avoid set rvalue ref which get de-allocated later, store args in a vector
-    // where temp_args[i] are lvalue ref that is stable
-    std::vector<runtime::NDArray> temp_args(arr_args.begin(), arr_args.end());
-
-    size_t arg_offset = 0;
-    for (; arg_offset < arr_args.size(); ++arg_offset) {
-      runtime::TVMArgsSetter(values.data(), type_codes.data())(arg_offset, temp_args[arg_offset]);
-    }
-    // set return value
-    runtime::TVMArgsSetter(values.data(), type_codes.data())(arg_offset++, ret_tensor);
-
-    TVMRetValue ret;
-    // invoke
-    func.value().CallPacked(TVMArgs(values.data(), type_codes.data(), values.size()), &ret);
-    return Constant(ret_tensor);
-  }
-
   // Returns the folded expr if the call is successfully folded to constant, otherwise null.
   Optional<Expr> VisitCallTIR(Call call) {
     // call_tir needs to have at least three arguments
@@ -187,7 +293,7 @@ class ConstantFolder : public ExprMutator {
     if (func && arr_args && shape && output_not_tuple) {
       DynTensorType ret_type = Downcast<DynTensorType>(call->checked_type());
       // value_or will return value if it is not null, otherwise return or
-      return ConstEvaluateCallTIR(func.value(), arr_args.value(), shape.value(), ret_type->dtype)
+      return engine_->Evaluate(func.value(), arr_args.value(), shape.value(), ret_type->dtype)
           .value_or({});
     }
     // TODO(hongyi): support const-fold tuple outputs
@@ -268,6 +374,8 @@ class ConstantFolder : public ExprMutator {
         if (arg->IsInstance<ConstantNode>()) {
           Constant constant = Downcast<Constant>(arg);
           runtime::NDArray ndarray = constant->data;
+          // The data is read below; a queued evaluation may still be producing it.
+          engine_->WaitFor(ndarray);
           ICHECK_EQ(ndarray->device.device_type, kDLCPU);
           ICHECK(ndarray->strides == nullptr);
           ICHECK_EQ(ndarray->byte_offset, 0);
@@ -314,16 +422,18 @@ class ConstantFolder : public ExprMutator {
     return ExprMutator::VisitExpr_(op);
   }
 
-  // cache for function build, via structural equality
-  std::unordered_map<tir::PrimFunc, Optional<runtime::PackedFunc>, StructuralHash, StructuralEqual>
-      func_build_cache_;
+  // the evaluation engine shared across all functions of the pass run
+  ConstantEvalEngine* engine_;
 };
 
 namespace transform {
 
 Pass FoldConstant() {
+  auto engine = std::make_shared<ConstantEvalEngine>();
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
-      [=](Function f, IRModule m, PassContext pc) { return ConstantFolder::Fold(f, m); };
+      [=](Function f, IRModule m, PassContext pc) {
+        return ConstantFolder::Fold(f, m, engine.get());
+      };
   return CreateFunctionPass(pass_func, 0, "FoldConstant", {});
 }
 
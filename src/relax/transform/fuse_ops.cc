@@ -27,6 +27,7 @@
  * A follow-up pass named "FuseTIR" will generate a TIR PrimFunc for each grouped function.
  */
 
+#include <tvm/arith/analyzer.h>
 #include <tvm/relax/analysis.h>
 #include <tvm/relax/dataflow_matcher.h>
 #include <tvm/relax/dataflow_pattern.h>
@@ -158,7 +159,24 @@ class GraphCreator : public ExprVisitor {
 
   void VisitBinding_(const MatchCastNode* binding) final {
     IndexedForwardGraph::Node* node = CreateNode(binding->var.get());
-    SetNodePattern(node, OpPatternKind::kOpaque);
+    if (!binding->var->IsInstance<DataflowVarNode>()) {
+      this->MarkAsExternRef(node);
+    }
+    // A match_cast whose target struct info is provably implied by the struct info of its input
+    // value is a pure re-assertion: it binds no new symbolic variable and always succeeds at
+    // runtime. Such casts frequently sit between operators in functions with symbolic shapes
+    // (e.g. re-asserting a `(n, 4096)` tensor shape), and treating them as opaque would break
+    // every fusion group they appear in. We let them flow through fusion like an elementwise
+    // operation instead. Casts that may fail at runtime or that bind new symbolic variables
+    // remain opaque fusion boundaries, as the variables they introduce must stay visible
+    // outside any fused function.
+    if (binding->value->struct_info_.defined() &&
+        IsBaseOf(binding->struct_info, GetStructInfo(binding->value), &analyzer_)) {
+      SetNodePattern(node, OpPatternKind::kElemWise);
+      VisitLeaf(binding->value, node, OpPatternKind::kElemWise);
+    } else {
+      SetNodePattern(node, OpPatternKind::kOpaque);
+    }
     AddToPostDFSOrder(node, binding->var.get());
   }
 
@@ -369,6 +387,8 @@ class GraphCreator : public ExprVisitor {
   std::unordered_set<IndexedForwardGraph::Node*> initialized_nodes_;
   /*! \brief The model params in the function input */
   std::unordered_set<const VarNode*> input_params_;
+  /*! \brief The analyzer used to prove symbolic shape equalities for match_cast bindings */
+  arith::Analyzer analyzer_;
 };
 
 /*!
@@ -393,7 +413,9 @@ class FunctionCreator : public ExprMutator {
    *  - VarBinding with value being a call node calling `relax.call_tir` or
    *    `relax.call_tir_inplace`.
    *  - VarBinding with value being a tuple-get-item node.
-   * // TODO(tvm-team): handle match shape
+   *  - MatchCast whose target struct info is provably implied by the struct info of its value
+   *    (such casts are admitted into fusion groups by GraphCreator and elided when the fused
+   *    function is emitted).
    */
   void AppendBinding(const Binding& binding) {
     ICHECK(!function_.defined())
@@ -450,7 +472,16 @@ class FunctionCreator : public ExprMutator {
         AppendOutput(var_binding->var);
       }
     } else {
-      // TODO(tvm-team): handle match_cast
+      const auto* match_cast = binding.as<MatchCastNode>();
+      ICHECK_NOTNULL(match_cast);
+      CheckDefAndUpdateParam(match_cast->value);
+
+      // Mark the binding variable as defined.
+      defined_vars_.insert(match_cast->var.get());
+      // Set var as output true if the binding is not a dataflow variable
+      if (!match_cast->var->IsInstance<DataflowVarNode>()) {
+        AppendOutput(match_cast->var);
+      }
     }
     bindings_.push_back(binding);
   }
@@ -521,6 +552,25 @@ class FunctionCreator : public ExprMutator {
         }
       }
 
+      // A match_cast admitted into a group is provably redundant (see GraphCreator): its
+      // target struct info is implied by the struct info of its input. Elide it and forward
+      // the input instead of re-emitting the cast, as FuseTIR does not support match_cast
+      // inside the primitive functions created here.
+      if (const auto* match_cast = binding.as<MatchCastNode>()) {
+        Expr new_value = VisitExpr(match_cast->value);
+        if (!new_value->IsInstance<VarNode>()) {
+          new_value = builder_->Emit(new_value);
+        }
+        Var new_var = Downcast<Var>(new_value);
+        var_remap_[match_cast->var->vid] = new_var;
+        if (auto output_idx = GetOutputIndex(binding->var)) {
+          Var output_var = builder_->EmitOutput(new_var);
+          var_remap_[match_cast->var->vid] = output_var;
+          outputs.Set(*output_idx, output_var);
+        }
+        continue;
+      }
+
       if (auto output_idx = GetOutputIndex(binding->var)) {
         // Case 1. It is an output binding
         // We only allow VarBinding as output.
@@ -835,10 +885,6 @@ class OperatorFusor : public ExprMutator {
       }
 
       // Case 3. The binding is the last binding of the group.
-      const auto* var_binding = binding.as<VarBindingNode>();
-      ICHECK(var_binding != nullptr) << "The last binding of a group whose size is larger than 1 "
-                                        "is supposed to be a variable binding";
-
       // Step a. Add the grouped function to the IRModule
       GlobalVar gv = builder_->AddFunction(func, func_info.name_hint_);
 
@@ -848,7 +894,7 @@ class OperatorFusor : public ExprMutator {
       Var new_var;
       Call call_to_emit = Call(gv, UpdateArgs(func_info.arguments_));
 
-      if (var_binding->var->IsInstance<DataflowVarNode>()) {
+      if (binding->var->IsInstance<DataflowVarNode>()) {
         new_var = builder_->Emit(call_to_emit);
       } else {
         new_var = builder_->EmitOutput(call_to_emit);
@@ -865,7 +911,7 @@ class OperatorFusor : public ExprMutator {
           var_remap_[var->vid] = builder_->Emit(tuple_get);
         }
       } else {
-        var_remap_[var_binding->var->vid] = new_var;
+        var_remap_[binding->var->vid] = new_var;
       }
     }
     // Step 5. Finish the binding block generation.
@@ -1054,6 +1100,91 @@ IRModule MakeGroupedFunctions(
   return OperatorFusor(mod, partition, lift_constants).Transform(entry_function_names);
 }
 
+/*!
+ * \brief Discriminator compiled from the root of a fusion pattern.
+ *
+ * The dataflow matcher is a backtracking matcher, and running it from every call site for every
+ * registered pattern makes BYOC partitioning quadratic in patterns x bindings. Most patterns can
+ * only anchor on calls to a small, statically known set of operators, so we pre-compile that set
+ * (op name plus minimum arity) by walking the pattern once. At match time a hash lookup on the
+ * call's op rejects infeasible roots before the matcher is ever invoked, which makes one traversal
+ * of the dataflow graph sufficient to discriminate between all registered patterns.
+ *
+ * The discriminator is conservative: any pattern whose root cannot be resolved to concrete
+ * operators (e.g. a wildcard or function-valued callee) is treated as matching every root, and
+ * feasible candidates are still handed to the full matcher.
+ */
+class PatternRootDiscriminator {
+ public:
+  explicit PatternRootDiscriminator(const DFPattern& pattern) { CollectRoots(pattern); }
+
+  /*! \brief Quickly decide whether the pattern could possibly match with \p call as its root. */
+  bool CanMatchRoot(const CallNode* call) const {
+    if (unconstrained_) {
+      return true;
+    }
+    const auto* op = call->op.as<OpNode>();
+    if (op == nullptr) {
+      return false;
+    }
+    auto it = root_ops_.find(op->name);
+    return it != root_ops_.end() && call->args.size() >= it->second;
+  }
+
+ private:
+  void CollectRoots(const DFPattern& pattern) {
+    if (const auto* call = pattern.as<CallPatternNode>()) {
+      CollectCallee(call->op, call->args.size());
+    } else if (const auto* or_pat = pattern.as<OrPatternNode>()) {
+      CollectRoots(or_pat->left);
+      CollectRoots(or_pat->right);
+    } else if (const auto* and_pat = pattern.as<AndPatternNode>()) {
+      // A match of the conjunction is in particular a match of the left branch, so the left
+      // branch's roots over-approximate the conjunction's roots.
+      CollectRoots(and_pat->left);
+    } else if (const auto* type_pat = pattern.as<TypePatternNode>()) {
+      CollectRoots(type_pat->pattern);
+    } else if (const auto* sinfo_pat = pattern.as<StructInfoPatternNode>()) {
+      CollectRoots(sinfo_pat->pattern);
+    } else if (const auto* shape_pat = pattern.as<ShapePatternNode>()) {
+      CollectRoots(shape_pat->pattern);
+    } else if (const auto* dtype_pat = pattern.as<DataTypePatternNode>()) {
+      CollectRoots(dtype_pat->pattern);
+    } else if (const auto* attr_pat = pattern.as<AttrPatternNode>()) {
+      CollectRoots(attr_pat->pattern);
+    } else {
+      // The root is not statically resolvable to a set of operators; fall back to invoking the
+      // matcher at every call site.
+      unconstrained_ = true;
+    }
+  }
+
+  void CollectCallee(const DFPattern& callee_pattern, size_t num_args) {
+    if (const auto* expr_pat = callee_pattern.as<ExprPatternNode>()) {
+      if (const auto* op = expr_pat->expr.as<OpNode>()) {
+        // The matcher pads missing args with wildcards when varg_default_wildcard is set, so the
+        // pattern arity is a lower bound on the call arity in either case. Keep the smallest
+        // bound when the same op anchors several alternatives.
+        auto it = root_ops_.find(op->name);
+        if (it == root_ops_.end() || num_args < it->second) {
+          root_ops_[op->name] = num_args;
+        }
+        return;
+      }
+    } else if (const auto* or_pat = callee_pattern.as<OrPatternNode>()) {
+      CollectCallee(or_pat->left, num_args);
+      CollectCallee(or_pat->right, num_args);
+      return;
+    }
+    unconstrained_ = true;
+  }
+
+  /*! \brief Map from feasible root op name to the minimum call arity for that op. */
+  std::unordered_map<String, size_t> root_ops_;
+  /*! \brief True if some alternative's root could not be resolved to concrete ops. */
+  bool unconstrained_{false};
+};
+
 /*! \brief Create a "partitioning", a map from interior / leaf expr to its representative group,
  * based on the provided pattern. The result can be passed to OperatorFusor above to fuse operations
  * in a group and create a grouped function.
@@ -1084,7 +1215,8 @@ class PatternBasedPartitioner : ExprVisitor {
         annotation_pat_(annotation_patterns),
         check_(check),
         arena_(arena),
-        attrs_getter_(attrs_getter) {}
+        attrs_getter_(attrs_getter),
+        root_discriminator_(pattern) {}
 
   void VisitBindingBlock_(const DataflowBlockNode* block) final {
     current_block_use_def_ = DataflowBlockUseDef(GetRef<DataflowBlock>(block));
@@ -1108,6 +1240,9 @@ class PatternBasedPartitioner : ExprVisitor {
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     VisitVarDef(binding->var);
+    if (!root_discriminator_.CanMatchRoot(call)) {
+      return;
+    }
     if (auto matches_opt = ExtractMatchedExpr(pat_, GetRef<Call>(call), bindings_)) {
       const auto& context = CreatePatternCheckContext(call, matches_opt.value());
       if (check_ != nullptr && !check_(context)) {
@@ -1232,6 +1367,7 @@ class PatternBasedPartitioner : ExprVisitor {
   FCheckMatch check_;
   support::Arena* arena_;
   FAttrsGetter attrs_getter_;
+  PatternRootDiscriminator root_discriminator_;
   Map<Var, Expr> bindings_;
   Map<Expr, Var> value_to_bound_var_;
   Map<Var, Array<Var>> current_block_use_def_;
@@ -17,14 +17,20 @@
  * under the License.
  */
 #include <tvm/relax/analysis.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relax/attrs/op.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/struct_info.h>
 #include <tvm/relax/transform.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "../../relay/analysis/graph_partitioner.h"
 #include "../../support/arena.h"
@@ -1084,8 +1090,33 @@ class TIRFuseMutator : public ExprMutator {
     // Since TIRFuseMutator will delete bunch of PrimFunc, we create an empty block builder.
 
     // Step 1. Fuse all primitive relax functions, store the result in `fused_tir_funcs_`
+    //
+    // Structurally identical primitive functions (e.g. the repeated blocks of a
+    // deep model) fuse to identical PrimFuncs, so construction is memoized
+    // under structural equality: each distinct pattern is fused once and
+    // cache hits are cloned with fresh definitions. GlobalVar equality is
+    // name-based and global var names are unique within a module, so equal
+    // functions are guaranteed to call the same callee PrimFuncs.
+    StructuralHash structural_hash;
+    StructuralEqual structural_equal;
+    using FusedTIRResult = std::pair<tir::PrimFunc, Array<Integer>>;
+    std::unordered_map<size_t, std::vector<std::pair<Function, FusedTIRResult>>> fused_memo;
+
     for (const auto& [old_gvar, func] : primitive_relax) {
-      const auto& [prim_func, indices] = FusedTIRConstructor::GetFusedTIR(mod, old_gvar);
+      tir::PrimFunc prim_func;
+      Array<Integer> indices;
+      std::vector<std::pair<Function, FusedTIRResult>>& bucket = fused_memo[structural_hash(func)];
+      auto it = std::find_if(bucket.begin(), bucket.end(),
+                             [&](const auto& entry) { return structural_equal(entry.first, func); });
+      if (it != bucket.end()) {
+        // Renew the definitions so the clone does not share symbolic vars or
+        // buffers with the previously fused function.
+        prim_func = tir::RenewDefs(it->second.first);
+        indices = it->second.second;
+      } else {
+        std::tie(prim_func, indices) = FusedTIRConstructor::GetFusedTIR(mod, old_gvar);
+        bucket.emplace_back(func, FusedTIRResult{prim_func, indices});
+      }
 
       GlobalVar new_gvar(old_gvar->name_hint);
       UpdateStructInfo(new_gvar,
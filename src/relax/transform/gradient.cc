@@ -295,10 +295,11 @@ class BackwardBindingGenerator : private ExprVisitor {
   static Expr Generate(const BlockBuilder& builder, const DataflowBlock& forward_block,
                        const Array<Var>& require_grads, const Var& target_var,
                        const Array<Var>& orig_params, const Expr& orig_return_value,
-                       const CheckpointCollector& cp_collector) {
+                       const CheckpointCollector& cp_collector, bool share_adjoints) {
     CheckpointGenerator checkpoint_generator(builder, orig_params, forward_block,
                                              cp_collector.checkpoints);
-    BackwardBindingGenerator generator(builder, cp_collector, checkpoint_generator);
+    BackwardBindingGenerator generator(builder, cp_collector, checkpoint_generator,
+                                       share_adjoints);
 
     // Initialize the adjoint of target_var as ones op. We have already checked the target.
     auto* target_sinfo = GetStructInfoAs<TensorStructInfoNode>(target_var);
@@ -315,10 +316,12 @@ class BackwardBindingGenerator : private ExprVisitor {
  private:
   explicit BackwardBindingGenerator(const BlockBuilder& builder,
                                     const CheckpointCollector& cp_collector,
-                                    const CheckpointGenerator& checkpoint_generator)
+                                    const CheckpointGenerator& checkpoint_generator,
+                                    bool share_adjoints)
       : builder_(builder),
         cp_collector_(cp_collector),
-        checkpoint_generator_(checkpoint_generator) {}
+        checkpoint_generator_(checkpoint_generator),
+        share_adjoints_(share_adjoints) {}
 
   void VisitBinding(const Binding& binding) final {
     // TODO(chaofan, yixin): support other types of bindings
@@ -451,7 +454,7 @@ class BackwardBindingGenerator : private ExprVisitor {
   // We use NestedMsg to simplify handling (nested) tuples. That requires converting partial from
   // expr to NestedMsg or backwards.
   void UpdateAdjoint(const Expr& expr, const Expr& partial) {
-    AdjointMsg partial_msg = ExprToAdjointMsg(builder_->Normalize(partial));
+    AdjointMsg partial_msg = ExprToAdjointMsg(NormalizePartial(partial));
     DecomposeNestedMsg(expr, partial_msg, [&](Expr leaf, AdjointMsg msg) {
       if (leaf->IsInstance<VarNode>()) {
         const Var& v = Downcast<Var>(leaf);
@@ -473,6 +476,28 @@ class BackwardBindingGenerator : private ExprVisitor {
     });
   }
 
+  // Normalize a partial adjoint before decomposing it into a NestedMsg. Without adjoint
+  // sharing this is a plain normalization, where the normalizer binds nested subexpressions
+  // to fresh vars without any deduplication. With adjoint sharing the partial is emitted
+  // through the hash-consing emitter instead, so that structurally identical subexpressions
+  // across all partials share one binding. Tuples are traversed field-wise so that the
+  // nested-msg decomposition below still sees their fields directly, and no_grad markers are
+  // left untouched.
+  Expr NormalizePartial(const Expr& partial) {
+    if (!share_adjoints_ || IsCallNoGrad(partial)) {
+      return builder_->Normalize(partial);
+    }
+    if (const auto* tuple = partial.as<TupleNode>()) {
+      Array<Expr> new_fields;
+      new_fields.reserve(tuple->fields.size());
+      for (const Expr& field : tuple->fields) {
+        new_fields.push_back(NormalizePartial(field));
+      }
+      return builder_->Normalize(Tuple(new_fields));
+    }
+    return builder_->Normalize(EmitSharedSubexprs(partial, ""));
+  }
+
   // Handle the return value of the AD function.
   // Returns the new return value, which would be like:
   // Tuple(original_return_value,
@@ -505,6 +530,18 @@ class BackwardBindingGenerator : private ExprVisitor {
     Var adjoint_var;
     if (is_output) {
       adjoint_var = builder_->EmitOutput(adjoint, source_var->name_hint() + "_adjoint_out");
+    } else if (share_adjoints_) {
+      Expr shared = EmitSharedSubexprs(adjoint, source_var->name_hint() + "_adjoint");
+      if (const auto* var = shared.as<VarNode>()) {
+        // Either the whole adjoint was emitted under the name above, or it hit an adjoint
+        // emitted earlier; in both cases reuse the binding instead of introducing an alias.
+        adjoint_var = GetRef<Var>(var);
+      } else {
+        // The adjoint is a leaf that is not a Var (e.g. a Constant); bind it so that the
+        // adjoint stays named.
+        adjoint_var = builder_->Emit(shared, source_var->name_hint() + "_adjoint");
+      }
+      adjoint_var_map_.Set(source_var, adjoint_var);
     } else {
       adjoint_var = builder_->Emit(adjoint, source_var->name_hint() + "_adjoint");
       adjoint_var_map_.Set(source_var, adjoint_var);
@@ -512,6 +549,46 @@ class BackwardBindingGenerator : private ExprVisitor {
     return adjoint_var;
   }
 
+  // Emit the adjoint expr bottom-up through a hash-consing table, so that structurally
+  // identical subexpressions across all backward bindings share a single binding. Leaf
+  // expressions are returned as is; every non-leaf subexpression is rebuilt with emitted
+  // (i.e. leaf) arguments, normalized, and looked up in the table before being emitted.
+  // Only used when share_adjoints is enabled.
+  Expr EmitSharedSubexprs(const Expr& expr, const String& name_hint) {
+    Expr rewritten;
+    if (const auto* call = expr.as<CallNode>()) {
+      Array<Expr> new_args;
+      new_args.reserve(call->args.size());
+      for (const Expr& arg : call->args) {
+        new_args.push_back(EmitSharedSubexprs(arg, ""));
+      }
+      rewritten = Call(call->op, new_args, call->attrs, call->sinfo_args);
+    } else if (const auto* tuple = expr.as<TupleNode>()) {
+      Array<Expr> new_fields;
+      new_fields.reserve(tuple->fields.size());
+      for (const Expr& field : tuple->fields) {
+        new_fields.push_back(EmitSharedSubexprs(field, ""));
+      }
+      rewritten = Tuple(new_fields);
+    } else if (const auto* tuple_get_item = expr.as<TupleGetItemNode>()) {
+      rewritten = TupleGetItem(EmitSharedSubexprs(tuple_get_item->tuple, ""),
+                               tuple_get_item->index);
+    } else {
+      // Leaf expressions (Var, Constant, ShapeExpr, ...) need no binding of their own.
+      return expr;
+    }
+    // All arguments are leaf expressions now, so normalizing only infers the struct info and
+    // does not emit hidden bindings; the normalized form serves as the hash-consing key.
+    rewritten = builder_->Normalize(rewritten);
+    auto it = emitted_adjoint_exprs_.find(rewritten);
+    if (it != emitted_adjoint_exprs_.end()) {
+      return it->second;
+    }
+    Var var = builder_->Emit(rewritten, name_hint);
+    emitted_adjoint_exprs_.emplace(rewritten, var);
+    return var;
+  }
+
   static bool IsCallNoGrad(const Expr& expr) {
     return expr->IsInstance<CallNode>() &&
            Downcast<Call>(expr)->op == Op::Get("relax.grad.no_grad");
@@ -597,12 +674,16 @@ class BackwardBindingGenerator : private ExprVisitor {
   CheckpointCollector cp_collector_;
   // The generator for checkpoint bindings
   CheckpointGenerator checkpoint_generator_;
+  // Whether to share structurally identical adjoint subexpressions across bindings
+  bool share_adjoints_;
+  // The hash-consing table: normalized adjoint subexpressions to their emitted vars
+  std::unordered_map<Expr, Var, StructuralHash, StructuralEqual> emitted_adjoint_exprs_;
 };
 
 class GradientMutator : private ExprMutator {
  public:
   static IRModule Transform(IRModule mod, String func_name, Optional<Array<Var>> require_grads,
-                            int target_index) {
+                            int target_index, bool share_adjoints) {
     // Step 1. Copy function
     auto* old_func = mod->Lookup(func_name).as<FunctionNode>();
     CHECK(old_func) << func_name << "is not a Relax Function";
@@ -623,17 +704,18 @@ class GradientMutator : private ExprMutator {
 
     // Step 4. Generate the adjoint function, use RemoveAllUnused to simplify it, and then return
     // the IRModule with the adjoint function
-    return GradientMutator(mod, require_grads.value(), target_index, cp_collector)
+    return GradientMutator(mod, require_grads.value(), target_index, cp_collector, share_adjoints)
         .AddAdjointFunction(new_func, func_name, true);
   }
 
  private:
   GradientMutator(const IRModule& module, const Array<Var>& require_grads, int target_index,
-                  const CheckpointCollector& cp_collector)
+                  const CheckpointCollector& cp_collector, bool share_adjoints)
       : ExprMutator(module),
         require_grads_(require_grads),
         cp_collector_(cp_collector),
-        target_index_(target_index) {}
+        target_index_(target_index),
+        share_adjoints_(share_adjoints) {}
 
   // Add the adjoint function of func to the IRModule using BlockBuilder
   IRModule AddAdjointFunction(const Function& func, const String& func_name,
@@ -695,7 +777,8 @@ class GradientMutator : private ExprMutator {
     // generate backward bindings and the return value
     return_expr_ = BackwardBindingGenerator::Generate(builder_, GetRef<DataflowBlock>(block),
                                                       require_grads_, target_var_, orig_params_,
-                                                      orig_return_expr_, cp_collector_);
+                                                      orig_return_expr_, cp_collector_,
+                                                      share_adjoints_);
 
     return builder_->EndBlock();
   }
@@ -768,6 +851,8 @@ class GradientMutator : private ExprMutator {
   // the differentiation target
   int target_index_;
   Var target_var_;
+  // whether to share structurally identical adjoint subexpressions across bindings
+  bool share_adjoints_;
   // the return value of the original function and the differentiated function
   Array<Var> orig_params_;
   Expr orig_return_expr_;
@@ -776,10 +861,12 @@ class GradientMutator : private ExprMutator {
 
 namespace transform {
 
-Pass Gradient(String func_name, Optional<Array<Var>> require_grads, int target_index) {
+Pass Gradient(String func_name, Optional<Array<Var>> require_grads, int target_index,
+              bool share_adjoints) {
   runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func = [=](IRModule mod,
                                                                             PassContext pc) {
-    return relax::GradientMutator::Transform(mod, func_name, require_grads, target_index);
+    return relax::GradientMutator::Transform(mod, func_name, require_grads, target_index,
+                                             share_adjoints);
   };
   return CreateModulePass(/*pass_function=*/pass_func,
                           /*opt_level=*/0,
@@ -26,6 +26,7 @@
 #include <tvm/relax/expr.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
 #include <tvm/runtime/logging.h>
 
 #include <iostream>
@@ -42,6 +43,9 @@ namespace relax {
 constexpr const char* kLiftTransformConsumeParams = "relax.lift_transform_params.consume_params";
 TVM_REGISTER_PASS_CONFIG_OPTION(kLiftTransformConsumeParams, Bool);
 
+constexpr const char* kLiftTransformStreaming = "relax.lift_transform_params.streaming";
+TVM_REGISTER_PASS_CONFIG_OPTION(kLiftTransformStreaming, Bool);
+
 namespace {
 struct BaseCollectInfo {
  public:
@@ -816,10 +820,35 @@ Pass LiftTransformParams(Variant<Bool, Array<String>> shared_transform) {
 
         std::string func_name = gvar->name_hint;
         if (ends_with(func_name, "transform_params")) {
+          bool streaming = pc->GetConfig<Bool>(kLiftTransformStreaming).value_or(Bool(false));
+          bool consume_params =
+              pc->GetConfig<Bool>(kLiftTransformConsumeParams).value_or(Bool(false));
+          CHECK(!(streaming && consume_params))
+              << "ValueError: "
+              << "The pass config options \"" << kLiftTransformStreaming << "\" and \""
+              << kLiftTransformConsumeParams << "\" are mutually exclusive.  "
+              << "The streaming mode does not bundle parameters into a tuple, "
+              << "so there is no bundled tuple to consume from";
+
           func = WithAttr(func, tvm::attr::kGlobalSymbol, gvar->name_hint);
-          func = BundleModelParams(func);
-          if (pc->GetConfig<Bool>(kLiftTransformConsumeParams).value_or(Bool(false))) {
-            func = Downcast<Function>(ConsumeBundledParams()(func));
+          if (streaming) {
+            // Streaming mode: each original weight is fetched through the
+            // fget_param callback at its first use, each transformed weight
+            // is handed to the fset_output callback as soon as it is
+            // computed, and every tensor is killed after its last use.
+            // Peak memory is therefore bounded by the largest working set of
+            // a single transform chain instead of the whole parameter set.
+            func = WithLazyInputs(func);
+            func = WithLazyOutputs(func);
+            // The callbacks and kill operators are impure, so leave dataflow
+            // form before inserting the kills.
+            func = Downcast<Function>(ToNonDataflow(func));
+            func = Downcast<Function>(relax::KillAfterLastUse(func));
+          } else {
+            func = BundleModelParams(func);
+            if (consume_params) {
+              func = Downcast<Function>(ConsumeBundledParams()(func));
+            }
           }
           to_add[gvar] = func;
         }
@@ -0,0 +1,236 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/specialize_symbolic_var_dispatch.cc
+ * \brief Specialize a function under symbolic-shape bindings and dispatch to
+ *   the specialized clones with a cheap runtime check.
+ *
+ * A dynamic-shape function often serves several regimes with very different
+ * performance profiles, for example `n == 1` decode steps and `n > 1` prefill
+ * steps of a language model.  This pass clones the function once per
+ * requested specialization, binds the specialized symbolic variables to their
+ * constant values (reusing the machinery of bind_symbolic_vars.cc), folds the
+ * shape arithmetic that becomes constant, and replaces the original function
+ * with a dispatcher that evaluates each specialization predicate at runtime
+ * and calls the first matching clone, falling back to a generic copy of the
+ * original body.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/block_builder.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/struct_info.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
+#include <tvm/tir/op.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "utils.h"
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*!
+ * \brief Fold shape arithmetic that becomes constant after specialization.
+ *
+ * Binding a symbolic variable leaves expressions such as `1 * 128` behind in
+ * shape expressions and struct info.  Fold them so that downstream passes see
+ * static shapes in the specialized clones.
+ */
+class SpecializedExprSimplifier : public ExprMutator {
+ public:
+  using ExprMutator::VisitExpr_;
+
+  PrimExpr VisitPrimExpr(const PrimExpr& expr) final {
+    if (expr->IsInstance<tir::VarNode>() || expr->IsInstance<IntImmNode>()) {
+      return expr;
+    }
+    return analyzer_.Simplify(expr);
+  }
+
+ private:
+  arith::Analyzer analyzer_;
+};
+
+IRModule SpecializeDispatch(IRModule mod, String func_name,
+                            Array<Map<ObjectRef, PrimExpr>> specializations) {
+  auto gvar = mod->GetGlobalVar(func_name);
+  auto func = Downcast<Function>(mod->Lookup(gvar));
+  CHECK(!specializations.empty()) << "At least one specialization must be provided";
+
+  // Map from string to the variable(s) with that name, as in
+  // FunctionBindSymbolicVars.  Specializations are re-applied to fresh copies
+  // of the function, whose symbolic variables are renewed, so every binding
+  // must be resolvable by name.
+  Array<tir::Var> symbolic_vars = DefinedSymbolicVars(func);
+  std::unordered_map<std::string, Array<tir::Var>> string_lookup;
+  std::unordered_set<const tir::VarNode*> symbolic_var_set;
+  for (const auto& var : symbolic_vars) {
+    string_lookup[var->name_hint].push_back(var);
+    symbolic_var_set.insert(var.get());
+  }
+
+  auto resolve_key = [&](const ObjectRef& key) -> tir::Var {
+    if (auto opt = key.as<String>()) {
+      String string_key = opt.value();
+      auto it = string_lookup.find(string_key);
+      CHECK(it != string_lookup.end())
+          << "Function does not use symbolic var with name \"" << string_key << "\".  "
+          << "Function has symbolic variables " << symbolic_vars;
+      CHECK_EQ(it->second.size(), 1)
+          << "Function contains multiple symbolic variables with name \"" << string_key << "\".  "
+          << "The TIR variables " << it->second << " are all named \"" << string_key << "\"";
+      return it->second[0];
+    } else if (auto opt = key.as<tir::Var>()) {
+      auto var = opt.value();
+      CHECK(symbolic_var_set.count(var.get()))
+          << "Function does not use variable " << var << " as a symbolic variable.  "
+          << "Function has symbolic variables " << symbolic_vars;
+      CHECK_EQ(string_lookup[var->name_hint].size(), 1)
+          << "Variable " << var << " shares its name with another symbolic variable, "
+          << "so the binding cannot be re-applied to a specialized copy of the function";
+      return var;
+    } else {
+      LOG(FATAL) << "Expected symbolic variable to be a tir::Var or a string name, "
+                 << "but " << key << " was of type " << key->GetTypeKey();
+    }
+  };
+
+  // Step 1. Resolve each specialization into by-name bindings and the runtime
+  // predicate that guards its clone.
+  std::vector<Map<ObjectRef, PrimExpr>> bindings_by_name;
+  std::vector<PrimExpr> predicates;
+  for (const auto& specialization : specializations) {
+    CHECK(!specialization.empty()) << "Each specialization must bind at least one symbolic var";
+    Map<ObjectRef, PrimExpr> by_name;
+    PrimExpr predicate;
+    for (const auto& [key, value] : specialization) {
+      tir::Var var = resolve_key(key);
+      CHECK(!by_name.count(String(var->name_hint)))
+          << "Specialization binds variable " << var << " multiple times";
+      by_name.Set(String(var->name_hint), value);
+      PrimExpr equals = (var == value);
+      predicate = predicate.defined() ? (predicate && equals) : equals;
+    }
+    bindings_by_name.push_back(by_name);
+    predicates.push_back(predicate);
+  }
+
+  BlockBuilder builder = BlockBuilder::Create(mod);
+
+  // Step 2. Keep the original body as a private generic fallback.
+  Function generic_func = CopyWithNewVars(func);
+  generic_func = WithoutAttr(std::move(generic_func), tvm::attr::kGlobalSymbol);
+  GlobalVar generic_gvar = builder->AddFunction(generic_func, func_name + "_generic");
+
+  // Step 3. Create one private clone per specialization, with the bound
+  // symbolic variables propagated and the resulting constant shape
+  // arithmetic folded.
+  std::vector<GlobalVar> specialized_gvars;
+  std::vector<Function> specialized_funcs;
+  for (size_t i = 0; i < bindings_by_name.size(); ++i) {
+    Function specialized = FunctionBindSymbolicVars(CopyWithNewVars(func), bindings_by_name[i]);
+    specialized = Downcast<Function>(SpecializedExprSimplifier().VisitExpr(specialized));
+    specialized = WithoutAttr(std::move(specialized), tvm::attr::kGlobalSymbol);
+    specialized_gvars.push_back(
+        builder->AddFunction(specialized, func_name + "_spec" + std::to_string(i)));
+    specialized_funcs.push_back(specialized);
+  }
+
+  // Step 4. Replace the original function with a dispatcher.  Each predicate
+  // is evaluated as a PrimValue, which ComputePrimValue later lowers to a
+  // host-side scalar computation, so the runtime check is a chain of cheap
+  // scalar comparisons rather than a tensor computation.
+  StructuralEqual structural_equal;
+  Array<Expr> call_args(func->params.begin(), func->params.end());
+
+  std::function<Expr(size_t)> make_branch = [&](size_t i) -> Expr {
+    if (i == specializations.size()) {
+      return SeqExpr({}, Call(generic_gvar, call_args));
+    }
+
+    // Arguments whose struct info was refined by the specialization are
+    // re-matched against the refined struct info, which the predicate
+    // guarantees to hold at runtime.
+    Array<Binding> cast_bindings;
+    Array<Expr> branch_args;
+    for (size_t p = 0; p < func->params.size(); ++p) {
+      Var param = func->params[p];
+      StructInfo specialized_sinfo = GetStructInfo(specialized_funcs[i]->params[p]);
+      if (structural_equal(GetStructInfo(param), specialized_sinfo)) {
+        branch_args.push_back(param);
+      } else {
+        Var cast_var(param->name_hint() + "_spec" + std::to_string(i), specialized_sinfo);
+        cast_bindings.push_back(MatchCast(cast_var, param, specialized_sinfo));
+        branch_args.push_back(cast_var);
+      }
+    }
+    Expr branch_call = Call(specialized_gvars[i], branch_args);
+    Expr true_branch = cast_bindings.empty()
+                           ? SeqExpr({}, branch_call)
+                           : SeqExpr({BindingBlock(cast_bindings)}, branch_call);
+
+    Var cond_var("cond_" + std::to_string(i), PrimStructInfo(DataType::Bool()));
+    Binding cond_binding = VarBinding(cond_var, PrimValue(predicates[i]));
+    If dispatch(cond_var, true_branch, make_branch(i + 1));
+    return SeqExpr({BindingBlock({cond_binding})}, dispatch);
+  };
+
+  Function dispatcher(func->params, make_branch(0), func->ret_struct_info, func->is_pure,
+                      func->attrs, func->span);
+  dispatcher = Downcast<Function>(builder->Normalize(dispatcher));
+
+  auto free_symbolic_vars = FreeSymbolicVars(dispatcher);
+  CHECK(free_symbolic_vars.empty())
+      << "Every symbolic variable used by a specialization predicate must be inferable "
+      << "from the parameters of \"" << func_name << "\", but TIR variables "
+      << free_symbolic_vars << " are not";
+
+  builder->UpdateFunction(gvar, dispatcher);
+  return builder->GetContextIRModule();
+}
+
+}  // namespace
+
+namespace transform {
+
+Pass SpecializeSymbolicVarDispatch(String func_name,
+                                   Array<Map<ObjectRef, PrimExpr>> specializations) {
+  auto pass_func = [=](IRModule mod, PassContext context) -> IRModule {
+    return SpecializeDispatch(mod, func_name, specializations);
+  };
+
+  return tvm::transform::CreateModulePass(pass_func, 1, "relax.SpecializeSymbolicVarDispatch", {});
+}
+
+TVM_REGISTER_GLOBAL("relax.transform.SpecializeSymbolicVarDispatch")
+    .set_body_typed(SpecializeSymbolicVarDispatch);
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -64,14 +64,47 @@
  * It means the maximum value of variable that names "n" in the function
  * signature will have upper bound 1024. And we will use 1024 as its value
  * during memory planning.
+ *
+ * The annotated bounds also flow across local call boundaries: when every
+ * call site of an internal function bounds a signature var of the callee
+ * (because the argument shapes are expressed in the caller's bounded vars),
+ * the callee's tensors are planned at the loosest call-site bound as well,
+ * without annotating the callee itself. Unbounded vars remain dynamic.
+ *
+ * In addition to the hard upper bounds, the pass supports a profile-guided
+ * mode through the attribute "tir_var_profiled_bound", with the same dict
+ * format. The values are a profiled shape envelope (e.g. the P95 of the
+ * distributions recorded by the `vm.builtin.shape_profile_*` VM instrument)
+ * rather than worst-case bounds, and take precedence over
+ * "tir_var_upper_bound" when sizing the planned storages. Since the actual
+ * shapes may exceed the envelope, running a plan produced this way requires
+ * the runtime storage spill path (TVM_VM_STORAGE_SPILL_ON_OVERFLOW), which
+ * serves outlier tensors from the device allocator instead of the
+ * envelope-sized storage pool.
+ *
+ * The pass can also spill planned storages to pinned host memory when the
+ * device cannot hold the activation peak. When a function is annotated with
+ * the attribute "relax.memory_plan_device_budget" (a positive number of
+ * bytes), the planned footprint of the statically sized storages is compared
+ * against the budget, and if it exceeds the budget, the coldest storages by
+ * liveness interval (the longest live span per referencing binding) have
+ * their storage scope rewritten to "global.pinned_host" until the remaining
+ * device footprint fits. The VM serves that scope from the pinned-host
+ * counterpart of the device (see `vm.builtin.alloc_storage`), which stays
+ * addressable by the device through unified addressing, so models whose
+ * activation peaks exceed device memory run at a predictable transfer
+ * penalty instead of failing to allocate.
  */
 #include <tvm/arith/analyzer.h>
 #include <tvm/relax/analysis.h>
+#include <tvm/relax/attrs/op.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/nested_msg.h>
 #include <tvm/relax/transform.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <set>
 #include <vector>
@@ -353,6 +386,34 @@ class StorageAllocatorBaseVisitor : public ExprVisitor {
   std::vector<const BindingBlockNode*> block_stack_;
 };
 
+/*!
+ * \brief Parse a function attribute that maps TIR var names to positive integers.
+ * \param func The function whose attribute is to be parsed.
+ * \param attr_name The name of the attribute.
+ * \return The parsed mapping from TIR var names to the integer values.
+ */
+std::unordered_map<String, IntImm> ParseTIRVarIntDictAttr(const Function& func,
+                                                          const char* attr_name) {
+  Map<ObjectRef, ObjectRef> attr_raw =
+      func->GetAttr<Map<ObjectRef, ObjectRef>>(attr_name).value_or(Map<ObjectRef, ObjectRef>());
+  std::unordered_map<String, IntImm> attr;
+  // We manually check the value type to ensure the values are all positive IntImm.
+  for (auto it : attr_raw) {
+    const auto* key = it.first.as<StringObj>();
+    const auto* value = it.second.as<IntImmNode>();
+    CHECK(key != nullptr) << "The entry key of attr `" << attr_name << "` should be string. However "
+                          << it.first->GetTypeKey() << " is got.";
+    CHECK(value != nullptr) << "The entry value of attr `" << attr_name
+                            << "` should be integer. However " << it.second->GetTypeKey()
+                            << " is got.";
+    CHECK_GT(value->value, 0) << "The entry value of attr `" << attr_name
+                              << "` should be a positive integer, while " << value->value
+                              << " is got.";
+    attr[GetRef<String>(key)] = GetRef<IntImm>(value);
+  }
+  return attr;
+}
+
 /*!
  * \brief Set the upper bound of the TIR variables that appear in
  * the input function signature in the analyzer.
@@ -363,31 +424,19 @@ class StorageAllocatorBaseVisitor : public ExprVisitor {
 void SetTIRVarUpperBound(Function func, arith::Analyzer* ana,
                          Map<tir::Var, arith::IntSet>* dom_map) {
   // Use the attribute-annotated TIR var upper bounds as the TIR var values for
-  // memory planning.
+  // memory planning. When a profiled bound (a shape envelope recorded at
+  // runtime, e.g. the P95 of observed values) is annotated for a variable, it
+  // takes precedence over the hard upper bound, so that the planned storages
+  // are sized for the common case and outlier shapes spill at runtime.
   // NOTE: we only apply the annotated upper bounds to the TIR variables that
   // appear in the **function signature**.
-  Map<ObjectRef, ObjectRef> var_upper_bound_attr_raw =
-      func->GetAttr<Map<ObjectRef, ObjectRef>>("tir_var_upper_bound")
-          .value_or(Map<ObjectRef, ObjectRef>());
+  std::unordered_map<String, IntImm> var_upper_bound_attr =
+      ParseTIRVarIntDictAttr(func, "tir_var_upper_bound");
+  std::unordered_map<String, IntImm> var_profiled_bound_attr =
+      ParseTIRVarIntDictAttr(func, "tir_var_profiled_bound");
   Array<ObjectRef> non_negative_var_attr_raw =
       func->GetAttr<Array<ObjectRef>>("tir_non_negative_var").value_or(Array<ObjectRef>());
-  std::unordered_map<String, IntImm> var_upper_bound_attr;
   std::unordered_set<String> non_negative_var_attr;
-  // We manually check the value type to ensure the values are all positive IntImm.
-  for (auto it : var_upper_bound_attr_raw) {
-    const auto* key = it.first.as<StringObj>();
-    const auto* value = it.second.as<IntImmNode>();
-    CHECK(key != nullptr)
-        << "The entry key of attr `tir_var_upper_bound` should be string. However "
-        << it.first->GetTypeKey() << " is got.";
-    CHECK(value != nullptr)
-        << "The entry value of attr `tir_var_upper_bound` should be integer. However "
-        << it.second->GetTypeKey() << " is got.";
-    CHECK_GT(value->value, 0)
-        << "The entry value of attr `tir_var_upper_bound` should be a positive integer, while "
-        << value->value << " is got.";
-    var_upper_bound_attr[GetRef<String>(key)] = GetRef<IntImm>(value);
-  }
   for (ObjectRef var_name : non_negative_var_attr_raw) {
     const auto* key = var_name.as<StringObj>();
     CHECK(key != nullptr) << "The element of attr `tir_non_negative_var` should be string. However "
@@ -396,11 +445,18 @@ void SetTIRVarUpperBound(Function func, arith::Analyzer* ana,
   }
   Array<tir::Var> var_in_signature = TIRVarsInStructInfo(GetStructInfo(func));
   for (const tir::Var& tir_var : var_in_signature) {
-    auto it = var_upper_bound_attr.find(tir_var->name_hint);
-    if (it != var_upper_bound_attr.end()) {
+    IntImm bound{nullptr};
+    if (auto it = var_profiled_bound_attr.find(tir_var->name_hint);
+        it != var_profiled_bound_attr.end()) {
+      bound = it->second;
+    } else if (auto it = var_upper_bound_attr.find(tir_var->name_hint);
+               it != var_upper_bound_attr.end()) {
+      bound = it->second;
+    }
+    if (bound.defined()) {
       tvm::Range range =
           tvm::Range::FromMinExtent(tvm::IntImm(DataType::Int(64), 0),
-                                    tvm::IntImm(DataType::Int(64), (*it).second->value + 1));
+                                    tvm::IntImm(DataType::Int(64), bound->value + 1));
       ana->Bind(tir_var, range);
       dom_map->Set(tir_var, arith::IntSet::FromRange(range));
     } else if (non_negative_var_attr.count(tir_var->name_hint)) {
@@ -439,6 +495,155 @@ Array<PrimExpr> GetUpperBoundShape(Array<PrimExpr> shape, arith::Analyzer* ana,
   return upper_bounded_shape;
 }
 
+/*!
+ * \brief Derive upper bounds for the signature TIR vars of internal functions
+ * from the struct info of their call-site arguments, and bind the derived
+ * bounds in the analyzer and the domain map.
+ * \details The attribute-annotated bounds of the entry functions flow into
+ * their callees: a callee signature var is bounded only when every call site
+ * of the callee bounds it, and the loosest such bound is used. Derivation is
+ * iterated so bounds propagate through chains of local calls. Functions with
+ * external linkage may be invoked with arbitrary shapes at runtime, so no
+ * bounds are derived for them; the same holds for functions whose GlobalVar
+ * escapes as a value, as their indirect call sites are invisible here. Vars
+ * that the callee bounds itself through its own attributes are skipped and
+ * handled by SetTIRVarUpperBound.
+ * \param mod The module being planned.
+ * \param ana The analyzer to bind the derived bounds in.
+ * \param dom_map The domain map of the TIR variables.
+ */
+void DeriveCallSiteVarBounds(const IRModule& mod, arith::Analyzer* ana,
+                             Map<tir::Var, arith::IntSet>* dom_map) {
+  // A function whose GlobalVar escapes as a value (e.g. captured through
+  // make_closure) can be invoked from sites this scan cannot see, so its
+  // signature vars must stay unbounded, just like those of functions with
+  // external linkage. Count the references of each GlobalVar against its
+  // call-op occurrences; any surplus reference is an escape.
+  std::unordered_map<const GlobalVarNode*, int> gvar_refs;
+  std::unordered_map<const GlobalVarNode*, int> gvar_call_ops;
+  auto fvisit_ref = [&](const Expr& expr) {
+    if (const auto* gv = expr.as<GlobalVarNode>()) {
+      ++gvar_refs[gv];
+    } else if (const auto* call = expr.as<CallNode>()) {
+      if (const auto* gv = call->op.as<GlobalVarNode>()) {
+        ++gvar_call_ops[gv];
+      }
+    }
+  };
+  for (auto it : mod->functions) {
+    if (const auto* func = it.second.as<FunctionNode>()) {
+      PostOrderVisit(func->body, fvisit_ref);
+    }
+  }
+  std::unordered_set<const GlobalVarNode*> escaped_gvars;
+  for (const auto& [gv, num_refs] : gvar_refs) {
+    auto it = gvar_call_ops.find(gv);
+    if (it == gvar_call_ops.end() || it->second != num_refs) {
+      escaped_gvars.insert(gv);
+    }
+  }
+
+  Map<tir::Var, IntImm> derived;
+  size_t num_functions = mod->functions.size();
+  for (size_t round = 0; round < num_functions; ++round) {
+    // Seed a scratch analyzer with all attribute-annotated bounds together
+    // with the bounds derived so far, so that call-site argument shapes
+    // expressed in a caller's bounded vars can be evaluated. The real
+    // analyzer is only given the derived bounds at the end, as the
+    // attribute-annotated vars are bound later by SetTIRVarUpperBound.
+    arith::Analyzer scratch_ana;
+    Map<tir::Var, arith::IntSet> scratch_dom;
+    for (auto it : mod->functions) {
+      if (const auto* func = it.second.as<FunctionNode>()) {
+        SetTIRVarUpperBound(GetRef<Function>(func), &scratch_ana, &scratch_dom);
+      }
+    }
+    for (auto [tir_var, bound] : derived) {
+      tvm::Range range = tvm::Range::FromMinExtent(
+          tvm::IntImm(DataType::Int(64), 0), tvm::IntImm(DataType::Int(64), bound->value + 1));
+      scratch_ana.Bind(tir_var, range);
+    }
+
+    // Collect, per callee, the bounds implied by all of its call sites.
+    std::unordered_map<const GlobalVarNode*, Map<tir::Var, IntImm>> callee_bounds;
+    auto fvisit_call = [&](const Expr& expr) {
+      const auto* call = expr.as<CallNode>();
+      if (call == nullptr) {
+        return;
+      }
+      const auto* gv = call->op.as<GlobalVarNode>();
+      if (gv == nullptr || escaped_gvars.count(gv)) {
+        return;
+      }
+      auto opt_callee = mod->functions.Get(GetRef<GlobalVar>(gv));
+      if (!opt_callee.defined()) {
+        return;
+      }
+      const auto* callee = opt_callee.value().as<FunctionNode>();
+      if (callee == nullptr || callee->GetLinkageType() == LinkageType::kExternal ||
+          callee->params.size() != call->args.size()) {
+        return;
+      }
+      Map<tir::Var, IntImm> site_bounds;
+      for (size_t i = 0; i < callee->params.size(); ++i) {
+        for (auto [tir_var, bound] :
+             DeriveSymbolicVarBounds(GetStructInfo(callee->params[i]),
+                                     GetStructInfo(call->args[i]), &scratch_ana)) {
+          auto it = site_bounds.find(tir_var);
+          if (it == site_bounds.end() || (*it).second->value < bound->value) {
+            site_bounds.Set(tir_var, bound);
+          }
+        }
+      }
+      auto it = callee_bounds.find(gv);
+      if (it == callee_bounds.end()) {
+        callee_bounds.emplace(gv, site_bounds);
+        return;
+      }
+      // A var stays bounded only when every call site bounds it; keep the
+      // loosest bound across the sites.
+      Map<tir::Var, IntImm> merged;
+      for (auto [tir_var, bound] : it->second) {
+        if (auto site_bound = site_bounds.Get(tir_var)) {
+          merged.Set(tir_var, bound->value >= site_bound.value()->value ? bound
+                                                                        : site_bound.value());
+        }
+      }
+      it->second = merged;
+    };
+    for (auto it : mod->functions) {
+      if (const auto* func = it.second.as<FunctionNode>()) {
+        PostOrderVisit(func->body, fvisit_call);
+      }
+    }
+
+    // Record the newly derived bounds, skipping vars the callee bounds itself.
+    bool changed = false;
+    for (const auto& [gv, bounds] : callee_bounds) {
+      const auto* callee = mod->functions.Get(GetRef<GlobalVar>(gv)).value().as<FunctionNode>();
+      std::unordered_map<String, IntImm> attr_bounds =
+          ParseTIRVarIntDictAttr(GetRef<Function>(callee), "tir_var_upper_bound");
+      for (auto [tir_var, bound] : bounds) {
+        if (attr_bounds.count(tir_var->name_hint) || derived.count(tir_var)) {
+          continue;
+        }
+        derived.Set(tir_var, bound);
+        changed = true;
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+
+  for (auto [tir_var, bound] : derived) {
+    tvm::Range range = tvm::Range::FromMinExtent(tvm::IntImm(DataType::Int(64), 0),
+                                                 tvm::IntImm(DataType::Int(64), bound->value + 1));
+    ana->Bind(tir_var, range);
+    dom_map->Set(tir_var, arith::IntSet::FromRange(range));
+  }
+}
+
 /*! \brief Check if a shape is static (a.k.a., has no TIR variable). */
 bool IsStaticShape(Array<PrimExpr> shape) {
   for (const PrimExpr& dim : shape) {
@@ -469,6 +674,10 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
   static std::unordered_map<const ExprNode*, Tokens> Initialize(const IRModule& mod,
                                                                 arith::Analyzer* analyzer) {
     StorageAllocatorInit initializer(mod, analyzer);
+    // Flow the annotated bounds of the entry functions into the signature
+    // vars of the internal functions they call, so bounded-dynamic tensors
+    // in callees are planned statically at the bound as well.
+    DeriveCallSiteVarBounds(mod, analyzer, &initializer.dom_map_);
 
     for (auto it : mod->functions) {
       const auto* func = it.second.as<FunctionNode>();
@@ -498,6 +707,7 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
   void VisitExpr_(const CallNode* call) final {
     static const Op& alloc_tensor_op = Op::Get("relax.builtin.alloc_tensor");
     static const Op& call_tir_dyn_op = Op::Get("relax.vm.call_tir_dyn");
+    static const Op& call_tir_inplace_op = Op::Get("relax.call_tir_inplace");
 
     if (call->op == alloc_tensor_op) {
       // Create a storage token for builtin alloc_tensor.
@@ -507,6 +717,25 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
       // Reuse the input's token for builtin reshape.
       SetTokens(call, GetTokens(call->args[0]));
       return;
+    } else if (call->op == call_tir_inplace_op) {
+      // An in-place call writes its result into the argument designated by the
+      // inplace indices, so the result aliases that argument's token instead of
+      // discarding it. The arguments are referenced like a PrimFunc call.
+      Array<Expr> args = Downcast<Tuple>(call->args[1])->fields;
+      ICHECK(!block_stack_.empty());
+      for (const Expr& arg : args) {
+        Tokens tokens = GetTokensWithAllocSiteCheck(arg, block_stack_.back());
+        ForEachLeaf(tokens, [](StorageToken token) { token->ref_counter += 1; });
+      }
+      const auto* attrs = call->attrs.as<CallTIRInplaceAttrs>();
+      ICHECK_NOTNULL(attrs);
+      if (attrs->inplace_indices.size() == 1) {
+        // Single-output form: the call result is the in-place argument itself.
+        // Multi-output in-place calls are left to the conservative path of the
+        // binding visitor, with their tokens unset.
+        SetTokens(call, GetTokens(args[attrs->inplace_indices[0].IntValue()]));
+      }
+      return;
     }
 
     // - Increase the reference counters of the arguments when the callee is
@@ -703,9 +932,14 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
       if (func == nullptr) {
         continue;
       }
-      // Clear the allocator to make the planning of different functions independent.
+      // Clear the allocator and the liveness statistics to make the planning
+      // of different functions independent.
       allocator_.Clear();
+      func_tokens_.clear();
+      liveness_.clear();
+      n_binding_steps_ = 0;
       this->VisitExpr_(func);
+      PlanHostSpill(GetRef<Function>(func));
     }
   }
 
@@ -732,6 +966,10 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     static const Op& alloc_tensor_op = Op::Get("relax.builtin.alloc_tensor");
+    static const Op& call_tir_inplace_op = Op::Get("relax.call_tir_inplace");
+    // Each call binding is one liveness step, so the use intervals of the
+    // tokens can be compared for spill planning.
+    ++n_binding_steps_;
     if (call->op == alloc_tensor_op) {
       auto it = token_map_.find(call);
       ICHECK(it != token_map_.end());
@@ -746,6 +984,7 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
 
       // Record that this alloc_tensor is using the token.
       alloc_tensor2token.insert({call, new_token});
+      Touch(new_token);
       token2cur_tensor_[new_token.get()].push_back(binding->var);
       SetTokens(call, Tokens(new_token));
       // Record that the token is allocated in the current block.
@@ -761,12 +1000,39 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
       ICHECK(!tokens.IsNested());
       if (tokens.IsLeaf()) {
         // If the input is using a token, record that the reshape uses the token as well.
+        Touch(tokens.LeafValue());
         token2cur_tensor_[tokens.LeafValue().get()].push_back(binding->var);
         SetTokens(call, tokens);
       } else {
         ICHECK(token_map_[call].IsNull());
       }
       return;
+    } else if (call->op == call_tir_inplace_op) {
+      Array<Expr> args = Downcast<Tuple>(call->args[1])->fields;
+      const auto* attrs = call->attrs.as<CallTIRInplaceAttrs>();
+      ICHECK_NOTNULL(attrs);
+      if (attrs->inplace_indices.size() == 1) {
+        Tokens tokens = GetTokens(args[attrs->inplace_indices[0].IntValue()]);
+        if (tokens.IsLeaf()) {
+          // The result shares the in-place argument's storage.
+          Touch(tokens.LeafValue());
+          token2cur_tensor_[tokens.LeafValue().get()].push_back(binding->var);
+          SetTokens(call, tokens);
+        }
+      }
+      // The reads of this call are done; release tokens that have no use left.
+      // Uses of the aliased result were counted during initialization, so the
+      // in-place token stays alive as long as the result is referenced.
+      for (const Expr& arg : args) {
+        Tokens tokens = GetTokens(arg);
+        ForEachLeaf(tokens, [this](StorageToken token) {
+          this->Touch(token);
+          ICHECK_GT(token->ref_counter, 0);
+          token->ref_counter -= 1;
+          this->CheckForRelease(token);
+        });
+      }
+      return;
     }
 
     // Decrease the reference counter by one for each token that the arguments use.
@@ -775,6 +1041,7 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
     for (const Expr& arg : call->args) {
       Tokens tokens = GetTokens(arg);
       ForEachLeaf(tokens, [this](StorageToken token) {
+        this->Touch(token);
         ICHECK_GT(token->ref_counter, 0);
         token->ref_counter -= 1;
         this->CheckForRelease(token);
@@ -786,12 +1053,92 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
   StorageToken RequestReuseOrAlloc(StorageToken prototype) {
     Optional<StorageToken> token = allocator_.RequestReuse(prototype);
     if (!token.defined()) {
-      return allocator_.Alloc(prototype, this->n_storage_++);
+      StorageToken allocated = allocator_.Alloc(prototype, this->n_storage_++);
+      func_tokens_.push_back(allocated);
+      return allocated;
     } else {
       return token.value();
     }
   }
 
+  /*! \brief Record a use of the token at the current liveness step. */
+  void Touch(const StorageToken& token) {
+    TokenLiveness& live = liveness_[token.get()];
+    if (live.n_uses == 0) {
+      live.first_use = n_binding_steps_;
+    }
+    live.last_use = n_binding_steps_;
+    ++live.n_uses;
+  }
+
+  /*!
+   * \brief The live span of the token per referencing binding. A storage that
+   * stays alive for long with few references is "cold": moving it off the
+   * device frees memory for the longest time at the cost of the fewest
+   * host/device transfers.
+   */
+  double Coldness(const StorageToken& token) const {
+    auto it = liveness_.find(token.get());
+    if (it == liveness_.end()) {
+      return std::numeric_limits<double>::max();
+    }
+    const TokenLiveness& live = it->second;
+    return static_cast<double>(live.last_use - live.first_use + 1) /
+           static_cast<double>(std::max<int64_t>(live.n_uses, 1));
+  }
+
+  /*!
+   * \brief Designate the coldest planned storages for pinned-host placement
+   * when the function is annotated with a device memory budget and the
+   * planned footprint of the statically sized storages exceeds it.
+   * \param func The function whose planned storages are to be checked.
+   */
+  void PlanHostSpill(const Function& func) {
+    Optional<IntImm> budget_attr = func->GetAttr<IntImm>("relax.memory_plan_device_budget");
+    if (!budget_attr.defined()) {
+      return;
+    }
+    int64_t budget = budget_attr.value()->value;
+    CHECK_GT(budget, 0) << "The attr `relax.memory_plan_device_budget` should be a positive "
+                        << "number of bytes. However " << budget << " is got.";
+    // Only the storages in the default scope with statically known sizes
+    // participate: other scopes are already placed deliberately, and
+    // dynamically sized storages cannot be accounted against the budget.
+    int64_t planned_bytes = 0;
+    std::vector<StorageToken> candidates;
+    for (const StorageToken& token : func_tokens_) {
+      if (token->storage_scope != "global") {
+        continue;
+      }
+      int64_t bytes = token->const_bytes();
+      if (bytes <= 0) {
+        continue;
+      }
+      planned_bytes += bytes;
+      candidates.push_back(token);
+    }
+    if (planned_bytes <= budget) {
+      return;
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [this](const StorageToken& lhs, const StorageToken& rhs) {
+                double lhs_coldness = Coldness(lhs);
+                double rhs_coldness = Coldness(rhs);
+                if (lhs_coldness != rhs_coldness) {
+                  return lhs_coldness > rhs_coldness;
+                }
+                // Break ties towards larger storages so fewer of them spill.
+                return lhs->const_bytes() > rhs->const_bytes();
+              });
+    for (const StorageToken& token : candidates) {
+      if (planned_bytes <= budget) {
+        break;
+      }
+      token->storage_scope = "global.pinned_host";
+      planned_bytes -= token->const_bytes();
+    }
+  }
+
   /*!
    * \brief Check if a token has no reference and thus can be released. And release it if so.
    * \param token The token to be checked.
@@ -809,12 +1156,28 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
     }
   }
 
+  /*! \brief The liveness statistics of a storage token used for spill planning. */
+  struct TokenLiveness {
+    /*! \brief The liveness step at which the token is used for the first time. */
+    int64_t first_use{0};
+    /*! \brief The liveness step at which the token is used for the last time. */
+    int64_t last_use{0};
+    /*! \brief The number of binding sites referencing the token. */
+    int64_t n_uses{0};
+  };
+
   /*! \brief Number of allocated storages. */
   int n_storage_{0};
   /*! \brief The 1D memory allocator. */
   TokenAllocator1D allocator_;
   /*! \brief The mapping from each token to the tensors that are currently using it. */
   std::unordered_map<const StorageTokenNode*, std::vector<Var>> token2cur_tensor_;
+  /*! \brief The number of call bindings visited so far in the current function. */
+  int64_t n_binding_steps_{0};
+  /*! \brief The storages allocated in the current function, in allocation order. */
+  std::vector<StorageToken> func_tokens_;
+  /*! \brief The liveness statistics of the tokens of the current function. */
+  std::unordered_map<const StorageTokenNode*, TokenLiveness> liveness_;
 };
 
 /*!
@@ -835,6 +1198,7 @@ class StorageAllocationRewriter : public ExprMutator {
 
   IRModule Rewrite() {
     const IRModule& mod = builder_->GetContextIRModule();
+    DeriveCallSiteVarBounds(mod, &ana_, &dom_map_);
     for (const auto& [gv, base_func] : mod->functions) {
       const auto* func_ = base_func.as<FunctionNode>();
       if (func_ == nullptr) {
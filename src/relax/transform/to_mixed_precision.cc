@@ -26,8 +26,10 @@
 #include <tvm/relax/transform.h>
 
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <unordered_set>
+#include <utility>
 
 #include "../op/nn/convolution.h"
 #include "../op/tensor/datatype.h"
@@ -40,14 +42,72 @@ namespace relax {
 
 using runtime::String;
 
-int GetMixedPrecisionInfo(const CallNode* call_node) {
+/*!
+ * \brief Optional calibration data that refines the static per-op policies.
+ *
+ * Both maps are keyed by op name (e.g. "relax.nn.softmax"). `absmax` holds the
+ * largest absolute output value observed for the op when running the fp32
+ * module on calibration inputs (e.g. collected with the
+ * `vm.builtin.value_range_profile_instrument` VM instrument). `fp16_speedup`
+ * holds the measured fp16-over-fp32 throughput ratio of the op on the target
+ * device; values at or below 1.0 mean fp16 gains nothing there.
+ */
+struct MixedPrecisionCalibration {
+  Optional<Map<String, FloatImm>> absmax;
+  Optional<Map<String, FloatImm>> fp16_speedup;
+};
+
+/*!
+ * \brief The largest calibrated absolute value considered safe to compute in
+ * fp16. Half of the fp16 maximum (65504), leaving headroom for inputs not
+ * covered by the calibration set.
+ */
+constexpr double kFp16CalibrationSafeMax = 65504.0 / 2;
+
+int GetMixedPrecisionInfo(const CallNode* call_node,
+                          const MixedPrecisionCalibration& calibration = {}) {
   const OpNode* op_node = call_node->op.as<OpNode>();
   if (op_node == nullptr) {
     return -1;
   }
   Op op = GetRef<Op>(op_node);
   auto attr_map = Op::GetAttrMap<TMixedPrecisionPolicy>("TMixedPrecisionPolicy");
-  return attr_map.count(op) ? attr_map[op] : MixedPrecisionPolicyKind::kNever;
+  int policy = attr_map.count(op) ? attr_map[op] : MixedPrecisionPolicyKind::kNever;
+  if (calibration.absmax.defined()) {
+    if (Optional<FloatImm> absmax = calibration.absmax.value().Get(op->name)) {
+      double observed = absmax.value()->value;
+      if (!std::isfinite(observed) || observed > kFp16CalibrationSafeMax) {
+        // The observed outputs do not fit fp16 even with headroom: keep this
+        // op in fp32, overriding kAlways/kFollow defaults.
+        return MixedPrecisionPolicyKind::kNever;
+      }
+      if (policy == MixedPrecisionPolicyKind::kNever) {
+        // The observed range fits fp16 with headroom, so the static kNever
+        // classification is overly conservative for this model. Let the op
+        // follow fp16 inputs, unless the device cost table explicitly reports
+        // no fp16 speedup for it.
+        bool profitable = true;
+        if (calibration.fp16_speedup.defined()) {
+          if (Optional<FloatImm> speedup = calibration.fp16_speedup.value().Get(op->name)) {
+            profitable = speedup.value()->value > 1.0;
+          }
+        }
+        if (profitable) {
+          policy = MixedPrecisionPolicyKind::kFollow;
+        }
+      }
+    }
+  }
+  if (policy == MixedPrecisionPolicyKind::kAlways && calibration.fp16_speedup.defined()) {
+    if (Optional<FloatImm> speedup = calibration.fp16_speedup.value().Get(op->name)) {
+      if (speedup.value()->value <= 1.0) {
+        // The device gains nothing from fp16 for this op (e.g. no tensor
+        // cores): do not actively insert casts, only follow fp16 inputs.
+        policy = MixedPrecisionPolicyKind::kFollow;
+      }
+    }
+  }
+  return policy;
 }
 
 /*!
@@ -78,6 +138,14 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
  * Note that in this case, we will actively cast the arg to fp16 only when it's used in kAlways.
  * This is to ensure that we have numerical stability to the best effort.
  *
+ * The static policies are conservative: they classify ops by kind, not by the value ranges a
+ * particular model actually produces. When calibration data is supplied (see
+ * MixedPrecisionCalibration), the policies are refined per model and per device in
+ * GetMixedPrecisionInfo: kNever ops whose observed outputs fit fp16 with headroom become kFollow,
+ * ops with observed fp16 overflow become kNever, and kAlways ops without a measured fp16 speedup
+ * on the device become kFollow. Both the collector and the rewriter consult the same refined
+ * policy.
+ *
  * DTypeDecisionCollector:
  *   Note that if some tensor is only used in kAlways ops, we can store it in fp16 without worsening
  *   numerical stability or using more storage. We use a backward propagation pass to detect such
@@ -116,10 +184,12 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
  */
 class DTypeDecisionCollector : public ExprVisitor {
  public:
-  explicit DTypeDecisionCollector(DataType output_dtype) : output_dtype_(output_dtype) {}
+  explicit DTypeDecisionCollector(DataType output_dtype, MixedPrecisionCalibration calibration)
+      : output_dtype_(output_dtype), calibration_(std::move(calibration)) {}
 
-  static VarDTypeMap Collect(Function func, DataType output_dtype) {
-    DTypeDecisionCollector collector(output_dtype);
+  static VarDTypeMap Collect(Function func, DataType output_dtype,
+                             const MixedPrecisionCalibration& calibration) {
+    DTypeDecisionCollector collector(output_dtype, calibration);
     collector.VisitExpr(func);
     return std::move(collector.only_fp16_map_);
   }
@@ -191,7 +261,7 @@ class DTypeDecisionCollector : public ExprVisitor {
   void VisitExpr_(const VarNode* op) final { VisitVars_(op); }
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = GetMixedPrecisionInfo(call_node, calibration_);
     if (policy == -1) {
       ExprVisitor::VisitBinding_(binding, call_node);
       return;
@@ -267,16 +337,19 @@ class DTypeDecisionCollector : public ExprVisitor {
   DataType fp16_ = DataType(DataType::TypeCode::kFloat, 16, 1);
   DataType fp32_ = DataType(DataType::TypeCode::kFloat, 32, 1);
   DataType output_dtype_;
+  MixedPrecisionCalibration calibration_;
   VarDTypeMap only_fp16_map_;
 };
 
 class ToMixedPrecisionRewriter : public ExprMutator {
  public:
   explicit ToMixedPrecisionRewriter(const VarDTypeMap* only_fp16_map, DataType output_dtype,
-                                    const std::unordered_set<std::string>& fp16_input_names)
+                                    const std::unordered_set<std::string>& fp16_input_names,
+                                    MixedPrecisionCalibration calibration)
       : only_fp16_map_(only_fp16_map),
         output_dtype_(output_dtype),
-        fp16_input_names_(fp16_input_names) {}
+        fp16_input_names_(fp16_input_names),
+        calibration_(std::move(calibration)) {}
 
  private:
   Var GetRemapped(const Var& var) {
@@ -456,7 +529,7 @@ class ToMixedPrecisionRewriter : public ExprMutator {
       ExprMutator::VisitBinding_(binding, call_node);
       return;
     }
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = GetMixedPrecisionInfo(call_node, calibration_);
     if (policy == -1) {
       // not an op call
       ExprMutator::VisitBinding_(binding, call_node);
@@ -596,27 +669,36 @@ class ToMixedPrecisionRewriter : public ExprMutator {
   DataType output_dtype_;
   Array<Var> params_;
   std::unordered_set<std::string> fp16_input_names_;
+  MixedPrecisionCalibration calibration_;
 
   const Op& wrap_param_op = Op::Get("relax.wrap_param");
 };
 
 Expr ToMixedPrecision(const Function& f, const DataType& out_dtype,
-                      Optional<Array<String>> fp16_input_names) {
-  VarDTypeMap only_fp16_map = std::move(DTypeDecisionCollector::Collect(f, out_dtype));
+                      Optional<Array<String>> fp16_input_names,
+                      Optional<Map<String, FloatImm>> calibrated_absmax,
+                      Optional<Map<String, FloatImm>> op_fp16_speedup) {
+  MixedPrecisionCalibration calibration{std::move(calibrated_absmax), std::move(op_fp16_speedup)};
+  VarDTypeMap only_fp16_map =
+      std::move(DTypeDecisionCollector::Collect(f, out_dtype, calibration));
   std::unordered_set<std::string> fp16_input_names_set;
   if (fp16_input_names) {
     fp16_input_names_set.insert(fp16_input_names.value().begin(), fp16_input_names.value().end());
   }
-  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set);
+  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set,
+                                   std::move(calibration));
   return mutator(f);
 }
 
 namespace transform {
 
-Pass ToMixedPrecision(const DataType& out_dtype, Optional<Array<String>> fp16_input_names) {
+Pass ToMixedPrecision(const DataType& out_dtype, Optional<Array<String>> fp16_input_names,
+                      Optional<Map<String, FloatImm>> calibrated_absmax,
+                      Optional<Map<String, FloatImm>> op_fp16_speedup) {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
-        return Downcast<Function>(ToMixedPrecision(f, out_dtype, fp16_input_names));
+        return Downcast<Function>(
+            ToMixedPrecision(f, out_dtype, fp16_input_names, calibrated_absmax, op_fp16_speedup));
       };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
@@ -53,6 +53,11 @@ ObjectRef TuningRecordNode::AsJSON(bool include_irmod) const {
                           run_secs};
 }
 
+ObjectRef TuningRecordNode::AsJSONDelta(const Trace& base) const {
+  return Array<ObjectRef>{trace->AsJSONDelta(base),  //
+                          run_secs};
+}
+
 TuningRecord TuningRecord::FromJSON(const ObjectRef& json_obj) {
   Trace trace{nullptr};
   Optional<Array<FloatImm>> run_secs{nullptr};
@@ -76,6 +81,30 @@ TuningRecord TuningRecord::FromJSON(const ObjectRef& json_obj) {
   return TuningRecord(trace, run_secs);
 }
 
+TuningRecord TuningRecord::FromJSON(const ObjectRef& json_obj, const Trace& base) {
+  Trace trace{nullptr};
+  Optional<Array<FloatImm>> run_secs{nullptr};
+  try {
+    const ArrayNode* json_array = json_obj.as<ArrayNode>();
+    CHECK(json_array && json_array->size() == 2);
+    // Load json[0] => trace, delta-encoded against `base` or full.
+    {
+      const ObjectRef& json_trace = json_array->at(0);
+      trace = Trace::IsJSONDelta(json_trace) ? Trace::FromJSONDelta(json_trace, base)
+                                             : Trace::FromJSON(json_trace);
+    }
+
+    // Load json[1] => run_secs
+    if (json_array->at(1).defined()) {
+      run_secs = meta_schedule::AsFloatArray(json_array->at(1));
+    }
+  } catch (const std::runtime_error& e) {  // includes tvm::Error and dmlc::Error
+    LOG(FATAL) << "ValueError: Unable to parse the JSON object: " << json_obj
+               << "\nThe error is: " << e.what();
+  }
+  return TuningRecord(trace, run_secs);
+}
+
 /*! \brief The struct defining comparison function of sorting by mean run seconds. */
 struct SortTuningRecordByMeanRunSecs {
   static const constexpr double kMaxMeanTime = 1e10;
@@ -125,6 +154,14 @@ class JSONDatabaseNode : public DatabaseNode {
   /*! \brief Measurement logs in the database */
   std::unordered_map<std::string, Array<FloatImm>> measurement_records_;
 
+  /*!
+   * \brief Per-key base trace that subsequent tuning records are delta-encoded against.
+   *
+   *  The first trace committed (or loaded) for a key becomes the base; later
+   *  records only serialize the suffix they add on top of the shared prefix.
+   */
+  std::unordered_map<std::string, Trace> trace_bases_;
+
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("path_workload", &path_workload);
     v->Visit("path_tuning_record", &path_tuning_record);
@@ -196,9 +233,17 @@ class JSONDatabaseNode : public DatabaseNode {
     std::string key = get_database_key(workload_idx, target);
     this->tuning_records_[key].insert(record);
 
+    // The first record for a key is stored in full and becomes the base that
+    // later records are delta-encoded against.
+    auto it = this->trace_bases_.find(key);
+    ObjectRef record_json = (it == this->trace_bases_.end()) ? record->AsJSON()
+                                                             : record->AsJSONDelta(it->second);
+    if (it == this->trace_bases_.end()) {
+      this->trace_bases_.emplace(key, record->trace);
+    }
     meta_schedule::JSONFileAppendLine(
         this->path_tuning_record, meta_schedule::JSONDumps(Array<ObjectRef>{
-                                      Integer(workload_idx), target->Export(), record->AsJSON()}));
+                                      Integer(workload_idx), target->Export(), record_json}));
   }
 
   Array<TuningRecord> GetTopK(const meta_schedule::Workload& workload, const Target& target,
@@ -259,6 +304,12 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
     workload_idxs.resize(size, -1);
     targets.resize(size, Target{nullptr});
     records.resize(size, TuningRecord{nullptr});
+    // Records with delta-encoded traces can only be decoded once the base trace
+    // of their key is available, so fully serialized records are parsed first.
+    auto is_delta_record = [](const ObjectRef& json_obj) -> bool {
+      const ArrayNode* arr = json_obj.as<ArrayNode>();
+      return arr && arr->size() == 2 && Trace::IsJSONDelta(arr->at(0));
+    };
     support::parallel_for_dynamic(
         0, json_objs.size(), num_threads, [&](int thread_id, int task_id) {
           const ObjectRef& json_obj = json_objs[task_id];
@@ -267,7 +318,36 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
             ICHECK_EQ(arr->size(), 3);
             workload_idxs[task_id] = Downcast<Integer>(arr->at(0)).IntValue();
             targets[task_id] = Target(Downcast<Map<String, ObjectRef>>(arr->at(1)));
-            records[task_id] = TuningRecord::FromJSON(arr->at(2));
+            if (!is_delta_record(arr->at(2))) {
+              records[task_id] = TuningRecord::FromJSON(arr->at(2));
+            }
+          } catch (std::runtime_error& e) {
+            LOG(FATAL) << "ValueError: Unable to parse the JSON object: " << json_obj
+                       << "\nThe error is: " << e.what();
+          }
+        });
+
+    // The first full record per key, in file order, is the base for that key.
+    for (int i = 0; i < size; i++) {
+      if (records[i].defined()) {
+        std::string key = get_database_key(workload_idxs[i], targets[i]);
+        n->trace_bases_.emplace(key, records[i]->trace);
+      }
+    }
+
+    support::parallel_for_dynamic(
+        0, json_objs.size(), num_threads, [&](int thread_id, int task_id) {
+          if (records[task_id].defined()) {
+            return;
+          }
+          const ObjectRef& json_obj = json_objs[task_id];
+          try {
+            const ArrayNode* arr = json_obj.as<ArrayNode>();
+            std::string key = get_database_key(workload_idxs[task_id], targets[task_id]);
+            auto it = n->trace_bases_.find(key);
+            CHECK(it != n->trace_bases_.end())
+                << "ValueError: Delta-encoded tuning record has no base trace for key " << key;
+            records[task_id] = TuningRecord::FromJSON(arr->at(2), it->second);
           } catch (std::runtime_error& e) {
             LOG(FATAL) << "ValueError: Unable to parse the JSON object: " << json_obj
                        << "\nThe error is: " << e.what();
@@ -324,7 +404,13 @@ TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecord")
     });
 TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecordAsJSON")
     .set_body_method<TuningRecord>(&TuningRecordNode::AsJSON);
-TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecordFromJSON").set_body_typed(TuningRecord::FromJSON);
+TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecordAsJSONDelta")
+    .set_body_method<TuningRecord>(&TuningRecordNode::AsJSONDelta);
+TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecordFromJSON")
+    .set_body_typed(static_cast<TuningRecord (*)(const ObjectRef&)>(TuningRecord::FromJSON));
+TVM_REGISTER_GLOBAL("relax.tuning_api.TuningRecordFromJSONDelta")
+    .set_body_typed(static_cast<TuningRecord (*)(const ObjectRef&, const Trace&)>(
+        TuningRecord::FromJSON));
 
 TVM_REGISTER_OBJECT_TYPE(DatabaseNode);
 TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseHasWorkload")
@@ -192,6 +192,91 @@ ObjectRef TraceNode::AsJSON(bool include_in_mod) const {
   }
 }
 
+ObjectRef TraceNode::AsJSONDelta(const Trace& base) const {
+  ICHECK(this->Verify()) << "Trace should be valid";
+
+  // Knobs are shared by reference while a search extends a trace, so pointer
+  // identity is enough to find the common prefix.
+  int prefix = 0;
+  int base_size = base->size;
+  while (prefix < this->size && prefix < base_size &&
+         this->knobs[prefix].same_as(base->knobs[prefix]) &&
+         this->decisions[prefix] == base->decisions[prefix]) {
+    prefix++;
+  }
+
+  Array<ObjectRef> json_knobs;
+  Array<ObjectRef> json_decisions;
+  json_knobs.reserve(this->size - prefix);
+  json_decisions.reserve(this->size - prefix);
+  for (int i = prefix; i < this->size; i++) {
+    json_knobs.push_back(this->knobs[i]->AsJSON());
+    json_decisions.push_back(this->decisions[i]);
+  }
+  return Array<ObjectRef>{Integer(prefix), json_knobs, json_decisions};
+}
+
+bool Trace::IsJSONDelta(const ObjectRef& json) {
+  const ArrayNode* arr = json.as<ArrayNode>();
+  // A full trace serialization starts with the knob array; a delta starts with
+  // the shared prefix length.
+  return arr && arr->size() == 3 && arr->at(0)->IsInstance<IntImmNode>();
+}
+
+Trace Trace::FromJSONDelta(const ObjectRef& json, const Trace& base) {
+  int prefix = 0;
+  Array<Knob> knobs;
+  Array<String> decisions;
+  try {
+    const ArrayNode* arr = json.as<ArrayNode>();
+    ICHECK(arr && arr->size() == 3);
+
+    prefix = Downcast<Integer>(arr->at(0)).IntValue();
+    const auto* arr1 = arr->at(1).as<ArrayNode>();
+    const auto* arr2 = arr->at(2).as<ArrayNode>();
+    ICHECK(arr1 && arr2);
+    ICHECK(prefix >= 0 && prefix <= base->size)
+        << "ValueError: Delta prefix exceeds the base trace";
+
+    // Structurally share the prefix with the base trace.
+    knobs.reserve(prefix + arr1->size());
+    decisions.reserve(prefix + arr2->size());
+    for (int i = 0; i < prefix; i++) {
+      knobs.push_back(base->knobs[i]);
+      decisions.push_back(base->decisions[i]);
+    }
+    for (const ObjectRef& elem : *arr1) {
+      knobs.push_back(Knob::FromJSON(elem));
+    }
+    for (const ObjectRef& elem : *arr2) {
+      decisions.push_back(Downcast<String>(elem));
+    }
+  } catch (const tvm::Error& e) {
+    LOG(FATAL) << "ValueError: Malformed Trace delta format - " << json;
+    throw;
+  }
+
+  // When the delta extends the whole base trace, resume the replay from the
+  // base's output module instead of re-applying the full history.
+  if (prefix == base->size && base->out_mod.defined()) {
+    auto func_deepcopy = runtime::Registry::Get("relax.tuning_api.deepcopy_irmodule");
+    ICHECK(func_deepcopy);
+    IRModule out_mod = (*func_deepcopy)(base->out_mod);
+    int size = knobs.size();
+    for (int i = prefix; i < size; i++) {
+      out_mod = knobs[i]->Apply(out_mod, decisions[i]);
+    }
+    ObjectPtr<TraceNode> n = make_object<TraceNode>();
+    n->in_mod = base->in_mod;
+    n->out_mod = std::move(out_mod);
+    n->knobs = std::move(knobs);
+    n->decisions = std::move(decisions);
+    n->size = size;
+    return Trace(n);
+  }
+  return Trace(base->in_mod, knobs, decisions);
+}
+
 Trace Trace::FromJSON(const ObjectRef& json) {
   // Parse `json` into `trace`
   IRModule in_mod;
@@ -269,5 +354,8 @@ TVM_REGISTER_GLOBAL("relax.tuning_api.TraceSetOutMod")
 
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceAsJSON").set_body_method<Trace>(&TraceNode::AsJSON);
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceFromJSON").set_body_typed(Trace::FromJSON);
+TVM_REGISTER_GLOBAL("relax.tuning_api.TraceAsJSONDelta")
+    .set_body_method<Trace>(&TraceNode::AsJSONDelta);
+TVM_REGISTER_GLOBAL("relax.tuning_api.TraceFromJSONDelta").set_body_typed(Trace::FromJSONDelta);
 }  // namespace relax
 }  // namespace tvm
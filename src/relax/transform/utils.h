@@ -117,6 +117,18 @@ class MemoizedExprTranslator : public ::tvm::relax::ExprFunctor<OutputType(const
  */
 TVM_DLL IRModule DeadCodeElimination(const IRModule& mod, Array<runtime::String> entry_funcs);
 
+/*!
+ * \brief Bind symbolic vars of a function to constant shape values.
+ *
+ * \param func The function to update.
+ * \param obj_remap The map of symbolic variables to their constant shape
+ *     values.  Keys may be either a `tir::Var` or a string name of the
+ *     variable.  If referred to by name, the name must uniquely identify a
+ *     symbolic variable of the function.
+ * \return The updated function.
+ */
+TVM_DLL Function FunctionBindSymbolicVars(Function func, Map<ObjectRef, PrimExpr> obj_remap);
+
 /*!
  * \brief Get the external symbol of the Relax function name.
  *
@@ -437,6 +449,38 @@ Expr CanonicalizeBindings(Expr expr);
  */
 Function BundleModelParams(const Function& func, Optional<String> param_tuple_name = NullOpt);
 
+/*! \brief Rewrite a function to fetch each model parameter on demand
+ *
+ * Replaces the model parameters (those after the `kNumInput` attribute)
+ * with a single `fget_param` callback parameter that is invoked at the
+ * first use of each parameter.
+ *
+ * \param func The function to be updated.
+ *
+ * \ret The updated function.
+ */
+Function WithLazyInputs(Function func);
+
+/*! \brief Rewrite a function to deliver each output as soon as it is computed
+ *
+ * Adds an `fset_output` callback parameter that is invoked with each
+ * element of the returned tuple immediately after the producing binding.
+ *
+ * \param func The function to be updated.
+ *
+ * \ret The updated function.
+ */
+Function WithLazyOutputs(Function func);
+
+/*! \brief Kill tensor/storage/object bindings after their last use
+ *
+ * \param expr The expression to be updated.  Should not contain
+ * dataflow blocks, as the inserted kill operators are impure.
+ *
+ * \ret The updated expression.
+ */
+Expr KillAfterLastUse(Expr expr);
+
 }  // namespace relax
 }  // namespace tvm
 
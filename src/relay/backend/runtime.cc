@@ -88,7 +88,9 @@ RuntimeRegEntry& RuntimeRegEntry::RegisterOrGet(const String& name) {
 
 /**********  Register Runtimes and options  **********/
 
-TVM_REGISTER_RUNTIME(kTvmRuntimeCrt).add_attr_option<runtime::Bool>("system-lib");
+TVM_REGISTER_RUNTIME(kTvmRuntimeCrt)
+    .add_attr_option<runtime::Bool>("system-lib")
+    .add_attr_option<runtime::Bool>("static-dispatch");
 
 TVM_REGISTER_RUNTIME(kTvmRuntimeCpp).add_attr_option<runtime::Bool>("system-lib");
 
@@ -93,6 +93,8 @@
 #include <tvm/ir/attrs.h>
 #include <tvm/ir/function.h>
 #include <tvm/ir/name_supply.h>
+#include <tvm/node/serialization.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/attrs/call.h>
@@ -107,14 +109,21 @@
 #include <tvm/tir/transform.h>
 #include <tvm/topi/tags.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../../runtime/file_utils.h"
 #include "../op/annotation/annotation.h"
 #include "../op/call/call.h"
 #include "../op/memory/device_copy.h"
@@ -133,6 +142,104 @@ using namespace tvm::relay::transform;
 
 TVM_REGISTER_OBJECT_TYPE(TECompilerNode);
 
+namespace {
+
+/*!
+ * \brief Directory of the persistent lowering cache shared across processes.
+ *
+ * Configured by the environment variable TVM_RELAY_LOWERING_CACHE_DIR; unset
+ * disables the cache. Entries are keyed by the structural hash of the
+ * primitive function together with the target string, so repeated builds of
+ * structurally identical fused subgraphs (e.g. across CI runs) reuse the
+ * already-lowered PrimFuncs instead of scheduling them again.
+ */
+std::string LoweringCacheDir() {
+  static std::string dir = []() -> std::string {
+    const char* val = std::getenv("TVM_RELAY_LOWERING_CACHE_DIR");
+    return val == nullptr ? std::string() : std::string(val);
+  }();
+  return dir;
+}
+
+/*! \brief Returns the cache entry path for \p key, or "" when the cache is disabled. */
+std::string LoweringCacheEntryPath(const CCacheKey& key) {
+  const std::string& dir = LoweringCacheDir();
+  if (dir.empty()) return "";
+  std::ostringstream os;
+  os << dir << "/" << std::hex << StructuralHash()(key->source_func) << "_"
+     << std::hash<std::string>()(key->target->str());
+  if (!key->virtual_device->IsFullyUnconstrained()) {
+    os << "_" << StructuralHash()(key->virtual_device);
+  }
+  os << ".bin";
+  return os.str();
+}
+
+/*!
+ * \brief Attempts to load a previously lowered function from the persistent cache.
+ *
+ * All global names introduced by the entry are reserved with
+ * \p global_var_supply; if any of them is already taken in the module being
+ * compiled the entry is ignored and lowering proceeds from scratch, which
+ * produces fresh unique names.
+ *
+ * \return The cached function, or a null ref on miss.
+ */
+CachedFunc TryLoadCachedFuncFromDisk(const std::string& path, GlobalVarSupply global_var_supply) {
+  auto mapping = runtime::MemoryMappedFile::Open(path);
+  if (mapping == nullptr) return CachedFunc(nullptr);
+  ObjectRef loaded;
+  try {
+    loaded = LoadBinary(std::string(mapping->data(), mapping->size()));
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Ignoring corrupt lowering cache entry '" << path << "': " << e.what();
+    return CachedFunc(nullptr);
+  }
+  auto cached_func = Downcast<CachedFunc>(loaded);
+  if (global_var_supply->name_supply_->ContainsName(cached_func->prim_fn_var->name_hint, false)) {
+    return CachedFunc(nullptr);
+  }
+  for (const auto& kv : cached_func->funcs->functions) {
+    if (!kv.first.same_as(cached_func->prim_fn_var) &&
+        global_var_supply->name_supply_->ContainsName(kv.first->name_hint, false)) {
+      return CachedFunc(nullptr);
+    }
+  }
+  global_var_supply->ReserveGlobalVar(cached_func->prim_fn_var);
+  for (const auto& kv : cached_func->funcs->functions) {
+    if (!kv.first.same_as(cached_func->prim_fn_var)) {
+      global_var_supply->ReserveGlobalVar(kv.first);
+    }
+  }
+  return cached_func;
+}
+
+/*! \brief Persists a lowered function, writing via a temporary so concurrent
+ *  builds never observe a partial entry. Failures only disable the cache entry. */
+void SaveCachedFuncToDisk(const CachedFunc& cached_func, const std::string& path) {
+  auto n = make_object<CachedFuncNode>(*cached_func.operator->());
+  // The schedule is only needed while lowering; drop it from the persisted entry.
+  n->schedule = te::Schedule{nullptr};
+  n->constant_tensors.clear();
+  std::string blob = SaveBinary(CachedFunc(n));
+  std::ostringstream tmp;
+  tmp << path << "." << std::random_device()() << ".part";
+  std::string tmp_path = tmp.str();
+  std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+  if (fs.fail()) {
+    LOG(WARNING) << "Cannot write lowering cache entry '" << tmp_path << "'";
+    return;
+  }
+  fs.write(blob.data(), blob.size());
+  fs.close();
+  if (fs.fail() || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Cannot publish lowering cache entry '" << path << "'";
+    std::remove(tmp_path.c_str());
+  }
+}
+
+}  // namespace
+
 class TECompilerImpl : public TECompilerNode {
  public:
   explicit TECompilerImpl(Optional<IRModule> opt_mod, Optional<String> opt_mod_name)
@@ -386,6 +493,18 @@ class TECompilerImpl : public TECompilerNode {
       return value;
     }
 
+    // Consult the persistent lowering cache before doing any scheduling work.
+    std::string disk_cache_path = LoweringCacheEntryPath(key);
+    if (!disk_cache_path.empty()) {
+      CachedFunc disk_func = TryLoadCachedFuncFromDisk(disk_cache_path, global_var_supply);
+      if (disk_func.defined()) {
+        VLOG(1) << "persistent lowering cache hit, reusing name:" << std::endl
+                << PrettyPrint(disk_func->prim_fn_var);
+        value->cached_func = disk_func;
+        return value;
+      }
+    }
+
     // Enforce use the target.
     With<Target> target_scope(key->target);
 
@@ -465,6 +584,10 @@ class TECompilerImpl : public TECompilerNode {
             << "with definitions:" << std::endl
             << PrettyPrint(value->cached_func->funcs);
 
+    if (!disk_cache_path.empty()) {
+      SaveCachedFuncToDisk(value->cached_func, disk_cache_path);
+    }
+
     return value;
   }
 
@@ -29,6 +29,7 @@
 #include <tvm/relay/transform.h>
 
 #include <stack>
+#include <unordered_set>
 
 #include "dataflow_matcher_impl.h"
 
@@ -606,6 +607,31 @@ class MatchExtractor : public ExprMutator {
   const std::unordered_map<Expr, Var, ObjectPtrHash, ObjectPtrEqual> inputs_;
 };
 
+bool CollectPatternRootOps(const DFPattern& pattern, std::unordered_set<const OpNode*>* root_ops) {
+  if (const auto* call_pattern = pattern.as<CallPatternNode>()) {
+    return CollectPatternRootOps(call_pattern->op, root_ops);
+  } else if (const auto* expr_pattern = pattern.as<ExprPatternNode>()) {
+    if (const auto* op_node = expr_pattern->expr.as<OpNode>()) {
+      root_ops->insert(op_node);
+      return true;
+    }
+    return false;
+  } else if (const auto* alt_pattern = pattern.as<AltPatternNode>()) {
+    return CollectPatternRootOps(alt_pattern->left, root_ops) &&
+           CollectPatternRootOps(alt_pattern->right, root_ops);
+  } else if (const auto* attr_pattern = pattern.as<AttrPatternNode>()) {
+    return CollectPatternRootOps(attr_pattern->pattern, root_ops);
+  } else if (const auto* type_pattern = pattern.as<TypePatternNode>()) {
+    return CollectPatternRootOps(type_pattern->pattern, root_ops);
+  } else if (const auto* shape_pattern = pattern.as<ShapePatternNode>()) {
+    return CollectPatternRootOps(shape_pattern->pattern, root_ops);
+  } else if (const auto* dtype_pattern = pattern.as<DataTypePatternNode>()) {
+    return CollectPatternRootOps(dtype_pattern->pattern, root_ops);
+  }
+  // Wildcards, vars, dominators etc. may match arbitrary expressions.
+  return false;
+}
+
 /*! \brief Group expressions that match the pattern */
 const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatches(
     const DFPattern& pattern, const Expr& pre) {
@@ -614,6 +640,8 @@ const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatch
 
   pattern_ = pattern;
   pattern_graph_ = CreateIndexedGraph(pattern_);
+  root_ops_.clear();
+  root_ops_resolved_ = CollectPatternRootOps(pattern_, &root_ops_);
   std::unique_ptr<IndexedGraph<Expr>> expr_graph = CreateIndexedGraph(pre);
   DFPatternMatcher matcher(expr_graph.get());
   matcher_ = &matcher;
@@ -622,6 +650,20 @@ const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatch
 }
 
 void PatternGrouper::VisitExprs() {
+  // A pattern whose root resolves to a known op set can only match calls to one
+  // of those ops, so only nodes in the matching op-signature bucket are tried.
+  auto may_match_root = [this](const Expr& expr) {
+    if (!root_ops_resolved_) {
+      return true;
+    }
+    const CallNode* call_node = expr.as<CallNode>();
+    if (call_node == nullptr) {
+      return false;
+    }
+    const OpNode* op_node = call_node->op.as<OpNode>();
+    return op_node != nullptr && root_ops_.count(op_node) != 0;
+  };
+
   std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> pre_partitioned;
   for (PostDfsIndex i = matcher_->size(); i != 0; --i) {
     PostDfsIndex index = i - 1;
@@ -634,7 +676,8 @@ void PatternGrouper::VisitExprs() {
                          [&pre_partitioned](const Expr& expr) { pre_partitioned.insert(expr); });
         }
       }
-      if (pre_partitioned.count(current) == 0 && matcher_->Match(pattern_, current)) {
+      if (pre_partitioned.count(current) == 0 && may_match_root(current) &&
+          matcher_->Match(pattern_, current)) {
         CreateGroup(current);
       }
     }
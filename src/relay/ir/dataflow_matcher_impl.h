@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "indexed_graph.h"
@@ -86,6 +87,21 @@ class DFPatternMatcher : public DFPatternFunctor<bool(const DFPattern&, const Ex
   bool memoize_ = true;
 };
 
+/*!
+ * \brief Collect the set of operators the root of a pattern can match.
+ *
+ *  Patterns rooted at a call to a known operator (possibly behind Alt/Attr/Type/
+ *  Shape/DataType wrappers) can only match call expressions to one of those
+ *  operators, which lets the matcher restrict its traversal to the matching
+ *  op-signature bucket of the expression graph instead of attempting a match at
+ *  every node.
+ * \param pattern The pattern to analyze.
+ * \param root_ops Output set of operators the root can match.
+ * \return Whether the root op set could be fully resolved. When false the
+ *  pattern root may match arbitrary expressions and no filtering is possible.
+ */
+bool CollectPatternRootOps(const DFPattern& pattern, std::unordered_set<const OpNode*>* root_ops);
+
 /*!
  * \brief PatternGrouper does pre-rewriting pattern matching and analysis
  *
@@ -146,6 +162,10 @@ class PatternGrouper {
   std::unordered_map<Expr, int, ObjectPtrHash, ObjectPtrEqual> gid_assignments_;
   DFPatternMatcher* matcher_ = nullptr;
   std::unique_ptr<IndexedGraph<DFPattern>> pattern_graph_;
+  /*! \brief Operators the pattern root can match, when resolvable. */
+  std::unordered_set<const OpNode*> root_ops_;
+  /*! \brief Whether root_ops_ is exhaustive and may be used to filter candidates. */
+  bool root_ops_resolved_ = false;
   int gid_ = 0;
   int graph_number_ = 0;
 };
@@ -32,8 +32,10 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/target/virtual_device.h>
 
+#include <atomic>
 #include <fstream>
 
 #include "../../support/scalars.h"
@@ -295,6 +297,14 @@ class Parser {
   /*! \brief Configure the whitespace mode, right now we ignore all whitespace. */
   bool ignore_whitespace;
 
+  /*! \brief Whether to attach spans to the parsed AST.
+   *
+   * Span construction merges a span per AST node, which is a measurable share of
+   * parse time on large modules. Disabling it trades source-location quality in
+   * downstream diagnostics for parse throughput.
+   */
+  bool track_spans = true;
+
   /*! \brief A global mapping for GlobalVar. */
   InternTable<GlobalVar> global_names;
 
@@ -570,6 +580,9 @@ class Parser {
 
   template <typename R>
   R WithSpan(std::function<R()> parser) {
+    if (!track_spans) {
+      return parser();
+    }
     auto start_span = Peek()->span;
     VLOG(9) << "WithSpan: start_span = " << start_span;
     R ast = parser();
@@ -722,6 +735,94 @@ class Parser {
     return module;
   }
 
+  /*! \brief Attempt to parse a module with its global functions parsed in parallel.
+   *
+   * The token stream is split at top-level `def` keywords, each segment is parsed
+   * by an isolated parser over its own slice of the stream, and the results are
+   * stitched into the module.
+   *
+   * The fast path only handles modules made of function definitions. Anything that
+   * introduces shared parsing state across segments (type definitions bind
+   * constructor names the other definitions may use) or any parse failure makes
+   * this method report false so the caller can fall back to the serial parser,
+   * which also produces the proper diagnostics.
+   *
+   * \param out The parsed module on success.
+   * \return Whether the parallel parse succeeded.
+   */
+  bool TryParseModuleParallel(IRModule* out) {
+    std::vector<int> defn_positions;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      switch (tokens[i]->token_type) {
+        case TokenType::kDefn:
+          defn_positions.push_back(static_cast<int>(i));
+          break;
+        case TokenType::kTypeDef:
+        case TokenType::kExtern:
+          return false;
+        default:
+          break;
+      }
+    }
+    if (defn_positions.size() < 2) {
+      return false;
+    }
+
+    this->version = ParseSemVer();
+
+    // Global variables must be unique objects across all segments, so intern every
+    // global name up front; afterwards the intern table is read-only and each
+    // worker can operate on its own copy of it.
+    for (const auto& token : tokens) {
+      if (token->token_type == TokenType::kGlobal) {
+        AddOrGet(&global_names, token.ToString());
+      }
+    }
+
+    int num_defns = static_cast<int>(defn_positions.size());
+    std::vector<GlobalFunc> funcs(num_defns);
+    std::atomic<bool> failed{false};
+    support::parallel_for(0, num_defns, [&](int i) {
+      int begin = defn_positions[i];
+      int end = i + 1 < num_defns ? defn_positions[i + 1] : static_cast<int>(tokens.size());
+      std::vector<Token> segment(tokens.begin() + begin, tokens.begin() + end);
+      try {
+        Parser worker(module, DiagnosticContext::Default(module), source, std::move(segment),
+                      op_table, meta_table);
+        worker.track_spans = track_spans;
+        worker.version = version;
+        worker.global_names = global_names;
+        worker.type_names = type_names;
+        worker.ctors = ctors;
+        worker.Consume(TokenType::kDefn);
+        auto global_tok = worker.Match(TokenType::kGlobal);
+        auto global = AddOrGet(&worker.global_names, global_tok.ToString());
+        auto func = worker.WithSpan<relay::Function>([&]() { return worker.ParseFunctionDef(); });
+        // A segment that had to invent a new global or type name would not share it
+        // with its sibling segments; such modules need the serial parser.
+        if (worker.global_names.table.size() != global_names.table.size() ||
+            worker.type_names.table.size() != type_names.table.size()) {
+          failed = true;
+          return;
+        }
+        funcs[i] = GlobalFunc(global, func);
+      } catch (const std::exception& e) {
+        failed = true;
+      }
+    });
+    if (failed) {
+      return false;
+    }
+
+    for (auto& func : funcs) {
+      module->Add(func.global, func.function, true);
+    }
+    // The metadata section, if any, was already captured by the tokenizer and is
+    // threaded through meta_table, so there is nothing left to parse here.
+    *out = module;
+    return true;
+  }
+
   /*! \brief Parse the semantic versioning header. */
   SemVer ParseSemVer(bool required = true) {
     if (Peek()->token_type == TokenType::kVersion) {
@@ -755,7 +856,7 @@ class Parser {
           auto global_name = global_tok.ToString();
           auto global = AddOrGet(&global_names, global_name);
           auto func = WithSpan<relay::Function>([&]() { return ParseFunctionDef(); });
-          ICHECK(func->span.defined()) << "spans must be set in parser";
+          ICHECK(!track_spans || func->span.defined()) << "spans must be set in parser";
           defs.funcs.push_back(GlobalFunc(global, func));
           continue;
         }
@@ -952,11 +1053,12 @@ class Parser {
         exprs.pop_back();
         while (exprs.size()) {
           auto value = exprs.back();
-          ICHECK(value->span.defined()) << "parser must set expression spans.";
+          ICHECK(!track_spans || value->span.defined()) << "parser must set expression spans.";
           exprs.pop_back();
-          body = relay::Let(Var("", IncompleteType()), value, body, value->span.Merge(body->span));
+          Span span = track_spans ? value->span.Merge(body->span) : Span();
+          body = relay::Let(Var("", IncompleteType()), value, body, span);
         }
-        ICHECK(body->span.defined()) << "parser must set expression spans.";
+        ICHECK(!track_spans || body->span.defined()) << "parser must set expression spans.";
         return body;
       }
     });
@@ -1048,7 +1150,7 @@ class Parser {
         } else {
           // We can now build the let binding up backwards.
           for (auto binding = bindings.rbegin(); binding != bindings.rend(); binding++) {
-            auto span = body->span.Merge(std::get<2>(*binding));
+            auto span = track_spans ? body->span.Merge(std::get<2>(*binding)) : Span();
             body = relay::Let(std::get<0>(*binding), std::get<1>(*binding), body, span);
           }
           return body;
@@ -1286,7 +1388,7 @@ class Parser {
         auto op = opt_op[0];
 
         Expr right = WithSpan<Expr>([this] { return ParseCallExpr(); });
-        ICHECK(right->span.defined());
+        ICHECK(!track_spans || right->span.defined());
 
         // If the operator stack is empty
         // we parse an operator and expression
@@ -1314,8 +1416,8 @@ class Parser {
           Expr left = exprs.back();
           exprs.pop_back();
           ICHECK(new_op.op.defined()) << "a call op must be set " << new_op.op;
-          exprs.push_back(
-              relay::Call(new_op.op, {left, right}, Attrs(), {}, left->span.Merge(right->span)));
+          Span span = track_spans ? left->span.Merge(right->span) : Span();
+          exprs.push_back(relay::Call(new_op.op, {left, right}, Attrs(), {}, span));
         }
 
         exprs.push_back(right);
@@ -1330,8 +1432,8 @@ class Parser {
         Expr left = exprs.back();
         exprs.pop_back();
         ICHECK(new_op.op.defined()) << "a call op must be set " << new_op.op;
-        exprs.push_back(
-            relay::Call(new_op.op, {left, right}, Attrs(), {}, left->span.Merge(right->span)));
+        Span span = track_spans ? left->span.Merge(right->span) : Span();
+        exprs.push_back(relay::Call(new_op.op, {left, right}, Attrs(), {}, span));
       }
 
       ICHECK_EQ(ops.size(), 0) << "No operations should be left on the operation stack.";
@@ -1579,7 +1681,7 @@ class Parser {
         case TokenType::kFn: {
           Consume(TokenType::kFn);
           Expr e = ParseFunctionDef();
-          ICHECK(e->span.defined()) << "function spans must be defined.\n" << e;
+          ICHECK(!track_spans || e->span.defined()) << "function spans must be defined.\n" << e;
           return e;
         }
         case TokenType::kIf: {
@@ -1634,8 +1736,10 @@ class Parser {
                   auto element = ParseExpr();
                   auto comma = Peek();
                   if (WhenMatch(TokenType::kComma)) {
-                    sp = sp.Merge(element->span.Merge(comma->span));
-                  } else {
+                    if (track_spans) {
+                      sp = sp.Merge(element->span.Merge(comma->span));
+                    }
+                  } else if (track_spans) {
                     sp = sp.Merge(element->span);
                   }
                   exprs.push_back(element);
@@ -1658,7 +1762,7 @@ class Parser {
     if (WhenMatch(TokenType::kPeriod)) {
       auto token = Match(TokenType::kInteger);
       auto index = token.ToNumber();
-      auto span = token->span.Merge(expr->span);
+      auto span = track_spans ? token->span.Merge(expr->span) : Span();
       VLOG(9) << "Parser::ParseAtomicExpr: tuple get item";
       return relay::TupleGetItem(expr, index, span);
     } else {
@@ -1917,17 +2021,42 @@ Parser InitParser(const std::string& file_name, const std::string& file_content,
   return Parser(module, diag_ctx, source, tokens, DefaultOpTable(), std::move(meta_data_table));
 }
 
+// Disabling span tracking skips per-node span construction for parse throughput, at
+// the price of source locations in downstream diagnostics.
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.parser.track_spans", Bool);
+// Parse independent global functions in parallel after a top-level split of the
+// token stream; modules the fast path cannot handle fall back to the serial parser.
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.parser.parallel_parse", Bool);
+
 IRModule ParseModule(const std::string& file_name, const std::string& file_content,
                      const Optional<IRModule>& init_module, const MetaTable& init_meta_table) {
   VLOG_CONTEXT << "ParseModule";
   VLOG(9) << "parsing and type-checking " << file_name;
-  auto parser = InitParser(file_name, file_content, init_module, init_meta_table);
-  auto mod = parser.ParseModule();
-  ICHECK(mod.defined()) << "The parser must return a non-null module.";
-  // NB(@jroesch): it is very important that we render any errors before we proceed
-  // if there were any errors which allow the parser to proceed we must render them
-  // here.
-  parser.diag_ctx.Render();
+  PassContext pass_ctx = PassContext::Current();
+  bool track_spans = pass_ctx->GetConfig<Bool>("relay.parser.track_spans", Bool(true)).value();
+  bool parallel_parse =
+      pass_ctx->GetConfig<Bool>("relay.parser.parallel_parse", Bool(false)).value();
+
+  IRModule mod;
+  bool parsed = false;
+  if (parallel_parse) {
+    auto parser = InitParser(file_name, file_content, init_module, init_meta_table);
+    parser.track_spans = track_spans;
+    parsed = parser.TryParseModuleParallel(&mod);
+    if (parsed) {
+      parser.diag_ctx.Render();
+    }
+  }
+  if (!parsed) {
+    auto parser = InitParser(file_name, file_content, init_module, init_meta_table);
+    parser.track_spans = track_spans;
+    mod = parser.ParseModule();
+    ICHECK(mod.defined()) << "The parser must return a non-null module.";
+    // NB(@jroesch): it is very important that we render any errors before we proceed
+    // if there were any errors which allow the parser to proceed we must render them
+    // here.
+    parser.diag_ctx.Render();
+  }
   auto infer_type = tvm::relay::transform::InferType();
   ICHECK(infer_type.defined()) << "The type inferencer must be non-null.";
   return infer_type(mod);
@@ -25,6 +25,7 @@
  */
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
 #include <tvm/te/operation.h>
@@ -144,6 +145,53 @@ Expr ConvertLayout(const Expr& expr, const Map<String, Array<String>>& desired_l
   return ForwardRewrite(expr, LayoutRewriter<ConvertTransformMemorizer>, fcontext);
 }
 
+/*! \brief Fixed cost charged for a layout transform whose shape is not fully static. */
+constexpr int64_t kDynamicLayoutTransformCost = 1LL << 20;
+
+/*!
+ * \brief Estimate the data-movement cost the layout assignment of a module induces.
+ *
+ *  The cost of one layout_transform operator is the number of elements of its result,
+ *  i.e. the volume of data it has to shuffle; the module cost is the sum over all of
+ *  them. Kernel-speedup terms are intentionally out of scope here: they depend on
+ *  tuning records that are not available at this stage, so the search compares
+ *  assignments by the transform traffic they force on the graph.
+ *
+ * \param mod The module with populated checked types.
+ * \return The total estimated cost.
+ */
+int64_t EstimateLayoutTransformCost(const IRModule& mod) {
+  static const Op& layout_transform_op = Op::Get("layout_transform");
+  int64_t total = 0;
+  for (const auto& kv : mod->functions) {
+    const auto* fn = kv.second.as<FunctionNode>();
+    if (fn == nullptr) {
+      continue;
+    }
+    PostOrderVisit(fn->body, [&](const Expr& e) {
+      const CallNode* call = e.as<CallNode>();
+      if (call == nullptr || !call->op.same_as(layout_transform_op)) {
+        return;
+      }
+      int64_t cost = 1;
+      if (const auto* ttype = call->checked_type().as<TensorTypeNode>()) {
+        for (const PrimExpr& dim : ttype->shape) {
+          if (const auto* imm = dim.as<IntImmNode>()) {
+            cost *= imm->value;
+          } else {
+            cost = kDynamicLayoutTransformCost;
+            break;
+          }
+        }
+      } else {
+        cost = kDynamicLayoutTransformCost;
+      }
+      total += cost;
+    });
+  }
+  return total;
+}
+
 }  // namespace convert_op_layout
 
 namespace transform {
@@ -158,6 +206,27 @@ Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts) {
 
 TVM_REGISTER_GLOBAL("relay._transform.ConvertLayout").set_body_typed(ConvertLayout);
 
+Pass ConvertLayoutSearch(const Array<Map<String, Array<String>>>& candidate_layouts) {
+  runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func =
+      [=](IRModule mod, PassContext pc) -> IRModule {
+        // Keeping the unconverted module is always a valid outcome, so it seeds the search.
+        IRModule best = mod;
+        int64_t best_cost = relay::convert_op_layout::EstimateLayoutTransformCost(mod);
+        for (const Map<String, Array<String>>& desired_layouts : candidate_layouts) {
+          IRModule converted = Sequential({ConvertLayout(desired_layouts), InferType()})(mod);
+          int64_t cost = relay::convert_op_layout::EstimateLayoutTransformCost(converted);
+          if (cost < best_cost) {
+            best = converted;
+            best_cost = cost;
+          }
+        }
+        return best;
+      };
+  return CreateModulePass(pass_func, 3, "ConvertLayoutSearch", {"InferType", "CanonicalizeOps"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.ConvertLayoutSearch").set_body_typed(ConvertLayoutSearch);
+
 TVM_REGISTER_GLOBAL("relay._transform.InferCorrectLayoutOutput")
     .set_body_typed([](Array<Layout> input_layouts, Array<Layout> output_layouts, Attrs new_attrs) {
       return InferCorrectLayoutOutput(input_layouts, output_layouts, new_attrs);
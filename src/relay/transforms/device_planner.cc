@@ -1489,11 +1489,124 @@ tvm::transform::Pass Check(CompilationConfig config) {
       /*opt_level=*/0, "PlanDevicesCheckConflicts", {});
 }
 
+/* =============== Phase 3 fast path for single-device modules =============== */
+
+/*!
+ * \brief Returns true if the module carries no device constraints of its own, i.e. no
+ * "on_device" or "device_copy" CallNodes, no \p VirtualDevice annotations on functions or
+ * their parameters, and no PrimFuncs (whose buffer maps can imply memory scopes).
+ *
+ * For such a module on a single-device configuration the unification-based analysis can only
+ * ever conclude that everything lives on that one device, so the whole solver can be skipped.
+ */
+class DeviceConstraintFinder : public ExprVisitor {
+ public:
+  static bool HasNoConstraints(const IRModule& mod) {
+    DeviceConstraintFinder finder;
+    for (const auto& kv : mod->functions) {
+      if (const auto* function_node = AsOptimizableFunctionNode(kv.second)) {
+        finder.VisitExpr(GetRef<Function>(function_node));
+      } else if (kv.second->IsInstance<tir::PrimFuncNode>()) {
+        finder.found_constraint_ = true;
+      }
+      if (finder.found_constraint_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  void VisitExpr_(const CallNode* call_node) final {
+    if (call_node->op == OnDeviceOp() || call_node->op == DeviceCopyOp()) {
+      found_constraint_ = true;
+      return;
+    }
+    ExprVisitor::VisitExpr_(call_node);
+  }
+
+  void VisitExpr_(const FunctionNode* function_node) final {
+    if (function_node->HasNonzeroAttr(attr::kPrimitive)) {
+      return;
+    }
+    if (!function_node->virtual_device()->IsFullyUnconstrained()) {
+      found_constraint_ = true;
+      return;
+    }
+    for (const auto& param : function_node->params) {
+      if (!param->virtual_device()->IsFullyUnconstrained()) {
+        found_constraint_ = true;
+        return;
+      }
+    }
+    ExprVisitor::VisitExpr_(function_node);
+  }
+
+  bool found_constraint_ = false;
+};
+
+/*!
+ * \brief Annotates every function of an unconstrained module with the single \p VirtualDevice
+ * of a homogeneous configuration, mimicking what \p DeviceCapturer produces when all domains
+ * unify to that device: parameter and result \p VirtualDevices are attached, and no
+ * "device_copy" or "on_device" CallNodes are needed.
+ */
+class HomogeneousCapturer : public ExprMutator {
+ public:
+  HomogeneousCapturer(IRModule mod, VirtualDevice virtual_device)
+      : mod_(std::move(mod)), virtual_device_(std::move(virtual_device)) {}
+
+  IRModule Capture() {
+    VLOG_CONTEXT << "CaptureHomogeneousDevices";
+    IRModule result(/*functions=*/{}, mod_->type_definitions, mod_->Imports(), mod_->source_map,
+                    mod_->attrs);
+    for (const auto& kv : mod_->functions) {
+      if (const auto* function_node = AsOptimizableFunctionNode(kv.second)) {
+        result->Add(kv.first, Downcast<Function>(Mutate(GetRef<Function>(function_node))));
+      } else {
+        result->Add(kv.first, kv.second);
+      }
+    }
+    return result;
+  }
+
+ private:
+  Expr VisitExpr_(const FunctionNode* function_node) final {
+    if (function_node->HasNonzeroAttr(attr::kPrimitive)) {
+      return GetRef<Function>(function_node);
+    }
+    Map<Var, Expr> annotated_bind_map;
+    for (const auto& param : function_node->params) {
+      annotated_bind_map.Set(param, WithFields(param, {}, {}, virtual_device_));
+    }
+    Expr body = VisitExpr(function_node->body);
+    Function func = WithFields(GetRef<Function>(function_node), function_node->params, body);
+    func = SubstituteBoundVars(func, annotated_bind_map);
+    func->virtual_device_ = virtual_device_;
+    return std::move(func);
+  }
+
+  /*! \brief Module we are rewriting, so we can lookup global variables. */
+  IRModule mod_;
+  /*! \brief The single device of the configuration. */
+  VirtualDevice virtual_device_;
+};
+
 /*! \brief Run the remaining phases. */
 tvm::transform::Pass PlanDevicesCore(CompilationConfig config) {
   return tvm::transform::CreateModulePass(
       [config = std::move(config)](IRModule mod,
                                    tvm::transform::PassContext pass_cnxt) -> IRModule {
+        // Fast path: on a single-device configuration (primitive and host device coincide), a
+        // module without any device constraints of its own can only ever unify to that one
+        // device, so skip the solver and annotate directly.
+        if (config->optional_homogeneous_target.defined() &&
+            config->default_primitive_virtual_device.same_as(config->host_virtual_device) &&
+            DeviceConstraintFinder::HasNoConstraints(mod)) {
+          VLOG(1) << "single-device module; skipping device analysis";
+          return HomogeneousCapturer(mod, config->default_primitive_virtual_device).Capture();
+        }
+
         // Collect the system of constraints for every sub-expression using existing "on_device"
         // and "device_copy" calls.
         std::unique_ptr<DeviceDomains> domains = DeviceAnalyzer(mod, config).Analyze();
@@ -32,6 +32,11 @@
 #include <tvm/relay/transform.h>
 #include <tvm/te/operation.h>
 
+#include <algorithm>
+#include <unordered_set>
+
+#include "../ir/dataflow_matcher_impl.h"
+
 namespace tvm {
 namespace relay {
 namespace merge_composite {
@@ -48,8 +53,27 @@ Expr MergeComposite(const Function& func, const Array<runtime::String>& pattern_
                     const IRModule& m) {
   ICHECK_EQ(pattern_names.size(), patterns.size());
   Function merged_func = func;
+  // Index the operators present in the function with a single traversal.
+  // Partitioning only wraps matched operators into composite functions, so the
+  // set stays a superset of the ops present as patterns are merged.
+  std::unordered_set<const OpNode*> present_ops;
+  PostOrderVisit(func, [&present_ops](const Expr& expr) {
+    if (const auto* op_node = expr.as<OpNode>()) {
+      present_ops.insert(op_node);
+    }
+  });
   // merge the patterns one-by-one in order
   for (size_t i = 0; i < patterns.size(); i++) {
+    // Patterns rooted at an operator that never occurs in the function cannot
+    // match; skip them without a graph traversal or type inference.
+    std::unordered_set<const OpNode*> root_ops;
+    if (CollectPatternRootOps(patterns[i], &root_ops)) {
+      bool any_present = std::any_of(root_ops.begin(), root_ops.end(),
+                                     [&](const OpNode* op) { return present_ops.count(op) != 0; });
+      if (!any_present) {
+        continue;
+      }
+    }
     Map<String, ObjectRef> attrs;
     attrs.Set("Composite", pattern_names[i]);
     merged_func = Downcast<Function>(PartitionPattern(patterns[i], merged_func, attrs, checks[i]));
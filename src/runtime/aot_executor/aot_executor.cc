@@ -27,16 +27,103 @@
 
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/name_transforms.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include "../meta_data.h"
 
 namespace tvm {
 namespace runtime {
 
+namespace {
+
+/*!
+ * \brief Process-wide workspace shared between AotExecutor instances.
+ *
+ *  When several AOT models are resident but never run concurrently on a device,
+ *  each instance's USMP-planned workspace pools can alias one buffer sized to
+ *  the maximum of the models' requirements instead of their sum. Executors
+ *  reserve their requirement at load time (which only raises the high-water
+ *  mark) and acquire the buffer before each run; acquisition is a single
+ *  mutex-guarded owner check, and rebinding views only happens when ownership
+ *  actually changes hands.
+ *
+ *  Opt-in via TVM_AOT_SHARED_WORKSPACE=1; concurrent runs of two executors on
+ *  the same device are not supported in this mode.
+ */
+class AotSharedWorkspacePool {
+ public:
+  static AotSharedWorkspacePool* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static AotSharedWorkspacePool* inst = new AotSharedWorkspacePool();
+    return inst;
+  }
+
+  /*! \brief Whether sharing is enabled for this process. */
+  static bool Enabled() {
+    const char* val = std::getenv("TVM_AOT_SHARED_WORKSPACE");
+    return val != nullptr && std::string(val) == "1";
+  }
+
+  /*!
+   * \brief Record a model's workspace requirement, raising the high-water mark.
+   * \param dev The device the workspace lives on.
+   * \param nbytes The total planned pool size of the model.
+   */
+  void Reserve(Device dev, int64_t nbytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[DeviceKey(dev)];
+    entry.reserved_bytes = std::max(entry.reserved_bytes, nbytes);
+  }
+
+  /*!
+   * \brief Take ownership of the shared buffer for the given device.
+   * \param dev The device the workspace lives on.
+   * \param owner An opaque token identifying the acquiring executor.
+   * \param rebound Set to true when the caller must re-create its views, i.e.
+   *  when ownership changed or the buffer was (re-)allocated.
+   * \return The shared buffer, at least as large as every Reserve so far.
+   */
+  NDArray Acquire(Device dev, const void* owner, bool* rebound) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[DeviceKey(dev)];
+    bool realloc = !entry.buffer.defined() || entry.buffer_bytes < entry.reserved_bytes;
+    if (realloc) {
+      entry.buffer = NDArray::Empty({entry.reserved_bytes}, DataType::UInt(8), dev);
+      entry.buffer_bytes = entry.reserved_bytes;
+    }
+    *rebound = realloc || entry.owner != owner;
+    entry.owner = owner;
+    return entry.buffer;
+  }
+
+ private:
+  struct Entry {
+    NDArray buffer;
+    int64_t buffer_bytes{0};
+    int64_t reserved_bytes{0};
+    const void* owner{nullptr};
+  };
+
+  static int64_t DeviceKey(Device dev) {
+    return (static_cast<int64_t>(dev.device_type) << 32) | dev.device_id;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, Entry> entries_;
+};
+
+}  // namespace
+
 AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs)
     : module_{module}, devices_{devs} {
   auto fmetadata = module->GetFunction("get_metadata");
@@ -84,12 +171,41 @@ AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>&
     // Emplace constant node pool only if workspace pools supplied
     args_.emplace_back(ci);
 
+    shared_workspace_ = AotSharedWorkspacePool::Enabled();
+    workspace_arg_base_ = args_.size();
+    int64_t workspace_total = 0;
     int32_t pool_len = 0;
     for (auto pool : metadata_->workspace_pools()) {
       pool_len =
           GetDataSize(*NDArray::Empty({pool->shape()}, pool->dtype(), devices_[0]).operator->());
-      args_.emplace_back(NDArray::Empty({pool_len}, DataType::UInt(8), devices_[0]));
+      if (shared_workspace_) {
+        // Lay the pools out back to back inside the shared buffer; the views
+        // are bound lazily before each run.
+        workspace_pool_offsets_.push_back(workspace_total);
+        workspace_pool_sizes_.push_back(pool_len);
+        workspace_total += ((pool_len + kAllocAlignment - 1) / kAllocAlignment) * kAllocAlignment;
+        args_.emplace_back(NDArray());
+      } else {
+        args_.emplace_back(NDArray::Empty({pool_len}, DataType::UInt(8), devices_[0]));
+      }
     }
+    if (shared_workspace_) {
+      AotSharedWorkspacePool::Global()->Reserve(devices_[0], workspace_total);
+      BindSharedWorkspace();
+    }
+  }
+}
+
+void AotExecutor::BindSharedWorkspace() {
+  bool rebound = false;
+  NDArray buffer = AotSharedWorkspacePool::Global()->Acquire(devices_[0], this, &rebound);
+  if (!rebound) {
+    return;
+  }
+  for (size_t i = 0; i < workspace_pool_sizes_.size(); ++i) {
+    args_[workspace_arg_base_ + i] =
+        buffer.CreateView({workspace_pool_sizes_[i]}, DataType::UInt(8),
+                          static_cast<uint64_t>(workspace_pool_offsets_[i]));
   }
 }
 
@@ -164,6 +280,9 @@ PackedFunc AotExecutor::GetFunction(const String& name, const ObjectPtr<Object>&
 }
 
 void AotExecutor::Run() {
+  if (shared_workspace_) {
+    BindSharedWorkspace();
+  }
   auto pf = module_.GetFunction(
       get_name_mangled(metadata_->mod_name(), ::tvm::runtime::symbol::tvm_module_main),
       true /* query_imports */);
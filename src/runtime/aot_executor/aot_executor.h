@@ -138,6 +138,14 @@ class TVM_DLL AotExecutor : public ModuleNode {
   void CopyOutputTo(int index, DLTensor* data_out);
 
  private:
+  /*!
+   * \brief Rebind the workspace pool arguments to the process-wide shared workspace.
+   *
+   *  Only called when shared workspaces are enabled (TVM_AOT_SHARED_WORKSPACE=1).
+   *  A no-op when this executor already owns the shared buffer.
+   */
+  void BindSharedWorkspace();
+
   /*! \brief Metadata provided to the runtime from the compiler. */
   metadata::Metadata metadata_;
 
@@ -149,6 +157,18 @@ class TVM_DLL AotExecutor : public ModuleNode {
 
   /*! \brief Holds one NDArray per function argument in the same order. */
   std::vector<NDArray> args_;
+
+  /*! \brief Whether the USMP workspace pools alias the process-wide shared workspace. */
+  bool shared_workspace_{false};
+
+  /*! \brief Index in args_ of the first workspace pool argument. */
+  size_t workspace_arg_base_{0};
+
+  /*! \brief Byte offset of each workspace pool inside the shared workspace. */
+  std::vector<int64_t> workspace_pool_offsets_;
+
+  /*! \brief Byte size of each workspace pool. */
+  std::vector<int64_t> workspace_pool_sizes_;
 };
 
 }  // namespace runtime
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file async_run_handle.h
+ * \brief Waitable handles for asynchronously completing executor runs.
+ *
+ *  Executors enqueue their device work synchronously (kernel launches are
+ *  asynchronous on stream-based devices) and hand the completion wait to a
+ *  shared worker thread, so one host thread can keep several requests in
+ *  flight and only block when it chooses to.
+ */
+#ifndef TVM_RUNTIME_ASYNC_RUN_HANDLE_H_
+#define TVM_RUNTIME_ASYNC_RUN_HANDLE_H_
+
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief A waitable handle for one asynchronously completing run.
+ *
+ *  Exposes two functions:
+ *  - "wait": block until the run completes; rethrows any error raised during
+ *    completion.
+ *  - "done": poll whether the run has completed, without blocking.
+ */
+class AsyncRunHandleNode : public ModuleNode {
+ public:
+  explicit AsyncRunHandleNode(std::shared_future<void> future) : future_(std::move(future)) {}
+
+  const char* type_key() const final { return "runtime.AsyncRunHandle"; }
+
+  /*! \brief The handle is usable from any module context; nothing is serialized. */
+  int GetPropertyMask() const final { return ModulePropertyMask::kRunnable; }
+
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "wait") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { future_.get(); });
+    } else if (name == "done") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        *rv = future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      });
+    }
+    return PackedFunc(nullptr);
+  }
+
+ private:
+  std::shared_future<void> future_;
+};
+
+/*!
+ * \brief The process-wide worker that performs completion waits off the caller thread.
+ */
+class AsyncCompletionQueue {
+ public:
+  static AsyncCompletionQueue* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new AsyncCompletionQueue();
+    return inst;
+  }
+
+  /*!
+   * \brief Submit the completion of one run.
+   * \param complete Runs on the worker thread; typically a device sync followed by
+   *        an optional user callback. Errors it raises surface from the handle's "wait".
+   * \return The waitable handle.
+   */
+  Module Submit(std::function<void()> complete) {
+    auto promise = std::make_shared<std::promise<void>>();
+    std::shared_future<void> future = promise->get_future().share();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back([promise, complete = std::move(complete)]() {
+        try {
+          complete();
+          promise->set_value();
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+    }
+    cv_.notify_one();
+    return Module(make_object<AsyncRunHandleNode>(std::move(future)));
+  }
+
+ private:
+  AsyncCompletionQueue() {
+    // The worker lives for the whole process, matching the Global() lifetime.
+    std::thread([this]() {
+      for (;;) {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          cv_.wait(lock, [this]() { return !tasks_.empty(); });
+          task = std::move(tasks_.front());
+          tasks_.pop_front();
+        }
+        task();
+      }
+    }).detach();
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RUNTIME_ASYNC_RUN_HANDLE_H_
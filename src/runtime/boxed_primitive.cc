@@ -25,6 +25,8 @@
 #include <tvm/runtime/container/boxed_primitive.h>
 #include <tvm/runtime/registry.h>
 
+#include <vector>
+
 namespace tvm {
 namespace runtime {
 
@@ -32,6 +34,40 @@ TVM_REGISTER_OBJECT_TYPE(BoxNode<int64_t>);
 TVM_REGISTER_OBJECT_TYPE(BoxNode<double>);
 TVM_REGISTER_OBJECT_TYPE(BoxNode<bool>);
 
+namespace {
+/* \brief Bounds of the interned integer range, inclusive of zero and
+ * exclusive of the end.
+ *
+ * The range covers the small non-negative integers that dominate
+ * scalar FFI traffic (shapes, axes, flags, small sizes).  It is kept
+ * modest so the table stays within a few kilobytes.
+ */
+constexpr int64_t kInternedIntEnd = 257;
+}  // namespace
+
+Int InternedInt(int64_t value) {
+  if (value >= 0 && value < kInternedIntEnd) {
+    // Built once on first use and intentionally kept alive for the
+    // process lifetime, so interned boxes never hit the deallocator.
+    static const std::vector<Int>* interned = []() {
+      auto* table = new std::vector<Int>();
+      table->reserve(kInternedIntEnd);
+      for (int64_t i = 0; i < kInternedIntEnd; ++i) {
+        table->push_back(Int(i));
+      }
+      return table;
+    }();
+    return (*interned)[value];
+  }
+  return Int(value);
+}
+
+Bool InternedBool(bool value) {
+  static const Bool* interned_true = new Bool(true);
+  static const Bool* interned_false = new Bool(false);
+  return value ? *interned_true : *interned_false;
+}
+
 /* \brief Allow explicit construction of Box<bool>
  *
  * Convert a `bool` to `Box<bool>`.  For use in FFI handling, to
@@ -45,7 +81,9 @@ TVM_REGISTER_OBJECT_TYPE(BoxNode<bool>);
  * ObjectRef()` without ambiguity, postponing conversions until
  * required.
  */
-TVM_REGISTER_GLOBAL("runtime.BoxBool").set_body_typed([](bool value) { return Box(value); });
+TVM_REGISTER_GLOBAL("runtime.BoxBool").set_body_typed([](bool value) {
+  return InternedBool(value);
+});
 
 /* \brief Return the underlying boolean object.
  *
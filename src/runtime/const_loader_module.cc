@@ -33,14 +33,90 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <tvm/runtime/threading_backend.h>
+
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "meta_data.h"
 
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Magic number heading const-loader blobs that deduplicate constants (v2).
+ *
+ *  A v1 blob starts with the element count of the variable-name vector, which is
+ *  always a small number, so the loader can tell the two formats apart from the
+ *  first 8 bytes the same way the parameter-dict magic works.
+ */
+constexpr uint64_t kConstLoaderDedupMagic = 0xF7E58D4F05C0DE02;
+
+/*!
+ * \brief Whether read-only constants are replicated per NUMA node.
+ *
+ *  Configured by the environment variable TVM_CONST_LOADER_NUMA_REPLICATE; off
+ *  by default. On multi-socket servers a single copy of the weights leaves
+ *  every thread on the far socket paying remote-memory latency. When enabled,
+ *  each thread asking for constants receives a replica whose pages live on its
+ *  own NUMA node: the replica is copied by the asking thread, and the
+ *  first-touch policy (together with the thread affinity configured in
+ *  threading_backend.cc) places the pages locally. Executors instantiated one
+ *  per socket therefore bind socket-local weights into their op closures at
+ *  initialization time.
+ */
+inline bool NumaReplicateEnabled() {
+  static bool enabled = []() {
+    const char* val = std::getenv("TVM_CONST_LOADER_NUMA_REPLICATE");
+    return val != nullptr && std::atoi(val) != 0;
+  }();
+  return enabled;
+}
+
+/*!
+ * \brief Content hash of a host-resident constant over its dtype, shape and raw bytes.
+ */
+size_t ConstContentHash(const NDArray& arr) {
+  const DLTensor* t = arr.operator->();
+  // FNV-1a; self-contained so the runtime does not grow a new dependency.
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const void* data, size_t nbytes) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < nbytes; ++i) {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+  };
+  mix(&t->dtype, sizeof(t->dtype));
+  mix(t->shape, sizeof(int64_t) * t->ndim);
+  mix(t->data, GetDataSize(*t));
+  return static_cast<size_t>(hash);
+}
+
+/*!
+ * \brief Check whether two host-resident constants hold bitwise identical contents.
+ */
+bool ConstContentEqual(const NDArray& lhs, const NDArray& rhs) {
+  const DLTensor* a = lhs.operator->();
+  const DLTensor* b = rhs.operator->();
+  if (a->dtype.code != b->dtype.code || a->dtype.bits != b->dtype.bits ||
+      a->dtype.lanes != b->dtype.lanes || a->ndim != b->ndim) {
+    return false;
+  }
+  for (int i = 0; i < a->ndim; ++i) {
+    if (a->shape[i] != b->shape[i]) {
+      return false;
+    }
+  }
+  return std::memcmp(a->data, b->data, GetDataSize(*a)) == 0;
+}
+
 /*!
  * \brief The const-loader module is designed to manage initialization of the
  * imported submodules for the C++ runtime.
@@ -81,7 +157,7 @@ class ConstLoaderModuleNode : public ModuleNode {
       return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
         Map<String, ObjectRef> ret_map;
         for (const auto& kv : const_var_ndarray_) {
-          ret_map.Set(kv.first, kv.second);
+          ret_map.Set(kv.first, GetNodeLocalConstant(kv.first));
         }
         *rv = ret_map;
       });
@@ -116,11 +192,46 @@ class ConstLoaderModuleNode : public ModuleNode {
     for (const auto& var : vars) {
       ICHECK_GT(const_var_ndarray_.count(var), 0U)
           << "No such constant variable '" << var << "' for function '" << symbol << "'";
-      ret.push_back(const_var_ndarray_[var]);
+      ret.push_back(GetNodeLocalConstant(var));
     }
     return ret;
   }
 
+  /*!
+   * \brief Resolve a constant to the replica local to the calling thread's NUMA node.
+   * \param var The constant variable name.
+   * \return The node-local replica, or the shared array when replication is off,
+   *         the host has a single node, or the constant does not live on the cpu.
+   *
+   * \note The first node asking for a constant adopts the shared array instead
+   *  of copying it, so single-socket deployments and the near socket pay
+   *  nothing. Replicas are copied by the asking thread; the first-touch policy
+   *  places their pages on that thread's node.
+   */
+  NDArray GetNodeLocalConstant(const std::string& var) {
+    const NDArray& arr = const_var_ndarray_.at(var);
+    if (!NumaReplicateEnabled() || arr->device.device_type != kDLCPU ||
+        threading::NumNumaNodes() < 2) {
+      return arr;
+    }
+    int node = threading::CurrentNumaNode();
+    std::lock_guard<std::mutex> lock(replica_mutex_);
+    auto& per_node = numa_replicas_[var];
+    auto it = per_node.find(node);
+    if (it != per_node.end()) {
+      return it->second;
+    }
+    if (per_node.empty()) {
+      per_node.emplace(node, arr);
+      return arr;
+    }
+    VLOG(1) << "Replicating constant '" << var << "' on NUMA node " << node;
+    NDArray replica = NDArray::Empty(arr.Shape(), arr->dtype, arr->device);
+    replica.CopyFrom(arr);
+    per_node.emplace(node, replica);
+    return replica;
+  }
+
   /*!
    * \brief Initialize each imported module.
    * \param symobl The symbol used for initializing a module. It is also used
@@ -152,22 +263,65 @@ class ConstLoaderModuleNode : public ModuleNode {
   }
 
   void SaveToBinary(dmlc::Stream* stream) final {
+    // Constants that no symbol requires are dead by export time; dropping them
+    // here keeps them out of both the artifact and the loaded runtime.
+    std::unordered_set<std::string> live_vars;
+    for (const auto& it : const_vars_by_symbol_) {
+      live_vars.insert(it.second.begin(), it.second.end());
+    }
+
     std::vector<std::string> variables;
     std::vector<NDArray> const_var_ndarray;
     for (const auto& it : const_var_ndarray_) {
-      String var_name = it.first;
-      variables.push_back(var_name);
+      if (live_vars.count(it.first) == 0) {
+        VLOG(1) << "Dropping constant '" << it.first << "' not required by any function";
+        continue;
+      }
+      variables.push_back(it.first);
       const_var_ndarray.push_back(it.second);
     }
 
+    // Deduplicate constants by content so that weights shared between submodules
+    // are stored once. Each variable records the index of its unique array, and
+    // aliased variables share one buffer after loading as well.
+    std::vector<NDArray> unique_arrays;
+    std::vector<uint64_t> alias_index(const_var_ndarray.size());
+    std::unordered_map<size_t, std::vector<uint64_t>> content_buckets;
+    for (size_t i = 0; i < const_var_ndarray.size(); ++i) {
+      const NDArray& arr = const_var_ndarray[i];
+      uint64_t idx = static_cast<uint64_t>(unique_arrays.size());
+      // Only host-resident constants can be compared byte-wise; anything else is
+      // conservatively treated as unique.
+      if (arr->device.device_type == kDLCPU) {
+        std::vector<uint64_t>& bucket = content_buckets[ConstContentHash(arr)];
+        for (uint64_t candidate : bucket) {
+          if (ConstContentEqual(unique_arrays[candidate], arr)) {
+            idx = candidate;
+            break;
+          }
+        }
+        if (idx == unique_arrays.size()) {
+          bucket.push_back(idx);
+        }
+      }
+      if (idx == unique_arrays.size()) {
+        unique_arrays.push_back(arr);
+      } else {
+        VLOG(1) << "Constant '" << variables[i] << "' aliases a previously saved constant";
+      }
+      alias_index[i] = idx;
+    }
+
+    stream->Write(kConstLoaderDedupMagic);
     // Save all variables in the function.
     stream->Write(variables);
-    // Save all constant data.
-    uint64_t sz = static_cast<uint64_t>(const_var_ndarray.size());
+    // Save the unique constant data and the variable to array mapping.
+    uint64_t sz = static_cast<uint64_t>(unique_arrays.size());
     stream->Write(sz);
     for (uint64_t i = 0; i < sz; i++) {
-      const_var_ndarray[i].Save(stream);
+      unique_arrays[i].Save(stream);
     }
+    stream->Write(alias_index);
 
     // Save the symbol to list of required constant variables mapping
     std::vector<std::string> symbols;
@@ -188,23 +342,49 @@ class ConstLoaderModuleNode : public ModuleNode {
   static Module LoadFromBinary(void* strm) {
     dmlc::Stream* stream = static_cast<dmlc::Stream*>(strm);
 
-    // Load the variables.
+    uint64_t header;
+    ICHECK(stream->Read(&header, sizeof(header))) << "Loading const loader header failed";
+
     std::vector<std::string> variables;
-    ICHECK(stream->Read(&variables)) << "Loading variable names failed";
-    uint64_t sz;
-    ICHECK(stream->Read(&sz, sizeof(sz))) << "Loading number of vars failed";
-    ICHECK_EQ(static_cast<size_t>(sz), variables.size())
-        << "The number of variables and ndarray counts must match";
-    // Load the list of ndarray.
     std::vector<NDArray> arrays;
-    for (uint64_t i = 0; i < sz; i++) {
-      NDArray temp;
-      temp.Load(stream);
-      arrays.push_back(temp);
+    uint64_t sz;
+    if (header == kConstLoaderDedupMagic) {
+      // Deduplicated blob: unique arrays plus a variable to array index mapping.
+      ICHECK(stream->Read(&variables)) << "Loading variable names failed";
+      ICHECK(stream->Read(&sz, sizeof(sz))) << "Loading number of vars failed";
+      std::vector<NDArray> unique_arrays;
+      for (uint64_t i = 0; i < sz; i++) {
+        NDArray temp;
+        temp.Load(stream);
+        unique_arrays.push_back(temp);
+      }
+      std::vector<uint64_t> alias_index;
+      ICHECK(stream->Read(&alias_index)) << "Loading constant alias indices failed";
+      ICHECK_EQ(alias_index.size(), variables.size())
+          << "The number of variables and alias indices must match";
+      for (uint64_t i = 0; i < alias_index.size(); i++) {
+        ICHECK_LT(alias_index[i], sz);
+        arrays.push_back(unique_arrays[alias_index[i]]);
+      }
+    } else {
+      // Legacy blob: the header is the element count of the variable-name vector,
+      // and arrays are stored one per variable.
+      variables.resize(header);
+      for (uint64_t i = 0; i < header; i++) {
+        ICHECK(stream->Read(&variables[i])) << "Loading variable names failed";
+      }
+      ICHECK(stream->Read(&sz, sizeof(sz))) << "Loading number of vars failed";
+      ICHECK_EQ(static_cast<size_t>(sz), variables.size())
+          << "The number of variables and ndarray counts must match";
+      for (uint64_t i = 0; i < sz; i++) {
+        NDArray temp;
+        temp.Load(stream);
+        arrays.push_back(temp);
+      }
     }
 
     std::unordered_map<std::string, NDArray> const_var_ndarray;
-    for (uint64_t i = 0; i < sz; i++) {
+    for (size_t i = 0; i < variables.size(); i++) {
       ICHECK_EQ(const_var_ndarray.count(variables[i]), 0U);
       const_var_ndarray[variables[i]] = arrays[i];
     }
@@ -238,6 +418,10 @@ class ConstLoaderModuleNode : public ModuleNode {
   std::unordered_map<std::string, bool> initialized_;
   /*! \brief Variable name to NDArray mapping. */
   std::unordered_map<std::string, NDArray> const_var_ndarray_;
+  /*! \brief Guards numa_replicas_; constants may be resolved from several threads. */
+  std::mutex replica_mutex_;
+  /*! \brief Per NUMA node replicas of cpu-resident constants, keyed by variable. */
+  std::unordered_map<std::string, std::unordered_map<int, NDArray>> numa_replicas_;
   /*! \brief Symbol name to required constant variables mapping. */
   std::unordered_map<std::string, std::vector<std::string>> const_vars_by_symbol_;
 };
@@ -24,6 +24,15 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
 #include "../../3rdparty/compiler-rt/builtin_fp16.h"
 #include "../cblas/gemm_common.h"
 #include "cublas_utils.h"
@@ -135,6 +144,133 @@ int roundoff(int v, int d) { return (v + d - 1) / d * d; }
 
 #if CUDART_VERSION >= 10010
 
+/*!
+ * \brief The process-wide cache of tuned cublasLt matmul algorithms.
+ *
+ *  The first occurrence of a (shape, dtype, layout, epilogue) key benchmarks
+ *  the heuristic candidates and remembers the winner; later calls reuse it
+ *  without further search. Winners are additionally appended to the file
+ *  named by TVM_CUBLAS_AUTOTUNE_CACHE, keyed by the GPU model, and entries
+ *  for the current GPU are reloaded from that file on first use. Setting
+ *  TVM_CUBLAS_AUTOTUNE=0 disables the benchmarking and keeps the plain
+ *  single-heuristic behavior.
+ */
+class CublasLtAlgoCache {
+ public:
+  static CublasLtAlgoCache* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new CublasLtAlgoCache();
+    return inst;
+  }
+
+  static bool Enabled() {
+    static bool enabled = []() {
+      const char* val = getenv("TVM_CUBLAS_AUTOTUNE");
+      return val == nullptr || atoi(val) != 0;
+    }();
+    return enabled;
+  }
+
+  bool Lookup(const std::string& key, cublasLtMatmulAlgo_t* algo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadPersisted();
+    auto it = algos_.find(key);
+    if (it == algos_.end()) {
+      return false;
+    }
+    *algo = it->second;
+    return true;
+  }
+
+  void Insert(const std::string& key, const cublasLtMatmulAlgo_t& algo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    algos_[key] = algo;
+    const char* path = getenv("TVM_CUBLAS_AUTOTUNE_CACHE");
+    if (path == nullptr) {
+      return;
+    }
+    std::ofstream os(path, std::ofstream::app);
+    if (!os.good()) {
+      LOG(WARNING) << "Cannot open the cublas autotune cache for writing: " << path;
+      return;
+    }
+    os << DeviceName() << '\t' << key << '\t' << SerializeAlgo(algo) << '\n';
+  }
+
+ private:
+  static const std::string& DeviceName() {
+    static std::string name = []() {
+      int device_id = 0;
+      cudaGetDevice(&device_id);
+      cudaDeviceProp prop;
+      cudaGetDeviceProperties(&prop, device_id);
+      std::string n(prop.name);
+      // The cache file is tab separated.
+      std::replace(n.begin(), n.end(), '\t', ' ');
+      return n;
+    }();
+    return name;
+  }
+
+  static std::string SerializeAlgo(const cublasLtMatmulAlgo_t& algo) {
+    // The algo descriptor is opaque; persist its words in hex.
+    const uint64_t* words = reinterpret_cast<const uint64_t*>(&algo);
+    constexpr size_t kNumWords = sizeof(cublasLtMatmulAlgo_t) / sizeof(uint64_t);
+    std::ostringstream os;
+    for (size_t i = 0; i < kNumWords; ++i) {
+      if (i != 0) os << ',';
+      os << std::hex << words[i];
+    }
+    return os.str();
+  }
+
+  static bool DeserializeAlgo(const std::string& str, cublasLtMatmulAlgo_t* algo) {
+    uint64_t* words = reinterpret_cast<uint64_t*>(algo);
+    constexpr size_t kNumWords = sizeof(cublasLtMatmulAlgo_t) / sizeof(uint64_t);
+    std::istringstream is(str);
+    for (size_t i = 0; i < kNumWords; ++i) {
+      std::string word;
+      if (!std::getline(is, word, ',')) {
+        return false;
+      }
+      words[i] = strtoull(word.c_str(), nullptr, 16);
+    }
+    return true;
+  }
+
+  // Load the entries persisted for the current GPU; requires mutex_ held.
+  void LoadPersisted() {
+    if (loaded_) {
+      return;
+    }
+    loaded_ = true;
+    const char* path = getenv("TVM_CUBLAS_AUTOTUNE_CACHE");
+    if (path == nullptr) {
+      return;
+    }
+    std::ifstream is(path);
+    for (std::string line; std::getline(is, line);) {
+      size_t first_tab = line.find('\t');
+      size_t second_tab = first_tab == std::string::npos ? first_tab : line.find('\t', first_tab + 1);
+      if (second_tab == std::string::npos) {
+        continue;
+      }
+      if (line.compare(0, first_tab, DeviceName()) != 0) {
+        continue;
+      }
+      cublasLtMatmulAlgo_t algo;
+      if (DeserializeAlgo(line.substr(second_tab + 1), &algo)) {
+        algos_[line.substr(first_tab + 1, second_tab - first_tab - 1)] = algo;
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, cublasLtMatmulAlgo_t> algos_;
+  bool loaded_ = false;
+};
+
 void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
                   cublasLtMatmulPreference_t matmul_pref_desc, const DLTensor* A, const DLTensor* B,
                   const DLTensor* bias, const DLTensor* scaleA, const DLTensor* scaleB,
@@ -241,6 +377,7 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
       cublasLtMatrixLayoutCreate(&B_desc, ab_type, !transa ? K : N, !transa ? N : K, ldb));
   CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&C_desc, c_type, M, N, ldc));
 
+  int64_t algo_batch_count = 1;
   if (use_batched_gemm) {
     auto get_batch_count = [](int64_t* shape, int batch_offset) {
       int64_t count = 1;
@@ -271,6 +408,7 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
     set_batch(A_desc, batch_count_A, batch_stride_A);
     set_batch(B_desc, batch_count_B, batch_stride_B);
     set_batch(C_desc, batch_count_C, batch_stride_C);
+    algo_batch_count = batch_count_A;
   }
 
   auto A_data = static_cast<char*>(A->data) + A->byte_offset;
@@ -280,18 +418,69 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
   cublasLtMatmulPreferenceSetAttribute(matmul_pref_desc, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
                                        &workspace_size, sizeof(size_t));
 
-  cublasLtMatmulHeuristicResult_t heuristic_result = {};
+  constexpr int kMaxAlgoCandidates = 8;
+  cublasLtMatmulHeuristicResult_t heuristic_results[kMaxAlgoCandidates] = {};
   int returned_result = 0;
   CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(hdl, op_desc, A_desc, B_desc, C_desc, C_desc,
-                                                    matmul_pref_desc, 1, &heuristic_result,
-                                                    &returned_result));
+                                                    matmul_pref_desc, kMaxAlgoCandidates,
+                                                    heuristic_results, &returned_result));
   if (returned_result == 0) {
     CHECK_CUBLAS_ERROR(CUBLAS_STATUS_NOT_SUPPORTED);
   }
+  cublasLtMatmulAlgo_t algo = heuristic_results[0].algo;
+
+  // Benchmarking on the caller's stream is not possible while a CUDA graph is
+  // being captured, so keep the top heuristic candidate in that case.
+  cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+  cudaStreamIsCapturing(stream, &capture_status);
+
+  if (CublasLtAlgoCache::Enabled() && returned_result > 1 &&
+      capture_status == cudaStreamCaptureStatusNone) {
+    std::ostringstream algo_key;
+    algo_key << M << '_' << N << '_' << K << '_' << algo_batch_count << '_' << transa << transb
+             << '_' << static_cast<int>(ab_type) << '_' << static_cast<int>(c_type) << '_'
+             << static_cast<int>(epilogue);
+    CublasLtAlgoCache* cache = CublasLtAlgoCache::Global();
+    if (!cache->Lookup(algo_key.str(), &algo)) {
+      // Time each candidate on the real operands. Every run writes the same
+      // values to C, so the extra launches do not change the result.
+      cudaEvent_t ev_start, ev_stop;
+      cudaEventCreate(&ev_start);
+      cudaEventCreate(&ev_stop);
+      float best_ms = std::numeric_limits<float>::max();
+      for (int i = 0; i < returned_result; ++i) {
+        constexpr int kBenchIters = 3;
+        // Warm-up run; skip candidates that fail to launch.
+        if (cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta, C_data,
+                           C_desc, C_data, C_desc, &heuristic_results[i].algo, workspace_ptr,
+                           workspace_size, stream) != CUBLAS_STATUS_SUCCESS) {
+          continue;
+        }
+        cudaEventRecord(ev_start, stream);
+        for (int iter = 0; iter < kBenchIters; ++iter) {
+          CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc,
+                                            beta, C_data, C_desc, C_data, C_desc,
+                                            &heuristic_results[i].algo, workspace_ptr,
+                                            workspace_size, stream));
+        }
+        cudaEventRecord(ev_stop, stream);
+        cudaEventSynchronize(ev_stop);
+        float elapsed_ms = 0.0f;
+        cudaEventElapsedTime(&elapsed_ms, ev_start, ev_stop);
+        if (elapsed_ms < best_ms) {
+          best_ms = elapsed_ms;
+          algo = heuristic_results[i].algo;
+        }
+      }
+      cudaEventDestroy(ev_start);
+      cudaEventDestroy(ev_stop);
+      cache->Insert(algo_key.str(), algo);
+    }
+  }
 
   CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta,
-                                    C_data, C_desc, C_data, C_desc, &heuristic_result.algo,
-                                    workspace_ptr, workspace_size, stream));
+                                    C_data, C_desc, C_data, C_desc, &algo, workspace_ptr,
+                                    workspace_size, stream));
 
   cublasLtMatmulDescDestroy(op_desc);
   cublasLtMatrixLayoutDestroy(A_desc);
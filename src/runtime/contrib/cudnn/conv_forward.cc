@@ -24,6 +24,14 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
 #include "cudnn_utils.h"
 
 namespace tvm {
@@ -31,6 +39,95 @@ namespace contrib {
 
 using namespace runtime;
 
+/*!
+ * \brief The process-wide cache of cuDNN forward algorithm choices.
+ *
+ *  cudnnFindConvolutionForwardAlgorithm exhaustively benchmarks every
+ *  algorithm, which is expensive; memoize its winner per workload so each
+ *  (shape, dtype, layout) key is searched at most once per process. When
+ *  TVM_CUDNN_ALGO_CACHE names a file, winners are also appended there keyed
+ *  by the GPU model, and matching entries are reloaded on first use.
+ */
+class ConvFwdAlgoCache {
+ public:
+  static ConvFwdAlgoCache* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new ConvFwdAlgoCache();
+    return inst;
+  }
+
+  bool Lookup(const std::string& key, int* algo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadPersisted();
+    auto it = algos_.find(key);
+    if (it == algos_.end()) {
+      return false;
+    }
+    *algo = it->second;
+    return true;
+  }
+
+  void Insert(const std::string& key, int algo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    algos_[key] = algo;
+    const char* path = getenv("TVM_CUDNN_ALGO_CACHE");
+    if (path == nullptr) {
+      return;
+    }
+    std::ofstream os(path, std::ofstream::app);
+    if (!os.good()) {
+      LOG(WARNING) << "Cannot open the cudnn algo cache for writing: " << path;
+      return;
+    }
+    os << DeviceName() << '\t' << key << '\t' << algo << '\n';
+  }
+
+ private:
+  static const std::string& DeviceName() {
+    static std::string name = []() {
+      int device_id = 0;
+      cudaGetDevice(&device_id);
+      cudaDeviceProp prop;
+      cudaGetDeviceProperties(&prop, device_id);
+      std::string n(prop.name);
+      // The cache file is tab separated.
+      std::replace(n.begin(), n.end(), '\t', ' ');
+      return n;
+    }();
+    return name;
+  }
+
+  // Load the entries persisted for the current GPU; requires mutex_ held.
+  void LoadPersisted() {
+    if (loaded_) {
+      return;
+    }
+    loaded_ = true;
+    const char* path = getenv("TVM_CUDNN_ALGO_CACHE");
+    if (path == nullptr) {
+      return;
+    }
+    std::ifstream is(path);
+    for (std::string line; std::getline(is, line);) {
+      size_t first_tab = line.find('\t');
+      size_t second_tab = first_tab == std::string::npos ? first_tab : line.find('\t', first_tab + 1);
+      if (second_tab == std::string::npos) {
+        continue;
+      }
+      if (line.compare(0, first_tab, DeviceName()) != 0) {
+        continue;
+      }
+      algos_[line.substr(first_tab + 1, second_tab - first_tab - 1)] =
+          atoi(line.c_str() + second_tab + 1);
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, int> algos_;
+  bool loaded_ = false;
+};
+
 void ConvolutionForward(int mode, int format, int algo, int dims, int groups, const int pad[],
                         const int stride[], const int dilation[], const DLTensor* x,
                         const DLTensor* w, const DLTensor* y, const std::string& conv_dtype) {
@@ -111,6 +208,21 @@ void FindAlgo(int format, int dims, int groups, const int pad[], const int strid
               TVMRetValue* ret) {
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
+
+  std::ostringstream algo_key;
+  algo_key << format << '_' << groups << '_' << data_dtype << '_' << conv_dtype;
+  for (int i = 0; i < dims; ++i) {
+    algo_key << '_' << pad[i] << '_' << stride[i] << '_' << dilation[i];
+  }
+  for (int i = 0; i < full_dims; ++i) {
+    algo_key << '_' << x_dim[i] << '_' << w_dim[i] << '_' << y_dim[i];
+  }
+  int cached_algo = 0;
+  if (ConvFwdAlgoCache::Global()->Lookup(algo_key.str(), &cached_algo)) {
+    ret[0] = cached_algo;
+    return;
+  }
+
   std::vector<int64_t> x_dim_int64(full_dims);
   std::vector<int64_t> w_dim_int64(full_dims);
   std::vector<int64_t> y_dim_int64(full_dims);
@@ -150,6 +262,7 @@ void FindAlgo(int format, int dims, int groups, const int pad[], const int strid
     }
   }
 
+  ConvFwdAlgoCache::Global()->Insert(algo_key.str(), static_cast<int>(best_algo));
   ret[0] = best_algo;
 }
 
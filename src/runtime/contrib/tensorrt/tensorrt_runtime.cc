@@ -26,10 +26,16 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <future>
+#include <list>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../file_utils.h"
@@ -73,9 +79,15 @@ class TensorRTRuntime : public JSONRuntimeBase {
         max_workspace_size_(size_t(1) << 30),
         max_batch_size_(-1),
         multi_engine_mode_(false),
-        use_fp16_(false) {
+        use_fp16_(false),
+        bucket_engines_(false),
+        background_build_(false),
+        max_cached_engines_(0) {
     const bool use_int8 = dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false);
     multi_engine_mode_ = dmlc::GetEnv("TVM_TENSORRT_MULTI_ENGINE", false);
+    bucket_engines_ = dmlc::GetEnv("TVM_TENSORRT_BUCKET_ENGINES", false);
+    background_build_ = dmlc::GetEnv("TVM_TENSORRT_BACKGROUND_BUILD", false);
+    max_cached_engines_ = dmlc::GetEnv("TVM_TENSORRT_MAX_CACHED_ENGINES", 0);
     num_calibration_batches_remaining_ = dmlc::GetEnv("TENSORRT_NUM_CALI_INT8", 0);
     if (use_int8) {
       ICHECK(num_calibration_batches_remaining_ != 0)
@@ -151,10 +163,19 @@ class TensorRTRuntime : public JSONRuntimeBase {
       it.second.engine->destroy();
     }
     trt_engine_cache_.clear();
+    lru_order_.clear();
   }
 
   ~TensorRTRuntime() override {
     VLOG(1) << "Destroying TensorRT runtime";
+    // Wait for any in-flight background builds; their engines were never
+    // published to the cache and must be destroyed here.
+    for (auto& it : pending_builds_) {
+      TensorRTEngineAndContext engine_and_context = it.second.get();
+      engine_and_context.context->destroy();
+      engine_and_context.engine->destroy();
+    }
+    pending_builds_.clear();
     DestroyEngines();
     VLOG(1) << "Destroyed TensorRT runtime";
   }
@@ -256,15 +277,39 @@ class TensorRTRuntime : public JSONRuntimeBase {
     return data_entry_[input_var_eid_[0]]->ndim == 0 ? 1 : data_entry_[input_var_eid_[0]]->shape[0];
   }
 
+  /*! \brief Round a batch size up to its bucket, the next power of two. Bucketing coalesces the
+   * long tail of batch sizes seen in production into a few engines, so a previously unseen size
+   * usually lands in an already-built bucket. */
+  static int BucketBatchSize(int batch_size) {
+    int bucket = 1;
+    while (bucket < batch_size) bucket *= 2;
+    return bucket;
+  }
+
   /*! \brief Find an engine in the cache which we can reuse depending on the mode. If no compatible
    * engine exists, return false to indicate that a new one should be built. */
   bool FindCompatibleEngine(int batch_size, int* compatible_engine_batch_size) {
     if (multi_engine_mode_) {
-      // Exact match is required for multi engine mode.
+      // Prefer an exact match.
       if (trt_engine_cache_.count(std::make_pair(symbol_name_, batch_size))) {
         *compatible_engine_batch_size = batch_size;
         return true;
       }
+      // With implicit batch, an engine built for a larger max batch size can execute any smaller
+      // batch, so fall back to the smallest cached engine that fits.
+      if (use_implicit_batch_) {
+        int best = -1;
+        for (const auto& it : trt_engine_cache_) {
+          if (it.first.first != symbol_name_) continue;
+          if (it.first.second >= batch_size && (best == -1 || it.first.second < best)) {
+            best = it.first.second;
+          }
+        }
+        if (best != -1) {
+          *compatible_engine_batch_size = best;
+          return true;
+        }
+      }
       return false;
     }
     // Check for engine with compatible max_batch_size.
@@ -281,47 +326,132 @@ class TensorRTRuntime : public JSONRuntimeBase {
    */
   TensorRTEngineAndContext& GetOrBuildEngine() {
     int batch_size = GetBatchSize();
+    const bool use_int8 = (dmlc::GetEnv("TVM_TENSORRT_USE_INT8", 0) != 0);
+    // Publish any background builds that completed since the last run.
+    HarvestBackgroundBuilds();
     int compatible_engine_batch_size = -1;
     bool find_engine_flag = FindCompatibleEngine(batch_size, &compatible_engine_batch_size);
-    const bool use_int8 = (dmlc::GetEnv("TVM_TENSORRT_USE_INT8", 0) != 0);
     const bool int8_calibration_not_used_or_not_complete =
         (calibrator_ != nullptr && num_calibration_batches_remaining_ != 0);
+    // Bucketing and background builds are incompatible with the calibration flow, which must see
+    // the exact batch the user runs.
+    const bool plain_build = !use_int8 && calibrator_ == nullptr;
+    const int build_batch_size =
+        (bucket_engines_ && plain_build) ? BucketBatchSize(batch_size) : batch_size;
     if (find_engine_flag &&
         (!use_int8 || calibrator_ == nullptr || int8_calibration_not_used_or_not_complete)) {
-      // A compatible engine already exists.
-      return trt_engine_cache_.at(std::make_pair(symbol_name_, compatible_engine_batch_size));
+      // A compatible engine already exists. If it is only a fallback (a larger bucket than the one
+      // this batch maps to), kick off a background build of the exact bucket so future runs use it,
+      // while this run proceeds on the fallback.
+      auto key = std::make_pair(symbol_name_, compatible_engine_batch_size);
+      if (background_build_ && multi_engine_mode_ && use_implicit_batch_ && plain_build &&
+          build_batch_size != compatible_engine_batch_size) {
+        LaunchBackgroundBuild(build_batch_size);
+      }
+      TouchEngine(key);
+      return trt_engine_cache_.at(key);
     }
 
     // For single engine mode, remove previous engine and update max_batch_size.
     if (!multi_engine_mode_) {
       DestroyEngines();
-      max_batch_size_ = batch_size;
+      max_batch_size_ = build_batch_size;
     }
     DLOG(INFO) << "Building new TensorRT engine for subgraph " << symbol_name_
-               << " with batch size " << batch_size;
+               << " with batch size " << build_batch_size;
 
     // Build engine.
     if (calibrator_ != nullptr && num_calibration_batches_remaining_ == 0) {
       // Calibration complete and build int8 engine
-      BuildEngineFromJson(batch_size);
+      BuildEngineFromJson(build_batch_size);
       calibrator_.reset(nullptr);
     } else {
       // Build new engine
-      BuildEngineFromJson(batch_size);
+      BuildEngineFromJson(build_batch_size);
       TensorRTEngineAndContext& engine_and_context =
-          trt_engine_cache_[std::make_pair(symbol_name_, batch_size)];
+          trt_engine_cache_[std::make_pair(symbol_name_, build_batch_size)];
       if (use_int8) {
         this->CreateInt8Calibrator(engine_and_context);
       }
     }
 
     VLOG(1) << "Finished building TensorRT engine for subgraph " << symbol_name_
-            << " with batch size " << batch_size;
-    CacheEngineToDisk();
-    return trt_engine_cache_.at(std::make_pair(symbol_name_, batch_size));
+            << " with batch size " << build_batch_size;
+    CacheEngineToDisk(build_batch_size);
+    auto key = std::make_pair(symbol_name_, build_batch_size);
+    TouchEngine(key);
+    EvictEnginesIfNeeded();
+    return trt_engine_cache_.at(key);
+  }
+
+  /*! \brief Start building an engine for the given batch size on a worker thread. The builder
+   * reads only the graph structure and the constant tensors, both immutable after Init, so it can
+   * run while inference continues on a fallback engine. The result is published into the cache by
+   * HarvestBackgroundBuilds on a later run. */
+  void LaunchBackgroundBuild(int batch_size) {
+    if (pending_builds_.count(batch_size)) return;
+    if (trt_engine_cache_.count(std::make_pair(symbol_name_, batch_size))) return;
+    DLOG(INFO) << "Launching background TensorRT engine build for subgraph " << symbol_name_
+               << " with batch size " << batch_size;
+    pending_builds_[batch_size] = std::async(
+        std::launch::async, [this, batch_size]() { return BuildEngineAndContext(batch_size); });
+  }
+
+  /*! \brief Move engines from completed background builds into the cache. */
+  void HarvestBackgroundBuilds() {
+    for (auto it = pending_builds_.begin(); it != pending_builds_.end();) {
+      if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        int batch_size = it->first;
+        auto key = std::make_pair(symbol_name_, batch_size);
+        trt_engine_cache_[key] = it->second.get();
+        VLOG(1) << "Finished background TensorRT engine build for subgraph " << symbol_name_
+                << " with batch size " << batch_size;
+        CacheEngineToDisk(batch_size);
+        TouchEngine(key);
+        EvictEnginesIfNeeded();
+        it = pending_builds_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /*! \brief Mark an engine as most recently used. */
+  void TouchEngine(const std::pair<std::string, int>& key) {
+    for (auto it = lru_order_.begin(); it != lru_order_.end(); ++it) {
+      if (*it == key) {
+        lru_order_.erase(it);
+        break;
+      }
+    }
+    lru_order_.push_front(key);
+  }
+
+  /*! \brief Destroy least recently used engines until the cache fits within
+   * TVM_TENSORRT_MAX_CACHED_ENGINES. The most recently used engine is never evicted, since it may
+   * be the one currently executing. */
+  void EvictEnginesIfNeeded() {
+    if (max_cached_engines_ <= 0) return;
+    while (static_cast<int>(trt_engine_cache_.size()) > max_cached_engines_ &&
+           lru_order_.size() > 1) {
+      auto key = lru_order_.back();
+      lru_order_.pop_back();
+      auto it = trt_engine_cache_.find(key);
+      if (it == trt_engine_cache_.end()) continue;
+      VLOG(1) << "Evicting TensorRT engine for function '" << key.first << "' (batch size "
+              << key.second << ")";
+      it->second.context->destroy();
+      it->second.engine->destroy();
+      trt_engine_cache_.erase(it);
+    }
   }
 
   void BuildEngineFromJson(int batch_size) {
+    trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] =
+        BuildEngineAndContext(batch_size);
+  }
+
+  TensorRTEngineAndContext BuildEngineAndContext(int batch_size) {
     const bool use_fp16 = dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) || use_fp16_;
     TensorRTBuilder builder(&logger_, data_entry_, max_workspace_size_, use_implicit_batch_,
                             use_fp16, batch_size, calibrator_.get());
@@ -350,8 +480,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       builder.AddOutput(outputs_[i], EntryID(outputs_[i]));
     }
 
-    TensorRTEngineAndContext engine_and_context = builder.BuildEngine();
-    trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
+    return builder.BuildEngine();
   }
 
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will check that directory for
@@ -362,8 +491,39 @@ class TensorRTRuntime : public JSONRuntimeBase {
     std::string cache_dir = dmlc::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return false;
     std::string key = GetSubgraphKey();
+    // Multi-engine caches keep one plan per batch size, listed in a manifest, so engines built
+    // ahead of time for every bucket can all be loaded before the first inference.
+    std::string manifest_path = cache_dir + "/" + key + ".batches";
+    std::ifstream manifest(manifest_path);
+    if (manifest.good()) {
+      bool loaded_any = false;
+      int batch_size;
+      while (manifest >> batch_size) {
+        std::string suffix = "_batch" + std::to_string(batch_size);
+        if (LoadEngineFromDisk(cache_dir + "/" + key + suffix + ".plan",
+                               cache_dir + "/" + key + suffix + ".meta")) {
+          disk_cached_batch_sizes_.insert(batch_size);
+          loaded_any = true;
+        }
+      }
+      if (loaded_any) {
+        LOG(INFO) << "finished loading engine and context ... ";
+        return true;
+      }
+      return false;
+    }
+    // Legacy layout: a single plan per subgraph.
     std::string path = cache_dir + "/" + key + ".plan";
-    // Check if engine is in the cache.
+    std::ifstream infile(path, std::ios::binary);
+    if (!infile.good()) return false;
+    infile.close();
+    if (!LoadEngineFromDisk(path, cache_dir + "/" + key + ".meta")) return false;
+    LOG(INFO) << "finished loading engine and context ... ";
+    return true;
+  }
+
+  /*! \brief Deserialize one engine and its metadata from disk into the cache. */
+  bool LoadEngineFromDisk(const std::string& path, const std::string& meta_path) {
     std::ifstream infile(path, std::ios::binary);
     if (!infile.good()) return false;
     LOG(INFO) << "Loading cached TensorRT engine from " << path;
@@ -377,7 +537,6 @@ class TensorRTRuntime : public JSONRuntimeBase {
         runtime->deserializeCudaEngine(&serialized_engine[0], serialized_engine.size(), nullptr);
     engine_and_context.context = engine_and_context.engine->createExecutionContext();
     // Load metadata
-    std::string meta_path = cache_dir + "/" + key + ".meta";
     std::string serialized_meta;
     LoadBinaryFromFile(meta_path, &serialized_meta);
     std::istringstream is(serialized_meta);
@@ -388,21 +547,25 @@ class TensorRTRuntime : public JSONRuntimeBase {
     helper.DeclareField("outputs", &engine_and_context.outputs);
     helper.DeclareField("batch_size", &batch_size);
     helper.ReadAllFields(&reader);
-    trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
-    max_batch_size_ = batch_size;
-    LOG(INFO) << "finished loading engine and context ... ";
+    auto cache_key = std::make_pair(symbol_name_, batch_size);
+    trt_engine_cache_[cache_key] = engine_and_context;
+    TouchEngine(cache_key);
+    max_batch_size_ = std::max(max_batch_size_, batch_size);
     return true;
   }
 
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will save the engine to that
    * directory so it can be loaded later.
    */
-  void CacheEngineToDisk() {
-    int batch_size = GetBatchSize();
+  void CacheEngineToDisk(int batch_size) {
     std::string cache_dir = dmlc::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return;
     std::string key = GetSubgraphKey();
-    std::string path = cache_dir + "/" + key + ".plan";
+    std::string file_key = key;
+    if (multi_engine_mode_) {
+      file_key += "_batch" + std::to_string(batch_size);
+    }
+    std::string path = cache_dir + "/" + file_key + ".plan";
     DLOG(INFO) << "Caching TensorRT engine to " << path;
     // Serialize engine to disk
     nvinfer1::IHostMemory* serialized_engine =
@@ -420,8 +583,17 @@ class TensorRTRuntime : public JSONRuntimeBase {
                                trt_engine_cache_[std::make_pair(symbol_name_, batch_size)].outputs);
     writer.WriteObjectKeyValue("batch_size", batch_size);
     writer.EndObject();
-    std::string meta_path = cache_dir + "/" + key + ".meta";
+    std::string meta_path = cache_dir + "/" + file_key + ".meta";
     SaveBinaryToFile(meta_path, os.str());
+    if (multi_engine_mode_) {
+      // Rewrite the manifest with every batch size serialized so far.
+      disk_cached_batch_sizes_.insert(batch_size);
+      std::ostringstream manifest;
+      for (int cached_batch_size : disk_cached_batch_sizes_) {
+        manifest << cached_batch_size << "\n";
+      }
+      SaveBinaryToFile(cache_dir + "/" + key + ".batches", manifest.str());
+    }
   }
 
   std::string GetSubgraphKey() {
@@ -468,6 +640,16 @@ class TensorRTRuntime : public JSONRuntimeBase {
   std::unordered_map<std::pair<std::string, int>, TensorRTEngineAndContext, PairHash>
       trt_engine_cache_;
 
+  /*! \brief Engine builds running on worker threads, keyed by batch size. Results are published
+   * into trt_engine_cache_ by HarvestBackgroundBuilds. */
+  std::unordered_map<int, std::future<TensorRTEngineAndContext>> pending_builds_;
+
+  /*! \brief Cache keys ordered from most to least recently used, for eviction. */
+  std::list<std::pair<std::string, int>> lru_order_;
+
+  /*! \brief Batch sizes whose engines have been serialized to TVM_TENSORRT_CACHE_DIR. */
+  std::set<int> disk_cached_batch_sizes_;
+
   /*! \brief Calibrator for INT8 mode. */
   std::unique_ptr<TensorRTCalibrator> calibrator_;
 
@@ -493,7 +675,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   bool GetCachedEnginesFromDisk() { return false; }
 
-  void CacheEngineToDisk() {}
+  void CacheEngineToDisk(int batch_size) {}
 #endif  // TVM_GRAPH_EXECUTOR_TENSORRT
 
   bool use_implicit_batch_;
@@ -516,6 +698,18 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   /*! \brief Use auto-conversion to fp16 */
   bool use_fp16_;
+
+  /*! \brief Round requested batch sizes up to the next power of two when building engines, so a
+   * stream of distinct batch sizes shares a few bucketed engines instead of building one each. */
+  bool bucket_engines_;
+
+  /*! \brief When a run lands on a fallback bucket, build the exact bucket on a worker thread
+   * instead of stalling the request. Only applies to multi-engine mode with implicit batch. */
+  bool background_build_;
+
+  /*! \brief Upper bound on the number of engines kept in memory; least recently used engines are
+   * destroyed beyond it. Zero means unbounded. */
+  int max_cached_engines_;
 };
 
 runtime::Module TensorRTRuntimeCreate(const String& symbol_name, const String& graph_json,
@@ -25,8 +25,13 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "workspace_pool.h"
 
@@ -34,8 +39,34 @@
 #include <android/api-level.h>
 #endif
 
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/mman.h>
+#endif
+
 namespace tvm {
 namespace runtime {
+
+/*!
+ * \brief Minimum allocation size backed by transparent huge pages.
+ *
+ * Configured by the environment variable TVM_CPU_HUGE_PAGE_MIN_BYTES; values
+ * <= 0 (and unset) disable huge-page backing. Large weight tensors benefit
+ * from 2MB pages through fewer TLB misses, and because the pages are
+ * populated on first touch, they land on the NUMA node of the thread that
+ * initializes them, which the thread affinity configured in
+ * threading_backend.cc keeps local.
+ */
+inline int64_t HugePageMinBytes() {
+  static int64_t threshold = []() -> int64_t {
+    const char* val = std::getenv("TVM_CPU_HUGE_PAGE_MIN_BYTES");
+    if (val == nullptr) {
+      return -1;
+    }
+    return std::atoll(val);
+  }();
+  return threshold;
+}
+
 class CPUDeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final {}
@@ -46,6 +77,21 @@ class CPUDeviceAPI final : public DeviceAPI {
   }
   void* AllocDataSpace(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
     void* ptr;
+#if defined(__linux__) && !defined(__ANDROID__)
+    int64_t huge_page_min_bytes = HugePageMinBytes();
+    if (huge_page_min_bytes > 0 && nbytes >= static_cast<size_t>(huge_page_min_bytes) &&
+        alignment <= kHugePageSize) {
+      size_t mapped_size = (nbytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+      ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (ptr != MAP_FAILED) {
+        madvise(ptr, mapped_size, MADV_HUGEPAGE);
+        std::lock_guard<std::mutex> lock(mapped_mutex_);
+        mapped_sizes_[ptr] = mapped_size;
+        return ptr;
+      }
+      // Fall through to the regular allocation on mmap failure.
+    }
+#endif
 #if _MSC_VER
     ptr = _aligned_malloc(nbytes, alignment);
     if (ptr == nullptr) throw std::bad_alloc();
@@ -61,6 +107,17 @@ class CPUDeviceAPI final : public DeviceAPI {
   }
 
   void FreeDataSpace(Device dev, void* ptr) final {
+#if defined(__linux__) && !defined(__ANDROID__)
+    {
+      std::lock_guard<std::mutex> lock(mapped_mutex_);
+      auto it = mapped_sizes_.find(ptr);
+      if (it != mapped_sizes_.end()) {
+        munmap(ptr, it->second);
+        mapped_sizes_.erase(it);
+        return;
+      }
+    }
+#endif
 #if _MSC_VER
     _aligned_free(ptr);
 #else
@@ -88,6 +145,16 @@ class CPUDeviceAPI final : public DeviceAPI {
                       TVMStreamHandle stream) final {
     memcpy(static_cast<char*>(to) + to_offset, static_cast<const char*>(from) + from_offset, size);
   }
+
+ private:
+#if defined(__linux__) && !defined(__ANDROID__)
+  /*! \brief The size of a 2MB transparent huge page. */
+  static constexpr size_t kHugePageSize = size_t(2) << 20;
+  /*! \brief Guards mapped_sizes_. */
+  std::mutex mapped_mutex_;
+  /*! \brief The mapped length of every mmap-backed allocation, for munmap on free. */
+  std::unordered_map<void*, size_t> mapped_sizes_;
+#endif
 };
 
 struct CPUWorkspacePool : public WorkspacePool {
@@ -106,5 +173,138 @@ TVM_REGISTER_GLOBAL("device_api.cpu").set_body([](TVMArgs args, TVMRetValue* rv)
   DeviceAPI* ptr = CPUDeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
 });
+
+/*!
+ * \brief Software DMA engine that backs the tir dma_copy/dma_wait builtins on CPU.
+ *
+ * Copies are executed by a background prefetch thread so that a schedule
+ * annotated with async queues can overlap the staging of global memory with
+ * compute, mirroring the semantics of the Hexagon user DMA
+ * (hexagon/hexagon_user_dma.cc): dma_wait blocks until at most `inflight`
+ * copy groups remain outstanding on the queue, and copies issued between
+ * dma_start_group and dma_end_group complete as a single group.
+ */
+class CPUSoftwareDMAEngine {
+ public:
+  static CPUSoftwareDMAEngine* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new CPUSoftwareDMAEngine();
+    return inst;
+  }
+
+  void Copy(int queue_id, void* dst, const void* src, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A copy outside a group forms a group of its own.
+    bool ends_group = !queues_[queue_id].in_group;
+    if (ends_group) {
+      queues_[queue_id].in_flight++;
+    }
+    requests_.push_back(Request{queue_id, dst, src, size, ends_group});
+    cv_worker_.notify_one();
+  }
+
+  void Wait(int queue_id, int inflight) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_done_.wait(lock, [&]() { return queues_[queue_id].in_flight <= inflight; });
+  }
+
+  void StartGroup(int queue_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QueueState& queue = queues_[queue_id];
+    ICHECK(!queue.in_group) << "ValueError: a DMA group is already active on queue " << queue_id;
+    queue.in_group = true;
+  }
+
+  void EndGroup(int queue_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QueueState& queue = queues_[queue_id];
+    ICHECK(queue.in_group) << "ValueError: no DMA group is active on queue " << queue_id;
+    queue.in_group = false;
+    queue.in_flight++;
+    // A zero-sized sentinel marks the end of the group in the request stream.
+    requests_.push_back(Request{queue_id, nullptr, nullptr, 0, true});
+    cv_worker_.notify_one();
+  }
+
+ private:
+  struct Request {
+    int queue_id;
+    void* dst;
+    const void* src;
+    size_t size;
+    bool ends_group;
+  };
+
+  struct QueueState {
+    /*! \brief The number of copy groups that have not yet completed. */
+    int in_flight{0};
+    /*! \brief Whether a group is currently being accumulated on the host side. */
+    bool in_group{false};
+  };
+
+  CPUSoftwareDMAEngine() {
+    worker_ = std::thread([this]() { this->RunWorker(); });
+    worker_.detach();
+  }
+
+  void RunWorker() {
+    while (true) {
+      Request req;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_worker_.wait(lock, [&]() { return !requests_.empty(); });
+        req = requests_.front();
+        requests_.pop_front();
+      }
+      if (req.size != 0) {
+        memcpy(req.dst, req.src, req.size);
+      }
+      if (req.ends_group) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[req.queue_id].in_flight--;
+        cv_done_.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_worker_;
+  std::condition_variable cv_done_;
+  std::deque<Request> requests_;
+  std::unordered_map<int, QueueState> queues_;
+  std::thread worker_;
+};
+
+TVM_REGISTER_GLOBAL("device_api.cpu.dma_copy").set_body([](TVMArgs args, TVMRetValue* rv) {
+  int queue_id = args[0];
+  void* dst = args[1];
+  void* src = args[2];
+  int size = args[3];
+  ICHECK(size > 0);
+  // args[4] is bypass_cache, which has no meaning for the software engine.
+  CPUSoftwareDMAEngine::Global()->Copy(queue_id, dst, src, static_cast<size_t>(size));
+  *rv = static_cast<int32_t>(0);
+});
+
+TVM_REGISTER_GLOBAL("device_api.cpu.dma_wait").set_body([](TVMArgs args, TVMRetValue* rv) {
+  int queue_id = args[0];
+  int inflight = args[1];
+  ICHECK(inflight >= 0);
+  CPUSoftwareDMAEngine::Global()->Wait(queue_id, inflight);
+  *rv = static_cast<int32_t>(0);
+});
+
+TVM_REGISTER_GLOBAL("device_api.cpu.dma_start_group").set_body([](TVMArgs args, TVMRetValue* rv) {
+  int queue_id = args[0];
+  CPUSoftwareDMAEngine::Global()->StartGroup(queue_id);
+  *rv = static_cast<int32_t>(0);
+});
+
+TVM_REGISTER_GLOBAL("device_api.cpu.dma_end_group").set_body([](TVMArgs args, TVMRetValue* rv) {
+  int queue_id = args[0];
+  CPUSoftwareDMAEngine::Global()->EndGroup(queue_id);
+  *rv = static_cast<int32_t>(0);
+});
 }  // namespace runtime
 }  // namespace tvm
@@ -28,13 +28,46 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <unordered_set>
 
 #include "cuda_common.h"
+#include "../workspace_pool.h"
 
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Minimum size of a pageable host-to-device copy routed through the
+ *  pinned staging pool.
+ *
+ * Synchronous copies from pageable memory reach roughly half of the PCIe
+ * bandwidth that pinned memory achieves. Copies at or above this threshold
+ * are therefore staged through thread-local pinned buffers in chunks, with
+ * each chunk issued asynchronously on the current stream. Configured by the
+ * environment variable TVM_CUDA_STAGING_MIN_BYTES; values <= 0 disable
+ * staging, unset defaults to 1MB.
+ */
+inline int64_t PinnedStagingMinBytes() {
+  static int64_t threshold = []() -> int64_t {
+    const char* val = std::getenv("TVM_CUDA_STAGING_MIN_BYTES");
+    if (val == nullptr) {
+      return 1 << 20;
+    }
+    return std::atoll(val);
+  }();
+  return threshold;
+}
+
+/*!
+ * \brief Copy pageable host memory to the device through the pinned staging pool.
+ * \return Whether the copy was handled; false falls back to a direct copy.
+ */
+bool TryStagedHostToDeviceCopy(const void* from, void* to, size_t size, cudaStream_t stream);
+
 class CUDADeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final { CUDA_CALL(cudaSetDevice(dev.device_id)); }
@@ -210,7 +243,9 @@ class CUDADeviceAPI final : public DeviceAPI {
       GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLCUDA) {
       CUDA_CALL(cudaSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      if (!TryStagedHostToDeviceCopy(from, to, size, cu_stream)) {
+        GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      }
     } else {
       LOG(FATAL) << "expect copy from/to GPU or between GPU";
     }
@@ -278,6 +313,75 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
 };
 
+/*!
+ * \brief Thread-local pinned staging buffers for pageable host-to-device copies.
+ *
+ * The staging path double-buffers: while the DMA engine drains one pinned
+ * chunk on the stream, the host memcpys the next chunk into the other slot,
+ * so the copy overlaps with itself and with compute already queued on the
+ * stream. A per-slot event tracks when the async copy out of a slot has
+ * completed and the slot can be refilled. Once the source data has been
+ * memcpy'd into the pinned slots the call returns; the device-side writes
+ * remain ordered on the caller's stream like any other async copy.
+ */
+class CUDAPinnedStagingBuffer {
+ public:
+  ~CUDAPinnedStagingBuffer() {
+    for (int i = 0; i < kNumSlots; ++i) {
+      if (slots_[i] != nullptr) {
+        cudaEventSynchronize(events_[i]);
+        cudaEventDestroy(events_[i]);
+        pool_.FreeWorkspace(Device{kDLCUDAHost, 0}, slots_[i]);
+      }
+    }
+  }
+
+  void CopyHostToDevice(const void* from, void* to, size_t size, cudaStream_t stream) {
+    for (size_t offset = 0; offset < size; offset += kChunkBytes) {
+      size_t nbytes = std::min(kChunkBytes, size - offset);
+      int slot = next_slot_;
+      next_slot_ = (next_slot_ + 1) % kNumSlots;
+      this->EnsureSlot(slot);
+      // Wait until the previous async copy out of this slot has drained.
+      CUDA_CALL(cudaEventSynchronize(events_[slot]));
+      std::memcpy(slots_[slot], static_cast<const char*>(from) + offset, nbytes);
+      CUDA_CALL(cudaMemcpyAsync(static_cast<char*>(to) + offset, slots_[slot], nbytes,
+                                cudaMemcpyHostToDevice, stream));
+      CUDA_CALL(cudaEventRecord(events_[slot], stream));
+    }
+  }
+
+ private:
+  void EnsureSlot(int slot) {
+    if (slots_[slot] != nullptr) return;
+    slots_[slot] = pool_.AllocWorkspace(Device{kDLCUDAHost, 0}, kChunkBytes);
+    CUDA_CALL(cudaEventCreateWithFlags(&events_[slot], cudaEventDisableTiming));
+  }
+
+  static constexpr size_t kChunkBytes = 4 << 20;
+  static constexpr int kNumSlots = 2;
+  WorkspacePool pool_{kDLCUDAHost, CUDADeviceAPI::Global()};
+  void* slots_[kNumSlots] = {nullptr, nullptr};
+  cudaEvent_t events_[kNumSlots];
+  int next_slot_{0};
+};
+
+bool TryStagedHostToDeviceCopy(const void* from, void* to, size_t size, cudaStream_t stream) {
+  int64_t min_bytes = PinnedStagingMinBytes();
+  if (min_bytes <= 0 || size < static_cast<size_t>(min_bytes)) return false;
+  cudaPointerAttributes attr;
+  cudaError_t err = cudaPointerGetAttributes(&attr, from);
+  if (err != cudaSuccess) {
+    // Unregistered host memory can report an error on older drivers; clear it.
+    cudaGetLastError();
+  } else if (attr.type != cudaMemoryTypeUnregistered) {
+    // Already pinned or device accessible; a direct async copy is faster.
+    return false;
+  }
+  dmlc::ThreadLocalStore<CUDAPinnedStagingBuffer>::Get()->CopyHostToDevice(from, to, size, stream);
+  return true;
+}
+
 typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
 
 CUDAThreadEntry::CUDAThreadEntry() : pool(kDLCUDA, CUDADeviceAPI::Global()) {}
@@ -331,6 +435,45 @@ TVM_REGISTER_GLOBAL("profiling.timer.cuda").set_body_typed([](Device dev) {
   return Timer(make_object<CUDATimerNode>());
 });
 
+#if CUDART_VERSION >= 11020
+/*!
+ * \brief Raise the default mempool's release threshold so freed blocks stay cached.
+ *
+ * By default the stream-ordered pool returns freed memory to the OS at every
+ * synchronization point, which reintroduces the allocation cost the pool is
+ * meant to hide. Raising the threshold keeps freed blocks resident for reuse;
+ * the driver still tracks the stream dependencies needed to hand a block freed
+ * on one stream to an allocation on another without a device-wide sync.
+ */
+void EnsureMemPoolConfigured(int device_id) {
+  static std::mutex mutex;
+  static std::unordered_set<int> configured;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (configured.count(device_id)) return;
+  cudaMemPool_t pool;
+  CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, device_id));
+  uint64_t threshold = UINT64_MAX;
+  CUDA_CALL(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+  configured.insert(device_id);
+}
+
+// Stream-ordered allocation entry points used by memory::StreamOrderedAllocator.
+// The allocation and free are enqueued on the calling thread's current stream,
+// so they order with the kernels around them instead of synchronizing the device.
+TVM_REGISTER_GLOBAL("runtime.cuda.malloc_async").set_body_typed([](int device_id, int64_t nbytes) {
+  CUDA_CALL(cudaSetDevice(device_id));
+  EnsureMemPoolConfigured(device_id);
+  void* ptr = nullptr;
+  CUDA_CALL(cudaMallocAsync(&ptr, nbytes, CUDAThreadEntry::ThreadLocal()->stream));
+  return ptr;
+});
+
+TVM_REGISTER_GLOBAL("runtime.cuda.free_async").set_body_typed([](int device_id, void* ptr) {
+  CUDA_CALL(cudaSetDevice(device_id));
+  CUDA_CALL(cudaFreeAsync(ptr, CUDAThreadEntry::ThreadLocal()->stream));
+});
+#endif  // CUDART_VERSION >= 11020
+
 TVM_DLL String GetCudaFreeMemory() {
   size_t free_mem, total_mem;
   CUDA_CALL(cudaMemGetInfo(&free_mem, &total_mem));
@@ -212,8 +212,106 @@ memory::Storage IPCAllocStorage(ShapeTuple buffer_shape, DLDataType dtype_hint)
   return storage;
 }
 
+/*!
+ * \brief A device-level barrier across all workers.
+ * A one-byte nccl all-gather on the default stream orders all work each
+ * worker issued before the barrier ahead of anything any worker issues
+ * after it, which is what direct peer reads/writes of IPC memory need.
+ */
+void IPCWorkerBarrier(nccl::CCLThreadLocalContext* ctx) {
+  static void* d_src = nullptr;
+  static void* d_dst = nullptr;
+  if (d_src == nullptr) {
+    CUDA_CALL(cudaMalloc(&d_src, 1));
+    CUDA_CALL(cudaMalloc(&d_dst, ctx->worker->num_workers));
+  }
+  NCCL_CALL(ncclAllGather(d_src, d_dst, 1, ncclChar, ctx->global_comm, /*stream=*/nullptr));
+  CUDA_CALL(cudaStreamSynchronize(nullptr));
+}
+
+/*!
+ * \brief Scatter an IPC-memory buffer on worker 0 to all workers.
+ * Each worker copies its shard straight out of worker 0's buffer through the
+ * IPC peer pointer, so all shards move in parallel over NVLink/PCIe instead
+ * of being serialized through the controller. `send` must on every worker be
+ * the local view of a buffer allocated with "cuda_ipc.alloc_storage"; only
+ * the copy on worker 0 needs to hold valid data.
+ * \param send The collectively allocated source buffer; data read on worker 0.
+ * \param recv The per-worker destination holding one shard.
+ */
+void IPCScatterFromWorker0(NDArray send, NDArray recv) {
+  nccl::CCLThreadLocalContext* ctx = nccl::CCLThreadLocalContext::Get();
+  int worker_id = ctx->worker->worker_id;
+  int num_workers = ctx->worker->num_workers;
+  int64_t numel = send.Shape()->Product();
+  CHECK_EQ(numel % num_workers, 0)
+      << "ValueError: Scattering evenly requires the number of elements in the buffer to be "
+      << "divisible by the number of workers, but got numel = " << numel << " and " << num_workers
+      << " workers.";
+  int64_t numel_per_shard = numel / num_workers;
+  CHECK_EQ(numel_per_shard, recv.Shape()->Product())
+      << "ValueError: The number of elements in buffer `recv` must be the same as each shard of "
+      << "buffer `send`. `send.size` is " << numel << ", but `recv.size` is "
+      << recv.Shape()->Product() << ".";
+  CHECK(DataType(send->dtype) == DataType(recv->dtype))
+      << "ValueError: The data types of `send` and `recv` must match.";
+  CUDAIPCMemory ipc_memory = CUDAIPCMemory::GetIPCMemoryFromDevicePtr(send->data);
+  int64_t bytes_per_shard = numel_per_shard * DataType(send->dtype).bytes();
+  // Order worker 0's producer ahead of the peer reads.
+  CUDA_CALL(cudaDeviceSynchronize());
+  IPCWorkerBarrier(ctx);
+  uint8_t* src =
+      static_cast<uint8_t*>(ipc_memory->remote_data[0]) + worker_id * bytes_per_shard;
+  CUDA_CALL(cudaMemcpy(recv->data, src, bytes_per_shard, cudaMemcpyDeviceToDevice));
+  CUDA_CALL(cudaDeviceSynchronize());
+  // All shards are read before worker 0 may reuse the buffer.
+  IPCWorkerBarrier(ctx);
+}
+
+/*!
+ * \brief Gather one shard from every worker into an IPC-memory buffer on
+ * worker 0. The mirror of IPCScatterFromWorker0: each worker writes its shard
+ * directly into worker 0's buffer through the IPC peer pointer.
+ * \param send The per-worker source holding one shard.
+ * \param recv The collectively allocated destination buffer; filled on worker 0.
+ */
+void IPCGatherToWorker0(NDArray send, NDArray recv) {
+  nccl::CCLThreadLocalContext* ctx = nccl::CCLThreadLocalContext::Get();
+  int worker_id = ctx->worker->worker_id;
+  int num_workers = ctx->worker->num_workers;
+  int64_t numel = recv.Shape()->Product();
+  CHECK_EQ(numel % num_workers, 0)
+      << "ValueError: Gathering evenly requires the number of elements in the buffer to be "
+      << "divisible by the number of workers, but got numel = " << numel << " and " << num_workers
+      << " workers.";
+  int64_t numel_per_shard = numel / num_workers;
+  CHECK_EQ(numel_per_shard, send.Shape()->Product())
+      << "ValueError: The number of elements in buffer `send` must be the same as each shard of "
+      << "buffer `recv`. `recv.size` is " << numel << ", but `send.size` is "
+      << send.Shape()->Product() << ".";
+  CHECK(DataType(send->dtype) == DataType(recv->dtype))
+      << "ValueError: The data types of `send` and `recv` must match.";
+  CUDAIPCMemory ipc_memory = CUDAIPCMemory::GetIPCMemoryFromDevicePtr(recv->data);
+  int64_t bytes_per_shard = numel_per_shard * DataType(send->dtype).bytes();
+  // Worker 0's previous consumers of the buffer finish before it is overwritten.
+  CUDA_CALL(cudaDeviceSynchronize());
+  IPCWorkerBarrier(ctx);
+  uint8_t* dst =
+      static_cast<uint8_t*>(ipc_memory->remote_data[0]) + worker_id * bytes_per_shard;
+  CUDA_CALL(cudaMemcpy(dst, send->data, bytes_per_shard, cudaMemcpyDeviceToDevice));
+  CUDA_CALL(cudaDeviceSynchronize());
+  // All shards have landed before worker 0 reads the gathered buffer.
+  IPCWorkerBarrier(ctx);
+}
+
 TVM_REGISTER_GLOBAL("runtime.disco.cuda_ipc.alloc_storage").set_body_typed(IPCAllocStorage);
 
+TVM_REGISTER_GLOBAL("runtime.disco.cuda_ipc.scatter_from_worker0")
+    .set_body_typed(IPCScatterFromWorker0);
+
+TVM_REGISTER_GLOBAL("runtime.disco.cuda_ipc.gather_to_worker0")
+    .set_body_typed(IPCGatherToWorker0);
+
 TVM_REGISTER_GLOBAL("runtime.disco.cuda_ipc.cuda_ipc_memory_allocator_clear").set_body_typed([]() {
   CUDAIPCMemoryAllocator::Global()->Clear();
 });
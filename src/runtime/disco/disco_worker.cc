@@ -22,8 +22,11 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <tvm/runtime/profiling.h>
+
 #include "../../support/process_id.h"
 #include "./protocol.h"
+#include "./tracing.h"
 
 namespace tvm {
 namespace runtime {
@@ -51,6 +54,9 @@ struct DiscoWorker::Impl {
     ThreadLocalDiscoWorker::Get()->worker = self;
     while (true) {
       TVMArgs args = self->channel->Recv();
+      DiscoTracer* tracer = DiscoTracer::Global();
+      const bool tracing = tracer->enabled();
+      int64_t recv_us = tracing ? DiscoTracer::NowUs() : 0;
       DiscoAction action = static_cast<DiscoAction>(args[0].operator int());
       int64_t reg_id = args[1];
       switch (action) {
@@ -72,7 +78,8 @@ struct DiscoWorker::Impl {
           PackedFunc func = GetReg(self, func_reg_id);
           CHECK(func.defined());
           CallPacked(self, reg_id, func,
-                     TVMArgs(args.values + 3, args.type_codes + 3, args.num_args - 3));
+                     TVMArgs(args.values + 3, args.type_codes + 3, args.num_args - 3), recv_us,
+                     func_reg_id);
           break;
         }
         case DiscoAction::kCopyFromWorker0: {
@@ -99,6 +106,11 @@ struct DiscoWorker::Impl {
           break;
         }
       }
+      if (tracing && action != DiscoAction::kCallPacked) {
+        // kCallPacked records itself with the function name and device time.
+        tracer->RecordCommand(self->worker_id, DiscoAction2String(action), recv_us,
+                              DiscoTracer::NowUs(), /*device_ns=*/0);
+      }
     }
   }
 
@@ -109,6 +121,8 @@ struct DiscoWorker::Impl {
     CHECK(pf) << "ValueError: Cannot find global function: " << name;
     if (reg_id != 0) {
       GetReg(self, reg_id) = *pf;
+      // Remember the name so traced calls through this register can be labeled.
+      DiscoTracer::Global()->RecordGlobalFunc(self->worker_id, reg_id, name);
     }
   }
 
@@ -170,7 +184,7 @@ struct DiscoWorker::Impl {
   }
 
   static void CallPacked(DiscoWorker* self, int64_t ret_reg_id, PackedFunc func,
-                         const TVMArgs& args) {
+                         const TVMArgs& args, int64_t recv_us, int func_reg_id) {
     TVMValue* values = const_cast<TVMValue*>(args.values);
     int* type_codes = const_cast<int*>(args.type_codes);
     int num_args = args.num_args;
@@ -182,9 +196,26 @@ struct DiscoWorker::Impl {
         setter(i, GetReg(self, dref->reg_id));
       }
     }
+    DiscoTracer* tracer = DiscoTracer::Global();
+    profiling::Timer timer{nullptr};
+    if (tracer->enabled()) {
+      // The device timer captures the kernels launched by the call; the
+      // sync it requires is the usual profiling distortion.
+      timer = profiling::Timer::Start(self->default_device);
+    }
     TVMRetValue rv;
     func.CallPacked(TVMArgs(values, type_codes, num_args), &rv);
     GetReg(self, ret_reg_id) = std::move(rv);
+    if (timer.defined()) {
+      timer->Stop();
+      int64_t end_us = DiscoTracer::NowUs();
+      int64_t device_ns = timer->SyncAndGetElapsedNanos();
+      std::string name = tracer->LookupFuncName(self->worker_id, func_reg_id);
+      if (name.empty()) {
+        name = "call_packed";
+      }
+      tracer->RecordCommand(self->worker_id, std::move(name), recv_us, end_us, device_ns);
+    }
   }
 
   static TVMRetValue& GetReg(DiscoWorker* self, int64_t reg_id) {
@@ -159,6 +159,8 @@ class ShardLoaderObj : public Object {
   mutable const FileRecord* current_file_;
   /*! \brief The context of the current file to be loaded from */
   mutable std::string current_file_stream_;
+  /*! \brief Zero-copy mapping of the current file, nullptr when reading through the stream */
+  mutable std::shared_ptr<MemoryMappedFile> current_file_mapped_;
 
  private:
   /*! \brief Load the i-th parameter without post-processing
@@ -172,6 +174,12 @@ class ShardLoaderObj : public Object {
    * \returns The full tensor at the specified index
    */
   NDArray LoadDirect(int weight_index) const;
+
+  /*! \brief Make `file` the current file, memory-mapping it when enabled */
+  void OpenCurrentFile(const FileRecord* file, Device device) const;
+
+  /*! \brief Load a parameter from the current file, aliasing it if mapped */
+  NDArray LoadParamFromCurrentFile(const ParamRecord* param, Device device) const;
 };
 
 TVM_REGISTER_OBJECT_TYPE(ShardLoaderObj);
@@ -239,6 +247,39 @@ std::string GetSiblingPath(const std::string& path, const std::string& filename)
   LOG(FATAL) << "ValueError: Cannot find the parent directory: " << path;
 }
 
+/*!
+ * \brief Whether shard files should be aliased via mmap instead of read into a
+ *  heap buffer. Only meaningful for CPU (including unified-memory) targets and
+ *  opt-in via TVM_NDARRAY_CACHE_MMAP=1, since aliased parameters live on
+ *  read-only pages that are shared between worker processes.
+ */
+bool ShouldMapShardFiles(Device device) {
+  if (device.device_type != kDLCPU) return false;
+  const char* val = getenv("TVM_NDARRAY_CACHE_MMAP");
+  return val != nullptr && atoi(val) != 0;
+}
+
+void ShardLoaderObj::OpenCurrentFile(const FileRecord* file, Device device) const {
+  current_file_ = file;
+  std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
+  current_file_mapped_ = nullptr;
+  if (ShouldMapShardFiles(device)) {
+    current_file_mapped_ = MemoryMappedFile::Open(file_name);
+  }
+  if (current_file_mapped_ != nullptr) {
+    current_file_stream_.clear();
+  } else {
+    LoadBinaryFromFile(file_name, &current_file_stream_);
+  }
+}
+
+NDArray ShardLoaderObj::LoadParamFromCurrentFile(const ParamRecord* param, Device device) const {
+  if (current_file_mapped_ != nullptr) {
+    return param->LoadZeroCopy(device, current_file_mapped_->data(), current_file_mapped_);
+  }
+  return param->Load(device, &current_file_stream_);
+}
+
 NDArray ShardLoaderObj::LoadParamOnWorker0(int weight_index) const {
   DiscoWorker* worker = DiscoWorker::ThreadLocal();
   int worker_id = worker->worker_id;
@@ -250,11 +291,9 @@ NDArray ShardLoaderObj::LoadParamOnWorker0(int weight_index) const {
 
   auto load = [this, param, device, file]() {
     if (file != current_file_) {
-      current_file_ = file;
-      std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-      LoadBinaryFromFile(file_name, &this->current_file_stream_);
+      OpenCurrentFile(file, device);
     }
-    return param->Load(device, &this->current_file_stream_);
+    return LoadParamFromCurrentFile(param, device);
   };
 
   if (worker_id == 0) {
@@ -297,11 +336,9 @@ NDArray ShardLoaderObj::LoadDirect(int weight_index) const {
   Device device = worker->default_device;
 
   if (file != current_file_) {
-    current_file_ = file;
-    std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-    LoadBinaryFromFile(file_name, &this->current_file_stream_);
+    OpenCurrentFile(file, device);
   }
-  return param->Load(device, &this->current_file_stream_);
+  return LoadParamFromCurrentFile(param, device);
 }
 
 NDArray ShardLoaderObj::Load(int weight_index) const {
@@ -130,6 +130,52 @@ void AllGather(NDArray send, bool in_group, NDArray recv) {
                           in_group ? ctx->group_comm : ctx->global_comm, stream));
 }
 
+/*!
+ * \brief Launch a collective on the dedicated communication stream instead of
+ *  the compute stream. The communication stream first waits on an event
+ *  recorded on the compute stream, so the collective starts as soon as its
+ *  input tensor is produced while later independent kernels keep running on
+ *  the compute stream. Callers must join the streams with `wait_comm_stream`
+ *  before launching a kernel that consumes the collective's output.
+ */
+void AllReduceAsync(NDArray send, ReduceKind reduce_kind, bool in_group, NDArray recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int64_t numel = send.Shape()->Product();
+  deviceStream_t compute_stream = ctx->GetDefaultStream();
+  deviceStream_t comm_stream = ctx->GetCommStream();
+  EventRecord(ctx->comm_input_ready, compute_stream);
+  StreamWaitEvent(comm_stream, ctx->comm_input_ready);
+  NCCL_CALL(ncclAllReduce(send->data, recv->data, numel,
+                          /*datatype=*/AsNCCLDataType(DataType(send->dtype)),
+                          /*op=*/AsNCCLRedOp(reduce_kind),
+                          in_group ? ctx->group_comm : ctx->global_comm, comm_stream));
+  EventRecord(ctx->comm_output_ready, comm_stream);
+}
+
+/*! \brief Asynchronous variant of AllGather; see AllReduceAsync. */
+void AllGatherAsync(NDArray send, bool in_group, NDArray recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int64_t numel = send.Shape()->Product();
+  deviceStream_t compute_stream = ctx->GetDefaultStream();
+  deviceStream_t comm_stream = ctx->GetCommStream();
+  EventRecord(ctx->comm_input_ready, compute_stream);
+  StreamWaitEvent(comm_stream, ctx->comm_input_ready);
+  NCCL_CALL(ncclAllGather(send->data, recv->data, numel,
+                          /*datatype=*/AsNCCLDataType(DataType(send->dtype)),
+                          in_group ? ctx->group_comm : ctx->global_comm, comm_stream));
+  EventRecord(ctx->comm_output_ready, comm_stream);
+}
+
+/*!
+ * \brief Make the compute stream wait for every collective launched on the
+ *  communication stream so far. Device-side only; the host does not block.
+ */
+void WaitCommStream() {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  if (ctx->comm_stream == nullptr) return;
+  StreamWaitEvent(ctx->GetDefaultStream(), ctx->comm_output_ready);
+}
+
 void BroadcastFromWorker0(Optional<NDArray> send, bool in_group, NDArray recv) {
   CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
   int worker_id = ctx->worker->worker_id;
@@ -314,6 +360,9 @@ void SyncWorker() {
   ICHECK(ctx->worker != nullptr);
   deviceStream_t stream = ctx->GetDefaultStream();
   StreamSynchronize(stream);
+  if (ctx->comm_stream != nullptr) {
+    StreamSynchronize(ctx->comm_stream);
+  }
 }
 
 TVM_REGISTER_GLOBAL("runtime.disco.compiled_ccl").set_body_typed([]() -> String {
@@ -331,6 +380,17 @@ TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".allgather")
     .set_body_typed([](NDArray send, bool in_group, NDArray recv) {
       nccl::AllGather(send, in_group, recv);
     });
+TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".allreduce_async")
+    .set_body_typed([](NDArray send, int kind, bool in_group, NDArray recv) {
+      CHECK(0 <= kind && kind <= 4) << "ValueError: Unknown ReduceKind: " << kind;
+      nccl::AllReduceAsync(send, static_cast<ReduceKind>(kind), in_group, recv);
+    });
+TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".allgather_async")
+    .set_body_typed([](NDArray send, bool in_group, NDArray recv) {
+      nccl::AllGatherAsync(send, in_group, recv);
+    });
+TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".wait_comm_stream")
+    .set_body_typed(WaitCommStream);
 TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".broadcast_from_worker0")
     .set_body_typed(BroadcastFromWorker0);
 TVM_REGISTER_GLOBAL("runtime.disco." TVM_DISCO_CCL_NAME ".scatter_from_worker0")
@@ -61,11 +61,22 @@ namespace nccl {
 #define TVM_DISCO_CCL_NAME "nccl"
 
 using deviceStream_t = cudaStream_t;
+using deviceEvent_t = cudaEvent_t;
 const constexpr DLDeviceType TVM_DISCO_DEVICE_TYPE = DLDeviceType::kDLCUDA;
 inline void SetDevice(int device_id) { CUDA_CALL(cudaSetDevice(device_id)); }
 inline void StreamSynchronize(deviceStream_t stream) { CUDA_CALL(cudaStreamSynchronize(stream)); }
 inline void StreamCreate(deviceStream_t* stream) { CUDA_CALL(cudaStreamCreate(stream)); }
 inline void StreamDestroy(deviceStream_t stream) { CUDA_CALL(cudaStreamDestroy(stream)); }
+inline void EventCreate(deviceEvent_t* event) {
+  CUDA_CALL(cudaEventCreateWithFlags(event, cudaEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { CUDA_CALL(cudaEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  CUDA_CALL(cudaEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  CUDA_CALL(cudaStreamWaitEvent(stream, event, 0));
+}
 
 #else
 
@@ -73,11 +84,22 @@ inline void StreamDestroy(deviceStream_t stream) { CUDA_CALL(cudaStreamDestroy(s
 #define TVM_DISCO_CCL_NAME "rccl"
 
 using deviceStream_t = hipStream_t;
+using deviceEvent_t = hipEvent_t;
 const constexpr DLDeviceType TVM_DISCO_DEVICE_TYPE = DLDeviceType::kDLROCM;
 inline void SetDevice(int device_id) { ROCM_CALL(hipSetDevice(device_id)); }
 inline void StreamSynchronize(deviceStream_t stream) { ROCM_CALL(hipStreamSynchronize(stream)); }
 inline void StreamCreate(deviceStream_t* stream) { ROCM_CALL(hipStreamCreate(stream)); }
 inline void StreamDestroy(deviceStream_t stream) { ROCM_CALL(hipStreamDestroy(stream)); }
+inline void EventCreate(deviceEvent_t* event) {
+  ROCM_CALL(hipEventCreateWithFlags(event, hipEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { ROCM_CALL(hipEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  ROCM_CALL(hipEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  ROCM_CALL(hipStreamWaitEvent(stream, event, 0));
+}
 
 #endif
 
@@ -121,6 +143,20 @@ struct CCLThreadLocalContext {
   DiscoWorker* worker = nullptr;
   int device_id;
   deviceStream_t default_stream = nullptr;
+  /*! \brief Dedicated stream for async collectives, created on first use. */
+  deviceStream_t comm_stream = nullptr;
+  /*!
+   * \brief Marks on the compute stream the point where a collective's input is
+   *  ready. A single event is enough: it is re-recorded before each launch and
+   *  the wait enqueued on the communication stream captures its state then.
+   */
+  deviceEvent_t comm_input_ready = nullptr;
+  /*!
+   * \brief Marks on the communication stream the completion of the most recent
+   *  collective. The communication stream is in-order, so waiting on this
+   *  event covers every collective launched so far.
+   */
+  deviceEvent_t comm_output_ready = nullptr;
   ncclComm_t global_comm = nullptr;
   ncclComm_t group_comm = nullptr;
 
@@ -138,6 +174,18 @@ struct CCLThreadLocalContext {
       NCCL_CALL(ncclCommDestroy(global_comm));
       global_comm = nullptr;
     }
+    if (comm_stream) {
+      StreamDestroy(comm_stream);
+      comm_stream = nullptr;
+    }
+    if (comm_input_ready) {
+      EventDestroy(comm_input_ready);
+      comm_input_ready = nullptr;
+    }
+    if (comm_output_ready) {
+      EventDestroy(comm_output_ready);
+      comm_output_ready = nullptr;
+    }
     if (default_stream) {
       StreamDestroy(default_stream);
       default_stream = nullptr;
@@ -152,6 +200,16 @@ struct CCLThreadLocalContext {
     return stream == nullptr ? default_stream : stream;
   }
 
+  /*! \brief Get the dedicated communication stream, creating it on first use. */
+  deviceStream_t GetCommStream() {
+    if (comm_stream == nullptr) {
+      StreamCreate(&comm_stream);
+      EventCreate(&comm_input_ready);
+      EventCreate(&comm_output_ready);
+    }
+    return comm_stream;
+  }
+
   static CCLThreadLocalContext* Get();
 };
 
@@ -22,41 +22,142 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <atomic>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "../../support/pipe.h"
+#include "../../support/utils.h"
 #include "../minrpc/rpc_reference.h"
 #include "./bcast_session.h"
 #include "./disco_worker_thread.h"
 #include "./message_queue.h"
 #include "./protocol.h"
+#include "./shm_transport.h"
 
 namespace tvm {
 namespace runtime {
 
+#if TVM_DISCO_SHM_TRANSPORT_ENABLED
+/*! \brief Per-direction capacity of the shared-memory ring in bytes. */
+uint64_t ShmQueueCapacity() {
+  static constexpr uint64_t kDefaultCapacity = 64 * 1024 * 1024;
+  if (const char* var = std::getenv("TVM_DISCO_SHM_QUEUE_SIZE")) {
+    int64_t value = std::atoll(var);
+    CHECK_GT(value, 0) << "ValueError: TVM_DISCO_SHM_QUEUE_SIZE must be a positive number of "
+                       << "bytes, but got \"" << var << "\".";
+    return static_cast<uint64_t>(value);
+  }
+  return kDefaultCapacity;
+}
+#endif
+
 class DiscoProcessChannel final : public DiscoChannel {
  public:
-  DiscoProcessChannel(int64_t controler_to_worker_fd, int64_t worker_to_controler_fd)
+  /*!
+   * \brief Construct the channel and negotiate its transport.
+   *
+   *  The controller decides the transport and announces it over the bootstrap
+   *  pipe before any disco message flows. With TVM_DISCO_SHM_QUEUE=1 on a
+   *  POSIX host it creates one shared-memory ring per direction and sends the
+   *  segment name to the worker; tensor payloads then stream through shared
+   *  memory instead of being copied through the pipe. If the segments cannot
+   *  be created, or the environment variable is unset, both sides keep using
+   *  the pipe. The transport is opt-in because the ring waits by spinning
+   *  with sleep backoff rather than blocking in the kernel.
+   */
+  DiscoProcessChannel(int64_t controler_to_worker_fd, int64_t worker_to_controler_fd,
+                      bool is_controller)
       : controller_to_worker_pipe_(controler_to_worker_fd),
-        worker_to_controller_pipe_(worker_to_controler_fd),
-        controler_to_worker_(&controller_to_worker_pipe_),
-        worker_to_controler_(&worker_to_controller_pipe_) {}
+        worker_to_controller_pipe_(worker_to_controler_fd) {
+#if TVM_DISCO_SHM_TRANSPORT_ENABLED
+    uint64_t use_shm = 0;
+    if (is_controller) {
+      uint64_t capacity = ShmQueueCapacity();
+      std::string name;
+      if (support::BoolEnvironmentVar("TVM_DISCO_SHM_QUEUE")) {
+        static std::atomic<uint64_t> counter{0};
+        std::ostringstream os;
+        os << "/tvm_disco_" << getpid() << "_" << counter.fetch_add(1);
+        name = os.str();
+        try {
+          c2w_arena_ = std::make_unique<ShmArena>(name + "_c2w", capacity, /*create=*/true);
+          w2c_arena_ = std::make_unique<ShmArena>(name + "_w2c", capacity, /*create=*/true);
+          use_shm = 1;
+        } catch (const std::exception& err) {
+          LOG(WARNING) << "Failed to create shared-memory queue, falling back to pipe: "
+                       << err.what();
+          c2w_arena_.reset();
+          w2c_arena_.reset();
+        }
+      }
+      controller_to_worker_pipe_.Write(&use_shm, sizeof(use_shm));
+      if (use_shm) {
+        uint64_t name_size = name.size();
+        controller_to_worker_pipe_.Write(&capacity, sizeof(capacity));
+        controller_to_worker_pipe_.Write(&name_size, sizeof(name_size));
+        controller_to_worker_pipe_.Write(name.data(), name.size());
+      }
+    } else {
+      ICHECK_EQ(controller_to_worker_pipe_.Read(&use_shm, sizeof(use_shm)), sizeof(use_shm));
+      if (use_shm) {
+        uint64_t capacity = 0;
+        uint64_t name_size = 0;
+        ICHECK_EQ(controller_to_worker_pipe_.Read(&capacity, sizeof(capacity)), sizeof(capacity));
+        ICHECK_EQ(controller_to_worker_pipe_.Read(&name_size, sizeof(name_size)),
+                  sizeof(name_size));
+        std::string name(name_size, '\0');
+        ICHECK_EQ(controller_to_worker_pipe_.Read(name.data(), name_size), name_size);
+        c2w_arena_ = std::make_unique<ShmArena>(name + "_c2w", capacity, /*create=*/false);
+        w2c_arena_ = std::make_unique<ShmArena>(name + "_w2c", capacity, /*create=*/false);
+      }
+    }
+    if (use_shm) {
+      c2w_ring_ = std::make_unique<ShmRingStream>(c2w_arena_.get());
+      w2c_ring_ = std::make_unique<ShmRingStream>(w2c_arena_.get());
+      send_ring_ = is_controller ? c2w_ring_.get() : w2c_ring_.get();
+      controler_to_worker_ = std::make_unique<DiscoStreamMessageQueue>(c2w_ring_.get());
+      worker_to_controler_ = std::make_unique<DiscoStreamMessageQueue>(w2c_ring_.get());
+      return;
+    }
+#else
+    (void)is_controller;
+#endif
+    controler_to_worker_ = std::make_unique<DiscoStreamMessageQueue>(&controller_to_worker_pipe_);
+    worker_to_controler_ = std::make_unique<DiscoStreamMessageQueue>(&worker_to_controller_pipe_);
+  }
 
   DiscoProcessChannel(DiscoProcessChannel&& other) = delete;
   DiscoProcessChannel(const DiscoProcessChannel& other) = delete;
 
-  void Send(const TVMArgs& args) { controler_to_worker_.Send(args); }
-  TVMArgs Recv() { return controler_to_worker_.Recv(); }
-  void Reply(const TVMArgs& args) { worker_to_controler_.Send(args); }
-  TVMArgs RecvReply() { return worker_to_controler_.Recv(); }
+  ~DiscoProcessChannel() {
+#if TVM_DISCO_SHM_TRANSPORT_ENABLED
+    if (send_ring_ != nullptr) {
+      send_ring_->Close();
+    }
+#endif
+  }
+
+  void Send(const TVMArgs& args) { controler_to_worker_->Send(args); }
+  TVMArgs Recv() { return controler_to_worker_->Recv(); }
+  void Reply(const TVMArgs& args) { worker_to_controler_->Send(args); }
+  TVMArgs RecvReply() { return worker_to_controler_->Recv(); }
 
   support::Pipe controller_to_worker_pipe_;
   support::Pipe worker_to_controller_pipe_;
-  DiscoStreamMessageQueue controler_to_worker_;
-  DiscoStreamMessageQueue worker_to_controler_;
+#if TVM_DISCO_SHM_TRANSPORT_ENABLED
+  std::unique_ptr<ShmArena> c2w_arena_;
+  std::unique_ptr<ShmArena> w2c_arena_;
+  std::unique_ptr<ShmRingStream> c2w_ring_;
+  std::unique_ptr<ShmRingStream> w2c_ring_;
+  /*! \brief The ring this side produces into; closed on destruction. */
+  ShmRingStream* send_ring_ = nullptr;
+#endif
+  std::unique_ptr<DiscoStreamMessageQueue> controler_to_worker_;
+  std::unique_ptr<DiscoStreamMessageQueue> worker_to_controler_;
 };
 
 class ProcessSessionObj final : public BcastSessionObj {
@@ -77,7 +178,8 @@ class ProcessSessionObj final : public BcastSessionObj {
       write_fds.push_back(fds[1]);
     }
     for (int i = 0; i < num_workers - 1; ++i) {
-      workers_.emplace_back(std::make_unique<DiscoProcessChannel>(write_fds[i], read_fds[i]));
+      workers_.emplace_back(std::make_unique<DiscoProcessChannel>(write_fds[i], read_fds[i],
+                                                                  /*is_controller=*/true));
     }
   }
 
@@ -197,7 +299,7 @@ void WorkerProcess(int worker_id, int num_workers, int num_group, int64_t read_f
                    int64_t write_fd) {
   CHECK_EQ(num_workers % num_group, 0)
       << "The number of workers should be divisible by the number of worker group.";
-  DiscoProcessChannel channel(read_fd, write_fd);
+  DiscoProcessChannel channel(read_fd, write_fd, /*is_controller=*/false);
   DiscoWorker worker(worker_id, num_workers, num_group, nullptr, &channel);
   worker.MainLoop();
 }
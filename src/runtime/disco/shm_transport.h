@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file shm_transport.h
+ * \brief Shared-memory byte ring used as a fast transport between disco
+ *  processes on the same host. Tensor payloads stream through the ring
+ *  without the kernel copies a pipe requires.
+ */
+#ifndef TVM_RUNTIME_DISCO_SHM_TRANSPORT_H_
+#define TVM_RUNTIME_DISCO_SHM_TRANSPORT_H_
+
+#if defined(__linux__) || defined(__APPLE__)
+#define TVM_DISCO_SHM_TRANSPORT_ENABLED 1
+#else
+#define TVM_DISCO_SHM_TRANSPORT_ENABLED 0
+#endif
+
+#if TVM_DISCO_SHM_TRANSPORT_ENABLED
+
+#include <dmlc/io.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tvm/runtime/logging.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Control block placed at the head of a shared-memory ring segment.
+ *
+ *  `tail` and `head` are monotonically increasing byte counters (produced and
+ *  consumed respectively); their difference is the number of unread bytes.
+ *  Lock-free std::atomic on a fixed-size integer is address-free, so it
+ *  synchronizes across processes through the shared mapping.
+ */
+struct ShmRingHeader {
+  std::atomic<uint64_t> tail{0};
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint32_t> closed{0};
+  uint64_t capacity{0};
+};
+
+/*!
+ * \brief RAII owner of one POSIX shared-memory segment holding a ring.
+ *
+ *  The creating side (the disco controller) picks the name, sizes the segment
+ *  and constructs the header; the attaching side (the worker) opens it by the
+ *  name received over the bootstrap pipe. Only the creator unlinks the name;
+ *  existing mappings stay valid after the unlink.
+ */
+class ShmArena {
+ public:
+  ShmArena(const std::string& name, uint64_t capacity, bool create)
+      : name_(name), owner_(create), total_bytes_(sizeof(ShmRingHeader) + capacity) {
+    int fd = create ? shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)
+                    : shm_open(name.c_str(), O_RDWR, 0600);
+    CHECK_NE(fd, -1) << "ValueError: shm_open failed for \"" << name << "\": " << strerror(errno);
+    if (create) {
+      int ret = ftruncate(fd, static_cast<off_t>(total_bytes_));
+      if (ret == -1) {
+        close(fd);
+        shm_unlink(name.c_str());
+        LOG(FATAL) << "ValueError: ftruncate failed for \"" << name << "\": " << strerror(errno);
+      }
+    }
+    void* addr = mmap(nullptr, total_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK(addr != MAP_FAILED) << "ValueError: mmap failed for \"" << name
+                              << "\": " << strerror(errno);
+    header_ = static_cast<ShmRingHeader*>(addr);
+    data_ = static_cast<uint8_t*>(addr) + sizeof(ShmRingHeader);
+    if (create) {
+      new (header_) ShmRingHeader();
+      header_->capacity = capacity;
+    } else {
+      CHECK_EQ(header_->capacity, capacity)
+          << "InternalError: shm ring capacity mismatch between controller and worker";
+    }
+  }
+
+  ShmArena(const ShmArena& other) = delete;
+  ShmArena(ShmArena&& other) = delete;
+
+  ~ShmArena() {
+    munmap(static_cast<void*>(header_), total_bytes_);
+    if (owner_) {
+      shm_unlink(name_.c_str());
+    }
+  }
+
+  ShmRingHeader* header() const { return header_; }
+  uint8_t* data() const { return data_; }
+
+ private:
+  std::string name_;
+  bool owner_;
+  uint64_t total_bytes_;
+  ShmRingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+};
+
+/*!
+ * \brief Blocking single-producer single-consumer byte stream over a ShmArena.
+ *
+ *  Producer and consumer live in different processes; each ring is written
+ *  from exactly one side. Waiting is a bounded spin followed by short sleeps,
+ *  so an idle ring costs little CPU while an active transfer never enters the
+ *  kernel. Read returns short only when the producer closed the ring and the
+ *  ring has drained, matching the EOF behavior of support::Pipe that the
+ *  message queue relies on to detect a dropped peer.
+ */
+class ShmRingStream : public dmlc::Stream {
+ public:
+  explicit ShmRingStream(ShmArena* arena) : header_(arena->header()), data_(arena->data()) {}
+
+  size_t Read(void* ptr, size_t size) final {
+    uint8_t* out = static_cast<uint8_t*>(ptr);
+    size_t total_read = 0;
+    int spins = 0;
+    while (total_read < size) {
+      uint64_t head = header_->head.load(std::memory_order_relaxed);
+      uint64_t tail = header_->tail.load(std::memory_order_acquire);
+      uint64_t avail = tail - head;
+      if (avail == 0) {
+        if (header_->closed.load(std::memory_order_acquire)) {
+          return total_read;
+        }
+        Backoff(&spins);
+        continue;
+      }
+      spins = 0;
+      uint64_t offset = head % header_->capacity;
+      uint64_t chunk = std::min<uint64_t>(size - total_read, avail);
+      chunk = std::min<uint64_t>(chunk, header_->capacity - offset);
+      std::memcpy(out + total_read, data_ + offset, chunk);
+      header_->head.store(head + chunk, std::memory_order_release);
+      total_read += chunk;
+    }
+    return total_read;
+  }
+
+  size_t Write(const void* ptr, size_t size) final {
+    const uint8_t* in = static_cast<const uint8_t*>(ptr);
+    size_t total_written = 0;
+    int spins = 0;
+    while (total_written < size) {
+      uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+      uint64_t head = header_->head.load(std::memory_order_acquire);
+      uint64_t free_bytes = header_->capacity - (tail - head);
+      if (free_bytes == 0) {
+        Backoff(&spins);
+        continue;
+      }
+      spins = 0;
+      uint64_t offset = tail % header_->capacity;
+      uint64_t chunk = std::min<uint64_t>(size - total_written, free_bytes);
+      chunk = std::min<uint64_t>(chunk, header_->capacity - offset);
+      std::memcpy(data_ + offset, in + total_written, chunk);
+      header_->tail.store(tail + chunk, std::memory_order_release);
+      total_written += chunk;
+    }
+    return total_written;
+  }
+
+  /*! \brief Mark the producer side gone; the reader drains and then sees EOF. */
+  void Close() { header_->closed.store(1, std::memory_order_release); }
+
+ private:
+  static void Backoff(int* spins) {
+    if (++*spins < 256) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+  ShmRingHeader* header_;
+  uint8_t* data_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_DISCO_SHM_TRANSPORT_ENABLED
+#endif  // TVM_RUNTIME_DISCO_SHM_TRANSPORT_H_
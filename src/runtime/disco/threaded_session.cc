@@ -20,9 +20,12 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/disco/disco_worker.h>
 #include <tvm/runtime/object.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -36,6 +39,22 @@
 
 namespace tvm {
 namespace runtime {
+namespace {
+
+// Time budget in microseconds the receiving side of a threaded message queue
+// busy-polls for the next packet before backing off to a condition-variable
+// sleep; negative disables busy polling. The per-step commands of a
+// tensor-parallel decode loop are tiny, so polling keeps the latency of
+// broadcasting them well below the cost of a condition-variable wakeup.
+int64_t DiscoBusyPollBudgetUs() {
+  static int64_t budget = []() -> int64_t {
+    const char* val = getenv("TVM_DISCO_BUSY_POLL_US");
+    return val ? atoll(val) : -1;
+  }();
+  return budget;
+}
+
+}  // namespace
 
 class DiscoThreadedMessageQueue : private dmlc::Stream,
                                   private DiscoProtocol<DiscoThreadedMessageQueue> {
@@ -71,6 +90,21 @@ class DiscoThreadedMessageQueue : private dmlc::Stream,
 
   void DequeueNextPacket() {
     {
+      int64_t poll_budget_us = DiscoBusyPollBudgetUs();
+      if (poll_budget_us >= 0 && msg_cnt_.load(std::memory_order_acquire) == 0) {
+        // Busy-poll the padded message counter without touching the mutex so
+        // an idle worker picks up the next command at memory latency.
+        auto start = std::chrono::steady_clock::now();
+        while (msg_cnt_.load(std::memory_order_acquire) == 0) {
+          tvm::runtime::threading::Yield();
+          auto waited_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+          if (waited_us >= poll_budget_us) {
+            break;
+          }
+        }
+      }
       std::unique_lock<std::mutex> lock(mutex_);
       dequeue_waiting_ = true;
       condition_.wait(lock, [this] { return msg_cnt_.load() > 0; });
@@ -117,7 +151,12 @@ class DiscoThreadedMessageQueue : private dmlc::Stream,
   bool dequeue_waiting_ = false;
 
   std::mutex mutex_;
+  // Pad the message counter onto its own cache line so a busy-polling
+  // receiver does not contend with the sender's writes to adjacent fields.
+  typedef char cache_line_pad_t[64];
+  cache_line_pad_t pad0_;
   std::atomic<int> msg_cnt_{0};
+  cache_line_pad_t pad1_;
   std::condition_variable condition_;
   support::RingBuffer ring_buffer_;
 };
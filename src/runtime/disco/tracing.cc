@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file tracing.cc
+ * \brief Timeline tracing of disco worker command execution.
+ */
+#include "./tracing.h"
+
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/disco/disco_worker.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "../../support/str_escape.h"
+
+namespace tvm {
+namespace runtime {
+
+DiscoTracer* DiscoTracer::Global() {
+  static DiscoTracer* tracer = new DiscoTracer();
+  return tracer;
+}
+
+void DiscoTracer::RecordCommand(int worker_id, std::string name, int64_t recv_us, int64_t end_us,
+                                int64_t device_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t seq = seq_counters_[worker_id]++;
+  events_.push_back(TraceEvent{worker_id, seq, std::move(name), recv_us, end_us, device_ns});
+}
+
+void DiscoTracer::RecordGlobalFunc(int worker_id, int64_t reg_id, const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  func_names_[(static_cast<uint64_t>(worker_id) << 32) | static_cast<uint64_t>(reg_id)] = name;
+}
+
+std::string DiscoTracer::LookupFuncName(int worker_id, int64_t reg_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = func_names_.find((static_cast<uint64_t>(worker_id) << 32) | static_cast<uint64_t>(reg_id));
+  return it == func_names_.end() ? "" : it->second;
+}
+
+String DiscoTracer::CollectJSON(int worker_id) {
+  std::vector<TraceEvent> collected;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::stable_partition(
+        events_.begin(), events_.end(),
+        [worker_id](const TraceEvent& event) { return event.worker_id != worker_id; });
+    collected.assign(std::make_move_iterator(it), std::make_move_iterator(events_.end()));
+    events_.erase(it, events_.end());
+  }
+  std::ostringstream os;
+  os << "[";
+  for (size_t i = 0; i < collected.size(); ++i) {
+    const TraceEvent& event = collected[i];
+    if (i != 0) {
+      os << ",";
+    }
+    os << "{\"name\":\"" << support::StrEscape(event.name) << "\",\"ph\":\"X\",\"pid\":0"
+       << ",\"tid\":" << event.worker_id << ",\"ts\":" << event.recv_us
+       << ",\"dur\":" << (event.end_us - event.recv_us) << ",\"args\":{\"seq\":" << event.seq
+       << ",\"device_ns\":" << event.device_ns << "}}";
+  }
+  os << "]";
+  return String(os.str());
+}
+
+namespace {
+
+/*!
+ * \brief Extract (seq, ts) pairs from a fragment produced by CollectJSON.
+ * The fragment layout is fixed by CollectJSON, so simple key scanning is
+ * enough; no general JSON parser is needed.
+ */
+std::vector<std::pair<int64_t, int64_t>> ExtractSeqTimestamps(const std::string& fragment) {
+  std::vector<std::pair<int64_t, int64_t>> result;
+  size_t pos = 0;
+  while ((pos = fragment.find("\"ts\":", pos)) != std::string::npos) {
+    int64_t ts = std::atoll(fragment.c_str() + pos + 5);
+    size_t seq_pos = fragment.find("\"seq\":", pos);
+    if (seq_pos == std::string::npos) {
+      break;
+    }
+    int64_t seq = std::atoll(fragment.c_str() + seq_pos + 6);
+    result.emplace_back(seq, ts);
+    pos = seq_pos;
+  }
+  return result;
+}
+
+}  // namespace
+
+String DiscoTracer::MergeJSON(const std::vector<String>& fragments) {
+  // Per command sequence number, the spread of receipt times across workers
+  // tells which rank arrived late at that command, e.g. at a collective.
+  std::map<int64_t, std::pair<int64_t, int64_t>> seq_range;  // seq -> (min_ts, max_ts)
+  for (const String& fragment : fragments) {
+    for (const auto& [seq, ts] : ExtractSeqTimestamps(fragment.operator std::string())) {
+      auto it = seq_range.find(seq);
+      if (it == seq_range.end()) {
+        seq_range.emplace(seq, std::make_pair(ts, ts));
+      } else {
+        it->second.first = std::min(it->second.first, ts);
+        it->second.second = std::max(it->second.second, ts);
+      }
+    }
+  }
+  int64_t max_skew = 0;
+  int64_t max_skew_seq = -1;
+  for (const auto& [seq, range] : seq_range) {
+    int64_t spread = range.second - range.first;
+    if (spread > max_skew) {
+      max_skew = spread;
+      max_skew_seq = seq;
+    }
+  }
+  std::ostringstream os;
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for (const String& fragment : fragments) {
+    // strip the surrounding brackets of the per-worker array
+    std::string content = fragment.operator std::string();
+    if (content.size() >= 2) {
+      content = content.substr(1, content.size() - 2);
+    }
+    if (content.empty()) {
+      continue;
+    }
+    if (!first) {
+      os << ",";
+    }
+    os << content;
+    first = false;
+  }
+  os << "],\"displayTimeUnit\":\"ms\",\"skew_us\":{\"max\":" << max_skew
+     << ",\"max_seq\":" << max_skew_seq << "}}";
+  return String(os.str());
+}
+
+TVM_REGISTER_GLOBAL("runtime.disco.trace_start").set_body_typed([]() {
+  DiscoTracer::Global()->Enable();
+});
+
+TVM_REGISTER_GLOBAL("runtime.disco.trace_stop").set_body_typed([]() {
+  DiscoTracer::Global()->Disable();
+});
+
+TVM_REGISTER_GLOBAL("runtime.disco.trace_collect").set_body_typed([]() -> String {
+  return DiscoTracer::Global()->CollectJSON(DiscoWorker::ThreadLocal()->worker_id);
+});
+
+TVM_REGISTER_GLOBAL("runtime.disco.trace_merge").set_body_typed([](Array<String> fragments) {
+  std::vector<String> frags(fragments.begin(), fragments.end());
+  return DiscoTracer::MergeJSON(frags);
+});
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file tracing.h
+ * \brief Timeline tracing of disco worker command execution.
+ */
+#ifndef TVM_RUNTIME_DISCO_TRACING_H_
+#define TVM_RUNTIME_DISCO_TRACING_H_
+
+#include <tvm/runtime/container/string.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Collects per-worker timelines of disco command execution.
+ *
+ *  Each worker records one entry per executed command: the wall-clock receipt
+ *  and completion times, plus the device-timer duration for packed calls.
+ *  Timestamps come from the system clock so entries from workers in different
+ *  processes on the same host line up on one timeline; the gap between a
+ *  command's completion and the next command's receipt is the time the worker
+ *  spent waiting on its channel. Workers in the same process share this
+ *  singleton and are told apart by worker id.
+ *
+ *  Tracing is controlled with the `runtime.disco.trace_start` /
+ *  `trace_stop` globals (broadcast to all workers), per-worker fragments are
+ *  drained with `runtime.disco.trace_collect`, and
+ *  `runtime.disco.trace_merge` merges the fragments into one
+ *  chrome://tracing JSON document with cross-worker skew statistics.
+ */
+class DiscoTracer {
+ public:
+  /*! \brief One executed command on one worker. */
+  struct TraceEvent {
+    /*! \brief The worker that executed the command. */
+    int worker_id;
+    /*! \brief Index of the command in the worker's receive order. */
+    int64_t seq;
+    /*! \brief Event label: the called function, or the disco action name. */
+    std::string name;
+    /*! \brief Wall-clock receipt time in microseconds. */
+    int64_t recv_us;
+    /*! \brief Wall-clock completion time in microseconds. */
+    int64_t end_us;
+    /*! \brief Device-timer duration of the call in nanoseconds; 0 if untimed. */
+    int64_t device_ns;
+  };
+
+  /*! \brief Return the process-wide tracer singleton. */
+  static DiscoTracer* Global();
+
+  /*! \brief Whether tracing is currently on; cheap enough for the hot loop. */
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  void Enable() { enabled_.store(true, std::memory_order_relaxed); }
+  void Disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+  /*! \brief The current wall-clock time in microseconds. */
+  static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /*! \brief Append one executed command to the worker's timeline. */
+  void RecordCommand(int worker_id, std::string name, int64_t recv_us, int64_t end_us,
+                     int64_t device_ns);
+
+  /*! \brief Remember the function name resolved into a worker register. */
+  void RecordGlobalFunc(int worker_id, int64_t reg_id, const std::string& name);
+
+  /*! \brief Look up the name behind a function register; empty if unknown. */
+  std::string LookupFuncName(int worker_id, int64_t reg_id);
+
+  /*!
+   * \brief Drain the given worker's events into a chrome://tracing fragment.
+   * \param worker_id The worker whose events to collect.
+   * \return A JSON array of trace events for this worker.
+   */
+  String CollectJSON(int worker_id);
+
+  /*!
+   * \brief Merge per-worker fragments into one chrome://tracing document.
+   * \param fragments One CollectJSON result per worker.
+   * \return A JSON object with "traceEvents" and a "skew_us" summary giving
+   *  the largest receipt-time spread across workers for any one command.
+   */
+  static String MergeJSON(const std::vector<String>& fragments);
+
+ private:
+  DiscoTracer() = default;
+
+  std::atomic<bool> enabled_{false};
+  std::mutex mutex_;
+  std::vector<TraceEvent> events_;
+  /*! \brief Per-worker count of received commands, indexed lazily. */
+  std::unordered_map<int, int64_t> seq_counters_;
+  /*! \brief Function names keyed by (worker_id << 32 | reg_id). */
+  std::unordered_map<uint64_t, std::string> func_names_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_DISCO_TRACING_H_
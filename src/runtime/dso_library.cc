@@ -34,6 +34,13 @@
 #include <dlfcn.h>
 #endif
 
+#if defined(__linux__) && !defined(__hexagon__)
+#include <link.h>
+#include <sys/mman.h>
+
+#include <cstdlib>
+#endif
+
 #if defined(__hexagon__)
 extern "C" {
 #include <HAP_farf.h>
@@ -120,10 +127,63 @@ void DSOLibrary::Unload() {
 
 #else
 
+#if defined(__linux__) && !defined(__hexagon__)
+/*!
+ * \brief Advise the kernel to back the library's executable segments with huge pages.
+ *
+ *  Large compiled models carry hundreds of megabytes of text; 4K iTLB entries thrash on
+ *  them. MADV_HUGEPAGE is a hint - it needs transparent huge pages enabled and only the
+ *  2MB-aligned interior of each segment is eligible - so failures are silently ignored.
+ */
+void AdviseHugePageText(void* lib_handle) {
+  link_map* lm = nullptr;
+  if (dlinfo(lib_handle, RTLD_DI_LINKMAP, &lm) != 0 || lm == nullptr) {
+    return;
+  }
+  struct CallbackData {
+    ElfW(Addr) base;
+    bool found;
+  } data = {lm->l_addr, false};
+  dl_iterate_phdr(
+      [](dl_phdr_info* info, size_t, void* arg) -> int {
+        auto* data = static_cast<CallbackData*>(arg);
+        if (info->dlpi_addr != data->base) {
+          return 0;
+        }
+        data->found = true;
+        constexpr uintptr_t kHugePageSize = 2 * 1024 * 1024;
+        for (int i = 0; i < info->dlpi_phnum; ++i) {
+          const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+          if (phdr.p_type != PT_LOAD || !(phdr.p_flags & PF_X)) {
+            continue;
+          }
+          uintptr_t begin = info->dlpi_addr + phdr.p_vaddr;
+          uintptr_t end = begin + phdr.p_memsz;
+          begin = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+          end = end & ~(kHugePageSize - 1);
+          if (begin < end) {
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+          }
+        }
+        return 1;
+      },
+      &data);
+}
+#endif  // defined(__linux__) && !defined(__hexagon__)
+
 void DSOLibrary::Load(const std::string& name) {
   lib_handle_ = dlopen(name.c_str(), RTLD_LAZY | RTLD_LOCAL);
   ICHECK(lib_handle_ != nullptr) << "Failed to load dynamic shared library " << name << " "
                                  << dlerror();
+#if defined(__linux__) && !defined(__hexagon__)
+  static bool hugepage_text = []() -> bool {
+    const char* var = std::getenv("TVM_HUGEPAGE_TEXT");
+    return var != nullptr && std::atoi(var) != 0;
+  }();
+  if (hugepage_text) {
+    AdviseHugePageText(lib_handle_);
+  }
+#endif
 #if defined(__hexagon__)
   int p;
   int rc = dlinfo(lib_handle_, RTLD_DI_LOAD_ADDR, &p);
@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file dtype_convert.cc
+ * \brief Batched conversion between fp32 and the 16-bit float formats.
+ */
+#include "./dtype_convert.h"
+
+#include <tvm/runtime/builtin_fp16.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TVM_DTYPE_CONVERT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TVM_DTYPE_CONVERT_TARGET_F16C
+#else
+#include <cpuid.h>
+#define TVM_DTYPE_CONVERT_TARGET_F16C __attribute__((target("avx,f16c")))
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TVM_DTYPE_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+/**************** Scalar fallback ****************/
+
+void FP16ToFP32Scalar(const uint8_t* src, float* dst, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    uint16_t bits;
+    std::memcpy(&bits, src + i * 2, 2);
+    dst[i] = __gnu_h2f_ieee(bits);
+  }
+}
+
+void FP32ToFP16Scalar(const float* src, uint8_t* dst, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    uint16_t bits = __gnu_f2h_ieee(src[i]);
+    std::memcpy(dst + i * 2, &bits, 2);
+  }
+}
+
+void BF16ToFP32Scalar(const uint8_t* src, float* dst, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    uint16_t half;
+    std::memcpy(&half, src + i * 2, 2);
+    uint32_t bits = static_cast<uint32_t>(half) << 16;
+    std::memcpy(&dst[i], &bits, 4);
+  }
+}
+
+uint16_t FP32ToBF16One(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, 4);
+  if ((~bits & 0x7f800000) != 0) {
+    // Normal and subnormal values: round to nearest even
+    bits += 0x7fff + ((bits >> 16) & 1);
+  } else if ((bits & 0x007fffff) != 0) {
+    // NaN: keep it a NaN after the mantissa truncation
+    bits |= 0x00010000;
+  }
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+void FP32ToBF16Scalar(const float* src, uint8_t* dst, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    uint16_t bits = FP32ToBF16One(src[i]);
+    std::memcpy(dst + i * 2, &bits, 2);
+  }
+}
+
+/**************** x86: F16C for fp16, baseline SSE2 for bf16 ****************/
+
+#ifdef TVM_DTYPE_CONVERT_X86
+
+bool SupportsF16C() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 29)) != 0;
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (ecx & (1u << 29)) != 0;
+#endif
+}
+
+TVM_DTYPE_CONVERT_TARGET_F16C void FP16ToFP32F16C(const uint8_t* src, float* dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+  }
+  FP16ToFP32Scalar(src + i * 2, dst + i, n - i);
+}
+
+TVM_DTYPE_CONVERT_TARGET_F16C void FP32ToFP16F16C(const float* src, uint8_t* dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), half);
+  }
+  FP32ToFP16Scalar(src + i, dst + i * 2, n - i);
+}
+
+// SSE2 is baseline on x86-64, so the bf16 widening needs no dispatch.
+void BF16ToFP32SSE2(const uint8_t* src, float* dst, size_t n) {
+  size_t i = 0;
+  __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    // Interleaving with zeros in the low half realizes the `<< 16` widening
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(zero, half));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(zero, half));
+  }
+  BF16ToFP32Scalar(src + i * 2, dst + i, n - i);
+}
+
+#endif  // TVM_DTYPE_CONVERT_X86
+
+/**************** AArch64: NEON ****************/
+
+#ifdef TVM_DTYPE_CONVERT_NEON
+
+void FP16ToFP32Neon(const uint8_t* src, float* dst, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint16x4_t half = vld1_u16(reinterpret_cast<const uint16_t*>(src + i * 2));
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(half)));
+  }
+  FP16ToFP32Scalar(src + i * 2, dst + i, n - i);
+}
+
+void FP32ToFP16Neon(const float* src, uint8_t* dst, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint16x4_t half = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i)));
+    vst1_u16(reinterpret_cast<uint16_t*>(dst + i * 2), half);
+  }
+  FP32ToFP16Scalar(src + i, dst + i * 2, n - i);
+}
+
+void BF16ToFP32Neon(const uint8_t* src, float* dst, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint16x4_t half = vld1_u16(reinterpret_cast<const uint16_t*>(src + i * 2));
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst + i), vshll_n_u16(half, 16));
+  }
+  BF16ToFP32Scalar(src + i * 2, dst + i, n - i);
+}
+
+#endif  // TVM_DTYPE_CONVERT_NEON
+
+}  // namespace
+
+void FP16ToFP32(const void* src, float* dst, size_t n) {
+  const uint8_t* in = static_cast<const uint8_t*>(src);
+#ifdef TVM_DTYPE_CONVERT_X86
+  static const bool has_f16c = SupportsF16C();
+  if (has_f16c) {
+    FP16ToFP32F16C(in, dst, n);
+    return;
+  }
+#elif defined(TVM_DTYPE_CONVERT_NEON)
+  FP16ToFP32Neon(in, dst, n);
+  return;
+#endif
+  FP16ToFP32Scalar(in, dst, n);
+}
+
+void FP32ToFP16(const float* src, void* dst, size_t n) {
+  uint8_t* out = static_cast<uint8_t*>(dst);
+#ifdef TVM_DTYPE_CONVERT_X86
+  static const bool has_f16c = SupportsF16C();
+  if (has_f16c) {
+    FP32ToFP16F16C(src, out, n);
+    return;
+  }
+#elif defined(TVM_DTYPE_CONVERT_NEON)
+  FP32ToFP16Neon(src, out, n);
+  return;
+#endif
+  FP32ToFP16Scalar(src, out, n);
+}
+
+void BF16ToFP32(const void* src, float* dst, size_t n) {
+  const uint8_t* in = static_cast<const uint8_t*>(src);
+#ifdef TVM_DTYPE_CONVERT_X86
+  BF16ToFP32SSE2(in, dst, n);
+#elif defined(TVM_DTYPE_CONVERT_NEON)
+  BF16ToFP32Neon(in, dst, n);
+#else
+  BF16ToFP32Scalar(in, dst, n);
+#endif
+}
+
+void FP32ToBF16(const float* src, void* dst, size_t n) {
+  // Narrowing with round-to-nearest-even has no single-instruction SIMD
+  // counterpart below AVX512-BF16; the scalar loop vectorizes reasonably.
+  FP32ToBF16Scalar(src, static_cast<uint8_t*>(dst), n);
+}
+
+namespace {
+
+void CheckConversionArgs(const NDArray& src, const NDArray& dst, DataType src_dtype,
+                         DataType dst_dtype) {
+  CHECK(src->device.device_type == kDLCPU || src->device.device_type == kDLCUDAHost ||
+        src->device.device_type == kDLROCMHost)
+      << "ValueError: dtype conversion builtins only operate on host tensors";
+  CHECK(dst->device.device_type == kDLCPU || dst->device.device_type == kDLCUDAHost ||
+        dst->device.device_type == kDLROCMHost)
+      << "ValueError: dtype conversion builtins only operate on host tensors";
+  CHECK(src.DataType() == src_dtype)
+      << "ValueError: expected source dtype " << src_dtype << ", but got " << src.DataType();
+  CHECK(dst.DataType() == dst_dtype)
+      << "ValueError: expected destination dtype " << dst_dtype << ", but got " << dst.DataType();
+  CHECK_EQ(src.Shape()->Product(), dst.Shape()->Product())
+      << "ValueError: source and destination must have the same number of elements";
+}
+
+TVM_REGISTER_GLOBAL("runtime.FP16ToFP32").set_body_typed([](NDArray src, NDArray dst) {
+  CheckConversionArgs(src, dst, DataType::Float(16), DataType::Float(32));
+  FP16ToFP32(src->data, static_cast<float*>(dst->data), src.Shape()->Product());
+});
+
+TVM_REGISTER_GLOBAL("runtime.FP32ToFP16").set_body_typed([](NDArray src, NDArray dst) {
+  CheckConversionArgs(src, dst, DataType::Float(32), DataType::Float(16));
+  FP32ToFP16(static_cast<const float*>(src->data), dst->data, src.Shape()->Product());
+});
+
+TVM_REGISTER_GLOBAL("runtime.BF16ToFP32").set_body_typed([](NDArray src, NDArray dst) {
+  CheckConversionArgs(src, dst, DataType::BFloat(16), DataType::Float(32));
+  BF16ToFP32(src->data, static_cast<float*>(dst->data), src.Shape()->Product());
+});
+
+TVM_REGISTER_GLOBAL("runtime.FP32ToBF16").set_body_typed([](NDArray src, NDArray dst) {
+  CheckConversionArgs(src, dst, DataType::Float(32), DataType::BFloat(16));
+  FP32ToBF16(static_cast<const float*>(src->data), dst->data, src.Shape()->Product());
+});
+
+}  // namespace
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file dtype_convert.h
+ * \brief Batched conversion between fp32 and the 16-bit float formats.
+ *
+ *  The kernels dispatch to SIMD implementations at runtime when the host
+ *  supports them (F16C on x86, NEON on AArch64) and otherwise fall back to
+ *  the scalar conversion helpers from builtin_fp16.cc. The 16-bit source and
+ *  destination pointers may be unaligned.
+ */
+#ifndef TVM_RUNTIME_DTYPE_CONVERT_H_
+#define TVM_RUNTIME_DTYPE_CONVERT_H_
+
+#include <cstddef>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief Convert `n` IEEE fp16 values to fp32. */
+void FP16ToFP32(const void* src, float* dst, size_t n);
+
+/*! \brief Convert `n` fp32 values to IEEE fp16, rounding to nearest even. */
+void FP32ToFP16(const float* src, void* dst, size_t n);
+
+/*! \brief Convert `n` bfloat16 values to fp32. */
+void BF16ToFP32(const void* src, float* dst, size_t n);
+
+/*! \brief Convert `n` fp32 values to bfloat16, rounding to nearest even. */
+void FP32ToBF16(const float* src, void* dst, size_t n);
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_DTYPE_CONVERT_H_
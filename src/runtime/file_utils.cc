@@ -32,6 +32,13 @@
 #include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace tvm {
 namespace runtime {
 
@@ -127,6 +134,40 @@ void LoadBinaryFromFile(const std::string& file_name, std::string* data) {
   fs.read(&(*data)[0], size);
 }
 
+MemoryMappedFile::~MemoryMappedFile() {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+#endif
+}
+
+std::shared_ptr<MemoryMappedFile> MemoryMappedFile::Open(const std::string& file_name) {
+#ifndef _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  auto result = std::make_shared<MemoryMappedFile>();
+  result->data_ = static_cast<char*>(data);
+  result->size_ = static_cast<size_t>(st.st_size);
+  return result;
+#else
+  return nullptr;
+#endif
+}
+
 void SaveBinaryToFile(const std::string& file_name, const std::string& data) {
   std::ofstream fs(file_name, std::ios::out | std::ios::binary);
   ICHECK(!fs.fail()) << "Cannot open " << file_name;
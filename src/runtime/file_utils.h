@@ -27,6 +27,7 @@
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -67,6 +68,33 @@ std::string GetFileBasename(const std::string& file_name);
  */
 void LoadBinaryFromFile(const std::string& file_name, std::string* data);
 
+/*!
+ * \brief A read-only memory mapping of a file.
+ *
+ *  The mapping aliases the OS page cache, so large files (e.g. parameter
+ *  shards) can be accessed without copying and the pages are shared between
+ *  processes mapping the same file.
+ */
+class MemoryMappedFile {
+ public:
+  ~MemoryMappedFile();
+  /*!
+   * \brief Map a file read-only.
+   * \param file_name The name of the file.
+   * \return The mapping, or nullptr if mapping is unsupported on this
+   *         platform or fails for the given file.
+   */
+  static std::shared_ptr<MemoryMappedFile> Open(const std::string& file_name);
+  /*! \return Base address of the mapped region. */
+  const char* data() const { return data_; }
+  /*! \return Size of the mapped region in bytes. */
+  size_t size() const { return size_; }
+
+ private:
+  char* data_{nullptr};
+  size_t size_{0};
+};
+
 /*!
  * \brief Load binary file into a in-memory buffer.
  * \param file_name The name of the file.
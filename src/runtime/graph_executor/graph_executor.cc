@@ -22,6 +22,7 @@
  */
 #include "graph_executor.h"
 
+#include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/runtime/data_type.h>
@@ -34,6 +35,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -41,7 +43,10 @@
 #include <utility>
 #include <vector>
 
+#include "../async_run_handle.h"
 #include "../file_utils.h"
+#include "../latency_monitor.h"
+#include "../library_module.h"
 #include "../texture.h"
 
 namespace tvm {
@@ -59,12 +64,137 @@ constexpr auto Is2DStorage = IsTextureStorage;
  * \brief Run all the operations one by one.
  */
 void GraphExecutor::Run() {
+  if (num_execution_streams_ > 1) {
+    this->RunPipelined();
+    return;
+  }
+  static const uint32_t invoke_scope =
+      profiling::LatencyMonitor::Global()->RegisterScope("graph_executor.run");
+  profiling::ScopedLatencyTimer invoke_timer(invoke_scope);
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
   }
 }
 
+GraphExecutor::~GraphExecutor() { this->FreeExecutionStreams(); }
+
+void GraphExecutor::SetNumExecutionStreams(int num_streams) {
+  if (num_streams < 1) {
+    num_streams = 1;
+  }
+  if (num_streams > 1) {
+    CHECK_EQ(devices_.size(), 1U)
+        << "Pipelined execution supports single-device graphs, but the graph uses "
+        << devices_.size() << " devices";
+  }
+  this->FreeExecutionStreams();
+  pipelined_ops_.clear();
+  num_execution_streams_ = num_streams;
+  if (num_streams > 1) {
+    this->SetupPipelinedExecution();
+  }
+}
+
+void GraphExecutor::FreeExecutionStreams() {
+  if (exec_streams_.size() > 1) {
+    DeviceAPI* api = DeviceAPI::Get(devices_[0]);
+    for (size_t i = 1; i < exec_streams_.size(); ++i) {
+      api->FreeStream(devices_[0], exec_streams_[i]);
+    }
+  }
+  exec_streams_.clear();
+  if (param_copy_stream_ != nullptr) {
+    DeviceAPI::Get(devices_[0])->FreeStream(devices_[0], param_copy_stream_);
+    param_copy_stream_ = nullptr;
+  }
+}
+
+void GraphExecutor::SetupPipelinedExecution() {
+  uint32_t n = this->GetNumOfNodes();
+  ICHECK_EQ(op_execs_.size(), n) << "Pipelined execution must be set up after Init";
+  // The stream each node was issued on; -1 for non-op nodes.
+  std::vector<int> node_stream(n, -1);
+  // The last node issued on each stream.
+  std::vector<int> stream_tail(num_execution_streams_, -1);
+  int next_stream = 0;
+  pipelined_ops_.reserve(n);
+  for (uint32_t nid = 0; nid < n; ++nid) {
+    if (!op_execs_[nid]) continue;
+    const Node& inode = nodes_[nid];
+    // The op nodes producing this op's inputs, deduplicated.
+    std::vector<uint32_t> deps;
+    for (const NodeEntry& e : inode.inputs) {
+      if (op_execs_[e.node_id] && std::find(deps.begin(), deps.end(), e.node_id) == deps.end()) {
+        deps.push_back(e.node_id);
+      }
+    }
+    for (uint32_t dep : inode.control_deps) {
+      if (op_execs_[dep] && std::find(deps.begin(), deps.end(), dep) == deps.end()) {
+        deps.push_back(dep);
+      }
+    }
+    // Continue on the stream of a producer that is still that stream's tail,
+    // so single-consumer chains stay on one stream without synchronization;
+    // otherwise start a new chain, rotating over the streams.
+    int stream_idx = -1;
+    for (uint32_t dep : deps) {
+      int s = node_stream[dep];
+      if (s >= 0 && stream_tail[s] == static_cast<int>(dep)) {
+        stream_idx = s;
+        break;
+      }
+    }
+    if (stream_idx < 0) {
+      stream_idx = next_stream % num_execution_streams_;
+      ++next_stream;
+    }
+    // Wait for the streams of every producer issued elsewhere. Ops are issued
+    // in topological order, so at issue time the producer's work is already
+    // submitted to its stream and an event-based wait covers it.
+    std::vector<int> waits;
+    for (uint32_t dep : deps) {
+      int s = node_stream[dep];
+      if (s >= 0 && s != stream_idx && std::find(waits.begin(), waits.end(), s) == waits.end()) {
+        waits.push_back(s);
+      }
+    }
+    node_stream[nid] = stream_idx;
+    stream_tail[stream_idx] = static_cast<int>(nid);
+    pipelined_ops_.push_back(PipelinedOp{nid, stream_idx, std::move(waits)});
+  }
+  // Entry 0 is the device's default stream.
+  DeviceAPI* api = DeviceAPI::Get(devices_[0]);
+  exec_streams_.resize(num_execution_streams_, nullptr);
+  for (int i = 1; i < num_execution_streams_; ++i) {
+    exec_streams_[i] = api->CreateStream(devices_[0]);
+  }
+}
+
+void GraphExecutor::RunPipelined() {
+  Device dev = devices_[0];
+  DeviceAPI* api = DeviceAPI::Get(dev);
+  int cur_stream = 0;
+  for (const PipelinedOp& op : pipelined_ops_) {
+    for (int src : op.wait_stream_idxs) {
+      api->SyncStreamFromTo(dev, exec_streams_[src], exec_streams_[op.stream_idx]);
+    }
+    if (op.stream_idx != cur_stream) {
+      api->SetStream(dev, exec_streams_[op.stream_idx]);
+      cur_stream = op.stream_idx;
+    }
+    op_execs_[op.nid]();
+  }
+  // Funnel every side stream back into the default stream, so output reads
+  // and device synchronization observe all submitted work.
+  for (int i = 1; i < num_execution_streams_; ++i) {
+    api->SyncStreamFromTo(dev, exec_streams_[i], exec_streams_[0]);
+  }
+  if (cur_stream != 0) {
+    api->SetStream(dev, exec_streams_[0]);
+  }
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -80,6 +210,19 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
   std::istringstream is(graph_json);
   dmlc::JSONReader reader(&is);
   this->Load(&reader);
+  this->InitCommon(module, devs, lookup_linked_param_func);
+}
+
+void GraphExecutor::InitFromParsedGraph(const std::string& graph_blob, tvm::runtime::Module module,
+                                        const std::vector<Device>& devs,
+                                        const PackedFunc lookup_linked_param_func) {
+  dmlc::MemoryFixedSizeStream strm(const_cast<char*>(graph_blob.data()), graph_blob.size());
+  this->LoadParsedGraph(&strm);
+  this->InitCommon(module, devs, lookup_linked_param_func);
+}
+
+void GraphExecutor::InitCommon(tvm::runtime::Module module, const std::vector<Device>& devs,
+                               PackedFunc lookup_linked_param_func) {
   module_ = module;
   devices_ = devs;
   lookup_linked_param_ = lookup_linked_param_func;
@@ -103,6 +246,127 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
   }
 }
 
+// Magic number and version of the binary warm-plan format holding the parsed graph.
+constexpr uint64_t kTVMParsedGraphMagic = 0x54564D47504C414E;
+constexpr uint32_t kTVMParsedGraphVersion = 1;
+
+void GraphExecutor::SaveParsedGraph(dmlc::Stream* strm) const {
+  strm->Write(kTVMParsedGraphMagic);
+  strm->Write(kTVMParsedGraphVersion);
+  uint64_t num_nodes = nodes_.size();
+  strm->Write(num_nodes);
+  for (const Node& node : nodes_) {
+    strm->Write(node.op_type);
+    strm->Write(node.name);
+    strm->Write(node.param.func_name);
+    strm->Write(node.param.num_inputs);
+    strm->Write(node.param.num_outputs);
+    strm->Write(node.param.flatten_data);
+    // Node attributes only ever hold strings, see Node::LoadAttrs.
+    std::map<std::string, std::string> attrs;
+    for (const auto& kv : node.param.attrs) {
+      attrs.emplace(kv.first, Downcast<String>(kv.second).operator std::string());
+    }
+    strm->Write(attrs);
+    std::vector<uint32_t> inputs;
+    inputs.reserve(node.inputs.size() * 3);
+    for (const NodeEntry& e : node.inputs) {
+      inputs.push_back(e.node_id);
+      inputs.push_back(e.index);
+      inputs.push_back(e.version);
+    }
+    strm->Write(inputs);
+    strm->Write(node.control_deps);
+  }
+  strm->Write(input_nodes_);
+  strm->Write(node_row_ptr_);
+  std::vector<uint32_t> outputs;
+  outputs.reserve(outputs_.size() * 3);
+  for (const NodeEntry& e : outputs_) {
+    outputs.push_back(e.node_id);
+    outputs.push_back(e.index);
+    outputs.push_back(e.version);
+  }
+  strm->Write(outputs);
+  strm->Write(attrs_.storage_id);
+  strm->Write(attrs_.device_index);
+  strm->Write(attrs_.dltype);
+  strm->Write(attrs_.storage_scope);
+  uint64_t num_shapes = attrs_.shape.size();
+  strm->Write(num_shapes);
+  for (const std::vector<int64_t>& shape : attrs_.shape) {
+    strm->Write(shape);
+  }
+}
+
+void GraphExecutor::LoadParsedGraph(dmlc::Stream* strm) {
+  uint64_t magic;
+  uint32_t version;
+  ICHECK(strm->Read(&magic)) << "ValueError: Invalid parsed-graph blob";
+  ICHECK_EQ(magic, kTVMParsedGraphMagic) << "ValueError: Invalid parsed-graph blob";
+  ICHECK(strm->Read(&version)) << "ValueError: Invalid parsed-graph blob";
+  ICHECK_EQ(version, kTVMParsedGraphVersion)
+      << "ValueError: Unsupported parsed-graph version " << version;
+  uint64_t num_nodes;
+  ICHECK(strm->Read(&num_nodes)) << "ValueError: Invalid parsed-graph blob";
+  nodes_.resize(num_nodes);
+  for (Node& node : nodes_) {
+    ICHECK(strm->Read(&node.op_type));
+    ICHECK(strm->Read(&node.name));
+    ICHECK(strm->Read(&node.param.func_name));
+    ICHECK(strm->Read(&node.param.num_inputs));
+    ICHECK(strm->Read(&node.param.num_outputs));
+    ICHECK(strm->Read(&node.param.flatten_data));
+    std::map<std::string, std::string> attrs;
+    ICHECK(strm->Read(&attrs));
+    for (const auto& kv : attrs) {
+      node.param.attrs[kv.first] = String(kv.second);
+    }
+    std::vector<uint32_t> inputs;
+    ICHECK(strm->Read(&inputs));
+    ICHECK_EQ(inputs.size() % 3, 0U);
+    node.inputs.resize(inputs.size() / 3);
+    for (size_t i = 0; i < node.inputs.size(); ++i) {
+      node.inputs[i].node_id = inputs[i * 3];
+      node.inputs[i].index = inputs[i * 3 + 1];
+      node.inputs[i].version = inputs[i * 3 + 2];
+    }
+    ICHECK(strm->Read(&node.control_deps));
+  }
+  ICHECK(strm->Read(&input_nodes_));
+  ICHECK(strm->Read(&node_row_ptr_));
+  std::vector<uint32_t> outputs;
+  ICHECK(strm->Read(&outputs));
+  ICHECK_EQ(outputs.size() % 3, 0U);
+  outputs_.resize(outputs.size() / 3);
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    outputs_[i].node_id = outputs[i * 3];
+    outputs_[i].index = outputs[i * 3 + 1];
+    outputs_[i].version = outputs[i * 3 + 2];
+  }
+  ICHECK(strm->Read(&attrs_.storage_id));
+  ICHECK(strm->Read(&attrs_.device_index));
+  ICHECK(strm->Read(&attrs_.dltype));
+  ICHECK(strm->Read(&attrs_.storage_scope));
+  uint64_t num_shapes;
+  ICHECK(strm->Read(&num_shapes));
+  attrs_.shape.resize(num_shapes);
+  for (std::vector<int64_t>& shape : attrs_.shape) {
+    ICHECK(strm->Read(&shape));
+  }
+}
+
+std::string GraphExecutor::SerializeParsedGraph(const std::string& graph_json) {
+  GraphExecutor parsed;
+  std::istringstream is(graph_json);
+  dmlc::JSONReader reader(&is);
+  parsed.Load(&reader);
+  std::string blob;
+  dmlc::MemoryStringStream strm(&blob);
+  parsed.SaveParsedGraph(&strm);
+  return blob;
+}
+
 /*!
  * \brief Get the input index given the name of input.
  * \param name The name of the input.
@@ -250,6 +514,58 @@ void GraphExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
     t->data = static_cast<char*>(data_ref->data) + data_ref->byte_offset;
   }
 }
+/*!
+ * \brief Stage a new value for the index-th input into a shadow buffer.
+ * \param index The input index.
+ * \param data_in The new input data.
+ */
+void GraphExecutor::StageParam(int index, DLTensor* data_in) {
+  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
+  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  const NDArray& bound = data_entry_[eid];
+  Device dev = bound->device;
+  ICHECK(dev.device_type == devices_[0].device_type && dev.device_id == devices_[0].device_id)
+      << "ValueError: staged parameter updates only support inputs on the primary device";
+  if (param_copy_stream_ == nullptr) {
+    param_copy_stream_ = DeviceAPI::Get(dev)->CreateStream(dev);
+  }
+  ShadowParamSlot& slot = shadow_params_[index];
+  NDArray& shadow = slot.buffers[slot.next];
+  if (!shadow.defined()) {
+    std::vector<int64_t> shape(bound->shape, bound->shape + bound->ndim);
+    shadow = NDArray::Empty(shape, bound->dtype, dev);
+  }
+  NDArray::CopyFromTo(data_in, const_cast<DLTensor*>(shadow.operator->()), param_copy_stream_);
+  slot.staged = true;
+}
+/*!
+ * \brief Make every staged parameter visible by pointer flip.
+ */
+void GraphExecutor::CommitParams() {
+  bool any_staged = false;
+  for (const auto& kv : shadow_params_) {
+    any_staged = any_staged || kv.second.staged;
+  }
+  if (!any_staged) {
+    return;
+  }
+  // Wait once for all outstanding staging copies, then flip the pointers.
+  DeviceAPI::Get(devices_[0])->StreamSync(devices_[0], param_copy_stream_);
+  for (auto& kv : shadow_params_) {
+    ShadowParamSlot& slot = kv.second;
+    if (!slot.staged) {
+      continue;
+    }
+    NDArray& shadow = slot.buffers[slot.next];
+    this->SetInputZeroCopy(kv.first, const_cast<DLTensor*>(shadow.operator->()));
+    // Rebind the entry so GetInput and later staging see the committed value;
+    // the previous buffer becomes the next staging target.
+    uint32_t eid = this->entry_id(input_nodes_[kv.first], 0);
+    data_entry_[eid] = shadow;
+    slot.next = 1 - slot.next;
+    slot.staged = false;
+  }
+}
 /*!
  * \brief Get the number of outputs
  *
@@ -534,6 +850,17 @@ void GraphExecutor::SetupOpExecs() {
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args);
 
+    // Fold per-op latency into the always-on histograms when enabled.
+    profiling::LatencyMonitor* monitor = profiling::LatencyMonitor::Global();
+    if (monitor->enabled() && op_execs_[nid] != nullptr && inode.param.func_name != "__nop") {
+      uint32_t op_scope = monitor->RegisterScope(inode.param.func_name);
+      std::function<void()> body = std::move(op_execs_[nid]);
+      op_execs_[nid] = [body, op_scope]() {
+        profiling::ScopedLatencyTimer op_timer(op_scope);
+        body();
+      };
+    }
+
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t input_eid = this->entry_id(inode.inputs[i]);
       // check if op input is model input
@@ -617,6 +944,27 @@ std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphEx
     return {fexec, arg_ptr};
   }
 
+  // Fast path: bind directly to the backend C entry of library-backed kernels.
+  // The argument record is packed once above, so the per-invocation work reduces
+  // to a single indirect call, skipping the PackedFunc dispatch layers.
+  if (TVMBackendPackedCFunc faddr = GetLibraryCFunc(module_, param.func_name)) {
+    auto fexec = [arg_ptr, faddr]() {
+      TVMValue ret_value;
+      int ret_type_code = kTVMNullptr;
+      int ret = (*faddr)(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+                         static_cast<int>(arg_ptr->arg_values.size()), &ret_value, &ret_type_code,
+                         nullptr);
+      if (ret != 0) {
+        TVMThrowLastError();
+      }
+      if (ret_type_code != kTVMNullptr) {
+        // Kernels do not return values; recover ownership in case one ever does.
+        TVMRetValue::MoveFromCHost(ret_value, ret_type_code);
+      }
+    };
+    return {fexec, arg_ptr};
+  }
+
   // Get compiled function from the module that contains both host and device
   // code.
   tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
@@ -651,6 +999,18 @@ PackedFunc GraphExecutor::GetFunction(const String& name, const ObjectPtr<Object
         this->SetInputZeroCopy(args[0], args[1]);
       }
     });
+  } else if (name == "stage_param") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      if (String::CanConvertFrom(args[0])) {
+        int in_idx = this->GetInputIndex(args[0].operator String());
+        if (in_idx >= 0) this->StageParam(in_idx, args[1]);
+      } else {
+        this->StageParam(args[0], args[1]);
+      }
+    });
+  } else if (name == "commit_params") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->CommitParams(); });
   } else if (name == "set_output_zero_copy") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       if (String::CanConvertFrom(args[0])) {
@@ -700,6 +1060,46 @@ PackedFunc GraphExecutor::GetFunction(const String& name, const ObjectPtr<Object
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "run_async") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      PackedFunc callback = nullptr;
+      if (args.num_args > 0) {
+        callback = args[0].operator PackedFunc();
+      }
+      // Enqueue the whole step on the device streams; only the completion
+      // wait moves off this thread.
+      this->Run();
+      std::vector<TVMStreamHandle> streams = exec_streams_;
+      if (streams.empty()) {
+        streams.push_back(nullptr);
+      }
+      *rv = AsyncCompletionQueue::Global()->Submit(
+          [sptr_to_self, this, streams = std::move(streams), callback]() {
+            for (TVMStreamHandle stream : streams) {
+              DeviceAPI::Get(devices_[0])->StreamSync(devices_[0], stream);
+            }
+            if (callback != nullptr) {
+              callback();
+            }
+          });
+    });
+  } else if (name == "get_call_order") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      // The op nodes execute in node order, so this is the kernel call order of one
+      // inference step. Attach it to the IRModule as "function_call_order" before
+      // building to get profile-guided function layout in the emitted library.
+      Array<String> order;
+      for (const auto& node : nodes_) {
+        if (node.op_type == "tvm_op") {
+          order.push_back(node.param.func_name);
+        }
+      }
+      *rv = order;
+    });
+  } else if (name == "set_num_execution_streams") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetNumExecutionStreams(args[0]);
+    });
   } else if (name == "run_from_inputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
@@ -92,6 +92,16 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   const char* type_key() const final { return "GraphExecutor"; }
   void Run();
+  ~GraphExecutor();
+
+  /*!
+   * \brief Set the number of device streams used to run independent node chains
+   *  concurrently. Entry 0 is the device's default stream; cross-stream data
+   *  dependencies are enforced with event-based stream synchronization.
+   * \param num_streams The number of streams; values <= 1 restore the
+   *  sequential single-stream execution.
+   */
+  void SetNumExecutionStreams(int num_streams);
 
   /*! \brief Get the property of the runtime module .*/
   int GetPropertyMask() const final { return ModulePropertyMask::kRunnable; }
@@ -111,6 +121,27 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void Init(const std::string& graph_json, tvm::runtime::Module module,
             const std::vector<Device>& devs, const PackedFunc lookup_linked_param_func = nullptr);
 
+  /*!
+   * \brief Initialize the graph executor from a binary warm plan produced by
+   *  SerializeParsedGraph, skipping the JSON parsing of the execution graph.
+   * \param graph_blob The serialized parsed graph.
+   * \param module The module containing the compiled functions for the host
+   *  processor.
+   * \param devs The device of the host and devices where graph nodes will be
+   *  executed on.
+   * \param lookup_linked_param_func Linked parameter lookup function, see Init.
+   */
+  void InitFromParsedGraph(const std::string& graph_blob, tvm::runtime::Module module,
+                           const std::vector<Device>& devs,
+                           const PackedFunc lookup_linked_param_func = nullptr);
+
+  /*!
+   * \brief Parse a graph JSON and serialize the parsed graph as a binary warm plan.
+   * \param graph_json The execution graph.
+   * \return A binary blob consumable by InitFromParsedGraph.
+   */
+  static std::string SerializeParsedGraph(const std::string& graph_json);
+
   /*!
    * \brief Get the input index given the name of input.
    * \param name The name of the input.
@@ -155,6 +186,24 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_ref The output data that is referred.
    */
   void SetOutputZeroCopy(int index, DLTensor* data_ref);
+  /*!
+   * \brief Stage a new value for the index-th input into a shadow buffer.
+   *
+   *  The copy runs asynchronously on a dedicated side stream and does not
+   *  disturb inferences using the currently bound value. Call CommitParams
+   *  between inferences to make all staged values visible atomically.
+   * \param index The input index.
+   * \param data_in The new input data.
+   */
+  void StageParam(int index, DLTensor* data_in);
+  /*!
+   * \brief Make every staged parameter visible by pointer flip.
+   *
+   *  Waits for the outstanding staging copies, then rebinds the affected
+   *  inputs to their shadow buffers the same way SetInputZeroCopy does.
+   *  The cost is independent of the parameter sizes.
+   */
+  void CommitParams();
   /*!
    * \brief Get the number of outputs
    *
@@ -424,6 +473,13 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
   static void LinkedNDArrayDeleter(Object* container);
+  /*! \brief Common initialization after the graph structures are loaded. */
+  void InitCommon(tvm::runtime::Module module, const std::vector<Device>& devs,
+                  PackedFunc lookup_linked_param_func);
+  /*! \brief Save the parsed graph structures to a binary stream. */
+  void SaveParsedGraph(dmlc::Stream* strm) const;
+  /*! \brief Load the parsed graph structures from a binary stream. */
+  void LoadParsedGraph(dmlc::Stream* strm);
   /*! \brief Setup the temporal storage */
   void SetupStorage();
   /*! \brief Setup the executors. */
@@ -495,6 +551,40 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * When the module does not include linked parmeters, module_lookup_linked_param_ will be nullptr.
    */
   bool module_lookup_linked_param_valid_;
+  /*! \brief A double-buffered shadow slot for one staged input. */
+  struct ShadowParamSlot {
+    /*! \brief The shadow buffers, used alternately between commits. */
+    NDArray buffers[2];
+    /*! \brief The buffer the next staging copy targets. */
+    int next{0};
+    /*! \brief Whether the slot holds an uncommitted staged value. */
+    bool staged{false};
+  };
+  /*! \brief The shadow slots of staged inputs, keyed by input index. */
+  std::unordered_map<int, ShadowParamSlot> shadow_params_;
+  /*! \brief The side stream the staging copies run on. */
+  TVMStreamHandle param_copy_stream_{nullptr};
+  /*! \brief The stream assignment of one op for pipelined execution. */
+  struct PipelinedOp {
+    /*! \brief The node to execute. */
+    uint32_t nid;
+    /*! \brief The stream the op is issued on. */
+    int stream_idx;
+    /*! \brief The streams holding producers of the op's inputs, to be waited for. */
+    std::vector<int> wait_stream_idxs;
+  };
+  /*! \brief Setup the stream assignment and cross-stream syncs of each op. */
+  void SetupPipelinedExecution();
+  /*! \brief Run the ops on multiple streams, syncing cross-stream dependencies. */
+  void RunPipelined();
+  /*! \brief Release the streams created for pipelined execution. */
+  void FreeExecutionStreams();
+  /*! \brief The number of device streams used by Run; <= 1 runs sequentially. */
+  int num_execution_streams_{1};
+  /*! \brief The streams used by pipelined execution; entry 0 is the default stream. */
+  std::vector<TVMStreamHandle> exec_streams_;
+  /*! \brief The per-op schedule of pipelined execution, in topological order. */
+  std::vector<PipelinedOp> pipelined_ops_;
 };
 
 std::vector<Device> GetAllDevice(const TVMArgs& args, int dev_start_arg);
@@ -32,9 +32,19 @@
 #include <iterator>
 #include <vector>
 
+#include "../file_utils.h"
+
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Marker heading v2 factory artifacts, which carry the pre-parsed binary graph
+ *  after the JSON. A v1 artifact starts with the graph JSON itself, which always
+ *  begins with '{' and therefore can never collide with the marker, so the loader
+ *  can tell the formats apart from the first field.
+ */
+static constexpr const char* kGraphExecutorFactoryFormatV2 = "tvm_graph_executor_factory_v2";
+
 GraphExecutorFactory::GraphExecutorFactory(
     const std::string& graph_json,
     const std::unordered_map<std::string, tvm::runtime::NDArray>& params,
@@ -77,11 +87,22 @@ PackedFunc GraphExecutorFactory::GetFunction(
       }
       *rv = this->DebugExecutorCreate(devices);
     });
+  } else if (name == "export_warm_plan") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::string path = args[0].operator String();
+      SaveBinaryToFile(path, GraphExecutor::SerializeParsedGraph(this->graph_json_));
+    });
+  } else if (name == "load_warm_plan") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::string path = args[0].operator String();
+      LoadBinaryFromFile(path, &this->parsed_graph_blob_);
+    });
   } else if (name == "remove_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       std::unordered_map<std::string, tvm::runtime::NDArray> empty_params{};
       auto exec =
           make_object<GraphExecutorFactory>(this->graph_json_, empty_params, this->module_name_);
+      exec->SetParsedGraphBlob(this->parsed_graph_blob_);
       exec->Import(this->imports_[0]);
       *rv = Module(exec);
     });
@@ -99,6 +120,7 @@ PackedFunc GraphExecutorFactory::GetFunction(
 }
 
 void GraphExecutorFactory::SaveToBinary(dmlc::Stream* stream) {
+  stream->Write(std::string(kGraphExecutorFactoryFormatV2));
   stream->Write(graph_json_);
   std::vector<std::string> names;
   std::vector<DLTensor*> arrays;
@@ -114,11 +136,21 @@ void GraphExecutorFactory::SaveToBinary(dmlc::Stream* stream) {
     tvm::runtime::SaveDLTensor(stream, arrays[i]);
   }
   stream->Write(module_name_);
+  // Emit the pre-parsed binary graph next to the JSON so loading the artifact can
+  // skip the JSON parse entirely; the JSON stays authoritative for get_graph_json.
+  if (parsed_graph_blob_.empty()) {
+    parsed_graph_blob_ = GraphExecutor::SerializeParsedGraph(graph_json_);
+  }
+  stream->Write(parsed_graph_blob_);
 }
 
 Module GraphExecutorFactory::ExecutorCreate(const std::vector<Device>& devs) {
   auto exec = make_object<GraphExecutor>();
-  exec->Init(this->graph_json_, this->imports_[0], devs, PackedFunc());
+  if (!this->parsed_graph_blob_.empty()) {
+    exec->InitFromParsedGraph(this->parsed_graph_blob_, this->imports_[0], devs, PackedFunc());
+  } else {
+    exec->Init(this->graph_json_, this->imports_[0], devs, PackedFunc());
+  }
   // set params
   SetParams(exec.get(), this->params_);
   return Module(exec);
@@ -182,6 +214,10 @@ Module GraphExecutorFactoryModuleLoadBinary(void* strm) {
   std::unordered_map<std::string, tvm::runtime::NDArray> params;
   std::string module_name;
   ICHECK(stream->Read(&graph_json));
+  bool is_v2 = graph_json == kGraphExecutorFactoryFormatV2;
+  if (is_v2) {
+    ICHECK(stream->Read(&graph_json));
+  }
   uint64_t sz;
   ICHECK(stream->Read(&sz));
   std::vector<std::string> names;
@@ -194,6 +230,11 @@ Module GraphExecutorFactoryModuleLoadBinary(void* strm) {
   }
   ICHECK(stream->Read(&module_name));
   auto exec = make_object<GraphExecutorFactory>(graph_json, params, module_name);
+  if (is_v2) {
+    std::string parsed_graph_blob;
+    ICHECK(stream->Read(&parsed_graph_blob));
+    exec->SetParsedGraphBlob(std::move(parsed_graph_blob));
+  }
   return Module(exec);
 }
 
@@ -35,6 +35,7 @@
 #include <numeric>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "./graph_executor.h"
@@ -105,6 +106,12 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
    * \param graph_executor The graph executor we want to set the params into.
    * \param params The graph params value we want to set.
    */
+  /*!
+   * \brief Install a pre-parsed binary graph to be used instead of parsing graph_json_.
+   * \param blob The serialized parsed graph, see GraphExecutor::SerializeParsedGraph.
+   */
+  void SetParsedGraphBlob(std::string blob) { parsed_graph_blob_ = std::move(blob); }
+
   void SetParams(GraphExecutor* graph_executor,
                  const std::unordered_map<std::string, tvm::runtime::NDArray>& params) const {
     std::unordered_map<std::string, tvm::runtime::NDArray> value = params;
@@ -130,6 +137,13 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
  protected:
   /*! \brief The execution graph. */
   std::string graph_json_;
+  /*!
+   * \brief The binary warm plan holding the parsed graph. When present, created
+   * executors skip parsing graph_json_. It is emitted into the factory's binary
+   * format alongside the JSON by SaveToBinary, and can also be produced and
+   * installed explicitly via export_warm_plan / load_warm_plan.
+   */
+  std::string parsed_graph_blob_;
   /*! \brief The params. */
   std::unordered_map<std::string, tvm::runtime::NDArray> params_;
   /*! \brief module name */
@@ -0,0 +1,94 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file kernel_trace.cc
+ * \brief Runtime side of the per-kernel trace hooks emitted by the CPU codegen.
+ *
+ * Kernels built with `tir.emit_kernel_trace_hooks` carry a guarded call to
+ * TVMBackendKernelTraceEnter/Exit at every entry and exit.  The guard reads a
+ * single runtime-wide flag through a pointer patched into the kernel library
+ * at load time, so an idle deployment pays one word load and a well-predicted
+ * branch per kernel, and tracing can be switched on during an incident
+ * without touching the binaries.
+ */
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+#include <memory>
+
+#include "runtime_base.h"
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+/*! \brief The runtime-wide enable flag the generated guards read. */
+std::atomic<int32_t> kernel_trace_enabled{0};
+/*! \brief The user-registered trace handler, swapped atomically. */
+std::shared_ptr<PackedFunc> kernel_trace_handler;
+
+void InvokeKernelTraceHandler(const char* name, bool is_enter) {
+  if (std::shared_ptr<PackedFunc> handler = std::atomic_load(&kernel_trace_handler)) {
+    (*handler)(name, is_enter);
+  }
+}
+
+TVM_REGISTER_GLOBAL("runtime.KernelTraceEnable").set_body_typed([](bool enable) {
+  kernel_trace_enabled.store(enable ? 1 : 0, std::memory_order_relaxed);
+});
+
+TVM_REGISTER_GLOBAL("runtime.KernelTraceEnabled").set_body_typed([]() -> bool {
+  return kernel_trace_enabled.load(std::memory_order_relaxed) != 0;
+});
+
+TVM_REGISTER_GLOBAL("runtime.SetKernelTraceHandler").set_body([](TVMArgs args, TVMRetValue* rv) {
+  CHECK_EQ(args.size(), 1);
+  std::shared_ptr<PackedFunc> handler;
+  if (args[0].type_code() != kTVMNullptr) {
+    handler = std::make_shared<PackedFunc>(args[0].operator PackedFunc());
+  }
+  std::atomic_store(&kernel_trace_handler, std::move(handler));
+});
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
+
+const int32_t* TVMBackendKernelTraceEnabledFlag() {
+  // The flag is a plain word for the generated code; std::atomic<int32_t> is
+  // layout-compatible on every platform the CPU codegen targets.
+  static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t),
+                "atomic flag must be readable as a plain word");
+  return reinterpret_cast<const int32_t*>(&tvm::runtime::kernel_trace_enabled);
+}
+
+int TVMBackendKernelTraceEnter(const char* name) {
+  API_BEGIN();
+  tvm::runtime::InvokeKernelTraceHandler(name, /*is_enter=*/true);
+  API_END();
+}
+
+int TVMBackendKernelTraceExit(const char* name) {
+  API_BEGIN();
+  tvm::runtime::InvokeKernelTraceHandler(name, /*is_enter=*/false);
+  API_END();
+}
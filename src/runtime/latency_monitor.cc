@@ -0,0 +1,276 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file latency_monitor.cc
+ * \brief Always-on latency histogram instrumentation.
+ */
+#include "latency_monitor.h"
+
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "../support/utils.h"
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*!
+ * \brief Owner of the thread-local histogram block.
+ *
+ * Registers the block with the monitor on first use and hands it back when the
+ * thread exits, so measurements from short-lived threads survive in the
+ * retired aggregate.
+ */
+struct LatencyMonitorThreadGuard {
+  LatencyMonitor::ThreadRecords* records{nullptr};
+
+  LatencyMonitor::ThreadRecords* Get() {
+    if (records == nullptr) {
+      records = new LatencyMonitor::ThreadRecords();
+      LatencyMonitor* monitor = LatencyMonitor::Global();
+      std::lock_guard<std::mutex> lock(monitor->mutex_);
+      monitor->threads_.push_back(records);
+    }
+    return records;
+  }
+
+  ~LatencyMonitorThreadGuard() {
+    if (records != nullptr) {
+      LatencyMonitor::Global()->RetireThread(records);
+    }
+  }
+};
+
+LatencyMonitor::LatencyMonitor() {
+  enabled_ = support::BoolEnvironmentVar("TVM_RUNTIME_LATENCY_MONITOR");
+  sample_period_ = 1;
+  if (const char* var = std::getenv("TVM_RUNTIME_LATENCY_MONITOR_SAMPLE")) {
+    int64_t period = std::atoll(var);
+    CHECK_GT(period, 0) << "ValueError: TVM_RUNTIME_LATENCY_MONITOR_SAMPLE must be a "
+                        << "positive integer, but got \"" << var << "\"";
+    sample_period_ = static_cast<uint64_t>(period);
+  }
+  // Reserve the shared overflow scope so RegisterScope can always succeed.
+  scope_names_.push_back("__overflow__");
+  scope_ids_["__overflow__"] = 0;
+}
+
+LatencyMonitor* LatencyMonitor::Global() {
+  // Leaked to avoid destruction-order races with recording threads.
+  static LatencyMonitor* inst = new LatencyMonitor();
+  return inst;
+}
+
+uint32_t LatencyMonitor::RegisterScope(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = scope_ids_.find(name);
+  if (it != scope_ids_.end()) {
+    return it->second;
+  }
+  if (scope_names_.size() >= kMaxScopes) {
+    // Fold everything past the cap into the shared overflow scope rather than
+    // growing without bound on pathological name cardinality.
+    return 0;
+  }
+  uint32_t id = static_cast<uint32_t>(scope_names_.size());
+  scope_names_.push_back(name);
+  scope_ids_[name] = id;
+  return id;
+}
+
+bool LatencyMonitor::ShouldSample() {
+  if (sample_period_ == 1) return true;
+  static thread_local uint64_t counter = 0;
+  if (++counter < sample_period_) return false;
+  counter = 0;
+  return true;
+}
+
+LatencyMonitor::ScopeHistogram* LatencyMonitor::GetThreadScope(uint32_t scope_id) {
+  static thread_local LatencyMonitorThreadGuard guard;
+  ThreadRecords* records = guard.Get();
+  ScopeHistogram* hist = records->scopes[scope_id].load(std::memory_order_acquire);
+  if (hist == nullptr) {
+    hist = new ScopeHistogram();
+    records->scopes[scope_id].store(hist, std::memory_order_release);
+  }
+  return hist;
+}
+
+void LatencyMonitor::Record(uint32_t scope_id, int64_t start_ns, int64_t duration_ns) {
+  if (scope_id >= kMaxScopes) scope_id = 0;
+  uint64_t ns = duration_ns > 0 ? static_cast<uint64_t>(duration_ns) : 0;
+
+  ScopeHistogram* hist = GetThreadScope(scope_id);
+  hist->buckets[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+  hist->count.fetch_add(1, std::memory_order_relaxed);
+  hist->total_ns.fetch_add(ns, std::memory_order_relaxed);
+  uint64_t prev_max = hist->max_ns.load(std::memory_order_relaxed);
+  while (ns > prev_max &&
+         !hist->max_ns.compare_exchange_weak(prev_max, ns, std::memory_order_relaxed)) {
+  }
+
+  // Publish a trace entry; the sequence number is written last so readers can
+  // reject slots that were being overwritten while they looked.
+  uint64_t idx = trace_cursor_.fetch_add(1, std::memory_order_relaxed);
+  TraceEntry& entry = trace_ring_[idx % kTraceRingSize];
+  entry.seq.store(0, std::memory_order_relaxed);
+  entry.scope_id = scope_id;
+  entry.start_ns = start_ns;
+  entry.duration_ns = duration_ns;
+  entry.seq.store(idx + 1, std::memory_order_release);
+}
+
+void LatencyMonitor::RetireThread(ThreadRecords* records) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint32_t i = 0; i < kMaxScopes; ++i) {
+    ScopeHistogram* hist = records->scopes[i].load(std::memory_order_acquire);
+    if (hist == nullptr) continue;
+    if (retired_[i] == nullptr) {
+      retired_[i] = std::make_unique<ScopeHistogram>();
+    }
+    ScopeHistogram* into = retired_[i].get();
+    for (int b = 0; b < kNumBuckets; ++b) {
+      into->buckets[b].fetch_add(hist->buckets[b].load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+    }
+    into->count.fetch_add(hist->count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    into->total_ns.fetch_add(hist->total_ns.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    uint64_t max_ns = hist->max_ns.load(std::memory_order_relaxed);
+    if (max_ns > into->max_ns.load(std::memory_order_relaxed)) {
+      into->max_ns.store(max_ns, std::memory_order_relaxed);
+    }
+    delete hist;
+  }
+  threads_.erase(std::remove(threads_.begin(), threads_.end(), records), threads_.end());
+  delete records;
+}
+
+int LatencyMonitor::BucketIndex(uint64_t ns) {
+  constexpr int kSubBuckets = 1 << kSubBucketBits;
+  if (ns < static_cast<uint64_t>(kSubBuckets)) {
+    return static_cast<int>(ns);
+  }
+  int msb = 0;
+  for (uint64_t v = ns; v >>= 1;) ++msb;
+  int shift = msb - kSubBucketBits;
+  int sub = static_cast<int>((ns >> shift) & (kSubBuckets - 1));
+  int index = ((msb - kSubBucketBits + 1) << kSubBucketBits) + sub;
+  return std::min(index, kNumBuckets - 1);
+}
+
+uint64_t LatencyMonitor::BucketLowerBound(int index) {
+  constexpr int kSubBuckets = 1 << kSubBucketBits;
+  if (index < kSubBuckets) {
+    return static_cast<uint64_t>(index);
+  }
+  int exponent = index >> kSubBucketBits;
+  int sub = index & (kSubBuckets - 1);
+  return static_cast<uint64_t>(kSubBuckets + sub) << (exponent - 1);
+}
+
+std::string LatencyMonitor::SnapshotJSON() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Aggregate live and retired histograms per scope.
+  std::vector<std::array<uint64_t, kNumBuckets>> buckets(scope_names_.size());
+  std::vector<uint64_t> counts(scope_names_.size(), 0);
+  std::vector<uint64_t> totals(scope_names_.size(), 0);
+  std::vector<uint64_t> maxes(scope_names_.size(), 0);
+  for (auto& b : buckets) b.fill(0);
+
+  auto accumulate = [&](uint32_t scope_id, const ScopeHistogram* hist) {
+    for (int b = 0; b < kNumBuckets; ++b) {
+      buckets[scope_id][b] += hist->buckets[b].load(std::memory_order_relaxed);
+    }
+    counts[scope_id] += hist->count.load(std::memory_order_relaxed);
+    totals[scope_id] += hist->total_ns.load(std::memory_order_relaxed);
+    maxes[scope_id] = std::max(maxes[scope_id], hist->max_ns.load(std::memory_order_relaxed));
+  };
+  for (uint32_t i = 0; i < scope_names_.size(); ++i) {
+    if (retired_[i] != nullptr) {
+      accumulate(i, retired_[i].get());
+    }
+    for (ThreadRecords* records : threads_) {
+      const ScopeHistogram* hist = records->scopes[i].load(std::memory_order_acquire);
+      if (hist != nullptr) {
+        accumulate(i, hist);
+      }
+    }
+  }
+
+  // Hand-built JSON, matching ReportNode::AsJSON. Only non-empty buckets are
+  // emitted, as [lower_bound_ns, count] pairs.
+  std::ostringstream s;
+  s << "{\"scopes\":[";
+  bool first_scope = true;
+  for (uint32_t i = 0; i < scope_names_.size(); ++i) {
+    if (counts[i] == 0) continue;
+    if (!first_scope) s << ",";
+    first_scope = false;
+    s << "{\"name\":\"" << scope_names_[i] << "\",\"count\":" << counts[i]
+      << ",\"total_ns\":" << totals[i] << ",\"max_ns\":" << maxes[i] << ",\"buckets\":[";
+    bool first_bucket = true;
+    for (int b = 0; b < kNumBuckets; ++b) {
+      if (buckets[i][b] == 0) continue;
+      if (!first_bucket) s << ",";
+      first_bucket = false;
+      s << "[" << BucketLowerBound(b) << "," << buckets[i][b] << "]";
+    }
+    s << "]}";
+  }
+  s << "],";
+
+  s << "\"recent\":[";
+  uint64_t cursor = trace_cursor_.load(std::memory_order_acquire);
+  uint64_t depth = std::min<uint64_t>(cursor, kTraceRingSize);
+  bool first_trace = true;
+  for (uint64_t n = depth; n > 0; --n) {
+    uint64_t idx = cursor - n;
+    const TraceEntry& entry = trace_ring_[idx % kTraceRingSize];
+    if (entry.seq.load(std::memory_order_acquire) != idx + 1) continue;
+    uint32_t scope_id = entry.scope_id;
+    int64_t start_ns = entry.start_ns;
+    int64_t duration_ns = entry.duration_ns;
+    if (entry.seq.load(std::memory_order_acquire) != idx + 1 || scope_id >= scope_names_.size()) {
+      continue;  // overwritten while reading
+    }
+    if (!first_trace) s << ",";
+    first_trace = false;
+    s << "{\"scope\":\"" << scope_names_[scope_id] << "\",\"start_ns\":" << start_ns
+      << ",\"duration_ns\":" << duration_ns << "}";
+  }
+  s << "]}";
+  return s.str();
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.snapshot").set_body_typed([]() {
+  return String(LatencyMonitor::Global()->SnapshotJSON());
+});
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
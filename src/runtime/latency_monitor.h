@@ -0,0 +1,197 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file latency_monitor.h
+ * \brief Always-on, low-overhead latency histograms for production monitoring.
+ *
+ * Unlike profiling::Profiler, which synchronizes devices around every call and
+ * builds full reports, the latency monitor only reads a host-side clock around
+ * each instrumented region and folds the result into log-bucketed (HDR-style)
+ * histograms kept per thread. Recording is lock-free; the only locks are taken
+ * on the rare paths (scope registration, thread retirement, snapshot). Host
+ * timestamps measure enqueue-to-return time on asynchronous devices, which is
+ * the accepted tradeoff for staying cheap enough to leave enabled.
+ *
+ * Enable with TVM_RUNTIME_LATENCY_MONITOR=1; optionally record only one in N
+ * calls via TVM_RUNTIME_LATENCY_MONITOR_SAMPLE=N. Scrape histograms and the
+ * ring buffer of recent traces with the runtime.profiling.snapshot global.
+ */
+#ifndef TVM_RUNTIME_LATENCY_MONITOR_H_
+#define TVM_RUNTIME_LATENCY_MONITOR_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*!
+ * \brief Global registry of latency histograms and recent traces.
+ *
+ * Scopes are interned names (op names, executor entry points) identified by a
+ * dense id. Each recording thread owns its histograms, so the hot path only
+ * touches thread-local memory with relaxed atomics; snapshots aggregate across
+ * threads under a mutex.
+ */
+class LatencyMonitor {
+ public:
+  /*! \brief Sub-bucket resolution bits; 3 gives <= 12.5% relative error. */
+  static constexpr int kSubBucketBits = 3;
+  /*! \brief Number of histogram buckets per scope. */
+  static constexpr int kNumBuckets = 512;
+  /*! \brief Maximum number of distinct scopes; later ones share an overflow scope. */
+  static constexpr uint32_t kMaxScopes = 1024;
+  /*! \brief Number of entries in the recent-trace ring buffer. */
+  static constexpr size_t kTraceRingSize = 4096;
+
+  /*! \return The process-wide monitor. */
+  static LatencyMonitor* Global();
+
+  /*! \return Whether recording is enabled (TVM_RUNTIME_LATENCY_MONITOR=1). */
+  bool enabled() const { return enabled_; }
+
+  /*!
+   * \brief Intern a scope name and return its id.
+   * \param name The scope name, e.g. an op symbol.
+   * \return A dense id usable with Record; stable for the process lifetime.
+   */
+  uint32_t RegisterScope(const std::string& name);
+
+  /*!
+   * \brief Fold one measurement into the calling thread's histogram.
+   * \param scope_id Id returned by RegisterScope.
+   * \param start_ns Start timestamp, nanoseconds on the steady clock.
+   * \param duration_ns Measured duration in nanoseconds.
+   */
+  void Record(uint32_t scope_id, int64_t start_ns, int64_t duration_ns);
+
+  /*!
+   * \brief Decide whether the current call should be timed at all.
+   *
+   *  Applies the configured 1-in-N sampling with a thread-local counter so
+   *  skipped calls cost a single branch and no clock reads.
+   */
+  bool ShouldSample();
+
+  /*!
+   * \brief Serialize all histograms and recent traces to JSON.
+   *
+   *  Aggregates live threads and retired ones. Counters recorded concurrently
+   *  with the snapshot may or may not be included; totals are never corrupted.
+   */
+  std::string SnapshotJSON();
+
+ private:
+  /*! \brief Per-scope histogram; owned by one thread, read by snapshots. */
+  struct ScopeHistogram {
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+  };
+
+  /*! \brief One entry of the recent-trace ring. */
+  struct TraceEntry {
+    // Sequence number published last with release ordering; readers that see a
+    // mismatch against the slot they expected drop the (torn) entry.
+    std::atomic<uint64_t> seq{0};
+    uint32_t scope_id{0};
+    int64_t start_ns{0};
+    int64_t duration_ns{0};
+  };
+
+  /*! \brief Histograms owned by a single recording thread. */
+  struct ThreadRecords {
+    std::array<std::atomic<ScopeHistogram*>, kMaxScopes> scopes{};
+  };
+
+  LatencyMonitor();
+
+  ScopeHistogram* GetThreadScope(uint32_t scope_id);
+  void RetireThread(ThreadRecords* records);
+
+  static int BucketIndex(uint64_t ns);
+  static uint64_t BucketLowerBound(int index);
+
+  bool enabled_;
+  uint64_t sample_period_;
+
+  // Guards scope registration, the thread list, and retired histograms.
+  std::mutex mutex_;
+  std::vector<std::string> scope_names_;
+  std::unordered_map<std::string, uint32_t> scope_ids_;
+  std::vector<ThreadRecords*> threads_;
+  // Histograms of exited threads, merged per scope.
+  std::array<std::unique_ptr<ScopeHistogram>, kMaxScopes> retired_;
+
+  std::array<TraceEntry, kTraceRingSize> trace_ring_;
+  std::atomic<uint64_t> trace_cursor_{0};
+
+  friend struct LatencyMonitorThreadGuard;
+};
+
+/*!
+ * \brief RAII timer recording the lifetime of a region into a scope.
+ *
+ * Construction is a single branch when the monitor is disabled or the call is
+ * not sampled.
+ */
+class ScopedLatencyTimer {
+ public:
+  explicit ScopedLatencyTimer(uint32_t scope_id) : scope_id_(scope_id) {
+    LatencyMonitor* monitor = LatencyMonitor::Global();
+    active_ = monitor->enabled() && monitor->ShouldSample();
+    if (active_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedLatencyTimer() {
+    if (active_) {
+      auto now = std::chrono::steady_clock::now();
+      int64_t start_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(start_.time_since_epoch()).count();
+      int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count();
+      LatencyMonitor::Global()->Record(scope_id_, start_ns, duration_ns);
+    }
+  }
+
+  ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+  ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+ private:
+  uint32_t scope_id_;
+  bool active_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_LATENCY_MONITOR_H_
@@ -27,18 +27,182 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/registry.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace tvm {
 namespace runtime {
 
+/*! \brief The symbol suffix marking alternative schedule variants of a kernel. */
+constexpr const char* kVariantSymbolSuffix = "__variant_";
+
+/*!
+ * \brief Per-function state for runtime dispatch between compiled schedule variants.
+ *
+ *  When a library exposes `fn` together with `fn__variant_0`, `fn__variant_1`, ...
+ *  (e.g. produced by meta_schedule.compile_tir_variants), the function lookup returns a
+ *  dispatching wrapper instead of the base symbol. For each shape bucket - the tuple of
+ *  tensor argument shapes - the wrapper round-robins the variants during a warmup window,
+ *  timing each call on the deployment hardware, then locks in the fastest variant for all
+ *  subsequent calls with that bucket. Timing is host-side around the packed call, so the
+ *  mechanism targets synchronous (CPU) kernels; asynchronously launched kernels would need
+ *  device events.
+ */
+class VariantDispatchState {
+ public:
+  explicit VariantDispatchState(std::vector<PackedFunc> variants)
+      : variants_(std::move(variants)) {
+    // Number of timed calls per variant and shape bucket before locking a winner.
+    if (const char* var = std::getenv("TVM_VARIANT_DISPATCH_TRIALS")) {
+      trials_per_variant_ = std::max(1, std::atoi(var));
+    }
+  }
+
+  void Call(TVMArgs args, TVMRetValue* rv) {
+    std::string bucket = ShapeBucket(args);
+    int variant_id;
+    bool in_warmup;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Bucket& state = buckets_[bucket];
+      if (state.total_secs.empty()) {
+        state.total_secs.resize(variants_.size(), 0.0);
+        state.calls.resize(variants_.size(), 0);
+      }
+      in_warmup = state.winner < 0;
+      if (in_warmup) {
+        variant_id = state.next_variant;
+        state.next_variant = (state.next_variant + 1) % variants_.size();
+      } else {
+        variant_id = state.winner;
+      }
+    }
+    if (!in_warmup) {
+      variants_[variant_id].CallPacked(args, rv);
+      return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    variants_[variant_id].CallPacked(args, rv);
+    auto end = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(end - begin).count();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Bucket& state = buckets_[bucket];
+      state.total_secs[variant_id] += secs;
+      state.calls[variant_id] += 1;
+      bool warmup_done = true;
+      for (int calls : state.calls) {
+        warmup_done = warmup_done && calls >= trials_per_variant_;
+      }
+      if (warmup_done && state.winner < 0) {
+        double best = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < variants_.size(); ++i) {
+          double mean = state.total_secs[i] / state.calls[i];
+          if (mean < best) {
+            best = mean;
+            state.winner = static_cast<int>(i);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  struct Bucket {
+    int next_variant = 0;
+    int winner = -1;
+    std::vector<double> total_secs;
+    std::vector<int> calls;
+  };
+
+  static std::string ShapeBucket(const TVMArgs& args) {
+    std::string key;
+    for (int i = 0; i < args.num_args; ++i) {
+      if (args.type_codes[i] == kTVMDLTensorHandle || args.type_codes[i] == kTVMNDArrayHandle) {
+        const DLTensor* tensor = args[i].operator DLTensor*();
+        key += 't';
+        for (int j = 0; j < tensor->ndim; ++j) {
+          key += std::to_string(tensor->shape[j]);
+          key += 'x';
+        }
+      }
+    }
+    return key;
+  }
+
+  std::vector<PackedFunc> variants_;
+  std::unordered_map<std::string, Bucket> buckets_;
+  int trials_per_variant_ = 3;
+  std::mutex mutex_;
+};
+
+/*!
+ * \brief Whether library functions are returned behind a patchable indirection.
+ *
+ *  Off by default: the indirection costs one atomic load per call and pins the
+ *  executor to the PackedFunc dispatch path, so it is only paid for when a
+ *  deployment wants to hot-swap kernels.
+ */
+bool PatchableKernelsEnabled() {
+  static bool enabled = []() -> bool {
+    const char* var = std::getenv("TVM_RUNTIME_PATCHABLE_KERNELS");
+    return var != nullptr && std::atoi(var) != 0;
+  }();
+  return enabled;
+}
+
+/*!
+ * \brief The rebind point for one patchable library function.
+ *
+ *  The current implementation lives in an immutable epoch record that is swapped
+ *  atomically; calls in flight keep their epoch alive through the shared_ptr
+ *  refcount, so the old code object (and the patch library providing it) is only
+ *  released after the last call using it returns. Callers therefore never observe
+ *  a torn update and patching never blocks the call path.
+ */
+class PatchableFunctionSlot {
+ public:
+  struct Epoch {
+    /*! \brief The implementation called for the current epoch. */
+    PackedFunc func;
+    /*! \brief Keeps the library module providing func alive; undefined for the base impl. */
+    Module backing;
+  };
+
+  void Set(PackedFunc func, Module backing) {
+    auto next = std::make_shared<Epoch>();
+    next->func = std::move(func);
+    next->backing = std::move(backing);
+    std::atomic_store_explicit(&current_, std::move(next), std::memory_order_release);
+  }
+
+  std::shared_ptr<Epoch> Get() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+ private:
+  std::shared_ptr<Epoch> current_;
+};
+
+void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
+                       PackedFuncWrapper packed_func_wrapper, runtime::Module* root_module,
+                       runtime::ModuleNode** dso_ctx_addr, ModuleNode* self_lib);
+
 // Library module that exposes symbols from a library.
 class LibraryModuleNode final : public ModuleNode {
  public:
-  explicit LibraryModuleNode(ObjectPtr<Library> lib, PackedFuncWrapper wrapper)
-      : lib_(lib), packed_func_wrapper_(wrapper) {}
+  explicit LibraryModuleNode(ObjectPtr<Library> lib, PackedFuncWrapper wrapper,
+                             const char* lazy_mblob = nullptr)
+      : lib_(lib), packed_func_wrapper_(wrapper), lazy_mblob_(lazy_mblob) {}
 
   const char* type_key() const final { return "library"; }
 
@@ -48,6 +212,7 @@ class LibraryModuleNode final : public ModuleNode {
   };
 
   PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    EnsureImportsInitialized();
     TVMBackendPackedCFunc faddr;
     if (name == runtime::symbol::tvm_module_main) {
       const char* entry_name =
@@ -59,14 +224,213 @@ class LibraryModuleNode final : public ModuleNode {
       faddr = reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
     }
     if (faddr == nullptr) return PackedFunc();
-    return packed_func_wrapper_(faddr, sptr_to_self);
+    PackedFunc base = packed_func_wrapper_(faddr, sptr_to_self);
+    if (name != runtime::symbol::tvm_module_main) {
+      if (PackedFunc dispatcher = MaybeCreateVariantDispatcher(name, base, sptr_to_self)) {
+        base = dispatcher;
+      }
+      if (PatchableKernelsEnabled()) {
+        // executors cache the returned function, so the patch indirection must be
+        // the outermost wrapper for later rebinds to take effect on cached copies
+        return WrapPatchable(name, base);
+      }
+    }
+    return base;
+  }
+
+  /*!
+   * \brief Atomically rebind a function of this library to a new implementation.
+   * \param name The name of the function.
+   * \param replacement The new implementation.
+   * \param backing The module providing the implementation, kept alive by the slot.
+   * \return Whether the function exists in this library and was rebound.
+   */
+  bool PatchFunction(const String& name, PackedFunc replacement, Module backing) {
+    if (!PatchableKernelsEnabled()) {
+      return false;
+    }
+    // only patch functions this library actually provides, so that patching a
+    // mistyped or foreign symbol fails loudly at the call site below
+    if (lib_->GetSymbol(name.c_str()) == nullptr) {
+      return false;
+    }
+    GetOrCreatePatchSlot(name)->Set(std::move(replacement), std::move(backing));
+    return true;
+  }
+
+  /*!
+   * \brief Get the raw backend C entry of a symbol in the underlying library.
+   * \param name The name of the symbol.
+   * \return The entry address, or nullptr if the symbol is not present or the module
+   *         uses a non-default packed function wrapper.
+   */
+  TVMBackendPackedCFunc GetCSymbol(const std::string& name) {
+    // A resolved symbol can launch device kernels through the module context,
+    // so the imported device modules must be available before it runs.
+    EnsureImportsInitialized();
+    // Only modules wrapped with the default packed function wrapper are eligible:
+    // a custom wrapper may add behavior that a direct call would skip.
+    using FWrapper = PackedFunc (*)(TVMBackendPackedCFunc, const ObjectPtr<Object>&);
+    const FWrapper* wrapper = packed_func_wrapper_.target<FWrapper>();
+    if (wrapper == nullptr || *wrapper != &WrapPackedFunc) {
+      return nullptr;
+    }
+    // A raw entry would bypass the patch indirection, so pre-packed executors must
+    // stay on the PackedFunc path when kernels are patchable.
+    if (PatchableKernelsEnabled()) {
+      return nullptr;
+    }
+    return reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
   }
 
  private:
+  /*!
+   * \brief Wrap a function in a runtime variant dispatcher if the library ships variants.
+   *
+   *  Probes for `name__variant_0`, `name__variant_1`, ... next to `name`; when at least
+   *  one exists, returns a wrapper that autotunes between them per shape bucket during a
+   *  warmup window. Returns a null PackedFunc when no variants are present, keeping the
+   *  regular lookup path untouched.
+   */
+  PackedFunc MaybeCreateVariantDispatcher(const String& name, PackedFunc base,
+                                          const ObjectPtr<Object>& sptr_to_self) {
+    std::vector<PackedFunc> variants;
+    variants.push_back(base);
+    for (int i = 0;; ++i) {
+      std::string variant_name = std::string(name) + kVariantSymbolSuffix + std::to_string(i);
+      auto variant_addr =
+          reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(variant_name.c_str()));
+      if (variant_addr == nullptr) {
+        break;
+      }
+      variants.push_back(packed_func_wrapper_(variant_addr, sptr_to_self));
+    }
+    if (variants.size() == 1) {
+      return PackedFunc(nullptr);
+    }
+    auto state = std::make_shared<VariantDispatchState>(std::move(variants));
+    return PackedFunc([state, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
+      state->Call(args, rv);
+    });
+  }
+
+  /*!
+   * \brief Deserialize the pending metadata blob, if any, into imports_.
+   *
+   *  When lazy initialization is enabled the metadata blob is kept unparsed at load
+   *  time and materialized here on the first function lookup, so loading a library
+   *  only pays for the modules that are actually used. The blob is a sequential
+   *  stream, so materialization is all-or-nothing; symbol binding itself is already
+   *  on-demand via GetSymbol.
+   */
+  void EnsureImportsInitialized() {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    if (lazy_mblob_ == nullptr) return;
+    const char* mblob = lazy_mblob_;
+    lazy_mblob_ = nullptr;
+    Module root;
+    ModuleNode* dso_ctx_addr = nullptr;
+    ProcessModuleBlob(mblob, lib_, packed_func_wrapper_, &root, &dso_ctx_addr, this);
+    if (root.operator->() != this) {
+      // The import tree puts the library below another module. Importing that
+      // root here would create a cycle, so such layouts stay on the eager path.
+      CHECK(dso_ctx_addr != this)
+          << "ValueError: TVM_RUNTIME_LAZY_MODULE_INIT only supports libraries whose "
+          << "import tree is rooted at the library itself. "
+          << "Unset the variable when loading this library.";
+      imports_.emplace_back(root);
+    }
+  }
+
+  /*!
+   * \brief Return \p base behind the patch slot of \p name, seeding the slot with
+   *  \p base when no patch has been installed yet.
+   */
+  PackedFunc WrapPatchable(const String& name, PackedFunc base) {
+    std::shared_ptr<PatchableFunctionSlot> slot = GetOrCreatePatchSlot(name);
+    {
+      std::lock_guard<std::mutex> lock(patch_mutex_);
+      if (slot->Get() == nullptr) {
+        slot->Set(base, Module());
+      }
+    }
+    return PackedFunc([slot](TVMArgs args, TVMRetValue* rv) {
+      std::shared_ptr<PatchableFunctionSlot::Epoch> epoch = slot->Get();
+      epoch->func.CallPacked(args, rv);
+    });
+  }
+
+  std::shared_ptr<PatchableFunctionSlot> GetOrCreatePatchSlot(const String& name) {
+    std::lock_guard<std::mutex> lock(patch_mutex_);
+    std::shared_ptr<PatchableFunctionSlot>& slot = patch_slots_[std::string(name)];
+    if (slot == nullptr) {
+      slot = std::make_shared<PatchableFunctionSlot>();
+    }
+    return slot;
+  }
+
   ObjectPtr<Library> lib_;
   PackedFuncWrapper packed_func_wrapper_;
+  /*! \brief Metadata blob whose deserialization is deferred; nullptr once processed. */
+  const char* lazy_mblob_{nullptr};
+  /*! \brief Protects lazy_mblob_ and the materialization of imports_. */
+  std::mutex init_mutex_;
+  /*! \brief Rebind points of the functions handed out while patching is enabled. */
+  std::unordered_map<std::string, std::shared_ptr<PatchableFunctionSlot>> patch_slots_;
+  /*! \brief Protects patch_slots_ and slot seeding. */
+  std::mutex patch_mutex_;
 };
 
+bool PatchLibraryFunction(const Module& mod, const String& name, PackedFunc replacement,
+                          Module backing) {
+  if (!mod.defined()) return false;
+  // NOTE: module nodes do not participate in the object type hierarchy,
+  // so the type key is the only way to identify a library module.
+  if (std::strcmp(mod->type_key(), "library") == 0) {
+    auto* library_module = static_cast<LibraryModuleNode*>(mod.operator->());
+    if (library_module->PatchFunction(name, replacement, backing)) {
+      return true;
+    }
+  }
+  for (const Module& import : mod->imports()) {
+    if (PatchLibraryFunction(import, name, replacement, backing)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TVM_REGISTER_GLOBAL("runtime.ModulePatchFunction")
+    .set_body_typed([](Module mod, String name, Module patch) {
+      CHECK(PatchableKernelsEnabled())
+          << "ValueError: kernel patching requires the runtime to hand out patchable "
+          << "functions; set TVM_RUNTIME_PATCHABLE_KERNELS=1 before loading the artifact.";
+      PackedFunc replacement = patch.GetFunction(name, /*query_imports=*/true);
+      CHECK(replacement != nullptr)
+          << "ValueError: the patch module does not provide function " << name;
+      CHECK(PatchLibraryFunction(mod, name, replacement, patch))
+          << "ValueError: no library-backed function named " << name
+          << " found in the module or its imports";
+    });
+
+TVMBackendPackedCFunc GetLibraryCFunc(const Module& mod, const std::string& name) {
+  if (!mod.defined()) return nullptr;
+  // NOTE: module nodes do not participate in the object type hierarchy,
+  // so the type key is the only way to identify a library module.
+  if (std::strcmp(mod->type_key(), "library") == 0) {
+    auto* library_module = static_cast<LibraryModuleNode*>(mod.operator->());
+    if (TVMBackendPackedCFunc faddr = library_module->GetCSymbol(name)) {
+      return faddr;
+    }
+  }
+  for (const Module& import : mod->imports()) {
+    if (TVMBackendPackedCFunc faddr = GetLibraryCFunc(import, name)) {
+      return faddr;
+    }
+  }
+  return nullptr;
+}
+
 PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& sptr_to_self) {
   return PackedFunc([faddr, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
     TVMValue ret_value;
@@ -100,6 +464,13 @@ void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
   TVM_INIT_CONTEXT_FUNC(TVMBackendFreeWorkspace);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunch);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelBarrier);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendKernelTraceEnter);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendKernelTraceExit);
+  // Patch the kernel trace guards to read the runtime-wide enable flag.
+  // Kernels built without trace hooks simply do not export this symbol.
+  if (auto* fp = reinterpret_cast<const int32_t**>(fgetsymbol("__tvm_kernel_trace_enabled_ptr"))) {
+    *fp = TVMBackendKernelTraceEnabledFlag();
+  }
 
 #undef TVM_INIT_CONTEXT_FUNC
 }
@@ -133,10 +504,13 @@ Module LoadModuleFromBinary(const std::string& type_key, dmlc::Stream* stream) {
  * \param lib The library.
  * \param root_module the output root module
  * \param dso_ctx_addr the output dso module
+ * \param self_lib Optional existing library module node that stands in for the
+ *        "_lib" placeholder, used when the blob is materialized lazily.
  */
 void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
                        PackedFuncWrapper packed_func_wrapper, runtime::Module* root_module,
-                       runtime::ModuleNode** dso_ctx_addr = nullptr) {
+                       runtime::ModuleNode** dso_ctx_addr = nullptr,
+                       ModuleNode* self_lib = nullptr) {
   ICHECK(mblob != nullptr);
   uint64_t nbytes = 0;
   for (size_t i = 0; i < sizeof(nbytes); ++i) {
@@ -159,7 +533,9 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
     // "_lib" serves as a placeholder in the module import tree to indicate where
     // to place the DSOModule
     if (tkey == "_lib") {
-      auto dso_module = Module(make_object<LibraryModuleNode>(lib, packed_func_wrapper));
+      Module dso_module = self_lib != nullptr
+                              ? GetRef<Module>(self_lib)
+                              : Module(make_object<LibraryModuleNode>(lib, packed_func_wrapper));
       *dso_ctx_addr = dso_module.operator->();
       ++num_dso_module;
       modules.emplace_back(dso_module);
@@ -177,13 +553,15 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
   // if we are using old dll, we don't have import tree
   // so that we can't reconstruct module relationship using import tree
   if (import_tree_row_ptr.empty()) {
-    auto n = make_object<LibraryModuleNode>(lib, packed_func_wrapper);
+    Module n = self_lib != nullptr
+                   ? GetRef<Module>(self_lib)
+                   : Module(make_object<LibraryModuleNode>(lib, packed_func_wrapper));
     auto module_import_addr = ModuleInternal::GetImportsAddr(n.operator->());
     for (const auto& m : modules) {
       module_import_addr->emplace_back(m);
     }
-    *dso_ctx_addr = n.get();
-    *root_module = Module(n);
+    *dso_ctx_addr = n.operator->();
+    *root_module = n;
   } else {
     for (size_t i = 0; i < modules.size(); ++i) {
       for (size_t j = import_tree_row_ptr[i]; j < import_tree_row_ptr[i + 1]; ++j) {
@@ -203,18 +581,28 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
 
 Module CreateModuleFromLibrary(ObjectPtr<Library> lib, PackedFuncWrapper packed_func_wrapper) {
   InitContextFunctions([lib](const char* fname) { return lib->GetSymbol(fname); });
-  auto n = make_object<LibraryModuleNode>(lib, packed_func_wrapper);
   // Load the imported modules
   const char* dev_mblob =
       reinterpret_cast<const char*>(lib->GetSymbol(runtime::symbol::tvm_dev_mblob));
 
+  // When enabled, defer parsing of the metadata blob (and with it the
+  // deserialization of every imported module) until the first function lookup,
+  // so that loading a library only pays for what is actually invoked.
+  static bool lazy_init = []() -> bool {
+    const char* var = std::getenv("TVM_RUNTIME_LAZY_MODULE_INIT");
+    return var != nullptr && std::atoi(var) != 0;
+  }();
+
   Module root_mod;
   runtime::ModuleNode* dso_ctx_addr = nullptr;
-  if (dev_mblob != nullptr) {
+  if (dev_mblob != nullptr && lazy_init) {
+    root_mod = Module(make_object<LibraryModuleNode>(lib, packed_func_wrapper, dev_mblob));
+    dso_ctx_addr = root_mod.operator->();
+  } else if (dev_mblob != nullptr) {
     ProcessModuleBlob(dev_mblob, lib, packed_func_wrapper, &root_mod, &dso_ctx_addr);
   } else {
     // Only have one single DSO Module
-    root_mod = Module(n);
+    root_mod = Module(make_object<LibraryModuleNode>(lib, packed_func_wrapper));
     dso_ctx_addr = root_mod.operator->();
   }
 
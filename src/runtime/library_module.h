@@ -73,6 +73,38 @@ class Library : public Object {
  */
 PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& mptr);
 
+/*!
+ * \brief Look up the raw backend C entry of a function in a library-backed module.
+ *
+ *  The returned address is the same entry that WrapPackedFunc would wrap, so executors
+ *  that keep pre-packed argument records can invoke it directly and skip the
+ *  PackedFunc dispatch layers on the hot call path. The caller must keep \p mod alive
+ *  for as long as the address is used.
+ *
+ * \param mod The module to search, including its imports.
+ * \param name The name of the function.
+ * \return The entry address, or nullptr if \p mod has no library-backed function
+ *         with this name.
+ */
+TVMBackendPackedCFunc GetLibraryCFunc(const Module& mod, const std::string& name);
+
+/*!
+ * \brief Atomically rebind a library-backed function to a new implementation.
+ *
+ *  Only takes effect when the runtime hands out patchable functions (see
+ *  TVM_RUNTIME_PATCHABLE_KERNELS); copies of the function cached by executors then
+ *  pick up the new implementation on their next call, while calls in flight finish
+ *  on the implementation they started with.
+ *
+ * \param mod The module to search, including its imports.
+ * \param name The name of the function.
+ * \param replacement The new implementation.
+ * \param backing The module providing the implementation, kept alive by the binding.
+ * \return Whether a library-backed function with this name was found and rebound.
+ */
+bool PatchLibraryFunction(const Module& mod, const String& name, PackedFunc replacement,
+                          Module backing);
+
 /*!
  * \brief Utility to initialize conext function symbols during startup
  * \param fgetsymbol A symbol lookup function.
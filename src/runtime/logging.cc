@@ -426,3 +426,18 @@ std::string VLogContext::str() const {
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_LOG_CUSTOMIZE
+
+namespace tvm {
+namespace runtime {
+namespace detail {
+
+// Always compiled, so that translation units built with TVM_CHECKS_MINIMAL can
+// link against a runtime library that was built without it (and vice versa).
+[[noreturn]] void LogCheckFailed(const char* file, int lineno, const char* check_msg) {
+  LogFatal(file, lineno).stream() << check_msg;
+  throw;
+}
+
+}  // namespace detail
+}  // namespace runtime
+}  // namespace tvm
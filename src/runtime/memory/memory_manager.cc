@@ -24,11 +24,13 @@
 #include <tvm/runtime/memory/memory_manager.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstdlib>
 #include <memory>
 #include <utility>
 
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
+#include "stream_ordered_allocator.h"
 
 namespace tvm {
 namespace runtime {
@@ -114,9 +116,23 @@ NDArray StorageObj::AllocNDArray(int64_t offset, ShapeTuple shape, DLDataType dt
   NDArray ret(GetObjectPtr<Object>(container));
   // RAII in effect, now run the check.
 
-  ICHECK(offset + needed_size <= this->buffer.size)
-      << "storage allocation failure, attempted to allocate " << needed_size << " at offset "
-      << offset << " in region that is " << this->buffer.size << "bytes";
+  if (offset + needed_size > this->buffer.size) {
+    // Opt-in spill path for profile-guided memory plans: storages sized to a
+    // profiled shape envelope (see the `tir_var_profiled_bound` attribute in
+    // StaticPlanBlockMemory) can be exceeded by outlier shapes, in which case
+    // the tensor is served by a fresh allocation instead of the shared storage.
+    static bool spill_on_overflow = []() -> bool {
+      const char* var = std::getenv("TVM_VM_STORAGE_SPILL_ON_OVERFLOW");
+      return var != nullptr && std::atoi(var) != 0;
+    }();
+    if (spill_on_overflow && this->allocator != nullptr) {
+      return this->allocator->Empty(shape, dtype, this->buffer.device);
+    }
+    LOG(FATAL) << "storage allocation failure, attempted to allocate " << needed_size
+               << " at offset " << offset << " in region that is " << this->buffer.size
+               << "bytes. Set TVM_VM_STORAGE_SPILL_ON_OVERFLOW=1 to serve oversized tensors "
+               << "from the device allocator instead.";
+  }
 
   return ret;
 }
@@ -147,6 +163,11 @@ Allocator* MemoryManager::GetOrCreateAllocator(Device dev, AllocatorType type) {
         alloc.reset(new PooledAllocator());
         break;
       }
+      case kStreamOrdered: {
+        VLOG(1) << "New stream-ordered allocator for " << dev;
+        alloc.reset(new StreamOrderedAllocator());
+        break;
+      }
       default:
         LOG(FATAL) << "Unknown allocator type: " << type;
     }
@@ -176,6 +197,17 @@ Allocator* MemoryManager::GetAllocator(Device dev, AllocatorType type) {
   return it->second.at(type).get();
 }
 
+Device MemoryManager::GetPinnedHostDevice(Device dev) {
+  switch (dev.device_type) {
+    case kDLCUDA:
+      return Device{kDLCUDAHost, 0};
+    case kDLROCM:
+      return Device{kDLROCMHost, 0};
+    default:
+      return Device{kDLCPU, 0};
+  }
+}
+
 void MemoryManager::Clear() {
   MemoryManager* m = MemoryManager::Global();
   std::lock_guard<std::mutex> lock(m->mu_);
@@ -186,6 +218,16 @@ void MemoryManager::Clear() {
   }
 }
 
+void MemoryManager::Defragment() {
+  MemoryManager* m = MemoryManager::Global();
+  std::lock_guard<std::mutex> lock(m->mu_);
+  for (const auto& [device, allocators] : m->allocators_) {
+    for (const auto& [allocator_type, allocator] : allocators) {
+      allocator->Trim();
+    }
+  }
+}
+
 NDArray Allocator::Empty(ShapeTuple shape, DLDataType dtype, DLDevice dev,
                          Optional<String> mem_scope) {
   VerifyDataType(dtype);
@@ -228,8 +270,17 @@ void Allocator::Clear() {
   // Pooled allocator will override this method.
 }
 
+void Allocator::Trim() {
+  // This function by default does nothing.
+  // For naive allocator, there is no cached free memory to release.
+  // Pooled allocator will override this method.
+}
+
 TVM_REGISTER_GLOBAL("vm.builtin.memory_manager.clear").set_body_typed(MemoryManager::Clear);
 
+TVM_REGISTER_GLOBAL("vm.builtin.memory_manager.defragment")
+    .set_body_typed(MemoryManager::Defragment);
+
 }  // namespace memory
 }  // namespace runtime
 }  // namespace tvm
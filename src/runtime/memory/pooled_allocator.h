@@ -39,16 +39,26 @@ namespace memory {
 class PooledAllocator : public Allocator {
  public:
   static constexpr size_t kDefaultPageSize = 4096;
+  static constexpr size_t kDefaultBucketGrowth = 2;
 
-  explicit PooledAllocator(size_t page_size = kDefaultPageSize)
-      : Allocator(kPooled), page_size_(page_size), used_memory_(0) {}
+  explicit PooledAllocator(size_t page_size = kDefaultPageSize,
+                           size_t bucket_growth = kDefaultBucketGrowth)
+      : Allocator(kPooled), page_size_(page_size), bucket_growth_(bucket_growth), used_memory_(0) {}
 
   ~PooledAllocator() { ReleaseAll(); }
 
   Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) override {
     std::lock_guard<std::recursive_mutex> lock(mu_);
-    size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
-    auto&& it = memory_pool_.find(size);
+    size_t size = BucketSize(nbytes);
+    auto it = memory_pool_.find(size);
+    if ((it == memory_pool_.end() || it->second.empty()) && bucket_growth_ > 1) {
+      // Best-fit fallback: a cached block from the next-larger bucket is still
+      // a bounded over-allocation and avoids touching the device allocator.
+      auto larger = memory_pool_.find(size * bucket_growth_);
+      if (larger != memory_pool_.end() && !larger->second.empty()) {
+        it = larger;
+      }
+    }
     if (it != memory_pool_.end() && !it->second.empty()) {
       auto&& pool = it->second;
       auto ret = pool.back();
@@ -59,6 +69,7 @@ class PooledAllocator : public Allocator {
     buf.device = dev;
     buf.size = size;
     buf.alloc_type = kPooled;
+    device_alloc_count_.fetch_add(1, std::memory_order_relaxed);
     try {
       buf.data = DeviceAllocDataSpace(dev, size, alignment, type_hint);
     } catch (InternalError& err) {
@@ -93,9 +104,41 @@ class PooledAllocator : public Allocator {
 
   void Clear() override { ReleaseAll(); }
 
+  void Trim() override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    for (auto const& it : memory_pool_) {
+      for (auto const& buf : it.second) {
+        DeviceFreeDataSpace(buf.device, buf.data);
+        used_memory_.fetch_sub(buf.size, std::memory_order_relaxed);
+      }
+    }
+    memory_pool_.clear();
+    VLOG(1) << "trim cached buffers, used memory " << used_memory_ << " B";
+  }
+
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  size_t DeviceAllocCount() const override {
+    return device_alloc_count_.load(std::memory_order_relaxed);
+  }
+
  protected:
+  /*!
+   * \brief Round a request up to its free-list bucket.
+   *
+   *  Requests are first rounded to whole pages and then to the geometric
+   *  series page_size * growth^k, so buffers from nearby request sizes share
+   *  free lists instead of each exact size pinning its own never-reused block.
+   */
+  size_t BucketSize(size_t nbytes) const {
+    size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
+    if (bucket_growth_ <= 1) return size;
+    size_t bucket = page_size_;
+    while (bucket < size) {
+      bucket *= bucket_growth_;
+    }
+    return bucket;
+  }
   virtual void* DeviceAllocDataSpace(Device dev, size_t nbytes, size_t alignment,
                                      DLDataType type_hint) {
     return DeviceAPI::Get(dev)->AllocDataSpace(dev, nbytes, alignment, type_hint);
@@ -120,7 +163,11 @@ class PooledAllocator : public Allocator {
 
  protected:
   size_t page_size_;
+  // growth factor of the free-list bucket series, <= 1 disables bucketing
+  size_t bucket_growth_;
   std::atomic<size_t> used_memory_;
+  // allocations that missed the pool and hit the device allocator
+  std::atomic<size_t> device_alloc_count_{0};
   std::unordered_map<size_t, std::vector<Buffer>> memory_pool_;
   std::recursive_mutex mu_;
 };
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/memory/stream_ordered_allocator.h
+ */
+#ifndef TVM_RUNTIME_MEMORY_STREAM_ORDERED_ALLOCATOR_H_
+#define TVM_RUNTIME_MEMORY_STREAM_ORDERED_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory/memory_manager.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+#include <string>
+
+namespace tvm {
+namespace runtime {
+namespace memory {
+
+/*!
+ * \brief An allocator that issues allocations in stream order.
+ *
+ *  Synchronous device allocation (cudaMalloc) implicitly synchronizes the whole
+ *  device, so an allocation on one inference stream stalls kernels already
+ *  running on every other stream. This allocator routes requests through the
+ *  device's stream-ordered allocation entry points when the backend registers
+ *  them ("runtime.<device>.malloc_async" / "runtime.<device>.free_async"); the
+ *  allocation and free are then just operations enqueued on the caller's
+ *  current stream, pooled by the driver, and cross-stream reuse dependencies
+ *  are tracked by the driver's memory pool rather than with device-wide syncs.
+ *
+ *  Devices without registered async entry points silently fall back to the
+ *  synchronous DeviceAPI path, so the allocator type is safe to request for a
+ *  heterogeneous set of devices.
+ */
+class StreamOrderedAllocator final : public Allocator {
+ public:
+  explicit StreamOrderedAllocator() : Allocator(kStreamOrdered), used_memory_(0) {}
+
+  Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
+    Buffer buf;
+    buf.device = dev;
+    buf.size = nbytes;
+    buf.alloc_type = kStreamOrdered;
+    if (const PackedFunc* f = MallocAsyncFunc(dev)) {
+      buf.data = (*f)(dev.device_id, static_cast<int64_t>(nbytes));
+    } else {
+      buf.data = DeviceAPI::Get(dev)->AllocDataSpace(dev, nbytes, alignment, type_hint);
+    }
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
+    return buf;
+  }
+
+  Buffer Alloc(Device dev, ShapeTuple shape, DLDataType type_hint,
+               const std::string& mem_scope) final {
+    if (AllowMemoryScope(mem_scope)) {
+      return Allocator::Alloc(dev, shape, type_hint, mem_scope);
+    }
+    // Scoped memory (e.g. textures) has no stream-ordered entry point; let the
+    // device API place it directly.
+    Buffer buf;
+    buf.device = dev;
+    size_t nbytes = 1;
+    for (int i = 0; i < static_cast<int>(shape.size()); ++i) {
+      nbytes *= static_cast<size_t>(shape[i]);
+    }
+    nbytes *= (type_hint.bits * type_hint.lanes + 7) / 8;
+    buf.size = nbytes;
+    buf.data = DeviceAPI::Get(dev)->AllocDataSpace(dev, shape.size(), shape.data(), type_hint,
+                                                   String(mem_scope));
+    buf.alloc_type = kStreamOrdered;
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    return buf;
+  }
+
+  void Free(const Buffer& buffer) final {
+    if (const PackedFunc* f = FreeAsyncFunc(buffer.device)) {
+      (*f)(buffer.device.device_id, buffer.data);
+    } else {
+      DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+    }
+    used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+    DLOG(INFO) << "free " << buffer.size << " B, used memory " << used_memory_ << " B";
+  }
+
+  size_t UsedMemory() const final { return used_memory_.load(std::memory_order_relaxed); }
+
+ private:
+  // The async entry points are looked up once per device type; a registration
+  // appearing mid-run would leave frees mismatched with their allocations.
+  static const PackedFunc* MallocAsyncFunc(Device dev) {
+    if (dev.device_type != kDLCUDA) return nullptr;
+    static const PackedFunc* f = Registry::Get("runtime.cuda.malloc_async");
+    return f;
+  }
+
+  static const PackedFunc* FreeAsyncFunc(Device dev) {
+    if (dev.device_type != kDLCUDA) return nullptr;
+    static const PackedFunc* f = Registry::Get("runtime.cuda.free_async");
+    return f;
+  }
+
+  std::atomic<size_t> used_memory_;
+};
+
+}  // namespace memory
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_MEMORY_STREAM_ORDERED_ALLOCATOR_H_
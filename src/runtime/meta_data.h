@@ -64,6 +64,15 @@ namespace launch_param {
 /*! \brief A tag to specify whether or not dynamic shared memory is used */
 constexpr const char* kUseDynamicSharedMemoryTag = "tir.use_dyn_shared_memory";
 
+/*! \brief A tag to specify that the kernel requires a cooperative launch.
+ *
+ * Kernels that synchronize across the whole grid (storage sync scope "grid")
+ * have to be launched through the cooperative launch API so that all thread
+ * blocks are resident. Unlike other tags, this one carries no host-side
+ * launch argument.
+ */
+constexpr const char* kUseCooperativeLaunchTag = "tir.use_cooperative_launch";
+
 }  // namespace launch_param
 
 /*! \brief function information needed by device */
@@ -192,8 +192,20 @@ class MetalWorkspace final : public DeviceAPI {
                       TVMStreamHandle stream) final;
 
  private:
+  /*!
+   * \brief Sub-allocate a buffer from the per-device heaps.
+   *
+   *  Falls back to nil (and thus a discrete MTLBuffer in the caller) when the
+   *  allocation is too large for heap placement or heaps are unavailable.
+   */
+  id<MTLBuffer> AllocBufferFromHeaps(Device device, id<MTLDevice> dev, size_t nbytes,
+                                     MTLResourceOptions storage_mode);
   // Pointers to default allocated streams
   std::vector<Stream*> default_streams_;
+  // Heaps backing small data-space allocations, per device
+  std::vector<std::vector<id<MTLHeap>>> heaps_;
+  // Guards heaps_
+  std::mutex heaps_mutex_;
 };
 
 /*! \brief Thread local workspace */
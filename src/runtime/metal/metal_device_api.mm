@@ -136,6 +136,11 @@ int GetWarpSize(id<MTLDevice> dev) {
 }
 
 MetalWorkspace::~MetalWorkspace() {
+  for (auto& dev_heaps : heaps_) {
+    for (auto heap : dev_heaps) {
+      [heap release];
+    }
+  }
   for (auto x : devices) {
     [x release];
   }
@@ -176,6 +181,38 @@ void MetalWorkspace::SetDevice(Device dev) {
   MetalThreadEntry::ThreadLocal()->device.device_id = dev.device_id;
 }
 
+id<MTLBuffer> MetalWorkspace::AllocBufferFromHeaps(Device device, id<MTLDevice> dev, size_t nbytes,
+                                                   MTLResourceOptions storage_mode) {
+  // Tracked heaps need macOS 10.15 / iOS 13; without them the sub-allocated
+  // buffers would require manual fencing, which the launch path does not do.
+  if (@available(macOS 10.15, iOS 13.0, *)) {
+    // The size of each heap block backing small allocations.
+    constexpr size_t kHeapBlockBytes = size_t(32) << 20;
+    // Allocations above this go to discrete buffers; a heap block holds
+    // several small tensors, which is where the allocation overhead is.
+    constexpr size_t kMaxHeapAllocBytes = size_t(8) << 20;
+    if (nbytes > kMaxHeapAllocBytes) return nil;
+    std::lock_guard<std::mutex> lock(heaps_mutex_);
+    if (static_cast<size_t>(device.device_id) >= heaps_.size()) {
+      heaps_.resize(device.device_id + 1);
+    }
+    for (id<MTLHeap> heap : heaps_[device.device_id]) {
+      id<MTLBuffer> buf = [heap newBufferWithLength:nbytes options:storage_mode];
+      if (buf != nil) return buf;
+    }
+    MTLHeapDescriptor* desc = [[MTLHeapDescriptor alloc] init];
+    desc.storageMode = MTLStorageModePrivate;
+    desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    desc.size = kHeapBlockBytes;
+    id<MTLHeap> heap = [dev newHeapWithDescriptor:desc];
+    [desc release];
+    if (heap == nil) return nil;
+    heaps_[device.device_id].push_back(heap);
+    return [heap newBufferWithLength:nbytes options:storage_mode];
+  }
+  return nil;
+}
+
 void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignment,
                                      DLDataType type_hint) {
   id<MTLBuffer> buf;
@@ -190,7 +227,13 @@ void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignm
     storage_mode = MTLResourceStorageModeManaged;
     #endif
     */
-    buf = [dev newBufferWithLength:nbytes options:storage_mode];
+    // Small tensors are sub-allocated from per-device heaps; discrete
+    // buffers are only created for large tensors or when heap placement
+    // fails (e.g. fragmentation).
+    buf = AllocBufferFromHeaps(device, dev, nbytes, storage_mode);
+    if (buf == nil) {
+      buf = [dev newBufferWithLength:nbytes options:storage_mode];
+    }
     ICHECK(buf != nil);
   };
   return (void*)(buf);
@@ -202,9 +245,18 @@ void MetalWorkspace::FreeDataSpace(Device dev, void* ptr) {
     // before set the purgeable state to empty
     // otherwise can cause issues sometimes
     this->StreamSync(dev, nullptr);
-    // MTLBuffer PurgeableState should be set to empty before manual
-    // release in order to prevent memory leak
-    [(id<MTLBuffer>)ptr setPurgeableState:MTLPurgeableStateEmpty];
+    bool on_heap = false;
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+      on_heap = [(id<MTLBuffer>)ptr heap] != nil;
+    }
+    if (!on_heap) {
+      // MTLBuffer PurgeableState should be set to empty before manual
+      // release in order to prevent memory leak
+      // NOTE: purging a heap-backed buffer would purge the whole heap,
+      // so only discrete buffers are purged; releasing a heap buffer
+      // returns its range to the heap.
+      [(id<MTLBuffer>)ptr setPurgeableState:MTLPurgeableStateEmpty];
+    }
     // release the ptr.
     CFRelease(ptr);
   };
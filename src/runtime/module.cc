@@ -66,9 +66,23 @@ PackedFunc ModuleNode::GetFunction(const String& name, bool query_imports) {
   PackedFunc pf = self->GetFunction(name, GetObjectPtr<Object>(this));
   if (pf != nullptr) return pf;
   if (query_imports) {
+    // Probe the symbol index before walking the imports. Each level of the
+    // import tree indexes the names its subtree has resolved, so a repeated
+    // lookup costs one hash probe per level instead of a linear scan.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = import_index_.find(name);
+      if (it != import_index_.end()) {
+        ModuleNode* resolver = it->second;
+        return resolver->GetFunction(name, true);
+      }
+    }
     for (Module& m : self->imports_) {
-      pf = m.operator->()->GetFunction(name, query_imports);
+      ModuleNode* import = m.operator->();
+      pf = import->GetFunction(name, query_imports);
       if (pf != nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        import_index_.emplace(name, import);
         return pf;
       }
     }
@@ -21,12 +21,20 @@
  * \file ndarray.cc
  * \brief NDArray container infratructure.
  */
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "runtime_base.h"
 
 extern "C" {
@@ -96,6 +104,217 @@ void ArrayCopyToBytes(const DLTensor* handle, void* data, size_t nbytes) {
   DeviceAPI::Get(handle->device)->StreamSync(handle->device, nullptr);
 }
 
+namespace {
+
+/*! \brief Whether the tensor's memory can be touched directly by the host. */
+inline bool IsHostAccessible(const DLTensor& tensor) {
+  return tensor.device.device_type == kDLCPU || tensor.device.device_type == kDLCUDAHost ||
+         tensor.device.device_type == kDLROCMHost;
+}
+
+/*!
+ * \brief A coalesced loop nest describing an elementwise copy between two
+ *  host tensors of the same shape, outermost dimension first.
+ *
+ *  Size-1 dimensions are dropped and adjacent dimensions that both tensors
+ *  traverse contiguously are merged, so a pair of compact tensors collapses
+ *  to a single memcpy and a transposed pair keeps the longest possible
+ *  inner loops.
+ */
+struct StridedCopyPlan {
+  std::vector<int64_t> extents;
+  std::vector<int64_t> from_strides;  // in bytes
+  std::vector<int64_t> to_strides;    // in bytes
+  const uint8_t* from_data;
+  uint8_t* to_data;
+  int64_t elem_bytes;
+};
+
+StridedCopyPlan MakeStridedCopyPlan(const DLTensor* from, const DLTensor* to) {
+  CHECK_EQ(from->ndim, to->ndim) << "ValueError: CopyFromTo requires tensors of the same shape, "
+                                 << "but got ndim " << from->ndim << " and " << to->ndim << ".";
+  CHECK(DataType(from->dtype) == DataType(to->dtype))
+      << "ValueError: CopyFromTo requires tensors of the same dtype for strided copies, but got "
+      << DataType(from->dtype) << " and " << DataType(to->dtype) << ".";
+  StridedCopyPlan plan;
+  plan.elem_bytes = (from->dtype.bits * from->dtype.lanes + 7) / 8;
+  plan.from_data = static_cast<const uint8_t*>(from->data) + from->byte_offset;
+  plan.to_data = static_cast<uint8_t*>(to->data) + to->byte_offset;
+  // element strides of a dimension, compact when strides are absent
+  auto stride_at = [](const DLTensor* tensor, int dim) -> int64_t {
+    if (tensor->strides != nullptr) {
+      return tensor->strides[dim];
+    }
+    int64_t stride = 1;
+    for (int i = tensor->ndim - 1; i > dim; --i) {
+      stride *= tensor->shape[i];
+    }
+    return stride;
+  };
+  for (int i = 0; i < from->ndim; ++i) {
+    CHECK_EQ(from->shape[i], to->shape[i])
+        << "ValueError: CopyFromTo requires tensors of the same shape, but dimension " << i
+        << " has extents " << from->shape[i] << " and " << to->shape[i] << ".";
+    int64_t extent = from->shape[i];
+    if (extent == 1) {
+      continue;
+    }
+    int64_t from_stride = stride_at(from, i) * plan.elem_bytes;
+    int64_t to_stride = stride_at(to, i) * plan.elem_bytes;
+    if (!plan.extents.empty() && plan.from_strides.back() == from_stride * extent &&
+        plan.to_strides.back() == to_stride * extent) {
+      plan.extents.back() *= extent;
+      plan.from_strides.back() = from_stride;
+      plan.to_strides.back() = to_stride;
+    } else {
+      plan.extents.push_back(extent);
+      plan.from_strides.push_back(from_stride);
+      plan.to_strides.push_back(to_stride);
+    }
+  }
+  if (plan.extents.empty()) {
+    plan.extents.push_back(1);
+    plan.from_strides.push_back(plan.elem_bytes);
+    plan.to_strides.push_back(plan.elem_bytes);
+  }
+  return plan;
+}
+
+/*!
+ * \brief Copy one innermost run. Unit strides on both sides become a single
+ *  memcpy; otherwise the fixed-size assignments below compile into
+ *  vectorized gather/scatter loops.
+ */
+void CopyStridedInner(const uint8_t* from, uint8_t* to, int64_t extent, int64_t from_stride,
+                      int64_t to_stride, int64_t elem_bytes) {
+  if (from_stride == elem_bytes && to_stride == elem_bytes) {
+    std::memcpy(to, from, extent * elem_bytes);
+    return;
+  }
+  switch (elem_bytes) {
+    case 1:
+      for (int64_t i = 0; i < extent; ++i) {
+        to[i * to_stride] = from[i * from_stride];
+      }
+      break;
+    case 2:
+      for (int64_t i = 0; i < extent; ++i) {
+        *reinterpret_cast<uint16_t*>(to + i * to_stride) =
+            *reinterpret_cast<const uint16_t*>(from + i * from_stride);
+      }
+      break;
+    case 4:
+      for (int64_t i = 0; i < extent; ++i) {
+        *reinterpret_cast<uint32_t*>(to + i * to_stride) =
+            *reinterpret_cast<const uint32_t*>(from + i * from_stride);
+      }
+      break;
+    case 8:
+      for (int64_t i = 0; i < extent; ++i) {
+        *reinterpret_cast<uint64_t*>(to + i * to_stride) =
+            *reinterpret_cast<const uint64_t*>(from + i * from_stride);
+      }
+      break;
+    default:
+      for (int64_t i = 0; i < extent; ++i) {
+        std::memcpy(to + i * to_stride, from + i * from_stride, elem_bytes);
+      }
+      break;
+  }
+}
+
+/*!
+ * \brief Copy the two innermost dimensions in cache-sized tiles. Used when
+ *  the inner dimension is strided on either side (a transposition), where
+ *  walking whole rows would touch each destination cache line many times.
+ */
+void CopyStrided2DBlocked(const uint8_t* from, uint8_t* to, int64_t extent0, int64_t extent1,
+                          int64_t from_stride0, int64_t from_stride1, int64_t to_stride0,
+                          int64_t to_stride1, int64_t elem_bytes) {
+  constexpr int64_t kTile = 64;
+  for (int64_t b0 = 0; b0 < extent0; b0 += kTile) {
+    int64_t end0 = std::min(b0 + kTile, extent0);
+    for (int64_t b1 = 0; b1 < extent1; b1 += kTile) {
+      int64_t end1 = std::min(b1 + kTile, extent1);
+      for (int64_t i0 = b0; i0 < end0; ++i0) {
+        CopyStridedInner(from + i0 * from_stride0 + b1 * from_stride1,
+                         to + i0 * to_stride0 + b1 * to_stride1, end1 - b1, from_stride1,
+                         to_stride1, elem_bytes);
+      }
+    }
+  }
+}
+
+void RunStridedCopy(const StridedCopyPlan& plan, int dim, const uint8_t* from, uint8_t* to) {
+  int ndim = static_cast<int>(plan.extents.size());
+  if (dim == ndim - 1) {
+    CopyStridedInner(from, to, plan.extents[dim], plan.from_strides[dim], plan.to_strides[dim],
+                     plan.elem_bytes);
+    return;
+  }
+  if (dim == ndim - 2 && (plan.from_strides[ndim - 1] != plan.elem_bytes ||
+                          plan.to_strides[ndim - 1] != plan.elem_bytes)) {
+    CopyStrided2DBlocked(from, to, plan.extents[dim], plan.extents[ndim - 1],
+                         plan.from_strides[dim], plan.from_strides[ndim - 1],
+                         plan.to_strides[dim], plan.to_strides[ndim - 1], plan.elem_bytes);
+    return;
+  }
+  for (int64_t i = 0; i < plan.extents[dim]; ++i) {
+    RunStridedCopy(plan, dim + 1, from + i * plan.from_strides[dim],
+                   to + i * plan.to_strides[dim]);
+  }
+}
+
+/*! \brief Copy the outermost-dimension range [begin, end) of the plan. */
+void CopyStridedOuterRange(const StridedCopyPlan& plan, int64_t begin, int64_t end) {
+  const uint8_t* from = plan.from_data + begin * plan.from_strides[0];
+  uint8_t* to = plan.to_data + begin * plan.to_strides[0];
+  if (plan.extents.size() == 1) {
+    CopyStridedInner(from, to, end - begin, plan.from_strides[0], plan.to_strides[0],
+                     plan.elem_bytes);
+    return;
+  }
+  for (int64_t i = begin; i < end; ++i) {
+    RunStridedCopy(plan, 1, plan.from_data + i * plan.from_strides[0],
+                   plan.to_data + i * plan.to_strides[0]);
+  }
+}
+
+int StridedCopyParallelTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  const StridedCopyPlan& plan = *static_cast<const StridedCopyPlan*>(cdata);
+  int64_t extent = plan.extents[0];
+  int64_t chunk = (extent + penv->num_task - 1) / penv->num_task;
+  int64_t begin = std::min<int64_t>(task_id * chunk, extent);
+  int64_t end = std::min<int64_t>(begin + chunk, extent);
+  if (begin < end) {
+    CopyStridedOuterRange(plan, begin, end);
+  }
+  return 0;
+}
+
+/*!
+ * \brief Elementwise copy between host tensors where either side is strided.
+ *  Large copies are split over the outermost dimension across the runtime
+ *  thread pool.
+ */
+void CopyStridedHostTensors(const DLTensor* from, DLTensor* to) {
+  StridedCopyPlan plan = MakeStridedCopyPlan(from, to);
+  constexpr int64_t kParallelBytes = 1 << 22;
+  int64_t total_bytes = plan.elem_bytes;
+  for (int64_t extent : plan.extents) {
+    total_bytes *= extent;
+  }
+  if (total_bytes >= kParallelBytes && plan.extents[0] > 1) {
+    if (TVMBackendParallelLaunch(StridedCopyParallelTask, &plan, /*num_task=*/0) == 0) {
+      return;
+    }
+    // thread pool unavailable; fall through to the serial path
+  }
+  CopyStridedOuterRange(plan, 0, plan.extents[0]);
+}
+
+}  // namespace
+
 struct NDArray::Internal {
   // Default deleter for the container
   static void DefaultDeleter(Object* ptr_obj) {
@@ -128,6 +347,13 @@ struct NDArray::Internal {
     auto* ptr = static_cast<NDArray::Container*>(ptr_obj);
     delete ptr;
   }
+  // Rebind the shape of a container in place; used by the external tensor
+  // registry for cheap per-call shape updates of registered buffers.
+  static void RebindShape(NDArray::Container* container, ShapeTuple shape) {
+    container->shape_ = std::move(shape);
+    container->dl_tensor.shape = const_cast<ShapeTuple::index_type*>(container->shape_.data());
+    container->dl_tensor.ndim = static_cast<int>(container->shape_.size());
+  }
   // Local create function which allocates tensor metadata
   // but does not allocate space for the data.
   static NDArray Create(ShapeTuple shape, DLDataType dtype, Device dev) {
@@ -321,6 +547,15 @@ void NDArray::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle str
       << "Can not copy across different device types directly. From device type: "
       << from->device.device_type << " to device type: " << to->device.device_type;
 
+  // Strided host-side views take the dedicated copy engine; device APIs
+  // only handle compact tensors.
+  if (IsHostAccessible(*from) && IsHostAccessible(*to) &&
+      (!IsContiguous(*from) || !IsContiguous(*to)) &&
+      (from->dtype.bits * from->dtype.lanes) % 8 == 0) {
+    CopyStridedHostTensors(from, to);
+    return;
+  }
+
   // Use the device that is *not* a cpu device to get the correct device
   // api manager.
   Device dev = from->device.device_type != kDLCPU ? from->device : to->device;
@@ -351,6 +586,70 @@ bool NDArray::IsAligned(const DLTensor& tensor) {
 
 TVM_REGISTER_OBJECT_TYPE(NDArray::Container);
 
+/*!
+ * \brief The registry of persistent zero-copy views over external buffers.
+ *
+ *  Registration runs the usual contiguity and alignment validation once and
+ *  pins an NDArray over the external buffer, so the handle stays stable and
+ *  can be passed to packed functions on every call without re-validation.
+ *  Rebinding only checks the new extents against the byte capacity recorded
+ *  at registration; data pointer, dtype and device are fixed.
+ */
+class ExternalTensorRegistry {
+ public:
+  static ExternalTensorRegistry* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new ExternalTensorRegistry();
+    return inst;
+  }
+
+  TVMArrayHandle Register(const DLTensor& tensor) {
+    // FromExternalDLTensor performs the one-time contiguity/alignment checks.
+    NDArray array = NDArray::FromExternalDLTensor(tensor);
+    TVMArrayHandle handle =
+        reinterpret_cast<TVMArrayHandle>(const_cast<DLTensor*>(array.operator->()));
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[handle] = Entry{array, GetDataSize(*array.operator->())};
+    return handle;
+  }
+
+  void RebindShape(TVMArrayHandle handle, const tvm_index_t* shape, int ndim) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(handle);
+    CHECK(it != entries_.end())
+        << "ValueError: The handle was not registered by TVMExternalTensorRegister";
+    const DLTensor& tensor = *it->second.array.operator->();
+    size_t num_elems = 1;
+    for (int i = 0; i < ndim; ++i) {
+      CHECK_GE(shape[i], 0) << "ValueError: The shape extents should be non-negative";
+      num_elems *= static_cast<size_t>(shape[i]);
+    }
+    size_t nbytes = (num_elems * tensor.dtype.bits * tensor.dtype.lanes + 7) / 8;
+    CHECK_LE(nbytes, it->second.capacity_bytes)
+        << "ValueError: The new shape exceeds the capacity of the registered buffer";
+    auto* container = static_cast<NDArray::Container*>(
+        reinterpret_cast<NDArray::ContainerBase*>(handle));
+    NDArray::Internal::RebindShape(container, ShapeTuple(shape, shape + ndim));
+  }
+
+  void Unregister(TVMArrayHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(entries_.erase(handle) != 0)
+        << "ValueError: The handle was not registered by TVMExternalTensorRegister";
+  }
+
+ private:
+  struct Entry {
+    /*! \brief The view pinned over the external buffer. */
+    NDArray array;
+    /*! \brief The byte capacity validated at registration. */
+    size_t capacity_bytes;
+  };
+  std::mutex mutex_;
+  std::unordered_map<TVMArrayHandle, Entry> entries_;
+};
+
 }  // namespace runtime
 }  // namespace tvm
 
@@ -412,6 +711,27 @@ int TVMArrayToDLPack(TVMArrayHandle from, DLManagedTensor** out) {
 
 void TVMDLManagedTensorCallDeleter(DLManagedTensor* dltensor) { (*(dltensor->deleter))(dltensor); }
 
+int TVMExternalTensorRegister(DLTensor* tensor, TVMArrayHandle* out) {
+  API_BEGIN();
+  ICHECK(tensor != nullptr && out != nullptr);
+  *out = ExternalTensorRegistry::Global()->Register(*tensor);
+  API_END();
+}
+
+int TVMExternalTensorRebindShape(TVMArrayHandle handle, const tvm_index_t* shape, int ndim) {
+  API_BEGIN();
+  ICHECK(handle != nullptr && (shape != nullptr || ndim == 0));
+  ExternalTensorRegistry::Global()->RebindShape(handle, shape, ndim);
+  API_END();
+}
+
+int TVMExternalTensorUnregister(TVMArrayHandle handle) {
+  API_BEGIN();
+  ICHECK(handle != nullptr);
+  ExternalTensorRegistry::Global()->Unregister(handle);
+  API_END();
+}
+
 int TVMArrayCopyFromBytes(TVMArrayHandle handle, void* data, size_t nbytes) {
   API_BEGIN();
   ArrayCopyFromBytes(handle, data, nbytes);
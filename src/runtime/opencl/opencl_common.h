@@ -58,6 +58,7 @@
 #include <CL/opencl.h>
 #endif
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -235,6 +236,19 @@ class OpenCLWorkspace : public DeviceAPI {
   std::vector<cl_command_queue> queues;
   // the events
   std::vector<std::vector<cl_event>> events;
+  // Whether the opt-in chained execution mode is active
+  // (TVM_OPENCL_EVENT_CHAINING=1). Queues are then created out-of-order and
+  // every command waits on its predecessor through an event, so the driver can
+  // batch an entire executor step and only a single clFlush happens at the next
+  // synchronization point.
+  bool use_event_chaining{false};
+  // Tail of the per-device event chain, i.e. the event of the last enqueued command.
+  std::vector<cl_event> chain_tail;
+  // Ring of recently retired chain events, so per-kernel timings stay queryable
+  // while the queue is in profiling mode without the chain growing unbounded.
+  std::vector<std::deque<cl_event>> chain_ring;
+  // Capacity of each per-device chain event ring.
+  static constexpr size_t kChainEventRingSize = 256;
   // Number of registered kernels
   // Used to register kernel into the workspace.
   size_t num_registered_kernels{0};
@@ -272,6 +286,39 @@ class OpenCLWorkspace : public DeviceAPI {
         << "Invalid OpenCL device_id=" << dev.device_id << ". " << GetError();
     return events[dev.device_id];
   }
+  // Get the wait list the next chained command on dev must use.
+  // Returns the number of wait events (0 or 1); *wait_list points at the chain tail.
+  cl_uint ChainWaitList(Device dev, cl_event** wait_list) {
+    if (!use_event_chaining || chain_tail[dev.device_id] == nullptr) {
+      *wait_list = nullptr;
+      return 0;
+    }
+    *wait_list = &chain_tail[dev.device_id];
+    return 1;
+  }
+  // Record the event of a just-enqueued chained command, taking ownership of one
+  // reference and retiring the previous tail into the ring.
+  void ChainPushEvent(Device dev, cl_event event) {
+    cl_event& tail = chain_tail[dev.device_id];
+    if (tail != nullptr) {
+      auto& ring = chain_ring[dev.device_id];
+      ring.push_back(tail);
+      if (ring.size() > kChainEventRingSize) {
+        OPENCL_CALL(clReleaseEvent(ring.front()));
+        ring.pop_front();
+      }
+    }
+    tail = event;
+  }
+  // Flush once and wait for the chain tail. Since every command waits on its
+  // predecessor, tail completion implies the whole chain has completed.
+  void ChainSync(Device dev) {
+    cl_event& tail = chain_tail[dev.device_id];
+    if (tail != nullptr) {
+      OPENCL_CALL(clFlush(GetQueue(dev)));
+      OPENCL_CALL(clWaitForEvents(1, &tail));
+    }
+  }
   // is current clCommandQueue in profiling mode
   bool IsProfiling(Device dev) {
     cl_command_queue queue = GetQueue(dev);
@@ -291,6 +338,9 @@ class OpenCLWorkspace : public DeviceAPI {
       return;
     }
     cl_command_queue_properties prop = (enable) ? CL_QUEUE_PROFILING_ENABLE : 0;
+    if (use_event_chaining) {
+      prop |= CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+    }
     auto queue = cl::OpenCLWorkspace::Global()->GetQueue(dev);
     OPENCL_CALL(clFlush(queue));
     OPENCL_CALL(clFinish(queue));
@@ -27,6 +27,7 @@
 
 #include <sstream>
 
+#include "../../support/utils.h"
 #include "opencl_common.h"
 
 #ifdef OPENCL_ENABLE_HOST_PTR
@@ -322,40 +323,53 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
   ICHECK(IsContiguous(*from) && IsContiguous(*to))
       << "CopyDataFromTo only support contiguous array for now";
 
+  // In chained mode every copy waits on the previous command and records its
+  // own event, so out-of-order queues keep the program order.
+  cl_event* wait_list = nullptr;
+  cl_uint num_wait = 0;
+  cl_event copy_event = nullptr;
+  cl_event* copy_event_ptr = use_event_chaining ? &copy_event : nullptr;
+
   if (IsOpenCLDevice(from->device) && IsOpenCLDevice(to->device)) {
     const auto* from_desc = static_cast<const cl::BufferDescriptor*>(from->data);
     auto* to_desc = static_cast<cl::BufferDescriptor*>(to->data);
+    num_wait = ChainWaitList(to->device, &wait_list);
     if (to_desc->layout == cl::BufferDescriptor::MemoryLayout::kBuffer1D &&
         from_desc->layout == cl::BufferDescriptor::MemoryLayout::kBuffer1D) {
       OPENCL_CALL(clEnqueueCopyBuffer(this->GetQueue(to->device), from_desc->buffer,
                                       to_desc->buffer, from->byte_offset, to->byte_offset, nbytes,
-                                      0, nullptr, nullptr));
+                                      num_wait, wait_list, copy_event_ptr));
     } else if (to_desc->layout != cl::BufferDescriptor::MemoryLayout::kBuffer1D &&
                from_desc->layout == cl::BufferDescriptor::MemoryLayout::kBuffer1D) {
       auto image_info = GetImageInfo(to_desc, to);
       OPENCL_CALL(clEnqueueCopyBufferToImage(this->GetQueue(to->device), from_desc->buffer,
                                              to_desc->buffer, from->byte_offset, image_info.origin,
-                                             image_info.region, 0, nullptr, nullptr));
+                                             image_info.region, num_wait, wait_list,
+                                             copy_event_ptr));
     } else if (to_desc->layout == cl::BufferDescriptor::MemoryLayout::kBuffer1D &&
                from_desc->layout != cl::BufferDescriptor::MemoryLayout::kBuffer1D) {
       auto image_info = GetImageInfo(from_desc, from);
       OPENCL_CALL(clEnqueueCopyImageToBuffer(this->GetQueue(to->device), from_desc->buffer,
                                              to_desc->buffer, image_info.origin, image_info.region,
-                                             to->byte_offset, 0, nullptr, nullptr));
+                                             to->byte_offset, num_wait, wait_list, copy_event_ptr));
     } else {
       auto to_image_info = GetImageInfo(to_desc, to);
       auto from_image_info = GetImageInfo(from_desc, from);
       OPENCL_CALL(clEnqueueCopyImage(this->GetQueue(to->device), from_desc->buffer, to_desc->buffer,
                                      from_image_info.origin, to_image_info.origin,
-                                     to_image_info.region, 0, nullptr, nullptr));
+                                     to_image_info.region, num_wait, wait_list, copy_event_ptr));
+    }
+    if (use_event_chaining) {
+      ChainPushEvent(to->device, copy_event);
     }
   } else if (IsOpenCLDevice(from->device) && to->device.device_type == kDLCPU) {
     const auto* from_desc = static_cast<const cl::BufferDescriptor*>(from->data);
+    num_wait = ChainWaitList(from->device, &wait_list);
     switch (from_desc->layout) {
       case cl::BufferDescriptor::MemoryLayout::kBuffer1D:
         OPENCL_CALL(clEnqueueReadBuffer(
             this->GetQueue(from->device), from_desc->buffer, CL_FALSE, from->byte_offset, nbytes,
-            static_cast<char*>(to->data) + to->byte_offset, 0, nullptr, nullptr));
+            static_cast<char*>(to->data) + to->byte_offset, num_wait, wait_list, copy_event_ptr));
         break;
       case cl::BufferDescriptor::MemoryLayout::kImage2DActivation:
       case cl::BufferDescriptor::MemoryLayout::kImage2DWeight:
@@ -367,17 +381,24 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
         OPENCL_CALL(clEnqueueReadImage(
             this->GetQueue(from->device), from_desc->buffer, CL_FALSE, image_info.origin,
             image_info.region, image_info.row_pitch, image_info.slice_pitch,
-            static_cast<char*>(to->data) + to->byte_offset, 0, nullptr, nullptr));
+            static_cast<char*>(to->data) + to->byte_offset, num_wait, wait_list, copy_event_ptr));
         break;
     }
-    OPENCL_CALL(clFinish(this->GetQueue(from->device)));
+    if (use_event_chaining) {
+      ChainPushEvent(from->device, copy_event);
+      ChainSync(from->device);
+    } else {
+      OPENCL_CALL(clFinish(this->GetQueue(from->device)));
+    }
   } else if (from->device.device_type == kDLCPU && IsOpenCLDevice(to->device)) {
     auto* to_desc = static_cast<cl::BufferDescriptor*>(to->data);
+    num_wait = ChainWaitList(to->device, &wait_list);
     switch (to_desc->layout) {
       case cl::BufferDescriptor::MemoryLayout::kBuffer1D:
-        OPENCL_CALL(clEnqueueWriteBuffer(
-            this->GetQueue(to->device), to_desc->buffer, CL_FALSE, to->byte_offset, nbytes,
-            static_cast<const char*>(from->data) + from->byte_offset, 0, nullptr, nullptr));
+        OPENCL_CALL(clEnqueueWriteBuffer(this->GetQueue(to->device), to_desc->buffer, CL_FALSE,
+                                         to->byte_offset, nbytes,
+                                         static_cast<const char*>(from->data) + from->byte_offset,
+                                         num_wait, wait_list, copy_event_ptr));
         break;
       case cl::BufferDescriptor::MemoryLayout::kImage2DActivation:
       case cl::BufferDescriptor::MemoryLayout::kImage2DWeight:
@@ -386,10 +407,16 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
         OPENCL_CALL(clEnqueueWriteImage(
             this->GetQueue(to->device), to_desc->buffer, CL_FALSE, image_info.origin,
             image_info.region, image_info.row_pitch, image_info.slice_pitch,
-            static_cast<const char*>(from->data) + from->byte_offset, 0, nullptr, nullptr));
+            static_cast<const char*>(from->data) + from->byte_offset, num_wait, wait_list,
+            copy_event_ptr));
         break;
     }
-    OPENCL_CALL(clFinish(this->GetQueue(to->device)));
+    if (use_event_chaining) {
+      ChainPushEvent(to->device, copy_event);
+      ChainSync(to->device);
+    } else {
+      OPENCL_CALL(clFinish(this->GetQueue(to->device)));
+    }
   } else {
     LOG(FATAL) << "Expect copy from/to OpenCL or between OpenCL";
   }
@@ -398,6 +425,12 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
 void OpenCLWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   this->Init();
   ICHECK(stream == nullptr);
+  if (use_event_chaining) {
+    // Waiting on the chain tail is enough: every command waits on its
+    // predecessor, so tail completion implies the whole chain has completed.
+    ChainSync(dev);
+    return;
+  }
   OPENCL_CALL(clFinish(this->GetQueue(dev)));
 }
 
@@ -535,6 +568,9 @@ void OpenCLWorkspace::Init(const std::string& type_key, const std::string& devic
     return;
   }
   ICHECK_EQ(this->queues.size(), 0U);
+  this->use_event_chaining = support::BoolEnvironmentVar("TVM_OPENCL_EVENT_CHAINING");
+  cl_command_queue_properties queue_props =
+      this->use_event_chaining ? CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE : 0;
   cl_int err_code;
   for (auto& [platform, devices] : device_map) {
     this->platform_ids.push_back(platform);
@@ -544,12 +580,15 @@ void OpenCLWorkspace::Init(const std::string& type_key, const std::string& devic
     for (size_t i = 0; i < devices.size(); ++i) {
       cl_device_id did = devices[i];
       device_to_platform[did] = platform;
-      this->queues.push_back(clCreateCommandQueue(this->contexts[platform], did, 0, &err_code));
+      this->queues.push_back(
+          clCreateCommandQueue(this->contexts[platform], did, queue_props, &err_code));
       OPENCL_CHECK_ERROR(err_code);
     }
     OPENCL_CHECK_ERROR(err_code);
   }
   this->events.resize(this->devices.size());
+  this->chain_tail.resize(this->devices.size(), nullptr);
+  this->chain_ring.resize(this->devices.size());
   initialized_ = true;
 }
 
@@ -80,11 +80,24 @@ class OpenCLWrappedFunc {
     }
     // launch kernel
 
+    cl_event* wait_list = nullptr;
+    cl_uint num_wait = w_->ChainWaitList(t->device, &wait_list);
     if (w_->IsProfiling(t->device)) {
       w_->GetEventQueue(t->device).resize(w_->GetEventQueue(t->device).size() + 1);
+      cl_event* event = &(w_->GetEventQueue(t->device).back());
       OPENCL_CALL(clEnqueueNDRangeKernel(queue, kernel, work_dim, nullptr, wl.work_size,
-                                         wl.work_size + 3, 0, nullptr,
-                                         &(w_->GetEventQueue(t->device).back())));
+                                         wl.work_size + 3, num_wait, wait_list, event));
+      if (w_->use_event_chaining) {
+        // The event queue keeps its reference for the timer; the chain owns one
+        // of its own so retiring the chain cannot invalidate profiling results.
+        OPENCL_CALL(clRetainEvent(*event));
+        w_->ChainPushEvent(t->device, *event);
+      }
+    } else if (w_->use_event_chaining) {
+      cl_event event;
+      OPENCL_CALL(clEnqueueNDRangeKernel(queue, kernel, work_dim, nullptr, wl.work_size,
+                                         wl.work_size + 3, num_wait, wait_list, &event));
+      w_->ChainPushEvent(t->device, event);
     } else {
       OPENCL_CALL(clEnqueueNDRangeKernel(queue, kernel, work_dim, nullptr, wl.work_size,
                                          wl.work_size + 3, 0, nullptr, nullptr));
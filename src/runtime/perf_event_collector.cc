@@ -0,0 +1,259 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file perf_event_collector.cc
+ * \brief A MetricCollector reading Linux perf_event hardware counters per thread.
+ *
+ *  Unlike the PAPI backend this collector has no library dependency: it opens
+ *  perf_event file descriptors directly on every thread of the process,
+ *  including the ThreadPool workers that actually execute parallel kernels, and
+ *  sums the per-thread deltas around each profiled call. Counters are opened
+ *  with the time-enabled/time-running read format, so when the kernel
+ *  multiplexes them against other users (the normal situation on shared
+ *  production hosts) the reported counts are scaled estimates rather than
+ *  dropped, the same correction `perf stat` applies.
+ */
+#if defined(__linux__)
+
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*! \brief The hardware events the collector knows how to open, by report name. */
+static const std::unordered_map<std::string, uint64_t> kKnownEvents = {
+    {"perf::CYCLES", PERF_COUNT_HW_CPU_CYCLES},
+    {"perf::INSTRUCTIONS", PERF_COUNT_HW_INSTRUCTIONS},
+    {"perf::CACHE-MISSES", PERF_COUNT_HW_CACHE_MISSES},
+    {"perf::CACHE-REFERENCES", PERF_COUNT_HW_CACHE_REFERENCES},
+    {"perf::BRANCH-MISSES", PERF_COUNT_HW_BRANCH_MISSES},
+    {"perf::BRANCHES", PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {"perf::STALLED-CYCLES-FRONTEND", PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+    {"perf::STALLED-CYCLES-BACKEND", PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+};
+
+static const std::vector<std::string> kDefaultEvents = {
+    "perf::CYCLES",        "perf::INSTRUCTIONS",
+    "perf::CACHE-MISSES",  "perf::BRANCH-MISSES",
+    "perf::STALLED-CYCLES-FRONTEND", "perf::STALLED-CYCLES-BACKEND",
+};
+
+/*! \brief Counter values at the start of a call, one slot per metric. */
+struct PerfEventCountsNode : public Object {
+  /*! \brief Multiplex-scaled counter sums across all monitored threads. */
+  std::vector<double> start_values;
+
+  explicit PerfEventCountsNode(std::vector<double> start_values)
+      : start_values(std::move(start_values)) {}
+
+  static constexpr const char* _type_key = "PerfEventCountsNode";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PerfEventCountsNode, Object);
+};
+
+struct PerfEventMetricCollectorNode final : public MetricCollectorNode {
+  explicit PerfEventMetricCollectorNode(Array<String> metrics) {
+    for (const String& metric : metrics) {
+      metric_names_.push_back(metric);
+    }
+  }
+  PerfEventMetricCollectorNode() = default;
+
+  void Init(Array<DeviceWrapper> devices) final {
+    bool has_cpu = false;
+    for (auto wrapped_device : devices) {
+      if (wrapped_device->device.device_type == kDLCPU) has_cpu = true;
+    }
+    if (!has_cpu) {
+      LOG(WARNING) << "PerfEventMetricCollector only reads CPU counters, but no CPU device was "
+                      "given; no metrics will be collected";
+      return;
+    }
+    if (metric_names_.empty()) {
+      metric_names_ = kDefaultEvents;
+    }
+    for (const std::string& metric : metric_names_) {
+      CHECK(kKnownEvents.count(metric)) << "ValueError: unknown perf event \"" << metric
+                                        << "\", expect one of " << KnownEventNames();
+    }
+    enabled_ = true;
+  }
+
+  ObjectRef Start(Device dev) final {
+    if (dev.device_type != kDLCPU || !enabled_) {
+      return ObjectRef(nullptr);
+    }
+    if (fds_.empty()) {
+      // Counters are opened lazily at the first profiled call rather than in
+      // Init: the ThreadPool workers that execute parallel kernels are spawned
+      // on first use, typically during the profiler's warmup iterations which
+      // run after Init. The counters follow the threads, not the cores, so CPU
+      // migration does not lose counts.
+      OpenAll();
+      if (fds_.empty()) return ObjectRef(nullptr);
+    }
+    return ObjectRef(make_object<PerfEventCountsNode>(ReadAll()));
+  }
+
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const PerfEventCountsNode* start = obj.as<PerfEventCountsNode>();
+    std::vector<double> end_values = ReadAll();
+    std::unordered_map<String, ObjectRef> reported_metrics;
+    for (size_t i = 0; i < metric_names_.size(); ++i) {
+      double delta = end_values[i] - start->start_values[i];
+      reported_metrics[metric_names_[i]] =
+          ObjectRef(make_object<CountNode>(static_cast<int64_t>(delta < 0 ? 0 : delta)));
+    }
+    return reported_metrics;
+  }
+
+  ~PerfEventMetricCollectorNode() final {
+    for (const auto& counter : fds_) {
+      close(counter.fd);
+    }
+  }
+
+  static constexpr const char* _type_key = "runtime.profiling.PerfEventMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PerfEventMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  struct Counter {
+    int fd;
+    // index into metric_names_ this fd contributes to
+    size_t metric_id;
+  };
+
+  void OpenAll() {
+    std::vector<pid_t> tids = ListProcessThreads();
+    for (size_t i = 0; i < metric_names_.size(); ++i) {
+      uint64_t config = kKnownEvents.at(metric_names_[i]);
+      for (pid_t tid : tids) {
+        int fd = OpenCounter(config, tid);
+        if (fd < 0) {
+          if (!warned_) {
+            LOG(WARNING) << "perf_event_open failed (" << std::strerror(errno)
+                         << "); lower /proc/sys/kernel/perf_event_paranoid to 2 or below to "
+                            "profile without extra privileges. Some counters will be missing.";
+            warned_ = true;
+          }
+          continue;
+        }
+        fds_.push_back({fd, i});
+      }
+    }
+  }
+
+  static std::vector<pid_t> ListProcessThreads() {
+    std::vector<pid_t> tids;
+    DIR* dir = opendir("/proc/self/task");
+    if (dir == nullptr) {
+      tids.push_back(0);  // fall back to the calling thread only
+      return tids;
+    }
+    while (dirent* entry = readdir(dir)) {
+      if (entry->d_name[0] == '.') continue;
+      tids.push_back(static_cast<pid_t>(std::atoi(entry->d_name)));
+    }
+    closedir(dir);
+    return tids;
+  }
+
+  static int OpenCounter(uint64_t config, pid_t tid) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 0;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, /*cpu=*/-1, /*group_fd=*/-1,
+                                    /*flags=*/0));
+  }
+
+  /*! \brief Read all counters, scaling multiplexed ones, and sum per metric. */
+  std::vector<double> ReadAll() const {
+    struct {
+      uint64_t value;
+      uint64_t time_enabled;
+      uint64_t time_running;
+    } sample;
+    std::vector<double> values(metric_names_.size(), 0.0);
+    for (const auto& counter : fds_) {
+      if (read(counter.fd, &sample, sizeof(sample)) != sizeof(sample)) continue;
+      double value = static_cast<double>(sample.value);
+      if (sample.time_running > 0 && sample.time_running < sample.time_enabled) {
+        value *= static_cast<double>(sample.time_enabled) / sample.time_running;
+      }
+      values[counter.metric_id] += value;
+    }
+    return values;
+  }
+
+  static std::string KnownEventNames() {
+    std::string names;
+    for (const auto& kv : kKnownEvents) {
+      if (!names.empty()) names += ", ";
+      names += kv.first;
+    }
+    return names;
+  }
+
+  std::vector<std::string> metric_names_;
+  std::vector<Counter> fds_;
+  bool enabled_{false};
+  bool warned_{false};
+};
+
+/*! \brief Wrapper for `PerfEventMetricCollectorNode`. */
+class PerfEventMetricCollector : public MetricCollector {
+ public:
+  explicit PerfEventMetricCollector(Array<String> metrics) {
+    data_ = make_object<PerfEventMetricCollectorNode>(metrics);
+  }
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PerfEventMetricCollector, MetricCollector,
+                                        PerfEventMetricCollectorNode);
+};
+
+TVM_REGISTER_OBJECT_TYPE(PerfEventCountsNode);
+TVM_REGISTER_OBJECT_TYPE(PerfEventMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.PerfEventMetricCollector")
+    .set_body_typed([](Array<String> metrics) { return PerfEventMetricCollector(metrics); });
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // defined(__linux__)
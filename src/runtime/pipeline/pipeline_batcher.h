@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_RUNTIME_PIPELINE_PIPELINE_BATCHER_H_
+#define TVM_RUNTIME_PIPELINE_PIPELINE_BATCHER_H_
+#include <tvm/runtime/ndarray.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+namespace tvm {
+namespace runtime {
+/*!
+ * \brief A dynamic batching engine for the pipeline executor.
+ *
+ *  The pipeline executor pipelines the stages of one model but runs one
+ *  sample per pipeline invocation. When many independent single-sample
+ *  requests arrive concurrently, the hardware could process them together
+ *  in a single batched invocation. This class coalesces such requests:
+ *  every request carries single-sample inputs (batch dimension 1), and
+ *  committing a request blocks until either `max_batch_size` requests have
+ *  accumulated or `deadline_us` microseconds have passed since the first
+ *  pending request. The committing thread that completes the batch gathers
+ *  the samples into batched tensors along the first axis, runs the
+ *  pipeline once, and scatters the batched outputs back to the per-request
+ *  results.
+ *
+ *  The pipeline has to be built from modules whose global inputs have a
+ *  batch dimension of `max_batch_size`. When the deadline fires with a
+ *  partially filled batch, the unfilled rows are left untouched and their
+ *  output rows are discarded.
+ */
+class PipelineRequestBatcher {
+ public:
+  using SetInputFunction = std::function<void(const std::string&, DLTensor*)>;
+  using RunFunction = std::function<void()>;
+  using GetOutputFunction = std::function<Array<NDArray>()>;
+  /*!
+   * \brief Configure and enable the batching engine.
+   * \param max_batch_size The batch capacity of the pipeline head modules.
+   * \param deadline_us The longest time a pending request waits for the batch to fill.
+   */
+  void Configure(int max_batch_size, int deadline_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ICHECK_GT(max_batch_size, 0) << "ValueError: max_batch_size should be a positive number.";
+    ICHECK_GE(deadline_us, 0) << "ValueError: deadline_us should not be negative.";
+    ICHECK(pending_.empty()) << "The batching config can not change while requests are pending.";
+    max_batch_size_ = max_batch_size;
+    deadline_us_ = deadline_us;
+  }
+  /*! \brief Whether the batching engine is enabled.*/
+  bool Enabled() const { return max_batch_size_ > 0; }
+  /*!
+   * \brief Create a new request.
+   * \return The request id used by the other calls.
+   */
+  int Submit() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int request_id = next_request_id_++;
+    requests_[request_id];
+    return request_id;
+  }
+  /*!
+   * \brief Set one single-sample input of a request.
+   * \param request_id The request id returned by Submit.
+   * \param input_name The global input name.
+   * \param data_in The input data with a batch dimension of 1.
+   */
+  void SetRequestInput(int request_id, const std::string& input_name, DLTensor* data_in) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Request& request = GetRequest(request_id);
+    ICHECK(!request.done) << "Request " << request_id << " has already been executed.";
+    ICHECK(data_in->ndim > 0 && data_in->shape[0] == 1)
+        << "ValueError: batched requests expect single-sample inputs with batch dimension 1.";
+    // The caller owns the incoming buffer, hence the sample gets copied out.
+    std::vector<int64_t> shape(data_in->shape, data_in->shape + data_in->ndim);
+    NDArray sample = NDArray::Empty(shape, data_in->dtype, data_in->device);
+    sample.CopyFrom(data_in);
+    request.inputs[input_name] = sample;
+  }
+  /*!
+   * \brief Commit a request and block until the batch containing it has run.
+   * \param request_id The request id returned by Submit.
+   * \param set_input The function that feeds a batched tensor to the pipeline.
+   * \param run The function that triggers one pipeline execution.
+   * \param get_output The function that polls the pipeline outputs.
+   */
+  void RunRequest(int request_id, const SetInputFunction& set_input, const RunFunction& run,
+                  const GetOutputFunction& get_output) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Request& request = GetRequest(request_id);
+    ICHECK(!request.done) << "Request " << request_id << " has already been executed.";
+    ICHECK(!request.inputs.empty()) << "Request " << request_id << " has no inputs.";
+    if (pending_.empty()) {
+      batch_deadline_ =
+          std::chrono::steady_clock::now() + std::chrono::microseconds(deadline_us_);
+    }
+    request.slot = static_cast<int>(pending_.size());
+    pending_.push_back(request_id);
+    if (static_cast<int>(pending_.size()) >= max_batch_size_) {
+      ExecuteBatch(set_input, run, get_output);
+      cv_.notify_all();
+      return;
+    }
+    while (!request.done) {
+      if (cv_.wait_until(lock, batch_deadline_) == std::cv_status::timeout && !request.done) {
+        // The deadline fired with a partially filled batch; this thread
+        // becomes the one that runs it.
+        ExecuteBatch(set_input, run, get_output);
+        cv_.notify_all();
+        return;
+      }
+    }
+  }
+  /*!
+   * \brief Get one output sample of an executed request.
+   * \param request_id The request id returned by Submit.
+   * \param output_index The global output index.
+   * \return The output sample with a batch dimension of 1.
+   */
+  NDArray GetRequestOutput(int request_id, int output_index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Request& request = GetRequest(request_id);
+    ICHECK(request.done) << "Request " << request_id << " has not been executed yet.";
+    ICHECK_GE(output_index, 0);
+    ICHECK_LT(output_index, static_cast<int>(request.outputs.size()));
+    return request.outputs[output_index];
+  }
+  /*!
+   * \brief Release an executed request and its outputs.
+   * \param request_id The request id returned by Submit.
+   */
+  void Release(int request_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Request& request = GetRequest(request_id);
+    ICHECK(request.done) << "Request " << request_id << " is still pending.";
+    requests_.erase(request_id);
+  }
+
+ private:
+  /*! \brief The state of one in-flight request.*/
+  struct Request {
+    /*! \brief The single-sample inputs of the request.*/
+    std::unordered_map<std::string, NDArray> inputs;
+    /*! \brief The row this request occupies in the batched tensors.*/
+    int slot = -1;
+    /*! \brief The per-request output samples, valid once done.*/
+    std::vector<NDArray> outputs;
+    /*! \brief Whether the batch containing this request has run.*/
+    bool done = false;
+  };
+
+  Request& GetRequest(int request_id) {
+    auto it = requests_.find(request_id);
+    ICHECK(it != requests_.end()) << "Request " << request_id << " does not exist.";
+    return it->second;
+  }
+  /*! \brief Create a view of one row of a compact batched tensor.*/
+  static DLTensor RowView(const NDArray& batched, std::vector<int64_t>* row_shape, int slot) {
+    DLTensor view = *batched.operator->();
+    row_shape->assign(view.shape, view.shape + view.ndim);
+    (*row_shape)[0] = 1;
+    view.shape = row_shape->data();
+    view.strides = nullptr;
+    view.byte_offset += static_cast<uint64_t>(slot) * (GetDataSize(*batched.operator->()) /
+                                                       batched.operator->()->shape[0]);
+    return view;
+  }
+  /*! \brief Gather the pending samples, run the pipeline once and scatter the outputs.*/
+  void ExecuteBatch(const SetInputFunction& set_input, const RunFunction& run,
+                    const GetOutputFunction& get_output) {
+    // Gather each global input of the pending requests into a batched tensor.
+    const Request& first = GetRequest(pending_.front());
+    for (const auto& name_sample : first.inputs) {
+      const std::string& input_name = name_sample.first;
+      const NDArray& sample = name_sample.second;
+      std::vector<int64_t> batched_shape(sample.Shape().begin(), sample.Shape().end());
+      batched_shape[0] = max_batch_size_;
+      NDArray batched = NDArray::Empty(batched_shape, sample->dtype, sample->device);
+      for (int request_id : pending_) {
+        Request& request = GetRequest(request_id);
+        auto it = request.inputs.find(input_name);
+        ICHECK(it != request.inputs.end()) << "Request " << request_id << " misses the input \""
+                                           << input_name << "\" set by the batch peers.";
+        std::vector<int64_t> row_shape;
+        DLTensor row = RowView(batched, &row_shape, request.slot);
+        NDArray::CopyFromTo(it->second.operator->(), &row);
+      }
+      DLTensor* batched_tensor = const_cast<DLTensor*>(batched.operator->());
+      set_input(input_name, batched_tensor);
+    }
+    run();
+    // The pipeline signals completion through the output poll.
+    Array<NDArray> batched_outputs;
+    do {
+      batched_outputs = get_output();
+    } while (batched_outputs.empty());
+    // Scatter the output rows back to the requests; the batched output
+    // arrays are reused by the next pipeline run, hence the copies.
+    for (int request_id : pending_) {
+      Request& request = GetRequest(request_id);
+      for (const NDArray& batched : batched_outputs) {
+        std::vector<int64_t> row_shape;
+        DLTensor row = RowView(batched, &row_shape, request.slot);
+        NDArray output = NDArray::Empty(row_shape, row.dtype, row.device);
+        NDArray::CopyFromTo(&row, const_cast<DLTensor*>(output.operator->()));
+        request.outputs.push_back(output);
+      }
+      request.done = true;
+    }
+    pending_.clear();
+  }
+
+  /*! \brief Guards all the batching state.*/
+  std::mutex mutex_;
+  /*! \brief Wakes up the pending requests when their batch has run.*/
+  std::condition_variable cv_;
+  /*! \brief The committed requests waiting for the current batch to run.*/
+  std::vector<int> pending_;
+  /*! \brief All live requests keyed by request id.*/
+  std::unordered_map<int, Request> requests_;
+  /*! \brief The time at which the current batch runs even if not full.*/
+  std::chrono::steady_clock::time_point batch_deadline_;
+  /*! \brief The batch capacity; zero when batching is disabled.*/
+  int max_batch_size_ = 0;
+  /*! \brief The longest time a pending request waits for the batch to fill.*/
+  int deadline_us_ = 0;
+  /*! \brief The id handed to the next submitted request.*/
+  int next_request_id_ = 0;
+};
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RUNTIME_PIPELINE_PIPELINE_BATCHER_H_
@@ -85,6 +85,31 @@ PackedFunc PipelineExecutor::GetFunction(const String& name,
   } else if (name == "get_execute_count") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetExecutionCount(); });
+  } else if (name == "set_batch_config") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetBatchConfig(args[0], args[1]);
+    });
+  } else if (name == "batch_submit") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->BatchSubmit(); });
+  } else if (name == "batch_set_input") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      if (String::CanConvertFrom(args[1])) {
+        this->BatchSetInput(args[0], args[1].operator String(), args[2]);
+      } else {
+        LOG(FATAL) << "Function only support the input name value in the form of string";
+      }
+    });
+  } else if (name == "batch_run") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->BatchRun(args[0]); });
+  } else if (name == "batch_get_output") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->BatchGetOutput(args[0], args[1]);
+    });
+  } else if (name == "batch_release") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->BatchRelease(args[0]); });
   } else {
     LOG(FATAL) << "Unknown packed function: " << name;
   }
@@ -235,6 +260,57 @@ std::pair<int, int> PipelineExecutor::GetInputIndex(const std::string& name) {
  * \brief Getting the count of running pipeline.
  */
 int PipelineExecutor::GetExecutionCount() { return runtimes_.back()->GetExecutionCount(); }
+/*!
+ * \brief Configure and enable the cross-request batching engine.
+ * \param max_batch_size The batch capacity of the pipeline head modules.
+ * \param deadline_us The longest time a pending request waits for the batch to fill.
+ */
+void PipelineExecutor::SetBatchConfig(int max_batch_size, int deadline_us) {
+  request_batcher_.Configure(max_batch_size, deadline_us);
+}
+/*!
+ * \brief Create a batched request.
+ * \return The request id.
+ */
+int PipelineExecutor::BatchSubmit() {
+  ICHECK(request_batcher_.Enabled()) << "Call set_batch_config before submitting requests.";
+  return request_batcher_.Submit();
+}
+/*!
+ * \brief Set a single-sample input of a batched request.
+ * \param request_id The request id.
+ * \param input_name The global input name.
+ * \param data_in The input data with a batch dimension of 1.
+ */
+void PipelineExecutor::BatchSetInput(int request_id, std::string input_name, DLTensor* data_in) {
+  request_batcher_.SetRequestInput(request_id, input_name, data_in);
+}
+/*!
+ * \brief Commit a batched request and block until its batch has run.
+ * \param request_id The request id.
+ */
+void PipelineExecutor::BatchRun(int request_id) {
+  request_batcher_.RunRequest(
+      request_id,
+      [this](const std::string& input_name, DLTensor* data_in) {
+        this->SetInput(input_name, data_in);
+      },
+      [this]() { this->Run(); }, [this]() { return this->GetOutput(); });
+}
+/*!
+ * \brief Get one output sample of an executed batched request.
+ * \param request_id The request id.
+ * \param output_index The global output index.
+ * \return The output sample.
+ */
+NDArray PipelineExecutor::BatchGetOutput(int request_id, int output_index) {
+  return request_batcher_.GetRequestOutput(request_id, output_index);
+}
+/*!
+ * \brief Release an executed batched request.
+ * \param request_id The request id.
+ */
+void PipelineExecutor::BatchRelease(int request_id) { request_batcher_.Release(request_id); }
 /*!
  * \brief Initialize the pipeline executor with a list of modules to be pipelined
  *  and config in JSON format.
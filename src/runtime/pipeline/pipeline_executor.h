@@ -35,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include "pipeline_batcher.h"
 #include "pipeline_scheduler.h"
 namespace tvm {
 namespace runtime {
@@ -135,6 +136,41 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
    *  return Return a module index and a input index.
    */
   std::pair<int, int> GetInputIndex(const std::string& name);
+  /*!
+   * \brief Configure and enable the cross-request batching engine.
+   * \param max_batch_size The batch capacity of the pipeline head modules.
+   * \param deadline_us The longest time a pending request waits for the batch to fill.
+   */
+  void SetBatchConfig(int max_batch_size, int deadline_us);
+  /*!
+   * \brief Create a batched request.
+   * \return The request id.
+   */
+  int BatchSubmit();
+  /*!
+   * \brief Set a single-sample input of a batched request.
+   * \param request_id The request id.
+   * \param input_name The global input name.
+   * \param data_in The input data with a batch dimension of 1.
+   */
+  void BatchSetInput(int request_id, std::string input_name, DLTensor* data_in);
+  /*!
+   * \brief Commit a batched request and block until its batch has run.
+   * \param request_id The request id.
+   */
+  void BatchRun(int request_id);
+  /*!
+   * \brief Get one output sample of an executed batched request.
+   * \param request_id The request id.
+   * \param output_index The global output index.
+   * \return The output sample.
+   */
+  NDArray BatchGetOutput(int request_id, int output_index);
+  /*!
+   * \brief Release an executed batched request.
+   * \param request_id The request id.
+   */
+  void BatchRelease(int request_id);
   /*!\brief Load the module files information.*/
   ModuleConfig& LoadModuleConfig(dmlc::JSONReader* reader) {
     reader->BeginArray();
@@ -174,6 +210,8 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
  private:
   /*!\brief The class used to execute and schedule the pipeline logic.*/
   PipelineScheduler pipeline_scheduler_;
+  /*!\brief The engine that coalesces concurrent single-sample requests into batches.*/
+  PipelineRequestBatcher request_batcher_;
   /*!\brief The dependency information of each graph runtime module of the pipeline.*/
   ConfigPipelineExecution pipeline_config_;
   /*!\brief The map of global input and subgraph input.*/
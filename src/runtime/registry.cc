@@ -27,6 +27,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -37,14 +38,34 @@ namespace tvm {
 namespace runtime {
 
 struct Registry::Manager {
+  /*!
+   * \brief An immutable copy of fmap published for lock-free lookups.
+   *
+   * The version records which mutation of fmap the copy reflects.
+   */
+  struct Snapshot {
+    uint64_t version;
+    std::unordered_map<String, Registry*> fmap;
+  };
+
   // map storing the functions.
   // We deliberately used raw pointer.
   // This is because PackedFunc can contain callbacks into the host language (Python) and the
   // resource can become invalid because of indeterministic order of destruction and forking.
   // The resources will only be recycled during program exit.
   std::unordered_map<String, Registry*> fmap;
-  // mutex
+  // mutex, guards fmap and snapshot publication
   std::mutex mutex;
+  // Monotonic count of mutations to fmap, bumped under the mutex.
+  std::atomic<uint64_t> version{0};
+  // RCU-style read path: Get() trusts the snapshot as long as its version
+  // matches, so lookups after warmup are two atomic loads plus a hash lookup
+  // with no lock. A stale snapshot is rebuilt lazily under the mutex on the
+  // next lookup; the previous copy is deliberately leaked (like the registry
+  // entries themselves) because concurrent readers may still be inside it.
+  // Registrations happen in bursts at startup, so in practice only a handful
+  // of rebuilds ever occur.
+  std::atomic<const Snapshot*> snapshot{nullptr};
 
   Manager() {}
 
@@ -72,6 +93,7 @@ Registry& Registry::Register(const String& name, bool can_override) {  // NOLINT
   Registry* r = new Registry();
   r->name_ = name;
   m->fmap[name] = r;
+  m->version.fetch_add(1, std::memory_order_release);
   return *r;
 }
 
@@ -81,14 +103,31 @@ bool Registry::Remove(const String& name) {
   auto it = m->fmap.find(name);
   if (it == m->fmap.end()) return false;
   m->fmap.erase(it);
+  m->version.fetch_add(1, std::memory_order_release);
   return true;
 }
 
 const PackedFunc* Registry::Get(const String& name) {
   Manager* m = Manager::Global();
+  // Fast path: a snapshot whose version matches reflects every completed
+  // registration and removal, so both hits and misses can be answered
+  // without taking the mutex.
+  uint64_t version = m->version.load(std::memory_order_acquire);
+  const Manager::Snapshot* snapshot = m->snapshot.load(std::memory_order_acquire);
+  if (snapshot != nullptr && snapshot->version == version) {
+    auto it = snapshot->fmap.find(name);
+    if (it == snapshot->fmap.end()) return nullptr;
+    return &(it->second->func_);
+  }
+  // Slow path: the snapshot is stale or absent; rebuild it under the mutex.
   std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
+  auto* fresh = new Manager::Snapshot();
+  fresh->version = m->version.load(std::memory_order_relaxed);
+  fresh->fmap = m->fmap;
+  // The replaced snapshot is deliberately leaked, see Manager.
+  m->snapshot.store(fresh, std::memory_order_release);
+  auto it = fresh->fmap.find(name);
+  if (it == fresh->fmap.end()) return nullptr;
   return &(it->second->func_);
 }
 
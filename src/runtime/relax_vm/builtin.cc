@@ -32,6 +32,9 @@
 #include <tvm/runtime/relax_vm/bytecode.h>
 #include <tvm/runtime/relax_vm/vm.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "../runtime_base.h"
 
 namespace tvm {
@@ -181,6 +184,50 @@ int64_t MakePrimValue(DLTensor* heap, int shape_code, int64_t reg) {
 
 TVM_REGISTER_GLOBAL("vm.builtin.make_prim_value").set_body_typed(MakePrimValue);
 
+/*!
+ * \brief A small cache of the shapes recently returned by MakeShape.
+ *
+ * Dynamic-shape decode loops resolve the same shape signatures step after
+ * step; memoizing the resolved ShapeTuple lets repeated steps reuse the
+ * existing container instead of allocating a fresh one per call. The cache
+ * is thread-local because the builtins are free packed functions that do
+ * not receive the VM handle.
+ */
+class MakeShapeCache {
+ public:
+  static MakeShapeCache* ThreadLocal() {
+    static thread_local MakeShapeCache inst;
+    return &inst;
+  }
+
+  /*!
+   * \brief Find a cached shape equal to the resolved values, or make and
+   *  remember one.
+   */
+  ShapeTuple GetOrMake(const std::vector<int64_t>& values) {
+    for (const ShapeTuple& entry : entries_) {
+      if (entry.size() == values.size() &&
+          std::equal(entry.begin(), entry.end(), values.begin())) {
+        return entry;
+      }
+    }
+    ShapeTuple shape(values);
+    if (entries_.size() < kCacheSize) {
+      entries_.push_back(shape);
+    } else {
+      entries_[next_victim_] = shape;
+      next_victim_ = (next_victim_ + 1) % kCacheSize;
+    }
+    return shape;
+  }
+
+ private:
+  /*! \brief The number of shapes remembered; replacement is round-robin. */
+  static constexpr size_t kCacheSize = 16;
+  std::vector<ShapeTuple> entries_;
+  size_t next_victim_ = 0;
+};
+
 /*!
  * \brief Builtin make shape function.
  * \param args The packed function arguments.
@@ -207,7 +254,7 @@ void MakeShape(TVMArgs args, TVMRetValue* rv) {
       shape[i] = heap_data[reg];
     }
   }
-  *rv = ShapeTuple(std::move(shape));
+  *rv = MakeShapeCache::ThreadLocal()->GetOrMake(shape);
 }
 
 TVM_REGISTER_GLOBAL("vm.builtin.make_shape").set_body(MakeShape);
@@ -350,6 +397,18 @@ Storage VMAllocStorage(void* ctx_ptr, ShapeTuple buffer_shape, Index device_inde
   auto* alloc = vm->allocators[device_index];
   ICHECK(alloc) << "Did you forget to init the VirtualMachine with devices?";
 
+  if (mem_scope == "global.pinned_host") {
+    // A storage spilled by StaticPlanBlockMemory under a device memory budget.
+    // Place it in the pinned-host counterpart of the device, where the data
+    // stays addressable by the device through unified addressing, and let the
+    // host-side allocator own the buffer so the device allocator's caches are
+    // not polluted with host pages.
+    Device host_dev = MemoryManager::GetPinnedHostDevice(vm->devices[device_index]);
+    auto* host_alloc = MemoryManager::GetOrCreateAllocator(host_dev, alloc->type());
+    auto buffer = host_alloc->Alloc(host_dev, buffer_shape, dtype_hint, "global");
+    return Storage(buffer, host_alloc);
+  }
+
   auto buffer = alloc->Alloc(vm->devices[device_index], buffer_shape, dtype_hint, mem_scope);
 
   return Storage(buffer, alloc);
@@ -67,6 +67,32 @@ struct CUDAGraphCaptureKeyEqual {
   }
 };
 
+/*!
+ * \brief Key of a full-function capture: the function name plus the shape
+ * signature of its tensor and shape arguments. Calls with a different
+ * signature are captured as separate graph versions.
+ */
+struct CUDAGraphInvokeKey {
+  std::string func_name;
+  std::vector<int64_t> signature;
+};
+
+struct CUDAGraphInvokeKeyHash {
+  size_t operator()(const CUDAGraphInvokeKey& key) const {
+    size_t hash = std::hash<std::string>()(key.func_name);
+    for (int64_t value : key.signature) {
+      support::HashCombine(hash, std::hash<int64_t>()(value));
+    }
+    return hash;
+  }
+};
+
+struct CUDAGraphInvokeKeyEqual {
+  bool operator()(const CUDAGraphInvokeKey& lhs, const CUDAGraphInvokeKey& rhs) const {
+    return lhs.func_name == rhs.func_name && lhs.signature == rhs.signature;
+  }
+};
+
 /*! \brief The captured state of a CUDA graph */
 struct CUDAGraphCapturedState {
   CUDAGraphCapturedState() {}
@@ -96,6 +122,35 @@ struct CUDAGraphCapturedState {
   cudaGraphExec_t exec = nullptr;
 };
 
+/*! \brief The captured state of a full VM function invocation */
+struct CUDAGraphCapturedInvoke {
+  CUDAGraphCapturedInvoke() {}
+
+  CUDAGraphCapturedInvoke(const CUDAGraphCapturedInvoke&) = delete;
+  CUDAGraphCapturedInvoke(CUDAGraphCapturedInvoke&& other) { *this = std::move(other); }
+
+  CUDAGraphCapturedInvoke& operator=(const CUDAGraphCapturedInvoke&) = delete;
+  CUDAGraphCapturedInvoke& operator=(CUDAGraphCapturedInvoke&& other) {
+    std::swap(inputs, other.inputs);
+    std::swap(states, other.states);
+    std::swap(exec, other.exec);
+    return *this;
+  }
+
+  ~CUDAGraphCapturedInvoke() {
+    if (exec) {
+      CUDA_CALL(cudaGraphExecDestroy(exec));
+    }
+  }
+
+  /*! \brief Stable input tensors whose addresses are baked into the graph */
+  Array<NDArray> inputs;
+  /*! \brief The return value of the captured invocation */
+  ObjectRef states;
+  /*! \brief The instantiated cuda graph */
+  cudaGraphExec_t exec = nullptr;
+};
+
 class ScopedCUDAStream {
  public:
   ScopedCUDAStream() { CUDA_CALL(cudaStreamCreate(&stream_)); }
@@ -196,6 +251,85 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
     return states;
   }
 
+  /*!
+   * \brief Capture an entire VM function invocation as a CUDA graph, replaying the
+   * instantiated graph on subsequent calls with the same shape signature.
+   *
+   * Unlike RunOrCapture, which covers compiler-selected regions, this records every
+   * kernel launched by the closure, eliminating per-instruction PackedFunc dispatch
+   * for fully static call sequences such as token-decode loops. Since device
+   * addresses are baked into the graph, tensor arguments are staged into buffers
+   * owned by the cache and refreshed with a device-to-device copy on replay.
+   * The closure must be safe to capture: no stream synchronization and no
+   * data-dependent host logic.
+   *
+   * \param vm The virtual machine.
+   * \param closure The VM closure to invoke.
+   * \param func_name The name of the closure, used as part of the cache key.
+   * \param func_args The arguments of the invocation.
+   * \return The return value of the captured invocation.
+   */
+  ObjectRef RunOrCaptureInvoke(VirtualMachine* vm, const ObjectRef& closure,
+                               const String& func_name, TVMArgs func_args) {
+    CUDAGraphInvokeKey key = MakeInvokeKey(func_name, func_args);
+    if (auto it = invoke_cache_.find(key); it != invoke_cache_.end()) {
+      CUDAGraphCapturedInvoke& entry = it->second;
+      // Refresh the staged inputs: kernel argument pointers are baked into the
+      // captured graph, so new data has to land in the captured buffers.
+      size_t input_idx = 0;
+      for (int i = 0; i < func_args.size(); ++i) {
+        if (func_args[i].type_code() == kTVMNDArrayHandle) {
+          NDArray arg = func_args[i];
+          NDArray staged = entry.inputs[input_idx++];
+          if (arg->data != staged->data) {
+            staged.CopyFrom(arg);
+          }
+        }
+      }
+      CUDA_CALL(cudaGraphLaunch(entry.exec, CUDAThreadEntry::ThreadLocal()->stream));
+      return entry.states;
+    }
+
+    // Stage tensor arguments into stable buffers owned by the cache entry.
+    int nargs = func_args.size();
+    std::vector<TVMValue> values(nargs);
+    std::vector<int> tcodes(nargs);
+    TVMArgsSetter setter(values.data(), tcodes.data());
+    Array<NDArray> inputs;
+    for (int i = 0; i < nargs; ++i) {
+      if (func_args[i].type_code() == kTVMNDArrayHandle) {
+        NDArray arg = func_args[i];
+        NDArray staged = NDArray::Empty(arg.Shape(), arg->dtype, arg->device);
+        staged.CopyFrom(arg);
+        inputs.push_back(staged);
+        setter(i, inputs.back());
+      } else {
+        setter(i, func_args[i]);
+      }
+    }
+    TVMArgs staged_args(values.data(), tcodes.data(), nargs);
+
+    TVMRetValue invoke_rv;
+    // Warm up run to finish lazy initialization such as module loading.
+    vm->InvokeClosurePacked(closure, staged_args, &invoke_rv);
+
+    cudaGraph_t graph;
+    {
+      CUDACaptureStream capture_stream(&graph);
+      vm->InvokeClosurePacked(closure, staged_args, &invoke_rv);
+    }
+
+    CUDAGraphCapturedInvoke entry;
+    entry.inputs = std::move(inputs);
+    entry.states = invoke_rv;
+    CUDA_CALL(cudaGraphInstantiate(&entry.exec, graph, NULL, NULL, 0));
+    CUDA_CALL(cudaGraphDestroy(graph));
+
+    ObjectRef states = entry.states;
+    invoke_cache_[key] = std::move(entry);
+    return states;
+  }
+
   /*!
    * \brief Get the cached allocation from the cache or run the allocation function.
    * \param vm The virtual machine.
@@ -218,6 +352,30 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
   static constexpr const char* _type_key = "relax_vm.CUDAGraphExtension";
 
  private:
+  /*! \brief Build the cache key from the function name and the argument shape signature. */
+  static CUDAGraphInvokeKey MakeInvokeKey(const String& func_name, TVMArgs func_args) {
+    CUDAGraphInvokeKey key;
+    key.func_name = func_name;
+    for (int i = 0; i < func_args.size(); ++i) {
+      if (func_args[i].type_code() == kTVMNDArrayHandle) {
+        NDArray arg = func_args[i];
+        key.signature.push_back(arg->ndim);
+        for (int64_t dim : arg.Shape()) {
+          key.signature.push_back(dim);
+        }
+      } else if (func_args[i].type_code() == kDLInt) {
+        key.signature.push_back(func_args[i].operator int64_t());
+      } else if (func_args[i].IsObjectRef<ShapeTuple>()) {
+        ShapeTuple shape = func_args[i].AsObjectRef<ShapeTuple>();
+        key.signature.push_back(shape.size());
+        for (int64_t dim : shape) {
+          key.signature.push_back(dim);
+        }
+      }
+    }
+    return key;
+  }
+
   /*!
    * \brief The cache of captured cuda graphs. The key is a unique index for the capture function.
    * The value is the result of the capture.
@@ -230,6 +388,13 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
    * The value is the cached allocations, which is a tuple of storages.
    */
   std::unordered_map<int64_t, ObjectRef> alloc_cache_;
+  /*!
+   * \brief The cache of fully captured invocations, keyed by function name and
+   * argument shape signature.
+   */
+  std::unordered_map<CUDAGraphInvokeKey, CUDAGraphCapturedInvoke, CUDAGraphInvokeKeyHash,
+                     CUDAGraphInvokeKeyEqual>
+      invoke_cache_;
 };
 
 /*! Managed reference to CUDAGraphExtensionNode */
@@ -257,6 +422,17 @@ TVM_REGISTER_GLOBAL("vm.builtin.cuda_graph.run_or_capture")
       *rv = extension->RunOrCapture(vm, capture_func, func_args, entry_index, shape_expr);
     });
 
+TVM_REGISTER_GLOBAL("vm.builtin.cuda_graph.run_or_capture_invoke")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_GE(args.size(), 3);
+      VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
+      auto extension = vm->GetOrCreateExtension<CUDAGraphExtension>();
+      ObjectRef closure = args[1];
+      String func_name = args[2];
+      TVMArgs func_args(args.values + 3, args.type_codes + 3, args.size() - 3);
+      *rv = extension->RunOrCaptureInvoke(vm, closure, func_name, func_args);
+    });
+
 TVM_REGISTER_GLOBAL("vm.builtin.cuda_graph.get_cached_alloc")
     .set_body([](TVMArgs args, TVMRetValue* rv) {
       ICHECK_EQ(args.size(), 3);
@@ -26,6 +26,7 @@
 #include <tvm/runtime/relax_vm/executable.h>
 #include <tvm/runtime/relax_vm/vm.h>
 
+#include <algorithm>
 #include <functional>
 #include <sstream>
 
@@ -173,11 +174,56 @@ void LoadHeader(dmlc::Stream* strm) {
   STREAM_CHECK(version == RELAX_VM_VERSION, "version");
 }
 
+void Executable::CompactRegisterFile() {
+  for (VMFuncInfo& finfo : func_table) {
+    if (finfo.kind != VMFuncInfo::FuncKind::kVMFunc) continue;
+    Index max_reg = -1;
+    auto update = [&max_reg](RegName reg) {
+      if (reg < Instruction::kBeginSpecialReg) {
+        max_reg = std::max(max_reg, static_cast<Index>(reg));
+      }
+    };
+    for (Index pc = finfo.start_instr; pc < finfo.end_instr; ++pc) {
+      Instruction instr = GetInstruction(pc);
+      switch (instr.op) {
+        case Opcode::Call: {
+          update(instr.dst);
+          for (Index i = 0; i < instr.num_args; ++i) {
+            if (instr.args[i].kind() == Instruction::ArgKind::kRegister) {
+              update(instr.args[i].value());
+            }
+          }
+          break;
+        }
+        case Opcode::Ret: {
+          update(instr.result);
+          break;
+        }
+        case Opcode::If: {
+          update(instr.cond);
+          break;
+        }
+        case Opcode::Goto: {
+          break;
+        }
+      }
+    }
+    // frames always reserve one register beyond the arguments
+    Index required = std::max<Index>(max_reg + 1, finfo.num_args + 1);
+    if (required < finfo.register_file_size) {
+      finfo.register_file_size = required;
+    }
+  }
+}
+
 void Executable::SaveToBinary(dmlc::Stream* stream) {
   std::string code;
   // Initialize the stream object.
   dmlc::MemoryStringStream strm(&code);
 
+  // Compact register files so deserialized frames are minimal.
+  CompactRegisterFile();
+
   // Save header
   SaveHeader(&strm);
 
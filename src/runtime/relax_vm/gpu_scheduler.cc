@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/relax_vm/gpu_scheduler.cc
+ * \brief A cooperative scheduler arbitrating a shared device between VMs.
+ */
+#include "gpu_scheduler.h"
+
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+namespace tvm {
+namespace runtime {
+namespace relax_vm {
+
+CooperativeGpuScheduler* CooperativeGpuScheduler::Global() {
+  // NOTE: explicitly use new to avoid exit-time destruction of global state
+  // Global state will be recycled by OS as the process exits.
+  static auto* inst = new CooperativeGpuScheduler();
+  return inst;
+}
+
+bool CooperativeGpuScheduler::HasHigherPriorityActive(int priority) const {
+  auto it = active_.upper_bound(priority);
+  for (; it != active_.end(); ++it) {
+    if (it->second > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CooperativeGpuScheduler::Enter(int priority) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [&]() { return !HasHigherPriorityActive(priority); });
+  ++active_[priority];
+}
+
+void CooperativeGpuScheduler::Exit(int priority) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = active_.find(priority);
+    ICHECK(it != active_.end() && it->second > 0)
+        << "Exit of priority " << priority << " does not match a previous Enter.";
+    --it->second;
+  }
+  cv_.notify_all();
+}
+
+void CooperativeGpuScheduler::PreemptionPoint(int priority) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!HasHigherPriorityActive(priority)) {
+    return;
+  }
+  cv_.wait(lock, [&]() { return !HasHigherPriorityActive(priority); });
+}
+
+int CooperativeGpuScheduler::NumActive(int priority) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = active_.find(priority);
+  return it == active_.end() ? 0 : it->second;
+}
+
+TVM_REGISTER_GLOBAL("vm.builtin.gpu_scheduler_num_active").set_body_typed([](int priority) {
+  return CooperativeGpuScheduler::Global()->NumActive(priority);
+});
+
+}  // namespace relax_vm
+}  // namespace runtime
+}  // namespace tvm
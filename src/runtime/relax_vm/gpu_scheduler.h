@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/relax_vm/gpu_scheduler.h
+ * \brief A cooperative scheduler arbitrating a shared device between VMs.
+ */
+#ifndef TVM_RUNTIME_RELAX_VM_GPU_SCHEDULER_H_
+#define TVM_RUNTIME_RELAX_VM_GPU_SCHEDULER_H_
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+namespace tvm {
+namespace runtime {
+namespace relax_vm {
+
+/*!
+ * \brief A process-global cooperative scheduler that arbitrates a shared
+ * device between multiple VirtualMachine instances of different priorities.
+ *
+ * Each participating VM registers a scheduling priority (higher value means
+ * more latency-critical). An invocation of a VM function enters the scheduler
+ * before executing bytecode and exits when the invocation returns. Between
+ * bytecode instructions the VM dispatch loop calls PreemptionPoint, which
+ * blocks while an invocation of a strictly higher priority is active, so a
+ * batch workload stops launching new kernels as soon as a latency-critical
+ * invocation starts and resumes once it finishes. Kernels already queued on
+ * the device stream keep draining; the scheduler only throttles launches,
+ * which keeps it deadlock-free (waiting is only ever on strictly higher
+ * priorities).
+ */
+class CooperativeGpuScheduler {
+ public:
+  static CooperativeGpuScheduler* Global();
+
+  /*!
+   * \brief Mark the start of a VM invocation with the given priority.
+   * Blocks until no invocation of a strictly higher priority is active.
+   * \param priority The priority of the invocation.
+   */
+  void Enter(int priority);
+
+  /*!
+   * \brief Mark the end of a VM invocation with the given priority,
+   * waking up lower-priority invocations waiting at preemption points.
+   * \param priority The priority the invocation was entered with.
+   */
+  void Exit(int priority);
+
+  /*!
+   * \brief A preemption point between bytecode instructions: blocks while
+   * an invocation of a strictly higher priority is active.
+   * \param priority The priority of the running invocation.
+   */
+  void PreemptionPoint(int priority);
+
+  /*!
+   * \brief The number of currently active invocations of the given priority.
+   * \param priority The priority to query.
+   * \return The number of active invocations.
+   */
+  int NumActive(int priority);
+
+ private:
+  CooperativeGpuScheduler() = default;
+
+  /*! \brief Whether an invocation with priority higher than the given one is active. */
+  bool HasHigherPriorityActive(int priority) const;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  /*! \brief The number of active invocations per priority. */
+  std::map<int, int> active_;
+};
+
+}  // namespace relax_vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_RELAX_VM_GPU_SCHEDULER_H_
@@ -39,6 +39,12 @@ TVM_REGISTER_GLOBAL("vm.builtin.kv_state_remove_sequence")
 TVM_REGISTER_GLOBAL("vm.builtin.kv_state_fork_sequence")
     .set_body_method<KVState>(&KVStateObj::ForkSequence);
 TVM_REGISTER_GLOBAL("vm.builtin.kv_state_popn").set_body_method<KVState>(&KVStateObj::PopN);
+TVM_REGISTER_GLOBAL("vm.builtin.kv_state_add_sequences")
+    .set_body_method<KVState>(&KVStateObj::AddSequences);
+TVM_REGISTER_GLOBAL("vm.builtin.kv_state_remove_sequences")
+    .set_body_method<KVState>(&KVStateObj::RemoveSequences);
+TVM_REGISTER_GLOBAL("vm.builtin.kv_state_popn_batch")
+    .set_body_method<KVState>(&KVStateObj::PopNBatch);
 TVM_REGISTER_GLOBAL("vm.builtin.kv_state_begin_forward")
     .set_body([](TVMArgs args, TVMRetValue* rv) {
       CHECK(args.size() == 3 || args.size() == 4)
@@ -58,8 +64,16 @@ TVM_REGISTER_GLOBAL("vm.builtin.kv_state_end_forward")
 // Attention KV Cache methods
 TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_enable_sliding_window_for_seq")
     .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::EnableSlidingWindowForSeq);
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_enable_heavy_hitter_retention_for_seq")
+    .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::EnableHeavyHitterRetentionForSeq);
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_commit_accumulated_attn_scores_for_seq")
+    .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::CommitAccumulatedAttnScoresForSeq);
 TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_commit_accepted_token_tree_nodes")
     .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::CommitAcceptedTokenTreeNodes);
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_swap_out_sequence")
+    .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::SwapOutSequence);
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_swap_in_sequence")
+    .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::SwapInSequence);
 TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_empty")
     .set_body_method<AttentionKVCache>(&AttentionKVCacheObj::Empty);
 TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_get_num_available_pages")
@@ -75,6 +75,51 @@ class KVStateObj : public Object {
    */
   virtual void PopN(int64_t seq_id, int32_t n) = 0;
 
+  /************** Batched Sequence Management **************/
+  //
+  // The batched variants apply all sequence mutations of one scheduling step
+  // in a single call. They are semantically equivalent to looping over the
+  // per-sequence methods, but save one packed-function crossing per sequence,
+  // and all resulting page-table mutations are committed to the device
+  // together in the next BeginForward's fused auxiliary upload. Continuous
+  // batching servers with hundreds of concurrent sequences should prefer them.
+
+  /*!
+   * \brief Add a batch of new sequences with empty K/V state in one call.
+   * \param seq_ids The ids of the sequences to add.
+   * \throws Error if any of the given sequence ids is not valid.
+   */
+  virtual void AddSequences(const IntTuple& seq_ids) {
+    for (int64_t seq_id : seq_ids) {
+      AddSequence(seq_id);
+    }
+  }
+
+  /*!
+   * \brief Remove a batch of sequences and their K/V state in one call.
+   * \param seq_ids The ids of the sequences to remove.
+   * \throws Error if any of the given sequence ids is not valid.
+   */
+  virtual void RemoveSequences(const IntTuple& seq_ids) {
+    for (int64_t seq_id : seq_ids) {
+      RemoveSequence(seq_id);
+    }
+  }
+
+  /*!
+   * \brief Pop trailing tokens from a batch of sequences in one call.
+   * \param seq_ids The ids of the sequences to pop from.
+   * \param ns The number of tokens to pop for each sequence.
+   * \throws Error if the given sequence ids are not valid.
+   */
+  virtual void PopNBatch(const IntTuple& seq_ids, const IntTuple& ns) {
+    CHECK_EQ(seq_ids.size(), ns.size())
+        << "The sequence ids and the numbers of tokens to pop must have the same length.";
+    for (size_t i = 0; i < seq_ids.size(); ++i) {
+      PopN(seq_ids[i], ns[i]);
+    }
+  }
+
   /*!
    * \brief Mark the start of the forward function with the ids of
    * the sequences and the sequence length to forward for each
@@ -146,6 +191,37 @@ class AttentionKVCacheObj : public KVStateObj {
   virtual void EnableSlidingWindowForSeq(int64_t seq_id, int32_t sliding_window_size,
                                          int32_t attn_sink_size) = 0;
 
+  /*!
+   * \brief Enable heavy-hitter retention for the given sequence, composed on
+   * top of the attention-sink + sliding-window eviction policy.
+   * The sequence slides as a sliding-window sequence, but pages about to be
+   * evicted whose accumulated attention mass (see
+   * CommitAccumulatedAttnScoresForSeq) is at least `promote_threshold` times
+   * the average page mass are pinned into the attention sink region instead
+   * of being freed, until the sink region reaches `max_sink_size` tokens.
+   * \param seq_id The id of the sequence to enable heavy-hitter retention for.
+   * \param sliding_window_size The sliding window size for the sequence.
+   * \param attn_sink_size The initial attention sink size for the sequence.
+   * \param max_sink_size The token upper bound the sink region may grow to.
+   * \param promote_threshold The promotion threshold over the average page mass.
+   */
+  virtual void EnableHeavyHitterRetentionForSeq(int64_t seq_id, int32_t sliding_window_size,
+                                                int32_t attn_sink_size, int32_t max_sink_size,
+                                                double promote_threshold) {
+    LOG(FATAL) << "EnableHeavyHitterRetentionForSeq is not supported by this KV cache.";
+  }
+
+  /*!
+   * \brief Accumulate per-page attention mass for the given sequence,
+   * driving heavy-hitter retention.
+   * \param seq_id The id of the sequence to commit the scores for.
+   * \param scores A host 1-D fp32/fp64 array with one accumulated score per
+   * page of the last block of the sequence.
+   */
+  virtual void CommitAccumulatedAttnScoresForSeq(int64_t seq_id, NDArray scores) {
+    LOG(FATAL) << "CommitAccumulatedAttnScoresForSeq is not supported by this KV cache.";
+  }
+
   /*!
    * \brief Committed the accepted token tree nodes to KV cache.
    * The commit will update the KV cache, by compacting the KV data and discard
@@ -157,6 +233,31 @@ class AttentionKVCacheObj : public KVStateObj {
   virtual void CommitAcceptedTokenTreeNodes(const IntTuple& seq_ids,
                                             const IntTuple& leaf_indices) = 0;
 
+  /*!
+   * \brief Migrate the K/V data of a sequence to host memory, releasing its
+   * device pages. The sequence keeps its id and can later be restored with
+   * SwapInSequence, so a scheduler can preempt long sequences under memory
+   * pressure without recomputing their prefill.
+   * Implementations may reject sequences whose K/V data is shared with
+   * other sequences.
+   * \param seq_id The id of the sequence to swap out.
+   * \throws Error if the given sequence id is not valid or cannot be swapped.
+   */
+  virtual void SwapOutSequence(int64_t seq_id) {
+    LOG(FATAL) << "SwapOutSequence is not supported by this KV cache.";
+  }
+
+  /*!
+   * \brief Restore a sequence previously swapped out with SwapOutSequence,
+   * copying its K/V data back into freshly allocated device pages.
+   * \param seq_id The id of the sequence to swap in.
+   * \throws Error if the sequence has not been swapped out, or the cache
+   * does not have enough free pages to hold it.
+   */
+  virtual void SwapInSequence(int64_t seq_id) {
+    LOG(FATAL) << "SwapInSequence is not supported by this KV cache.";
+  }
+
   /************** Attention **************/
 
   /*!
@@ -39,14 +39,23 @@
 #define __STDC_FORMAT_MACROS
 #endif
 #include <picojson.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/relax_vm/ndarray_cache_support.h>
+#include <tvm/runtime/threading_backend.h>
 
+#ifdef TVM_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstdint>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../../support/utils.h"
+#include "../dtype_convert.h"
 #include "../file_utils.h"
 
 namespace tvm {
@@ -64,6 +73,13 @@ inline ValueType GetValue(const picojson::object& json, const std::string& key)
   return AsType<ValueType>(json.at(key));
 }
 
+template <typename ValueType>
+inline ValueType GetValueOr(const picojson::object& json, const std::string& key,
+                            ValueType default_value) {
+  auto it = json.find(key);
+  return it == json.end() ? default_value : AsType<ValueType>(it->second);
+}
+
 NDArrayCacheMetadata::FileRecord::ParamRecord JSONAsParamRecord(const picojson::object& json) {
   std::vector<ShapeTuple::index_type> shape;
   {
@@ -80,6 +96,7 @@ NDArrayCacheMetadata::FileRecord::ParamRecord JSONAsParamRecord(const picojson::
   result.format = GetValue<std::string>(json, "format");
   result.nbytes = GetValue<int64_t>(json, "nbytes");
   result.byte_offset = GetValue<int64_t>(json, "byteOffset");
+  result.encoded_nbytes = GetValueOr<int64_t>(json, "encodedNbytes", 0);
   result.shape = ShapeTuple(std::move(shape));
   return result;
 }
@@ -90,6 +107,7 @@ NDArrayCacheMetadata::FileRecord JSONAsFileRecord(const picojson::object& json)
   result.data_path = GetValue<std::string>(json, "dataPath");
   result.format = GetValue<std::string>(json, "format");
   result.nbytes = GetValue<int64_t>(json, "nbytes");
+  result.dict_nbytes = GetValueOr<int64_t>(json, "dictNbytes", 0);
   result.records.reserve(records.size());
   for (const picojson::value& item : records) {
     result.records.push_back(JSONAsParamRecord(AsType<picojson::object>(item)));
@@ -169,38 +187,153 @@ NDArray NDArrayCacheMetadata::FileRecord::ParamRecord::Load(
     Device device, const std::string* raw_data, Optional<NDArray>* staging_buffer) const {
   NDArray arr = NDArray::Empty(shape, dtype, device);
   if (dtype == DataType::Float(32) && format == "f32-to-bf16") {
-    // decode bf16 to f32
-    std::vector<uint16_t> buffer(nbytes / 2);
-    std::vector<uint32_t> decoded(nbytes / 2);
-    std::memcpy(buffer.data(), raw_data->data() + byte_offset, nbytes);
-    for (size_t i = 0; i < buffer.size(); ++i) {
-      decoded[i] = static_cast<uint32_t>(buffer[i]) << 16;
-    }
-    CopyNDArrayFromBytes(arr, decoded.data(), decoded.size() * sizeof(uint32_t), staging_buffer);
+    // decode bf16 to f32; the batched kernel reads the raw bytes in place
+    std::vector<float> decoded(nbytes / 2);
+    BF16ToFP32(raw_data->data() + byte_offset, decoded.data(), decoded.size());
+    CopyNDArrayFromBytes(arr, decoded.data(), decoded.size() * sizeof(float), staging_buffer);
   } else {
     CopyNDArrayFromBytes(arr, raw_data->data() + byte_offset, nbytes, staging_buffer);
   }
   return arr;
 }
 
+NDArray NDArrayCacheMetadata::FileRecord::ParamRecord::LoadZeroCopy(
+    Device device, const char* data_base, std::shared_ptr<void> owner) const {
+  const char* data_ptr = data_base + byte_offset;
+  if (dtype == DataType::Float(32) && format == "f32-to-bf16") {
+    // dtype conversion requires a real copy, decode bf16 to f32
+    NDArray arr = NDArray::Empty(shape, dtype, device);
+    std::vector<float> decoded(nbytes / 2);
+    BF16ToFP32(data_ptr, decoded.data(), decoded.size());
+    CopyNDArrayFromBytes(arr, decoded.data(), decoded.size() * sizeof(float), nullptr);
+    return arr;
+  }
+  if (device.device_type != kDLCPU ||
+      reinterpret_cast<uintptr_t>(data_ptr) % kAllocAlignment != 0) {
+    // non-CPU devices and insufficiently aligned records still need a copy
+    NDArray arr = NDArray::Empty(shape, dtype, device);
+    arr.CopyFromBytes(data_ptr, nbytes);
+    return arr;
+  }
+  NDArray::Container* container =
+      new NDArray::Container(const_cast<char*>(data_ptr), shape, dtype, device);
+  container->manager_ctx = new std::shared_ptr<void>(std::move(owner));
+  container->SetDeleter([](Object* obj) {
+    auto* ptr = static_cast<NDArray::Container*>(obj);
+    delete static_cast<std::shared_ptr<void>*>(ptr->manager_ctx);
+    delete ptr;
+  });
+  return NDArray(GetObjectPtr<Object>(container));
+}
+
 TVM_DLL Array<NDArray> NDArrayCacheMetadata::FileRecord::Load(
     Device device,
     const std::string& path_prefix,  //
     std::string* raw_data_buffer,    //
     Optional<NDArray>* staging_buffer) const {
   LoadBinaryFromFile(path_prefix + "/" + this->data_path, raw_data_buffer);
-  CHECK_EQ(this->format, "raw-shard") << "ValueError: Only `raw-shard` format is supported";
-  CHECK_EQ(this->nbytes, raw_data_buffer->length())
+  return Load(device, raw_data_buffer, staging_buffer);
+}
+
+/*!
+ * \brief Decompress a `zstd-shard` file into the raw-record layout that the
+ *  per-record loaders expect.
+ *
+ *  Each record is an independent zstd frame, so the records are decompressed
+ *  in parallel on the threading backend while the caller's prefetch thread is
+ *  already reading the next shard from disk.  Shards may carry a shared
+ *  dictionary at the head of the file, trained over the records at dump time.
+ *
+ * \param shard The shard metadata.
+ * \param raw_data The compressed file contents.
+ * \param decoded_offset Output: offset of each record in the returned buffer.
+ * \return The decompressed records, laid out back to back.
+ */
+std::string DecompressZstdShard(const NDArrayCacheMetadata::FileRecord& shard,
+                                const std::string& raw_data,
+                                std::vector<int64_t>* decoded_offset) {
+#ifdef TVM_USE_ZSTD
+  using ParamRecord = NDArrayCacheMetadata::FileRecord::ParamRecord;
+  int64_t num_records = shard.records.size();
+  decoded_offset->resize(num_records + 1);
+  (*decoded_offset)[0] = 0;
+  for (int64_t i = 0; i < num_records; ++i) {
+    (*decoded_offset)[i + 1] = (*decoded_offset)[i] + shard.records[i].nbytes;
+  }
+  std::string decoded(decoded_offset->back(), '\0');
+  const char* dict_data = raw_data.data();
+  size_t dict_nbytes = shard.dict_nbytes;
+  // LOG(FATAL) throws, which must not unwind across the worker threads, so
+  // collect per-record results and report the first failure afterwards.
+  std::vector<size_t> status(num_records, 0);
+  parallel_for_with_threading_backend(
+      [&](int64_t i) {
+        const ParamRecord& rec = shard.records[i];
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        status[i] = ZSTD_decompress_usingDict(dctx, &decoded[(*decoded_offset)[i]], rec.nbytes,
+                                              raw_data.data() + rec.byte_offset,
+                                              rec.encoded_nbytes, dict_data, dict_nbytes);
+        ZSTD_freeDCtx(dctx);
+      },
+      0, num_records);
+  for (int64_t i = 0; i < num_records; ++i) {
+    const ParamRecord& rec = shard.records[i];
+    CHECK(!ZSTD_isError(status[i]))
+        << "ValueError: Failed to decompress record `" << rec.name << "` in " << shard.data_path
+        << ": " << ZSTD_getErrorName(status[i]);
+    CHECK_EQ(static_cast<int64_t>(status[i]), rec.nbytes)
+        << "ValueError: Record `" << rec.name << "` in " << shard.data_path << " decompressed to "
+        << status[i] << " bytes, but the metadata expects " << rec.nbytes << " bytes";
+  }
+  return decoded;
+#else
+  LOG(FATAL) << "ValueError: The parameter shard " << shard.data_path
+             << " is zstd-compressed, but TVM was built without zstd support. "
+             << "Please rebuild with `set(USE_ZSTD ON)` in config.cmake";
+#endif  // TVM_USE_ZSTD
+}
+
+TVM_DLL Array<NDArray> NDArrayCacheMetadata::FileRecord::Load(
+    Device device,
+    const std::string* raw_data,  //
+    Optional<NDArray>* staging_buffer) const {
+  CHECK(this->format == "raw-shard" || this->format == "zstd-shard")
+      << "ValueError: Only `raw-shard` and `zstd-shard` formats are supported";
+  CHECK_EQ(this->nbytes, raw_data->length())
       << "ValueError: Encountered an corrupted parameter shard. It means it is not downloaded "
          "completely or downloading is interrupted. Please try to download again.";
   Array<NDArray> result;
   result.reserve(this->records.size());
+  if (this->format == "zstd-shard") {
+    // Decompress all records first, then feed them through the usual
+    // copy-to-device path so the device copies overlap the next disk read.
+    std::vector<int64_t> decoded_offset;
+    std::string decoded = DecompressZstdShard(*this, *raw_data, &decoded_offset);
+    for (size_t i = 0; i < this->records.size(); ++i) {
+      ParamRecord rec = this->records[i];
+      rec.byte_offset = decoded_offset[i];
+      result.push_back(rec.Load(device, &decoded, staging_buffer));
+    }
+    return result;
+  }
   for (const ParamRecord& nd_rec : this->records) {
-    result.push_back(nd_rec.Load(device, raw_data_buffer, staging_buffer));
+    result.push_back(nd_rec.Load(device, raw_data, staging_buffer));
   }
   return result;
 }
 
+/*!
+ * \brief Whether cache loading should alias memory-mapped shard files.
+ *
+ *  Only meaningful for CPU (including unified-memory) targets and opt-in via
+ *  TVM_NDARRAY_CACHE_MMAP=1, since aliased parameters live on read-only pages.
+ */
+bool ShouldMapShardFiles(Device device) {
+  if (device.device_type != kDLCPU) return false;
+  const char* val = getenv("TVM_NDARRAY_CACHE_MMAP");
+  return val != nullptr && atoi(val) != 0;
+}
+
 /*!
  * A NDArray cache to store pre-loaded arrays in the system.
  */
@@ -245,24 +378,74 @@ class NDArrayCache {
   static void Load(const std::string& cache_path, int device_type, int device_id) {
     DLDevice device{static_cast<DLDeviceType>(device_type), device_id};
     NDArrayCacheMetadata metadata = NDArrayCacheMetadata::Load(cache_path);
+    if (ShouldMapShardFiles(device) && LoadMapped(metadata, cache_path, device)) {
+      return;
+    }
     Optional<NDArray> staging_buffer;
-    std::string raw_data;
-    Array<NDArray> params;
-    for (const NDArrayCacheMetadata::FileRecord& shard_rec : metadata.records) {
+    size_t num_shards = metadata.records.size();
+    // Double-buffered pipeline: a background thread reads shard k + 1 from disk
+    // while this thread decodes shard k and copies it to the device, so cold
+    // start is bound by max(disk, copy) time instead of their sum.
+    std::string raw_data[2];
+    std::thread prefetch;
+    auto read_shard = [&metadata, &cache_path](size_t i, std::string* out) {
+      LoadBinaryFromFile(cache_path + "/" + metadata.records[i].data_path, out);
+    };
+    if (num_shards > 0) {
+      read_shard(0, &raw_data[0]);
+    }
+    for (size_t i = 0; i < num_shards; ++i) {
+      const NDArrayCacheMetadata::FileRecord& shard_rec = metadata.records[i];
+      if (i + 1 < num_shards) {
+        prefetch = std::thread(read_shard, i + 1, &raw_data[(i + 1) % 2]);
+      }
+      Array<NDArray> params;
       try {
-        params = shard_rec.Load(device, cache_path, &raw_data, &staging_buffer);
+        params = shard_rec.Load(device, &raw_data[i % 2], &staging_buffer);
       } catch (const dmlc::Error& e) {
+        if (prefetch.joinable()) {
+          prefetch.join();
+        }
         LOG(FATAL) << "ValueError: Error when loading parameters from " << shard_rec.data_path
                    << ": " << e.what();
       }
       int num_params = params.size();
-      for (int i = 0; i < num_params; ++i) {
-        Update(shard_rec.records[i].name, params[i], true);
+      for (int j = 0; j < num_params; ++j) {
+        Update(shard_rec.records[j].name, params[j], true);
+      }
+      if (prefetch.joinable()) {
+        prefetch.join();
       }
     }
   }
 
  private:
+  /*!
+   * \brief Zero-copy load path: alias memory-mapped shard files directly.
+   * \return Whether all shards could be mapped. On failure the caller falls
+   *         back to the copying loader, which overrides any partial updates.
+   */
+  static bool LoadMapped(const NDArrayCacheMetadata& metadata, const std::string& cache_path,
+                         Device device) {
+    for (const NDArrayCacheMetadata::FileRecord& shard_rec : metadata.records) {
+      auto mapped = MemoryMappedFile::Open(cache_path + "/" + shard_rec.data_path);
+      if (mapped == nullptr) {
+        return false;
+      }
+      if (shard_rec.format != "raw-shard") {
+        // compressed shards cannot alias file pages; use the copying loader
+        return false;
+      }
+      CHECK_EQ(shard_rec.nbytes, mapped->size())
+          << "ValueError: Encountered an corrupted parameter shard. It means it is not downloaded "
+             "completely or downloading is interrupted. Please try to download again.";
+      for (const NDArrayCacheMetadata::FileRecord::ParamRecord& nd_rec : shard_rec.records) {
+        Update(nd_rec.name, nd_rec.LoadZeroCopy(device, mapped->data(), mapped), true);
+      }
+    }
+    return true;
+  }
+
   Map<String, NDArray> pool_;
 };
 
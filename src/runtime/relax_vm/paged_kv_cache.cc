@@ -25,10 +25,12 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory/memory_manager.h>
 #include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
 #include <numeric>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -77,8 +79,9 @@ constexpr const int kPagedKVCacheTempPageId = -1;
 struct Block {
   /*!
    * \brief The ids of the pages in the block.
-   * Each page can only be used by a unique block (in other
-   * words, different blocks do not share pages).
+   * A partially-filled trailing page may be shared by several blocks
+   * after a fork; shared pages are copy-on-write and are only written
+   * once a block holds the sole reference (see `page_ref_counts_`).
    */
   std::vector<int32_t> page_ids;
   /*! \brief The total sequence length in the block. */
@@ -154,6 +157,33 @@ struct Sequence {
    * in the KV cache even when sliding window is enabled.
    */
   int last_block_attn_sink_size = 0;
+  /*!
+   * \brief Whether heavy-hitter retention is enabled on top of the sliding
+   * window of the sequence. When enabled, pages about to be slid out whose
+   * accumulated attention mass is well above average are promoted into the
+   * attention sink region instead of being freed, until the sink region
+   * reaches `retention_max_sink_size`.
+   */
+  bool heavy_hitter_retention = false;
+  /*!
+   * \brief The upper bound of the attention sink region (in tokens) that
+   * heavy-hitter promotion may grow the sinks to.
+   */
+  int32_t retention_max_sink_size = 0;
+  /*!
+   * \brief The promotion threshold of heavy-hitter retention: a page is
+   * promoted when its accumulated attention mass is at least this multiple
+   * of the average page mass of the last block.
+   */
+  double heavy_hitter_promote_threshold = 0.0;
+  /*!
+   * \brief The accumulated attention mass of each page of the last block,
+   * parallel to the `page_ids` of the last block. Committed from outside via
+   * `CommitAccumulatedAttnScoresForSeq` and kept aligned when pages are
+   * evicted. Empty when no scores were committed; heavy-hitter promotion is
+   * then disabled and eviction degenerates to the plain sliding window.
+   */
+  std::vector<double> page_attn_scores;
 
   /*! \brief Whether the current appended tokens form a chain (not a tree). */
   bool is_chain = true;
@@ -196,6 +226,27 @@ struct Sequence {
   }
 };
 
+/*!
+ * \brief The host-side snapshot of a swapped-out sequence.
+ * It keeps the sequence bookkeeping, the per-block metadata (ordered from the
+ * root block to the last block) and the K/V data of all the pages of the
+ * sequence, which is everything needed to rebuild the sequence on swap-in.
+ * The page ids recorded in the saved blocks are stale; fresh pages are
+ * allocated when the sequence is swapped back in.
+ */
+struct SwappedSequence {
+  /*! \brief The sequence bookkeeping at the time of swap-out. */
+  Sequence seq;
+  /*! \brief The blocks of the sequence, ordered from root to last. */
+  std::vector<Block> blocks;
+  /*!
+   * \brief The K/V data of all pages of the sequence on host, in layout
+   * (num_layers, num_pages, 2, num_kv_heads, page_size, head_dim), where
+   * pages follow the root-to-last block trace order.
+   */
+  NDArray kv_data;
+};
+
 /*!
  * \brief The rotary embedding mode adopted by the paged KV cache
  * when computing attention.
@@ -865,8 +916,41 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   Array<NDArray> pages_;
   /*! \brief The list of ids of released pages for page reuse. */
   std::vector<int32_t> free_page_ids_;
+  /*!
+   * \brief The reference count of each page.
+   * Pages are exclusively owned (count 1) except for partially-filled
+   * trailing pages shared across forked blocks, which are copy-on-write.
+   */
+  std::vector<int32_t> page_ref_counts_;
   /*! \brief The mapping from sequence ids to sequences. */
   std::unordered_map<int64_t, Sequence> seq_map_;
+  /*! \brief Host snapshots of swapped-out sequences, keyed by sequence id. */
+  std::unordered_map<int64_t, SwappedSequence> swapped_seq_map_;
+  /*! \brief The total bytes currently held by the host swap pool. */
+  int64_t host_swap_bytes_ = 0;
+
+  /********************* Instrumentation *********************/
+  //-------------------------------------------
+  // The counters below are monotonic totals maintained on the host
+  // bookkeeping paths. Each update is a plain integer increment on a
+  // branch that is already taken, so the cost is negligible. They are
+  // reported by DebugStats() together with snapshot statistics derived
+  // from the structures above.
+  //-------------------------------------------
+  /*! \brief The total number of pages handed out from the free list. */
+  int64_t stat_page_allocs_ = 0;
+  /*! \brief The total number of pages recycled back to the free list. */
+  int64_t stat_page_frees_ = 0;
+  /*! \brief The total number of copy-on-write page copies made before appends. */
+  int64_t stat_cow_page_copies_ = 0;
+  /*! \brief The total number of tokens appended into the cache. */
+  int64_t stat_appended_tokens_ = 0;
+  /*! \brief The total number of forward rounds begun. */
+  int64_t stat_forward_rounds_ = 0;
+  /*! \brief The total number of token tree commit rounds that compacted KV data. */
+  int64_t stat_compaction_rounds_ = 0;
+  /*! \brief The total number of KV entries moved by commit compactions. */
+  int64_t stat_compaction_copied_tokens_ = 0;
 
   /********************* Sequence Block Structures *********************/
 
@@ -1114,6 +1198,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     for (int64_t page_id = num_total_pages - 1; page_id >= 0; --page_id) {
       free_page_ids_.push_back(page_id);
     }
+    page_ref_counts_.assign(num_total_pages, 0);
 
     // If the device is CUDA/ROCm, we create a standalone copy stream, in
     // purpose to hide the latency of auxiliary stream copy.
@@ -1159,8 +1244,18 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     for (int64_t page_id = num_total_pages_ - 1; page_id >= 0; --page_id) {
       free_page_ids_.push_back(page_id);
     }
+    page_ref_counts_.assign(num_total_pages_, 0);
     global_block_pool_.clear();
     free_block_idx_.clear();
+    swapped_seq_map_.clear();
+    host_swap_bytes_ = 0;
+    stat_page_allocs_ = 0;
+    stat_page_frees_ = 0;
+    stat_cow_page_copies_ = 0;
+    stat_appended_tokens_ = 0;
+    stat_forward_rounds_ = 0;
+    stat_compaction_rounds_ = 0;
+    stat_compaction_copied_tokens_ = 0;
     dirty_aux_data_device_ = false;
   }
 
@@ -1183,7 +1278,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
       // - Free pages in the last block.
       for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
-        free_page_ids_.push_back(page_id);
+        FreePage(page_id);
       }
       free_block_idx_.push_back(block_idx);
       block_idx = global_block_pool_[block_idx].parent_idx;
@@ -1299,11 +1394,13 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       global_block_pool_[child_block_idx].seq_length = in_page_offset;
 
       if (in_page_offset > 0) {
-        // Fork within a page and copy common page to child block partially
+        // Fork within a page: share the partially-filled page with the child
+        // instead of copying it. The copy is deferred until one side appends
+        // into the page again (copy-on-write in ReserveAppendLengthInSeq), so
+        // beam-search forks share all common history at zero copy cost.
         int32_t src_page_id = global_block_pool_[forked_block_idx].page_ids[0];
-        int32_t tgt_page_id = GetFreePage();
-        global_block_pool_[child_block_idx].page_ids.push_back(tgt_page_id);
-        CopySinglePage(src_page_id, tgt_page_id, in_page_offset);
+        ++page_ref_counts_[src_page_id];
+        global_block_pool_[child_block_idx].page_ids.push_back(src_page_id);
       }
       break;
     }
@@ -1332,6 +1429,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     if (total_copy_length == 0) {
       return;
     }
+    ++stat_compaction_rounds_;
+    stat_compaction_copied_tokens_ += total_copy_length;
 
     // Copy indptr/src/dst arrays to GPU.
     aux_data_manager_->ResetCompactKVAuxDataCopy();
@@ -1389,6 +1488,58 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     it->second.sliding_window_size = sliding_window_size;
   }
 
+  void EnableHeavyHitterRetentionForSeq(int64_t seq_id, int32_t sliding_window_size,
+                                        int32_t attn_sink_size, int32_t max_sink_size,
+                                        double promote_threshold) final {
+    EnableSlidingWindowForSeq(seq_id, sliding_window_size, attn_sink_size);
+    CHECK_GE(max_sink_size, attn_sink_size)
+        << "The max sink size of heavy-hitter retention should be no less than the attention "
+           "sink size.";
+    CHECK_GT(promote_threshold, 0)
+        << "The promotion threshold of heavy-hitter retention should be positive.";
+    auto it = seq_map_.find(seq_id);
+    ICHECK(it != seq_map_.end());
+    it->second.heavy_hitter_retention = true;
+    it->second.retention_max_sink_size = max_sink_size;
+    it->second.heavy_hitter_promote_threshold = promote_threshold;
+  }
+
+  // The attention kernels in this cache return per-query outputs and
+  // log-sum-exp values rather than per-key attention scores, so the
+  // accumulated per-page mass is committed from outside, e.g. by a serving
+  // layer that aggregates the scores emitted by its attention kernels.
+  void CommitAccumulatedAttnScoresForSeq(int64_t seq_id, NDArray scores) final {
+    auto it = seq_map_.find(seq_id);
+    CHECK(it != seq_map_.end()) << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    CHECK(it->second.heavy_hitter_retention)
+        << "The sequence \"" << seq_id << "\" is not enabled for heavy-hitter retention.";
+    CHECK_EQ(scores->device.device_type, kDLCPU)
+        << "The committed attention scores are expected to reside on host.";
+    CHECK_EQ(scores->ndim, 1) << "The committed attention scores are expected to be 1-D.";
+    const Block& block = global_block_pool_[it->second.last_block_idx];
+    int64_t num_pages = static_cast<int64_t>(block.page_ids.size());
+    CHECK_EQ(scores->shape[0], num_pages)
+        << "The committed attention scores are expected to have one value per page of the last "
+           "block ("
+        << num_pages << " pages), while " << scores->shape[0] << " values are got.";
+    std::vector<double>& page_attn_scores = it->second.page_attn_scores;
+    page_attn_scores.resize(num_pages, 0.0);
+    if (scores.DataType() == DataType::Float(32)) {
+      const float* data = static_cast<const float*>(scores->data);
+      for (int64_t i = 0; i < num_pages; ++i) {
+        page_attn_scores[i] += data[i];
+      }
+    } else if (scores.DataType() == DataType::Float(64)) {
+      const double* data = static_cast<const double*>(scores->data);
+      for (int64_t i = 0; i < num_pages; ++i) {
+        page_attn_scores[i] += data[i];
+      }
+    } else {
+      LOG(FATAL) << "The committed attention scores are expected to be fp32 or fp64, while "
+                 << scores.DataType() << " is got.";
+    }
+  }
+
   void PopN(int64_t seq_id, int32_t n) final {
     auto it = seq_map_.find(seq_id);
     CHECK(it != seq_map_.end()) << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
@@ -1401,6 +1552,50 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       return;
     }
 
+    PopNImpl(seq_id, n);
+    dirty_aux_data_device_ = true;
+  }
+
+  void PopNBatch(const IntTuple& seq_ids, const IntTuple& ns) final {
+    CHECK_EQ(seq_ids.size(), ns.size())
+        << "The sequence ids and the numbers of tokens to pop must have the same length.";
+    // Validate the whole batch before mutating anything, so one bad entry
+    // cannot leave some sequences rolled back and others untouched.
+    std::unordered_map<int64_t, int64_t> total_pop;
+    total_pop.reserve(seq_ids.size());
+    for (size_t i = 0; i < seq_ids.size(); ++i) {
+      auto it = seq_map_.find(seq_ids[i]);
+      CHECK(it != seq_map_.end()) << "The sequence \"" << seq_ids[i]
+                                  << "\" cannot be found in KV cache.";
+      CHECK_GE(ns[i], 0) << "The length of popping " << ns[i] << " cannot be negative.";
+      int64_t& total = total_pop[seq_ids[i]];
+      total += ns[i];
+      CHECK_LE(total, it->second.seq_length)
+          << "The sequence only has length " << it->second.seq_length
+          << ", while the total length of pop is " << total
+          << " which exceeds the whole sequence length.";
+    }
+    // Apply all per-sequence deltas in one host pass. The page-table mutations
+    // stay host side and are committed to the device in a single fused
+    // auxiliary upload at the next BeginForward, so speculative-decoding
+    // verification cost stays flat as the batch grows.
+    for (size_t i = 0; i < seq_ids.size(); ++i) {
+      if (ns[i] != 0) {
+        PopNImpl(seq_ids[i], static_cast<int32_t>(ns[i]));
+      }
+    }
+    dirty_aux_data_device_ = true;
+  }
+
+  /*!
+   * \brief Roll back the trailing `n` tokens of a sequence in the page table.
+   *  The caller is responsible for validating the arguments and marking the
+   *  auxiliary device data dirty afterwards.
+   */
+  void PopNImpl(int64_t seq_id, int32_t n) {
+    auto it = seq_map_.find(seq_id);
+    ICHECK(it != seq_map_.end());
+
     int32_t block_idx = it->second.last_block_idx;
     // The block should have at least one reference, which comes from the sequence.
     ICHECK_GE(global_block_pool_[block_idx].external_ref_cnt, 1);
@@ -1409,7 +1604,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         n -= global_block_pool_[block_idx].seq_length;
         it->second.seq_length -= global_block_pool_[block_idx].seq_length;
         for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
-          free_page_ids_.push_back(page_id);
+          FreePage(page_id);
         }
         free_block_idx_.push_back(block_idx);
         block_idx = global_block_pool_[block_idx].parent_idx;
@@ -1421,7 +1616,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         int64_t tgt_npage =
             (global_block_pool_[block_idx].seq_length - n + page_size_ - 1) / page_size_;
         while (cur_npage > tgt_npage) {
-          free_page_ids_.push_back(global_block_pool_[block_idx].page_ids.back());
+          FreePage(global_block_pool_[block_idx].page_ids.back());
           global_block_pool_[block_idx].page_ids.pop_back();
           --cur_npage;
         }
@@ -1446,6 +1641,115 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       seq_map_.erase(temp_seq_id);
     }
 
+    // The pages of the last block have changed: the committed per-page
+    // attention scores no longer line up with them, so drop the stale mass
+    // until new scores are committed.
+    seq_map_.find(seq_id)->second.page_attn_scores.clear();
+  }
+
+  void SwapOutSequence(int64_t seq_id) final {
+    auto it = seq_map_.find(seq_id);
+    CHECK(it != seq_map_.end()) << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    CHECK(it->second.accepted_indices_committed)
+        << "The sequence \"" << seq_id
+        << "\" has uncommitted token tree nodes and cannot be swapped out.";
+    std::vector<int32_t> trace = it->second.GetBlockTrace(global_block_pool_);
+    int64_t num_pages = 0;
+    for (int32_t block_idx : trace) {
+      CHECK_EQ(global_block_pool_[block_idx].external_ref_cnt, 1)
+          << "The sequence \"" << seq_id
+          << "\" shares blocks with other sequences and cannot be swapped out.";
+      num_pages += global_block_pool_[block_idx].page_ids.size();
+    }
+    int64_t swap_nbytes = num_layers_ * num_pages * PageNBytes();
+    int64_t host_limit = HostSwapLimitBytes();
+    CHECK(host_limit < 0 || host_swap_bytes_ + swap_nbytes <= host_limit)
+        << "Swapping out sequence \"" << seq_id << "\" (" << swap_nbytes
+        << " bytes) would exceed the host swap pool limit of " << host_limit << " bytes.";
+
+    // - Copy all pages of the sequence to the host buffer (pinned when the
+    //   device supports it), following the root-to-last block trace order.
+    NDArray kv_data =
+        NDArray::Empty({num_layers_, num_pages, 2, num_kv_heads_, page_size_, head_dim_},
+                       pages_[0]->dtype, GetPreferredHostDevice(device_));
+    for (int64_t layer = 0; layer < num_layers_; ++layer) {
+      int64_t dst_page = 0;
+      for (int32_t block_idx : trace) {
+        for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
+          CopyPageData(pages_[layer], page_id, kv_data, layer * num_pages + dst_page);
+          ++dst_page;
+        }
+      }
+    }
+    // The device pages are recycled right below, so the copies must be done.
+    if (copy_stream_ != nullptr) {
+      DeviceAPI::Get(device_)->StreamSync(device_, copy_stream_);
+    }
+
+    // - Save the bookkeeping and release the device-side blocks and pages.
+    SwappedSequence swapped{it->second, {}, kv_data};
+    swapped.blocks.reserve(trace.size());
+    for (int32_t block_idx : trace) {
+      swapped.blocks.push_back(global_block_pool_[block_idx]);
+      for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
+        FreePage(page_id);
+      }
+      free_block_idx_.push_back(block_idx);
+    }
+    host_swap_bytes_ += swap_nbytes;
+    swapped_seq_map_.emplace(seq_id, std::move(swapped));
+    seq_map_.erase(it);
+    dirty_aux_data_device_ = true;
+  }
+
+  void SwapInSequence(int64_t seq_id) final {
+    auto it = swapped_seq_map_.find(seq_id);
+    CHECK(it != swapped_seq_map_.end())
+        << "The sequence \"" << seq_id << "\" has not been swapped out.";
+    CHECK(seq_map_.find(seq_id) == seq_map_.end())
+        << "The sequence \"" << seq_id << "\" is already in the KV cache.";
+    SwappedSequence& swapped = it->second;
+    int64_t num_pages = 0;
+    for (const Block& block : swapped.blocks) {
+      num_pages += block.page_ids.size();
+    }
+    CHECK_LE(num_pages, static_cast<int64_t>(free_page_ids_.size()))
+        << "Not enough free pages to swap in sequence \"" << seq_id << "\": " << num_pages
+        << " needed, " << free_page_ids_.size() << " available.";
+
+    // - Rebuild the block chain with freshly allocated blocks and pages and
+    //   copy the K/V data back to the device.
+    int32_t parent_idx = -1;
+    int64_t src_page = 0;
+    for (const Block& saved : swapped.blocks) {
+      int32_t block_idx = GetFreeBlock();
+      Block& block = global_block_pool_[block_idx];
+      block.seq_length = saved.seq_length;
+      block.start_pos = saved.start_pos;
+      block.sink_length = saved.sink_length;
+      block.sliding_window_offset = saved.sliding_window_offset;
+      block.parent_idx = parent_idx;
+      block.external_ref_cnt = 1;
+      for (size_t i = 0; i < saved.page_ids.size(); ++i) {
+        int32_t page_id = GetFreePage();
+        block.page_ids.push_back(page_id);
+        for (int64_t layer = 0; layer < num_layers_; ++layer) {
+          CopyPageData(swapped.kv_data, layer * num_pages + src_page, pages_[layer], page_id);
+        }
+        ++src_page;
+      }
+      parent_idx = block_idx;
+    }
+    if (copy_stream_ != nullptr) {
+      // The host buffer is freed below, so the copies must be done.
+      DeviceAPI::Get(device_)->StreamSync(device_, copy_stream_);
+    }
+
+    Sequence seq = swapped.seq;
+    seq.last_block_idx = parent_idx;
+    seq_map_.insert({seq_id, seq});
+    host_swap_bytes_ -= num_layers_ * num_pages * PageNBytes();
+    swapped_seq_map_.erase(it);
     dirty_aux_data_device_ = true;
   }
 
@@ -1467,13 +1771,134 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     return total_seq_len;
   }
 
+  /*!
+   * \brief Get the current length of the given sequence in the cache.
+   * This is the chunk continuation state for chunked prefill: it tells
+   * the scheduler how many tokens of the sequence are already in the
+   * cache, which is where the next prefill chunk resumes.
+   */
+  int64_t GetSeqLength(int64_t seq_id) const {
+    auto it = seq_map_.find(seq_id);
+    CHECK(it != seq_map_.end()) << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    return it->second.seq_length;
+  }
+
+  /*!
+   * \brief Dump the occupancy and throughput statistics of the KV cache.
+   * Snapshot values are derived from the host-side bookkeeping, and the
+   * cumulative "accum_*" values come from the instrumentation counters,
+   * so this query never touches device memory. Counts are reported as
+   * `runtime.profiling.Count` and ratios as `runtime.profiling.Ratio`,
+   * following the convention of profiling reports. The "seq_num_pages"
+   * entry is a nested map from the decimal sequence id to the number of
+   * pages the sequence occupies; a page shared after a fork is counted
+   * once per sharing sequence.
+   */
+  Map<String, ObjectRef> DebugStats() const {
+    auto count = [](int64_t value) -> ObjectRef {
+      return ObjectRef(make_object<profiling::CountNode>(value));
+    };
+    auto ratio = [](double value) -> ObjectRef {
+      return ObjectRef(make_object<profiling::RatioNode>(value));
+    };
+    int64_t num_free_pages = free_page_ids_.size();
+    int64_t num_pages_in_use = num_total_pages_ - num_free_pages;
+    // A page with more than one reference is shared by forked blocks.
+    // The sharing ratio is the number of page references per in-use page,
+    // which is 1 when no page is shared.
+    int64_t num_shared_pages = 0;
+    int64_t num_page_refs = 0;
+    for (int32_t ref_cnt : page_ref_counts_) {
+      num_page_refs += ref_cnt;
+      if (ref_cnt > 1) {
+        ++num_shared_pages;
+      }
+    }
+    Map<String, ObjectRef> seq_num_pages;
+    for (const auto& it : seq_map_) {
+      int64_t num_pages = 0;
+      for (int32_t block_idx : it.second.GetBlockTrace(global_block_pool_)) {
+        num_pages += global_block_pool_[block_idx].page_ids.size();
+      }
+      seq_num_pages.Set(std::to_string(it.first), count(num_pages));
+    }
+
+    Map<String, ObjectRef> stats;
+    stats.Set("num_total_pages", count(num_total_pages_));
+    stats.Set("num_free_pages", count(num_free_pages));
+    stats.Set("num_pages_in_use", count(num_pages_in_use));
+    stats.Set("page_utilization",
+              ratio(num_total_pages_ > 0 ? 1.0 * num_pages_in_use / num_total_pages_ : 0.0));
+    stats.Set("num_sequences", count(seq_map_.size()));
+    stats.Set("num_swapped_sequences", count(swapped_seq_map_.size()));
+    stats.Set("host_swap_bytes", count(host_swap_bytes_));
+    stats.Set("total_sequence_length", count(GetTotalSequenceLength()));
+    stats.Set("num_shared_pages", count(num_shared_pages));
+    stats.Set("page_sharing_ratio",
+              ratio(num_pages_in_use > 0 ? 1.0 * num_page_refs / num_pages_in_use : 1.0));
+    stats.Set("seq_num_pages", seq_num_pages);
+    stats.Set("accum_page_allocs", count(stat_page_allocs_));
+    stats.Set("accum_page_frees", count(stat_page_frees_));
+    stats.Set("accum_cow_page_copies", count(stat_cow_page_copies_));
+    stats.Set("accum_appended_tokens", count(stat_appended_tokens_));
+    stats.Set("accum_forward_rounds", count(stat_forward_rounds_));
+    stats.Set("accum_compaction_rounds", count(stat_compaction_rounds_));
+    stats.Set("accum_compaction_copied_tokens", count(stat_compaction_copied_tokens_));
+    return stats;
+  }
+
   /************** Attention **************/
 
+  /*!
+   * \brief Plan the append lengths of one forward wave under the prefill
+   * chunk budget.
+   * Given the number of tokens each sequence still wants to append, the
+   * plan admits the single-token (decode) requests first, so that long
+   * prompts cannot head-of-line block the decode latency of the other
+   * sequences, and then spends the remaining budget on the prefill
+   * requests in the given order. The returned tuple has one append
+   * length per input sequence; an entry 0 means the sequence sits out
+   * this wave and should be left out of the BeginForward batch. The plan
+   * is pure arithmetic over the budgets and does not require the
+   * sequences to be in the cache yet.
+   */
+  IntTuple PlanChunkedPrefill(const IntTuple& remaining_lengths) const {
+    int64_t budget = prefill_chunk_size_;
+    std::vector<int64_t> append_lengths(remaining_lengths.size(), 0);
+    for (int i = 0; i < static_cast<int>(remaining_lengths.size()); ++i) {
+      CHECK_GE(remaining_lengths[i], 0)
+          << "The remaining length of a sequence cannot be negative.";
+      if (remaining_lengths[i] == 1 && budget > 0) {
+        append_lengths[i] = 1;
+        --budget;
+      }
+    }
+    for (int i = 0; i < static_cast<int>(remaining_lengths.size()); ++i) {
+      if (remaining_lengths[i] > 1) {
+        append_lengths[i] = std::min(remaining_lengths[i], budget);
+        budget -= append_lengths[i];
+      }
+    }
+    return IntTuple(std::move(append_lengths));
+  }
+
   void BeginForward(const IntTuple& seq_ids, const IntTuple& append_lengths,
                     const Optional<IntTuple>& opt_token_tree_parent_ptr) final {
     CHECK_EQ(seq_ids.size(), append_lengths.size())
         << "The seq_ids size (" << seq_ids.size() << ") and append_lengths size ("
         << append_lengths.size() << ") mismatch.";
+    // The batch geometry below merges prefill chunks and decode tokens into
+    // one ragged wave, whose total length is bounded by the prefill chunk
+    // size that the temporary buffers and position maps are allocated for.
+    int64_t total_append_length = 0;
+    for (int64_t append_length : append_lengths) {
+      total_append_length += append_length;
+    }
+    CHECK_LE(total_append_length, prefill_chunk_size_)
+        << "The total append length " << total_append_length
+        << " of the input batch exceeds the prefill chunk size " << prefill_chunk_size_
+        << ". Please split the batch into chunks within the budget, e.g. with the plan "
+           "given by PlanChunkedPrefill.";
     cur_batch_size_ = seq_ids.size();
     cur_seq_ids_ = seq_ids;
     cur_append_lengths_ = append_lengths;
@@ -1494,10 +1919,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
           global_block_pool_[it->second.last_block_idx].seq_length);
       k_ragged_rope_pos_offset_host_.push_back(it->second.seq_length);
       it->second.seq_length += append_lengths[i];
+      stat_appended_tokens_ += append_lengths[i];
       if (append_lengths[i] != 1) {
         is_decode_request_ = false;
       }
     }
+    ++stat_forward_rounds_;
 
     // - Check token tree validity and process the token tree.
     is_chain_ = true;
@@ -1830,19 +2257,24 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     }
 
     // - Update the KV cache page data structure.
-    //   Note: Function "PopN" only changes the page table structure and does not
+    //   Note: The pop only changes the page table structure and does not
     //         change the KV cache data. Therefore, we can directly use it, since
-    //         we have already launched all copies.
+    //         we have already launched all copies. The whole batch of rollbacks
+    //         shares one auxiliary-data commit at the next BeginForward.
     for (int i = 0; i < num_seq_to_commit; ++i) {
       int64_t length_to_pop =
           cur_append_lengths_[i] -
           (leaf_indices[i] != -1 ? (sequences[i]->token_tree_node_depths[leaf_indices[i]] + 1) : 0);
-      PopN(cur_seq_ids_[i], length_to_pop);
+      ICHECK_GE(length_to_pop, 0);
+      if (length_to_pop > 0) {
+        PopNImpl(cur_seq_ids_[i], static_cast<int32_t>(length_to_pop));
+      }
       // Reset the sequence states.
       sequences[i]->accepted_indices_committed = true;
       sequences[i]->token_tree_parent_ptr.clear();
       sequences[i]->token_tree_node_depths.clear();
     }
+    dirty_aux_data_device_ = true;
   }
 
   NDArray GetQueryPositions() final {
@@ -1911,15 +2343,75 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   TVM_DECLARE_FINAL_OBJECT_INFO(PagedAttentionKVCacheObj, AttentionKVCacheObj);
 
  private:
+  /*! \brief The number of bytes of one page in one layer. */
+  int64_t PageNBytes() const {
+    DLDataType dtype = pages_[0]->dtype;
+    int64_t elem_bytes = (dtype.bits * dtype.lanes + 7) / 8;
+    return 2 * num_kv_heads_ * page_size_ * head_dim_ * elem_bytes;
+  }
+
+  /*!
+   * \brief The byte limit of the host swap pool, configured via the
+   * TVM_KV_CACHE_SWAP_HOST_LIMIT_BYTES environment variable.
+   * Negative means unlimited.
+   */
+  static int64_t HostSwapLimitBytes() {
+    static int64_t limit = []() -> int64_t {
+      const char* val = getenv("TVM_KV_CACHE_SWAP_HOST_LIMIT_BYTES");
+      return val ? atoll(val) : -1;
+    }();
+    return limit;
+  }
+
+  /*!
+   * \brief Copy one page between the layer KV storage and a host swap buffer.
+   * Both sides are addressed as flat arrays of pages; the copy runs on the
+   * copy stream when one is available.
+   */
+  void CopyPageData(const NDArray& src, int64_t src_page, const NDArray& dst, int64_t dst_page) {
+    int64_t page_nbytes = PageNBytes();
+    DLDataType dtype = pages_[0]->dtype;
+    int64_t elem_bytes = (dtype.bits * dtype.lanes + 7) / 8;
+    int64_t page_elems = page_nbytes / elem_bytes;
+    DLTensor copy_src;
+    copy_src.data = src->data;
+    copy_src.device = src->device;
+    copy_src.ndim = 1;
+    copy_src.dtype = dtype;
+    copy_src.shape = &page_elems;
+    copy_src.strides = nullptr;
+    copy_src.byte_offset = src_page * page_nbytes;
+    DLTensor copy_dst = copy_src;
+    copy_dst.data = dst->data;
+    copy_dst.device = dst->device;
+    copy_dst.byte_offset = dst_page * page_nbytes;
+    NDArray::CopyFromTo(&copy_src, &copy_dst, copy_stream_);
+  }
+
   /*! \brief Get a new free page and return its id. */
   int32_t GetFreePage() {
     // Find a page from the free page pools.
     CHECK(!free_page_ids_.empty()) << "The KV cache is full. No page can be allocated.";
     int32_t page_id = free_page_ids_.back();
     free_page_ids_.pop_back();
+    page_ref_counts_[page_id] = 1;
+    ++stat_page_allocs_;
     return page_id;
   }
 
+  /*!
+   * \brief Drop one reference to the given page, recycling the page
+   * when the last reference is gone. Pages are only multi-referenced
+   * when a partially-filled trailing page is shared after a fork.
+   */
+  void FreePage(int32_t page_id) {
+    ICHECK_GT(page_ref_counts_[page_id], 0);
+    if (--page_ref_counts_[page_id] == 0) {
+      free_page_ids_.push_back(page_id);
+      ++stat_page_frees_;
+    }
+  }
+
   /*! \brief Get a new free block and return its index. */
   int32_t GetFreeBlock() {
     if (!free_block_idx_.empty()) {
@@ -2009,6 +2501,36 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     return is_chain;
   }
 
+  /*!
+   * \brief Decide whether the page at the given index of the last block of
+   * the sequence should be pinned into the attention sink region rather
+   * than evicted, according to the heavy-hitter retention policy of the
+   * sequence.
+   */
+  bool ShouldPromoteHeavyHitterPage(const Sequence& seq, const Block& block,
+                                    int32_t page_idx) const {
+    if (!seq.heavy_hitter_retention) {
+      return false;
+    }
+    // No promotion without committed scores aligned to the current pages.
+    if (seq.page_attn_scores.size() != block.page_ids.size()) {
+      return false;
+    }
+    // The sink region may not grow beyond the configured upper bound.
+    if ((page_idx + 1) * page_size_ > seq.retention_max_sink_size) {
+      return false;
+    }
+    double total_mass = 0;
+    for (double score : seq.page_attn_scores) {
+      total_mass += score;
+    }
+    double mean_mass = total_mass / seq.page_attn_scores.size();
+    if (mean_mass <= 0) {
+      return false;
+    }
+    return seq.page_attn_scores[page_idx] >= seq.heavy_hitter_promote_threshold * mean_mass;
+  }
+
   /*!
    * \brief Slide the KV cache window of the given sequence when
    * it has sliding window enabled.
@@ -2047,12 +2569,31 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     int32_t page_start_offset_after_sliding =
         (block.sliding_window_offset + length_to_slide) % page_size_;
 
-    // - Free the pages that are fully slidden.
+    // - Free the pages that are fully slidden, promoting heavy-hitter pages
+    // into the attention sink region instead when the retention policy of
+    // the sequence asks for it.
+    int32_t promoted_length = 0;
     while (page_idx_after_sliding > num_sink_pages) {
+      if (block.page_ids[num_sink_pages] != kPagedKVCacheTempPageId &&
+          ShouldPromoteHeavyHitterPage(*seq, block, num_sink_pages)) {
+        // Pin the whole page into the sink region. The promotion is
+        // page-granular, so it may also cover a few already-slid positions
+        // preceding the page when the previous sink end was not page-aligned;
+        // their K/V data is still intact since the page was never freed.
+        int32_t new_sink_length = (num_sink_pages + 1) * page_size_;
+        promoted_length += new_sink_length - block.sink_length;
+        block.sink_length = new_sink_length;
+        seq->last_block_attn_sink_size = new_sink_length;
+        ++num_sink_pages;
+        continue;
+      }
       if (block.page_ids[num_sink_pages] != kPagedKVCacheTempPageId) {
-        free_page_ids_.push_back(block.page_ids[num_sink_pages]);
+        FreePage(block.page_ids[num_sink_pages]);
       }
       block.page_ids.erase(block.page_ids.begin() + num_sink_pages);
+      if (num_sink_pages < static_cast<int32_t>(seq->page_attn_scores.size())) {
+        seq->page_attn_scores.erase(seq->page_attn_scores.begin() + num_sink_pages);
+      }
       --page_idx_after_sliding;
     }
     // - The first sliding page after sliding is either the last sink page,
@@ -2060,9 +2601,13 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     ICHECK(page_idx_after_sliding == num_sink_pages - 1 ||
            page_idx_after_sliding == num_sink_pages);
 
-    // - Update the length of the sequence and the block.
+    // - Update the length of the sequence and the block. Promoted tokens are
+    // retained in the sink region, so the window budget of the sequence
+    // grows by the promoted length, bounded by the max sink size of the
+    // retention policy.
+    seq->sliding_window_size += promoted_length;
     seq->seq_length = seq->sliding_window_size;
-    block.seq_length -= length_to_slide;
+    block.seq_length -= length_to_slide - promoted_length;
     block.sliding_window_offset =
         page_idx_after_sliding * page_size_ + page_start_offset_after_sliding;
     ICHECK_GE(block.seq_length, block.sink_length);
@@ -2091,6 +2636,26 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         << "The block is " << block.external_ref_cnt - 1
         << "-time referenced by other blocks, thus cannot accept new KV values.";
 
+    // ==================== Copy-on-write ====================
+    // A fork within a page shares the partially-filled trailing page across
+    // the forked blocks. Before appending into it, give this block a private
+    // copy so the other sharers keep their history intact.
+    if (!block.page_ids.empty()) {
+      int32_t last_page_id = block.page_ids.back();
+      if (last_page_id != kPagedKVCacheTempPageId && page_ref_counts_[last_page_id] > 1) {
+        int64_t filled_length = block.sliding_window_offset + block.seq_length -
+                                block.sink_length -
+                                (static_cast<int64_t>(block.page_ids.size()) - 1) * page_size_;
+        ICHECK_GT(filled_length, 0);
+        ICHECK_LE(filled_length, page_size_);
+        int32_t new_page_id = GetFreePage();
+        CopySinglePage(last_page_id, new_page_id, filled_length);
+        block.page_ids.back() = new_page_id;
+        FreePage(last_page_id);
+        ++stat_cow_page_copies_;
+      }
+    }
+
     // ==================== Reserve ====================
     // The reservation is based on the current sequence length.
     // If "current sequence + append length" does not exceed the
@@ -2618,6 +3183,27 @@ TVM_REGISTER_GLOBAL("vm.builtin.paged_attention_kv_cache_create_reduced")
       *rv = AttentionKVCache(std::move(n));
     });
 
+TVM_REGISTER_GLOBAL("vm.builtin.kv_cache_debug_stats")
+    .set_body_typed([](AttentionKVCache kv_cache) {
+      const auto* paged_kv_cache = kv_cache.as<PagedAttentionKVCacheObj>();
+      CHECK(paged_kv_cache != nullptr) << "The given KV cache is not a paged KV cache.";
+      return paged_kv_cache->DebugStats();
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_get_seq_length")
+    .set_body_typed([](AttentionKVCache kv_cache, int64_t seq_id) {
+      const auto* paged_kv_cache = kv_cache.as<PagedAttentionKVCacheObj>();
+      CHECK(paged_kv_cache != nullptr) << "The given KV cache is not a paged KV cache.";
+      return paged_kv_cache->GetSeqLength(seq_id);
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.attention_kv_cache_plan_chunked_prefill")
+    .set_body_typed([](AttentionKVCache kv_cache, IntTuple remaining_lengths) {
+      const auto* paged_kv_cache = kv_cache.as<PagedAttentionKVCacheObj>();
+      CHECK(paged_kv_cache != nullptr) << "The given KV cache is not a paged KV cache.";
+      return paged_kv_cache->PlanChunkedPrefill(remaining_lengths);
+    });
+
 }  // namespace relax_vm
 }  // namespace runtime
 }  // namespace tvm
@@ -114,15 +114,26 @@ class RNNStateImpObj : public RNNStateObj {
    * If it is dirty, an explicit "SyncAuxArrayToDevice" should be invoked.
    */
   bool dirty_aux_data_device_ = false;
-  /*! \brief The device array of the sequence ids. */
-  NDArray seq_slot_ids_device_;
+  /*!
+   * \brief The double-buffered device array holding the packed auxiliary data.
+   *
+   * Each half stores the sequence slot ids followed by the history slot ids of
+   * one step, so the per-step upload is a single host-to-device copy instead of
+   * one per array. The halves alternate between steps: the upload for the next
+   * step lands in the inactive half while the gather/scatter kernels of the
+   * current step may still be reading the active one, so the copy can be issued
+   * without waiting for the previous step to drain.
+   */
+  NDArray aux_data_device_;
+  /*! \brief The half of `aux_data_device_` the current step's views point into. */
+  int active_aux_buffer_ = 0;
+  /*! \brief Persistent host staging buffer for the packed auxiliary data. */
+  std::vector<int32_t> host_aux_data_;
   /*!
    * \brief The view of the device array of the sequence ids.
    * The view is used to reuse the memory but with different shape.
    */
   NDArray seq_slot_ids_view_;
-  /*! \brief The device array of the history slot ids. */
-  NDArray history_slot_ids_device_;
   /*!
    * \brief The view of the device array of the history slot ids.
    * The view is used to reuse the memory but with different shape.
@@ -185,9 +196,9 @@ class RNNStateImpObj : public RNNStateObj {
 
     CHECK_GT(max_history_, 0) << "At least 1 history slot to store the current state";
 
-    // Allocate the auxiliary arrays on device.
-    seq_slot_ids_device_ = NDArray::Empty({reserved_num_seqs}, dtype_aux_, device);
-    history_slot_ids_device_ = NDArray::Empty({reserved_num_seqs}, dtype_aux_, device);
+    // Allocate the double-buffered packed auxiliary array on device:
+    // 2 buffers * (seq slot ids + history slot ids).
+    aux_data_device_ = NDArray::Empty({2 * 2 * reserved_num_seqs}, dtype_aux_, device);
 
     Clear();
   }
@@ -418,36 +429,43 @@ class RNNStateImpObj : public RNNStateObj {
    * invoked before running attention computation on device.
    */
   void SyncAuxArrayToDevice() {
-    auto fcopy_from_vec = [](NDArray array, std::vector<int32_t> vec_data) {
-      DLTensor copy_dst = *array.operator->();
-      DLTensor copy_src;
-      copy_src.data = vec_data.data();
-      copy_src.device = Device{kDLCPU, 0};
-      copy_src.ndim = 1;
-      copy_src.dtype = array->dtype;
-      copy_src.shape = array->shape;
-      copy_src.strides = nullptr;
-      copy_src.byte_offset = 0;
-      NDArray::CopyFromTo(&copy_src, &copy_dst);
-    };
-
-    std::vector<int32_t> seq_slot_ids;
-    std::vector<int32_t> history_slot_ids;
-    seq_slot_ids.reserve(cur_batch_size_);
-    history_slot_ids.reserve(cur_batch_size_);
+    // Pack both id arrays into one staging buffer so the decode critical path
+    // pays a single host-to-device copy per step.
+    host_aux_data_.resize(2 * cur_batch_size_);
+    int64_t i = 0;
     for (int64_t seq_id : cur_seq_ids_) {
       auto it = seq_map_.find(seq_id);
       CHECK(it != seq_map_.end()) << "The sequence \"" << seq_id
                                   << "\" cannot be found in the space state storage.";
       const Sequence& seq = it->second;
-      seq_slot_ids.push_back(seq.seq_slot_id);
-      history_slot_ids.push_back(seq.history_slot_id);
+      host_aux_data_[i] = seq.seq_slot_id;
+      host_aux_data_[cur_batch_size_ + i] = seq.history_slot_id;
+      ++i;
     }
-    seq_slot_ids_view_ = seq_slot_ids_device_.CreateView({cur_batch_size_}, dtype_aux_);
-    history_slot_ids_view_ = history_slot_ids_device_.CreateView({cur_batch_size_}, dtype_aux_);
 
-    fcopy_from_vec(seq_slot_ids_view_, seq_slot_ids);
-    fcopy_from_vec(history_slot_ids_view_, history_slot_ids);
+    // Write into the inactive half: kernels launched for the previous step may
+    // still be reading the active half, and alternating halves lets this copy
+    // overlap them instead of serializing behind a stream sync.
+    active_aux_buffer_ = 1 - active_aux_buffer_;
+    int64_t elem_bytes = (dtype_aux_.bits * dtype_aux_.lanes + 7) / 8;
+    uint64_t buffer_offset = active_aux_buffer_ * 2 * reserved_num_seqs_ * elem_bytes;
+    NDArray packed_view =
+        aux_data_device_.CreateView({2 * cur_batch_size_}, dtype_aux_, buffer_offset);
+
+    DLTensor copy_dst = *packed_view.operator->();
+    DLTensor copy_src;
+    copy_src.data = host_aux_data_.data();
+    copy_src.device = Device{kDLCPU, 0};
+    copy_src.ndim = 1;
+    copy_src.dtype = packed_view->dtype;
+    copy_src.shape = packed_view->shape;
+    copy_src.strides = nullptr;
+    copy_src.byte_offset = 0;
+    NDArray::CopyFromTo(&copy_src, &copy_dst);
+
+    seq_slot_ids_view_ = aux_data_device_.CreateView({cur_batch_size_}, dtype_aux_, buffer_offset);
+    history_slot_ids_view_ = aux_data_device_.CreateView(
+        {cur_batch_size_}, dtype_aux_, buffer_offset + cur_batch_size_ * elem_bytes);
 
     // Reset the dirty flag to false.
     dirty_aux_data_device_ = false;
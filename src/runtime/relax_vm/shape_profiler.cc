@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/relax_vm/shape_profiler.cc
+ * \brief A VM instrument that records tensor argument shapes.
+ * \details
+ * The instrument is installed via `set_instrument` and records, for every
+ * tensor argument of every VM call, the observed shape. The recorded
+ * distributions can then be summarized into a percentile envelope (e.g. P95)
+ * which drives profile-guided memory planning: the envelope values are fed
+ * back to compilation as the `tir_var_profiled_bound` function attribute
+ * consumed by StaticPlanBlockMemory, while outlier shapes beyond the envelope
+ * are served at runtime by the storage spill path
+ * (see TVM_VM_STORAGE_SPILL_ON_OVERFLOW in memory_manager.cc).
+ */
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace relax_vm {
+
+/*! \brief A process-global recorder of per-call-site tensor shape observations. */
+class ShapeProfiler {
+ public:
+  static ShapeProfiler* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new ShapeProfiler();
+    return inst;
+  }
+
+  /*! \brief Record the shape of \p arg_index-th tensor argument of a call to \p func_name. */
+  void Record(const std::string& func_name, int arg_index, ShapeTuple shape) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observations_[{func_name, arg_index}].push_back(std::move(shape));
+  }
+
+  /*! \brief Drop all recorded observations. */
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observations_.clear();
+  }
+
+  /*! \return The number of recorded shapes for the given call site, or 0 if none. */
+  int64_t NumRecords(const std::string& func_name, int arg_index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = observations_.find({func_name, arg_index});
+    return it == observations_.end() ? 0 : static_cast<int64_t>(it->second.size());
+  }
+
+  /*!
+   * \brief Summarize the recorded shapes of a call site into a per-dimension
+   * percentile envelope, using the nearest-rank method.
+   * \param func_name The name of the called VM function.
+   * \param arg_index The index of the tensor argument.
+   * \param percentile The requested percentile in range (0, 100].
+   * \return The envelope shape: each dimension is the given percentile of the
+   * observed values of that dimension.
+   */
+  ShapeTuple Percentile(const std::string& func_name, int arg_index, double percentile) {
+    CHECK(percentile > 0 && percentile <= 100)
+        << "ValueError: The percentile is expected to be in range (0, 100], while " << percentile
+        << " is got.";
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = observations_.find({func_name, arg_index});
+    CHECK(it != observations_.end())
+        << "ValueError: No shape was recorded for argument " << arg_index << " of function \""
+        << func_name << "\".";
+    const std::vector<ShapeTuple>& shapes = it->second;
+    size_t ndim = shapes.front().size();
+    std::vector<int64_t> envelope(ndim);
+    std::vector<int64_t> dim_values(shapes.size());
+    for (size_t dim = 0; dim < ndim; ++dim) {
+      for (size_t i = 0; i < shapes.size(); ++i) {
+        CHECK_EQ(shapes[i].size(), ndim)
+            << "ValueError: The recorded shapes of argument " << arg_index << " of function \""
+            << func_name << "\" do not have the same number of dimensions.";
+        dim_values[i] = shapes[i][dim];
+      }
+      std::sort(dim_values.begin(), dim_values.end());
+      size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * dim_values.size()));
+      envelope[dim] = dim_values[std::max<size_t>(rank, 1) - 1];
+    }
+    return ShapeTuple(std::move(envelope));
+  }
+
+ private:
+  struct CallSiteHash {
+    std::size_t operator()(const std::pair<std::string, int>& site) const {
+      return std::hash<std::string>{}(site.first) ^ std::hash<int>{}(site.second);
+    }
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::pair<std::string, int>, std::vector<ShapeTuple>, CallSiteHash>
+      observations_;
+};
+
+// The instrument follows the `set_instrument` calling convention:
+// (func, func_name, before_run, ret_value, *call_args). Shapes are recorded
+// before the call runs so that allocation outputs are captured with the
+// shapes the caller requested.
+TVM_REGISTER_GLOBAL("vm.builtin.shape_profile_instrument")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      bool before_run = args[2];
+      if (!before_run) {
+        return;
+      }
+      std::string func_name = args[1];
+      for (int i = 4; i < args.size(); ++i) {
+        if (args[i].type_code() == kTVMNDArrayHandle ||
+            args[i].type_code() == kTVMDLTensorHandle) {
+          NDArray nd_array = args[i];
+          ShapeProfiler::Global()->Record(func_name, i - 4, nd_array.Shape());
+        }
+      }
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.shape_profile_reset").set_body_typed([]() {
+  ShapeProfiler::Global()->Reset();
+});
+
+TVM_REGISTER_GLOBAL("vm.builtin.shape_profile_num_records")
+    .set_body_typed([](std::string func_name, int arg_index) {
+      return ShapeProfiler::Global()->NumRecords(func_name, arg_index);
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.shape_profile_percentile")
+    .set_body_typed([](std::string func_name, int arg_index, double percentile) {
+      return ShapeProfiler::Global()->Percentile(func_name, arg_index, percentile);
+    });
+
+}  // namespace relax_vm
+}  // namespace runtime
+}  // namespace tvm
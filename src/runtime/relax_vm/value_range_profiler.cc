@@ -0,0 +1,239 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/relax_vm/value_range_profiler.cc
+ * \brief A VM instrument that records tensor value-range histograms.
+ * \details
+ * The instrument is installed via `set_instrument` and records, for every
+ * float tensor argument of every VM call, a histogram of the log2 magnitudes
+ * of its elements together with the largest absolute value observed. The
+ * records drive calibration of automatic mixed precision: after running the
+ * fp32 module on calibration inputs, the per-kernel absmax values are mapped
+ * back to the relax ops they implement and fed to ToMixedPrecision as the
+ * `calibrated_absmax` parameter, which relaxes or tightens the static per-op
+ * fp16 policies (see src/relax/transform/to_mixed_precision.cc).
+ */
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace relax_vm {
+
+/*! \brief A process-global recorder of per-call-site tensor value ranges. */
+class ValueRangeProfiler {
+ public:
+  /*!
+   * \brief The number of log2-magnitude histogram buckets. Bucket 0 counts
+   * zeros; bucket `e + kExponentOffset` counts elements whose magnitude has
+   * binary exponent `e`, clamped to the representable bucket range.
+   */
+  static constexpr int kNumBuckets = 64;
+  static constexpr int kExponentOffset = 32;
+
+  static ValueRangeProfiler* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new ValueRangeProfiler();
+    return inst;
+  }
+
+  /*! \brief Record the values of the \p arg_index-th tensor argument of a call to \p func_name. */
+  void Record(const std::string& func_name, int arg_index, const NDArray& array) {
+    DLDataType dtype = array->dtype;
+    if (dtype.code != kDLFloat || dtype.lanes != 1 || (dtype.bits != 32 && dtype.bits != 64)) {
+      // Only fp32/fp64 tensors carry calibration information; the calibration
+      // run is expected to execute the original fp32 module.
+      return;
+    }
+    // Summarize on a host copy outside the lock; only the merge is guarded.
+    Device cpu_dev{kDLCPU, 0};
+    NDArray host = array;
+    if (array->device.device_type != kDLCPU) {
+      host = array.CopyTo(cpu_dev);
+      DeviceAPI::Get(array->device)->StreamSync(array->device, nullptr);
+    }
+    int64_t num_elements = 1;
+    for (int i = 0; i < host->ndim; ++i) {
+      num_elements *= host->shape[i];
+    }
+    RangeRecord summary;
+    if (dtype.bits == 32) {
+      Summarize<float>(host, num_elements, &summary);
+    } else {
+      Summarize<double>(host, num_elements, &summary);
+    }
+    summary.num_calls = 1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    RangeRecord& record = observations_[{func_name, arg_index}];
+    record.absmax = std::max(record.absmax, summary.absmax);
+    record.num_elements += summary.num_elements;
+    record.num_nonfinite += summary.num_nonfinite;
+    record.num_calls += summary.num_calls;
+    for (int i = 0; i < kNumBuckets; ++i) {
+      record.histogram[i] += summary.histogram[i];
+    }
+  }
+
+  /*! \brief Drop all recorded observations. */
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observations_.clear();
+  }
+
+  /*! \return The number of recorded calls for the given call site, or 0 if none. */
+  int64_t NumRecords(const std::string& func_name, int arg_index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = observations_.find({func_name, arg_index});
+    return it == observations_.end() ? 0 : it->second.num_calls;
+  }
+
+  /*!
+   * \brief The largest absolute value observed across all tensor arguments of
+   * the given function, or +inf if any non-finite value was observed.
+   */
+  double AbsMax(const std::string& func_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double absmax = -1.0;
+    for (const auto& [site, record] : observations_) {
+      if (site.first != func_name) {
+        continue;
+      }
+      if (record.num_nonfinite > 0) {
+        return std::numeric_limits<double>::infinity();
+      }
+      absmax = std::max(absmax, record.absmax);
+    }
+    CHECK_GE(absmax, 0.0) << "ValueError: No value range was recorded for function \"" << func_name
+                          << "\".";
+    return absmax;
+  }
+
+  /*!
+   * \brief The aggregated log2-magnitude histogram of a call site.
+   * \param func_name The name of the called VM function.
+   * \param arg_index The index of the tensor argument.
+   * \return The per-bucket element counts; see kNumBuckets for the bucket layout.
+   */
+  ShapeTuple Histogram(const std::string& func_name, int arg_index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = observations_.find({func_name, arg_index});
+    CHECK(it != observations_.end())
+        << "ValueError: No value range was recorded for argument " << arg_index << " of function \""
+        << func_name << "\".";
+    std::vector<int64_t> counts(it->second.histogram.begin(), it->second.histogram.end());
+    return ShapeTuple(std::move(counts));
+  }
+
+ private:
+  struct RangeRecord {
+    double absmax{0.0};
+    int64_t num_elements{0};
+    int64_t num_nonfinite{0};
+    int64_t num_calls{0};
+    std::array<int64_t, kNumBuckets> histogram{};
+  };
+
+  template <typename T>
+  static void Summarize(const NDArray& host, int64_t num_elements, RangeRecord* summary) {
+    const T* data = static_cast<const T*>(host->data);
+    for (int64_t i = 0; i < num_elements; ++i) {
+      double value = static_cast<double>(data[i]);
+      if (!std::isfinite(value)) {
+        ++summary->num_nonfinite;
+        continue;
+      }
+      double magnitude = std::abs(value);
+      summary->absmax = std::max(summary->absmax, magnitude);
+      int bucket = 0;
+      if (magnitude > 0.0) {
+        int exponent = std::ilogb(magnitude);
+        bucket = std::min(std::max(exponent + kExponentOffset, 1), kNumBuckets - 1);
+      }
+      ++summary->histogram[bucket];
+    }
+    summary->num_elements += num_elements;
+  }
+
+  struct CallSiteHash {
+    std::size_t operator()(const std::pair<std::string, int>& site) const {
+      return std::hash<std::string>{}(site.first) ^ std::hash<int>{}(site.second);
+    }
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::pair<std::string, int>, RangeRecord, CallSiteHash> observations_;
+};
+
+// The instrument follows the `set_instrument` calling convention:
+// (func, func_name, before_run, ret_value, *call_args). Values are recorded
+// after the call runs so that output tensors, which are passed as
+// preallocated arguments in the VM calling convention, hold computed values.
+TVM_REGISTER_GLOBAL("vm.builtin.value_range_profile_instrument")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      bool before_run = args[2];
+      if (before_run) {
+        return;
+      }
+      std::string func_name = args[1];
+      for (int i = 4; i < args.size(); ++i) {
+        if (args[i].type_code() == kTVMNDArrayHandle ||
+            args[i].type_code() == kTVMDLTensorHandle) {
+          NDArray nd_array = args[i];
+          ValueRangeProfiler::Global()->Record(func_name, i - 4, nd_array);
+        }
+      }
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.value_range_profile_reset").set_body_typed([]() {
+  ValueRangeProfiler::Global()->Reset();
+});
+
+TVM_REGISTER_GLOBAL("vm.builtin.value_range_profile_num_records")
+    .set_body_typed([](std::string func_name, int arg_index) {
+      return ValueRangeProfiler::Global()->NumRecords(func_name, arg_index);
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.value_range_profile_absmax")
+    .set_body_typed([](std::string func_name) {
+      return ValueRangeProfiler::Global()->AbsMax(func_name);
+    });
+
+TVM_REGISTER_GLOBAL("vm.builtin.value_range_profile_histogram")
+    .set_body_typed([](std::string func_name, int arg_index) {
+      return ValueRangeProfiler::Global()->Histogram(func_name, arg_index);
+    });
+
+}  // namespace relax_vm
+}  // namespace runtime
+}  // namespace tvm
@@ -21,15 +21,23 @@
  * \file src/runtime/relax_vm/vm.cc
  */
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/memory/memory_manager.h>
 #include <tvm/runtime/nvtx.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/relax_vm/vm.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <thread>
 
+#include "../../support/utils.h"
+#include "../async_run_handle.h"
+#include "gpu_scheduler.h"
+
 namespace tvm {
 namespace runtime {
 namespace relax_vm {
@@ -88,24 +96,30 @@ ObjectRef IndexIntoNestedObject(ObjectRef obj, TVMArgs args, int starting_arg_id
   return obj;
 }
 
-NDArray ConvertNDArrayToDevice(NDArray src, const DLDevice& dev, Allocator* alloc) {
+NDArray ConvertNDArrayToDevice(NDArray src, const DLDevice& dev, Allocator* alloc,
+                               TVMStreamHandle copy_stream = nullptr) {
   if (src->device.device_type == dev.device_type && src->device.device_id == dev.device_id) {
     return src;
   } else {
     auto res = alloc->Empty(src.Shape(), src->dtype, dev);
-    res.CopyFrom(src);
+    if (copy_stream == nullptr) {
+      res.CopyFrom(src);
+    } else {
+      NDArray::CopyFromTo(src.operator->(), const_cast<DLTensor*>(res.operator->()), copy_stream);
+    }
     return res;
   }
 }
 
-ObjectRef ConvertObjectToDevice(ObjectRef src, const Device& dev, Allocator* alloc) {
+ObjectRef ConvertObjectToDevice(ObjectRef src, const Device& dev, Allocator* alloc,
+                                TVMStreamHandle copy_stream = nullptr) {
   if (src->IsInstance<NDArray::ContainerType>()) {
-    return ConvertNDArrayToDevice(Downcast<NDArray>(src), dev, alloc);
+    return ConvertNDArrayToDevice(Downcast<NDArray>(src), dev, alloc, copy_stream);
   } else if (src->IsInstance<ArrayNode>()) {
     std::vector<ObjectRef> ret;
     auto arr = Downcast<Array<ObjectRef>>(src);
     for (size_t i = 0; i < arr.size(); i++) {
-      ret.push_back(ConvertObjectToDevice(arr[i], dev, alloc));
+      ret.push_back(ConvertObjectToDevice(arr[i], dev, alloc, copy_stream));
     }
     return Array<ObjectRef>(ret.begin(), ret.end());
   } else {
@@ -113,7 +127,8 @@ ObjectRef ConvertObjectToDevice(ObjectRef src, const Device& dev, Allocator* all
   }
 }
 
-TVMRetValue ConvertArgToDevice(TVMArgValue input, Device dev, Allocator* alloc) {
+TVMRetValue ConvertArgToDevice(TVMArgValue input, Device dev, Allocator* alloc,
+                               TVMStreamHandle copy_stream = nullptr) {
   // NOTE: NDArray::FromExternalDLTensor is not safe
   // in terms of memory-behavior.
   // To be extra careful, we copy DLTensor.
@@ -125,10 +140,14 @@ TVMRetValue ConvertArgToDevice(TVMArgValue input, Device dev, Allocator* alloc)
     DLTensor* tensor = input;
     std::vector<int64_t> shape(tensor->shape, tensor->shape + tensor->ndim);
     auto dst = alloc->Empty(shape, tensor->dtype, dev);
-    dst.CopyFrom(tensor);
+    if (copy_stream == nullptr) {
+      dst.CopyFrom(tensor);
+    } else {
+      NDArray::CopyFromTo(tensor, const_cast<DLTensor*>(dst.operator->()), copy_stream);
+    }
     ret = dst;
   } else if (input.IsObjectRef<ObjectRef>()) {
-    ret = ConvertObjectToDevice(input.operator ObjectRef(), dev, alloc);
+    ret = ConvertObjectToDevice(input.operator ObjectRef(), dev, alloc, copy_stream);
   } else {
     ret = input;
   }
@@ -167,6 +186,8 @@ struct VMFrame {
   std::vector<RegType> register_file;
   /*! \brief Register in caller's frame to put return value */
   RegName caller_return_register;
+  /*! \brief Name of the VM function executing in this frame, kept for profilers. */
+  std::string func_name;
   // The following fields are used for PackedFunc call within
   // a single function scope. The space is reused across multiple
   // packed func calls to increase cache locality and avoid re-allocation
@@ -208,6 +229,67 @@ class VirtualMachineImpl : public VirtualMachine {
                            TVMRetValue* rv) final;
   void SetInstrument(PackedFunc instrument) final { this->instrument_ = instrument; }
 
+  /*!
+   * \brief Freeze the VM for zero-allocation steady-state serving.
+   *
+   *  Call after a warmup invocation of every entry function. Requires all
+   *  devices to use the pooled allocator: warmup populates the memory pool and
+   *  the frame free list, so subsequent invocations of the same shapes are
+   *  served entirely from caches. Freeze pre-reserves frame and call-stack
+   *  capacity for every VM function and records the device allocation
+   *  baseline; any allocation that escapes the pool afterwards is counted and,
+   *  in strict mode, fatal.
+   *
+   * \param strict Whether an allocation escaping the pool aborts instead of
+   *        being counted and warned about.
+   */
+  void Freeze(bool strict);
+
+  /*!
+   * \brief Drop device copies of least-recently-used constants.
+   *
+   *  Only available when the VM was initialized with TVM_VM_LAZY_CONST_UPLOAD
+   *  set: the host-side copy in the executable stays valid, so an evicted
+   *  constant is simply re-uploaded on its next use. Intended for multi-model
+   *  servers that keep many VMs resident but only a few hot.
+   *
+   * \param bytes_to_keep Upper bound on device bytes kept resident for
+   *        constants; least-recently-used constants are evicted until the
+   *        resident total is below it.
+   * \return The device bytes still resident for constants after eviction.
+   */
+  int64_t EvictDeviceConstants(int64_t bytes_to_keep);
+
+  /*!
+   * \brief Phase one of a two-phase load: upload only the constants reachable
+   *  from the given entry function, so serving can start before the whole
+   *  constant section is device resident.
+   *
+   *  Reachability is computed over the loaded bytecode: the constant indices
+   *  referenced by the entry function and, transitively, by the VM functions
+   *  it calls. Only available when the VM was initialized with
+   *  TVM_VM_LAZY_CONST_UPLOAD set, which keeps the remaining constants host
+   *  side until phase two or their first use.
+   *
+   * \param entry_func The name of the entry function to load constants for.
+   * \return The number of constants uploaded.
+   */
+  int64_t LoadEntryConstants(const std::string& entry_func);
+
+  /*!
+   * \brief Phase two of a two-phase load: stream the constants still pending
+   *  upload from a background thread, in the order of their first static
+   *  reference in the bytecode, so the constants an invocation needs earliest
+   *  arrive first.
+   *
+   *  Serving threads synchronize with the stream per constant, so an
+   *  invocation that overtakes the stream uploads the constant on demand as
+   *  usual and the stream skips it.
+   */
+  void LoadRemainingConstantsAsync();
+
+  ~VirtualMachineImpl() { JoinBackgroundConstLoad(); }
+
   //---------------------------------------------------
   // Functions in the vtable of Module
   //---------------------------------------------------
@@ -215,11 +297,15 @@ class VirtualMachineImpl : public VirtualMachine {
   void _SaveClosure(TVMArgs args, TVMRetValue* rv);
   void _InvokeClosure(TVMArgs args, TVMRetValue* rv);
   void _InvokeClosureStateful(std::string func_name);
+  void _InvokeClosureStatefulAsync(TVMArgs args, TVMRetValue* rv);
   void _SetInstrument(TVMArgs args, TVMRetValue* rv);
   void _GetOutputArity(TVMArgs args, TVMRetValue* rv);
   void _GetOutput(TVMArgs args, TVMRetValue* rv);
   void _SetInputWithoutParamModule(TVMArgs args, TVMRetValue* rv);
   void _SetInputWithParamModule(TVMArgs args, TVMRetValue* rv);
+  void _StageInput(TVMArgs args, TVMRetValue* rv);
+  void _Freeze(TVMArgs args, TVMRetValue* rv);
+  int64_t _FrozenAllocCount() { return frozen_alloc_count_; }
   int _GetFunctionArity(std::string func_name);
   std::string _GetFunctionParamName(std::string func_name, int index);
   PackedFunc _LookupFunction(const String& name);
@@ -229,12 +315,23 @@ class VirtualMachineImpl : public VirtualMachine {
   TVM_MODULE_VTABLE_ENTRY_PACKED("save_function", &VirtualMachineImpl::_SaveClosure);
   TVM_MODULE_VTABLE_ENTRY_PACKED("invoke_closure", &VirtualMachineImpl::_InvokeClosure);
   TVM_MODULE_VTABLE_ENTRY("invoke_stateful", &VirtualMachineImpl::_InvokeClosureStateful);
+  TVM_MODULE_VTABLE_ENTRY_PACKED("invoke_stateful_async",
+                                 &VirtualMachineImpl::_InvokeClosureStatefulAsync);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_instrument", &VirtualMachineImpl::_SetInstrument);
+  TVM_MODULE_VTABLE_ENTRY("set_scheduler_priority", &VirtualMachineImpl::SetSchedulerPriority);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output_arity", &VirtualMachineImpl::_GetOutputArity);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output", &VirtualMachineImpl::_GetOutput);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_input", &VirtualMachineImpl::_SetInputWithoutParamModule);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_input_with_param_module",
                                  &VirtualMachineImpl::_SetInputWithParamModule);
+  TVM_MODULE_VTABLE_ENTRY_PACKED("stage_input", &VirtualMachineImpl::_StageInput);
+  TVM_MODULE_VTABLE_ENTRY("commit_staged_input", &VirtualMachineImpl::CommitStagedInput);
+  TVM_MODULE_VTABLE_ENTRY_PACKED("freeze", &VirtualMachineImpl::_Freeze);
+  TVM_MODULE_VTABLE_ENTRY("frozen_alloc_count", &VirtualMachineImpl::_FrozenAllocCount);
+  TVM_MODULE_VTABLE_ENTRY("evict_device_constants", &VirtualMachineImpl::EvictDeviceConstants);
+  TVM_MODULE_VTABLE_ENTRY("load_entry_constants", &VirtualMachineImpl::LoadEntryConstants);
+  TVM_MODULE_VTABLE_ENTRY("load_remaining_constants_async",
+                          &VirtualMachineImpl::LoadRemainingConstantsAsync);
   TVM_MODULE_VTABLE_ENTRY("get_function_arity", &VirtualMachineImpl::_GetFunctionArity);
   TVM_MODULE_VTABLE_ENTRY("get_function_param_name", &VirtualMachineImpl::_GetFunctionParamName);
   TVM_MODULE_VTABLE_END_WITH_DEFAULT(&VirtualMachineImpl::_LookupFunction);
@@ -260,8 +357,21 @@ class VirtualMachineImpl : public VirtualMachine {
    * objects. \note This interface works when using VM over RPC by internally converting NDArray in
    * the arguments to DLTensor, which is supported in RPC where remote could only have a minimal C
    * runtime.
+   * \param stage If set to true, the converted arguments are staged instead of bound: the
+   *        device copies run asynchronously on a side stream and become visible only when
+   *        CommitStagedInput is called, so inferences using the currently bound inputs are
+   *        not disturbed.
+   */
+  void SetInput(std::string func_name, bool with_param_module, TVMArgs args, bool stage = false);
+
+  /*!
+   * \brief Atomically bind the inputs previously staged for a function.
+   *
+   *  Waits once for the outstanding staging copies, then swaps the staged set in; the swap
+   *  itself is pointer-level and independent of the parameter sizes.
+   * \param func_name The function name.
    */
-  void SetInput(std::string func_name, bool with_param_module, TVMArgs args);
+  void CommitStagedInput(std::string func_name);
 
   /*!
    * \brief Look up whether the VM has a function by the given name.
@@ -359,6 +469,7 @@ class VirtualMachineImpl : public VirtualMachine {
     } else {
       new_frame = std::make_unique<VMFrame>(ret_pc, vm_func.register_file_size);
     }
+    new_frame->func_name = vm_func.name;
     return FrameGuard(this, std::move(new_frame));
   }
   /*!
@@ -393,6 +504,65 @@ class VirtualMachineImpl : public VirtualMachine {
     }
     return ret;
   }
+  /*!
+   * \brief Read a constant pool entry, uploading it to the device on first
+   *  use when lazy constant upload is enabled.
+   * \param idx The constant pool index.
+   * \return The constant value.
+   */
+  TVM_ALWAYS_INLINE const RegType& GetConstant(Index idx) {
+    if (lazy_const_upload_) {
+      if (background_load_active_.load(std::memory_order_acquire)) {
+        // A background constant stream is in flight; serialize with it so the
+        // two sides never upload the same constant twice.
+        std::lock_guard<std::mutex> lock(const_upload_mu_);
+        UploadConstant(idx);
+      } else {
+        UploadConstant(idx);
+      }
+      const_last_use_[idx] = ++const_use_tick_;
+    }
+    return const_pool_[idx];
+  }
+
+  /*! \brief Upload the constant to the device if it is not resident yet. */
+  void UploadConstant(Index idx) {
+    if (!const_on_device_[idx]) {
+      const_pool_[idx] = ConvertRegToDevice(exec_->constants[idx], devices[0], allocators[0]);
+      const_on_device_[idx] = true;
+    }
+  }
+
+  /*! \brief Wait for an in-flight background constant stream, if any. */
+  void JoinBackgroundConstLoad() {
+    if (background_const_thread_.joinable()) {
+      background_const_thread_.join();
+    }
+  }
+
+  /*! \brief Upload every constant still pending lazy upload. */
+  void MaterializeAllConstants() {
+    if (!lazy_const_upload_) return;
+    JoinBackgroundConstLoad();
+    for (size_t i = 0; i < const_pool_.size(); ++i) {
+      if (!const_on_device_[i]) {
+        this->GetConstant(static_cast<Index>(i));
+      }
+    }
+  }
+
+  /*!
+   * \brief Register this VM with the cooperative GPU scheduler under the
+   * given priority, so that its bytecode loop yields to higher-priority VMs
+   * at instruction boundaries and its invocations preempt lower-priority
+   * ones (see CooperativeGpuScheduler).
+   * \param priority The scheduling priority; higher is more latency-critical.
+   */
+  void SetSchedulerPriority(int priority) {
+    sched_priority_ = priority;
+    sched_enabled_ = true;
+  }
+
   /*!
    * \brief Run call instruction.
    * \param curr_frame The current frame.
@@ -403,6 +573,13 @@ class VirtualMachineImpl : public VirtualMachine {
   /*! \brief Run VM dispatch loop. */
   void RunLoop();
 
+  /*!
+   * \brief Peephole over the loaded bytecode that fuses straight-line runs of
+   * Call instructions, so the dispatch loop pays one dispatch per run instead
+   * of one per call.
+   */
+  void BuildCallRunTable();
+
   /*!
    * \brief Retrieve the name of the function identified by the given index.
    * \param idx The index into the VM executable function table.
@@ -437,10 +614,19 @@ class VirtualMachineImpl : public VirtualMachine {
   //--------------------------------------------------------
   /*! \brief The function name to input register mapping. */
   std::unordered_map<std::string, std::vector<RegType>> inputs_;
+  /*! \brief Staged input sets awaiting CommitStagedInput, keyed by function name. */
+  std::unordered_map<std::string, std::vector<RegType>> staged_inputs_;
+  /*! \brief The side stream the staging copies run on. */
+  TVMStreamHandle stage_stream_ = nullptr;
   /*! \brief The function name to output register. */
   std::unordered_map<std::string, RegType> outputs_;
   /*! \brief A store of closures created by `save_function`. */
   std::unordered_map<std::string, VMClosure> saved_closures_;
+  /*!
+   * \brief Cache of closures resolved by GetClosureInternal, keyed by function
+   * name, so repeated GetFunction lookups do not rebuild the closure.
+   */
+  std::unordered_map<std::string, VMClosure> closure_cache_;
   //------------------------------------------------------------
   // VM Instruction execution.
   //------------------------------------------------------------
@@ -456,15 +642,140 @@ class VirtualMachineImpl : public VirtualMachine {
 
   /*! \brief The virtual machine PC. */
   Index pc_{0};
+  /*!
+   * \brief Length of the straight-line run of Call instructions starting at each
+   * pc, and 0 for non-Call instructions. Built once when the executable is
+   * loaded; a run never extends across a branch target.
+   */
+  std::vector<Index> call_run_length_;
   /*! \brief The special return register. */
   RegType return_value_;
   /*!\ brief instrument function. */
   PackedFunc instrument_ = nullptr;
+  /*! \brief Whether NDArray constants are uploaded to the device on first use. */
+  bool lazy_const_upload_{false};
+  /*! \brief Whether const_pool_[i] already holds the device-side copy. */
+  std::vector<bool> const_on_device_;
+  /*! \brief Logical timestamp of the last access of each constant. */
+  std::vector<uint64_t> const_last_use_;
+  /*! \brief Logical clock advanced on every constant access. */
+  uint64_t const_use_tick_{0};
+  /*! \brief Serializes constant uploads while a background stream is active. */
+  std::mutex const_upload_mu_;
+  /*! \brief Whether a background constant stream is running. */
+  std::atomic<bool> background_load_active_{false};
+  /*! \brief The background constant stream thread of LoadRemainingConstantsAsync. */
+  std::thread background_const_thread_;
+  /*! \brief Whether this VM participates in cooperative GPU scheduling. */
+  bool sched_enabled_{false};
+  /*! \brief The scheduling priority of this VM; higher is more latency-critical. */
+  int sched_priority_{0};
+  /*! \brief The nesting depth of bytecode invocations on this VM. */
+  int sched_depth_{0};
+  /*!
+   * \brief An RAII slot in the cooperative GPU scheduler, held for the
+   * duration of the outermost bytecode invocation of a participating VM.
+   * Nested invocations run under the outer invocation's slot.
+   */
+  struct SchedulerSlotGuard {
+    VirtualMachineImpl* vm;
+    bool entered;
+    explicit SchedulerSlotGuard(VirtualMachineImpl* vm)
+        : vm(vm), entered(vm->sched_depth_++ == 0 && vm->sched_enabled_) {
+      if (entered) {
+        CooperativeGpuScheduler::Global()->Enter(vm->sched_priority_);
+      }
+    }
+    ~SchedulerSlotGuard() {
+      --vm->sched_depth_;
+      if (entered) {
+        CooperativeGpuScheduler::Global()->Exit(vm->sched_priority_);
+      }
+    }
+  };
+  /*! \brief Whether the VM is frozen for zero-allocation serving. */
+  bool frozen_{false};
+  /*! \brief Whether an allocation escaping the pool while frozen is fatal. */
+  bool frozen_strict_{false};
+  /*! \brief Total device allocations across allocators at the last check. */
+  int64_t frozen_alloc_baseline_{0};
+  /*! \brief Device allocations observed since Freeze; proves the guarantee holds. */
+  int64_t frozen_alloc_count_{0};
+
+  /*! \return The device allocation total summed over all VM allocators. */
+  int64_t CurrentDeviceAllocCount() const {
+    int64_t total = 0;
+    for (Allocator* alloc : this->allocators) {
+      total += static_cast<int64_t>(alloc->DeviceAllocCount());
+    }
+    return total;
+  }
+
+  /*! \brief Account for allocations that escaped the pool while frozen. */
+  void CheckFrozenAllocs(const std::string& context) {
+    int64_t current = CurrentDeviceAllocCount();
+    int64_t delta = current - frozen_alloc_baseline_;
+    if (delta <= 0) return;
+    frozen_alloc_baseline_ = current;
+    frozen_alloc_count_ += delta;
+    if (frozen_strict_) {
+      LOG(FATAL) << "ValueError: " << delta << " device allocation(s) escaped the memory pool "
+                 << "in \"" << context << "\" while the VM is frozen. Run a warmup invocation "
+                 << "covering these shapes before calling freeze.";
+    }
+    LOG(WARNING) << delta << " device allocation(s) escaped the memory pool in \"" << context
+                 << "\" while the VM is frozen.";
+  }
 };
 
 void VirtualMachineImpl::LoadExecutable(ObjectPtr<Executable> exec) {
   this->exec_ = exec;
   this->imports_ = exec_->imports();
+  BuildCallRunTable();
+}
+
+void VirtualMachineImpl::BuildCallRunTable() {
+  Index num_instr = static_cast<Index>(exec_->instr_offset.size());
+  call_run_length_.assign(num_instr, 0);
+  if (num_instr == 0) {
+    return;
+  }
+  // An instruction is a leader when control flow can enter it other than by
+  // falling through from its predecessor; a fused run must not cross one since
+  // a jump has to land on an un-fused dispatch point.
+  std::vector<bool> leader(num_instr, false);
+  for (const VMFuncInfo& info : exec_->func_table) {
+    if (info.kind != VMFuncInfo::FuncKind::kPackedFunc && info.start_instr >= 0 &&
+        info.start_instr < num_instr) {
+      leader[info.start_instr] = true;
+    }
+  }
+  for (Index pc = 0; pc < num_instr; ++pc) {
+    Instruction instr = exec_->GetInstruction(pc);
+    if (instr.op == Opcode::Goto) {
+      Index target = pc + instr.pc_offset;
+      if (target >= 0 && target < num_instr) {
+        leader[target] = true;
+      }
+    } else if (instr.op == Opcode::If) {
+      if (pc + 1 < num_instr) {
+        leader[pc + 1] = true;
+      }
+      Index target = pc + instr.false_offset;
+      if (target >= 0 && target < num_instr) {
+        leader[target] = true;
+      }
+    }
+  }
+  for (Index pc = num_instr - 1; pc >= 0; --pc) {
+    if (exec_->GetInstruction(pc).op != Opcode::Call) {
+      continue;
+    }
+    call_run_length_[pc] = 1;
+    if (pc + 1 < num_instr && call_run_length_[pc + 1] > 0 && !leader[pc + 1]) {
+      call_run_length_[pc] += call_run_length_[pc + 1];
+    }
+  }
 }
 
 void VirtualMachineImpl::Init(const std::vector<Device>& devices,
@@ -479,10 +790,24 @@ void VirtualMachineImpl::Init(const std::vector<Device>& devices,
     this->allocators.push_back(alloc);
   }
   // Setup constant sections.
+  // When TVM_VM_LAZY_CONST_UPLOAD is set, NDArray constants stay host side
+  // until the first instruction referencing them, so cold models keep no
+  // device-resident weights.
+  lazy_const_upload_ = support::BoolEnvironmentVar("TVM_VM_LAZY_CONST_UPLOAD");
   this->const_pool_.reserve(exec_->constants.size());
-  for (const auto& constant : exec_->constants) {
+  if (lazy_const_upload_) {
+    const_on_device_.assign(exec_->constants.size(), false);
+    const_last_use_.assign(exec_->constants.size(), 0);
+  }
+  for (size_t i = 0; i < exec_->constants.size(); ++i) {
+    const auto& constant = exec_->constants[i];
     if (constant.type_code() != kTVMNDArrayHandle) {
       this->const_pool_.push_back(constant);
+      if (lazy_const_upload_) {
+        const_on_device_[i] = true;
+      }
+    } else if (lazy_const_upload_) {
+      this->const_pool_.push_back(constant);
     } else {
       this->const_pool_.push_back(ConvertRegToDevice(constant, devices[0], allocators[0]));
     }
@@ -491,6 +816,172 @@ void VirtualMachineImpl::Init(const std::vector<Device>& devices,
   this->InitFuncPool();
 }
 
+void VirtualMachineImpl::Freeze(bool strict) {
+  ICHECK(exec_) << "The executable is not created yet.";
+  for (size_t i = 0; i < this->allocators.size(); ++i) {
+    CHECK(this->allocators[i] != nullptr && this->allocators[i]->type() == AllocatorType::kPooled)
+        << "ValueError: freeze requires every device to use the pooled allocator; "
+        << "initialize the VM with AllocatorType::kPooled for device " << i << ".";
+  }
+  // Pre-reserve frame capacity so recycling never reallocates: one frame per VM
+  // function (recursion beyond that falls back to the heap and is counted),
+  // each sized to the largest register file and call argument record.
+  size_t num_vm_funcs = 0;
+  Index max_register_file = 0;
+  for (const VMFuncInfo& info : exec_->func_table) {
+    if (info.kind == VMFuncInfo::FuncKind::kVMFunc) {
+      ++num_vm_funcs;
+      max_register_file = std::max(max_register_file, static_cast<Index>(info.register_file_size));
+    }
+  }
+  size_t max_call_args = 0;
+  for (size_t pc = 0; pc < exec_->instr_offset.size(); ++pc) {
+    Instruction instr = exec_->GetInstruction(pc);
+    if (instr.op == Opcode::Call) {
+      max_call_args = std::max(max_call_args, static_cast<size_t>(instr.num_args));
+    }
+  }
+  // extra slots for the instrument calling convention
+  max_call_args += 4;
+  while (frame_free_list_.size() < num_vm_funcs) {
+    frame_free_list_.emplace_back(std::make_unique<VMFrame>(0, max_register_file));
+  }
+  for (std::unique_ptr<VMFrame>& frame : frame_free_list_) {
+    frame->register_file.reserve(max_register_file);
+    frame->call_arg_values.reserve(max_call_args);
+    frame->call_arg_tcodes.reserve(max_call_args);
+  }
+  frozen_alloc_baseline_ = CurrentDeviceAllocCount();
+  frozen_alloc_count_ = 0;
+  frozen_strict_ = strict;
+  frozen_ = true;
+}
+
+int64_t VirtualMachineImpl::EvictDeviceConstants(int64_t bytes_to_keep) {
+  CHECK(lazy_const_upload_)
+      << "ValueError: evict_device_constants requires the VM to run with lazy constant "
+      << "upload enabled; set TVM_VM_LAZY_CONST_UPLOAD=1 before vm_initialization.";
+  CHECK_GE(bytes_to_keep, 0) << "ValueError: bytes_to_keep must be non-negative.";
+  JoinBackgroundConstLoad();
+  std::vector<size_t> resident;
+  int64_t resident_bytes = 0;
+  for (size_t i = 0; i < const_pool_.size(); ++i) {
+    if (const_on_device_[i] && exec_->constants[i].type_code() == kTVMNDArrayHandle) {
+      resident.push_back(i);
+      NDArray arr = const_pool_[i];
+      resident_bytes += static_cast<int64_t>(GetDataSize(*arr.operator->()));
+    }
+  }
+  // evict least-recently-used first
+  std::sort(resident.begin(), resident.end(),
+            [this](size_t lhs, size_t rhs) { return const_last_use_[lhs] < const_last_use_[rhs]; });
+  for (size_t idx : resident) {
+    if (resident_bytes <= bytes_to_keep) break;
+    NDArray arr = const_pool_[idx];
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*arr.operator->()));
+    // dropping the device copy; the executable keeps the host copy for re-upload
+    const_pool_[idx] = exec_->constants[idx];
+    const_on_device_[idx] = false;
+    resident_bytes -= nbytes;
+  }
+  return resident_bytes;
+}
+
+int64_t VirtualMachineImpl::LoadEntryConstants(const std::string& entry_func) {
+  CHECK(lazy_const_upload_)
+      << "ValueError: load_entry_constants requires the VM to run with lazy constant "
+      << "upload enabled; set TVM_VM_LAZY_CONST_UPLOAD=1 before vm_initialization.";
+  auto it = exec_->func_map.find(entry_func);
+  CHECK(it != exec_->func_map.end()) << "ValueError: Unknown function: " << entry_func;
+  JoinBackgroundConstLoad();
+  // Step 1. Walk the bytecode of the entry function and, transitively, of the
+  // VM functions it references, collecting the constant indices in use.
+  std::vector<bool> func_visited(exec_->func_table.size(), false);
+  std::vector<bool> const_needed(exec_->constants.size(), false);
+  std::vector<Index> worklist{static_cast<Index>(it->second)};
+  while (!worklist.empty()) {
+    Index func_idx = worklist.back();
+    worklist.pop_back();
+    if (func_idx < 0 || func_idx >= static_cast<Index>(exec_->func_table.size()) ||
+        func_visited[func_idx]) {
+      continue;
+    }
+    func_visited[func_idx] = true;
+    const VMFuncInfo& info = exec_->func_table[func_idx];
+    if (info.kind != VMFuncInfo::FuncKind::kVMFunc) {
+      // Packed and VMTIR functions carry no bytecode of their own; any
+      // constant they touch is passed in as a call argument and thus counted
+      // at the call site.
+      continue;
+    }
+    for (Index pc = info.start_instr; pc < info.end_instr; ++pc) {
+      Instruction instr = exec_->GetInstruction(pc);
+      if (instr.op != Opcode::Call) {
+        continue;
+      }
+      worklist.push_back(instr.func_idx);
+      for (Index i = 0; i < instr.num_args; ++i) {
+        Instruction::Arg arg = instr.args[i];
+        if (arg.kind() == Instruction::ArgKind::kConstIdx) {
+          const_needed[arg.value()] = true;
+        } else if (arg.kind() == Instruction::ArgKind::kFuncIdx) {
+          worklist.push_back(arg.value());
+        }
+      }
+    }
+  }
+  // Step 2. Upload the reachable constants; everything else stays host side.
+  int64_t n_uploaded = 0;
+  for (size_t i = 0; i < exec_->constants.size(); ++i) {
+    if (const_needed[i] && !const_on_device_[i]) {
+      UploadConstant(static_cast<Index>(i));
+      ++n_uploaded;
+    }
+  }
+  return n_uploaded;
+}
+
+void VirtualMachineImpl::LoadRemainingConstantsAsync() {
+  CHECK(lazy_const_upload_)
+      << "ValueError: load_remaining_constants_async requires the VM to run with lazy constant "
+      << "upload enabled; set TVM_VM_LAZY_CONST_UPLOAD=1 before vm_initialization.";
+  JoinBackgroundConstLoad();
+  // Stream in the order of the first static reference in the bytecode, so the
+  // constants an invocation needs earliest arrive first. Constants that are
+  // never referenced statically go last in index order.
+  std::vector<Index> order;
+  std::vector<bool> seen(exec_->constants.size(), false);
+  order.reserve(exec_->constants.size());
+  for (size_t pc = 0; pc < exec_->instr_offset.size(); ++pc) {
+    Instruction instr = exec_->GetInstruction(static_cast<Index>(pc));
+    if (instr.op != Opcode::Call) {
+      continue;
+    }
+    for (Index i = 0; i < instr.num_args; ++i) {
+      Instruction::Arg arg = instr.args[i];
+      if (arg.kind() == Instruction::ArgKind::kConstIdx && !seen[arg.value()]) {
+        seen[arg.value()] = true;
+        order.push_back(static_cast<Index>(arg.value()));
+      }
+    }
+  }
+  for (size_t i = 0; i < exec_->constants.size(); ++i) {
+    if (!seen[i]) {
+      order.push_back(static_cast<Index>(i));
+    }
+  }
+  background_load_active_.store(true, std::memory_order_release);
+  background_const_thread_ = std::thread([this, order = std::move(order)]() {
+    for (Index idx : order) {
+      // One constant per lock acquisition, so a serving thread that needs a
+      // constant right now waits for at most one background upload.
+      std::lock_guard<std::mutex> lock(const_upload_mu_);
+      UploadConstant(idx);
+    }
+    background_load_active_.store(false, std::memory_order_release);
+  });
+}
+
 VMFuncInfo VirtualMachineImpl::LookupVMFuncInfo(const std::string& func_name) {
   ICHECK(exec_) << "The executable is not created yet.";
   auto it = this->exec_->func_map.find(func_name);
@@ -507,7 +998,8 @@ RegType VirtualMachineImpl::LookupVMOutput(const std::string& func_name) {
   return outputs_[func_name];
 }
 
-void VirtualMachineImpl::SetInput(std::string func_name, bool with_param_module, TVMArgs args) {
+void VirtualMachineImpl::SetInput(std::string func_name, bool with_param_module, TVMArgs args,
+                                  bool stage) {
   const auto& m = exec_->func_map;
   if (m.find(func_name) != m.end()) {
     Index gf_idx = m.at(func_name);
@@ -515,21 +1007,41 @@ void VirtualMachineImpl::SetInput(std::string func_name, bool with_param_module,
     size_t params_num = vm_func.num_args;
     ICHECK_EQ(args.size(), params_num)
         << "The number of provided parameters doesn't match the number of arguments for";
+    TVMStreamHandle copy_stream = nullptr;
+    if (stage) {
+      if (stage_stream_ == nullptr) {
+        stage_stream_ = DeviceAPI::Get(devices[0])->CreateStream(devices[0]);
+      }
+      copy_stream = stage_stream_;
+    }
     std::vector<RegType> func_args(params_num);
     for (int i = 0; i < args.size(); ++i) {
       if (with_param_module && i == args.size() - 1) {
         // call param func to get the arguments(usually corresponds to param pack.)
         func_args[i] = (args[i].operator Module()).GetFunction("get_params")();
       } else {
-        func_args[i] = ConvertArgToDevice(args[i], devices[0], allocators[0]);
+        func_args[i] = ConvertArgToDevice(args[i], devices[0], allocators[0], copy_stream);
       }
     }
-    inputs_[func_name] = func_args;
+    if (stage) {
+      staged_inputs_[func_name] = func_args;
+    } else {
+      inputs_[func_name] = func_args;
+    }
   } else {
     LOG(FATAL) << "ValueError: Unknown function: " << func_name;
   }
 }
 
+void VirtualMachineImpl::CommitStagedInput(std::string func_name) {
+  auto it = staged_inputs_.find(func_name);
+  CHECK(it != staged_inputs_.end()) << "ValueError: No staged input for function \"" << func_name
+                                    << "\"; use `stage_input` first.";
+  DeviceAPI::Get(devices[0])->StreamSync(devices[0], stage_stream_);
+  inputs_[func_name] = std::move(it->second);
+  staged_inputs_.erase(it);
+}
+
 //------------------------------------------
 // Closure handling
 //------------------------------------------
@@ -557,6 +1069,9 @@ void VirtualMachineImpl::InvokeClosurePacked(const ObjectRef& closure_or_packedf
     NVTXScopedRange scope("RelaxVM: " + clo->func_name);
     clo->impl.CallPacked(TVMArgs(values.data(), tcodes.data(), args.size() + 1), rv);
   }
+  if (frozen_) {
+    CheckFrozenAllocs(clo->func_name);
+  }
 }
 
 // internal variant version of invoke closurepacked
@@ -610,6 +1125,11 @@ Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const String& func_na
   if (saved_it != saved_closures_.end()) {
     return saved_it->second;
   }
+  // look up previously resolved closures.
+  auto cached_it = closure_cache_.find(func_name);
+  if (cached_it != closure_cache_.end()) {
+    return cached_it->second;
+  }
   auto it = exec_->func_map.find(func_name);
   if (it == exec_->func_map.end()) {
     if (allow_missing) return NullOpt;
@@ -631,7 +1151,9 @@ Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const String& func_na
       }
       *rv = static_cast<VirtualMachineImpl*>(ctx_ptr)->InvokeBytecode(gf_idx, inputs);
     });
-    return VMClosure(func_name, impl);
+    VMClosure clo(func_name, impl);
+    closure_cache_.emplace(func_name, clo);
+    return clo;
   } else {
     ICHECK(finfo.kind == VMFuncInfo::FuncKind::kVMTIRFunc)
         << "Cannot support closure with function kind " << static_cast<int>(finfo.kind);
@@ -650,6 +1172,9 @@ Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const String& func_na
         reg_file[i] = args[i + 1];
       }
       void* reg_anylist_handle = reg_file.data();
+      // TIR functions read the constant pool directly and bypass GetConstant,
+      // so every pending constant must be resident before handing out the pool.
+      this->MaterializeAllConstants();
       void* const_anylist_handle = this->const_pool_.data();
       void* func_anylist_handle = this->func_pool_.data();
       tir_func(static_cast<void*>(ctx_ptr), reg_anylist_handle, const_anylist_handle,
@@ -657,7 +1182,9 @@ Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const String& func_na
       // Return value always stored after inputs.
       *rv = reg_file[finfo.num_args];
     });
-    return VMClosure(func_name, impl);
+    VMClosure clo(func_name, impl);
+    closure_cache_.emplace(func_name, clo);
+    return clo;
   }
 }
 
@@ -668,6 +1195,10 @@ RegType VirtualMachineImpl::InvokeBytecode(Index gf_idx, const std::vector<RegTy
   const VMFuncInfo& gfunc = exec_->func_table[gf_idx];
   ICHECK(gfunc.kind == VMFuncInfo::FuncKind::kVMFunc);
 
+  // Cooperative scheduling: the outermost bytecode invocation claims a
+  // scheduler slot, blocking while a higher-priority invocation is active.
+  SchedulerSlotGuard sched_slot(this);
+
   // Get the curr instr which might be a potential caller.
   Instruction curr_instr = exec_->GetInstruction(pc_);
   auto guard = PushFrame(this->pc_, gfunc);
@@ -758,7 +1289,7 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
         break;
       }
       case Instruction::ArgKind::kConstIdx: {
-        setter(arg_index, this->const_pool_[arg.value()]);
+        setter(arg_index, this->GetConstant(arg.value()));
         break;
       }
       case Instruction::ArgKind::kFuncIdx: {
@@ -821,11 +1352,23 @@ void VirtualMachineImpl::RunLoop() {
   VMFrame* curr_frame = frames_.back().get();
 
   while (true) {
+    if (sched_enabled_) {
+      // Preemption point between bytecode instructions: pause launching
+      // further work while a higher-priority invocation is active. Kernels
+      // already queued on the stream keep draining.
+      CooperativeGpuScheduler::Global()->PreemptionPoint(sched_priority_);
+    }
     ICHECK_LT(static_cast<size_t>(pc_), exec_->instr_offset.size()) << "run into invalid section";
     Instruction instr = exec_->GetInstruction(pc_);
     switch (instr.op) {
       case Opcode::Call: {
+        // Execute the whole fused run of calls in one dispatch; RunInstrCall
+        // advances pc_ itself.
+        Index run_end = pc_ + call_run_length_[pc_];
         this->RunInstrCall(curr_frame, instr);
+        while (pc_ < run_end) {
+          this->RunInstrCall(curr_frame, exec_->GetInstruction(pc_));
+        }
         break;
       }
       case Opcode::Ret: {
@@ -908,6 +1451,27 @@ void VirtualMachineImpl::_InvokeClosureStateful(std::string func_name) {
       this->InvokeClosureInternal(func_pool_[m.at(func_name)], inputs_[func_name]);
 }
 
+void VirtualMachineImpl::_InvokeClosureStatefulAsync(TVMArgs args, TVMRetValue* rv) {
+  std::string func_name = args[0];
+  PackedFunc callback = nullptr;
+  if (args.num_args > 1) {
+    callback = args[1].operator PackedFunc();
+  }
+  // Run the bytecode on this thread - kernel launches are asynchronous on
+  // stream-based devices - and hand only the completion wait to the worker.
+  this->_InvokeClosureStateful(func_name);
+  Module self_ref = GetRef<Module>(this);
+  std::vector<Device> devs = devices;
+  *rv = AsyncCompletionQueue::Global()->Submit([self_ref, devs, callback]() {
+    for (Device dev : devs) {
+      DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+    }
+    if (callback != nullptr) {
+      callback();
+    }
+  });
+}
+
 void VirtualMachineImpl::_SetInstrument(TVMArgs args, TVMRetValue* rv) {
   if (args[0].type_code() == kTVMPackedFuncHandle) {
     this->SetInstrument(args[0]);
@@ -950,11 +1514,22 @@ void VirtualMachineImpl::_SetInputWithoutParamModule(TVMArgs args, TVMRetValue*
                  TVMArgs(args.values + 1, args.type_codes + 1, args.num_args - 1));
 }
 
+void VirtualMachineImpl::_Freeze(TVMArgs args, TVMRetValue* rv) {
+  bool strict = args.size() > 0 ? args[0].operator bool() : false;
+  this->Freeze(strict);
+}
+
 void VirtualMachineImpl::_SetInputWithParamModule(TVMArgs args, TVMRetValue* rv) {
   std::string func_name = args[0];
   this->SetInput(func_name, true, TVMArgs(args.values + 1, args.type_codes + 1, args.num_args - 1));
 }
 
+void VirtualMachineImpl::_StageInput(TVMArgs args, TVMRetValue* rv) {
+  std::string func_name = args[0];
+  this->SetInput(func_name, false, TVMArgs(args.values + 1, args.type_codes + 1, args.num_args - 1),
+                 /*stage=*/true);
+}
+
 int VirtualMachineImpl::_GetFunctionArity(std::string func_name) {
   const VMFuncInfo& vm_func = LookupVMFuncInfo(func_name);
   return vm_func.param_names.size();
@@ -1032,6 +1607,60 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
         *rv = report_json;
 
         prof_ = std::nullopt;  // releases hardware counters
+        if (clear_inputs) {
+          // SetInput modifies the internal states of VM. Undo the change after profiling.
+          ClearInputsFor(f_name);
+        }
+      });
+    } else if (name == "profile_collapsed") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::string f_name = args[0];
+        VMClosure clo = this->GetClosure(f_name);
+
+        auto inputs = GetInputsFor(f_name);
+
+        bool clear_inputs = false;
+        if (inputs.size() == 0) {
+          ICHECK(args.num_args > 1) << "No input is provided";
+          SetInput(f_name, false, TVMArgs(args.values + 1, args.type_codes + 1, args.num_args - 1));
+          inputs = GetInputsFor(f_name);
+          clear_inputs = true;
+        } else {
+          ICHECK_EQ(args.num_args, 1) << "Inputs are already provided by set_input.";
+        }
+
+        // warmup
+        this->InvokeClosureInternal(clo, inputs);
+
+        stack_timers_.clear();
+        collect_stacks_ = true;
+        this->InvokeClosureInternal(clo, inputs);
+        collect_stacks_ = false;
+
+        // Fold the per-call timers into collapsed stacks. The sync happens
+        // here, after the run, so the timers do not perturb each other.
+        std::unordered_map<std::string, int64_t> stacks;
+        for (auto& kv : stack_timers_) {
+          stacks[kv.first] += kv.second->SyncAndGetElapsedNanos();
+        }
+        stack_timers_.clear();
+
+        // Emit the flame-graph collapsed-stack format: one "frame;frame;leaf value"
+        // line per distinct stack, with device time in microseconds as the value.
+        std::vector<std::string> lines;
+        lines.reserve(stacks.size());
+        for (const auto& kv : stacks) {
+          std::ostringstream os;
+          os << kv.first << " " << (kv.second + 500) / 1000;
+          lines.push_back(os.str());
+        }
+        std::sort(lines.begin(), lines.end());
+        std::ostringstream os;
+        for (const std::string& line : lines) {
+          os << line << "\n";
+        }
+        *rv = os.str();
+
         if (clear_inputs) {
           // SetInput modifies the internal states of VM. Undo the change after profiling.
           ClearInputsFor(f_name);
@@ -1044,6 +1673,35 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
 
  protected:
   void RunInstrCall(VMFrame* curr_frame, Instruction inst) override {
+    int64_t stack_timer_idx = -1;
+    if (collect_stacks_) {
+      std::optional<Device> dev;
+      for (Index i = 0; i < inst.num_args; ++i) {
+        Instruction::Arg arg = inst.args[i];
+        RegType val;
+        if (arg.kind() == Instruction::ArgKind::kRegister) {
+          val = ReadRegister(curr_frame, arg.value());
+        } else if (arg.kind() == Instruction::ArgKind::kConstIdx) {
+          val = this->const_pool_[arg.value()];
+        }
+        if (val.type_code() == kTVMNDArrayHandle) {
+          dev = val.operator NDArray()->device;
+          break;
+        }
+      }
+      // Only device calls are attributed; host glue carries no device time.
+      if (dev) {
+        // The VM frames correspond to the relax functions the call was
+        // inlined from, so joining them gives the frontend-level stack.
+        std::ostringstream stack;
+        for (const auto& frame : frames_) {
+          stack << frame->func_name << ";";
+        }
+        stack << GetFuncName(inst.func_idx);
+        stack_timer_idx = static_cast<int64_t>(stack_timers_.size());
+        stack_timers_.emplace_back(stack.str(), Timer::Start(*dev));
+      }
+    }
     bool profiling = false;
     if (prof_ && prof_->IsRunning()) {
       auto f_name = GetFuncName(inst.func_idx);
@@ -1084,10 +1742,17 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
     if (profiling) {
       prof_->StopCall();
     }
+    if (stack_timer_idx >= 0) {
+      stack_timers_[stack_timer_idx].second->Stop();
+    }
   }
 
  private:
   std::optional<profiling::Profiler> prof_;
+  /*! \brief Whether RunInstrCall currently records collapsed stacks. */
+  bool collect_stacks_ = false;
+  /*! \brief Per-call (collapsed stack, timer) records of the profiled run. */
+  std::vector<std::pair<std::string, Timer>> stack_timers_;
 };
 
 ObjectPtr<VirtualMachine> VirtualMachine::CreateProfiler() {
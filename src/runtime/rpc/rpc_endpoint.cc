@@ -58,12 +58,14 @@ namespace runtime {
 class RPCEndpoint::EventHandler : public dmlc::Stream {
  public:
   EventHandler(support::RingBuffer* reader, support::RingBuffer* writer, std::string name,
-               std::string* remote_key, std::function<void()> flush_writer)
+               std::string* remote_key, std::function<void()> flush_writer,
+               std::function<size_t(const void*, size_t)> fsend_direct = nullptr)
       : reader_(reader),
         writer_(writer),
         name_(name),
         remote_key_(remote_key),
-        flush_writer_(flush_writer) {
+        flush_writer_(flush_writer),
+        fsend_direct_(fsend_direct) {
     this->Clear();
 
     if (*remote_key == "%toinit") {
@@ -102,6 +104,35 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   /*! \brief Finish the copy ack stage. */
   void FinishCopyAck() { this->SwitchToState(kRecvPacketNumBytes); }
 
+  /*!
+   * \brief Send a bulk payload straight to the channel, bypassing the writer
+   *  ring buffer, so tensor contents do not go through an intermediate copy.
+   *  Buffered header bytes are flushed first to preserve packet ordering.
+   * \param data The payload to send; must already be in wire byte order.
+   * \param size The number of bytes to send.
+   * \return Whether the direct path is available. When false, nothing has been
+   *  sent and the caller must stage the payload through the writer instead.
+   */
+  bool SendDirect(const void* data, size_t size) {
+    // The async server must defer all writes until the socket is writable,
+    // so it always stages replies in the writer.
+    if (async_server_mode_ || fsend_direct_ == nullptr) return false;
+    flush_writer_();
+    if (writer_->bytes_available() != 0) return false;
+    const char* ptr = static_cast<const char*>(data);
+    while (size != 0) {
+      size_t n = fsend_direct_(ptr, size);
+      if (n == 0) {
+        ICHECK_EQ(ptr, static_cast<const char*>(data))
+            << "Channel closed in the middle of a tensor transfer";
+        return false;
+      }
+      ptr += n;
+      size -= n;
+    }
+    return true;
+  }
+
   /*!
    * \brief Enter the io loop until the next event.
    * \param client_mode Whether we are in the client.
@@ -460,7 +491,12 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
 
       this->Write(packet_nbytes);
       this->Write(code);
-      this->WriteArray(dptr, num_bytes);
+      // Scatter the ack payload straight from the tensor buffer when the
+      // channel allows it, so large reads back to the client skip the
+      // writer staging copy.
+      if (!this->SendDirect(dptr, num_bytes)) {
+        this->WriteArray(dptr, num_bytes);
+      }
       this->SwitchToState(kRecvPacketNumBytes);
     };
 
@@ -686,6 +722,9 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   std::string* remote_key_;
   // function to flush the writer.
   std::function<void()> flush_writer_;
+  // function to send a bulk payload to the channel directly, bypassing the
+  // writer; returns the number of bytes sent, 0 when unavailable.
+  std::function<size_t(const void*, size_t)> fsend_direct_;
 };
 
 RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn) {
@@ -727,12 +766,22 @@ void RPCEndpoint::Init() {
     }
   };
 
+  // callback to send bulk tensor payloads to the channel directly,
+  // bypassing the writer ring buffer.
+  auto send_direct = [this](const void* data, size_t size) -> size_t {
+    if (channel_ == nullptr) return 0;
+    return channel_->Send(data, size);
+  };
+
   // Event handler
-  handler_ = std::make_shared<EventHandler>(&reader_, &writer_, name_, &remote_key_, flush_writer);
+  handler_ = std::make_shared<EventHandler>(&reader_, &writer_, name_, &remote_key_, flush_writer,
+                                            send_direct);
 
   // Quick function to for syscall remote.
   syscall_remote_ = PackedFunc([this](TVMArgs all_args, TVMRetValue* rv) {
     std::lock_guard<std::mutex> lock(mutex_);
+    ICHECK(pending_encode_returns_.empty())
+        << "Cannot make a syscall while pipelined calls are in flight";
     RPCCode code = static_cast<RPCCode>(all_args[0].operator int());
     TVMArgs args(all_args.values + 1, all_args.type_codes + 1, all_args.num_args - 1);
 
@@ -853,6 +902,8 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
                            const int* arg_type_codes, int num_args,
                            RPCSession::FEncodeReturn encode_return) {
   std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK(pending_encode_returns_.empty())
+      << "Cannot make a synchronous call while pipelined calls are in flight";
 
   handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
   RPCCode code = RPCCode::kCallFunc;
@@ -871,8 +922,56 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
   ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
+uint64_t RPCEndpoint::CallFuncAsync(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                                    const int* arg_type_codes, int num_args,
+                                    RPCSession::FEncodeReturn encode_return) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
+  RPCCode code = RPCCode::kCallFunc;
+  uint64_t handle = reinterpret_cast<uint64_t>(h);
+
+  uint64_t packet_nbytes =
+      sizeof(code) + sizeof(handle) +
+      handler_->PackedSeqGetNumBytes(arg_values, arg_type_codes, num_args, true);
+
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  handler_->Write(handle);
+  handler_->SendPackedSeq(arg_values, arg_type_codes, num_args, true);
+
+  // Push the request onto the wire now so the remote starts serving it while
+  // the caller issues further requests.
+  while (writer_.bytes_available() != 0) {
+    size_t n = writer_.ReadWithCallback(
+        [this](const void* data, size_t size) { return channel_->Send(data, size); },
+        writer_.bytes_available());
+    if (n == 0) break;
+  }
+
+  pending_encode_returns_.emplace_back(std::move(encode_return));
+  return next_call_ticket_++;
+}
+
+void RPCEndpoint::WaitCallReply(uint64_t ticket) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK_LT(ticket, next_call_ticket_) << "Invalid pipelined call ticket " << ticket;
+  while (completed_call_ticket_ < ticket) {
+    ICHECK(!pending_encode_returns_.empty());
+    RPCSession::FEncodeReturn setreturn = std::move(pending_encode_returns_.front());
+    pending_encode_returns_.pop_front();
+    // Advance the bookkeeping before pumping so the state stays consistent
+    // when the reply carries a remote exception, which is rethrown locally.
+    ++completed_call_ticket_;
+    RPCCode code = HandleUntilReturnEvent(true, setreturn);
+    ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  }
+}
+
 void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK(pending_encode_returns_.empty())
+      << "Cannot copy to remote while pipelined calls are in flight";
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
@@ -887,12 +986,19 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
-  handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  // Stream the tensor contents straight from the caller's buffer instead of
+  // staging them in the writer ring buffer; multi-GB weight pushes would
+  // otherwise pay an extra full-size copy on every transfer.
+  if (!handler_->SendDirect(from_bytes, nbytes)) {
+    handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  }
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
 }
 
 void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
   std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK(pending_encode_returns_.empty())
+      << "Cannot copy from remote while pipelined calls are in flight";
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
@@ -1087,6 +1193,15 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     endpoint_->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
   }
 
+  uint64_t CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                             const int* arg_type_codes, int num_args,
+                             FEncodeReturn fencode_return) final {
+    return endpoint_->CallFuncAsync(func, arg_values, arg_type_codes, num_args,
+                                    std::move(fencode_return));
+  }
+
+  void WaitPipelined(uint64_t ticket) final { endpoint_->WaitCallReply(ticket); }
+
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
     RPCCode code = RPCCode::kCopyToRemote;
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/packed_func.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -140,6 +141,31 @@ class RPCEndpoint {
    */
   void CallFunc(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
                 const int* arg_type_codes, int num_args, RPCSession::FEncodeReturn encode_return);
+  /*!
+   * \brief Send a call request without waiting for its reply, so that many
+   *  requests can be pipelined on the connection.
+   *
+   *  The request is flushed to the channel before this function returns.
+   *  Replies arrive in request order, so waiting on the returned ticket also
+   *  completes all earlier in-flight calls.
+   *
+   * \param handle The function handle
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param encode_return The function to receive return value encodings,
+   *  invoked from WaitCallReply when the reply is processed.
+   * \return The ticket identifying the in-flight call.
+   */
+  uint64_t CallFuncAsync(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
+                         const int* arg_type_codes, int num_args,
+                         RPCSession::FEncodeReturn encode_return);
+  /*!
+   * \brief Block until the reply of the given in-flight call has been
+   *  received and its return encoder invoked.
+   * \param ticket The ticket returned by CallFuncAsync.
+   */
+  void WaitCallReply(uint64_t ticket);
   /*!
    * \brief Copy bytes into remote array content.
    * \param from The source host data.
@@ -200,6 +226,13 @@ class RPCEndpoint {
   support::RingBuffer reader_, writer_;
   // Event handler.
   std::shared_ptr<EventHandler> handler_;
+  // Return encoders of pipelined calls whose replies are still in flight,
+  // in request order since replies complete in FIFO order.
+  std::deque<RPCSession::FEncodeReturn> pending_encode_returns_;
+  // Ticket to assign to the next pipelined call.
+  uint64_t next_call_ticket_{1};
+  // Ticket of the latest pipelined call whose reply has been processed.
+  uint64_t completed_call_ticket_{0};
   // syscall remote with specified function code.
   PackedFunc syscall_remote_;
   // The name of the session.
@@ -34,6 +34,19 @@ namespace runtime {
 
 bool RPCSession::IsAsync() const { return false; }
 
+uint64_t RPCSession::CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                                       const int* arg_type_codes, int num_args,
+                                       FEncodeReturn fencode_return) {
+  // Generic sessions have no transport-level pipelining: run the call
+  // eagerly so the ticket is already complete by the time it is waited on.
+  this->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
+  return ++pipeline_ticket_counter_;
+}
+
+void RPCSession::WaitPipelined(uint64_t ticket) {
+  ICHECK_LE(ticket, pipeline_ticket_counter_) << "Invalid pipelined call ticket " << ticket;
+}
+
 void RPCSession::SendException(FAsyncCallback callback, const char* msg) {
   TVMValue value;
   value.v_str = msg;
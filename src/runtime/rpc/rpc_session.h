@@ -125,6 +125,37 @@ class RPCSession {
                         const int* arg_type_codes, int num_args,
                         const FEncodeReturn& fencode_return) = 0;
 
+  /*!
+   * \brief Call into a remote Packed function without waiting for its reply,
+   *  so that many calls can be kept in flight on the same session.
+   *
+   *  Follows the same calling convention as CallFunc. The returned ticket is
+   *  passed to WaitPipelined to block until the reply has been received and
+   *  fencode_return invoked; replies complete in request order, so waiting on
+   *  a ticket also completes all earlier in-flight calls. The caller must
+   *  keep the arguments and any data they reference alive until the call is
+   *  waited on.
+   *
+   *  The default implementation runs the call synchronously; transports that
+   *  support request pipelining override it to overlap round trips.
+   *
+   * \param func The function handle.
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param fencode_return The function to set the return value.
+   * \return The ticket identifying the in-flight call.
+   */
+  virtual uint64_t CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                                     const int* arg_type_codes, int num_args,
+                                     FEncodeReturn fencode_return);
+
+  /*!
+   * \brief Wait until the reply of the given in-flight call has been processed.
+   * \param ticket The ticket returned by CallFuncPipelined.
+   */
+  virtual void WaitPipelined(uint64_t ticket);
+
   /*!
    * \brief Copy bytes into remote array content.
    * \param local_from_bytes The source host data.
@@ -268,6 +299,8 @@ class RPCSession {
  private:
   /*! \brief index of this session in RPC session table */
   int table_index_{0};
+  /*! \brief ticket counter used by the default pipelined call implementation */
+  uint64_t pipeline_ticket_counter_{0};
   /*! \brief Insert the current session to the session table.*/
   static void InsertToSessionTable(std::shared_ptr<RPCSession> sess);
   // friend declaration
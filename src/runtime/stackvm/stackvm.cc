@@ -65,6 +65,117 @@ StackVM::State* StackVM::ThreadLocalState() { return StackVMStateStore::Get(); }
     pc += 2;                                                \
   }
 
+/*!
+ * \brief X-macro listing every opcode, in the declaration order of StackVM::OpCode.
+ * \note Used to build the direct-threaded dispatch table; keep in sync with the enum.
+ */
+#define STACK_VM_OPCODE_LIST(F)                                                                    \
+  F(ADD_I64)                                                                                       \
+  F(SUB_I64)                                                                                       \
+  F(MUL_I64)                                                                                       \
+  F(DIV_I64)                                                                                       \
+  F(MOD_I64)                                                                                       \
+  F(EQ_I64)                                                                                        \
+  F(LT_I64)                                                                                        \
+  F(LE_I64)                                                                                        \
+  F(ADD_F64)                                                                                       \
+  F(SUB_F64)                                                                                       \
+  F(MUL_F64)                                                                                       \
+  F(DIV_F64)                                                                                       \
+  F(EQ_F64)                                                                                        \
+  F(LT_F64)                                                                                        \
+  F(LE_F64)                                                                                        \
+  F(EQ_HANDLE)                                                                                     \
+  F(ARRAY_LOAD_UINT32)                                                                             \
+  F(ARRAY_LOAD_INT32)                                                                              \
+  F(ARRAY_LOAD_INT64)                                                                              \
+  F(ARRAY_LOAD_FP64)                                                                               \
+  F(ARRAY_LOAD_HANDLE)                                                                             \
+  F(ARRAY_LOAD_TVMVALUE)                                                                           \
+  F(ARRAY_STORE_UINT32)                                                                            \
+  F(ARRAY_STORE_INT32)                                                                             \
+  F(ARRAY_STORE_INT64)                                                                             \
+  F(ARRAY_STORE_FP64)                                                                              \
+  F(ARRAY_STORE_HANDLE)                                                                            \
+  F(ARRAY_STORE_TVMVALUE)                                                                          \
+  F(NOT)                                                                                           \
+  F(ADDR_ADD)                                                                                      \
+  F(PUSH_I64)                                                                                      \
+  F(PUSH_VALUE)                                                                                    \
+  F(LOAD_HEAP)                                                                                     \
+  F(STORE_HEAP)                                                                                    \
+  F(POP)                                                                                           \
+  F(SELECT)                                                                                        \
+  F(ASSERT)                                                                                        \
+  F(RJUMP_IF_TRUE)                                                                                 \
+  F(RJUMP_IF_FALSE)                                                                                \
+  F(RJUMP)                                                                                         \
+  F(ASSERT_SP)                                                                                     \
+  F(CALL_PACKED_LOWERED)                                                                           \
+  F(TVM_STACK_ALLOCA_BY_8BYTE)                                                                     \
+  F(TVM_DEVICE_ALLOCA)                                                                             \
+  F(TVM_DEVICE_FREE)                                                                               \
+  F(TVM_THROW_LAST_ERROR)                                                                          \
+  F(TVM_STRUCT_GET)                                                                                \
+  F(TVM_STRUCT_SET)
+
+// Instruction dispatch of the interpreter loop.
+//
+// On compilers that support labels-as-values we use direct-threaded dispatch:
+// every handler jumps straight to the handler of the next instruction through
+// a table of label addresses instead of going back to a central switch. This
+// gives the branch predictor one indirect branch per handler so it can key on
+// instruction pairs, which measurably lowers the per-instruction overhead of
+// the argument-marshalling glue this VM runs. The switch-based loop is kept
+// as the portable fallback and both share the same handler bodies.
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_STACKVM_THREADED_DISPATCH 1
+#else
+#define TVM_STACKVM_THREADED_DISPATCH 0
+#endif
+
+#if TVM_STACKVM_THREADED_DISPATCH
+
+#define STACK_VM_LABEL_ADDR(OP) &&LABEL_##OP,
+
+#define STACK_VM_DISPATCH_LOOP_BEGIN()                                               \
+  static const void* dispatch_table[] = {STACK_VM_OPCODE_LIST(STACK_VM_LABEL_ADDR)}; \
+  static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) ==                \
+                    static_cast<size_t>(StackVM::TVM_STRUCT_SET) + 1,                \
+                "dispatch table must cover every opcode");                           \
+  STACK_VM_DISPATCH_NEXT();
+
+#define STACK_VM_DISPATCH_LOOP_END() \
+  stack_vm_exit:;
+
+#define STACK_VM_CASE(OP) LABEL_##OP:
+
+#define STACK_VM_DISPATCH_NEXT()                         \
+  {                                                      \
+    ICHECK_GE(sp, alloca_sp) << "touch allocated space"; \
+    ICHECK_LT(sp, stack_cap) << "Stack overflow";        \
+    if (pc >= code_size) goto stack_vm_exit;             \
+    goto* dispatch_table[code[pc].op_code];              \
+  }
+
+#else
+
+#define STACK_VM_DISPATCH_LOOP_BEGIN() \
+  while (pc < code_size) {             \
+    switch (code[pc].op_code) {
+
+#define STACK_VM_DISPATCH_LOOP_END()                     \
+    }                                                    \
+    ICHECK_GE(sp, alloca_sp) << "touch allocated space"; \
+    ICHECK_LT(sp, stack_cap) << "Stack overflow";        \
+  }
+
+#define STACK_VM_CASE(OP) case OP:
+
+#define STACK_VM_DISPATCH_NEXT() break
+
+#endif
+
 #define STACK_VM_PRINT_CODE0(CODE)                  \
   case CODE: {                                      \
     os << "[" << pc << "]\t" << #CODE << std::endl; \
@@ -251,177 +362,176 @@ void StackVM::Run(State* s) const {
     heap.resize(heap_size);
   }
   const int64_t code_size = static_cast<int64_t>(code.size());
-  while (pc < code_size) {
-    switch (code[pc].op_code) {
-      case ADD_I64:
+  STACK_VM_DISPATCH_LOOP_BEGIN();
+      STACK_VM_CASE(ADD_I64)
         STACK_VM_BINOP(+, v_int64);
-        break;
-      case SUB_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(SUB_I64)
         STACK_VM_BINOP(-, v_int64);
-        break;
-      case MUL_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(MUL_I64)
         STACK_VM_BINOP(*, v_int64);
-        break;
-      case DIV_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(DIV_I64)
         STACK_VM_BINOP(/, v_int64);
-        break;
-      case MOD_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(MOD_I64)
         STACK_VM_BINOP(%, v_int64);
-        break;
-      case EQ_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(EQ_I64)
         STACK_VM_CMPOP(==, v_int64);
-        break;
-      case LT_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(LT_I64)
         STACK_VM_CMPOP(<, v_int64);
-        break;
-      case LE_I64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(LE_I64)
         STACK_VM_CMPOP(<=, v_int64);
-        break;
-      case ADD_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ADD_F64)
         STACK_VM_BINOP(+, v_float64);
-        break;
-      case SUB_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(SUB_F64)
         STACK_VM_BINOP(-, v_float64);
-        break;
-      case MUL_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(MUL_F64)
         STACK_VM_BINOP(*, v_float64);
-        break;
-      case DIV_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(DIV_F64)
         STACK_VM_BINOP(/, v_float64);
-        break;
-      case EQ_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(EQ_F64)
         STACK_VM_CMPOP(==, v_float64);
-        break;
-      case LT_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(LT_F64)
         STACK_VM_CMPOP(<, v_float64);
-        break;
-      case LE_F64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(LE_F64)
         STACK_VM_CMPOP(<=, v_float64);
-        break;
-      case EQ_HANDLE:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(EQ_HANDLE)
         STACK_VM_CMPOP(==, v_handle);
-        break;
+        STACK_VM_DISPATCH_NEXT();
       // addressing
-      case ARRAY_LOAD_UINT32:
+      STACK_VM_CASE(ARRAY_LOAD_UINT32)
         STACK_VM_LOAD(.v_int64, int64_t, uint32_t);
-        break;
-      case ARRAY_LOAD_INT32:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_LOAD_INT32)
         STACK_VM_LOAD(.v_int64, int64_t, int32_t);
-        break;
-      case ARRAY_LOAD_INT64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_LOAD_INT64)
         STACK_VM_LOAD(.v_int64, int64_t, int64_t);
-        break;
-      case ARRAY_LOAD_FP64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_LOAD_FP64)
         STACK_VM_LOAD(.v_float64, double, double);
-        break;
-      case ARRAY_LOAD_HANDLE:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_LOAD_HANDLE)
         STACK_VM_LOAD(.v_handle, void*, void*);
-        break;
-      case ARRAY_LOAD_TVMVALUE:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_LOAD_TVMVALUE)
         STACK_VM_LOAD(, TVMValue, TVMValue);
-        break;
+        STACK_VM_DISPATCH_NEXT();
       // store
-      case ARRAY_STORE_UINT32:
+      STACK_VM_CASE(ARRAY_STORE_UINT32)
         STACK_VM_STORE(.v_int64, uint32_t);
-        break;
-      case ARRAY_STORE_INT32:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_STORE_INT32)
         STACK_VM_STORE(.v_int64, int32_t);
-        break;
-      case ARRAY_STORE_INT64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_STORE_INT64)
         STACK_VM_STORE(.v_int64, int64_t);
-        break;
-      case ARRAY_STORE_FP64:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_STORE_FP64)
         STACK_VM_STORE(.v_float64, double);
-        break;
-      case ARRAY_STORE_HANDLE:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_STORE_HANDLE)
         STACK_VM_STORE(.v_handle, void*);
-        break;
-      case ARRAY_STORE_TVMVALUE:
+        STACK_VM_DISPATCH_NEXT();
+      STACK_VM_CASE(ARRAY_STORE_TVMVALUE)
         STACK_VM_STORE(, TVMValue);
-        break;
+        STACK_VM_DISPATCH_NEXT();
       // add
-      case ADDR_ADD: {
+      STACK_VM_CASE(ADDR_ADD) {
         stack[sp - 1].v_handle = (char*)(stack[sp - 1].v_handle) + stack[sp].v_int64;  // NOLINT(*)
         sp = sp - 1;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case NOT: {
+      STACK_VM_CASE(NOT) {
         stack[sp].v_int64 = !stack[sp].v_int64;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case PUSH_I64: {
+      STACK_VM_CASE(PUSH_I64) {
         stack[sp + 1].v_int64 = code[pc + 1].v_int;
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case PUSH_VALUE: {
+      STACK_VM_CASE(PUSH_VALUE) {
         int relpos = code[pc + 1].v_int;
         ICHECK_LE(relpos, 0);
         stack[sp + 1] = stack[sp + relpos];
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case POP: {
+      STACK_VM_CASE(POP) {
         sp -= 1;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case SELECT: {
+      STACK_VM_CASE(SELECT) {
         stack[sp - 2] = (stack[sp].v_int64 ? stack[sp - 2] : stack[sp - 1]);
         sp -= 2;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case LOAD_HEAP: {
+      STACK_VM_CASE(LOAD_HEAP) {
         stack[sp + 1] = heap[code[pc + 1].v_int];
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case STORE_HEAP: {
+      STACK_VM_CASE(STORE_HEAP) {
         heap[code[pc + 1].v_int] = stack[sp];
         sp -= 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case ASSERT: {
+      STACK_VM_CASE(ASSERT) {
         ICHECK(stack[sp].v_int64) << str_data[code[pc + 1].v_int];
         sp -= 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case RJUMP_IF_TRUE: {
+      STACK_VM_CASE(RJUMP_IF_TRUE) {
         if (stack[sp].v_int64) {
           pc += code[pc + 1].v_int;
         } else {
           pc += 2;
         }
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case RJUMP_IF_FALSE: {
+      STACK_VM_CASE(RJUMP_IF_FALSE) {
         if (!stack[sp].v_int64) {
           pc += code[pc + 1].v_int;
         } else {
           pc += 2;
         }
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case RJUMP: {
+      STACK_VM_CASE(RJUMP) {
         pc += code[pc + 1].v_int;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case ASSERT_SP: {
+      STACK_VM_CASE(ASSERT_SP) {
         int64_t expected = code[pc + 1].v_int;
         ICHECK_EQ(sp, expected) << "sp assertion failed, expected=" << expected << " now=" << sp
                                 << ", pc=" << pc;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case CALL_PACKED_LOWERED: {
+      STACK_VM_CASE(CALL_PACKED_LOWERED) {
         // call packed function.
         TVMValue* value_stack = static_cast<TVMValue*>(stack[sp - 1].v_handle);
         int* type_stack = static_cast<int*>(stack[sp].v_handle);
@@ -436,10 +546,10 @@ void StackVM::Run(State* s) const {
         sp = sp - 1;
         stack[sp] = rv.value();
         pc += 4;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
       // intrinsics
-      case TVM_STRUCT_GET: {
+      STACK_VM_CASE(TVM_STRUCT_GET) {
         int index = code[pc + 1].v_int;
         int kind = code[pc + 2].v_int;
         DLTensor* arr = static_cast<DLTensor*>(stack[sp].v_handle);
@@ -496,9 +606,9 @@ void StackVM::Run(State* s) const {
             LOG(FATAL) << "unhandled get " << kind;
         }
         pc = pc + 3;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case TVM_STRUCT_SET: {
+      STACK_VM_CASE(TVM_STRUCT_SET) {
         int index = code[pc + 1].v_int;
         int kind = code[pc + 2].v_int;
         DLTensor* arr = static_cast<DLTensor*>(stack[sp - 1].v_handle);
@@ -552,10 +662,10 @@ void StackVM::Run(State* s) const {
         }
         sp -= 2;
         pc += 3;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
       // alloca
-      case TVM_STACK_ALLOCA_BY_8BYTE: {
+      STACK_VM_CASE(TVM_STACK_ALLOCA_BY_8BYTE) {
         static_assert(sizeof(TVMValue) == 8, "invariance");
         int num = code[pc + 1].v_int;
         void* addr = &stack[sp] + 1;
@@ -563,9 +673,9 @@ void StackVM::Run(State* s) const {
         alloca_sp = sp - 1;
         stack[sp].v_handle = addr;
         pc = pc + 2;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case TVM_DEVICE_ALLOCA: {
+      STACK_VM_CASE(TVM_DEVICE_ALLOCA) {
         int device_type = static_cast<int>(stack[sp - 4].v_int64);
         int device_id = static_cast<int>(stack[sp - 3].v_int64);
         size_t nbytes = static_cast<size_t>(stack[sp - 2].v_int64);
@@ -576,9 +686,9 @@ void StackVM::Run(State* s) const {
         stack[sp - 4].v_handle = ptr;
         sp = sp - 4;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case TVM_DEVICE_FREE: {
+      STACK_VM_CASE(TVM_DEVICE_FREE) {
         int device_type = static_cast<int>(stack[sp - 2].v_int64);
         int device_id = static_cast<int>(stack[sp - 1].v_int64);
         void* ptr = stack[sp].v_handle;
@@ -586,16 +696,13 @@ void StackVM::Run(State* s) const {
         stack[sp - 2].v_int64 = ret;
         sp = sp - 2;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-      case TVM_THROW_LAST_ERROR: {
+      STACK_VM_CASE(TVM_THROW_LAST_ERROR) {
         LOG(FATAL) << TVMGetLastError();
-        break;
+        STACK_VM_DISPATCH_NEXT();
       }
-    }
-    ICHECK_GE(sp, alloca_sp) << "touch allocated space";
-    ICHECK_LT(sp, stack_cap) << "Stack overflow";
-  }
+  STACK_VM_DISPATCH_LOOP_END();
 }
 
 const PackedFunc& StackVM::GetExtern(State* s, int fid) const {
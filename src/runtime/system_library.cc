@@ -26,12 +26,76 @@
 #include <tvm/runtime/registry.h>
 
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "library_module.h"
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TVM_SYSLIB_HOST_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define TVM_SYSLIB_HOST_X86 0
+#endif
+
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Query the CPU feature tags the host supports, most specific first.
+ *
+ *  The tags name the feature levels ISA-variant symbols can be compiled for,
+ *  see runtime::symbol::tvm_isa_variant_infix. Detection runs once via CPUID;
+ *  non-x86 hosts report no tags and always use the plain symbols.
+ */
+const std::vector<std::string>& HostIsaVariantTags() {
+  static const std::vector<std::string> tags = []() {
+    std::vector<std::string> result;
+#if TVM_SYSLIB_HOST_X86
+    auto cpuid = [](unsigned leaf, unsigned subleaf, unsigned out[4]) {
+#if defined(_MSC_VER)
+      int regs[4];
+      __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+      for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned>(regs[i]);
+#else
+      out[0] = out[1] = out[2] = out[3] = 0;
+      __get_cpuid_count(leaf, subleaf, &out[0], &out[1], &out[2], &out[3]);
+#endif
+    };
+    unsigned leaf1[4], leaf7[4];
+    cpuid(1, 0, leaf1);
+    cpuid(7, 0, leaf7);
+    bool has_sse42 = (leaf1[2] & (1u << 20)) != 0;
+    // AVX needs OS support for the extended register state as well: the
+    // OSXSAVE bit tells us xgetbv is usable, XCR0 tells us which state the
+    // OS actually saves on context switches.
+    uint64_t xcr0 = 0;
+    if ((leaf1[2] & (1u << 27)) != 0) {  // OSXSAVE
+#if defined(_MSC_VER)
+      xcr0 = _xgetbv(0);
+#else
+      unsigned eax, edx;
+      __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+      xcr0 = (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+    bool os_avx = (xcr0 & 0x6) == 0x6;            // XMM and YMM state
+    bool os_avx512 = (xcr0 & 0xe6) == 0xe6;       // plus opmask and ZMM state
+    bool has_avx2 = os_avx && (leaf1[2] & (1u << 28)) != 0 && (leaf7[1] & (1u << 5)) != 0;
+    bool has_avx512 = os_avx512 && (leaf7[1] & (1u << 16)) != 0;  // AVX512F
+    if (has_avx512) result.push_back("avx512");
+    if (has_avx2) result.push_back("avx2");
+    if (has_sse42) result.push_back("sse42");
+#endif
+    return result;
+  }();
+  return tags;
+}
+
 class SystemLibSymbolRegistry {
  public:
   void RegisterSymbol(const std::string& name, void* ptr) {
@@ -73,13 +137,27 @@ class SystemLibrary : public Library {
   void* GetSymbol(const char* name) {
     if (symbol_prefix_.length() != 0) {
       std::string name_with_prefix = symbol_prefix_ + name;
-      void* symbol = reg_->GetSymbol(name_with_prefix.c_str());
+      void* symbol = GetBestVariant(name_with_prefix);
       if (symbol != nullptr) return symbol;
     }
-    return reg_->GetSymbol(name);
+    return GetBestVariant(name);
   }
 
  private:
+  /*!
+   * \brief Look up the most specific ISA variant of a symbol the host supports.
+   * \param name The plain symbol name.
+   * \return The variant address, the plain symbol on fallback, or nullptr.
+   */
+  void* GetBestVariant(const std::string& name) {
+    for (const std::string& tag : HostIsaVariantTags()) {
+      std::string variant_name = name + symbol::tvm_isa_variant_infix + tag;
+      void* symbol = reg_->GetSymbol(variant_name.c_str());
+      if (symbol != nullptr) return symbol;
+    }
+    return reg_->GetSymbol(name.c_str());
+  }
+
   SystemLibSymbolRegistry* reg_ = SystemLibSymbolRegistry::Global();
   std::string symbol_prefix_;
 };
@@ -34,6 +34,7 @@
 #endif
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstring>
 #include <memory>
@@ -60,6 +61,14 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+// Time budget in microseconds an idle worker keeps spinning before it backs
+// off to a condition-variable sleep; negative disables the persistent-spin
+// mode. Configured via threading::Configure or TVM_THREAD_POOL_SPIN_WAIT_US.
+std::atomic<int64_t> spin_wait_budget_us{[]() -> int64_t {
+  const char* val = getenv("TVM_THREAD_POOL_SPIN_WAIT_US");
+  return val ? atoll(val) : -1;
+}()};
+
 }  // namespace
 
 // stride in the page, fit to cache line.
@@ -71,8 +80,11 @@ constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 class ParallelLauncher {
  public:
   // Reset the task request.
-  void Init(FTVMParallelLambda flambda, void* cdata, int num_task, bool need_sync) {
+  void Init(FTVMParallelLambda flambda, void* cdata, int num_task, bool need_sync,
+            bool work_stealing = false) {
     num_pending_.store(num_task);
+    dyn_num_task_ = work_stealing ? num_task : 0;
+    dyn_task_index_.store(0, std::memory_order_relaxed);
     this->cdata = cdata;
     this->flambda = flambda;
     this->env.num_task = num_task;
@@ -119,6 +131,28 @@ class ParallelLauncher {
   }
   // Signal that one job has finished.
   void SignalJobFinish() { num_pending_.fetch_sub(1); }
+  // Claim the next unassigned task id of a work-stealing launch.
+  // Returns -1 once all task ids have been claimed.
+  int32_t FetchDynamicTask() {
+    int32_t task_id = dyn_task_index_.fetch_add(1, std::memory_order_relaxed);
+    return task_id < dyn_num_task_ ? task_id : -1;
+  }
+  // Set the number of workers participating in a work-stealing launch.
+  void ResetDynamicWorkers(int32_t num_workers) {
+    dyn_workers_active_.store(num_workers, std::memory_order_relaxed);
+  }
+  // Signal that this worker observed the exhausted task range and will no
+  // longer touch the state of this launch.
+  void LeaveDynamicLaunch() { dyn_workers_active_.fetch_sub(1, std::memory_order_release); }
+  // Wait until every participating worker has left the launch. A straggler
+  // that ran the last task keeps fetching until it sees -1, and Init of the
+  // next launch resets the claim range non-atomically, so the launch must
+  // not complete while a worker can still fetch from the old range.
+  void WaitDynamicWorkers() {
+    while (dyn_workers_active_.load(std::memory_order_acquire) != 0) {
+      tvm::runtime::threading::Yield();
+    }
+  }
   // Get thread local version of the store.
   static ParallelLauncher* ThreadLocal() { return dmlc::ThreadLocalStore<ParallelLauncher>::Get(); }
   // The parallel lambda
@@ -140,13 +174,61 @@ class ParallelLauncher {
   std::atomic<int32_t>* sync_counter_{nullptr};
   // The error message
   std::vector<std::string> par_errors_;
+  // Next task id to be claimed in a work-stealing launch.
+  std::atomic<int32_t> dyn_task_index_{0};
+  // Total number of tasks of a work-stealing launch, 0 when in static mode.
+  int32_t dyn_num_task_{0};
+  // Number of workers of a work-stealing launch still able to claim task ids.
+  std::atomic<int32_t> dyn_workers_active_{0};
+};
+
+/*!
+ * \brief Thread local state of a pool worker, used by nested launches to
+ *  locate the pool and the worker's position in it.
+ */
+struct WorkerEnv {
+  /*! \brief The pool this worker belongs to, nullptr on non-worker threads. */
+  class ThreadPool* pool{nullptr};
+  /*! \brief The worker id inside the pool. */
+  int worker_id{-1};
+  static WorkerEnv* ThreadLocal() {
+    static thread_local WorkerEnv env;
+    return &env;
+  }
 };
 
+/*!
+ * \brief Thread local launcher reserved for nested launches, so leading a
+ *  team does not clobber the launch state the leading thread is part of.
+ */
+struct NestedLaunchState {
+  ParallelLauncher launcher;
+  /*! \brief Whether this thread is currently inside a nested launch. */
+  bool active{false};
+  static NestedLaunchState* ThreadLocal() {
+    static thread_local NestedLaunchState state;
+    return &state;
+  }
+};
+
+// Run a launch serially on the calling thread. Task 0 of a single-task
+// group covers the whole iteration space of the generated strided loop,
+// and the barrier degenerates to a no-op.
+int RunSerialLaunch(FTVMParallelLambda flambda, void* cdata) {
+  std::atomic<int32_t> sync_counter{0};
+  TVMParallelGroupEnv env;
+  env.num_task = 1;
+  env.sync_handle = &sync_counter;
+  return (*flambda)(0, &env, cdata) == 0 ? 0 : -1;
+}
+
 /*! \brief Lock-free single-producer-single-consumer queue for each thread */
 class SpscTaskQueue {
  public:
   /*! \brief The task entry */
   struct Task {
+    /*! \brief Sentinel task id that tells a worker to claim ids from the launcher instead. */
+    static constexpr int32_t kWorkStealingTaskId = -1;
     ParallelLauncher* launcher;
     int32_t task_id;
   };
@@ -176,11 +258,26 @@ class SpscTaskQueue {
    * \return Whether pop is successful (true) or we need to exit now (false).
    */
   bool Pop(Task* output, uint32_t spin_count) {
-    // Busy wait a bit when the queue is empty.
-    // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
-    // The default spin count is set by following the typical omp convention
-    for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
-      tvm::runtime::threading::Yield();
+    const int64_t spin_budget_us = spin_wait_budget_us.load(std::memory_order_relaxed);
+    if (spin_budget_us >= 0) {
+      // Persistent-spin mode: keep spinning within the configured time budget
+      // so short kernels never pay the condition-variable wakeup latency, then
+      // back off to sleep like the default path.
+      auto start = std::chrono::steady_clock::now();
+      while (pending_.load() == 0) {
+        tvm::runtime::threading::Yield();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        if (elapsed > spin_budget_us) break;
+      }
+    } else {
+      // Busy wait a bit when the queue is empty.
+      // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
+      // The default spin count is set by following the typical omp convention
+      for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
+        tvm::runtime::threading::Yield();
+      }
     }
     if (pending_.fetch_sub(1) == 0) {
       std::unique_lock<std::mutex> lock(mutex_);
@@ -264,6 +361,10 @@ class ThreadPool {
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
     }
+    const char* num_teams = getenv("TVM_THREAD_POOL_NUM_TEAMS");
+    if (num_teams) {
+      num_teams_ = std::max(1, atoi(num_teams));
+    }
     Init();
   }
 
@@ -288,6 +389,18 @@ class ThreadPool {
     ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
     ICHECK(!launcher->is_worker)
         << "Cannot launch parallel job inside worker, consider fuse then parallel";
+    if (in_launch_) {
+      // Nested launch from the task the main thread runs in place of worker 0.
+      // The main thread leads team 0 when teams are active, otherwise the
+      // nested job runs serially.
+      if (team_size_ > 1 && exclude_worker0_) {
+        return NestedLaunch(flambda, cdata, num_task, /*lead_worker_id=*/0);
+      }
+      return RunSerialLaunch(flambda, cdata);
+    }
+    if (num_teams_ > 1) {
+      return LaunchTeams(flambda, cdata, num_task, need_sync);
+    }
     if (num_task == 0) {
       num_task = num_workers_used_;
     }
@@ -296,9 +409,33 @@ class ThreadPool {
           << "Request parallel sync task larger than number of threads used "
           << " workers=" << num_workers_used_ << " request=" << num_task;
     }
-    launcher->Init(flambda, cdata, num_task, need_sync != 0);
+    launcher->Init(flambda, cdata, num_task, need_sync != 0, work_stealing_);
+    in_launch_ = true;
     SpscTaskQueue::Task tsk;
     tsk.launcher = launcher;
+    if (work_stealing_) {
+      // Every signalled worker claims task ids from the launcher's shared range,
+      // so a worker on a slow core takes fewer chunks while fast cores keep
+      // stealing the remainder instead of idling at the barrier.
+      tsk.task_id = SpscTaskQueue::Task::kWorkStealingTaskId;
+      int num_signal = std::min(num_task, num_workers_used_);
+      // The main thread stands in for worker 0, so num_signal participants
+      // claim from the shared range either way.
+      launcher->ResetDynamicWorkers(num_signal);
+      for (int i = exclude_worker0_; i < num_signal; ++i) {
+        queues_[i]->Push(tsk);
+      }
+      if (exclude_worker0_) {
+        RunDynamicTasks(launcher);
+      }
+      int res = launcher->WaitForJobs();
+      // num_pending_ reaches zero as soon as the last task finishes, but a
+      // straggler that ran it may still be about to fetch from this launch;
+      // do not let the next launch reinitialize the launcher under it.
+      launcher->WaitDynamicWorkers();
+      in_launch_ = false;
+      return res;
+    }
     // if worker0 is taken by the main, queues_[0] is abandoned
     for (int i = exclude_worker0_; i < num_task; ++i) {
       tsk.task_id = i;
@@ -314,6 +451,55 @@ class ThreadPool {
       }
     }
     int res = launcher->WaitForJobs();
+    in_launch_ = false;
+    return res;
+  }
+
+  /*!
+   * \brief Launch a nested parallel job from inside a running task.
+   *
+   *  The lead lane of a team fans the tasks out across its own lanes, whose
+   *  queues are idle at this point because team-mode launches only signal the
+   *  leads; the lead is thus the unique producer for those queues until the
+   *  nested launch finishes, preserving their SPSC invariant. Any other
+   *  caller, or a caller already inside a nested launch, runs the whole job
+   *  serially as a single task.
+   * \param flambda The parallel function to be launched.
+   * \param cdata The closure data.
+   * \param num_task The requested number of tasks, clamped to the team size.
+   * \param lead_worker_id The worker id of the caller, 0 for the main thread.
+   * \return 0 when no error happens, -1 when failure happens
+   */
+  int NestedLaunch(FTVMParallelLambda flambda, void* cdata, int num_task, int lead_worker_id) {
+    int team_size = team_size_;
+    NestedLaunchState* state = NestedLaunchState::ThreadLocal();
+    if (team_size <= 1 || lead_worker_id % team_size != 0 || state->active) {
+      return RunSerialLaunch(flambda, cdata);
+    }
+    if (num_task == 0 || num_task > team_size) {
+      num_task = team_size;
+    }
+    if (num_task == 1) {
+      return RunSerialLaunch(flambda, cdata);
+    }
+    ParallelLauncher* launcher = &(state->launcher);
+    launcher->Init(flambda, cdata, num_task, /*need_sync=*/true);
+    state->active = true;
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    for (int i = 1; i < num_task; ++i) {
+      tsk.task_id = i;
+      queues_[lead_worker_id + i]->Push(tsk);
+    }
+    // the lead runs lane 0 in place
+    TVMParallelGroupEnv* penv = &(launcher->env);
+    if ((*flambda)(0, penv, cdata) == 0) {
+      launcher->SignalJobFinish();
+    } else {
+      launcher->SignalJobError(0);
+    }
+    int res = launcher->WaitForJobs();
+    state->active = false;
     return res;
   }
 
@@ -331,6 +517,29 @@ class ThreadPool {
 
   int32_t NumThreads() const { return num_workers_used_; }
 
+  /*!
+   * \brief Enable or disable the work-stealing launch mode.
+   *
+   *  In this mode workers dynamically claim task ids instead of being
+   *  statically assigned one each, which balances load across uneven cores
+   *  (e.g. big.LITTLE). A worker may run several task ids back to back, so the
+   *  mode must not be used with kernels that call TVMBackendParallelBarrier.
+   * \param enable Whether to enable work stealing.
+   */
+  void SetWorkStealing(bool enable) { work_stealing_ = enable; }
+
+  /*!
+   * \brief Set the number of worker teams for nested parallelism.
+   *
+   *  With n > 1 teams, a top-level launch runs task i on the lead worker of
+   *  team i, and a nested TVMBackendParallelLaunch from inside that task fans
+   *  out across the lanes of the team. The outer task id thus serves as the
+   *  team id and the inner one as the lane id. Team-mode launches are always
+   *  statically assigned, ignoring the work-stealing mode.
+   * \param n The number of teams, 1 restores flat single-level launches.
+   */
+  void SetNumTeams(int n) { num_teams_ = std::max(1, n); }
+
  private:
   // Shared initialization code
   void Init() {
@@ -344,17 +553,74 @@ class ThreadPool {
     num_workers_used_ = threads_->Configure(threading::ThreadGroup::kBig, 0, exclude_worker0_);
   }
 
+  // Launch in team mode: task i runs on the lead worker of team i and may
+  // fan out across the team's lanes through a nested launch; the lanes other
+  // than the leads stay idle at this level.
+  int LaunchTeams(FTVMParallelLambda flambda, void* cdata, int num_task, int need_sync) {
+    ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
+    int num_teams = std::min(num_teams_, num_workers_used_);
+    team_size_ = num_workers_used_ / num_teams;
+    if (num_task == 0) {
+      num_task = num_teams;
+    }
+    ICHECK_LE(num_task, num_teams) << "Request parallel task larger than number of teams "
+                                   << " teams=" << num_teams << " request=" << num_task;
+    launcher->Init(flambda, cdata, num_task, need_sync != 0);
+    in_launch_ = true;
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    for (int i = exclude_worker0_; i < num_task; ++i) {
+      tsk.task_id = i;
+      queues_[i * team_size_]->Push(tsk);
+    }
+    // use the main thread to run task 0 as the lead of team 0
+    if (exclude_worker0_) {
+      TVMParallelGroupEnv* penv = &(launcher->env);
+      if ((*flambda)(0, penv, cdata) == 0) {
+        launcher->SignalJobFinish();
+      } else {
+        launcher->SignalJobError(0);
+      }
+    }
+    int res = launcher->WaitForJobs();
+    in_launch_ = false;
+    team_size_ = 0;
+    return res;
+  }
+
+  // Claim and run task ids from the shared range of a work-stealing launch.
+  static void RunDynamicTasks(ParallelLauncher* launcher) {
+    TVMParallelGroupEnv* penv = &(launcher->env);
+    void* cdata = launcher->cdata;
+    int32_t task_id;
+    while ((task_id = launcher->FetchDynamicTask()) != -1) {
+      if ((*launcher->flambda)(task_id, penv, cdata) == 0) {
+        launcher->SignalJobFinish();
+      } else {
+        launcher->SignalJobError(task_id);
+      }
+    }
+    launcher->LeaveDynamicLaunch();
+  }
+
   // Internal worker function.
   void RunWorker(int worker_id) {
     SpscTaskQueue* queue = queues_[worker_id].get();
     SpscTaskQueue::Task task;
     ParallelLauncher::ThreadLocal()->is_worker = true;
+    WorkerEnv* worker_env = WorkerEnv::ThreadLocal();
+    worker_env->pool = this;
+    worker_env->worker_id = worker_id;
     // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
     // the global first use of the ThreadPool.
     // TODO(tulloch): should we make this configurable via standard APIs?
     static size_t spin_count = GetSpinCount();
     while (queue->Pop(&task, spin_count)) {
       ICHECK(task.launcher != nullptr);
+      if (task.task_id == SpscTaskQueue::Task::kWorkStealingTaskId) {
+        RunDynamicTasks(task.launcher);
+        continue;
+      }
       TVMParallelGroupEnv* penv = &(task.launcher->env);
       void* cdata = task.launcher->cdata;
       if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
@@ -369,13 +635,25 @@ class ThreadPool {
   int num_workers_used_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
+  // whether workers claim task ids dynamically instead of static assignment
+  bool work_stealing_{false};
+  // number of worker teams for nested parallelism, 1 means flat launches
+  int num_teams_{1};
+  // lanes per team of the team-mode launch in flight, 0 when none is
+  int team_size_{0};
+  // whether a top-level launch of this pool is in flight
+  bool in_launch_{false};
   std::vector<std::unique_ptr<SpscTaskQueue>> queues_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
 
 /*!
  * \brief args[0] is the AffinityMode, args[1] is the number of threads.
- *  args2 is a list of CPUs which is used to set the CPU affinity.
+ *  args[2] is a list of CPUs which is used to set the CPU affinity.
+ *  args[3] optionally enables the work-stealing launch mode, where workers
+ *  claim task ids dynamically to balance load across uneven cores.
+ *  args[4] optionally sets the number of worker teams for nested
+ *  parallelism, 1 restores flat single-level launches.
  */
 TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRetValue* rv) {
   threading::ThreadGroup::AffinityMode mode =
@@ -390,6 +668,14 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRe
     }
   }
   threading::Configure(mode, nthreads, cpus);
+#if !TVM_THREADPOOL_USE_OPENMP
+  if (args.num_args >= 4) {
+    ThreadPool::ThreadLocal()->SetWorkStealing(static_cast<int>(args[3]) != 0);
+  }
+  if (args.num_args >= 5) {
+    ThreadPool::ThreadLocal()->SetNumTeams(static_cast<int>(args[4]));
+  }
+#endif
 });
 
 TVM_REGISTER_GLOBAL("runtime.NumThreads").set_body_typed([]() -> int32_t {
@@ -455,10 +741,17 @@ void ResetThreadPool() { tvm::runtime::ThreadPool::ThreadLocal()->Reset(); }
  *  -3 = kSpecifyThreadShareAllCore).
  * \param nthreads The number of threads to use (0 = use all).
  * \param cpus cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads.
- *
+ * \param worker_spin_wait_us Idle-spin time budget in microseconds before a worker
+ *  backs off to sleep, negative leaves the configured budget unchanged.
  */
 TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode, int nthreads,
-                       std::vector<unsigned int> cpus) {
+                       std::vector<unsigned int> cpus, int64_t worker_spin_wait_us) {
+  // Negative means "not specified": keep whatever budget is in effect, so a
+  // Configure call that only adjusts affinity does not wipe a budget set via
+  // TVM_THREAD_POOL_SPIN_WAIT_US.
+  if (worker_spin_wait_us >= 0) {
+    spin_wait_budget_us.store(worker_spin_wait_us, std::memory_order_relaxed);
+  }
   tvm::runtime::threading::SetMaxConcurrency(cpus.size());
 #if !TVM_THREADPOOL_USE_OPENMP
   tvm::runtime::ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads, cpus);
@@ -482,6 +775,16 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
     return 0;
   } else {
 #if !TVM_THREADPOOL_USE_OPENMP
+    if (tvm::runtime::ParallelLauncher::ThreadLocal()->is_worker) {
+      // Nested launch from inside a running task: the lead lane of a worker
+      // team fans out across its team, any other worker runs the job
+      // serially (see ThreadPool::NestedLaunch).
+      tvm::runtime::WorkerEnv* worker_env = tvm::runtime::WorkerEnv::ThreadLocal();
+      if (worker_env->pool != nullptr) {
+        return worker_env->pool->NestedLaunch(flambda, cdata, num_task, worker_env->worker_id);
+      }
+      return tvm::runtime::RunSerialLaunch(flambda, cdata);
+    }
     int res = tvm::runtime::ThreadPool::ThreadLocal()->Launch(flambda, cdata, num_task, 1);
     return res;
 #else
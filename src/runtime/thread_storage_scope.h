@@ -248,6 +248,10 @@ class LaunchParamConfig {
         ICHECK_EQ(i, launch_param_tags.size() - 1)
             << "kUseDynamicSharedMemoryTag should be the last tag in launch_param_tags.";
         use_dyn_shared_memory_ = true;
+      } else if (tag == launch_param::kUseCooperativeLaunchTag) {
+        // This tag carries no launch argument; it only flags how the kernel
+        // has to be launched.
+        use_cooperative_launch_ = true;
       } else {
         ThreadScope ts = ThreadScope::Create(tag);
         arg_index_map_.push_back(ts.rank * 3 + ts.dim_index);
@@ -279,6 +283,8 @@ class LaunchParamConfig {
   }
   // return the work dim
   size_t work_dim() const { return work_dim_; }
+  // return whether the kernel requires a cooperative launch
+  bool use_cooperative_launch() const { return use_cooperative_launch_; }
 
  private:
   /*! \brief base axis */
@@ -289,6 +295,8 @@ class LaunchParamConfig {
   std::vector<uint32_t> arg_index_map_;
   /*! \brief Whether or not use dynamic shared memory. */
   bool use_dyn_shared_memory_{false};
+  /*! \brief Whether or not the kernel requires a cooperative launch. */
+  bool use_cooperative_launch_{false};
 };
 
 }  // namespace runtime
@@ -47,7 +47,12 @@ extern "C" {
 #define HEXAGON_STACK_ALIGNMENT 32
 #endif
 #include <algorithm>
+#include <cstdlib>
+#include <string>
 #include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #define CURRENT_THREAD_HANDLE (static_cast<std::thread::native_handle_type>(0))
 namespace tvm {
 namespace runtime {
@@ -140,6 +145,39 @@ void SetThreadAffinity(std::thread::native_handle_type thread,
 #endif
 }
 
+#if defined(__linux__) || defined(__ANDROID__)
+/*!
+ * \brief Read a single integer from a sysfs file.
+ * \return The value, or -1 when the file is missing or malformed.
+ */
+static int64_t ReadSysfsInt(const std::string& path) {
+  std::ifstream ifs(path);
+  int64_t value = -1;
+  if (!ifs.fail() && !(ifs >> value)) {
+    value = -1;
+  }
+  return value;
+}
+
+/*!
+ * \brief Parse a sysfs cpu list such as "0-3,8,10-11".
+ */
+static std::vector<unsigned int> ParseSysfsCpuList(const std::string& str) {
+  std::vector<unsigned int> cpus;
+  std::istringstream is(str);
+  std::string item;
+  while (std::getline(is, item, ',')) {
+    size_t dash = item.find('-');
+    unsigned int first = std::atoi(item.c_str());
+    unsigned int last = dash == std::string::npos ? first : std::atoi(item.c_str() + dash + 1);
+    for (unsigned int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+#endif
+
 thread_local int max_concurrency = 0;
 class ThreadGroup::Impl {
  public:
@@ -150,6 +188,7 @@ class ThreadGroup::Impl {
       threads_.emplace_back([worker_callback, i] { worker_callback(i); });
     }
     InitSortedOrder();
+    DiscoverTopology();
   }
   ~Impl() { Join(); }
 
@@ -174,6 +213,18 @@ class ThreadGroup::Impl {
         num_workers_used = cpus.size();
         sorted_order_ = cpus;
         break;
+      case kOnePerPhysicalCore:
+        sorted_order_ = OnePerPhysicalCoreOrder();
+        num_workers_used = static_cast<int>(sorted_order_.size());
+        break;
+      case kSpecifyOneLLCDomain:
+        sorted_order_ = OneLLCDomainOrder();
+        num_workers_used = static_cast<int>(sorted_order_.size());
+        break;
+      case kExcludeEfficiencyCores:
+        sorted_order_ = ExcludeEfficiencyCoresOrder();
+        num_workers_used = static_cast<int>(sorted_order_.size());
+        break;
       default:
         // use default
         num_workers_used = threading::MaxConcurrency();
@@ -204,10 +255,13 @@ class ThreadGroup::Impl {
     // Do not set affinity if there are more workers than found cores and mode is not kSpecify*.
     if (sorted_order_.size() < static_cast<unsigned int>(num_workers_)) {
       switch (mode) {
-        // When the mode is kSpecifyOneCorePerThread or kSpecifyThreadShareAllCore, we should
-        // let the threads share all the cpu cores.
+        // When the mode restricts the workers to an explicit or derived core
+        // list, let the threads share all the listed cores.
         case kSpecifyOneCorePerThread:
         case kSpecifyThreadShareAllCore:
+        case kOnePerPhysicalCore:
+        case kSpecifyOneLLCDomain:
+        case kExcludeEfficiencyCores:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             SetThreadFullCpuAffinity(threads_[i].native_handle(), mode);
           }
@@ -226,6 +280,7 @@ class ThreadGroup::Impl {
       ICHECK_GE(sorted_order_.size(), num_workers_);
       switch (mode) {
         case kSpecifyThreadShareAllCore:
+        case kSpecifyOneLLCDomain:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             SetThreadFullCpuAffinity(threads_[i].native_handle(), mode);
           }
@@ -233,6 +288,8 @@ class ThreadGroup::Impl {
         case kLittle:
         case kBig:
         case kSpecifyOneCorePerThread:
+        case kOnePerPhysicalCore:
+        case kExcludeEfficiencyCores:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             bool reverse = mode == kLittle;
             unsigned core_id;
@@ -272,6 +329,9 @@ class ThreadGroup::Impl {
     switch (mode) {
       case kSpecifyOneCorePerThread:
       case kSpecifyThreadShareAllCore:
+      case kOnePerPhysicalCore:
+      case kSpecifyOneLLCDomain:
+      case kExcludeEfficiencyCores:
         for (size_t i = 0; i < sorted_order_.size(); ++i) {
           ids.push_back(sorted_order_[i]);
         }
@@ -304,6 +364,7 @@ class ThreadGroup::Impl {
     if (threads == 0) threads = 4;
 #endif
     std::vector<std::pair<unsigned int, int64_t>> max_freqs;
+    max_freq_by_cpu_.resize(threads, -1);
 
     for (unsigned int i = 0; i < threads; ++i) {
       int64_t cur_freq = 0;
@@ -323,6 +384,7 @@ class ThreadGroup::Impl {
       }
 #endif
       max_freqs.push_back(std::make_pair(i, cur_freq));
+      max_freq_by_cpu_[i] = cur_freq;
     }
 
     auto fcmpbyfreq = [](const std::pair<unsigned int, int64_t>& a,
@@ -347,6 +409,110 @@ class ThreadGroup::Impl {
     }
   }
 
+  /*!
+   * \brief Discover the cpu topology from sysfs.
+   *
+   *  The max-frequency sorting of InitSortedOrder only separates two core
+   *  classes; hybrid x86 parts and multi-CCX server parts additionally need
+   *  SMT sibling and last-level-cache sharing information to place workers
+   *  well. Missing sysfs entries leave the corresponding ids at -1 and the
+   *  topology-aware modes degrade to the frequency-sorted order.
+   */
+  void DiscoverTopology() {
+#if defined(__linux__) || defined(__ANDROID__)
+    size_t threads = max_freq_by_cpu_.size();
+    physical_core_of_.resize(threads, -1);
+    llc_domain_of_.resize(threads, -1);
+    for (size_t i = 0; i < threads; ++i) {
+      std::ostringstream base;
+      base << "/sys/devices/system/cpu/cpu" << i << "/";
+      int64_t package = ReadSysfsInt(base.str() + "topology/physical_package_id");
+      int64_t core = ReadSysfsInt(base.str() + "topology/core_id");
+      if (package >= 0 && core >= 0) {
+        // core_id is only unique within a package.
+        physical_core_of_[i] = (package << 16) | core;
+      }
+      // The index with the largest level is the last-level cache; the set of
+      // cpus sharing it delimits a CCX / tile / cluster.
+      int64_t llc_level = -1;
+      for (int index = 0; index < 8; ++index) {
+        std::ostringstream cache;
+        cache << base.str() << "cache/index" << index << "/";
+        int64_t level = ReadSysfsInt(cache.str() + "level");
+        if (level <= llc_level) {
+          continue;
+        }
+        std::ifstream ifs(cache.str() + "shared_cpu_list");
+        std::string shared;
+        if (!ifs.fail() && std::getline(ifs, shared)) {
+          std::vector<unsigned int> cpus = ParseSysfsCpuList(shared);
+          if (!cpus.empty()) {
+            llc_level = level;
+            // The domain is keyed by the first cpu sharing the cache.
+            llc_domain_of_[i] = cpus.front();
+          }
+        }
+      }
+    }
+#endif
+  }
+
+  /*! \brief One logical cpu per physical core, fastest cores first. */
+  std::vector<unsigned int> OnePerPhysicalCoreOrder() const {
+    std::vector<unsigned int> order;
+    std::unordered_set<int64_t> seen_cores;
+    for (unsigned int cpu : sorted_order_) {
+      int64_t core = cpu < physical_core_of_.size() ? physical_core_of_[cpu] : -1;
+      // Keep cpus with unknown topology; dropping them could leave no workers.
+      if (core >= 0 && !seen_cores.insert(core).second) {
+        continue;
+      }
+      order.push_back(cpu);
+    }
+    return order;
+  }
+
+  /*! \brief The logical cpus sharing the last-level cache with the fastest core. */
+  std::vector<unsigned int> OneLLCDomainOrder() const {
+    if (sorted_order_.empty()) {
+      return sorted_order_;
+    }
+    unsigned int leader = sorted_order_[0];
+    int64_t domain = leader < llc_domain_of_.size() ? llc_domain_of_[leader] : -1;
+    if (domain < 0) {
+      // Unknown cache topology; no confinement is possible.
+      return sorted_order_;
+    }
+    std::vector<unsigned int> order;
+    for (unsigned int cpu : sorted_order_) {
+      if (cpu < llc_domain_of_.size() && llc_domain_of_[cpu] == domain) {
+        order.push_back(cpu);
+      }
+    }
+    return order;
+  }
+
+  /*! \brief The logical cpus of the fastest frequency class, SMT siblings included. */
+  std::vector<unsigned int> ExcludeEfficiencyCoresOrder() const {
+    int64_t top_freq = -1;
+    for (unsigned int cpu : sorted_order_) {
+      if (cpu < max_freq_by_cpu_.size()) {
+        top_freq = std::max(top_freq, max_freq_by_cpu_[cpu]);
+      }
+    }
+    if (top_freq <= 0) {
+      // Frequencies unknown; there is nothing to exclude by.
+      return sorted_order_;
+    }
+    std::vector<unsigned int> order;
+    for (unsigned int cpu : sorted_order_) {
+      if (cpu < max_freq_by_cpu_.size() && max_freq_by_cpu_[cpu] == top_freq) {
+        order.push_back(cpu);
+      }
+    }
+    return order;
+  }
+
   int num_workers_;
 #if defined(__hexagon__)
   std::vector<QuRTThread> threads_;
@@ -356,6 +522,12 @@ class ThreadGroup::Impl {
   std::vector<unsigned int> sorted_order_;
   int big_count_ = 0;
   int little_count_ = 0;
+  /*! \brief cpuinfo_max_freq per logical cpu; -1 when unknown */
+  std::vector<int64_t> max_freq_by_cpu_;
+  /*! \brief (package, core) key per logical cpu; SMT siblings share a key; -1 when unknown */
+  std::vector<int64_t> physical_core_of_;
+  /*! \brief Last-level-cache domain per logical cpu; -1 when unknown */
+  std::vector<int64_t> llc_domain_of_;
 };
 
 ThreadGroup::ThreadGroup(int num_workers, std::function<void(int)> worker_callback,
@@ -434,6 +606,62 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+/*!
+ * \brief The NUMA topology from sysfs, as the list of cpus of each node.
+ *
+ *  A single empty node stands in for unknown topology (non-Linux platforms or
+ *  sysfs not mounted), which keeps every cpu on node 0.
+ */
+static const std::vector<std::vector<unsigned int>>& NumaTopology() {
+  static const std::vector<std::vector<unsigned int>> nodes = []() {
+    std::vector<std::vector<unsigned int>> result;
+#if defined(__linux__) && !defined(__ANDROID__)
+    for (int node = 0;; ++node) {
+      std::ostringstream path;
+      path << "/sys/devices/system/node/node" << node << "/cpulist";
+      std::ifstream ifs(path.str());
+      std::string line;
+      if (ifs.fail() || !std::getline(ifs, line)) {
+        break;
+      }
+      result.push_back(ParseSysfsCpuList(line));
+    }
+#endif
+    if (result.empty()) {
+      result.push_back({});
+    }
+    return result;
+  }();
+  return nodes;
+}
+
+int NumNumaNodes() { return static_cast<int>(NumaTopology().size()); }
+
+std::vector<unsigned int> NumaNodeCpus(int node) {
+  const auto& nodes = NumaTopology();
+  if (node < 0 || node >= static_cast<int>(nodes.size())) {
+    return {};
+  }
+  return nodes[node];
+}
+
+int CurrentNumaNode() {
+#if defined(__linux__) && !defined(__ANDROID__)
+  int cpu = sched_getcpu();
+  if (cpu >= 0) {
+    const auto& nodes = NumaTopology();
+    for (size_t node = 0; node < nodes.size(); ++node) {
+      for (unsigned int node_cpu : nodes[node]) {
+        if (node_cpu == static_cast<unsigned int>(cpu)) {
+          return static_cast<int>(node);
+        }
+      }
+    }
+  }
+#endif
+  return 0;
+}
+
 // This global function can be used by disco runtime to bind processes
 // to CPUs.
 TVM_REGISTER_GLOBAL("tvm.runtime.threading.set_current_thread_affinity")
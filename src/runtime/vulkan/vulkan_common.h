@@ -45,7 +45,7 @@ static constexpr const int kVulkanModuleMagic = 0x02700027;
 const int kMaxPushConstantsBytes = 128;
 
 /*! \brief A mask used when we attach additional information to shaders */
-enum ShaderMetaDataFlagMask { kUseUBO = 0 };
+enum ShaderMetaDataFlagMask { kUseUBO = 0, kUseSpecConstantWorkgroupSize = 1 };
 
 inline const char* VKGetErrorString(VkResult error) {
   switch (error) {
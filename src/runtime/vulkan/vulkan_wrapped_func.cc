@@ -46,11 +46,15 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
                                    const ArgUnion64* pack_args) const {
   int device_id = VulkanDeviceAPI::Global()->GetActiveDeviceID();
   auto& device = VulkanDeviceAPI::Global()->device(device_id);
-  if (!scache_[device_id]) {
-    scache_[device_id] = m_->GetPipeline(device_id, func_name_, num_pack_args_);
+  ThreadWorkLoad wl = launch_param_config_.Extract(args);
+  const std::array<uint32_t, 3> workgroup_size = {static_cast<uint32_t>(wl.block_dim(0)),
+                                                  static_cast<uint32_t>(wl.block_dim(1)),
+                                                  static_cast<uint32_t>(wl.block_dim(2))};
+  if (!scache_[device_id] || (scache_[device_id]->use_spec_constant_workgroup_size &&
+                              scache_[device_id]->spec_workgroup_size != workgroup_size)) {
+    scache_[device_id] = m_->GetPipeline(device_id, func_name_, num_pack_args_, workgroup_size);
   }
   const auto& pipeline = scache_[device_id];
-  ThreadWorkLoad wl = launch_param_config_.Extract(args);
   std::vector<VkDescriptorBufferInfo> descriptor_buffers;
   descriptor_buffers.resize(num_buffer_args_);
   for (size_t i = 0; i < num_buffer_args_; ++i) {
@@ -113,7 +117,26 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
 
   // Otherwise, the more expensive deferred path.
   std::vector<ArgUnion64> pack_args_storage(pack_args, pack_args + num_pack_args_);
-  const auto& deferred_initializer = [&device, pipeline, descriptor_buffers]() {
+
+  // Prefer a write-once descriptor set keyed on the bindings: reusing it keeps
+  // consecutive launches batched in one command buffer, instead of forcing a
+  // synchronizing submit whenever the shared set would need rewriting.
+  std::vector<VkBuffer> bindings(descriptor_buffers.size());
+  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
+    bindings[i] = descriptor_buffers[i].buffer;
+  }
+  VkDescriptorSet descriptor_set =
+      m_->GetCachedDescriptorSet(device_id, pipeline.get(), bindings, descriptor_buffers);
+  const bool use_cached_set = descriptor_set != VK_NULL_HANDLE;
+  if (!use_cached_set) {
+    descriptor_set = pipeline->descriptor_set;
+  }
+
+  const auto& deferred_initializer = [&device, pipeline, descriptor_buffers, use_cached_set]() {
+    if (use_cached_set) {
+      // The cached set was written when it was created.
+      return;
+    }
     std::vector<VkWriteDescriptorSet> write_descriptor_sets;
     write_descriptor_sets.resize(descriptor_buffers.size());
     for (size_t i = 0; i < write_descriptor_sets.size(); i++) {
@@ -137,14 +160,13 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
     vkUpdateDescriptorSets(device, write_descriptor_sets.size(), write_descriptor_sets.data(), 0,
                            nullptr);
   };
-  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars,
-                                 device_id](VulkanStreamState* state) {
+  const auto& deferred_kernel = [this, pipeline, descriptor_set, wl, pack_args_storage,
+                                 nbytes_scalars, device_id](VulkanStreamState* state) {
     auto& device = VulkanDeviceAPI::Global()->device(device_id);
 
     vkCmdBindPipeline(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
     vkCmdBindDescriptorSets(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            pipeline->pipeline_layout, 0, 1, &(pipeline->descriptor_set), 0,
-                            nullptr);
+                            pipeline->pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
 
     if (pipeline->use_ubo) {
       auto& ubo = device.ThreadLocalUniformBuffer(nbytes_scalars);
@@ -167,11 +189,8 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
                          1, &barrier_info, 0, nullptr, 0, nullptr);
   };
   VulkanStreamToken deferred_token;
-  deferred_token.descriptor_set_ = pipeline->descriptor_set;
-  deferred_token.buffers_.resize(descriptor_buffers.size());
-  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
-    deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
-  }
+  deferred_token.descriptor_set_ = descriptor_set;
+  deferred_token.buffers_ = std::move(bindings);
   device.ThreadLocalStream().LaunchDeferred(deferred_initializer, deferred_kernel, deferred_token);
 
   if (device.UseDebugUtilsLabel()) {
@@ -199,8 +218,16 @@ VulkanModuleNode::~VulkanModuleNode() {
       vkDestroyPipeline(device, pe->pipeline, nullptr);
       vkDestroyPipelineLayout(device, pe->pipeline_layout, nullptr);
       vkDestroyDescriptorPool(device, pe->descriptor_pool, nullptr);
+      for (VkDescriptorPool pool : pe->cache_pools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+      }
       vkDestroyDescriptorSetLayout(device, pe->descriptor_set_layout, nullptr);
-      vkDestroyShaderModule(device, pe->shader, nullptr);
+    }
+    // Shader modules are owned by the shader cache and shared across the
+    // specialized pipelines of a kernel; destroy each of them once.
+    for (auto& kv : shader_cache_[device_id]) {
+      const auto& device = VulkanDeviceAPI::Global()->device(device_id);
+      vkDestroyShaderModule(device, kv.second, nullptr);
     }
   }
 }
@@ -219,30 +246,46 @@ PackedFunc VulkanModuleNode::GetFunction(const String& name,
   return PackFuncNonBufferArg(std::move(f), info.arg_types);
 }
 
-std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
-                                                              const std::string& func_name,
-                                                              size_t num_pack_args) {
+std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(
+    size_t device_id, const std::string& func_name, size_t num_pack_args,
+    const std::array<uint32_t, 3>& workgroup_size) {
   auto& device = VulkanDeviceAPI::Global()->device(device_id);
   std::lock_guard<std::mutex> lock(mutex_);
-  const auto& cp = ecache_[device_id][func_name];
+  auto sit = smap_.find(func_name);
+  ICHECK(sit != smap_.end());
+  const bool use_spec_workgroup_size =
+      sit->second.flag & (1 << ShaderMetaDataFlagMask::kUseSpecConstantWorkgroupSize);
+  // One pipeline is cached per specialization vector; shaders without
+  // specialization constants keep one pipeline per function as before.
+  std::string pipeline_key = func_name;
+  if (use_spec_workgroup_size) {
+    pipeline_key += "_wg" + std::to_string(workgroup_size[0]) + "_" +
+                    std::to_string(workgroup_size[1]) + "_" + std::to_string(workgroup_size[2]);
+  }
+  const auto& cp = ecache_[device_id][pipeline_key];
   if (cp) {
     return cp;
   }
   // Create new pipeline
   auto pe = std::make_shared<VulkanPipeline>();
+  pe->use_spec_constant_workgroup_size = use_spec_workgroup_size;
+  pe->spec_workgroup_size = workgroup_size;
   {
-    // create shader
-    auto sit = smap_.find(func_name);
-    ICHECK(sit != smap_.end());
+    // Create or reuse the shader module; the specializations of a kernel all
+    // share one module, so only the first pipeline pays for the shader build.
     pe->use_ubo = sit->second.flag & (1 << ShaderMetaDataFlagMask::kUseUBO);
-    const std::vector<uint32_t>& data = sit->second.data;
-    VkShaderModuleCreateInfo shader_cinfo;
-    shader_cinfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    shader_cinfo.pNext = nullptr;
-    shader_cinfo.flags = 0;
-    shader_cinfo.codeSize = data.size() * sizeof(uint32_t);
-    shader_cinfo.pCode = data.data();
-    VULKAN_CALL(vkCreateShaderModule(device, &shader_cinfo, nullptr, &(pe->shader)));
+    VkShaderModule& shader = shader_cache_[device_id][func_name];
+    if (shader == VK_NULL_HANDLE) {
+      const std::vector<uint32_t>& data = sit->second.data;
+      VkShaderModuleCreateInfo shader_cinfo;
+      shader_cinfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+      shader_cinfo.pNext = nullptr;
+      shader_cinfo.flags = 0;
+      shader_cinfo.codeSize = data.size() * sizeof(uint32_t);
+      shader_cinfo.pCode = data.data();
+      VULKAN_CALL(vkCreateShaderModule(device, &shader_cinfo, nullptr, &shader));
+    }
+    pe->shader = shader;
   }
   std::vector<VkDescriptorSetLayoutBinding> arg_binding;
   std::vector<VkDescriptorUpdateTemplateEntryKHR> arg_template;
@@ -337,6 +380,9 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     alloc_info.descriptorSetCount = 1;
     alloc_info.pSetLayouts = &(pe->descriptor_set_layout);
     VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &(pe->descriptor_set)));
+
+    // Keep the per-set pool sizes so descriptor set cache pools can be created later.
+    pe->descriptor_pool_sizes = descriptor_set_pool_sizes;
   }
 
   VkPushConstantRange crange;
@@ -379,6 +425,24 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
   pipeline_cinfo.stage.module = pe->shader;
   pipeline_cinfo.stage.pName = func_name.c_str();
   pipeline_cinfo.stage.pSpecializationInfo = nullptr;
+  VkSpecializationMapEntry spec_map_entries[3];
+  uint32_t spec_data[3];
+  VkSpecializationInfo spec_info;
+  if (use_spec_workgroup_size) {
+    // Specialize the workgroup dimensions declared with SpecIds 0/1/2 by the
+    // SPIR-V codegen to the launch-time workgroup size.
+    for (uint32_t i = 0; i < 3; ++i) {
+      spec_map_entries[i].constantID = i;
+      spec_map_entries[i].offset = i * sizeof(uint32_t);
+      spec_map_entries[i].size = sizeof(uint32_t);
+      spec_data[i] = workgroup_size[i];
+    }
+    spec_info.mapEntryCount = 3;
+    spec_info.pMapEntries = spec_map_entries;
+    spec_info.dataSize = sizeof(spec_data);
+    spec_info.pData = spec_data;
+    pipeline_cinfo.stage.pSpecializationInfo = &spec_info;
+  }
   pipeline_cinfo.layout = pe->pipeline_layout;
   pipeline_cinfo.basePipelineHandle = VK_NULL_HANDLE;
   pipeline_cinfo.basePipelineIndex = 0;
@@ -400,10 +464,84 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     VULKAN_CALL(device.descriptor_template_khr_functions->vkCreateDescriptorUpdateTemplateKHR(
         device, &descrip_template_cinfo, nullptr, &(pe->descriptor_update_template)));
   }
-  ecache_[device_id][func_name] = pe;
+  ecache_[device_id][pipeline_key] = pe;
   return pe;
 }
 
+VkDescriptorSet VulkanModuleNode::GetCachedDescriptorSet(
+    size_t device_id, VulkanPipeline* pipeline, const std::vector<VkBuffer>& bindings,
+    const std::vector<VkDescriptorBufferInfo>& buffer_infos) {
+  // Number of descriptor sets per cache pool.
+  static constexpr uint32_t kSetsPerCachePool = 16;
+  // Upper bound on cached sets per pipeline; beyond this, fall back to the
+  // shared set rather than letting pools grow without limit.
+  static constexpr size_t kMaxCachedDescriptorSets = 1024;
+
+  auto& device = VulkanDeviceAPI::Global()->device(device_id);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = pipeline->descriptor_set_cache.find(bindings);
+  if (it != pipeline->descriptor_set_cache.end()) {
+    return it->second;
+  }
+  if (pipeline->descriptor_set_cache.size() >= kMaxCachedDescriptorSets) {
+    return VK_NULL_HANDLE;
+  }
+
+  if (pipeline->cache_pool_remaining == 0) {
+    std::vector<VkDescriptorPoolSize> pool_sizes = pipeline->descriptor_pool_sizes;
+    for (auto& psize : pool_sizes) {
+      psize.descriptorCount *= kSetsPerCachePool;
+    }
+    VkDescriptorPoolCreateInfo pool_cinfo;
+    pool_cinfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_cinfo.pNext = nullptr;
+    pool_cinfo.flags = 0;
+    pool_cinfo.maxSets = kSetsPerCachePool;
+    pool_cinfo.poolSizeCount = pool_sizes.size();
+    pool_cinfo.pPoolSizes = pool_sizes.data();
+    VkDescriptorPool pool;
+    VULKAN_CALL(vkCreateDescriptorPool(device, &pool_cinfo, nullptr, &pool));
+    pipeline->cache_pools.push_back(pool);
+    pipeline->cache_pool_remaining = kSetsPerCachePool;
+  }
+
+  VkDescriptorSetAllocateInfo alloc_info;
+  alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  alloc_info.pNext = nullptr;
+  alloc_info.descriptorPool = pipeline->cache_pools.back();
+  alloc_info.descriptorSetCount = 1;
+  alloc_info.pSetLayouts = &(pipeline->descriptor_set_layout);
+  VkDescriptorSet descriptor_set;
+  VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &descriptor_set));
+  --pipeline->cache_pool_remaining;
+
+  // Written exactly once; the set stays immutable afterwards, so command
+  // buffers that already reference it remain valid.
+  std::vector<VkWriteDescriptorSet> write_descriptor_sets(buffer_infos.size());
+  for (size_t i = 0; i < write_descriptor_sets.size(); i++) {
+    write_descriptor_sets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write_descriptor_sets[i].pNext = nullptr;
+    write_descriptor_sets[i].dstSet = descriptor_set;
+    write_descriptor_sets[i].dstBinding = i;
+    write_descriptor_sets[i].dstArrayElement = 0;
+    write_descriptor_sets[i].descriptorCount = 1;
+    write_descriptor_sets[i].pImageInfo = nullptr;
+    write_descriptor_sets[i].pBufferInfo = &(buffer_infos[i]);
+    write_descriptor_sets[i].pTexelBufferView = nullptr;
+
+    if (pipeline->use_ubo && i == write_descriptor_sets.size() - 1) {
+      // The last binding is for UBO
+      write_descriptor_sets[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    } else {
+      write_descriptor_sets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+  }
+  vkUpdateDescriptorSets(device, write_descriptor_sets.size(), write_descriptor_sets.data(), 0,
+                         nullptr);
+  pipeline->descriptor_set_cache.emplace(bindings, descriptor_set);
+  return descriptor_set;
+}
+
 void VulkanModuleNode::SaveToFile(const String& file_name, const String& format) {
   std::string fmt = GetFileFormat(file_name, format);
   ICHECK_EQ(fmt, fmt_) << "Can only save to customized format vulkan";
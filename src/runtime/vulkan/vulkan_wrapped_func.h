@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../../support/utils.h"
 #include "../meta_data.h"
 #include "../pack_args.h"
 #include "../spirv/spirv_shader.h"
@@ -39,6 +40,17 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+/*! \brief Hash a sequence of buffer bindings for the descriptor set cache. */
+struct VulkanBindingHash {
+  size_t operator()(const std::vector<VkBuffer>& bindings) const {
+    uint64_t hash = bindings.size();
+    for (VkBuffer buffer : bindings) {
+      hash = support::HashCombine(hash, reinterpret_cast<uint64_t>(buffer));
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+
 struct VulkanPipeline {
   VulkanDevice* device{nullptr};
   VkShaderModule shader{VK_NULL_HANDLE};
@@ -49,6 +61,23 @@ struct VulkanPipeline {
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkDescriptorUpdateTemplateKHR descriptor_update_template{VK_NULL_HANDLE};
   bool use_ubo{false};
+  // Whether the shader declares its workgroup size through specialization
+  // constants; if so, the pipeline is specialized to spec_workgroup_size and
+  // the shader module is shared across the specializations of the kernel.
+  bool use_spec_constant_workgroup_size{false};
+  // The workgroup dimensions the pipeline was specialized for.
+  std::array<uint32_t, 3> spec_workgroup_size{{0, 0, 0}};
+  // Write-once descriptor sets keyed on the bound buffers, used on the deferred
+  // path so that repeat launches reuse their bindings instead of rewriting the
+  // shared descriptor_set, which would force a synchronizing submit.
+  std::unordered_map<std::vector<VkBuffer>, VkDescriptorSet, VulkanBindingHash>
+      descriptor_set_cache;
+  // Pools backing the cached descriptor sets; each pool holds several sets.
+  std::vector<VkDescriptorPool> cache_pools;
+  // Number of sets still allocatable from the most recent cache pool.
+  uint32_t cache_pool_remaining{0};
+  // Per-set pool sizes, kept around to size additional cache pools.
+  std::vector<VkDescriptorPoolSize> descriptor_pool_sizes;
 };
 
 class VulkanModuleNode;
@@ -96,8 +125,42 @@ class VulkanModuleNode final : public runtime::ModuleNode {
 
   PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final;
 
+  /*!
+   * \brief Get the pipeline of a kernel function, creating it on first use.
+   *
+   *  When the shader declares its workgroup size through specialization
+   *  constants, one pipeline is cached per workgroup size and all of them
+   *  share a single shader module, so a new shape variant only pays for the
+   *  cheap pipeline specialization instead of a full shader build.
+   *
+   * \param device_id The device to create the pipeline for.
+   * \param func_name The name of the kernel function.
+   * \param num_pack_args Number of packed scalar arguments.
+   * \param workgroup_size The launch-time workgroup dimensions.
+   * \return The cached or newly created pipeline.
+   */
   std::shared_ptr<VulkanPipeline> GetPipeline(size_t device_id, const std::string& func_name,
-                                              size_t num_pack_args);
+                                              size_t num_pack_args,
+                                              const std::array<uint32_t, 3>& workgroup_size);
+
+  /*!
+   * \brief Get a descriptor set bound to the given buffers, creating and writing
+   *        it on first use.
+   *
+   *  The returned set is never rewritten, so command buffers that already
+   *  reference it stay valid and launches with differing bindings no longer have
+   *  to synchronize against each other. Returns VK_NULL_HANDLE once the
+   *  per-pipeline cache is full; callers then fall back to the shared set.
+   *
+   * \param device_id The device the pipeline was created for.
+   * \param pipeline The pipeline owning the cache.
+   * \param bindings The buffers bound to the set, in binding order.
+   * \param buffer_infos The descriptor infos matching \p bindings.
+   * \return The cached descriptor set, or VK_NULL_HANDLE.
+   */
+  VkDescriptorSet GetCachedDescriptorSet(size_t device_id, VulkanPipeline* pipeline,
+                                         const std::vector<VkBuffer>& bindings,
+                                         const std::vector<VkDescriptorBufferInfo>& buffer_infos);
 
   void SaveToFile(const String& file_name, const String& format) final;
 
@@ -114,10 +177,13 @@ class VulkanModuleNode final : public runtime::ModuleNode {
   // The source
   std::string source_;
 
-  // Guards accesses to `ecache_`
+  // Guards accesses to `ecache_` and `shader_cache_`
   std::mutex mutex_;
   std::array<std::unordered_map<std::string, std::shared_ptr<VulkanPipeline>>, kVulkanMaxNumDevice>
       ecache_;
+  // Shader modules keyed by function name, shared across the specialized
+  // pipelines of a kernel. The modules are owned here, not by the pipelines.
+  std::array<std::unordered_map<std::string, VkShaderModule>, kVulkanMaxNumDevice> shader_cache_;
 };
 
 }  // namespace vulkan
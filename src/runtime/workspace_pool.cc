@@ -23,7 +23,12 @@
  */
 #include "workspace_pool.h"
 
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace tvm {
 namespace runtime {
@@ -31,6 +36,104 @@ namespace runtime {
 // page size.
 constexpr size_t kWorkspacePageSize = 4 << 10;
 
+// Planned workspace capacity in bytes. When nonzero, every per-thread pool
+// preallocates one arena of this size and bump-allocates workspaces from it,
+// so steady-state execution never touches the free list or the device
+// allocator. Configured through runtime.ConfigPlannedWorkspace with the
+// high-water mark reported by tir.analysis.calculate_workspace_bytes.
+std::atomic<size_t> planned_arena_bytes{0};
+
+// Whether bump allocation is usable for the device: it offsets the raw base
+// pointer, which is only meaningful for devices whose data space is a plain
+// address (unlike e.g. OpenCL buffer objects).
+inline bool DeviceSupportsArena(Device dev) {
+  return dev.device_type == kDLCPU || dev.device_type == kDLCUDA || dev.device_type == kDLROCM;
+}
+
+/*!
+ * \brief A process-wide cache of workspace pages shared between the
+ *  per-thread pools.
+ *
+ *  The device APIs keep one WorkspacePool per worker thread so that the
+ *  allocation fast path stays lock-free. The downside is that pages held
+ *  by one thread are invisible to the others, so every worker grows its
+ *  own device buffers. This cache backs all the per-thread pools: when a
+ *  pool has to hit the device allocator (new page, resize, or teardown),
+ *  it first tries to adopt a surrendered page here, and pages released by
+ *  a pool are surrendered here instead of being freed. Only these slow
+ *  paths take the lock.
+ */
+class SharedPageCache {
+ public:
+  struct Page {
+    void* data;
+    size_t size;
+  };
+
+  static SharedPageCache* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new SharedPageCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Try to adopt a cached page of at least nbytes for the device.
+   * \return Whether a page was found; on success *page holds the page.
+   */
+  bool Acquire(Device dev, size_t nbytes, Page* page) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Page>& pages = pages_[Key(dev)];
+    // Best fit; the cache stays small so a linear scan is fine.
+    int best = -1;
+    for (size_t i = 0; i < pages.size(); ++i) {
+      if (pages[i].size >= nbytes && (best < 0 || pages[i].size < pages[best].size)) {
+        best = static_cast<int>(i);
+      }
+    }
+    if (best < 0) {
+      return false;
+    }
+    *page = pages[best];
+    pages.erase(pages.begin() + best);
+    return true;
+  }
+
+  /*!
+   * \brief Hand a page back to the cache; frees a page when the cache is full.
+   */
+  void Surrender(Device dev, DeviceAPI* device, Page page) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Page>& pages = pages_[Key(dev)];
+    if (pages.size() >= kMaxPagesPerDevice) {
+      // Evict the smallest page; the big ones are the expensive ones to
+      // re-allocate.
+      size_t smallest = 0;
+      for (size_t i = 1; i < pages.size(); ++i) {
+        if (pages[i].size < pages[smallest].size) {
+          smallest = i;
+        }
+      }
+      if (page.size > pages[smallest].size) {
+        std::swap(page, pages[smallest]);
+      }
+      device->FreeDataSpace(dev, page.data);
+      return;
+    }
+    pages.push_back(page);
+  }
+
+ private:
+  static int64_t Key(Device dev) {
+    return (static_cast<int64_t>(dev.device_type) << 32) | static_cast<uint32_t>(dev.device_id);
+  }
+
+  /*! \brief The largest number of pages cached per device. */
+  static constexpr size_t kMaxPagesPerDevice = 32;
+  std::mutex mutex_;
+  std::unordered_map<int64_t, std::vector<Page>> pages_;
+};
+
 class WorkspacePool::Pool {
  public:
   // constructor
@@ -44,26 +147,28 @@ class WorkspacePool::Pool {
   }
   // allocate from pool
   void* Alloc(Device dev, DeviceAPI* device, size_t nbytes) {
+    size_t planned = planned_arena_bytes.load(std::memory_order_relaxed);
+    if (planned != 0 && DeviceSupportsArena(dev)) {
+      if (void* ptr = ArenaAlloc(dev, device, nbytes, planned)) {
+        return ptr;
+      }
+      // The request overflows the planned arena, e.g. the module was not the
+      // one the plan was computed for; fall back to the free-list path.
+    }
     // Allocate align to page.
     nbytes = (nbytes + (kWorkspacePageSize - 1)) / kWorkspacePageSize * kWorkspacePageSize;
     if (nbytes == 0) nbytes = kWorkspacePageSize;
     Entry e;
-    DLDataType type;
-    type.code = kDLUInt;
-    type.bits = 8;
-    type.lanes = 1;
     if (free_list_.size() == 2) {
       e = free_list_.back();
       free_list_.pop_back();
       if (e.size < nbytes) {
         // resize the page
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
+        FreePage(dev, device, e);
+        e = AllocPage(dev, device, nbytes);
       }
     } else if (free_list_.size() == 1) {
-      e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-      e.size = nbytes;
+      e = AllocPage(dev, device, nbytes);
     } else {
       if (free_list_.back().size >= nbytes) {
         // find smallest fit
@@ -76,9 +181,8 @@ class WorkspacePool::Pool {
         // resize the page
         e = free_list_.back();
         free_list_.pop_back();
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
+        FreePage(dev, device, e);
+        e = AllocPage(dev, device, nbytes);
       }
     }
     allocated_.push_back(e);
@@ -86,6 +190,9 @@ class WorkspacePool::Pool {
   }
   // free resource back to pool
   void Free(void* data) {
+    if (FreeFromArena(data)) {
+      return;
+    }
     Entry e;
     if (allocated_.back().data == data) {
       // quick path, last allocated.
@@ -115,10 +222,18 @@ class WorkspacePool::Pool {
   }
   // Release all resources
   void Release(Device dev, DeviceAPI* device) {
+    // Surrender the pages of this (typically thread-local) pool so that
+    // other worker threads can adopt them.
     for (size_t i = 1; i < free_list_.size(); ++i) {
-      device->FreeDataSpace(dev, free_list_[i].data);
+      FreePage(dev, device, free_list_[i]);
     }
     free_list_.clear();
+    if (arena_.data != nullptr) {
+      FreePage(dev, device, arena_);
+      arena_ = Entry{nullptr, 0};
+      arena_used_ = 0;
+      arena_allocs_.clear();
+    }
   }
 
  private:
@@ -127,10 +242,75 @@ class WorkspacePool::Pool {
     void* data;
     size_t size;
   };
+  // Get a fresh page, preferring pages surrendered by other threads over
+  // hitting the device allocator.
+  Entry AllocPage(Device dev, DeviceAPI* device, size_t nbytes) {
+    SharedPageCache::Page page;
+    if (SharedPageCache::Global()->Acquire(dev, nbytes, &page)) {
+      return Entry{page.data, page.size};
+    }
+    DLDataType type;
+    type.code = kDLUInt;
+    type.bits = 8;
+    type.lanes = 1;
+    Entry e;
+    e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+    e.size = nbytes;
+    return e;
+  }
+  // Hand a page back to the shared cache.
+  void FreePage(Device dev, DeviceAPI* device, Entry e) {
+    SharedPageCache::Global()->Surrender(dev, device, SharedPageCache::Page{e.data, e.size});
+  }
+  /*! \brief a block bump-allocated from the planned arena */
+  struct ArenaAlloc_ {
+    void* data;
+    size_t offset;
+    size_t size;
+  };
+  // Bump-allocate from the planned arena; returns nullptr when it does not fit.
+  void* ArenaAlloc(Device dev, DeviceAPI* device, size_t nbytes, size_t planned) {
+    nbytes = (nbytes + kTempAllocaAlignment - 1) / kTempAllocaAlignment * kTempAllocaAlignment;
+    if (nbytes == 0) nbytes = kTempAllocaAlignment;
+    if (arena_.data == nullptr) {
+      arena_ = AllocPage(dev, device, std::max(planned, nbytes));
+    }
+    if (arena_used_ + nbytes > arena_.size) {
+      return nullptr;
+    }
+    void* ptr = static_cast<char*>(arena_.data) + arena_used_;
+    arena_allocs_.push_back(ArenaAlloc_{ptr, arena_used_, nbytes});
+    arena_used_ += nbytes;
+    return ptr;
+  }
+  // Return a block to the arena; returns false if the pointer is not from it.
+  bool FreeFromArena(void* data) {
+    if (!arena_allocs_.empty() && arena_allocs_.back().data == data) {
+      // quick path: workspaces are almost always freed LIFO.
+      arena_used_ = arena_allocs_.back().offset;
+      arena_allocs_.pop_back();
+      return true;
+    }
+    for (int index = static_cast<int>(arena_allocs_.size()) - 2; index >= 0; --index) {
+      if (arena_allocs_[index].data == data) {
+        // Out-of-order free: the bytes are reclaimed once the blocks above
+        // are freed, which the high-water plan already accounts for.
+        arena_allocs_.erase(arena_allocs_.begin() + index);
+        return true;
+      }
+    }
+    return false;
+  }
   /*! \brief List of free items, sorted from small to big size */
   std::vector<Entry> free_list_;
   /*! \brief List of allocated items */
   std::vector<Entry> allocated_;
+  /*! \brief The planned arena page, unset until its first use */
+  Entry arena_{nullptr, 0};
+  /*! \brief The bump pointer of the planned arena */
+  size_t arena_used_{0};
+  /*! \brief The live blocks of the planned arena, in allocation order */
+  std::vector<ArenaAlloc_> arena_allocs_;
 };
 
 WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
@@ -163,5 +343,20 @@ void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+/*!
+ * \brief Configure the planned workspace capacity in bytes.
+ *
+ *  Executors that know the workspace high-water mark of the module they run
+ *  (the maximum of tir.analysis.calculate_workspace_bytes over its lowered
+ *  PrimFuncs) can set it here; each per-thread pool then serves
+ *  TVMBackendAllocWorkspace by bumping a pointer in one preallocated arena
+ *  instead of managing a free list. 0 disables the planned mode.
+ */
+TVM_REGISTER_GLOBAL("runtime.ConfigPlannedWorkspace").set_body_typed([](int64_t nbytes) {
+  CHECK_GE(nbytes, 0) << "ValueError: planned workspace size must be non-negative, but gets: "
+                      << nbytes;
+  planned_arena_bytes.store(static_cast<size_t>(nbytes), std::memory_order_relaxed);
+});
+
 }  // namespace runtime
 }  // namespace tvm
@@ -179,6 +179,10 @@
 #define TVM_INFO_USE_MKL "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_MINIMAL_CHECKS
+#define TVM_INFO_USE_MINIMAL_CHECKS "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_MRVL
 #define TVM_INFO_USE_MRVL "NOT-FOUND"
 #endif
@@ -347,6 +351,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_METAL", TVM_INFO_USE_METAL},
       {"USE_MICRO_STANDALONE_RUNTIME", TVM_INFO_USE_MICRO_STANDALONE_RUNTIME},
       {"USE_MICRO", TVM_INFO_USE_MICRO},
+      {"USE_MINIMAL_CHECKS", TVM_INFO_USE_MINIMAL_CHECKS},
       {"USE_MIOPEN", TVM_INFO_USE_MIOPEN},
       {"USE_MKL", TVM_INFO_USE_MKL},
       {"USE_MRVL", TVM_INFO_USE_MRVL},
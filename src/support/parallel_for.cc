@@ -21,17 +21,76 @@
  * \file parallel_for.cc
  * \brief An implementation to run loop in parallel.
  */
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/support/parallel_for.h>
 
-#include <future>
-#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 namespace tvm {
 namespace support {
 
+namespace {
+
+/*!
+ * \brief Whether the current thread is already inside a parallel_for region.
+ *
+ *  The runtime thread pool cannot be re-entered from one of its own launches,
+ *  so nested regions degrade to serial execution on the calling thread.
+ */
+thread_local bool in_parallel_region{false};
+
+/*! \brief The state shared between the launching thread and the pool workers. */
+struct PoolLaunchEnv {
+  /*! \brief The per-worker body; the argument is the worker index. */
+  const std::function<void(int)>* worker;
+  /*! \brief The first exception thrown by any worker, if any. */
+  std::exception_ptr first_error{nullptr};
+  /*! \brief Guards first_error. */
+  std::mutex error_mutex;
+};
+
+/*! \brief The lambda run by the runtime thread pool; exceptions must not cross it. */
+int PoolWorkerFunc(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  PoolLaunchEnv* env = static_cast<PoolLaunchEnv*>(cdata);
+  try {
+    (*env->worker)(task_id);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(env->error_mutex);
+    if (env->first_error == nullptr) {
+      env->first_error = std::current_exception();
+    }
+  }
+  return 0;
+}
+
+/*!
+ * \brief Run `worker` for worker indices [0, num_workers) on the runtime
+ *  thread pool and rethrow the first worker exception on the calling thread.
+ *
+ *  The pool keeps its threads alive between launches, so repeated calls do
+ *  not pay thread creation, unlike spawning std::threads per call.
+ */
+void LaunchOnRuntimePool(int num_workers, const std::function<void(int)>& worker) {
+  PoolLaunchEnv env;
+  env.worker = &worker;
+  in_parallel_region = true;
+  int res = TVMBackendParallelLaunch(PoolWorkerFunc, &env, num_workers);
+  in_parallel_region = false;
+  ICHECK_EQ(res, 0) << "Failed to launch the runtime thread pool";
+  if (env.first_error != nullptr) {
+    std::rethrow_exception(env.first_error);
+  }
+}
+
+}  // namespace
+
 std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int num_threads) {
   int total_task_count = (end - begin) / step;
   ICHECK_GE(total_task_count, 0) << "Infinite loop condition with begin: " << begin
@@ -49,45 +108,33 @@ std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int n
 
 void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
                   const PartitionerFuncType partitioner) {
-  static bool GLOBAL_PARALLEL_FOR_FLAG{false};
-  static std::mutex M_GLOBAL_PARALLEL_FOR_FLAG;
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    ICHECK(!GLOBAL_PARALLEL_FOR_FLAG) << "There's another parallel_for running. Maybe you're "
-                                      << "currently inside another parallel_for loop.";
-    GLOBAL_PARALLEL_FOR_FLAG = true;
-  }
-
-  int default_num_threads = std::thread::hardware_concurrency();
-  const auto& run_partitions = partitioner(begin, end, step, default_num_threads);
-
-  std::vector<std::thread> threads;
-  threads.reserve(run_partitions.size());
-  std::vector<std::future<void>> res_vec;
-  res_vec.reserve(run_partitions.size());
-  for (const auto& run_partition : run_partitions) {
-    std::packaged_task<void(const std::vector<int>&, const std::function<void(int)>&)> task(
-        [](const std::vector<int>& run_partition, const std::function<void(int)>& f) {
-          for (const auto& i : run_partition) {
-            f(i);
-          }
-        });
-    res_vec.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), run_partition, f);
-  }
-
-  for (auto&& thread : threads) {
-    thread.join();
+  if (begin >= end) {
+    return;
   }
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    ICHECK(GLOBAL_PARALLEL_FOR_FLAG);
-    GLOBAL_PARALLEL_FOR_FLAG = false;
+  int total_task_count = (end - begin + step - 1) / step;
+  ICHECK_GE(total_task_count, 0) << "Infinite loop condition with begin: " << begin
+                                 << " end: " << end << " step: " << step;
+  // Minimum grain: never wake more workers than there are loop tasks, and
+  // never request more than the pool has threads — the launch runs with
+  // need_sync and the pool rejects oversubscribed task counts.
+  int num_workers = std::min(total_task_count, tvm::runtime::threading::NumThreads());
+  if (in_parallel_region || num_workers <= 1) {
+    // Nested regions cannot re-enter the pool; run on the calling thread.
+    for (int i = begin; i < end; i += step) {
+      f(i);
+    }
+    return;
   }
+  const auto& run_partitions = partitioner(begin, end, step, num_workers);
   try {
-    for (auto&& i : res_vec) {
-      i.get();
-    }
+    LaunchOnRuntimePool(num_workers, [&run_partitions, &f](int worker_id) {
+      if (static_cast<size_t>(worker_id) >= run_partitions.size()) {
+        return;
+      }
+      for (const auto& i : run_partitions[worker_id]) {
+        f(i);
+      }
+    });
   } catch (const std::exception& e) {
     LOG(FATAL) << "Parallel_for error with " << e.what();
   }
@@ -101,40 +148,43 @@ void parallel_for_dynamic(int begin, int end, int num_threads,
   }
   CHECK_LE(begin, end) << "ValueError: The interval [begin, end) requires `begin <= end`";
   CHECK_GT(num_threads, 0) << "ValueError: `num_threads` should be positive";
-  // Step 2. Launch threads
-  // Step 2.1. Launch worker 1 to worker `num_threads - 1`
-  std::atomic<int> counter{begin};
-  std::vector<std::future<void>> futures;
-  std::vector<std::thread> threads;
-  futures.reserve(num_threads - 1);
-  threads.reserve(num_threads - 1);
-  auto worker = [end, &counter, &f](int thread_id) -> void {
-    for (int task_id; (task_id = counter++) < end;) {
-      f(thread_id, task_id);
+  // Step 2. Determine the number of workers; never more than loop tasks,
+  // never more than the pool has threads.
+  int num_workers = std::min({num_threads, end - begin, tvm::runtime::threading::NumThreads()});
+  if (in_parallel_region || num_workers <= 1) {
+    // Nested regions cannot re-enter the pool; run on the calling thread.
+    try {
+      for (int task_id = begin; task_id < end; ++task_id) {
+        f(0, task_id);
+      }
+    } catch (const std::exception& e) {
+      LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
     }
-  };
-  for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
-    std::packaged_task<void(int)> task(worker);
-    futures.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), thread_id);
-  }
-  // Step 2.2. Launch worker 0 inplace
-  try {
-    worker(0);
-  } catch (const std::exception& e) {
-    for (auto&& thread : threads) {
-      thread.join();
-    }
-    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
-  }
-  // Step 3. Join threads and check exceptions
-  for (auto&& thread : threads) {
-    thread.join();
+    return;
   }
+  // Step 3. Launch the workers on the runtime thread pool with lazy chunked
+  // stealing: each worker grabs a shrinking slice of the remaining range, so
+  // the steal counter is not contended once per element while the tail is
+  // still balanced dynamically.
+  std::atomic<int> counter{begin};
   try {
-    for (auto&& future : futures) {
-      future.get();
-    }
+    LaunchOnRuntimePool(num_workers, [end, num_workers, &counter, &f](int thread_id) {
+      for (;;) {
+        int remaining = end - counter.load(std::memory_order_relaxed);
+        if (remaining <= 0) {
+          break;
+        }
+        int chunk = std::max(1, remaining / (num_workers * 4));
+        int task_begin = counter.fetch_add(chunk);
+        if (task_begin >= end) {
+          break;
+        }
+        int task_end = std::min(end, task_begin + chunk);
+        for (int task_id = task_begin; task_id < task_end; ++task_id) {
+          f(thread_id, task_id);
+        }
+      }
+    });
   } catch (const std::exception& e) {
     LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
   }
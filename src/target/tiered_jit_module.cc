@@ -0,0 +1,200 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tiered_jit_module.cc
+ * \brief A two-tier module that interprets TIR while the optimized build runs.
+ */
+#include "tiered_jit_module.h"
+
+#include <tvm/ir/transform.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace tvm {
+namespace codegen {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.tiered_jit", Bool);
+
+/*!
+ * \brief The per-function dispatch cell shared with the returned PackedFuncs.
+ *
+ *  Every function handed out before the optimized tier is ready keeps calling
+ *  through its cell, so completing the background build swaps all of them at
+ *  once without invalidating user-held PackedFuncs.
+ */
+struct TieredFuncCell {
+  /*! \brief Whether `optimized` has been resolved; set after it is written. */
+  std::atomic<bool> swapped{false};
+  /*! \brief The baseline-tier function. */
+  runtime::PackedFunc baseline;
+  /*! \brief The optimized-tier function, valid once `swapped` is true. */
+  runtime::PackedFunc optimized;
+};
+
+/*!
+ * \brief The module that owns both tiers.
+ *
+ *  The baseline tier is a StackVM module built synchronously; the optimized
+ *  tier is produced by the target's regular build function on a background
+ *  thread. Lookups served before completion return dispatchers that follow
+ *  the swap; serialization and source queries wait for the optimized tier,
+ *  since only it is in the deployable format.
+ */
+class TieredJITModuleNode : public runtime::ModuleNode {
+ public:
+  TieredJITModuleNode(runtime::Module baseline, IRModule mod, Target target)
+      : baseline_(baseline) {
+    builder_ = std::thread([this, mod, target]() {
+      runtime::Module optimized;
+      try {
+        const runtime::PackedFunc* bf =
+            runtime::Registry::Get("target.build." + target->kind->name);
+        ICHECK(bf != nullptr) << "target.build." << target->kind->name << " is not enabled";
+        optimized = (*bf)(mod, target);
+      } catch (const std::exception& e) {
+        // Keep serving the baseline tier; an exception must not escape the thread.
+        LOG(ERROR) << "The optimized tier build failed; the module keeps running on the "
+                   << "StackVM baseline tier. Error: " << e.what();
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        optimized_ = optimized;
+        for (auto& kv : cells_) {
+          kv.second->optimized = optimized_->GetFunction(kv.first, true);
+          kv.second->swapped.store(true, std::memory_order_release);
+        }
+      }
+      optimized_ready_.store(true, std::memory_order_release);
+    });
+  }
+
+  ~TieredJITModuleNode() {
+    if (builder_.joinable()) {
+      builder_.join();
+    }
+  }
+
+  const char* type_key() const final { return "tiered_jit"; }
+
+  int GetPropertyMask() const final { return runtime::ModulePropertyMask::kRunnable; }
+
+  runtime::PackedFunc GetFunction(const String& name,
+                                  const ObjectPtr<Object>& sptr_to_self) final {
+    if (optimized_ready_.load(std::memory_order_acquire)) {
+      // Steady state: hand out the compiled function directly.
+      return optimized_->GetFunction(name, true);
+    }
+    std::shared_ptr<TieredFuncCell> cell;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (optimized_.defined()) {
+        return optimized_->GetFunction(name, true);
+      }
+      auto it = cells_.find(name);
+      if (it != cells_.end()) {
+        cell = it->second;
+      } else {
+        cell = std::make_shared<TieredFuncCell>();
+        cell->baseline = baseline_->GetFunction(name, true);
+        cells_.emplace(name, cell);
+      }
+    }
+    if (cell->baseline == nullptr) {
+      return runtime::PackedFunc(nullptr);
+    }
+    return runtime::PackedFunc(
+        [sptr_to_self, cell](runtime::TVMArgs args, runtime::TVMRetValue* rv) {
+          if (cell->swapped.load(std::memory_order_acquire)) {
+            cell->optimized.CallPacked(args, rv);
+          } else {
+            cell->baseline.CallPacked(args, rv);
+          }
+        });
+  }
+
+  bool ImplementsFunction(const String& name, bool query_imports) final {
+    return baseline_->ImplementsFunction(name, query_imports);
+  }
+
+  void SaveToFile(const String& file_name, const String& format) final {
+    WaitForOptimized()->SaveToFile(file_name, format);
+  }
+
+  void SaveToBinary(dmlc::Stream* stream) final { WaitForOptimized()->SaveToBinary(stream); }
+
+  String GetSource(const String& format) final { return WaitForOptimized()->GetSource(format); }
+
+ private:
+  /*! \brief Block until the optimized tier is built. */
+  runtime::Module WaitForOptimized() {
+    if (builder_.joinable()) {
+      builder_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(optimized_.defined())
+        << "ValueError: The optimized tier failed to build; only function calls "
+        << "can be served from the baseline tier.";
+    return optimized_;
+  }
+
+  /*! \brief The StackVM baseline tier. */
+  runtime::Module baseline_;
+  /*! \brief The optimized tier; defined once the background build completes. */
+  runtime::Module optimized_{nullptr};
+  /*! \brief Whether optimized_ is published; checked without taking the lock. */
+  std::atomic<bool> optimized_ready_{false};
+  /*! \brief The dispatch cells of the functions handed out before completion. */
+  std::unordered_map<std::string, std::shared_ptr<TieredFuncCell>> cells_;
+  /*! \brief Guards optimized_ and cells_. */
+  std::mutex mutex_;
+  /*! \brief The background thread running the optimized build. */
+  std::thread builder_;
+};
+
+runtime::Module CreateTieredJITModule(IRModule mod, Target target) {
+  const runtime::PackedFunc* baseline_builder = runtime::Registry::Get("target.build.stackvm");
+  ICHECK(baseline_builder != nullptr) << "target.build.stackvm is not enabled";
+  runtime::Module baseline;
+  try {
+    baseline = (*baseline_builder)(mod, target);
+  } catch (const std::exception& e) {
+    // The StackVM codegen supports the host-side TIR subset; fall back to a
+    // plain synchronous build when the module is outside it.
+    LOG(WARNING) << "tir.tiered_jit is enabled but the baseline StackVM build failed; "
+                 << "falling back to the synchronous " << target->kind->name
+                 << " build. Error: " << e.what();
+    const runtime::PackedFunc* bf = runtime::Registry::Get("target.build." + target->kind->name);
+    ICHECK(bf != nullptr) << "target.build." << target->kind->name << " is not enabled";
+    return (*bf)(mod, target);
+  }
+  auto n = runtime::make_object<TieredJITModuleNode>(baseline, mod, target);
+  return runtime::Module(n);
+}
+
+}  // namespace codegen
+}  // namespace tvm
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tiered_jit_module.h
+ * \brief Declares the two-tier module that interprets TIR while LLVM compiles.
+ */
+
+#ifndef TVM_TARGET_TIERED_JIT_MODULE_H_
+#define TVM_TARGET_TIERED_JIT_MODULE_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/runtime/module.h>
+#include <tvm/target/target.h>
+
+namespace tvm {
+namespace codegen {
+
+/*!
+ * \brief Create a two-tier module for near-instant time-to-first-call.
+ *
+ *        The baseline tier is built synchronously with the StackVM codegen,
+ *        which emits interpretable bytecode in milliseconds, while the given
+ *        target's optimizing build runs in a background thread. Functions
+ *        looked up from the module dispatch to the baseline tier until the
+ *        optimized build completes, then hot-swap to the compiled code.
+ *
+ * \param mod The lowered IRModule to compile.
+ * \param target The target of the optimized tier.
+ * \return The created tiered module.
+ */
+runtime::Module CreateTieredJITModule(IRModule mod, Target target);
+
+}  // namespace codegen
+}  // namespace tvm
+
+#endif  // TVM_TARGET_TIERED_JIT_MODULE_H_
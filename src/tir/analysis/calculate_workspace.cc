@@ -25,9 +25,12 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/function.h>
+#include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
+
 namespace tvm {
 namespace tir {
 
@@ -37,9 +40,15 @@ class WorkspaceCalculator : public StmtExprVisitor {
   WorkspaceCalculator() = default;
   size_t operator()(const PrimFunc& func);
   size_t byte_alignment = tvm::runtime::kDefaultWorkspaceAlignment;
+  /*!
+   * \brief Whether lowered TVMBackendAllocWorkspace calls are also counted, so
+   *  the high-water mark can be computed for modules after LowerTVMBuiltin.
+   */
+  bool count_lowered_workspace = false;
 
  private:
   void VisitStmt_(const T* op) override;
+  void VisitStmt_(const LetStmtNode* op) override;
   size_t GetByteAlignedSize(Integer non_aligned_size);
   size_t CalculateExtentsSize(const DataType& dtype, const Array<PrimExpr>& extents);
   size_t current_size = 0;
@@ -71,6 +80,29 @@ void WorkspaceCalculator<T>::VisitStmt_(const T* op) {
   current_size -= size;
 }
 
+template <typename T>
+void WorkspaceCalculator<T>::VisitStmt_(const LetStmtNode* op) {
+  // After LowerTVMBuiltin a workspace allocation is bound by a LetStmt whose
+  // value calls TVMBackendAllocWorkspace and whose scope covers the matching
+  // TVMBackendFreeWorkspace, so scoping over the let body yields the same
+  // high-water accounting as for the AllocateNode it was lowered from.
+  static const Op& alloc_workspace_op = Op::Get("tir.TVMBackendAllocWorkspace");
+  size_t size = 0;
+  if (count_lowered_workspace) {
+    if (const auto* call = op->value.as<CallNode>()) {
+      if (call->op.same_as(alloc_workspace_op)) {
+        if (const int64_t* total_bytes = as_const_int(call->args[2])) {
+          size = GetByteAlignedSize(Integer(*total_bytes));
+        }
+      }
+    }
+  }
+  current_size += size;
+  max_size = std::max(max_size, current_size);
+  StmtExprVisitor::VisitStmt_(op);
+  current_size -= size;
+}
+
 size_t CalculateConstantBytes(const PrimFunc& func, const Integer& byte_alignment) {
   WorkspaceCalculator<AllocateConstNode> wc;
   wc.byte_alignment = byte_alignment->value;
@@ -80,6 +112,7 @@ size_t CalculateConstantBytes(const PrimFunc& func, const Integer& byte_alignmen
 size_t CalculateWorkspaceBytes(const PrimFunc& func, const Integer& byte_alignment) {
   WorkspaceCalculator<AllocateNode> wc;
   wc.byte_alignment = byte_alignment->value;
+  wc.count_lowered_workspace = true;
   return wc(func);
 }
 
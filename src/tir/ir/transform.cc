@@ -22,13 +22,89 @@
  * \brief TIR specific transformation passes.
  */
 #include <tvm/node/repr_printer.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/transform.h>
 
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_prim_func_pass_caching", Bool);
+
+/*!
+ * \brief Memoization table for function pass results.
+ *
+ * Entries are keyed on the pass identity and the structural hash of the input
+ * function, with a structural equality check on lookup to rule out hash
+ * collisions. Rebuilding a module in which only a few functions changed then
+ * skips the pass pipeline for every unchanged function.
+ *
+ * Caching assumes the pass result depends only on the input function, not on
+ * the rest of the module or on pass context options that vary between runs,
+ * which is why it is only consulted when tir.enable_prim_func_pass_caching
+ * is set.
+ */
+class PrimFuncPassCache {
+ public:
+  static PrimFuncPassCache* Global() {
+    static PrimFuncPassCache inst;
+    return &inst;
+  }
+
+  /*!
+   * \brief Apply a pass function through the cache.
+   * \param pass_key Key identifying the pass.
+   * \param func The input function.
+   * \param frun Callback running the pass on a cache miss.
+   * \return The transformed function.
+   */
+  PrimFunc Apply(const std::string& pass_key, PrimFunc func,
+                 const std::function<PrimFunc(PrimFunc)>& frun) {
+    std::string key = pass_key + ':' + std::to_string(StructuralHash()(func));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto range = entries_.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (StructuralEqual()(it->second.input, func)) {
+          return it->second.result;
+        }
+      }
+    }
+    PrimFunc result = frun(func);
+    // Deleting passes return an undefined result; those are not cached so the
+    // caller keeps its usual removal handling.
+    if (result.defined()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entries_.size() >= kMaxEntries) {
+        entries_.clear();
+      }
+      entries_.emplace(std::move(key), Entry{func, result});
+    }
+    return result;
+  }
+
+ private:
+  struct Entry {
+    PrimFunc input;
+    PrimFunc result;
+  };
+  // Bound the table so long-running autotuning sessions do not grow it
+  // without limit; wholesale clearing keeps the bookkeeping trivial.
+  static constexpr size_t kMaxEntries = 10000;
+
+  std::mutex mutex_;
+  std::unordered_multimap<std::string, Entry> entries_;
+};
+
 /*!
  * \brief Function level pass that applies transformations to all
  *        TIR functions within the module.
@@ -90,6 +166,14 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   ICHECK(mod.defined());
   std::vector<GlobalVar> deleted_list;
 
+  bool enable_cache =
+      pass_ctx->GetConfig<Bool>("tir.enable_prim_func_pass_caching", Bool(false)).value();
+  std::string pass_key;
+  if (enable_cache) {
+    const PassInfo& info = pass_info;
+    pass_key = std::string(info->name) + '#' + std::to_string(info->opt_level);
+  }
+
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
   // directly loop over the underlying dict
@@ -98,7 +182,13 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
     if (kv.second->IsInstance<PrimFuncNode>()) {
       // move out the function so that it is the only copy.
       PrimFunc func = Downcast<PrimFunc>(std::move(kv.second));
-      func = pass_func(std::move(func), mod, pass_ctx);
+      if (enable_cache) {
+        func = PrimFuncPassCache::Global()->Apply(
+            pass_key, std::move(func),
+            [&](PrimFunc f) { return pass_func(std::move(f), mod, pass_ctx); });
+      } else {
+        func = pass_func(std::move(func), mod, pass_ctx);
+      }
       kv.second = std::move(func);
 
       if (!kv.second.defined()) {
@@ -351,6 +351,15 @@ BlockRealize GetBlockRealize(const ScheduleState& self, const StmtSRef& block_sr
  */
 IterVarType GetLoopIterType(const StmtSRef& loop_sref);
 
+/*!
+ * \brief Get the IterVarType of the specific loop, according to the blocks it's bound to,
+ * caching the result in the analysis cache of the given state
+ * \param self The schedule state the loop belongs to
+ * \param loop_sref The loop to be checked
+ * \return The IterVarType of the specific loop
+ */
+IterVarType GetLoopIterType(const ScheduleState& self, const StmtSRef& loop_sref);
+
 /*!
  * \brief Get the lowest common ancestor of an array of blocks or loops on the sref tree
  * \param srefs The block srefs or loop srefs whose lowest common ancestor is to be queried
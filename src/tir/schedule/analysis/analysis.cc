@@ -205,8 +205,8 @@ bool IsDominantBlock(const ScheduleState& self, const StmtSRef& scope_root_sref,
  * \return 0 if the block is a complete block, or a positive integer indicating which condition is
  * first violated
  */
-int CheckCompleteBlockErrorCode(const ScheduleState& self, const StmtSRef& block_sref,
-                                const StmtSRef& scope_root_sref) {
+int CheckCompleteBlockErrorCodeImpl(const ScheduleState& self, const StmtSRef& block_sref,
+                                    const StmtSRef& scope_root_sref) {
   // Cond 1. All block vars are data parallel
   const BlockNode* block = TVM_SREF_TO_BLOCK(block_sref);
   for (const IterVar& iter_var : block->iter_vars) {
@@ -233,6 +233,23 @@ int CheckCompleteBlockErrorCode(const ScheduleState& self, const StmtSRef& block
   return 0;
 }
 
+/*!
+ * \brief The caching front-end of `CheckCompleteBlockErrorCodeImpl`. The completeness of a block
+ * is queried repeatedly with the same scope root during tuning, so the result is kept in the
+ * per-state analysis cache, which `Replace` empties.
+ */
+int CheckCompleteBlockErrorCode(const ScheduleState& self, const StmtSRef& block_sref,
+                                const StmtSRef& scope_root_sref) {
+  auto& cache = self->analysis_cache.complete_block_code;
+  auto it = cache.find(block_sref->stmt);
+  if (it != cache.end() && it->second.first == scope_root_sref->stmt) {
+    return it->second.second;
+  }
+  int error_code = CheckCompleteBlockErrorCodeImpl(self, block_sref, scope_root_sref);
+  cache[block_sref->stmt] = {scope_root_sref->stmt, error_code};
+  return error_code;
+}
+
 static const char* kCompleteBlockDefinition = R"(Definition of a complete block:
 1) All block vars are data parallel
 2) Dominant: the block is the only writer of its output, dominating the reader of its output buffers
@@ -298,8 +315,8 @@ void CheckCompleteBlock(const ScheduleState& self, const StmtSRef& block_sref,
  * \return 0 if the block is a reduction block, or a positive integer indicating which condition is
  * first violated
  */
-int CheckReductionBlockErrorCode(const ScheduleState& self, const StmtSRef& block_sref,
-                                 const StmtSRef& scope_root_sref) {
+int CheckReductionBlockErrorCodeImpl(const ScheduleState& self, const StmtSRef& block_sref,
+                                     const StmtSRef& scope_root_sref) {
   const BlockNode* block = TVM_SREF_TO_BLOCK(block_sref);
   // Cond 1. The block has the `init` statement.
   if (!block->init.defined()) {
@@ -323,6 +340,22 @@ int CheckReductionBlockErrorCode(const ScheduleState& self, const StmtSRef& bloc
   return ReductionIterNotIndexOutputBuffer(GetRef<Block>(block)) ? 0 : 5;
 }
 
+/*!
+ * \brief The caching front-end of `CheckReductionBlockErrorCodeImpl`, following the same scheme
+ * as `CheckCompleteBlockErrorCode`.
+ */
+int CheckReductionBlockErrorCode(const ScheduleState& self, const StmtSRef& block_sref,
+                                 const StmtSRef& scope_root_sref) {
+  auto& cache = self->analysis_cache.reduction_block_code;
+  auto it = cache.find(block_sref->stmt);
+  if (it != cache.end() && it->second.first == scope_root_sref->stmt) {
+    return it->second.second;
+  }
+  int error_code = CheckReductionBlockErrorCodeImpl(self, block_sref, scope_root_sref);
+  cache[block_sref->stmt] = {scope_root_sref->stmt, error_code};
+  return error_code;
+}
+
 bool IsReductionBlock(const ScheduleState& self, const StmtSRef& block_sref,
                       const StmtSRef& scope_root_sref) {
   return CheckReductionBlockErrorCode(self, block_sref, scope_root_sref) == 0;
@@ -916,6 +949,20 @@ IterVarType GetLoopIterType(const StmtSRef& loop_sref) {
   }
 }
 
+IterVarType GetLoopIterType(const ScheduleState& self, const StmtSRef& loop_sref) {
+  // The classification traverses every block under the loop, and tuning evaluates it for the
+  // same loops over and over, so the result is kept in the per-state analysis cache, which
+  // `Replace` empties.
+  auto& cache = self->analysis_cache.loop_iter_type;
+  auto it = cache.find(loop_sref->stmt);
+  if (it != cache.end()) {
+    return static_cast<IterVarType>(it->second);
+  }
+  IterVarType result = GetLoopIterType(loop_sref);
+  cache[loop_sref->stmt] = static_cast<int>(result);
+  return result;
+}
+
 StmtSRef GetSRefLowestCommonAncestor(const Array<StmtSRef>& srefs) {
   CHECK(!srefs.empty()) << "ValueError: The input array is required to have at least one sref";
 
@@ -982,8 +1029,7 @@ std::pair<Array<StmtSRef>, std::vector<int>> CollectComputeLocation(const Schedu
   loop_iter_types.reserve(n_candidate);
   int i_last_datapar = -1;
   for (size_t i = 0; i < n_candidate; ++i) {
-    // TODO(siyuan): improve the performance
-    IterVarType iter_type = GetLoopIterType(loop_srefs[i]);
+    IterVarType iter_type = GetLoopIterType(self, loop_srefs[i]);
     loop_iter_types.push_back(iter_type);
     if (iter_type == IterVarType::kDataPar) {
       i_last_datapar = i;
@@ -1578,7 +1624,7 @@ std::pair<int64_t, int64_t> GetCumulativeSpaceAndReductionLength(const tir::Sche
    *   2. there is some loop which is dynamic.
    */
   for (const tir::StmtSRef& loop_sref : loops) {
-    tir::IterVarType type = GetLoopIterType(loop_sref);
+    tir::IterVarType type = GetLoopIterType(self, loop_sref);
     if (type == tir::kDataPar) {
       const int64_t* extent = GetLoopIntExtent(loop_sref);
       if (*extent != -1) {
@@ -1623,7 +1669,7 @@ bool NeedsRFactorOrCrossThreadReduction(const tir::ScheduleState& self,   //
 
   // Cond 3. Every the loop axis must be either spatial axis or reduction axis.
   for (const tir::StmtSRef& loop_sref : loops) {
-    const tir::IterVarType& type = GetLoopIterType(loop_sref);
+    const tir::IterVarType type = GetLoopIterType(self, loop_sref);
     if (type != tir::kDataPar && type != tir::kCommReduce) {
       return false;
     }
@@ -1634,7 +1680,7 @@ bool NeedsRFactorOrCrossThreadReduction(const tir::ScheduleState& self,   //
   bool has_reduction_loop = false;
   for (size_t i = 0; i < loops.size(); ++i) {
     // Cond 4.
-    if (GetLoopIterType(loops[i]) == tir::kCommReduce) {
+    if (GetLoopIterType(self, loops[i]) == tir::kCommReduce) {
       has_reduction_loop = true;
     }
 
@@ -2135,7 +2181,7 @@ TVM_REGISTER_GLOBAL("tir.schedule.IsOutputBlock").set_body_typed([](Schedule sch
 
 TVM_REGISTER_GLOBAL("tir.schedule.GetLoopIterType")
     .set_body_typed([](Schedule sch, LoopRV loop) -> String {
-      IterVarType kind = GetLoopIterType(sch->GetSRef(loop));
+      IterVarType kind = GetLoopIterType(sch->state(), sch->GetSRef(loop));
       if (kind == kDataPar) {
         return "S";
       } else if (kind == kCommReduce) {
@@ -60,6 +60,9 @@ class ScheduleCopier {
     n->mod = src_state->mod;
     n->block_info = copier.Copy(src_state->block_info);
     n->stmt2ref = copier.Copy(src_state->stmt2ref);
+    // The copy shares the IR with the source, so the stale markers, which are
+    // keyed by statements, carry over as-is.
+    n->stale_block_info = src_state->stale_block_info;
     n->debug_mask = src_state->debug_mask;
     n->enable_check = src_state->enable_check;
     *new_state = ScheduleState(std::move(n));
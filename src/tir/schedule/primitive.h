@@ -66,6 +66,19 @@ TVM_DLL int64_t SampleCategorical(support::LinearCongruentialEngine::TRandState*
  */
 TVM_DLL std::function<int32_t()> MakeMultinomialSampler(
     support::LinearCongruentialEngine::TRandState* rand_state, const std::vector<double>& weights);
+/*!
+ * \brief Create a stateless multinomial sampling function.
+ *
+ *  Unlike the overload above, the returned function owns no random state and draws from the
+ *  random state passed at each call. Together with
+ *  `support::LinearCongruentialEngine::StreamSeed`, this lets parallel search strategies sample
+ *  with one independent stream per candidate, keeping results bit-reproducible regardless of
+ *  thread scheduling.
+ * \param weights The weights for multinomial sampling.
+ * \return The multinomial sampling function, taking the random state to draw from.
+ */
+TVM_DLL std::function<int32_t(support::LinearCongruentialEngine::TRandState*)>
+MakeMultinomialSampler(const std::vector<double>& weights);
 /*!
  * \brief Sample the factors to perfect tile a specific loop
  * \param rand_state The random state
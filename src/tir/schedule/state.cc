@@ -172,6 +172,8 @@ class BlockInfoCollector : private StmtVisitor {
   }
 
   void MakeBlockInfo(StmtSRef scope_root) {
+    // The scope info is fully recomputed below
+    self_->stale_block_info.erase(scope_root->stmt);
     bool is_root_block = srefs_.empty();
     // Calculate `BlockInfo::scope`
     Array<StmtSRef> child_block_srefs = std::move(block_frames_.back());
@@ -332,8 +334,32 @@ class BlockInfoCollector : private StmtVisitor {
   }
 
   void VisitStmt_(const BlockRealizeNode* realize) final {
-    block_frames_.emplace_back();
     const BlockNode* block = realize->block.get();
+    // Incremental update: if no `Replace` call has touched the subtree of this block
+    // since its info was computed, reuse the cached info instead of recursing.
+    // Everything that only depends on the subtree is still valid: the scope dependency
+    // graph, the info of the blocks nested inside, and the `stage_pipeline` flag.
+    // The `affine_binding` flag depends on the loops above the block and is recomputed
+    // here; the `region_cover` flag is recomputed by the enclosing scope.
+    if (!self_->stale_block_info.count(block)) {
+      if (auto it = self_->stmt2ref.find(block); it != self_->stmt2ref.end()) {
+        const StmtSRef& sref = it->second;
+        if (auto info_it = self_->block_info.find(sref); info_it != self_->block_info.end()) {
+          block2realize_.emplace(block, GetRef<BlockRealize>(realize));
+          if (!srefs_.empty()) {
+            info_it->second.affine_binding =
+                IsAffineBinding(/*realize=*/GetRef<BlockRealize>(realize),
+                                /*loop_var_ranges=*/LoopDomainOfSRefTreePath(srefs_.back()),
+                                /*analyzer=*/&analyzer_);
+          }
+          // If this is the root of the visit, the loops above it are unchanged as well,
+          // so the cached `affine_binding` is kept as-is.
+          block_frames_.back().push_back(sref);
+          return;
+        }
+      }
+    }
+    block_frames_.emplace_back();
     block2realize_.emplace(block, GetRef<BlockRealize>(realize));
     // Recursive visit
     PushSRef(block);
@@ -578,6 +604,7 @@ class SRefTreePruner : public StmtVisitor {
     }
     // erase the statement
     self_->stmt2ref.erase(it);
+    self_->stale_block_info.erase(op);
     // detect recursively
     // op->init is omitted
     VisitStmt(op->body);
@@ -681,6 +708,9 @@ class SRefUpdater : public StmtVisitor {
 
   void UpdateBlockInfo(const StmtSRef& block_sref) {
     using TIter = std::unordered_map<StmtSRef, BlockInfo, ObjectPtrHash, ObjectPtrEqual>::iterator;
+    // The subtree of this block is new or rewritten, so its cached info cannot be
+    // trusted until the next UpdateScopeBlockInfo call re-analyzes it.
+    self_->stale_block_info.insert(block_sref->stmt);
     // The caller is responsible for correcting the flags
     BlockInfo new_info((BlockScope(GetChildBlockSRefOnSRefTree(self_, block_sref))));
     std::pair<TIter, bool> insert_result = self_->block_info.emplace(block_sref, new_info);
@@ -966,6 +996,17 @@ void ScheduleStateNode::Replace(const tir::StmtSRef& _src_sref, const Stmt& tgt_
     new_map->at(g_var) = std::move(ref_new_func);
     this->mod = GetRef<IRModule>(new_mod);
   }
+  // Step 4. The scope info of every block enclosing the replaced subtree may be
+  // affected by the edit, whether the enclosing blocks were copied or mutated in
+  // place, so mark them for re-analysis by the next UpdateScopeBlockInfo call.
+  for (const StmtSRefNode* p = src_sref->parent; p != nullptr; p = p->parent) {
+    if (p->stmt != nullptr && p->stmt->IsInstance<BlockNode>()) {
+      this->stale_block_info.insert(p->stmt);
+    }
+  }
+  // The edit may change the answer of any cached analysis, and parts of the old IR may be
+  // freed (so their statement pointers may get reused); drop all the cached entries.
+  this->analysis_cache.Clear();
   uint32_t flag = (debug_mask != -1)                       //
                       ? static_cast<uint32_t>(debug_mask)  //
                       : std::numeric_limits<uint32_t>::max();
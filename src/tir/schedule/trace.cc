@@ -16,6 +16,12 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <tvm/node/structural_equal.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
 #include "./utils.h"
 
 namespace tvm {
@@ -284,6 +290,37 @@ Optional<Instruction> TraceNode::Pop() {
 
 /**************** Interfacing with InstructionKind ****************/
 
+/*!
+ * \brief Replay instructions `[begin, end)` of a trace onto a schedule.
+ * \param trace The trace to be replayed
+ * \param sch The schedule the instructions are applied onto
+ * \param remove_postproc If postprocessing instructions are removed
+ * \param decision_provider A callback that allows users to mutate decisions on the fly
+ * \param begin The index of the first instruction to apply
+ * \param end The index one past the last instruction to apply
+ * \param rv_map The translation table from the trace's random variables to the schedule's.
+ * Keeping it external allows a replay to be split: apply a prefix, snapshot the schedule
+ * together with the table, then resume the rest on a copy of the snapshot.
+ */
+void ApplyTraceToSchedule(const TraceNode* trace, Schedule sch, bool remove_postproc,
+                          FTraceDecisionProvider decision_provider, size_t begin, size_t end,
+                          std::unordered_map<const Object*, const Object*>* rv_map) {
+  for (size_t i = begin; i < end; ++i) {
+    const Instruction& inst = trace->insts[i];
+    if (remove_postproc && inst->kind->IsPostproc()) {
+      break;
+    }
+    Array<ObjectRef> inputs = TranslateInputRVs(inst->inputs, *rv_map);
+    Array<ObjectRef> attrs = inst->attrs;
+    Optional<ObjectRef> decision = trace->GetDecision(inst);
+    if (decision_provider != nullptr) {
+      decision = decision_provider(inst, inputs, attrs, decision);
+    }
+    Array<ObjectRef> outputs = inst->kind->f_apply_to_schedule(sch, inputs, attrs, decision);
+    TranslateAddOutputRVs(inst->outputs, outputs, rv_map);
+  }
+}
+
 void TraceNode::ApplyToSchedule(
     Schedule sch, bool remove_postproc,
     runtime::TypedPackedFunc<ObjectRef(const Instruction& inst, const Array<ObjectRef>& inputs,  //
@@ -291,19 +328,107 @@ void TraceNode::ApplyToSchedule(
                                        const Optional<ObjectRef>& decision)>
         decision_provider) const {
   std::unordered_map<const Object*, const Object*> rv_map;
-  for (const Instruction& inst : this->insts) {
-    if (remove_postproc && inst->kind->IsPostproc()) {
-      break;
+  ApplyTraceToSchedule(this, sch, remove_postproc, decision_provider, 0, this->insts.size(),
+                       &rv_map);
+}
+
+/*! \brief Whether the instruction samples a fresh decision when replayed without one */
+bool IsSamplingInst(const Instruction& inst) {
+  static const InstructionKind& inst_sample_categorical = InstructionKind::Get("SampleCategorical");
+  static const InstructionKind& inst_sample_perfect_tile =
+      InstructionKind::Get("SamplePerfectTile");
+  static const InstructionKind& inst_sample_partitioned_tile =
+      InstructionKind::Get("SamplePartitionedTile");
+  static const InstructionKind& inst_sample_compute_location =
+      InstructionKind::Get("SampleComputeLocation");
+  const InstructionKind& kind = inst->kind;
+  return kind.same_as(inst_sample_categorical) || kind.same_as(inst_sample_perfect_tile) ||
+         kind.same_as(inst_sample_partitioned_tile) || kind.same_as(inst_sample_compute_location);
+}
+
+Array<Schedule> Trace::ApplyToSchedulesInBatch(
+    const Array<Trace>& traces, const runtime::TypedPackedFunc<Schedule()>& f_create,
+    bool remove_postproc) {
+  int n = traces.size();
+  std::vector<Schedule> results(n, Schedule{nullptr});
+  // Group the traces by identical instruction sequences, the shape produced by
+  // decision mutation. Instruction object identity keeps the grouping cheap.
+  std::map<std::vector<const Object*>, std::vector<int>> groups;
+  for (int i = 0; i < n; ++i) {
+    std::vector<const Object*> key;
+    key.reserve(traces[i]->insts.size());
+    for (const Instruction& inst : traces[i]->insts) {
+      if (remove_postproc && inst->kind->IsPostproc()) {
+        break;
+      }
+      key.push_back(inst.get());
     }
-    Array<ObjectRef> inputs = TranslateInputRVs(inst->inputs, rv_map);
-    Array<ObjectRef> attrs = inst->attrs;
-    Optional<ObjectRef> decision = this->GetDecision(inst);
-    if (decision_provider != nullptr) {
-      decision = decision_provider(inst, inputs, attrs, decision);
+    groups[std::move(key)].push_back(i);
+  }
+  StructuralEqual structural_equal;
+  for (const auto& kv : groups) {
+    const std::vector<int>& members = kv.second;
+    const Trace& base = traces[members[0]];
+    size_t prefix_len = kv.first.size();
+    // Sharing must stop at the first undecided sampling instruction: each
+    // replay is expected to sample it independently.
+    size_t safe_depth = prefix_len;
+    for (size_t d = 0; d < prefix_len; ++d) {
+      const Instruction& inst = base->insts[d];
+      if (IsSamplingInst(inst) && !base->GetDecision(inst).defined()) {
+        safe_depth = d;
+        break;
+      }
+    }
+    // The depth at which each member's decisions diverge from the base trace.
+    std::vector<size_t> fork_depth(members.size(), prefix_len);
+    std::set<size_t> fork_points;
+    for (size_t m = 1; m < members.size(); ++m) {
+      const Trace& trace = traces[members[m]];
+      size_t d = 0;
+      for (; d < prefix_len; ++d) {
+        const Instruction& inst = base->insts[d];
+        Optional<ObjectRef> lhs = base->GetDecision(inst);
+        Optional<ObjectRef> rhs = trace->GetDecision(inst);
+        if (lhs.defined() != rhs.defined()) {
+          break;
+        }
+        if (lhs.defined() && !structural_equal(lhs.value(), rhs.value())) {
+          break;
+        }
+      }
+      d = std::min(d, safe_depth);
+      fork_depth[m] = d;
+      fork_points.insert(d);
+    }
+    // Replay the base trace once, snapshotting the schedule and the variable
+    // translation table at every depth some member forks from.
+    std::unordered_map<size_t, Schedule> snapshots;
+    std::unordered_map<size_t, std::unordered_map<const Object*, const Object*>> snapshot_rv_maps;
+    Schedule sch = f_create();
+    std::unordered_map<const Object*, const Object*> rv_map;
+    size_t applied = 0;
+    for (size_t d : fork_points) {
+      ApplyTraceToSchedule(base.get(), sch, remove_postproc, nullptr, applied, d, &rv_map);
+      applied = d;
+      snapshots.emplace(d, sch->Copy());
+      snapshot_rv_maps.emplace(d, rv_map);
+    }
+    ApplyTraceToSchedule(base.get(), sch, remove_postproc, nullptr, applied, prefix_len, &rv_map);
+    results[members[0]] = sch;
+    // Resume every other member on a copy of the snapshot at its fork depth.
+    // The copy forks the random state, so undecided sampling instructions past
+    // the fork still sample independently per member.
+    for (size_t m = 1; m < members.size(); ++m) {
+      size_t d = fork_depth[m];
+      Schedule forked = snapshots.at(d)->Copy();
+      std::unordered_map<const Object*, const Object*> member_rv_map = snapshot_rv_maps.at(d);
+      ApplyTraceToSchedule(traces[members[m]].get(), forked, remove_postproc, nullptr, d,
+                           traces[members[m]]->insts.size(), &member_rv_map);
+      results[members[m]] = forked;
     }
-    Array<ObjectRef> outputs = inst->kind->f_apply_to_schedule(sch, inputs, attrs, decision);
-    TranslateAddOutputRVs(inst->outputs, outputs, &rv_map);
   }
+  return Array<Schedule>(results.begin(), results.end());
 }
 
 ObjectRef TraceNode::AsJSON(bool remove_postproc) const {
@@ -579,6 +704,8 @@ TVM_REGISTER_GLOBAL("tir.schedule.TraceAppend")
 TVM_REGISTER_GLOBAL("tir.schedule.TracePop").set_body_method<Trace>(&TraceNode::Pop);
 TVM_REGISTER_GLOBAL("tir.schedule.TraceApplyToSchedule")
     .set_body_method<Trace>(&TraceNode::ApplyToSchedule);
+TVM_REGISTER_GLOBAL("tir.schedule.TraceApplyToSchedulesInBatch")
+    .set_body_typed(Trace::ApplyToSchedulesInBatch);
 TVM_REGISTER_GLOBAL("tir.schedule.TraceAsJSON").set_body_method<Trace>(&TraceNode::AsJSON);
 TVM_REGISTER_GLOBAL("tir.schedule.TraceAsPython").set_body_method<Trace>(&TraceNode::AsPython);
 TVM_REGISTER_GLOBAL("tir.schedule.TraceWithDecision")
@@ -329,7 +329,7 @@ inline void ReorderAndFuseReductionLoops(const tir::Schedule& sch, const tir::Bl
   // Step 1. Add spatial loops.
   *num_spatial_loops = 0;
   for (size_t i = 0; i < loops.size(); ++i) {
-    if (GetLoopIterType(loop_srefs[i]) == tir::kDataPar) {
+    if (GetLoopIterType(sch->state(), loop_srefs[i]) == tir::kDataPar) {
       new_order.push_back(loops[i]);
       (*num_spatial_loops)++;
     }
@@ -337,7 +337,7 @@ inline void ReorderAndFuseReductionLoops(const tir::Schedule& sch, const tir::Bl
   // Step 2. Add reduction loops.
   Array<tir::LoopRV> reduction_loops;
   for (size_t i = 0; i < loops.size(); ++i) {
-    if (GetLoopIterType(loop_srefs[i]) == tir::kCommReduce) {
+    if (GetLoopIterType(sch->state(), loop_srefs[i]) == tir::kCommReduce) {
       new_order.push_back(loops[i]);
       reduction_loops.push_back(loops[i]);
     }
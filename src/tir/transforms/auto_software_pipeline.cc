@@ -0,0 +1,369 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_software_pipeline.cc
+ * \brief Automatically annotate eligible loops for software pipelining.
+ *
+ *  InjectSoftwarePipeline only transforms loops that carry explicit
+ *  software_pipeline_stage/order annotations, so only hand-written schedules
+ *  benefit from it. This pass detects the canonical GPU mainloop pattern --
+ *  global->shared staging copies followed by compute in a serial loop -- and
+ *  attaches the annotations automatically, picking the stage count from the
+ *  shared memory budget of the target. On CUDA targets with cp.async support
+ *  the copy stage is additionally marked async, so the pipeline is lowered to
+ *  the overlapped form that InjectPTXAsyncCopy targets.
+ *
+ *  The pass is opt-in via the `tir.enable_auto_software_pipeline` config.
+ */
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "./ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+namespace {
+
+/*! \brief The default shared memory budget when the target does not specify one. */
+constexpr int64_t kDefaultSharedMemoryBudget = 48 * 1024;
+/*!
+ * \brief The deepest pipeline the pass will build. Deeper pipelines keep more
+ * copies in flight and hide more of the global memory latency, but multiply
+ * the footprint of the staging buffers.
+ */
+constexpr int kMaxPipelineStages = 4;
+
+/*! \brief Classification of one component (direct child) of a candidate loop body. */
+struct LoopComponent {
+  /*! \brief Whether the component only copies global memory into shared staging buffers. */
+  bool is_copy = false;
+  /*! \brief The shared buffers written by the component, if it is a copy. */
+  Array<Buffer> staging_buffers;
+  /*! \brief The buffers read by the component. */
+  Array<BufferRegion> reads;
+};
+
+/*! \brief Returns the constant footprint of a buffer in bytes, or -1 if dynamic. */
+int64_t BufferConstBytes(const Buffer& buffer) {
+  int64_t numel = 1;
+  for (const PrimExpr& dim : buffer->shape) {
+    const auto* imm = dim.as<IntImmNode>();
+    if (imm == nullptr) {
+      return -1;
+    }
+    numel *= imm->value;
+  }
+  return numel * buffer->dtype.bytes() * buffer->dtype.lanes();
+}
+
+bool IsSharedScope(const Buffer& buffer) {
+  String scope = buffer.scope();
+  return scope == "shared" || scope == "shared.dyn";
+}
+
+/*!
+ * \brief Checks whether a statement is a pure global->shared staging copy:
+ * a (possibly loop-nested) store to a shared buffer whose value is a load from
+ * global memory, optionally guarded the way cp.async supports
+ * (if_then_else with zero padding). This is exactly the pattern that
+ * InjectPTXAsyncCopy can turn into asynchronous copies.
+ */
+bool IsGlobalToSharedCopy(Stmt stmt) {
+  while (true) {
+    if (const auto* loop = stmt.as<ForNode>()) {
+      if (loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled &&
+          loop->kind != ForKind::kVectorized) {
+        return false;
+      }
+      stmt = loop->body;
+    } else if (const auto* realize = stmt.as<BlockRealizeNode>()) {
+      if (!is_one(realize->predicate)) {
+        return false;
+      }
+      stmt = realize->block->body;
+    } else if (const auto* if_then_else = stmt.as<IfThenElseNode>()) {
+      if (if_then_else->else_case.defined()) {
+        return false;
+      }
+      stmt = if_then_else->then_case;
+    } else {
+      break;
+    }
+  }
+  const auto* store = stmt.as<BufferStoreNode>();
+  if (store == nullptr || !IsSharedScope(store->buffer)) {
+    return false;
+  }
+  PrimExpr value = store->value;
+  if (const auto* call = value.as<CallNode>()) {
+    if (!call->op.same_as(builtin::if_then_else()) || call->args.size() != 3) {
+      return false;
+    }
+    value = call->args[1];
+  }
+  const auto* load = value.as<BufferLoadNode>();
+  return load != nullptr && load->buffer.scope() == "global";
+}
+
+/*!
+ * \brief Annotates eligible serial loops with software pipeline stage/order,
+ * leaving the actual transformation to InjectSoftwarePipeline.
+ */
+class AutoPipelineAnnotator : public StmtMutator {
+ public:
+  static PrimFunc Annotate(PrimFunc func, const Target& target, bool use_async_copy) {
+    AutoPipelineAnnotator annotator(target, use_async_copy);
+    for (const auto& [param, buffer] : func->buffer_map) {
+      annotator.buffer_data_to_buffer_.Set(buffer->data, buffer);
+    }
+    auto* n = func.CopyOnWrite();
+    n->body = annotator(std::move(n->body));
+    return func;
+  }
+
+ private:
+  AutoPipelineAnnotator(const Target& target, bool use_async_copy) {
+    if (Optional<Integer> budget = target->GetAttr<Integer>("max_shared_memory_per_block")) {
+      shared_memory_budget_ = budget.value().IntValue();
+    }
+    // cp.async requires sm_80; otherwise the pipeline still overlaps through
+    // multi-versioned staging buffers, just with synchronous copies.
+    if (use_async_copy && target->GetTargetDeviceType() == kDLCUDA) {
+      if (Optional<String> arch = target->GetAttr<String>("arch")) {
+        const std::string& val = arch.value();
+        if (val.size() > 3 && val.compare(0, 3, "sm_") == 0) {
+          async_copy_supported_ = std::atoi(val.c_str() + 3) >= 80;
+        }
+      }
+    }
+  }
+
+  Stmt VisitStmt_(const BlockNode* op) final {
+    for (const Buffer& buffer : op->alloc_buffers) {
+      buffer_data_to_buffer_.Set(buffer->data, buffer);
+    }
+    Stmt result = StmtMutator::VisitStmt_(op);
+    for (const Buffer& buffer : op->alloc_buffers) {
+      buffer_data_to_buffer_.erase(buffer->data);
+    }
+    return result;
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    size_t num_annotated_before = num_annotated_;
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    // Do not build pipelines around loops that already contain one, whether
+    // annotated by hand or by this pass.
+    if (num_annotated_ != num_annotated_before || HasPipelineAnnotation(op)) {
+      return stmt;
+    }
+    if (op->kind != ForKind::kSerial || op->thread_binding.defined()) {
+      return stmt;
+    }
+    const auto* extent = op->extent.as<IntImmNode>();
+    if (extent == nullptr || extent->value < 2) {
+      return stmt;
+    }
+    // The staging buffers must be allocated under the loop so that
+    // InjectSoftwarePipeline can multi-version them.
+    const auto* realize = op->body.as<BlockRealizeNode>();
+    if (realize == nullptr || !is_one(realize->predicate) ||
+        realize->block->alloc_buffers.empty()) {
+      return stmt;
+    }
+    const auto* seq = realize->block->body.as<SeqStmtNode>();
+    if (seq == nullptr) {
+      return stmt;
+    }
+    for (const Buffer& buffer : realize->block->alloc_buffers) {
+      buffer_data_to_buffer_.Set(buffer->data, buffer);
+    }
+    std::vector<LoopComponent> components = ClassifyComponents(seq);
+    for (const Buffer& buffer : realize->block->alloc_buffers) {
+      buffer_data_to_buffer_.erase(buffer->data);
+    }
+    int num_stages = PickStageCount(components, realize->block->alloc_buffers, extent->value);
+    if (num_stages < 2) {
+      return stmt;
+    }
+    // Copies go to the prologue stage, everything else to the final stage, so
+    // that `num_stages - 1` iterations worth of copies stay in flight.
+    Array<Integer> stages;
+    Array<Integer> orders;
+    for (size_t i = 0; i < components.size(); ++i) {
+      stages.push_back(Integer(components[i].is_copy ? 0 : num_stages - 1));
+      orders.push_back(Integer(static_cast<int>(i)));
+    }
+    For new_loop = Downcast<For>(stmt);
+    ForNode* n = new_loop.CopyOnWrite();
+    n->annotations.Set(attr::software_pipeline_stage, stages);
+    n->annotations.Set(attr::software_pipeline_order, orders);
+    if (async_copy_supported_) {
+      n->annotations.Set(attr::software_pipeline_async_stages, Array<Integer>{Integer(0)});
+    }
+    ++num_annotated_;
+    return std::move(new_loop);
+  }
+
+  /*!
+   * \brief Classifies the direct children of the loop body and checks the
+   * staging pattern. Returns an empty vector if the loop is not eligible.
+   */
+  std::vector<LoopComponent> ClassifyComponents(const SeqStmtNode* seq) {
+    std::vector<LoopComponent> components;
+    components.reserve(seq->seq.size());
+    bool seen_compute = false;
+    for (const Stmt& child : seq->seq) {
+      LoopComponent component;
+      Block block(/*iter_vars=*/{}, /*reads=*/{}, /*writes=*/{}, /*name_hint=*/"", /*body=*/child);
+      Array<Array<BufferRegion>> access = GetBlockReadWriteRegion(block, buffer_data_to_buffer_);
+      component.reads = access[0];
+      if (IsGlobalToSharedCopy(child)) {
+        component.is_copy = true;
+        for (const BufferRegion& region : access[1]) {
+          component.staging_buffers.push_back(region->buffer);
+        }
+        if (seen_compute) {
+          // Copies interleaved after compute break the simple two-stage
+          // assignment; leave such loops to explicit schedules.
+          return {};
+        }
+      } else {
+        seen_compute = true;
+      }
+      components.push_back(component);
+    }
+    return components;
+  }
+
+  /*!
+   * \brief Picks the number of pipeline stages: the deepest pipeline (capped
+   * at kMaxPipelineStages and the loop extent) whose multi-versioned staging
+   * buffers still fit into the shared memory budget next to the shared
+   * allocations that are not versioned. Returns 0 if the loop is ineligible.
+   */
+  int PickStageCount(const std::vector<LoopComponent>& components,
+                     const Array<Buffer>& alloc_buffers, int64_t loop_extent) {
+    bool has_copy = false;
+    bool has_compute = false;
+    std::unordered_set<const BufferNode*> staging;
+    for (const LoopComponent& component : components) {
+      if (component.is_copy) {
+        has_copy = true;
+        for (const Buffer& buffer : component.staging_buffers) {
+          staging.insert(buffer.get());
+        }
+      } else {
+        // The compute must consume the staged data for pipelining to overlap
+        // anything worthwhile.
+        for (const BufferRegion& region : component.reads) {
+          if (staging.count(region->buffer.get())) {
+            has_compute = true;
+          }
+        }
+      }
+    }
+    if (!has_copy || !has_compute) {
+      return 0;
+    }
+    int64_t staged_bytes = 0;
+    int64_t unversioned_bytes = 0;
+    for (const Buffer& buffer : alloc_buffers) {
+      if (!IsSharedScope(buffer)) {
+        continue;
+      }
+      int64_t bytes = BufferConstBytes(buffer);
+      if (bytes < 0) {
+        return 0;
+      }
+      (staging.count(buffer.get()) ? staged_bytes : unversioned_bytes) += bytes;
+    }
+    if (staged_bytes <= 0) {
+      // The copies write shared memory allocated outside the loop; those
+      // buffers cannot be multi-versioned.
+      return 0;
+    }
+    int64_t max_stages = std::min<int64_t>(kMaxPipelineStages, loop_extent);
+    for (int64_t k = max_stages; k >= 2; --k) {
+      if (staged_bytes * k + unversioned_bytes <= shared_memory_budget_) {
+        return static_cast<int>(k);
+      }
+    }
+    return 0;
+  }
+
+  bool HasPipelineAnnotation(const ForNode* op) const {
+    return op->annotations.count(attr::software_pipeline_stage) ||
+           op->annotations.count(attr::software_pipeline_order);
+  }
+
+  /*! \brief The mapping from buffer data vars to the buffers in scope. */
+  Map<Var, Buffer> buffer_data_to_buffer_;
+  /*! \brief The shared memory capacity the pipeline may use. */
+  int64_t shared_memory_budget_ = kDefaultSharedMemoryBudget;
+  /*! \brief Whether the copy stage can be lowered to cp.async. */
+  bool async_copy_supported_ = false;
+  /*! \brief Number of loops annotated so far, used to detect nesting. */
+  size_t num_annotated_ = 0;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass AutoSoftwarePipeline() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    bool enabled =
+        ctx->GetConfig<Bool>("tir.enable_auto_software_pipeline", Bool(false)).value();
+    if (!enabled) {
+      return f;
+    }
+    Optional<Target> target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target.defined()) {
+      target = Target::Current();
+    }
+    if (!target.defined() || target.value()->GetTargetDeviceType() != kDLCUDA) {
+      return f;
+    }
+    bool use_async_copy = ctx->GetConfig<Bool>("tir.use_async_copy", Bool(false)).value();
+    return AutoPipelineAnnotator::Annotate(std::move(f), target.value(), use_async_copy);
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.AutoSoftwarePipeline", {});
+}
+
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_auto_software_pipeline", Bool);
+
+TVM_REGISTER_GLOBAL("tir.transform.AutoSoftwarePipeline").set_body_typed(AutoSoftwarePipeline);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -0,0 +1,254 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_texture_placement.cc
+ * \brief Automatically place eligible intermediate buffers in texture memory.
+ *
+ * Texture placement previously relied on schedules annotating buffers with
+ * the "global.texture" storage scope by hand; unannotated models paid global
+ * memory latency for accesses the Adreno texture cache would serve. This
+ * pass scores every realized intermediate buffer before TextureFlatten runs
+ * and rewrites the storage scope of the profitable ones, so TextureFlatten
+ * then lowers them to image2d allocations and texture2d_load/store accesses
+ * exactly as if the schedule had been annotated.
+ */
+
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/stmt.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../runtime/texture.h"
+
+namespace tvm {
+namespace tir {
+
+using runtime::ApplyTexture2DFlattening;
+using runtime::DefaultTextureLayoutSeparator;
+using runtime::IsTextureStorage;
+using runtime::Texture2DShape;
+
+/*! \brief Minimum width and height supported by OpenCL image2d on the devices we target. */
+static constexpr int64_t kMaxTexture2DDim = 16384;
+
+/*! \brief Collect per-buffer access statistics to decide texture placement. */
+class TexturePlacementAnalyzer : public StmtExprVisitor {
+ public:
+  struct BufferStat {
+    /*! \brief Number of load sites of the buffer. */
+    int num_loads{0};
+    /*! \brief Number of store sites of the buffer. */
+    int num_stores{0};
+    /*! \brief Whether a load of the buffer was seen before all of its stores. */
+    bool load_before_store{false};
+  };
+
+  explicit TexturePlacementAnalyzer(const Map<Var, Buffer>& extern_buffer_map) {
+    for (auto kv : extern_buffer_map) {
+      extern_buf_.insert(kv.second.get());
+    }
+  }
+
+  void VisitStmt_(const BufferRealizeNode* op) final {
+    if (!extern_buf_.count(op->buffer.get())) {
+      realized_.insert(op->buffer.get());
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    stats_[op->buffer.get()].num_stores++;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    BufferStat& stat = stats_[op->buffer.get()];
+    stat.num_loads++;
+    if (stat.num_stores == 0) {
+      stat.load_before_store = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  /*!
+   * \brief Decide which realized buffers should be placed in texture memory.
+   * \return The selected buffers.
+   */
+  std::unordered_set<const BufferNode*> SelectTextureBuffers() const {
+    std::unordered_set<const BufferNode*> selected;
+    for (const BufferNode* buffer : realized_) {
+      if (IsEligible(buffer) && IsProfitable(buffer)) {
+        selected.insert(buffer);
+      }
+    }
+    return selected;
+  }
+
+ private:
+  /*! \brief Check the hard constraints of the image2d lowering. */
+  bool IsEligible(const BufferNode* buffer) const {
+    // Textures only hold what image2d channels can represent.
+    if (buffer->dtype != DataType::Float(32) && buffer->dtype != DataType::Float(16)) {
+      return false;
+    }
+    // Respect explicit scope decisions, e.g. shared memory staging or a
+    // hand-written texture annotation; only re-place plain global buffers.
+    if (const auto* ptr = buffer->data->type_annotation.as<PointerTypeNode>()) {
+      std::string scope = ptr->storage_scope;
+      if (scope != "" && scope != "global") {
+        return false;
+      }
+    }
+    // TextureFlatten supports Nd buffers whose innermost dimension is the
+    // RGBA vector; all extents must be static to size the image.
+    if (buffer->shape.size() < 3) {
+      return false;
+    }
+    for (const PrimExpr& extent : buffer->shape) {
+      if (!extent.as<IntImmNode>()) {
+        return false;
+      }
+    }
+    const auto* vec_length = buffer->shape.back().as<IntImmNode>();
+    if (vec_length->value != 4) {
+      return false;
+    }
+    struct ShapeAsInt {
+      const Array<PrimExpr>& shape;
+      int64_t operator[](size_t i) const { return shape[i].as<IntImmNode>()->value; }
+    };
+    size_t rank = buffer->shape.size();
+    size_t axis = DefaultTextureLayoutSeparator(rank, "global.texture");
+    Texture2DShape<int64_t> texture =
+        ApplyTexture2DFlattening<int64_t>(ShapeAsInt{buffer->shape}, rank, axis);
+    return texture.width <= kMaxTexture2DDim && texture.height <= kMaxTexture2DDim;
+  }
+
+  /*! \brief Score the access pattern for texture cache benefit. */
+  bool IsProfitable(const BufferNode* buffer) const {
+    auto it = stats_.find(buffer);
+    if (it == stats_.end()) {
+      return false;
+    }
+    const BufferStat& stat = it->second;
+    // The texture cache only pays off on the read side: require a produce
+    // phase followed by reads, and no reads of uninitialized contents that
+    // would suggest the buffer aliases state across iterations.
+    return stat.num_stores > 0 && stat.num_loads > 0 && !stat.load_before_store;
+  }
+
+  // Intermediate buffers realized in the function.
+  std::unordered_set<const BufferNode*> realized_;
+  // External input and output buffers, never re-placed.
+  std::unordered_set<const BufferNode*> extern_buf_;
+  // Access statistics per buffer.
+  std::unordered_map<const BufferNode*, BufferStat> stats_;
+};
+
+/*! \brief Rewrite the storage scope of the selected buffers to global.texture. */
+class TextureScopeRewriter : public StmtExprMutator {
+ public:
+  explicit TextureScopeRewriter(const std::unordered_set<const BufferNode*>& selected)
+      : selected_(selected) {}
+
+  Stmt VisitStmt_(const BufferRealizeNode* op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    op = stmt.as<BufferRealizeNode>();
+    if (selected_.count(op->buffer.get())) {
+      BufferRealize realize = Downcast<BufferRealize>(stmt);
+      realize.CopyOnWrite()->buffer = GetUpdatedBuffer(op->buffer);
+      return realize;
+    }
+    return stmt;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    op = stmt.as<BufferStoreNode>();
+    if (selected_.count(op->buffer.get())) {
+      BufferStore store = Downcast<BufferStore>(stmt);
+      store.CopyOnWrite()->buffer = GetUpdatedBuffer(op->buffer);
+      return store;
+    }
+    return stmt;
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    PrimExpr expr = StmtExprMutator::VisitExpr_(op);
+    op = expr.as<BufferLoadNode>();
+    if (selected_.count(op->buffer.get())) {
+      BufferLoad load = Downcast<BufferLoad>(expr);
+      load.CopyOnWrite()->buffer = GetUpdatedBuffer(op->buffer);
+      return load;
+    }
+    return expr;
+  }
+
+ private:
+  Buffer GetUpdatedBuffer(Buffer buffer) {
+    auto it = buffer_remap_.find(buffer.get());
+    if (it != buffer_remap_.end()) {
+      return it->second;
+    }
+    const BufferNode* key = buffer.get();
+    Var new_data(buffer->data->name_hint,
+                 PointerType(PrimType(buffer->dtype), String("global.texture")));
+    Buffer new_buffer = buffer;
+    new_buffer.CopyOnWrite()->data = new_data;
+    buffer_remap_[key] = new_buffer;
+    return new_buffer;
+  }
+
+  const std::unordered_set<const BufferNode*>& selected_;
+  std::unordered_map<const BufferNode*, Buffer> buffer_remap_;
+};
+
+PrimFunc AutoTexturePlacement(PrimFunc func) {
+  TexturePlacementAnalyzer analyzer(func->buffer_map);
+  analyzer(func->body);
+  auto selected = analyzer.SelectTextureBuffers();
+  if (selected.empty()) {
+    return func;
+  }
+  auto fptr = func.CopyOnWrite();
+  fptr->body = TextureScopeRewriter(selected)(std::move(fptr->body));
+  return func;
+}
+
+namespace transform {
+
+Pass AutoTexturePlacement() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    return AutoTexturePlacement(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.AutoTexturePlacement", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.AutoTexturePlacement").set_body_typed(AutoTexturePlacement);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
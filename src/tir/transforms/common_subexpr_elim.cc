@@ -133,8 +133,8 @@ bool CommonSubexpressionEliminator::CanContainEligibleComputations(const PrimExp
  */
 bool CommonSubexpressionEliminator::OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a,
                                                             std::pair<PrimExpr, size_t> b) {
-  size_t a_size = CalculateExprComplexity(a.first);
-  size_t b_size = CalculateExprComplexity(b.first);
+  size_t a_size = MemoizedExprComplexity(a.first);
+  size_t b_size = MemoizedExprComplexity(b.first);
 
   // Criteria 1 - Size of the expression comes first
   // `a` comes before `b` if the size of `a` is bigger
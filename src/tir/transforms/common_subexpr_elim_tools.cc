@@ -37,6 +37,7 @@
 #include <tvm/tir/transform.h>  // For the declaration of the pass
 
 #include <algorithm>      // For std::find_if
+#include <string>
 #include <unordered_map>  // For the hashtable datatype
 #include <utility>
 #include <vector>
@@ -50,6 +51,55 @@ namespace tir {
 // such static attribute, otherwise it causes a linking error.
 ComputationCache ComputationsDoneBy::cache_;
 
+// The memoization caches below are keyed by object identity, which is sound as expressions are
+// immutable. The keys are PrimExpr (and not raw pointers) so that the cached objects stay alive :
+// otherwise a freed object could be reused at the same address with a different content, and the
+// stale cache entry would be wrongly returned for it. When a cache grows past this limit, it is
+// simply emptied, which only costs recomputations : this is the graceful way of bounding the
+// memory that the caches can retain across the functions being compiled.
+constexpr size_t kMemoizationCacheMaxSize = 1 << 20;
+
+// Above this number of distinct syntactic computations, SyntacticToSemanticComputations() stops
+// identifying equivalent terms (which needs simplifications and pairwise comparisons) and just
+// keeps the computations syntactically distinct. This keeps the pass close to linear on huge
+// tables, at the price of potentially missing some commonings on them.
+constexpr size_t kMaxTableSizeForEquivalenceIdentification = 2048;
+
+/*!
+ * \brief The () operator of the memoized hash : computes the structural hash on the first query
+          for a given object, and retrieves it from the cache afterwards.
+ */
+size_t MemoizedStructuralHash::operator()(const PrimExpr& expr) const {
+  static std::unordered_map<PrimExpr, size_t, ObjectPtrHash, ObjectPtrEqual> cache;
+  auto it = cache.find(expr);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  size_t hash = StructuralHash()(expr);
+  if (cache.size() >= kMemoizationCacheMaxSize) {
+    cache.clear();
+  }
+  cache[expr] = hash;
+  return hash;
+}
+
+/*!
+ * \brief Memoized version of CalculateExprComplexity(), which gives the size of an expression.
+ */
+size_t MemoizedExprComplexity(const PrimExpr& expr) {
+  static std::unordered_map<PrimExpr, size_t, ObjectPtrHash, ObjectPtrEqual> cache;
+  auto it = cache.find(expr);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  size_t complexity = CalculateExprComplexity(expr);
+  if (cache.size() >= kMemoizationCacheMaxSize) {
+    cache.clear();
+  }
+  cache[expr] = complexity;
+  return complexity;
+}
+
 /* ********************************** Class ComputationsDoneBy **********************************
 *********************************************************************************************** */
 
@@ -740,8 +790,22 @@ PrimExpr NormalizeTerm(const PrimExpr& expr, bool do_normalization) {
     // offered by arith::Analyzer::Simplify(). "pseudo" because while it is correct (i.e.
     // the simplification is indeed equivalent to the original term), it is incomplete (i.e.
     // the returned term is not guaranteed to be a normal form).
+
+    // The normal form of a given object never changes, and this function is called (via
+    // EquivalentTerms()) on the same terms over and over again while selecting the occurrences
+    // to replace, so the result of the (costly) simplification is memoized by object identity.
+    static std::unordered_map<PrimExpr, PrimExpr, ObjectPtrHash, ObjectPtrEqual> cache;
+    auto it = cache.find(expr);
+    if (it != cache.end()) {
+      return it->second;
+    }
     arith::Analyzer analyzer;
-    return analyzer.Simplify(expr);
+    PrimExpr normalized = analyzer.Simplify(expr);
+    if (cache.size() >= kMemoizationCacheMaxSize) {
+      cache.clear();
+    }
+    cache[expr] = normalized;
+    return normalized;
   } else {
     // If `do_normalization` is false, the equivalence relation just checks the syntactic equality,
     // so the normalization is just the identity function.
@@ -778,6 +842,14 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
     const ComputationTable& table, bool identify_equiv_terms) {
   std::vector<std::pair<PrimExpr, size_t>> result;
 
+  // Identifying equivalent terms needs to normalize (i.e. simplify) every computation and to sort
+  // the whole table, which does not scale to the huge tables that deeply fused kernels produce.
+  // Above the budget we degrade gracefully to the purely syntactic treatment, which only misses
+  // the commonings between terms that are equivalent without being syntactically equal.
+  if (table.size() > kMaxTableSizeForEquivalenceIdentification) {
+    identify_equiv_terms = false;
+  }
+
   // If we do NOT identify equivalent terms, then we simply need to transform the input hashtable
   // into a vector, without doing anything else.
   if (!identify_equiv_terms) {
@@ -797,7 +869,7 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // normalized. This normalized table will keep the count for each set of equivalent terms
   // (i.e. each equivalence class), together with a term that did appear in this equivalence class
   // (in practice, the first term of the equivalence class that was encoutered).
-  std::unordered_map<PrimExpr, std::pair<PrimExpr, size_t>, StructuralHash, ExprDeepEqual>
+  std::unordered_map<PrimExpr, std::pair<PrimExpr, size_t>, MemoizedStructuralHash, ExprDeepEqual>
       norm_table;
 
   // In order to avoid frequent rehashing if the norm_table becomes big, we immediately ask for
@@ -812,14 +884,23 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // (otherwise {x+y, y+x} could be both replaced by x+y, and on another run by y+x).
   std::vector<std::pair<PrimExpr, size_t>> sorted_items_of_table(table.begin(), table.end());
 
-  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering
+  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering.
+  // The repr of each expression is built only once (printing is linear in the size of the
+  // expression, so rebuilding it inside the comparator would make the sort superlinear).
+  std::vector<std::string> reprs;
+  reprs.reserve(sorted_items_of_table.size());
+  std::unordered_map<const PrimExprNode*, size_t> repr_index;
+  for (const auto& elem : sorted_items_of_table) {
+    std::stringstream elem_stream;
+    elem_stream << AsLegacyRepr(elem.first);
+    repr_index[elem.first.get()] = reprs.size();
+    reprs.push_back(elem_stream.str());
+  }
   sort(sorted_items_of_table.begin(), sorted_items_of_table.end(),
-       [](std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b) {
-         std::stringstream a_stream;
-         std::stringstream b_stream;
-         a_stream << AsLegacyRepr(a.first);
-         b_stream << AsLegacyRepr(b.first);
-         return a_stream.str().compare(b_stream.str()) < 0;
+       [&reprs, &repr_index](const std::pair<PrimExpr, size_t>& a,
+                             const std::pair<PrimExpr, size_t>& b) {
+         return reprs[repr_index.at(a.first.get())].compare(reprs[repr_index.at(b.first.get())]) <
+                0;
        });
 
   for (const auto& elem : sorted_items_of_table) {
@@ -850,7 +931,7 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // Careful : the pairs will never change (the canonical represantants chosen will always be the
   // same), but the order in which the pairs are produced can vary as we are iterating through the
   // hashtable `norm_table`. It is not an issue as the called will be sorting the result anyway.
-  std::unordered_map<PrimExpr, std::pair<PrimExpr, size_t>, StructuralHash,
+  std::unordered_map<PrimExpr, std::pair<PrimExpr, size_t>, MemoizedStructuralHash,
                      ExprDeepEqual>::const_iterator it_norm_table;
   for (it_norm_table = norm_table.begin(); it_norm_table != norm_table.end(); ++it_norm_table) {
     result.push_back(it_norm_table->second);
@@ -891,7 +972,7 @@ void InsertElemToSortedSemanticComputations(std::vector<std::pair<PrimExpr, size
   auto insertion_point = std::lower_bound(
       sorted_vec->begin(), sorted_vec->end(), pair,
       [](const std::pair<PrimExpr, size_t>& left, const std::pair<PrimExpr, size_t>& right) {
-        return (CalculateExprComplexity(left.first) >= CalculateExprComplexity(right.first));
+        return (MemoizedExprComplexity(left.first) >= MemoizedExprComplexity(right.first));
       });
   sorted_vec->insert(insertion_point, pair);
 }
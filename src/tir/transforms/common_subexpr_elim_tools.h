@@ -41,16 +41,29 @@
 namespace tvm {
 namespace tir {
 
+/*!
+ * \brief Hash functor which returns the structural hash of an expression, memoized by object
+          identity. As expressions are immutable, the structural hash of a given object never
+          changes, so it can be computed on the first query and then simply retrieved, instead of
+          traversing the whole expression again on each insertion or lookup in a hashtable.
+          The memoization is what keeps the cost of the occurrence analysis close to linear on
+          deeply nested programs, where the same (shared) subexpressions get hashed many times.
+ */
+struct MemoizedStructuralHash {
+  size_t operator()(const PrimExpr& expr) const;
+};
+
 /*!
  * \brief A computation table is a hashtable which associates to each expression being computed
           a number (which is the number of time that it is computed)
-          It is important to note that the hash used is a StructuralHash (and not an ObjectPtrHash)
+          It is important to note that the hash used is a structural hash (and not an ObjectPtrHash)
           as we need to hash similarly deeply equal terms.
           The comparison used is ExprDeepEqual, which is stricter than StructuralEqual (as it does
           not do variables remapping), so it is compatible with StructuralHash (intended to be used
           with StructuralEqual).
  */
-using ComputationTable = std::unordered_map<PrimExpr, size_t, StructuralHash, ExprDeepEqual>;
+using ComputationTable =
+    std::unordered_map<PrimExpr, size_t, MemoizedStructuralHash, ExprDeepEqual>;
 
 /*!
  * \brief A cache of computations is made of a pair of two hashtables, which respectively associate
@@ -176,6 +189,10 @@ class UsesVarName : public StmtExprVisitor {
  */
 void PrintComputationTable(const ComputationTable& table);
 
+// The size of an expression (as given by CalculateExprComplexity()), memoized by object identity.
+// Used by the orderings on computations, which would otherwise recompute it on each comparison.
+size_t MemoizedExprComplexity(const PrimExpr& expr);
+
 using MaybeValue = std::optional<PrimExpr>;
 
 bool EqualTerms(const PrimExpr& a, const PrimExpr& b);
@@ -0,0 +1,218 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership. The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inject_lds_swizzle.cc
+ * \brief The pass injects a swizzled layout for AMD LDS buffers to avoid bank conflicts.
+ *
+ * This is the ROCm counterpart of inject_permuted_layout.cc. AMD LDS has
+ * 32 banks of 4 bytes each and a wave64 wavefront accesses it in
+ * quarter-waves of 16 lanes, so the conflict geometry differs from the
+ * CUDA shared memory layout that pass targets: MFMA fragment loads read
+ * 4-element vectors per lane instead of the 8-element ldmatrix rows, and
+ * there is no ldmatrix-style intrinsic to patch up -- after tensorization
+ * the fragment loads are ordinary BufferLoad nodes, so rewriting
+ * BufferStore/BufferLoad indices is sufficient.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../../arith/ir_mutator_with_analyzer.h"
+#include "../../runtime/thread_storage_scope.h"
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+using namespace arith;
+using namespace runtime;
+
+class LDSSwizzleInjector : private IRMutatorWithAnalyzer {
+ public:
+  static PrimFunc Transform(PrimFunc func) {
+    Analyzer analyzer;
+
+    auto new_body = LDSSwizzleInjector(&analyzer)(func->body);
+    auto func_node = func.CopyOnWrite();
+    func_node->body = new_body;
+    return func;
+  }
+
+ private:
+  explicit LDSSwizzleInjector(Analyzer* analyzer) : IRMutatorWithAnalyzer(analyzer) {}
+
+  using IRMutatorWithAnalyzer::VisitExpr_;
+  using IRMutatorWithAnalyzer::VisitStmt_;
+
+  Array<PrimExpr> SwizzleIndices(PrimExpr row_idx, PrimExpr col_idx, int row_size) {
+    ICHECK(swizzle_);
+    // Index after vectorizing by 4, the per-lane vector width of MFMA
+    // fragment loads (ds_read_b64 for fp16, ds_read_b128 for fp32).
+    PrimExpr col_idx_outer = floordiv(col_idx, VECTORIZE_FACTOR),
+             col_idx_inner = floormod(col_idx, VECTORIZE_FACTOR);
+    PrimExpr new_col_idx_outer;
+    if (row_size % 32 == 0) {
+      // XOR the vector index with the row index modulo 8, so the 8
+      // vectors a quarter-wave reads down a column land in 8 distinct
+      // groups of the 32 LDS banks:
+      // 0  1  2  3  4  5  6  7    ==>    0  1  2  3  4  5  6  7
+      // 0  1  2  3  4  5  6  7    ==>    1  0  3  2  5  4  7  6
+      // 0  1  2  3  4  5  6  7    ==>    2  3  0  1  6  7  4  5
+      // 0  1  2  3  4  5  6  7    ==>    3  2  1  0  7  6  5  4
+      // 0  1  2  3  4  5  6  7    ==>    4  5  6  7  0  1  2  3
+      // 0  1  2  3  4  5  6  7    ==>    5  4  7  6  1  0  3  2
+      // 0  1  2  3  4  5  6  7    ==>    6  7  4  5  2  3  0  1
+      // 0  1  2  3  4  5  6  7    ==>    7  6  5  4  3  2  1  0
+      new_col_idx_outer = col_idx_outer ^ floormod(row_idx, 8);
+    } else {
+      ICHECK(row_size % 16 == 0);
+      // Narrow rows only span half the banks; pair up adjacent rows so
+      // the XOR pattern stays within the row:
+      // 0  1  2  3    ==>    0  1  2  3
+      // 0  1  2  3    ==>    0  1  2  3
+      // 0  1  2  3    ==>    1  0  3  2
+      // 0  1  2  3    ==>    1  0  3  2
+      // 0  1  2  3    ==>    2  3  0  1
+      // 0  1  2  3    ==>    2  3  0  1
+      // 0  1  2  3    ==>    3  2  1  0
+      // 0  1  2  3    ==>    3  2  1  0
+      new_col_idx_outer = col_idx_outer ^ floordiv(floormod(row_idx, 8), 2);
+    }
+    return {row_idx,
+            analyzer_->Simplify(new_col_idx_outer * VECTORIZE_FACTOR + col_idx_inner)};
+  }
+
+  static bool CheckAnnotation(ObjectRef annotation) {
+    if (auto* node = annotation.as<StringObj>()) {
+      return GetRef<String>(node) != "";
+    } else if (auto* node = annotation.as<IntImmNode>()) {
+      return node->value != 0;
+    } else {
+      LOG(FATAL) << "Invalid LDS swizzle annotation: " << annotation;
+    }
+  }
+
+  Stmt VisitStmt_(const BlockNode* op) final {
+    if (op->annotations.count("lds_swizzle") == 0 ||
+        !CheckAnnotation(op->annotations.at("lds_swizzle"))) {
+      return IRMutatorWithAnalyzer::VisitStmt_(op);
+    }
+
+    auto prev_swizzle = swizzle_;
+    swizzle_ = true;
+
+    Block block = Downcast<Block>(IRMutatorWithAnalyzer::VisitStmt_(op));
+
+    swizzle_ = prev_swizzle;
+
+    // Erase the lds_swizzle annotation after the pass
+    auto block_node = block.CopyOnWrite();
+    block_node->annotations.erase("lds_swizzle");
+    return block;
+  }
+
+  int CheckAndGetBufferRowSize(Buffer buffer) {
+    CHECK(buffer->shape.size() >= 2)
+        << "The dimension of Buffer \"" << buffer->name << "\" with shape " << buffer->shape
+        << " should be at least 2";
+
+    auto dim = buffer->shape.size();
+    auto buffer_row_size = buffer->shape[dim - 1].as<IntImmNode>()->value;
+
+    if (buffer_row_size % 32 != 0) {
+      CHECK(buffer_row_size % 16 == 0)
+          << "LDS swizzle for Buffer \"" << buffer->name << "\" with shape " << buffer->shape
+          << " is not supported since its last dimension is not divisible by 16";
+    }
+
+    return buffer_row_size;
+  }
+
+  Array<PrimExpr> HandleBufferIndices(Buffer buffer, Array<PrimExpr> indices) {
+    auto buffer_row_size = CheckAndGetBufferRowSize(buffer);
+
+    // Mutate the last two indices
+    auto indices_size = indices.size();
+    PrimExpr row_idx = indices[indices_size - 2];
+    PrimExpr col_idx = indices[indices_size - 1];
+    auto new_indices = SwizzleIndices(row_idx, col_idx, buffer_row_size);
+    indices.Set(indices_size - 2, new_indices[0]);
+    indices.Set(indices_size - 1, new_indices[1]);
+    return indices;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    // Rewrite write from global to shared (LDS)
+    auto store = Downcast<BufferStore>(IRMutatorWithAnalyzer::VisitStmt_(op));
+
+    if (!swizzle_ || store->buffer->shape.size() < 2) {
+      return store;
+    }
+
+    auto scope = StorageScope::Create(GetPtrStorageScope(store->buffer->data));
+    if (scope.rank != StorageRank::kShared) {
+      return store;
+    }
+
+    auto store_node = store.CopyOnWrite();
+    store_node->indices = HandleBufferIndices(store_node->buffer, store_node->indices);
+    return store;
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    // Rewrite load from shared (LDS) to the MFMA fragment registers
+    auto load = Downcast<BufferLoad>(IRMutatorWithAnalyzer::VisitExpr_(op));
+
+    if (!swizzle_ || load->buffer->shape.size() < 2) {
+      return load;
+    }
+
+    auto scope = StorageScope::Create(GetPtrStorageScope(load->buffer->data));
+    if (scope.rank != StorageRank::kShared) {
+      return load;
+    }
+
+    auto load_node = load.CopyOnWrite();
+    load_node->indices = HandleBufferIndices(load_node->buffer, load_node->indices);
+    return load;
+  }
+
+  static constexpr size_t VECTORIZE_FACTOR = 4;
+
+  bool swizzle_ = false;
+};
+
+namespace transform {
+
+Pass InjectLDSSwizzle() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    return LDSSwizzleInjector::Transform(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectLDSSwizzle", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InjectLDSSwizzle").set_body_typed(InjectLDSSwizzle);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -71,6 +71,13 @@ class DeviceInfoCollector : public StmtVisitor {
 
     collector(func->body);
 
+    // Kernels that synchronize across the grid must be launched through the
+    // cooperative launch API.
+    if (UsesGridSync(func->body)) {
+      collector.info_.launch_params.push_back(
+          tvm::runtime::launch_param::kUseCooperativeLaunchTag);
+    }
+
     // The dynamic shared memory is required to be the last of the
     // kernel launch parameters
     if (collector.dyn_shmem_size) {
@@ -81,13 +88,35 @@ class DeviceInfoCollector : public StmtVisitor {
     collector.info_.global_symbol =
         func->GetAttr<String>(tvm::attr::kGlobalSymbol).value_or(gvar->name_hint);
 
-    collector.info_.launch_args = collector.info_.launch_params.Map(
-        [&](const auto& param) { return collector.GetArgument(param); });
+    for (const auto& param : collector.info_.launch_params) {
+      // The cooperative launch tag only flags the launch API to use and
+      // carries no host-side argument.
+      if (param == tvm::runtime::launch_param::kUseCooperativeLaunchTag) {
+        continue;
+      }
+      collector.info_.launch_args.push_back(collector.GetArgument(param));
+    }
 
     return collector.info_;
   }
 
  private:
+  static bool UsesGridSync(const Stmt& body) {
+    bool uses_grid_sync = false;
+    PostOrderVisit(body, [&uses_grid_sync](const ObjectRef& node) {
+      if (const auto* call = node.as<CallNode>()) {
+        if (call->op.same_as(builtin::tvm_storage_sync())) {
+          if (const auto* scope = call->args[0].as<StringImmNode>()) {
+            if (scope->value == "grid") {
+              uses_grid_sync = true;
+            }
+          }
+        }
+      }
+    });
+    return uses_grid_sync;
+  }
+
   PrimExpr GetArgument(const String& launch_param) const {
     if (launch_param == tvm::runtime::launch_param::kUseDynamicSharedMemoryTag) {
       CHECK(dyn_shmem_size.defined())
@@ -25,6 +25,7 @@
 
 #include <tvm/arith/analyzer.h>
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/target/target_info.h>
 #include <tvm/te/operation.h>
@@ -1905,6 +1906,10 @@ PrimFunc StorageFlatten(PrimFunc func, int cache_line_size, bool create_bound_at
   // entire module and apply the Sequential transform.
   Optional<Bool> from_legacy_te_schedule = func->GetAttr("from_legacy_te_schedule", Bool(false));
   if (from_legacy_te_schedule.value()) {
+    // The legalization sub-passes below rewrite most expressions several
+    // times; recycle the storage of that transient IR from a thread-local
+    // pool for the duration of the pass.
+    runtime::ObjectPoolScope pool_scope;
     auto seq = transform::Sequential(
         {
             BufferShapeLegalize::Pass(),
@@ -191,6 +191,11 @@ class LinearAccessPatternFinder final : public StmtExprVisitor {
   }
 
   void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent || op->attr_key == attr::virtual_thread) {
+      if (const auto* iv = op->node.as<IterVarNode>()) {
+        thread_vars_.insert(iv->var.get());
+      }
+    }
     // Only record the outer most thread extent.
     if (op->attr_key == attr::thread_extent && !in_thread_env_) {
       in_thread_env_ = true;
@@ -205,7 +210,34 @@ class LinearAccessPatternFinder final : public StmtExprVisitor {
     }
   }
 
-  void VisitStmt_(const IfThenElseNode* op) final { VisitNewScope(op); }
+  void VisitStmt_(const IfThenElseNode* op) final {
+    if (!CanSplitArms(op)) {
+      VisitNewScope(op);
+      return;
+    }
+    // Represent each arm by its own scope pair nested in the scope pair of
+    // the if statement. Buffers whose last touch is inside an arm are then
+    // killed at that arm's exit instead of at the exit of the whole if, so
+    // the other arm can reuse their storage: only one arm executes, and a
+    // buffer last touched in one arm is dead after the if on every path.
+    // Buffers that stay live past their arm keep holding their storage,
+    // exactly as in the linear plan.
+    scope_.push_back(StmtEntry());
+    StmtEntry e;
+    e.stmt = op;
+    int64_t begin_index = static_cast<int64_t>(linear_seq_.size());
+    linear_seq_.push_back(e);
+    this->VisitExpr(op->condition);
+    VisitIfArm(op->then_case);
+    VisitIfArm(op->else_case.value());
+    e.touched = std::move(scope_.back().touched);
+    scope_.pop_back();
+    int64_t end_index = static_cast<int64_t>(linear_seq_.size());
+    ICHECK_GT(end_index, begin_index);
+    e.scope_pair_offset = begin_index - end_index;
+    linear_seq_.push_back(e);
+    linear_seq_[begin_index].scope_pair_offset = end_index - begin_index;
+  }
 
   void VisitStmt_(const ForNode* op) final { VisitNewScope(op); }
 
@@ -224,10 +256,55 @@ class LinearAccessPatternFinder final : public StmtExprVisitor {
   std::unordered_set<const BufferNode*> all_buffers_accessed_;
 
  private:
+  // Whether the arms of the if statement can be planned as mutually
+  // exclusive regions. All threads must take the same arm, which we only
+  // trust when the condition is a pure expression of non-thread variables,
+  // and sharing is only profitable when both arms exist.
+  bool CanSplitArms(const IfThenElseNode* op) {
+    if (!op->else_case.defined()) {
+      return false;
+    }
+    if (UsesVar(op->condition,
+                [this](const VarNode* var) { return thread_vars_.count(var) != 0; })) {
+      return false;
+    }
+    bool is_pure = true;
+    PostOrderVisit(op->condition, [&is_pure](const ObjectRef& node) {
+      if (node->IsInstance<BufferLoadNode>() || node->IsInstance<CallNode>()) {
+        is_pure = false;
+      }
+    });
+    return is_pure;
+  }
+
+  // Visit one arm of a region-split if statement as its own scope pair.
+  // The scope pair is keyed by an owned marker statement rather than the arm
+  // itself, since the arm node produces its own entries when visited.
+  void VisitIfArm(const Stmt& arm) {
+    arm_markers_.push_back(Evaluate(0));
+    scope_.push_back(StmtEntry());
+    StmtEntry e;
+    e.stmt = arm_markers_.back().get();
+    int64_t begin_index = static_cast<int64_t>(linear_seq_.size());
+    linear_seq_.push_back(e);
+    this->VisitStmt(arm);
+    e.touched = std::move(scope_.back().touched);
+    scope_.pop_back();
+    int64_t end_index = static_cast<int64_t>(linear_seq_.size());
+    ICHECK_GT(end_index, begin_index);
+    e.scope_pair_offset = begin_index - end_index;
+    linear_seq_.push_back(e);
+    linear_seq_[begin_index].scope_pair_offset = end_index - begin_index;
+  }
+
   // Whether already in thread env.
   bool in_thread_env_{false};
   // The scope stack.
   std::vector<StmtEntry> scope_;
+  // Variables bound to thread indices.
+  std::unordered_set<const VarNode*> thread_vars_;
+  // Marker statements keeping the arm scope keys alive.
+  std::vector<Stmt> arm_markers_;
 };
 
 // Verify if the statement can be run safely via inplace fashion
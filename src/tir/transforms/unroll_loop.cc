@@ -23,6 +23,7 @@
  */
 // Unrolls the loop as in Halide pipeline.
 #include <tvm/arith/analyzer.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
@@ -264,6 +265,10 @@ class LoopUnroller : public StmtExprMutator {
 };
 
 Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
+  // Each unrolled iteration substitutes the loop var through a copy of the
+  // body, so the pass churns through short-lived expression nodes; recycle
+  // their storage from a thread-local pool while the pass runs.
+  runtime::ObjectPoolScope pool_scope;
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
                           cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
   if (!ret.same_as(stmt)) {
@@ -22,6 +22,7 @@
  */
 // Loop vectorizer as in Halide pipeline.
 #include <tvm/arith/analyzer.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
@@ -72,6 +73,39 @@ inline PrimExpr BroadcastTo(PrimExpr e, int lanes, bool is_scalable) {
   return Broadcast(e, CreateNewLanes(is_scalable, lanes));
 }
 
+/*!
+ * \brief Check if the target natively supports masked vector loads and stores.
+ *
+ *  Besides SVE, the AVX-512 opmask registers give every vector load/store a lane
+ *  predicate, and LLVM lowers the masked load/store intrinsics emitted for predicated
+ *  buffer accesses to them directly, so split tails can stay vectorized instead of
+ *  falling back to scalar loops.
+ */
+bool TargetHasMaskedVectorOps(Target target) {
+  if (arith::TargetHasSVE(target)) {
+    return true;
+  }
+  if (!target.defined()) {
+    return false;
+  }
+  auto has_avx512 = [](const String& str) {
+    return std::string(str).find("avx512") != std::string::npos;
+  };
+  if (Optional<String> mcpu = target->GetAttr<String>("mcpu")) {
+    if (has_avx512(mcpu.value())) {
+      return true;
+    }
+  }
+  if (Optional<Array<String>> mattr = target->GetAttr<Array<String>>("mattr")) {
+    for (const String& attr : mattr.value()) {
+      if (has_avx512(attr)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool EnableBufferLevelPredication(Target target) {
   transform::PassContext pass_ctx = transform::PassContext::Current();
   Optional<Bool> enable_buffer_predication =
@@ -80,8 +114,9 @@ bool EnableBufferLevelPredication(Target target) {
     return enable_buffer_predication.value();
   }
 
-  // Use buffer-level predication by default for AArch64 SVE targets
-  return arith::TargetHasSVE(target);
+  // Use buffer-level predication by default on targets with native masked
+  // vector loads and stores: AArch64 SVE and x86 AVX-512.
+  return TargetHasMaskedVectorOps(target);
 }
 
 /*!
@@ -119,21 +154,33 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
    * stmt if successful.
    */
   std::pair<bool, Stmt> Run(Stmt stmt, PrimExpr condition) {
-    // Check that the condition provided is of the form a < b, for now.
-    if (!condition->IsInstance<LTNode>()) {
+    // Check that the condition provided is of the form a < b or a <= b, for now.
+    PrimExpr lhs, rhs;
+    bool is_strict = false;
+    if (const LTNode* lt = condition.as<LTNode>()) {
+      lhs = lt->a;
+      rhs = lt->b;
+      is_strict = true;
+    } else if (const LENode* le = condition.as<LENode>()) {
+      lhs = le->a;
+      rhs = le->b;
+    } else {
       return {false, stmt};
     }
 
-    LT lt = Downcast<LT>(condition);
-
     // Check the form of the vectorized condition, we're expecting
     // Ramp(...) < Broadcast(...)
-    if (!lt->a->IsInstance<RampNode>() || !lt->b->IsInstance<BroadcastNode>()) {
+    if (!lhs->IsInstance<RampNode>() || !rhs->IsInstance<BroadcastNode>()) {
       return {false, stmt};
     }
 
-    base_ = Downcast<Ramp>(lt->a)->base;
-    limit_ = Downcast<Broadcast>(lt->b)->value;
+    base_ = Downcast<Ramp>(lhs)->base;
+    limit_ = Downcast<Broadcast>(rhs)->value;
+    if (!is_strict) {
+      // get_active_lane_mask activates lanes with base + i < limit; an inclusive
+      // bound needs the limit shifted by one.
+      limit_ = limit_ + make_const(limit_.dtype(), 1);
+    }
 
     // Now we can try to predicate
     Stmt predicated_stmt = StmtExprMutator::operator()(std::move(stmt));
@@ -953,6 +1000,9 @@ Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
+      // Vectorization rewrites every expression under each vectorized loop;
+      // recycle the storage of that transient IR for the duration of the pass.
+      runtime::ObjectPoolScope pool_scope;
       n->body = LoopVectorizer(n->attrs)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
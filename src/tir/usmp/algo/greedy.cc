@@ -32,6 +32,13 @@
  * the most liveness conflicted buffer to the given pools. The
  * BufferInfo objects are sorted based on the number of conflicts
  * and placed on each pool adhering to size_hint constraint.
+ *
+ * greedy_by_access : this algorithm prioritizes placing the most
+ * frequently accessed buffers (per byte) to the pools with the
+ * highest memory bandwidth (e.g. VTCM on Hexagon). The BufferInfo
+ * objects are sorted based on the access estimate produced by the
+ * buffer info extraction and each buffer tries its pool candidates
+ * in decreasing bandwidth order, adhering to size_hint constraint.
  */
 
 #include <tvm/arith/analyzer.h>
@@ -205,6 +212,69 @@ class GreedyConflicts : public GreedyBase {
   }
 };
 
+/*!
+ * \brief This class implements Greedy by the access estimate of
+ * BufferInfo greedy algorithm. Please refer to main documentation
+ * of the file for more details.
+ */
+class GreedyAccess : public GreedyBase {
+ public:
+  GreedyAccess() {}
+  Map<BufferInfo, PoolAllocation> PlanMemory(const Array<BufferInfo>& buffer_info_arr) {
+    std::vector<BufferInfo> buffer_info_vec;
+    for (const auto& buffer_info : buffer_info_arr) {
+      // Re-order the pool candidates of each buffer by decreasing memory
+      // bandwidth, so that the hottest buffers get the first claim on the
+      // fastest pools. The sort is stable to preserve the user-specified
+      // order among pools of unknown or equal bandwidth.
+      std::vector<PoolInfo> pool_candidates(buffer_info->pool_candidates.begin(),
+                                            buffer_info->pool_candidates.end());
+      std::stable_sort(pool_candidates.begin(), pool_candidates.end(),
+                       [this](const PoolInfo& a, const PoolInfo& b) {
+                         return PoolBandwidth(a) > PoolBandwidth(b);
+                       });
+      buffer_info->pool_candidates =
+          Array<PoolInfo>(pool_candidates.begin(), pool_candidates.end());
+      buffer_info_vec.push_back(std::move(buffer_info));
+    }
+    std::sort(buffer_info_vec.begin(), buffer_info_vec.end(),
+              [this](const BufferInfo& a, const BufferInfo& b) {
+                double density_a = AccessDensity(a);
+                double density_b = AccessDensity(b);
+                if (density_a == density_b) {
+                  if (a->size_bytes->value == b->size_bytes->value) {
+                    return std::string(a->name_hint->data) > std::string(b->name_hint->data);
+                  } else {
+                    return a->size_bytes->value > b->size_bytes->value;
+                  }
+                }
+                return density_a > density_b;
+              });
+    return PostSortAllocation(buffer_info_vec);
+  }
+
+ private:
+  /*!
+   * \brief Obtains the combined read/write bandwidth of a pool; pools of
+   * unknown bandwidth are ranked last.
+   */
+  int64_t PoolBandwidth(const PoolInfo& pool_info) {
+    int64_t read_bandwidth = pool_info->read_bandwidth_bytes_per_cycle.IntValue();
+    int64_t write_bandwidth = pool_info->write_bandwidth_bytes_per_cycle.IntValue();
+    return std::max<int64_t>(read_bandwidth, 0) + std::max<int64_t>(write_bandwidth, 0);
+  }
+  /*!
+   * \brief Obtains the estimated accesses per byte of a buffer, i.e. how much
+   * the buffer benefits from each byte of fast memory it occupies.
+   */
+  double AccessDensity(const BufferInfo& buf_info) {
+    int64_t access_estimate =
+        buf_info->access_estimate.defined() ? buf_info->access_estimate.IntValue() : 1;
+    return static_cast<double>(access_estimate) /
+           static_cast<double>(std::max<int64_t>(buf_info->size_bytes.IntValue(), 1));
+  }
+};
+
 Map<BufferInfo, PoolAllocation> GreedyBySize(const Array<BufferInfo>& buffer_info_arr,
                                              const Integer& memory_pressure) {
   return GreedySize().PlanMemory(buffer_info_arr);
@@ -215,6 +285,11 @@ Map<BufferInfo, PoolAllocation> GreedyByConflicts(const Array<BufferInfo>& buffe
   return GreedyConflicts().PlanMemory(buffer_info_arr);
 }
 
+Map<BufferInfo, PoolAllocation> GreedyByAccess(const Array<BufferInfo>& buffer_info_arr,
+                                               const Integer& memory_pressure) {
+  return GreedyAccess().PlanMemory(buffer_info_arr);
+}
+
 TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_size")
     .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
       return GreedyBySize(buffer_info_arr, memory_pressure);
@@ -225,6 +300,11 @@ TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_conflicts")
       return GreedyByConflicts(buffer_info_arr, memory_pressure);
     });
 
+TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_access")
+    .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
+      return GreedyByAccess(buffer_info_arr, memory_pressure);
+    });
+
 }  // namespace algo
 }  // namespace usmp
 }  // namespace tir
@@ -130,6 +130,17 @@ class BufferInfoExtractor : public StmtExprVisitor {
    * \brief Indicates a count of stmts visited so far to use as a metric of liveness
    */
   int current_stmt_idx_ = 0;
+  /*!
+   * \brief The product of the constant extents of the serial for loops enclosing
+   * the statement being visited. This is used to weight each access to a buffer
+   * when estimating the access traffic it generates.
+   */
+  int64_t current_loop_weight_ = 1;
+  /*!
+   * \brief Accumulates loop-weighted access counts per allocate node. These are
+   * used to populate BufferInfoNode::access_estimate at the end of the analysis.
+   */
+  std::unordered_map<tir::Stmt, int64_t, ObjectPtrHash, ObjectPtrEqual> access_counts_;
   /*!
    * \brief This structure is supposed to contain information around the scope
    * the visitor is currently in.
@@ -361,8 +372,21 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   }
   Call current_call = scope_stack_.top().call;
   PrimFunc current_primfunc = scope_stack_.top().func;
+  int64_t saved_loop_weight = current_loop_weight_;
+  // Only constant extents contribute to the access weight; loops with unknown
+  // trip counts are treated as a single iteration to keep the estimate
+  // conservative. The weight is capped to avoid overflow in deep loop nests.
+  if (const auto* extent = op->extent.as<IntImmNode>()) {
+    constexpr int64_t kMaxLoopWeight = static_cast<int64_t>(1) << 40;
+    if (extent->value > 0 && current_loop_weight_ <= kMaxLoopWeight / extent->value) {
+      current_loop_weight_ *= extent->value;
+    } else {
+      current_loop_weight_ = kMaxLoopWeight;
+    }
+  }
   scope_stack_.push(si);
   StmtExprVisitor::VisitStmt_(op);
+  current_loop_weight_ = saved_loop_weight;
   // Extending the liveness to beginning of for-loop next and end of the current for-loop
   for (const Allocate& allocate : scope_stack_.top().allocate_nodes) {
     AllocateInfo ai = allocate_infos[allocate->buffer_var];
@@ -412,6 +436,7 @@ void BufferInfoExtractor::VisitExpr_(const VarNode* op) {
       buffer_info_start_stmt_idx_[update_call].Set(allocate, current_stmt_idx_);
     }
     buffer_info_end_stmt_idx_[update_call].Set(allocate, current_stmt_idx_);
+    access_counts_[allocate] += current_loop_weight_;
 
     ScopeInfo& currect_scope_info = scope_stack_.top();
     if (currect_scope_info.for_loop.defined()) {
@@ -610,6 +635,14 @@ BufferInfoAnalysis BufferInfoExtractor::operator()(const PrimFunc& main_func) {
                  [&srch](const auto& c) { return srch.end() == srch.find(c); });
     buf->conflicts.Assign(conflicts.begin(), conflicts.end());
   }
+  // Finally, record the loop-weighted access counts so that bandwidth-aware
+  // algorithms (e.g. greedy_by_access) can place the hottest buffers in the
+  // fastest pools.
+  for (const auto& kv : this->buffer_info_map_) {
+    auto buffer_info = Downcast<BufferInfo>(kv.first);
+    auto ac = access_counts_.find(Downcast<Stmt>(kv.second));
+    buffer_info->access_estimate = ac != access_counts_.end() ? Integer(ac->second) : Integer(1);
+  }
   return BufferInfoAnalysis(this->buffer_info_map_, max_open_set_size);
 }
 
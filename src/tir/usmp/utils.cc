@@ -44,6 +44,7 @@ BufferInfo::BufferInfo(String name_hint, Integer size_bytes, Array<PoolInfo> poo
   bufinfo_node->pool_candidates = pool_candidates;
   bufinfo_node->alignment = alignment;
   bufinfo_node->kind = kind;
+  bufinfo_node->access_estimate = Integer(1);
   data_ = std::move(bufinfo_node);
 }
 
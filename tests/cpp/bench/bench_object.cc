@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Microbenchmarks of object allocation, refcount churn and NDArray creation.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/object.h>
+
+namespace {
+
+using namespace tvm::runtime;
+
+void BM_MakeObject(benchmark::State& state) {
+  std::string payload = "payload";
+  for (auto _ : state) {
+    // One heap object allocation plus the final refcount drop.
+    String s(payload);
+    benchmark::DoNotOptimize(s);
+  }
+}
+BENCHMARK(BM_MakeObject);
+
+// Copying an ObjectRef is one atomic increment plus one decrement; this is the
+// cost every container op and call-frame capture pays per reference.
+void BM_ObjectRefCopy(benchmark::State& state) {
+  String s("payload");
+  for (auto _ : state) {
+    String copy = s;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_ObjectRefCopy);
+
+void BM_ArrayPushBackCoW(benchmark::State& state) {
+  Array<String> base;
+  for (int i = 0; i < 8; ++i) {
+    base.push_back(String("item"));
+  }
+  for (auto _ : state) {
+    // The second reference forces a copy-on-write of the backing store.
+    Array<String> copy = base;
+    copy.push_back(String("tail"));
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_ArrayPushBackCoW);
+
+void BM_NDArrayEmpty(benchmark::State& state) {
+  ShapeTuple shape({state.range(0)});
+  DLDataType dtype{kDLFloat, 32, 1};
+  Device dev{kDLCPU, 0};
+  for (auto _ : state) {
+    NDArray arr = NDArray::Empty(shape, dtype, dev);
+    benchmark::DoNotOptimize(arr);
+  }
+}
+BENCHMARK(BM_NDArrayEmpty)->Arg(64)->Arg(64 * 1024);
+
+// CreateView shares the backing allocation; its cost is header setup and
+// refcounting only, and it sits under every zero-copy reshape at runtime.
+void BM_NDArrayCreateView(benchmark::State& state) {
+  NDArray arr = NDArray::Empty(ShapeTuple({64, 64}), DLDataType{kDLFloat, 32, 1}, Device{kDLCPU, 0});
+  for (auto _ : state) {
+    NDArray view = arr.CreateView(ShapeTuple({4096}), DLDataType{kDLFloat, 32, 1});
+    benchmark::DoNotOptimize(view);
+  }
+}
+BENCHMARK(BM_NDArrayCreateView);
+
+}  // namespace
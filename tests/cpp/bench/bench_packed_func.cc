@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Microbenchmarks of PackedFunc dispatch and FFI boundary crossings.
+ *
+ *  These paths sit under every operator call at inference time; regressions of
+ *  a few nanoseconds here multiply by the number of ops per request.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+namespace {
+
+using namespace tvm::runtime;
+
+TVM_REGISTER_GLOBAL("testing.bench.add_i64").set_body_typed([](int64_t a, int64_t b) {
+  return a + b;
+});
+
+void BM_PackedFuncCall(benchmark::State& state) {
+  PackedFunc add([](TVMArgs args, TVMRetValue* rv) {
+    *rv = args[0].operator int64_t() + args[1].operator int64_t();
+  });
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum += add(1, 2).operator int64_t();
+  }
+  benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_PackedFuncCall);
+
+void BM_TypedPackedFuncCall(benchmark::State& state) {
+  TypedPackedFunc<int64_t(int64_t, int64_t)> add([](int64_t a, int64_t b) { return a + b; });
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum += add(1, 2);
+  }
+  benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_TypedPackedFuncCall);
+
+// Lookup plus call, the pattern of a cold FFI boundary crossing.
+void BM_RegistryLookupAndCall(benchmark::State& state) {
+  int64_t sum = 0;
+  for (auto _ : state) {
+    const PackedFunc* f = Registry::Get("testing.bench.add_i64");
+    sum += (*f)(1, 2).operator int64_t();
+  }
+  benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_RegistryLookupAndCall);
+
+// Call through a cached global, the pattern of a warm FFI boundary crossing.
+void BM_RegistryCachedCall(benchmark::State& state) {
+  static const PackedFunc* f = Registry::Get("testing.bench.add_i64");
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum += (*f)(1, 2).operator int64_t();
+  }
+  benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_RegistryCachedCall);
+
+// Argument packing cost as the signature grows.
+void BM_PackedFuncCallManyArgs(benchmark::State& state) {
+  PackedFunc nop([](TVMArgs args, TVMRetValue* rv) {});
+  std::string s = "payload";
+  for (auto _ : state) {
+    nop(1, 2.0, s.c_str(), 4, 5.0, s.c_str(), 7, 8);
+  }
+}
+BENCHMARK(BM_PackedFuncCallManyArgs);
+
+}  // namespace
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Microbenchmarks of relax VM dispatch.
+ *
+ *  A hand-built executable with trivial packed-call instructions isolates the
+ *  per-instruction interpreter overhead (frame setup, register file, call
+ *  dispatch) from any real kernel work.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/relax/exec_builder.h>
+#include <tvm/runtime/memory/memory_manager.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/relax_vm/vm.h>
+
+namespace {
+
+using namespace tvm;
+using namespace tvm::runtime;
+namespace vm = tvm::runtime::relax_vm;
+
+TVM_REGISTER_GLOBAL("testing.bench.vm_nop").set_body([](TVMArgs args, TVMRetValue* rv) {});
+
+/*! \brief Build a VM whose "main" executes num_calls trivial packed calls. */
+runtime::Module BuildNopVM(int num_calls) {
+  relax::ExecBuilder builder = relax::ExecBuilderNode::Create();
+  builder->EmitFunction("main", /*num_inputs=*/0, Array<String>(),
+                        vm::VMFuncInfo::FuncKind::kVMFunc, /*init_register_size=*/1);
+  for (int i = 0; i < num_calls; ++i) {
+    builder->EmitCall("testing.bench.vm_nop", {}, /*ret=*/0);
+  }
+  builder->EmitRet(vm::Instruction::Arg::Register(0));
+  builder->EndFunction("main");
+
+  ObjectPtr<vm::VirtualMachine> machine = vm::VirtualMachine::Create();
+  machine->LoadExecutable(builder->Get());
+  machine->Init({Device{kDLCPU, 0}}, {memory::AllocatorType::kPooled});
+  return runtime::Module(machine);
+}
+
+void BM_RelaxVMDispatch(benchmark::State& state) {
+  runtime::Module machine = BuildNopVM(static_cast<int>(state.range(0)));
+  PackedFunc main = machine.GetFunction("main");
+  for (auto _ : state) {
+    main();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// One call isolates frame entry/exit; the larger counts amortize it and
+// approach the steady-state per-instruction cost.
+BENCHMARK(BM_RelaxVMDispatch)->Arg(1)->Arg(16)->Arg(256);
+
+}  // namespace
@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Microbenchmarks of ThreadPool fork-join latency.
+ *
+ *  TVMBackendParallelLaunch is the entry every parallelized TIR kernel goes
+ *  through; the benchmark measures the pure dispatch/join cost with a trivial
+ *  body, which bounds how small a parallel loop can usefully be.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_backend_api.h>
+
+#include <atomic>
+
+namespace {
+
+std::atomic<int64_t> counter{0};
+
+int NopTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  counter.fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+void BM_ParallelLaunchForkJoin(benchmark::State& state) {
+  int num_task = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(NopTask, nullptr, num_task);
+  }
+  benchmark::DoNotOptimize(counter.load());
+}
+// num_task == 0 lets the pool use all workers; the fixed sizes expose how
+// latency scales with the fan-out.
+BENCHMARK(BM_ParallelLaunchForkJoin)->Arg(0)->Arg(1)->Arg(2)->Arg(4);
+
+}  // namespace
@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/ir/op.h>
+
+#include <string>
+
+using namespace tvm;
+
+TVM_REGISTER_OP("test.op_attr_map.add")
+    .describe("test op for attr map lookups")
+    .set_num_inputs(2)
+    .set_attr<std::string>("TestAttrMapKey", "AddValue");
+
+TEST(OpAttrToken, MatchesNameLookup) {
+  auto by_name = Op::GetAttrMap<std::string>("TestAttrMapKey");
+  static const OpAttrToken attr_key("TestAttrMapKey");
+  auto by_token = Op::GetAttrMap<std::string>(attr_key);
+
+  Op op = Op::Get("test.op_attr_map.add");
+  ASSERT_EQ(by_name.count(op), 1);
+  ASSERT_EQ(by_token.count(op), 1);
+  ASSERT_EQ(by_name[op], by_token[op]);
+}
+
+TEST(OpAttrToken, StableAcrossResolutions) {
+  OpAttrToken first("TestAttrMapKey");
+  OpAttrToken second("TestAttrMapKey");
+  ASSERT_EQ(first.token(), second.token());
+
+  OpAttrToken other("TestAttrMapKeyOther");
+  ASSERT_NE(first.token(), other.token());
+}
@@ -118,6 +118,45 @@ static FTVMParallelLambda affinity_check_task_id = [](int task_id, TVMParallelGr
   return 0;
 };
 
+struct NestedLaunchData {
+  std::atomic<size_t> acc{0};
+  std::atomic<int> num_outer_task{0};
+};
+
+static FTVMParallelLambda nested_launch_task_id = [](int task_id, TVMParallelGroupEnv* penv,
+                                                     void* cdata) -> int {
+  auto* data = reinterpret_cast<NestedLaunchData*>(cdata);
+  if (task_id == 0) {
+    data->num_outer_task.store(penv->num_task, std::memory_order_relaxed);
+  }
+  // Each outer task runs the full inner job once, whether the nested launch
+  // was fanned out across a team's lanes or serialized on the caller.
+  return TVMBackendParallelLaunch(atomic_add_task_id, &data->acc, 0);
+};
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchNested) {
+  NestedLaunchData data;
+  EXPECT_EQ(TVMBackendParallelLaunch(nested_launch_task_id, &data, 0), 0);
+  EXPECT_EQ(data.acc.load(std::memory_order_relaxed),
+            data.num_outer_task.load(std::memory_order_relaxed) * (N * (N - 1) / 2));
+}
+
+#if defined(__linux__)
+TEST(ThreadingBackend, TVMBackendParallelLaunchNestedTeams) {
+  // Configure the pool of a fresh thread through the environment so the
+  // thread-local pool of the other tests stays untouched.
+  setenv("TVM_THREAD_POOL_NUM_TEAMS", "2", 1);
+  std::thread t([]() {
+    NestedLaunchData data;
+    EXPECT_EQ(TVMBackendParallelLaunch(nested_launch_task_id, &data, 0), 0);
+    EXPECT_EQ(data.acc.load(std::memory_order_relaxed),
+              data.num_outer_task.load(std::memory_order_relaxed) * (N * (N - 1) / 2));
+  });
+  t.join();
+  unsetenv("TVM_THREAD_POOL_NUM_TEAMS");
+}
+#endif
+
 TEST(ThreadingBackend, TVMBackendParallelLaunch) {
   std::atomic<size_t> acc(0);
   TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0);
@@ -186,6 +225,16 @@ TEST(ThreadingBackend, TVMBackendAffinityConfigure) {
   }
 }
 
+TEST(ThreadingBackend, NumaTopology) {
+  int num_nodes = tvm::runtime::threading::NumNumaNodes();
+  EXPECT_GE(num_nodes, 1);
+  int current = tvm::runtime::threading::CurrentNumaNode();
+  EXPECT_GE(current, 0);
+  EXPECT_LT(current, num_nodes);
+  EXPECT_TRUE(tvm::runtime::threading::NumaNodeCpus(-1).empty());
+  EXPECT_TRUE(tvm::runtime::threading::NumaNodeCpus(num_nodes).empty());
+}
+
 TEST(ThreadingBackend, TVMBackendParallelForWithThreadingBackend) {
   int n = 100;
   std::vector<int> vec(/*size=*/n, /*value=*/0);
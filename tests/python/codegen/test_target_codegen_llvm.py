@@ -1195,5 +1195,38 @@ def test_bool_return_value():
     assert not built(15)
 
 
+@tvm.testing.requires_llvm
+def test_llvm_reduction_loop_vectorize():
+    """Scalar reduction loops lower to a vector accumulator plus a scalar tail."""
+
+    @T.prim_func
+    def int_sum(A: T.Buffer((1027,), "int32"), B: T.Buffer((1,), "int32")):
+        B[0] = 0
+        for i in T.serial(1027):
+            B[0] = B[0] + A[i]
+
+    f = tvm.build(int_sum, target="llvm")
+    a_np = np.random.randint(-100, 100, 1027).astype("int32")
+    a = tvm.nd.array(a_np)
+    b = tvm.nd.array(np.zeros((1,), "int32"))
+    f(a, b)
+    assert b.numpy()[0] == a_np.sum()
+
+    @T.prim_func
+    def float_max(A: T.Buffer((1027,), "float32"), B: T.Buffer((1,), "float32")):
+        B[0] = T.float32(-3.4e38)
+        for i in T.serial(1027):
+            B[0] = T.max(B[0], A[i])
+
+    # float reductions are only reassociated with the explicit opt-in
+    with tvm.transform.PassContext(config={"tir.vectorize_reduction_loops": True}):
+        f = tvm.build(float_max, target="llvm")
+    a_np = np.random.uniform(size=1027).astype("float32")
+    a = tvm.nd.array(a_np)
+    b = tvm.nd.array(np.zeros((1,), "float32"))
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy()[0], a_np.max())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
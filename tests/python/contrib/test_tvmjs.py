@@ -17,6 +17,7 @@
 
 """Test contrib.tvmjs"""
 
+import json
 import tempfile
 
 import numpy as np
@@ -60,5 +61,24 @@ def test_save_load_float8(dtype):
     np.testing.assert_array_equal(arr, after_roundtrip)
 
 
+def test_save_load_zstd_compressed():
+    pytest.importorskip("zstandard")
+
+    params = {f"arr_{i}": np.arange(1024, dtype="float16") + i for i in range(16)}
+
+    with tempfile.TemporaryDirectory(prefix="tvm_") as temp_dir:
+        tvmjs.dump_ndarray_cache(params, temp_dir, encode_format="raw", compression="zstd")
+        with open(f"{temp_dir}/ndarray-cache.json", "r") as infile:
+            cache_json = json.load(infile)
+        for shard_rec in cache_json["records"]:
+            assert shard_rec["format"] == "zstd-shard"
+            for rec in shard_rec["records"]:
+                assert rec["encodedNbytes"] > 0
+        cache, _ = tvmjs.load_ndarray_cache(temp_dir, tvm.cpu())
+
+    for name, arr in params.items():
+        np.testing.assert_array_equal(arr, cache[name].numpy())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
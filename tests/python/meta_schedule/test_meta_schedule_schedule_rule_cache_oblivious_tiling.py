@@ -0,0 +1,153 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+from tvm import meta_schedule as ms
+from tvm.meta_schedule.testing import te_workload
+from tvm.meta_schedule.testing.space_generation import (
+    check_sketches,
+    generate_design_space,
+)
+from tvm.script import tir as T
+from tvm.target import Target
+from tvm.te import create_prim_func
+
+
+def _design_space(mod, depth=2, min_inner_extent=8):
+    return generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm --num-cores=4"),
+        types=None,
+        sch_rules=[ms.schedule_rule.CacheObliviousTiling(depth, min_inner_extent)],
+    )
+
+
+def test_cpu_matmul():
+    @T.prim_func
+    def cpu_matmul_0(
+        A: T.Buffer((32, 32), "float32"),
+        B: T.Buffer((32, 32), "float32"),
+        C: T.Buffer((32, 32), "float32"),
+    ) -> None:
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        # Level-major halving: the outer chunks of every axis, then the level-1
+        # halves, then the level-2 halves.
+        for i0_0, i1_0, i2_0, i0_1, i1_1, i2_1, i0_2, i1_2, i2_2 in T.grid(
+            8, 8, 8, 2, 2, 2, 2, 2, 2
+        ):
+            with T.block("C"):
+                i = T.axis.spatial(32, i0_0 * 4 + i0_1 * 2 + i0_2)
+                j = T.axis.spatial(32, i1_0 * 4 + i1_1 * 2 + i1_2)
+                k = T.axis.reduce(32, i2_0 * 4 + i2_1 * 2 + i2_2)
+                T.reads(A[i, k], B[k, j])
+                T.writes(C[i, j])
+                with T.init():
+                    C[i, j] = T.float32(0)
+                C[i, j] = C[i, j] + A[i, k] * B[k, j]
+
+    @T.prim_func
+    def cpu_matmul_1(
+        A: T.Buffer((32, 32), "float32"),
+        B: T.Buffer((32, 32), "float32"),
+        C: T.Buffer((32, 32), "float32"),
+    ) -> None:
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i0, i1, i2 in T.grid(32, 32, 32):
+            with T.block("C"):
+                i, j, k = T.axis.remap("SSR", [i0, i1, i2])
+                T.reads(A[i, k], B[k, j])
+                T.writes(C[i, j])
+                with T.init():
+                    C[i, j] = T.float32(0)
+                C[i, j] = C[i, j] + A[i, k] * B[k, j]
+
+    mod = create_prim_func(te_workload.matmul(n=32, m=32, k=32))
+    actual = _design_space(mod)
+    # The rule samples nothing, so both sketches carry empty decisions.
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[cpu_matmul_0, cpu_matmul_1],
+        expected_decisions=[[], []],
+    )
+
+
+def test_cpu_matmul_uneven_depth():
+    # With min_inner_extent=8, a 16-extent axis can only be halved once while
+    # the 64-extent axes are halved twice.
+    @T.prim_func
+    def cpu_matmul_0(
+        A: T.Buffer((64, 16), "float32"),
+        B: T.Buffer((16, 64), "float32"),
+        C: T.Buffer((64, 64), "float32"),
+    ) -> None:
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i0_0, i1_0, i2_0, i0_1, i1_1, i2_1, i0_2, i1_2 in T.grid(16, 16, 8, 2, 2, 2, 2, 2):
+            with T.block("C"):
+                i = T.axis.spatial(64, i0_0 * 4 + i0_1 * 2 + i0_2)
+                j = T.axis.spatial(64, i1_0 * 4 + i1_1 * 2 + i1_2)
+                k = T.axis.reduce(16, i2_0 * 2 + i2_1)
+                T.reads(A[i, k], B[k, j])
+                T.writes(C[i, j])
+                with T.init():
+                    C[i, j] = T.float32(0)
+                C[i, j] = C[i, j] + A[i, k] * B[k, j]
+
+    @T.prim_func
+    def cpu_matmul_1(
+        A: T.Buffer((64, 16), "float32"),
+        B: T.Buffer((16, 64), "float32"),
+        C: T.Buffer((64, 64), "float32"),
+    ) -> None:
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i0, i1, i2 in T.grid(64, 64, 16):
+            with T.block("C"):
+                i, j, k = T.axis.remap("SSR", [i0, i1, i2])
+                T.reads(A[i, k], B[k, j])
+                T.writes(C[i, j])
+                with T.init():
+                    C[i, j] = T.float32(0)
+                C[i, j] = C[i, j] + A[i, k] * B[k, j]
+
+    mod = create_prim_func(te_workload.matmul(n=64, m=64, k=16))
+    actual = _design_space(mod)
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[cpu_matmul_0, cpu_matmul_1],
+        expected_decisions=[[], []],
+    )
+
+
+def test_cpu_too_small_to_halve():
+    # Every axis already fits within min_inner_extent, so the rule leaves the
+    # block alone and produces a single unchanged sketch.
+    mod = create_prim_func(te_workload.matmul(n=8, m=8, k=8))
+    actual = _design_space(mod, depth=2, min_inner_extent=8)
+    assert len(actual) == 1
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[mod["main"]],
+        expected_decisions=[[]],
+    )
+
+
+if __name__ == "__main__":
+    test_cpu_matmul()
+    test_cpu_matmul_uneven_depth()
+    test_cpu_too_small_to_halve()
@@ -0,0 +1,149 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I, relax as R, tir as T
+
+
+def _called_prim_funcs(func: relax.Function):
+    call_tir_op = tvm.ir.Op.get("relax.call_tir")
+    called = set()
+
+    def fvisit(expr):
+        if isinstance(expr, relax.Call) and expr.op == call_tir_op:
+            called.add(expr.args[0].name_hint)
+
+    relax.analysis.post_order_visit(func, fvisit)
+    return called
+
+
+@I.ir_module
+class Module:
+    @T.prim_func
+    def copy(
+        A: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+        B: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+    ):
+        for i, j in T.grid(T.int64(4), T.int64(4)):
+            with T.block("copy"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vi, vj]
+
+    @T.prim_func
+    def add_one(
+        A: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+        B: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+    ):
+        for i, j in T.grid(T.int64(4), T.int64(4)):
+            with T.block("add_one"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vi, vj] + T.float32(1)
+
+    @R.function
+    def main(x: R.Tensor((4, 4), "float32")) -> R.Tensor((4, 4), "float32"):
+        cls = Module
+        with R.dataflow():
+            y = R.call_tir(cls.copy, (x,), out_sinfo=R.Tensor((4, 4), "float32"))
+            z = R.call_tir(cls.add_one, (y,), out_sinfo=R.Tensor((4, 4), "float32"))
+            R.output(z)
+        return z
+
+
+def test_copy_becomes_alias():
+    after = relax.transform.EliminateRedundantCopies()(Module)
+    after = relax.transform.DeadCodeElimination()(after)
+    assert _called_prim_funcs(after["main"]) == {"add_one"}
+
+
+def test_copy_with_mutated_source_is_preserved():
+    @I.ir_module
+    class ModuleWithExternCall:
+        @T.prim_func
+        def copy(
+            A: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+            B: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+        ):
+            for i, j in T.grid(T.int64(4), T.int64(4)):
+                with T.block("copy"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vi, vj]
+
+        @R.function
+        def main(x: R.Tensor((4, 4), "float32")) -> R.Tensor((4, 4), "float32"):
+            cls = ModuleWithExternCall
+            with R.dataflow():
+                y = R.call_tir(cls.copy, (x,), out_sinfo=R.Tensor((4, 4), "float32"))
+                # The extern call may write `x` in place, so the copy must stay.
+                z = R.call_dps_packed(
+                    "my_extern_mutating_op", (x,), out_sinfo=R.Tensor((4, 4), "float32")
+                )
+                w = R.add(y, z)
+                R.output(w)
+            return w
+
+    after = relax.transform.EliminateRedundantCopies()(ModuleWithExternCall)
+    assert "copy" in _called_prim_funcs(after["main"])
+
+
+def test_reshape_is_not_treated_as_copy():
+    @I.ir_module
+    class ModuleWithReshape:
+        @T.prim_func
+        def reshape(
+            A: T.Buffer((T.int64(4), T.int64(4)), "float32"),
+            B: T.Buffer((T.int64(16),), "float32"),
+        ):
+            for i in range(T.int64(16)):
+                with T.block("reshape"):
+                    vi = T.axis.remap("S", [i])
+                    B[vi] = A[vi // T.int64(4), vi % T.int64(4)]
+
+        @R.function
+        def main(x: R.Tensor((4, 4), "float32")) -> R.Tensor((16,), "float32"):
+            cls = ModuleWithReshape
+            with R.dataflow():
+                y = R.call_tir(cls.reshape, (x,), out_sinfo=R.Tensor((16,), "float32"))
+                R.output(y)
+            return y
+
+    after = relax.transform.EliminateRedundantCopies()(ModuleWithReshape)
+    assert "reshape" in _called_prim_funcs(after["main"])
+
+
+def test_execution_unchanged():
+    import numpy as np
+
+    target = tvm.target.Target("llvm")
+    x_np = np.random.rand(4, 4).astype("float32")
+
+    before_ex = relax.build(Module, target)
+    before_vm = relax.VirtualMachine(before_ex, tvm.cpu())
+    expected = before_vm["main"](tvm.nd.array(x_np)).numpy()
+
+    after = relax.transform.EliminateRedundantCopies()(Module)
+    after = relax.transform.DeadCodeElimination()(after)
+    after_ex = relax.build(after, target)
+    after_vm = relax.VirtualMachine(after_ex, tvm.cpu())
+    actual = after_vm["main"](tvm.nd.array(x_np)).numpy()
+
+    tvm.testing.assert_allclose(actual, expected)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1416,6 +1416,76 @@ def test_skipping_match_cast():
     _check(Module, Module)
 
 
+def test_fuse_through_redundant_match_cast():
+    """A match_cast that merely re-asserts an already-known symbolic shape should not
+    break the elementwise fusion group around it. The cast is elided inside the fused
+    function, which must stay free of match_cast for FuseTIR."""
+
+    n = tvm.tir.Var("n", "int64")
+
+    def before():
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", R.Tensor([n, 4096], "float32"))
+        with bb.function("main", [x]):
+            with bb.dataflow():
+                lv0 = bb.emit_te(topi.add, x, relax.const(1, "float32"))
+                lv1 = bb.match_cast(lv0, R.Tensor([n, 4096], "float32"))
+                gv = bb.emit_output(bb.call_te(topi.exp, lv1))
+            bb.emit_func_output(gv)
+
+        return bb.get()
+
+    def expected():
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", R.Tensor([n, 4096], "float32"))
+        p0 = relax.Var("p0", R.Tensor((), "float32"))
+
+        with bb.function("fused_add_exp", [x, p0], attrs={"Primitive": 1}, private=True):
+            with bb.dataflow():
+                lv0 = bb.emit_te(topi.add, x, p0)
+                gv = bb.emit_output(bb.call_te(topi.exp, lv0))
+            bb.emit_func_output(gv)
+        fused_add_exp = bb.get().get_global_var("fused_add_exp")
+
+        x = relax.Var("x", R.Tensor([n, 4096], "float32"))
+        with bb.function("main", [x]):
+            with bb.dataflow():
+                gv = bb.emit_output(relax.Call(fused_add_exp, [x, relax.const(1, "float32")]))
+            bb.emit_func_output(gv)
+
+        return bb.get()
+
+    _check(before(), expected())
+
+
+def test_fuse_through_redundant_match_cast_then_fuse_tir():
+    """The default pipeline runs FuseTIR right after FuseOps, and FuseTIR rejects
+    match_cast inside primitive functions, so the fused symbolic-shape group must
+    lower end to end."""
+
+    n = tvm.tir.Var("n", "int64")
+
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", R.Tensor([n, 4096], "float32"))
+    with bb.function("main", [x]):
+        with bb.dataflow():
+            lv0 = bb.emit_te(topi.add, x, relax.const(1, "float32"))
+            lv1 = bb.match_cast(lv0, R.Tensor([n, 4096], "float32"))
+            gv = bb.emit_output(bb.call_te(topi.exp, lv1))
+        bb.emit_func_output(gv)
+
+    mod = relax.transform.AnnotateTIROpPattern()(bb.get())
+    mod = relax.transform.FuseOps()(mod)
+    mod = relax.transform.FuseTIR()(mod)
+
+    assert relax.analysis.well_formed(mod)
+    # The two elementwise kernels end up in a single fused TIR function.
+    fused_names = [
+        gv.name_hint for gv, func in mod.functions.items() if isinstance(func, tvm.tir.PrimFunc)
+    ]
+    assert "fused_add_exp" in fused_names
+
+
 def test_skipping_primvalue():
     @I.ir_module
     class Module:
@@ -1094,6 +1094,37 @@ def test_tir_copy():
     assert relax.analysis.well_formed(After)
 
 
+def test_share_adjoints():
+    @I.ir_module
+    class Before:
+        @R.function
+        def main(x: R.Tensor((3, 3), "float32"), y: R.Tensor((3, 3), "float32")):
+            with R.dataflow():
+                lv0 = R.multiply(x, y)
+                lv1 = R.multiply(x, y)
+                lv2 = R.add(lv0, lv1)
+                gv = R.sum(lv2)
+                R.output(gv)
+            return gv
+
+    def backward_binding_hashes(mod):
+        # the bindings after the copied forward bindings form the backward section
+        forward_len = len(Before["main"].body.blocks[0].bindings)
+        bindings = mod["main_adjoint"].body.blocks[0].bindings[forward_len:]
+        return [tvm.ir.structural_hash(binding.value) for binding in bindings]
+
+    # Without sharing, the structurally identical partial adjoints of lv0 and lv1 are
+    # emitted as duplicate bindings
+    hashes = backward_binding_hashes(relax.transform.Gradient("main")(Before))
+    assert len(hashes) > len(set(hashes))
+
+    # With sharing, every backward binding is structurally unique
+    After = relax.transform.Gradient("main", share_adjoints=True)(Before)
+    assert relax.analysis.well_formed(After)
+    hashes = backward_binding_hashes(After)
+    assert len(hashes) == len(set(hashes))
+
+
 def test_report_error():
     @I.ir_module
     class TargetNotTensor:
@@ -0,0 +1,82 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.script
+import tvm.testing
+from tvm import relax
+from tvm.script import relax as R
+
+
+@tvm.script.ir_module
+class Before:
+    @R.function
+    def main(x: R.Tensor(("n", 8), "float32")) -> R.Tensor(("n", 8), "float32"):
+        y = R.add(x, x)
+        return y
+
+
+def test_specialize_generates_clones_and_dispatcher():
+    After = relax.transform.SpecializeSymbolicVarDispatch("main", [{"n": 1}])(Before)
+
+    assert relax.analysis.well_formed(After)
+
+    func_names = {gvar.name_hint for gvar in After.functions}
+    assert func_names == {"main", "main_generic", "main_spec0"}
+
+    # The specialized clone has the symbolic var bound to a static shape.
+    spec = After["main_spec0"]
+    shape = relax.get_shape_of(spec.params[0])
+    assert [int(dim) for dim in shape] == [1, 8]
+
+    # The fallback keeps the dynamic shape.
+    generic = After["main_generic"]
+    shape = relax.get_shape_of(generic.params[0])
+    assert shape[0].dtype == "int64" and not isinstance(shape[0], tvm.tir.IntImm)
+
+    # The dispatcher branches on the specialization predicate.
+    assert isinstance(After["main"].body.body, relax.If)
+
+    # Only the dispatcher keeps an external symbol.
+    assert "global_symbol" in After["main"].attrs
+    assert "global_symbol" not in (spec.attrs or {})
+    assert "global_symbol" not in (generic.attrs or {})
+
+
+def test_specialize_requires_known_symbolic_var():
+    with pytest.raises(tvm.TVMError):
+        relax.transform.SpecializeSymbolicVarDispatch("main", [{"batch": 1}])(Before)
+
+
+def test_dispatch_execution():
+    mod = relax.transform.SpecializeSymbolicVarDispatch("main", [{"n": 1}, {"n": 4}])(Before)
+
+    ex = relax.build(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+
+    # n == 1 and n == 4 take the specialized clones, n == 7 the generic fallback.
+    for n in [1, 4, 7]:
+        x = np.random.rand(n, 8).astype("float32")
+        res = vm["main"](tvm.nd.array(x))
+        tvm.testing.assert_allclose(res.numpy(), x + x)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1335,6 +1335,81 @@ def test_function_independence():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+def test_device_budget_spills_cold_storage():
+    # fmt: off
+    @tvm.script.ir_module
+    class Module:
+        @T.prim_func
+        def big(rxplaceholder: T.Buffer(T.int64(8), "float32"), compute: T.Buffer(T.int64(1024), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def relu(rxplaceholder: T.Buffer(T.int64(8), "float32"), compute: T.Buffer(T.int64(8), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def combine(rxplaceholder: T.Buffer(T.int64(1024), "float32"), rxplaceholder_1: T.Buffer(T.int64(8), "float32"), T_add: T.Buffer(T.int64(10), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((8,), dtype="float32")) -> R.Tensor((10,), dtype="float32"):
+            R.func_attr({"relax.force_pure": True, "relax.memory_plan_device_budget": 512})
+            cls = Module
+            alloc: R.Tensor((1024,), dtype="float32") = R.builtin.alloc_tensor(R.shape([1024]), dtype="float32", runtime_device_index=0)
+            _: R.Tuple() = cls.big(x, alloc)
+            alloc1: R.Tensor((8,), dtype="float32") = R.builtin.alloc_tensor(R.shape([8]), dtype="float32", runtime_device_index=0)
+            _1: R.Tuple() = cls.relu(x, alloc1)
+            alloc2: R.Tensor((8,), dtype="float32") = R.builtin.alloc_tensor(R.shape([8]), dtype="float32", runtime_device_index=0)
+            _2: R.Tuple() = cls.relu(alloc1, alloc2)
+            alloc3: R.Tensor((8,), dtype="float32") = R.builtin.alloc_tensor(R.shape([8]), dtype="float32", runtime_device_index=0)
+            _3: R.Tuple() = cls.relu(alloc2, alloc3)
+            alloc4: R.Tensor((10,), dtype="float32") = R.builtin.alloc_tensor(R.shape([10]), dtype="float32", runtime_device_index=0)
+            _4: R.Tuple() = cls.combine(alloc, alloc3, alloc4)
+            gv: R.Tensor((10,), dtype="float32") = alloc4
+            return gv
+
+    @tvm.script.ir_module
+    class Expected:
+        @T.prim_func
+        def big(rxplaceholder: T.Buffer(T.int64(8), "float32"), compute: T.Buffer(T.int64(1024), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def relu(rxplaceholder: T.Buffer(T.int64(8), "float32"), compute: T.Buffer(T.int64(8), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def combine(rxplaceholder: T.Buffer(T.int64(1024), "float32"), rxplaceholder_1: T.Buffer(T.int64(8), "float32"), T_add: T.Buffer(T.int64(10), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((8,), dtype="float32")) -> R.Tensor((10,), dtype="float32"):
+            R.func_attr({"relax.force_pure": True, "relax.memory_plan_device_budget": 512})
+            cls = Expected
+            # The big intermediate stays alive across the whole function with
+            # only three referencing bindings, so it is the coldest storage and
+            # spills to pinned host memory under the 512-byte budget.
+            storage: R.Object = R.memory.alloc_storage(R.shape([4096]), virtual_device_index=0, storage_scope="global.pinned_host", dtype="float32")
+            alloc: R.Tensor((1024,), dtype="float32") = R.memory.alloc_tensor(storage, 0, R.shape([1024]), dtype="float32")
+            _: R.Tuple() = cls.big(x, alloc)
+            storage1: R.Object = R.memory.alloc_storage(R.shape([32]), virtual_device_index=0, storage_scope="global", dtype="float32")
+            alloc1: R.Tensor((8,), dtype="float32") = R.memory.alloc_tensor(storage1, 0, R.shape([8]), dtype="float32")
+            _1: R.Tuple() = cls.relu(x, alloc1)
+            storage2: R.Object = R.memory.alloc_storage(R.shape([32]), virtual_device_index=0, storage_scope="global", dtype="float32")
+            alloc2: R.Tensor((8,), dtype="float32") = R.memory.alloc_tensor(storage2, 0, R.shape([8]), dtype="float32")
+            _2: R.Tuple() = cls.relu(alloc1, alloc2)
+            alloc3: R.Tensor((8,), dtype="float32") = R.memory.alloc_tensor(storage1, 0, R.shape([8]), dtype="float32")
+            _3: R.Tuple() = cls.relu(alloc2, alloc3)
+            alloc4: R.Tensor((10,), dtype="float32") = R.builtin.alloc_tensor(R.shape([10]), dtype="float32", runtime_device_index=0)
+            _4: R.Tuple() = cls.combine(alloc, alloc3, alloc4)
+            gv: R.Tensor((10,), dtype="float32") = alloc4
+            return gv
+    # fmt: on
+
+    mod = relax.transform.StaticPlanBlockMemory()(Module)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
 def test_invalid_tir_var_upper_bound():
     @tvm.script.ir_module
     class Module:
@@ -1064,5 +1064,122 @@ def test_call_tir_with_float16_args():
     tvm.ir.assert_structural_equal(Expected, After)
 
 
+def test_calibration_promotes_safe_kNever_op():
+    # softmax is statically kNever, but the calibrated output range fits fp16
+    # with headroom, so it is relaxed to follow the fp16 conv output.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((3, 3, 3, 3), "float32")
+        ) -> R.Tensor(None, "float32", ndim=4):
+            with R.dataflow():
+                gv: R.Tensor((2, 3, 28, 28), "float32") = R.nn.conv2d(x, w, padding=(1, 1))
+                gv1: R.Tensor((2, 3, 28, 28), "float32") = R.nn.softmax(gv, axis=1)
+                gv2: R.Tensor((2, 3, 28, 28), "float32") = R.add(gv1, x)
+                R.output(gv2)
+            return gv2
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), dtype="float32"), w: R.Tensor((3, 3, 3, 3), dtype="float32")
+        ) -> R.Tensor((2, 3, 28, 28), dtype="float32"):
+            with R.dataflow():
+                lv: R.Tensor((3, 3, 3, 3), dtype="float16") = R.astype(w, dtype="float16")
+                lv1: R.Tensor((2, 3, 28, 28), dtype="float16") = R.astype(x, dtype="float16")
+                lv2: R.Tensor((2, 3, 28, 28), dtype="float32") = R.nn.conv2d(
+                    lv1,
+                    lv,
+                    strides=[1, 1],
+                    padding=[1, 1, 1, 1],
+                    dilation=[1, 1],
+                    groups=1,
+                    data_layout="NCHW",
+                    kernel_layout="OIHW",
+                    out_layout="NCHW",
+                    out_dtype="float32",
+                )
+                gv: R.Tensor((2, 3, 28, 28), dtype="float16") = R.astype(lv2, dtype="float16")
+                gv1: R.Tensor((2, 3, 28, 28), dtype="float16") = R.nn.softmax(gv, axis=1)
+                lv3: R.Tensor((2, 3, 28, 28), dtype="float32") = R.astype(gv1, dtype="float32")
+                gv2: R.Tensor((2, 3, 28, 28), dtype="float32") = R.add(lv3, x)
+                R.output(gv2)
+            return gv2
+
+    mod = ToMixedPrecision(calibrated_absmax={"relax.nn.softmax": 1.0})(Input)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_calibration_promotion_gated_by_cost_table():
+    # The calibrated range of softmax fits fp16, but the device cost table
+    # reports no fp16 speedup for it, so the static kNever policy is kept.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((3, 3, 3, 3), "float32")
+        ) -> R.Tensor(None, "float32", ndim=4):
+            with R.dataflow():
+                gv: R.Tensor((2, 3, 28, 28), "float32") = R.nn.conv2d(x, w, padding=(1, 1))
+                gv1: R.Tensor((2, 3, 28, 28), "float32") = R.nn.softmax(gv, axis=1)
+                gv2: R.Tensor((2, 3, 28, 28), "float32") = R.add(gv1, x)
+                R.output(gv2)
+            return gv2
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), dtype="float32"), w: R.Tensor((3, 3, 3, 3), dtype="float32")
+        ) -> R.Tensor((2, 3, 28, 28), dtype="float32"):
+            with R.dataflow():
+                lv: R.Tensor((3, 3, 3, 3), dtype="float16") = R.astype(w, dtype="float16")
+                lv1: R.Tensor((2, 3, 28, 28), dtype="float16") = R.astype(x, dtype="float16")
+                lv2: R.Tensor((2, 3, 28, 28), dtype="float32") = R.nn.conv2d(
+                    lv1,
+                    lv,
+                    strides=[1, 1],
+                    padding=[1, 1, 1, 1],
+                    dilation=[1, 1],
+                    groups=1,
+                    data_layout="NCHW",
+                    kernel_layout="OIHW",
+                    out_layout="NCHW",
+                    out_dtype="float32",
+                )
+                gv: R.Tensor((2, 3, 28, 28), dtype="float16") = R.astype(lv2, dtype="float16")
+                lv3: R.Tensor((2, 3, 28, 28), dtype="float32") = R.astype(gv, dtype="float32")
+                gv1: R.Tensor((2, 3, 28, 28), dtype="float32") = R.nn.softmax(lv3, axis=1)
+                gv2: R.Tensor((2, 3, 28, 28), dtype="float32") = R.add(gv1, x)
+                R.output(gv2)
+            return gv2
+
+    mod = ToMixedPrecision(
+        calibrated_absmax={"relax.nn.softmax": 1.0},
+        op_fp16_speedup={"relax.nn.softmax": 0.9},
+    )(Input)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_calibration_demotes_overflowing_kAlways_op():
+    # The calibrated conv2d output exceeds the fp16 range, so the static
+    # kAlways policy is overridden and the module is left in fp32.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((4, 3, 3, 3), "float32")
+        ) -> R.Tensor(None, "float32", ndim=4):
+            with R.dataflow():
+                gv: R.Tensor((2, 4, 26, 26), "float32") = R.nn.conv2d(x, w, out_dtype="float32")
+                R.output(gv)
+            return gv
+
+    mod = ToMixedPrecision(calibrated_absmax={"relax.nn.conv2d": 1.0e9})(Input)
+    tvm.ir.assert_structural_equal(mod, Input)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
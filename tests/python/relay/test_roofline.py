@@ -104,8 +104,9 @@ def test_estimate_peak_bandwidth_gpu():
 
 @tvm.testing.requires_x86
 @tvm.testing.skip_if_32bit(reason="Cannot allocate enough memory on i386")
+@pytest.mark.parametrize("executor", ["vm", "graph"])
 @tvm.testing.parametrize_targets("llvm -mattr=+fma,+avx2", "cuda")
-def test_roofline_analysis(target, dev):
+def test_roofline_analysis(target, dev, executor):
     a = relay.var("a", relay.TensorType((512, 512), "float32"))
     b = relay.var("b", relay.TensorType((512, 512), "float32"))
     c = relay.nn.dense(a, b)
@@ -116,7 +117,7 @@ def test_roofline_analysis(target, dev):
     remote = rpc.connect("127.0.0.1", server.port, key="roofline")
     dev = remote.device(target)
 
-    report = tvm.utils.roofline_analysis(mod, params, target, dev, remote=remote)
+    report = tvm.utils.roofline_analysis(mod, params, target, dev, remote=remote, executor=executor)
     print(report)
 
     assert "Bound" in report.table()
@@ -133,5 +134,36 @@ def test_roofline_analysis(target, dev):
                 assert 90 >= call["Percent of Theoretical Optimal"].ratio >= 0.01
 
 
+@tvm.testing.requires_x86
+@tvm.testing.skip_if_32bit(reason="Cannot allocate enough memory on i386")
+@tvm.testing.requires_llvm
+def test_optimization_priority_report():
+    target = "llvm -mattr=+fma,+avx2"
+    a = relay.var("a", relay.TensorType((512, 512), "float32"))
+    b = relay.var("b", relay.TensorType((512, 512), "float32"))
+    c = relay.nn.dense(a, b)
+    mod = tvm.IRModule.from_expr(relay.Function([a, b], c))
+
+    server = rpc.Server(key="roofline_priority")
+    remote = rpc.connect("127.0.0.1", server.port, key="roofline_priority")
+    dev = remote.device(target)
+
+    report = tvm.utils.roofline_analysis(mod, {}, target, dev, remote=remote)
+    # No operator can exceed 100% of theoretical optimal, so everything with
+    # roofline metrics must be flagged.
+    prioritized = tvm.utils.optimization_priority_report(report, efficiency_threshold=100.0)
+
+    recoverable = [
+        call["Estimated Recoverable Time (us)"].microseconds
+        for call in prioritized.calls
+        if "Estimated Recoverable Time (us)" in call
+    ]
+    assert len(recoverable) > 0
+    assert recoverable == sorted(recoverable, reverse=True)
+    for call in prioritized.calls:
+        if "Below Threshold" in call:
+            assert call["Below Threshold"] == "yes"
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,90 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test hot-swapping one kernel of a loaded library via Module.patch_function."""
+import os
+import subprocess
+import sys
+
+import tvm
+import tvm.testing
+from tvm import te
+from tvm.contrib import utils
+
+# Patching is latched from the environment on first use, so the checks run in a
+# child process that enables it before touching the runtime.
+patch_py = """
+import sys
+
+import numpy as np
+import tvm
+
+base_path, patch_path = sys.argv[1], sys.argv[2]
+mod = tvm.runtime.load_module(base_path)
+fadd = mod["myadd"]
+
+a = tvm.nd.array(np.random.uniform(size=8).astype("float32"))
+b = tvm.nd.array(np.zeros(8, dtype="float32"))
+fadd(a, b)
+np.testing.assert_allclose(b.numpy(), a.numpy() + 1)
+
+# the already-cached handle must pick up the patched implementation
+mod.patch_function("myadd", patch_path)
+fadd(a, b)
+np.testing.assert_allclose(b.numpy(), a.numpy() + 2)
+
+# patching an unknown function fails loudly
+try:
+    mod.patch_function("nosuchfunc", patch_path)
+    raise AssertionError("patching an unknown function should raise")
+except tvm.error.TVMError:
+    pass
+print("Finish patch checking...")
+"""
+
+
+@tvm.testing.requires_llvm
+def test_patch_function():
+    temp = utils.tempdir()
+
+    def build_add(constant, path):
+        n = 8
+        A = te.placeholder((n,), name="A", dtype="float32")
+        B = te.compute((n,), lambda i: A[i] + tvm.tir.const(constant, "float32"), name="B")
+        s = te.create_schedule(B.op)
+        m = tvm.build(s, [A, B], "llvm", name="myadd")
+        m.export_library(path)
+
+    base_path = temp.relpath("base.so")
+    patch_path = temp.relpath("patch.so")
+    build_add(1, base_path)
+    build_add(2, patch_path)
+
+    path_patch_py = temp.relpath("patch_check.py")
+    with open(path_patch_py, "w") as fo:
+        fo.write(patch_py)
+    env = dict(os.environ, TVM_RUNTIME_PATCHABLE_KERNELS="1")
+    proc = subprocess.run(
+        [sys.executable, path_patch_py, base_path, patch_path],
+        env=env,
+        capture_output=True,
+        text=True,
+    )
+    assert proc.returncode == 0, f"Patch check failed:\n{proc.stdout}\n{proc.stderr}"
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
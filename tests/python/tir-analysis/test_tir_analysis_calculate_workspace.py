@@ -122,5 +122,24 @@ def test_vector_type():
     assert tvm.tir.analysis.calculate_workspace_bytes(primfunc, 1) == 64
 
 
+def test_lowered_workspace_allocates():
+    """After LowerTVMBuiltin the allocates become nested TVMBackendAllocWorkspace
+    lets; the analysis reports their high-water mark."""
+    alloc_op = tvm.ir.Op.get("tir.TVMBackendAllocWorkspace")
+
+    def make_let(name, nbytes, body):
+        var = tir.Var(name, "handle")
+        value = tir.Call("handle", alloc_op, [1, 0, tir.IntImm("uint64", nbytes), 2, 32])
+        return tir.LetStmt(var, value, body)
+
+    # ws_b is live inside ws_a's scope, while ws_c is only live after both
+    # have been freed, so the high-water mark is ws_a + ws_b.
+    body = make_let("ws_a", 1024, make_let("ws_b", 512, tir.Evaluate(0)))
+    body = tvm.tir.stmt_seq(body, make_let("ws_c", 256, tir.Evaluate(0)))
+    primfunc = tir.PrimFunc([], body)
+    assert tvm.tir.analysis.calculate_workspace_bytes(primfunc, 1) == 1536
+    assert tvm.tir.analysis.calculate_workspace_bytes(primfunc, 1024) == 2048
+
+
 if __name__ == "__main__":
     tvm.testing.main()
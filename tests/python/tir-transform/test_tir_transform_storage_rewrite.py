@@ -443,6 +443,71 @@ def test_while_alloc():
     assert isinstance(body.body.body, tvm.tir.Allocate)  # A
 
 
+def count_allocs(body):
+    num_alloc = [0]
+
+    def verify(n):
+        if isinstance(n, tvm.tir.Allocate):
+            num_alloc[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(body, verify)
+    return num_alloc[0]
+
+
+def test_alloc_if_else_arms_share():
+    # Only one arm of the if executes, so buffers local to the then arm and
+    # to the else arm can share the same storage.
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    with ib.if_scope(n >= 0):
+        A = ib.allocate("float32", 200, name="A", scope="global")
+        A[0] = 1.2
+    with ib.else_scope():
+        B = ib.allocate("float32", 200, name="B", scope="global")
+        B[0] = 1.3
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], ib.get()))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+    assert count_allocs(body) == 1
+
+
+def test_alloc_if_else_live_across_if():
+    # A is first written in the then arm but read after the if, so it is
+    # live across the else arm on the else path and must not share storage
+    # with the else arm's local buffer.
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    A = ib.allocate("float32", 200, name="A", scope="global")
+    with ib.if_scope(n >= 0):
+        A[0] = 1.1
+    with ib.else_scope():
+        B = ib.allocate("float32", 200, name="B", scope="global")
+        B[0] = 1.3
+    A[1] = A[0] + 1.0
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], ib.get()))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+    assert count_allocs(body) == 2
+
+
+def test_alloc_if_else_divergent_condition():
+    # Threads may take different arms when the condition depends on a
+    # thread index, so the arms keep the conservative linear plan.
+    ib = tvm.tir.ir_builder.create()
+    tx = te.thread_axis("threadIdx.x")
+    ib.scope_attr(tx, "thread_extent", 32)
+    with ib.if_scope(tx.var < 16):
+        A = ib.allocate("float32", 200, name="A", scope="local")
+        A[0] = 1.2
+    with ib.else_scope():
+        B = ib.allocate("float32", 200, name="B", scope="local")
+        B[0] = 1.3
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([], ib.get()))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+    assert count_allocs(body) == 2
+
+
 def test_inplace_rule2(scope_tb="local_TB2", max_bits=1024 * 1024 * 1024):
     # Test Buffer
     register_mem(scope_tb, max_bits)
@@ -389,8 +389,22 @@ export class WebGPUContext {
   private bufferTableFreeId: Array<number> = [];
   private podArgStagingBuffers: Array<GPUBuffer> = [];
   private canvasRenderManager?: CanvasRenderManager = undefined;
-  // number of pod arg staging buffers
-  private maxNumPodArgsStagingBuffers = 2;
+  // number of free pod arg staging buffers kept around. Each kernel of a
+  // pending batch holds its own pod arg buffer until the batch is submitted,
+  // so the pool is sized to the batch limit.
+  private maxNumPodArgsStagingBuffers = 32;
+  // command encoder that batches the GPU commands recorded since the last flush
+  private pendingEncoder?: GPUCommandEncoder = undefined;
+  // number of kernels recorded in the pending encoder
+  private pendingKernelCount = 0;
+  // pod arg staging buffers held by the pending batch, recycled on flush
+  private podArgBatchBuffers: Array<GPUBuffer> = [];
+  // mapped staging buffers reused across readbacks
+  private readStagingBuffers: Array<GPUBuffer> = [];
+  // number of free readback staging buffers kept around
+  private maxNumReadStagingBuffers = 8;
+  // maximum number of kernels batched into a single queue submission
+  protected maxBatchedKernels = 32;
   // flags for debugging
   // stats of the runtime.
   // peak allocation
@@ -401,6 +415,8 @@ export class WebGPUContext {
   private allAllocatedBytes = 0;
   // shader submit counter
   private shaderSubmitCounter = 0;
+  // queue submission counter
+  private queueSubmitCounter = 0;
   // limite number of shaders to be submitted, useful for debugging, default to -1
   protected debugShaderSubmitLimit = -1;
   // log and sync each step
@@ -416,6 +432,8 @@ export class WebGPUContext {
    */
   dispose() {
     this.canvasRenderManager?.dispose();
+    this.pendingEncoder = undefined;
+    this.pendingKernelCount = 0;
     this.bufferTableFreeId = [];
     while (this.bufferTable.length != 0) {
       this.bufferTable.pop()?.destroy();
@@ -423,6 +441,12 @@ export class WebGPUContext {
     while (this.podArgStagingBuffers.length != 0) {
       this.podArgStagingBuffers.pop()?.destroy();
     }
+    while (this.podArgBatchBuffers.length != 0) {
+      this.podArgBatchBuffers.pop()?.destroy();
+    }
+    while (this.readStagingBuffers.length != 0) {
+      this.readStagingBuffers.pop()?.destroy();
+    }
     this.device.destroy();
   }
 
@@ -430,9 +454,48 @@ export class WebGPUContext {
    * Wait for all pending GPU tasks to complete
    */
   async sync(): Promise<void> {
+    this.flushPendingCommands();
     await this.device.queue.onSubmittedWorkDone();
   }
 
+  /**
+   * Get the command encoder that batches the commands recorded until the
+   * next flush into a single queue submission.
+   */
+  private getPendingEncoder(): GPUCommandEncoder {
+    if (this.pendingEncoder === undefined) {
+      this.pendingEncoder = this.device.createCommandEncoder();
+    }
+    return this.pendingEncoder;
+  }
+
+  /**
+   * Submit all commands recorded in the pending encoder, if any.
+   *
+   * Must be called before any operation whose queue-level ordering would
+   * otherwise run ahead of the recorded commands (queue.writeBuffer,
+   * buffer mapping) and before waiting on onSubmittedWorkDone.
+   */
+  flushPendingCommands(): void {
+    if (this.pendingEncoder === undefined) {
+      return;
+    }
+    this.device.queue.submit([this.pendingEncoder.finish()]);
+    this.queueSubmitCounter += 1;
+    this.pendingEncoder = undefined;
+    this.pendingKernelCount = 0;
+    // The batch is submitted now. Later writeBuffer calls execute after it,
+    // so its pod arg staging buffers can be recycled.
+    while (this.podArgBatchBuffers.length != 0) {
+      const buffer = this.podArgBatchBuffers.pop() as GPUBuffer;
+      if (this.podArgStagingBuffers.length < this.maxNumPodArgsStagingBuffers) {
+        this.podArgStagingBuffers.push(buffer);
+      } else {
+        buffer.destroy();
+      }
+    }
+  }
+
   /**
    * Obtain the runtime information in readable format.
    */
@@ -440,6 +503,7 @@ export class WebGPUContext {
     let info = "peak-memory=" + Math.ceil(this.peakAllocatedBytes / (1 << 20)) + " MB";
     info += ", all-memory=" + Math.ceil(this.allAllocatedBytes / (1 << 20)) + " MB";
     info += ", shader-submissions=" + this.shaderSubmitCounter;
+    info += ", queue-submissions=" + this.queueSubmitCounter;
     return info;
   }
 
@@ -453,6 +517,9 @@ export class WebGPUContext {
     if (this.canvasRenderManager == undefined) {
       throw Error("Do not have a canvas context, call bindCanvas first");
     }
+    // the render pass submits its own encoder, so the recorded compute
+    // commands producing the image must be on the queue first
+    this.flushPendingCommands();
     this.canvasRenderManager.draw(this.gpuBufferFromPtr(ptr), height, width);
   }
 
@@ -470,7 +537,9 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to use a staging buffer?
+    // writeBuffer executes before any later submit, so the recorded-but-
+    // unsubmitted commands that may touch the destination must go first.
+    this.flushPendingCommands();
     this.device.queue.writeBuffer(
       this.gpuBufferFromPtr(toPtr),
       toOffset,
@@ -524,10 +593,7 @@ export class WebGPUContext {
    * \return The allocated buffer
    */
   private getPodArgsBuffer(nbytes: number): GPUBuffer {
-    let buffer: GPUBuffer | undefined = undefined;
-    if (this.podArgStagingBuffers.length >= this.maxNumPodArgsStagingBuffers) {
-      buffer = this.podArgStagingBuffers.shift();
-    }
+    let buffer: GPUBuffer | undefined = this.podArgStagingBuffers.pop();
     // minimum of 16 bytes
     let allocSize = 16;
     if (buffer !== undefined) {
@@ -549,6 +615,10 @@ export class WebGPUContext {
       });
     }
     assert(nbytes <= buffer.size);
+    // Hold the buffer until the current batch is submitted. Recycling it
+    // earlier would clobber the pod args of a recorded-but-unsubmitted
+    // kernel, because queue.writeBuffer executes before any later submit.
+    this.podArgBatchBuffers.push(buffer);
     return buffer;
   }
 
@@ -634,9 +704,6 @@ export class WebGPUContext {
           return;
         }
 
-        const commandEncoder = this.device.createCommandEncoder();
-        const compute = commandEncoder.beginComputePass();
-        compute.setPipeline(pipeline);
         const bindGroupEntries: Array<GPUBindGroupEntry> = [];
         const numBufferOrPodArgs = bufferArgIndices.length + podArgIndices.length;
 
@@ -712,6 +779,13 @@ export class WebGPUContext {
           }
         });
 
+        // Record the dispatch into the shared encoder. The commands are only
+        // submitted when the batch limit is reached or when an operation
+        // (readback, upload, sync) needs the recorded work on the queue,
+        // so a full VM step typically costs a handful of submissions.
+        const commandEncoder = this.getPendingEncoder();
+        const compute = commandEncoder.beginComputePass();
+        compute.setPipeline(pipeline);
         compute.setBindGroup(0, this.device.createBindGroup({
           layout: bindGroupLayout,
           entries: bindGroupEntries
@@ -719,8 +793,10 @@ export class WebGPUContext {
 
         compute.dispatchWorkgroups(workDim[0], workDim[1], workDim[2])
         compute.end()
-        const command = commandEncoder.finish();
-        this.device.queue.submit([command]);
+        this.pendingKernelCount += 1;
+        if (this.pendingKernelCount >= this.maxBatchedKernels || this.debugLogFinish) {
+          this.flushPendingCommands();
+        }
 
         if (this.debugLogFinish) {
           const currCounter = this.shaderSubmitCounter;
@@ -847,7 +923,6 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to use a staging buffer?
     let rawBytes = this.memory.loadRawBytes(from, nbytes);
     if (rawBytes.length % 4 !== 0) {
       // writeBuffer requires length to be multiples of 4, so we pad here
@@ -856,6 +931,9 @@ export class WebGPUContext {
       rawBytes.set(rawBytes);
       nbytes = nbytes + toPad;
     }
+    // keep queue order: recorded commands that may touch the destination
+    // must be submitted before the write lands on the queue
+    this.flushPendingCommands();
     this.device.queue.writeBuffer(
       this.gpuBufferFromPtr(to),
       toOffset,
@@ -871,13 +949,10 @@ export class WebGPUContext {
     to: Pointer,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to resuse a staging buffer?
-    const gpuTemp = tryCreateBuffer(this.device, {
-      size: nbytes,
-      usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
-    });
-
-    const copyEncoder = this.device.createCommandEncoder();
+    const gpuTemp = this.getReadStagingBuffer(nbytes);
+    // Record the copy behind the pending kernels so it observes their
+    // results, then flush: mapAsync only resolves for submitted work.
+    const copyEncoder = this.getPendingEncoder();
     copyEncoder.copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
@@ -885,16 +960,51 @@ export class WebGPUContext {
       0,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
+    this.flushPendingCommands();
 
+    const mapSize = Math.ceil(nbytes / 4) * 4;
     gpuTemp.mapAsync(GPUMapMode.READ).then(() => {
-      const data = gpuTemp.getMappedRange();
-      this.memory.storeRawBytes(to, new Uint8Array(data));
-      gpuTemp.destroy();
+      const data = gpuTemp.getMappedRange(0, mapSize);
+      this.memory.storeRawBytes(to, new Uint8Array(data, 0, nbytes));
+      gpuTemp.unmap();
+      this.returnReadStagingBuffer(gpuTemp);
+    });
+  }
+
+  /**
+   * Get a readback staging buffer of at least nbytes from the pool.
+   * \param nbytes The minimum size.
+   * \return The staging buffer.
+   */
+  private getReadStagingBuffer(nbytes: number): GPUBuffer {
+    for (let i = 0; i < this.readStagingBuffers.length; ++i) {
+      if (this.readStagingBuffers[i].size >= nbytes) {
+        return this.readStagingBuffers.splice(i, 1)[0];
+      }
+    }
+    // minimum of 256 bytes, power-of-two sizing so the pool converges
+    let allocSize = 256;
+    while (allocSize < nbytes) {
+      allocSize *= 2;
+    }
+    return tryCreateBuffer(this.device, {
+      size: allocSize,
+      usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
     });
   }
 
+  /**
+   * Return an unmapped readback staging buffer to the pool.
+   * \param buffer The staging buffer.
+   */
+  private returnReadStagingBuffer(buffer: GPUBuffer): void {
+    if (this.readStagingBuffers.length < this.maxNumReadStagingBuffers) {
+      this.readStagingBuffers.push(buffer);
+    } else {
+      buffer.destroy();
+    }
+  }
+
   private deviceCopyWithinGPU(
     from: GPUPointer,
     fromOffset: number,
@@ -902,7 +1012,9 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    const copyEncoder = this.device.createCommandEncoder();
+    // record into the pending batch; ordering with the recorded kernels is
+    // preserved within the shared encoder
+    const copyEncoder = this.getPendingEncoder();
     copyEncoder.copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
@@ -910,8 +1022,6 @@ export class WebGPUContext {
       toOffset,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
   }
 
   private gpuBufferFromPtr(ptr: GPUPointer): GPUBuffer {